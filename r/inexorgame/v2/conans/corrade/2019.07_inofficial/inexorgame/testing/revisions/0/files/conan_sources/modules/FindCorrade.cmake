@@ -516,6 +516,14 @@ foreach(_component ${Corrade_FIND_COMPONENTS})
                 set_property(TARGET Corrade::${_component} APPEND PROPERTY
                     INTERFACE_LINK_LIBRARIES "log")
             endif()
+
+            # TaskScheduler needs threads, unless it's the single-threaded
+            # fallback
+            if(CORRADE_BUILD_MULTITHREADED AND NOT CORRADE_TARGET_EMSCRIPTEN)
+                find_package(Threads REQUIRED)
+                set_property(TARGET Corrade::${_component} APPEND PROPERTY
+                    INTERFACE_LINK_LIBRARIES Threads::Threads)
+            endif()
         endif()
 
         # Find library includes
@@ -0,0 +1,411 @@
+#ifndef Corrade_Containers_ArenaAllocator_h
+#define Corrade_Containers_ArenaAllocator_h
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Corrade::Containers::ArenaAllocator
+ * @see @ref Corrade/Containers/PoolAllocator.h
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "Corrade/Containers/Array.h"
+#include "Corrade/Utility/Assert.h"
+#include "Corrade/Utility/Macros.h"
+
+namespace Corrade { namespace Containers {
+
+namespace Implementation {
+    /* Alignment guaranteed by malloc() on common platforms, not using
+       std::max_align_t as it's not in libstdc++ 4.8 */
+    enum: std::size_t { AllocatorAlignment = 2*sizeof(void*) };
+
+    template<class T> void arenaDeleter(T* data, std::size_t size) {
+        /* Memory is owned by the allocator, only call the destructors */
+        for(std::size_t i = 0; i != size; ++i) data[i].~T();
+    }
+
+    template<class T> void arenaTrivialDeleter(T*, std::size_t) {}
+
+    template<class T> inline void(*arenaDeleterFor())(T*, std::size_t) {
+        return std::is_trivially_destructible<T>::value ? arenaTrivialDeleter<T> : arenaDeleter<T>;
+    }
+}
+
+/**
+@brief Arena allocator
+
+A linear allocator that hands out memory from a list of large blocks by just
+advancing a pointer. Individual allocations can't be freed, instead all memory
+is recycled at once by calling @ref reset(). The blocks are kept around across
+resets, so after a few iterations of a frame loop no more heap allocations are
+done at all.
+
+Apart from raw @ref allocate(), the @ref array() functions return a
+@ref Array that has a deleter which only calls destructors and doesn't
+deallocate anything, so it can be passed to any API taking an @ref Array:
+
+@code{.cpp}
+Containers::ArenaAllocator arena;
+
+for(;;) {
+    Containers::Array<Matrix4> transformations =
+        arena.array<Matrix4>(Containers::NoInit, objectCount);
+    Containers::Array<UnsignedInt> visible = arena.array<UnsignedInt>(objectCount);
+    // ...
+
+    arena.reset();
+}
+@endcode
+
+@attention Arrays allocated from the arena have to be destroyed before
+    @ref reset() is called or the arena is destroyed, otherwise their deleter
+    accesses freed or reused memory. Passing them to the
+    @ref Corrade/Containers/GrowableArray.h "growable array" functions is
+    fine, as those move the contents to the heap first.
+
+The allocator is not thread-safe. For per-thread scratch memory, use
+@ref threadLocal(), which returns a separate instance for every thread.
+@see @ref PoolAllocator
+*/
+class ArenaAllocator {
+    public:
+        enum: std::size_t {
+            /** Default block size in bytes */
+            DefaultBlockSize = 64*1024,
+
+            /**
+             * Default allocation alignment, guaranteed also by
+             * @ref std::malloc() on common platforms
+             */
+            DefaultAlignment = Implementation::AllocatorAlignment
+        };
+
+        #if !defined(__has_feature) || defined(DOXYGEN_GENERATING_OUTPUT)
+        /**
+         * @brief Thread-local arena
+         *
+         * Returns an instance with @ref DefaultBlockSize that is unique for
+         * every thread and destroyed at thread exit. If Corrade is built
+         * without @ref CORRADE_BUILD_MULTITHREADED, there's just one global
+         * instance. Note that the instance is not shared across shared
+         * library boundaries. Not available on old Apple Clang that doesn't
+         * support the C++11 @cpp thread_local @ce keyword.
+         */
+        static ArenaAllocator& threadLocal();
+        #elif __has_feature(cxx_thread_local)
+        static ArenaAllocator& threadLocal();
+        #endif
+
+        /**
+         * @brief Constructor
+         * @param blockSize     Size of a single block
+         *
+         * Doesn't allocate anything, the first block is allocated on first
+         * @ref allocate() call. Allocations larger than @p blockSize get a
+         * block of their own.
+         */
+        explicit ArenaAllocator(std::size_t blockSize = DefaultBlockSize) noexcept: _blockSize{blockSize}, _first{}, _current{}, _offset{}, _usedSize{} {}
+
+        /** @brief Copying is not allowed */
+        ArenaAllocator(const ArenaAllocator&) = delete;
+
+        /** @brief Move constructor */
+        ArenaAllocator(ArenaAllocator&& other) noexcept: _blockSize{other._blockSize}, _first{other._first}, _current{other._current}, _offset{other._offset}, _usedSize{other._usedSize} {
+            other._first = other._current = nullptr;
+            other._offset = other._usedSize = 0;
+        }
+
+        /**
+         * @brief Destructor
+         *
+         * Frees all blocks.
+         */
+        ~ArenaAllocator();
+
+        /** @brief Copying is not allowed */
+        ArenaAllocator& operator=(const ArenaAllocator&) = delete;
+
+        /** @brief Move assignment */
+        ArenaAllocator& operator=(ArenaAllocator&& other) noexcept {
+            using std::swap;
+            swap(_blockSize, other._blockSize);
+            swap(_first, other._first);
+            swap(_current, other._current);
+            swap(_offset, other._offset);
+            swap(_usedSize, other._usedSize);
+            return *this;
+        }
+
+        /** @brief Block size */
+        std::size_t blockSize() const { return _blockSize; }
+
+        /**
+         * @brief Used size
+         *
+         * Count of bytes allocated since construction or last @ref reset(),
+         * including alignment padding and unused ends of blocks that didn't
+         * fit the next allocation.
+         */
+        std::size_t usedSize() const { return _usedSize; }
+
+        /**
+         * @brief Capacity
+         *
+         * Sum of sizes of all allocated blocks.
+         */
+        std::size_t capacity() const;
+
+        /** @brief Count of allocated blocks */
+        std::size_t blockCount() const;
+
+        /**
+         * @brief Allocate memory
+         * @param size          Size in bytes
+         * @param alignment     Alignment, expected to be a power of two
+         *
+         * Returns a pointer to @p size bytes aligned to @p alignment. If the
+         * current block doesn't have enough space, the next already
+         * allocated block is used or a new block is allocated. Returns
+         * @cpp nullptr @ce if @p size is zero.
+         */
+        void* allocate(std::size_t size, std::size_t alignment = DefaultAlignment);
+
+        /**
+         * @brief Allocate an uninitialized view
+         *
+         * Allocates memory for @p size elements of type @p T and returns a
+         * view on it. No constructors or destructors are called, the
+         * memory is valid until @ref reset() or destruction of the arena.
+         */
+        template<class T> ArrayView<T> allocate(NoInitT, std::size_t size) {
+            return {static_cast<T*>(allocate(size*sizeof(T), alignof(T))), size};
+        }
+
+        /**
+         * @brief Allocate a default-initialized array
+         *
+         * Equivalent to @ref Array(DefaultInitT, std::size_t), but the
+         * memory is allocated from the arena. The returned array has a
+         * deleter that only calls destructors of the elements, and nothing
+         * at all for trivially destructible types.
+         */
+        template<class T> Array<T> array(std::size_t size) {
+            return array<T>(DefaultInit, size);
+        }
+
+        /** @copydoc array(std::size_t) */
+        template<class T> Array<T> array(DefaultInitT, std::size_t size) {
+            Array<T> out = array<T>(NoInit, size);
+            for(T& i: out) new(&i) T;
+            return out;
+        }
+
+        /**
+         * @brief Allocate a value-initialized array
+         *
+         * Equivalent to @ref Array(ValueInitT, std::size_t), but the memory
+         * is allocated from the arena.
+         * @see @ref array(std::size_t)
+         */
+        template<class T> Array<T> array(ValueInitT, std::size_t size) {
+            Array<T> out = array<T>(NoInit, size);
+            for(T& i: out) new(&i) T();
+            return out;
+        }
+
+        /**
+         * @brief Allocate an uninitialized array
+         *
+         * Equivalent to @ref Array(NoInitT, std::size_t), but the memory is
+         * allocated from the arena. The elements have to be constructed
+         * using placement new before the array is destroyed.
+         * @see @ref array(std::size_t)
+         */
+        template<class T> Array<T> array(NoInitT, std::size_t size) {
+            return Array<T>{allocate<T>(NoInit, size).data(), size, Implementation::arenaDeleterFor<T>()};
+        }
+
+        /**
+         * @brief Allocate a direct-initialized array
+         *
+         * Equivalent to @ref Array(DirectInitT, std::size_t, Args&&... args),
+         * but the memory is allocated from the arena.
+         * @see @ref array(std::size_t)
+         */
+        template<class T, class... Args> Array<T> array(DirectInitT, std::size_t size, Args&&... args) {
+            Array<T> out = array<T>(NoInit, size);
+            for(T& i: out) new(&i) T{std::forward<Args>(args)...};
+            return out;
+        }
+
+        /**
+         * @brief Allocate an in-place-initialized array
+         *
+         * Equivalent to @ref Array(InPlaceInitT, std::initializer_list<T>),
+         * but the memory is allocated from the arena.
+         * @see @ref array(std::size_t)
+         */
+        template<class T> Array<T> array(InPlaceInitT, std::initializer_list<T> list) {
+            Array<T> out = array<T>(NoInit, list.size());
+            std::size_t i = 0;
+            for(const T& item: list) new(out.data() + i++) T{item};
+            return out;
+        }
+
+        /**
+         * @brief Reset the arena
+         *
+         * Makes all memory available for reuse, keeping the blocks
+         * allocated. All arrays and views allocated from the arena are
+         * invalidated. If there were more blocks allocated, it might be
+         * worth to increase the block size so a single block is enough.
+         */
+        void reset() {
+            _current = _first;
+            _offset = _usedSize = 0;
+        }
+
+    private:
+        struct Block {
+            Block* next;
+            std::size_t size;
+        };
+
+        enum: std::size_t {
+            /* Data start right after the header, aligned */
+            BlockHeaderSize = (sizeof(Block) + DefaultAlignment - 1)/DefaultAlignment*DefaultAlignment
+        };
+
+        static char* blockData(Block* block) {
+            return reinterpret_cast<char*>(block) + BlockHeaderSize;
+        }
+
+        void* allocateSlow(std::size_t size, std::size_t alignment);
+
+        std::size_t _blockSize;
+        Block* _first;
+        Block* _current;
+        std::size_t _offset, _usedSize;
+};
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+#if !defined(__has_feature)
+#define _CORRADE_CONTAINERS_ARENA_THREAD_LOCAL
+#elif __has_feature(cxx_thread_local)
+#define _CORRADE_CONTAINERS_ARENA_THREAD_LOCAL
+#endif
+
+#ifdef _CORRADE_CONTAINERS_ARENA_THREAD_LOCAL
+inline ArenaAllocator& ArenaAllocator::threadLocal() {
+    #ifdef CORRADE_BUILD_MULTITHREADED
+    static CORRADE_THREAD_LOCAL ArenaAllocator arena;
+    #else
+    static ArenaAllocator arena;
+    #endif
+    return arena;
+}
+#undef _CORRADE_CONTAINERS_ARENA_THREAD_LOCAL
+#endif
+
+inline ArenaAllocator::~ArenaAllocator() {
+    for(Block* block = _first; block; ) {
+        Block* const next = block->next;
+        delete[] reinterpret_cast<char*>(block);
+        block = next;
+    }
+}
+
+inline std::size_t ArenaAllocator::capacity() const {
+    std::size_t capacity = 0;
+    for(Block* block = _first; block; block = block->next)
+        capacity += block->size;
+    return capacity;
+}
+
+inline std::size_t ArenaAllocator::blockCount() const {
+    std::size_t count = 0;
+    for(Block* block = _first; block; block = block->next) ++count;
+    return count;
+}
+
+inline void* ArenaAllocator::allocate(const std::size_t size, const std::size_t alignment) {
+    CORRADE_ASSERT(alignment && !(alignment & (alignment - 1)),
+        "Containers::ArenaAllocator::allocate(): alignment" << alignment << "is not a power of two", nullptr);
+    if(!size) return nullptr;
+
+    /* Fast path, fits into the current block. The block data are aligned to
+       DefaultAlignment, so for smaller alignments it's enough to align the
+       offset. */
+    if(_current) {
+        const std::size_t padding = (~std::size_t(reinterpret_cast<std::uintptr_t>(blockData(_current)) + _offset) + 1) & (alignment - 1);
+        if(_offset + padding + size <= _current->size) {
+            void* const out = blockData(_current) + _offset + padding;
+            _offset += padding + size;
+            _usedSize += padding + size;
+            return out;
+        }
+    }
+
+    return allocateSlow(size, alignment);
+}
+
+inline void* ArenaAllocator::allocateSlow(const std::size_t size, const std::size_t alignment) {
+    /* The rest of the current block is wasted */
+    if(_current) _usedSize += _current->size - _offset;
+
+    /* Reuse the next blocks that were kept from before a reset, if large
+       enough. Over-aligned allocations might need extra padding. */
+    const std::size_t sizeWithPadding = size + (alignment > DefaultAlignment ? alignment - DefaultAlignment : 0);
+    Block* const next = _current ? _current->next : _first;
+    if(next && next->size >= sizeWithPadding) {
+        _current = next;
+        _offset = 0;
+        return allocate(size, alignment);
+    }
+
+    /* Otherwise allocate a new block and insert it after the current one so
+       the remaining ones are still reused later */
+    const std::size_t blockSize = sizeWithPadding > _blockSize ? sizeWithPadding : _blockSize;
+    Block* const block = reinterpret_cast<Block*>(new char[BlockHeaderSize + blockSize]);
+    block->size = blockSize;
+    block->next = next;
+    if(_current) _current->next = block;
+    else _first = block;
+    _current = block;
+    _offset = 0;
+    return allocate(size, alignment);
+}
+#endif
+
+}}
+
+#endif
@@ -132,6 +132,32 @@ deleter type can be used:
 
 @snippet Containers.cpp Array-deleter
 
+@section Containers-Array-growable Growable arrays
+
+The @ref Corrade/Containers/GrowableArray.h header provides
+@ref arrayAppend(), @ref arrayResize(), @ref arrayReserve(),
+@ref arrayRemoveSuffix() and @ref arrayShrink(), which make it possible to use
+the class in place of @ref std::vector also when the size isn't known up
+front. The growable state is stored in the deleter, so the type is still a
+plain @ref Array and can be passed to any API taking one. The first growing
+operation moves the contents to a memory with a capacity stored in front and
+sets the deleter to the one of given allocator; later operations then grow
+the capacity geometrically, making appends amortized @f$ \mathcal{O}(1) @f$.
+Trivially copyable types use @ref ArrayMallocAllocator, which grows the
+memory using @ref std::realloc() and thus often without any copy, other types
+use @ref ArrayNewAllocator. The @ref NoInit overloads leave the new elements
+uninitialized, avoiding the redundant zero-fill that
+@ref std::vector::resize() does:
+
+@code{.cpp}
+Containers::Array<Vector3> positions;
+Containers::arrayReserve(positions, vertexCount);
+for(…) Containers::arrayAppend(positions, {x, y, z});
+
+Containers::ArrayView<UnsignedInt> indices =
+    Containers::arrayAppend(indexData, NoInit, 3*triangleCount);
+@endcode
+
 @section Containers-Array-views Conversion to array views
 
 Arrays are implicitly convertible to @ref ArrayView as described in the
@@ -0,0 +1,556 @@
+#ifndef Corrade_Containers_GrowableArray_h
+#define Corrade_Containers_GrowableArray_h
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Corrade::Containers::ArrayNewAllocator, @ref Corrade::Containers::ArrayMallocAllocator, alias @ref Corrade::Containers::ArrayAllocator, function @ref Corrade::Containers::arrayIsGrowable(), @ref Corrade::Containers::arrayCapacity(), @ref Corrade::Containers::arrayReserve(), @ref Corrade::Containers::arrayResize(), @ref Corrade::Containers::arrayAppend(), @ref Corrade::Containers::arrayRemoveSuffix(), @ref Corrade::Containers::arrayShrink()
+ */
+
+#include <cstdlib>
+#include <cstring>
+
+#include "Corrade/Containers/Array.h"
+
+namespace Corrade { namespace Containers {
+
+namespace Implementation {
+    /* std::is_trivially_copyable is not in libstdc++ 4, see also
+       Interconnect::Emitter */
+    template<class T> struct IsTriviallyCopyable: std::integral_constant<bool,
+        #if !defined(CORRADE_TARGET_LIBSTDCXX) || _GLIBCXX_RELEASE >= 5
+        std::is_trivially_copyable<T>::value
+        #else
+        __has_trivial_copy(T) && __has_trivial_destructor(T)
+        #endif
+    > {};
+
+    /* The capacity is stored right before the data, the offset is large
+       enough to keep the data aligned */
+    template<class T> struct AllocationOffset: std::integral_constant<std::size_t,
+        (alignof(T) > sizeof(std::size_t) ? alignof(T) : sizeof(std::size_t))> {};
+
+    template<class T> std::size_t arrayGrowth(const std::size_t current, const std::size_t desired) {
+        /* Small arrays are doubled, larger grown by 50% to be nicer to
+           memory usage */
+        const std::size_t currentBytes = current*sizeof(T) + AllocationOffset<T>::value;
+        const std::size_t grownBytes = currentBytes < 64 ? currentBytes*2 : currentBytes + currentBytes/2;
+        const std::size_t grown = (grownBytes - AllocationOffset<T>::value)/sizeof(T);
+        return grown > desired ? grown : desired;
+    }
+}
+
+/**
+@brief New-based allocator for growable arrays
+@tparam T   Element type
+
+Allocates the memory using @cpp new[] @ce and moves the elements one by one on
+reallocation, so it's usable with any type that's move-constructible. The
+capacity is stored in front of the data. Used by @ref ArrayAllocator for types
+that aren't trivially copyable, see @ref Containers-Array-growable for more
+information.
+@see @ref ArrayMallocAllocator
+*/
+template<class T> struct ArrayNewAllocator {
+    typedef T Type; /**< Pointer type */
+
+    /**
+     * @brief Allocate an array
+     *
+     * Allocates memory for @p capacity elements, doesn't construct any of
+     * them.
+     */
+    static T* allocate(std::size_t capacity) {
+        char* const memory = new char[capacity*sizeof(T) + Implementation::AllocationOffset<T>::value];
+        reinterpret_cast<std::size_t*>(memory)[0] = capacity;
+        return reinterpret_cast<T*>(memory + Implementation::AllocationOffset<T>::value);
+    }
+
+    /**
+     * @brief Reallocate an array
+     *
+     * Allocates a new array of @p newCapacity elements, move-constructs
+     * @p prevSize elements from @p array there, destructs them in the
+     * original location and deallocates it. Updates @p array to point to the
+     * new memory.
+     */
+    static void reallocate(T*& array, std::size_t prevSize, std::size_t newCapacity);
+
+    /**
+     * @brief Deallocate an array
+     *
+     * Doesn't call any destructors. Passing @cpp nullptr @ce is a no-op.
+     */
+    static void deallocate(T* data) {
+        if(data) delete[] (reinterpret_cast<char*>(data) - Implementation::AllocationOffset<T>::value);
+    }
+
+    /**
+     * @brief Grow an array
+     *
+     * Calculates a new capacity for an array that has @p current capacity
+     * and needs to fit at least @p desired elements. Small arrays are
+     * doubled, larger grown by 50%.
+     */
+    static std::size_t grow(T* array, std::size_t desired) {
+        return Implementation::arrayGrowth<T>(array ? capacity(array) : 0, desired);
+    }
+
+    /**
+     * @brief Array capacity
+     *
+     * Returns @cpp 0 @ce for @cpp nullptr @ce, which is the case for a
+     * growable @ref Array that was moved out.
+     */
+    static std::size_t capacity(T* array) {
+        if(!array) return 0;
+        return reinterpret_cast<const std::size_t*>(reinterpret_cast<const char*>(array) - Implementation::AllocationOffset<T>::value)[0];
+    }
+
+    /**
+     * @brief Array deleter
+     *
+     * Destructs the first @p size elements and deallocates the array. A
+     * growable @ref Array is identified by having this function as a
+     * deleter.
+     */
+    static void deleter(T* data, std::size_t size) {
+        for(std::size_t i = 0; i != size; ++i) data[i].~T();
+        deallocate(data);
+    }
+};
+
+/**
+@brief Malloc-based allocator for growable arrays
+@tparam T   Element type
+
+Allocates the memory using @ref std::malloc() and reallocates it using
+@ref std::realloc(), which can often extend the allocation in-place without
+copying anything. Usable only with trivially copyable types. Used by
+@ref ArrayAllocator for trivially copyable types, see
+@ref Containers-Array-growable for more information.
+@see @ref ArrayNewAllocator
+*/
+template<class T> struct ArrayMallocAllocator {
+    static_assert(Implementation::IsTriviallyCopyable<T>::value,
+        "only trivially copyable types are usable with this allocator");
+
+    typedef T Type; /**< Pointer type */
+
+    /** @copydoc ArrayNewAllocator::allocate() */
+    static T* allocate(std::size_t capacity) {
+        char* const memory = static_cast<char*>(std::malloc(capacity*sizeof(T) + Implementation::AllocationOffset<T>::value));
+        reinterpret_cast<std::size_t*>(memory)[0] = capacity;
+        return reinterpret_cast<T*>(memory + Implementation::AllocationOffset<T>::value);
+    }
+
+    /**
+     * @brief Reallocate an array
+     *
+     * Calls @ref std::realloc() on @p array, the elements are copied only if
+     * the allocation can't be extended in-place. Updates @p array to point to
+     * the new memory.
+     */
+    static void reallocate(T*& array, std::size_t prevSize, std::size_t newCapacity);
+
+    /**
+     * @brief Deallocate an array
+     *
+     * Passing @cpp nullptr @ce is a no-op.
+     */
+    static void deallocate(T* data) {
+        if(data) std::free(reinterpret_cast<char*>(data) - Implementation::AllocationOffset<T>::value);
+    }
+
+    /** @copydoc ArrayNewAllocator::grow() */
+    static std::size_t grow(T* array, std::size_t desired) {
+        return Implementation::arrayGrowth<T>(array ? capacity(array) : 0, desired);
+    }
+
+    /** @copydoc ArrayNewAllocator::capacity() */
+    static std::size_t capacity(T* array) {
+        if(!array) return 0;
+        return reinterpret_cast<const std::size_t*>(reinterpret_cast<const char*>(array) - Implementation::AllocationOffset<T>::value)[0];
+    }
+
+    /**
+     * @brief Array deleter
+     *
+     * Deallocates the array, the type is trivially destructible so no
+     * destructors are called. A growable @ref Array is identified by having
+     * this function as a deleter.
+     */
+    static void deleter(T* data, std::size_t) {
+        deallocate(data);
+    }
+};
+
+/**
+@brief Default allocator for growable arrays
+
+@ref ArrayMallocAllocator for trivially copyable types, @ref ArrayNewAllocator
+otherwise. All growable array functions take the allocator as a second
+template parameter, which makes it possible to plug in a different one. An
+allocator is expected to provide the same interface as @ref ArrayNewAllocator.
+*/
+template<class T> using ArrayAllocator = typename std::conditional<Implementation::IsTriviallyCopyable<T>::value, ArrayMallocAllocator<T>, ArrayNewAllocator<T>>::type;
+
+/**
+@brief Whether an array is growable
+
+Returns @cpp true @ce if the array has @p Allocator's deleter, which means
+it was allocated or reallocated by one of the growable array functions. Other
+arrays get converted to growable ones on the first growing operation.
+@see @ref Containers-Array-growable
+*/
+template<class T, class Allocator = ArrayAllocator<T>> bool arrayIsGrowable(Array<T>& array) {
+    return array.deleter() == Allocator::deleter;
+}
+
+/**
+@brief Array capacity
+
+For a growable array returns its capacity, otherwise its size.
+@see @ref arrayIsGrowable()
+*/
+template<class T, class Allocator = ArrayAllocator<T>> std::size_t arrayCapacity(Array<T>& array) {
+    return arrayIsGrowable<T, Allocator>(array) ? Allocator::capacity(array.data()) : array.size();
+}
+
+/**
+@brief Reserve given capacity in an array
+@return New capacity of the array
+
+If the array capacity is already large enough, the function does nothing.
+Otherwise the array is reallocated to have exactly @p capacity, converting it
+to a growable array if it isn't already. The size stays the same. Unlike
+@ref arrayAppend() the capacity isn't grown beyond @p capacity.
+@see @ref arrayCapacity(), @ref arrayShrink()
+*/
+template<class T, class Allocator = ArrayAllocator<T>> std::size_t arrayReserve(Array<T>& array, std::size_t capacity);
+
+/**
+@brief Resize an array to given size, leaving new elements uninitialized
+
+If the array is growable and its capacity is large enough, the size is just
+updated, destructing the excess elements if the array gets smaller. Otherwise
+the array is reallocated to exactly @p size and converted to a growable one.
+The new elements are not initialized and it's the responsibility of the caller
+to construct them, for example using placement new. This is the fastest way to
+grow an array of trivial types.
+@see @ref arrayAppend(Array<T>&, NoInitT, std::size_t)
+*/
+template<class T, class Allocator = ArrayAllocator<T>> void arrayResize(Array<T>& array, NoInitT, std::size_t size);
+
+/**
+@brief Resize an array to given size, default-initializing new elements
+
+Like @ref arrayResize(Array<T>&, NoInitT, std::size_t), but new elements are
+default-constructed, which means trivial types are not initialized at all.
+*/
+template<class T, class Allocator = ArrayAllocator<T>> void arrayResize(Array<T>& array, DefaultInitT, std::size_t size);
+
+/**
+@brief Resize an array to given size, value-initializing new elements
+
+Like @ref arrayResize(Array<T>&, NoInitT, std::size_t), but new elements are
+value-initialized, which means trivial types are zeroed out.
+*/
+template<class T, class Allocator = ArrayAllocator<T>> void arrayResize(Array<T>& array, ValueInitT, std::size_t size);
+
+/**
+@brief Resize an array to given size, value-initializing new elements
+
+Alias to @ref arrayResize(Array<T>&, ValueInitT, std::size_t).
+*/
+template<class T, class Allocator = ArrayAllocator<T>> inline void arrayResize(Array<T>& array, std::size_t size) {
+    arrayResize<T, Allocator>(array, ValueInit, size);
+}
+
+/**
+@brief Resize an array to given size, constructing new elements from given arguments
+
+Like @ref arrayResize(Array<T>&, NoInitT, std::size_t), but new elements are
+constructed from @p args.
+*/
+template<class T, class Allocator = ArrayAllocator<T>, class... Args> void arrayResize(Array<T>& array, DirectInitT, std::size_t size, Args&&... args);
+
+/**
+@brief Append uninitialized elements to an array
+@return View on the newly appended elements
+
+If the array isn't growable or its capacity is not large enough, it's grown
+with @ref ArrayNewAllocator::grow() "Allocator::grow()", which makes repeated
+appends amortized @f$ \mathcal{O}(1) @f$. The new elements are not initialized
+and it's the responsibility of the caller to construct them.
+*/
+template<class T, class Allocator = ArrayAllocator<T>> ArrayView<T> arrayAppend(Array<T>& array, NoInitT, std::size_t count);
+
+/**
+@brief Append elements to an array
+@return View on the newly appended elements
+
+Grows the array the same way as
+@ref arrayAppend(Array<T>&, NoInitT, std::size_t) and copy-constructs the new
+elements from @p values. The @p values are not allowed to point into the
+array itself.
+*/
+template<class T, class Allocator = ArrayAllocator<T>> ArrayView<T> arrayAppend(Array<T>& array, typename std::common_type<ArrayView<const T>>::type values);
+
+/** @overload */
+template<class T, class Allocator = ArrayAllocator<T>> inline ArrayView<T> arrayAppend(Array<T>& array, std::initializer_list<typename std::common_type<T>::type> values) {
+    return arrayAppend<T, Allocator>(array, ArrayView<const T>{values.begin(), values.size()});
+}
+
+/**
+@brief Append an element to an array in-place
+@return Reference to the newly appended element
+
+Grows the array the same way as
+@ref arrayAppend(Array<T>&, NoInitT, std::size_t) and constructs the new
+element from @p args.
+*/
+template<class T, class Allocator = ArrayAllocator<T>, class... Args> T& arrayAppend(Array<T>& array, InPlaceInitT, Args&&... args);
+
+/**
+@brief Copy-append an element to an array
+@return Reference to the newly appended element
+
+Grows the array the same way as
+@ref arrayAppend(Array<T>&, NoInitT, std::size_t) and copy-constructs the new
+element. The @p value is allowed to point into the array itself.
+*/
+template<class T, class Allocator = ArrayAllocator<T>> T& arrayAppend(Array<T>& array, const typename std::common_type<T>::type& value);
+
+/**
+@brief Move-append an element to an array
+@return Reference to the newly appended element
+
+Grows the array the same way as
+@ref arrayAppend(Array<T>&, NoInitT, std::size_t) and move-constructs the new
+element.
+*/
+template<class T, class Allocator = ArrayAllocator<T>> T& arrayAppend(Array<T>& array, typename std::remove_const<T>::type&& value);
+
+/**
+@brief Remove a suffix from an array
+
+Expects that @p count is not larger than the array size. If the array is
+growable, the excess elements are destructed and the capacity stays the same.
+Otherwise the remaining elements are moved to a new growable array.
+@see @ref arrayShrink()
+*/
+template<class T, class Allocator = ArrayAllocator<T>> void arrayRemoveSuffix(Array<T>& array, std::size_t count = 1);
+
+/**
+@brief Convert an array back to a non-growable one
+@return New capacity of the array, which is the same as its size
+
+If the array is growable, its elements are moved to a new array of exactly its
+size allocated with @ref Array(NoInitT, std::size_t), which can be safely
+passed to code that doesn't know about @p Allocator. Otherwise the function
+does nothing.
+@see @ref arrayIsGrowable()
+*/
+template<class T, class Allocator = ArrayAllocator<T>> std::size_t arrayShrink(Array<T>& array);
+
+template<class T> void ArrayNewAllocator<T>::reallocate(T*& array, const std::size_t prevSize, const std::size_t newCapacity) {
+    T* const newArray = allocate(newCapacity);
+    for(std::size_t i = 0; i != prevSize; ++i) {
+        new(newArray + i) T(std::move(array[i]));
+        array[i].~T();
+    }
+    deallocate(array);
+    array = newArray;
+}
+
+template<class T> void ArrayMallocAllocator<T>::reallocate(T*& array, std::size_t, const std::size_t newCapacity) {
+    char* const memory = static_cast<char*>(std::realloc(array ? reinterpret_cast<char*>(array) - Implementation::AllocationOffset<T>::value : nullptr, newCapacity*sizeof(T) + Implementation::AllocationOffset<T>::value));
+    reinterpret_cast<std::size_t*>(memory)[0] = newCapacity;
+    array = reinterpret_cast<T*>(memory + Implementation::AllocationOffset<T>::value);
+}
+
+namespace Implementation {
+
+/* Replaces the array contents with a growable allocation of given capacity,
+   moving the first `size` elements over. Used when the array is not growable
+   yet, so the old contents get destructed with the original deleter. */
+template<class T, class Allocator> void arrayConvertToGrowable(Array<T>& array, const std::size_t size, const std::size_t capacity) {
+    T* const newArray = Allocator::allocate(capacity);
+    for(std::size_t i = 0; i != size; ++i)
+        new(newArray + i) T(std::move(array[i]));
+    array = Array<T>{newArray, size, Allocator::deleter};
+}
+
+/* Going through release() and a move assignment for every size update would
+   mean a function pointer call in the destructor of the temporary on each
+   append, so the growable array functions access the members directly. The
+   layout has to match Array, which is checked below. */
+template<class T> struct ArrayGuts {
+    T* data;
+    std::size_t size;
+    void(*deleter)(T*, std::size_t);
+};
+
+template<class T> inline ArrayGuts<T>& arrayGuts(Array<T>& array) {
+    static_assert(sizeof(ArrayGuts<T>) == sizeof(Array<T>),
+        "unexpected Array layout");
+    return reinterpret_cast<ArrayGuts<T>&>(array);
+}
+
+/* Grows the array to fit `count` more elements and updates the size, the new
+   elements are left uninitialized */
+template<class T, class Allocator> T* arrayGrowBy(Array<T>& array, const std::size_t count) {
+    ArrayGuts<T>& guts = arrayGuts(array);
+    const std::size_t size = guts.size;
+    const std::size_t desired = size + count;
+    if(guts.deleter != Allocator::deleter)
+        arrayConvertToGrowable<T, Allocator>(array, size, Allocator::grow(nullptr, desired < size*2 ? size*2 : desired));
+    else if(Allocator::capacity(guts.data) < desired)
+        Allocator::reallocate(guts.data, size, Allocator::grow(guts.data, desired));
+
+    guts.size = desired;
+    return guts.data + size;
+}
+
+/* Resizes the array, destructing excess elements, new elements are left
+   uninitialized. Returns the previous size. */
+template<class T, class Allocator> std::size_t arrayResizeNoInit(Array<T>& array, const std::size_t size) {
+    ArrayGuts<T>& guts = arrayGuts(array);
+    const std::size_t prevSize = guts.size;
+
+    if(guts.deleter != Allocator::deleter)
+        arrayConvertToGrowable<T, Allocator>(array, prevSize < size ? prevSize : size, size);
+    else if(Allocator::capacity(guts.data) < size)
+        Allocator::reallocate(guts.data, prevSize, size);
+    else for(std::size_t i = size; i < prevSize; ++i)
+        guts.data[i].~T();
+
+    guts.size = size;
+    return prevSize;
+}
+
+}
+
+template<class T, class Allocator> std::size_t arrayReserve(Array<T>& array, const std::size_t capacity) {
+    const std::size_t currentCapacity = arrayCapacity<T, Allocator>(array);
+    if(currentCapacity >= capacity) return currentCapacity;
+
+    const std::size_t size = array.size();
+    if(!arrayIsGrowable<T, Allocator>(array))
+        Implementation::arrayConvertToGrowable<T, Allocator>(array, size, capacity);
+    else
+        Allocator::reallocate(Implementation::arrayGuts(array).data, size, capacity);
+
+    return capacity;
+}
+
+template<class T, class Allocator> void arrayResize(Array<T>& array, NoInitT, const std::size_t size) {
+    Implementation::arrayResizeNoInit<T, Allocator>(array, size);
+}
+
+template<class T, class Allocator> void arrayResize(Array<T>& array, DefaultInitT, const std::size_t size) {
+    const std::size_t prevSize = Implementation::arrayResizeNoInit<T, Allocator>(array, size);
+    for(std::size_t i = prevSize; i < size; ++i) new(array.data() + i) T;
+}
+
+template<class T, class Allocator> void arrayResize(Array<T>& array, ValueInitT, const std::size_t size) {
+    const std::size_t prevSize = Implementation::arrayResizeNoInit<T, Allocator>(array, size);
+    if(prevSize >= size) return;
+    if(std::is_trivial<T>::value)
+        std::memset(static_cast<void*>(array.data() + prevSize), 0, (size - prevSize)*sizeof(T));
+    else for(std::size_t i = prevSize; i < size; ++i)
+        new(array.data() + i) T();
+}
+
+template<class T, class Allocator, class... Args> void arrayResize(Array<T>& array, DirectInitT, const std::size_t size, Args&&... args) {
+    const std::size_t prevSize = Implementation::arrayResizeNoInit<T, Allocator>(array, size);
+    for(std::size_t i = prevSize; i < size; ++i)
+        new(array.data() + i) T{std::forward<Args>(args)...};
+}
+
+template<class T, class Allocator> ArrayView<T> arrayAppend(Array<T>& array, NoInitT, const std::size_t count) {
+    return {Implementation::arrayGrowBy<T, Allocator>(array, count), count};
+}
+
+template<class T, class Allocator> ArrayView<T> arrayAppend(Array<T>& array, const typename std::common_type<ArrayView<const T>>::type values) {
+    T* const out = Implementation::arrayGrowBy<T, Allocator>(array, values.size());
+    for(std::size_t i = 0; i != values.size(); ++i)
+        new(out + i) T(values[i]);
+    return {out, values.size()};
+}
+
+template<class T, class Allocator, class... Args> T& arrayAppend(Array<T>& array, InPlaceInitT, Args&&... args) {
+    T* const out = Implementation::arrayGrowBy<T, Allocator>(array, 1);
+    new(out) T{std::forward<Args>(args)...};
+    return *out;
+}
+
+template<class T, class Allocator> T& arrayAppend(Array<T>& array, const typename std::common_type<T>::type& value) {
+    /* The value might point into the array itself, so if it needs to be
+       reallocated, make a copy first */
+    if(array.data() <= &value && &value < array.data() + array.size() && arrayCapacity<T, Allocator>(array) == array.size()) {
+        T copy(value);
+        return arrayAppend<T, Allocator>(array, std::move(copy));
+    }
+
+    T* const out = Implementation::arrayGrowBy<T, Allocator>(array, 1);
+    new(out) T(value);
+    return *out;
+}
+
+template<class T, class Allocator> T& arrayAppend(Array<T>& array, typename std::remove_const<T>::type&& value) {
+    T* const out = Implementation::arrayGrowBy<T, Allocator>(array, 1);
+    new(out) T(std::move(value));
+    return *out;
+}
+
+template<class T, class Allocator> void arrayRemoveSuffix(Array<T>& array, const std::size_t count) {
+    CORRADE_ASSERT(count <= array.size(), "Containers::arrayRemoveSuffix(): can't remove" << count << "elements from an array of size" << array.size(), );
+    if(!count) return;
+
+    const std::size_t size = array.size() - count;
+    if(!arrayIsGrowable<T, Allocator>(array)) {
+        Implementation::arrayConvertToGrowable<T, Allocator>(array, size, size);
+        return;
+    }
+
+    for(std::size_t i = size; i != array.size(); ++i) array[i].~T();
+    Implementation::arrayGuts(array).size = size;
+}
+
+template<class T, class Allocator> std::size_t arrayShrink(Array<T>& array) {
+    if(!arrayIsGrowable<T, Allocator>(array)) return array.size();
+
+    Array<T> newArray{NoInit, array.size()};
+    for(std::size_t i = 0; i != array.size(); ++i)
+        new(newArray.data() + i) T(std::move(array[i]));
+    array = std::move(newArray);
+    return array.size();
+}
+
+}}
+
+#endif
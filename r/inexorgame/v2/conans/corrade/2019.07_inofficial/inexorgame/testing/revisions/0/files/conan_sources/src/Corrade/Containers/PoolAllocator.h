@@ -0,0 +1,311 @@
+#ifndef Corrade_Containers_PoolAllocator_h
+#define Corrade_Containers_PoolAllocator_h
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Corrade::Containers::PoolAllocator
+ * @see @ref Corrade/Containers/ArenaAllocator.h
+ */
+
+#include "Corrade/Containers/ArenaAllocator.h"
+
+namespace Corrade { namespace Containers {
+
+class PoolAllocator;
+
+namespace Implementation {
+    template<class T> void poolDeleter(T* data, std::size_t size);
+}
+
+/**
+@brief Fixed-size block pool allocator
+
+Hands out blocks of a fixed size from larger chunks, keeping the freed blocks
+in a free list. Both allocation and deallocation are just a few pointer
+operations and, once the pool has grown to its peak usage, no heap
+allocations are done anymore. Useful for many small objects of the same size
+that are allocated and freed in an arbitrary order.
+
+Apart from raw @ref allocate() and @ref deallocate(), the @ref array()
+functions return an @ref Array that has a deleter returning the block back to
+the pool, so it can be passed to any API taking an @ref Array:
+
+@code{.cpp}
+Containers::PoolAllocator pool{16*sizeof(Vector3)};
+
+Containers::Array<Vector3> corners = pool.array<Vector3>(8);
+// ...
+@endcode
+
+The pool pointer is stored in front of every block, which is why the deleter
+doesn't need any state. The pool is not thread-safe and it's not movable as
+the blocks point to it.
+
+@attention Arrays allocated from the pool have to be destroyed before the
+    pool itself, otherwise their deleter accesses freed memory.
+
+@see @ref ArenaAllocator
+*/
+class PoolAllocator {
+    public:
+        enum: std::size_t {
+            /** Default count of blocks allocated at once */
+            DefaultBlocksPerChunk = 64,
+
+            /**
+             * Block alignment, guaranteed also by @ref std::malloc() on
+             * common platforms
+             */
+            Alignment = Implementation::AllocatorAlignment
+        };
+
+        /**
+         * @brief Constructor
+         * @param blockSize         Size of a single block in bytes
+         * @param blocksPerChunk    Count of blocks allocated at once
+         *
+         * Doesn't allocate anything, the first chunk is allocated on first
+         * @ref allocate() call. Expects that both @p blockSize and
+         * @p blocksPerChunk are non-zero.
+         */
+        explicit PoolAllocator(std::size_t blockSize, std::size_t blocksPerChunk = DefaultBlocksPerChunk);
+
+        /** @brief Copying is not allowed */
+        PoolAllocator(const PoolAllocator&) = delete;
+
+        /** @brief Moving is not allowed */
+        PoolAllocator(PoolAllocator&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Frees all chunks.
+         */
+        ~PoolAllocator();
+
+        /** @brief Copying is not allowed */
+        PoolAllocator& operator=(const PoolAllocator&) = delete;
+
+        /** @brief Moving is not allowed */
+        PoolAllocator& operator=(PoolAllocator&&) = delete;
+
+        /**
+         * @brief Block size
+         *
+         * The size passed in the constructor, rounded up to @ref Alignment.
+         */
+        std::size_t blockSize() const { return _blockSize; }
+
+        /** @brief Count of blocks allocated at once */
+        std::size_t blocksPerChunk() const { return _blocksPerChunk; }
+
+        /** @brief Count of blocks that are currently in use */
+        std::size_t usedCount() const { return _usedCount; }
+
+        /** @brief Count of all blocks in all chunks */
+        std::size_t capacity() const { return _chunkCount*_blocksPerChunk; }
+
+        /**
+         * @brief Allocate a block
+         *
+         * Returns a block of @ref blockSize() bytes aligned to
+         * @ref Alignment. If there's no free block, a new chunk of
+         * @ref blocksPerChunk() blocks is allocated.
+         */
+        void* allocate();
+
+        /**
+         * @brief Deallocate a block
+         *
+         * Expects that @p block was allocated from this pool. Passing
+         * @cpp nullptr @ce is a no-op.
+         */
+        void deallocate(void* block);
+
+        /**
+         * @brief Allocate a default-initialized array
+         *
+         * Equivalent to @ref Array(DefaultInitT, std::size_t), but the
+         * memory is a block from the pool. Expects that the array fits into
+         * @ref blockSize(). The returned array has a deleter that calls
+         * destructors of the elements and returns the block to the pool. An
+         * empty array doesn't use any block.
+         */
+        template<class T> Array<T> array(std::size_t size) {
+            return array<T>(DefaultInit, size);
+        }
+
+        /** @copydoc array(std::size_t) */
+        template<class T> Array<T> array(DefaultInitT, std::size_t size) {
+            Array<T> out = array<T>(NoInit, size);
+            for(T& i: out) new(&i) T;
+            return out;
+        }
+
+        /**
+         * @brief Allocate a value-initialized array
+         *
+         * Equivalent to @ref Array(ValueInitT, std::size_t), but the memory
+         * is a block from the pool.
+         * @see @ref array(std::size_t)
+         */
+        template<class T> Array<T> array(ValueInitT, std::size_t size) {
+            Array<T> out = array<T>(NoInit, size);
+            for(T& i: out) new(&i) T();
+            return out;
+        }
+
+        /**
+         * @brief Allocate an uninitialized array
+         *
+         * Equivalent to @ref Array(NoInitT, std::size_t), but the memory is
+         * a block from the pool. The elements have to be constructed using
+         * placement new before the array is destroyed.
+         * @see @ref array(std::size_t)
+         */
+        template<class T> Array<T> array(NoInitT, std::size_t size);
+
+        /**
+         * @brief Allocate a direct-initialized array
+         *
+         * Equivalent to @ref Array(DirectInitT, std::size_t, Args&&... args),
+         * but the memory is a block from the pool.
+         * @see @ref array(std::size_t)
+         */
+        template<class T, class... Args> Array<T> array(DirectInitT, std::size_t size, Args&&... args) {
+            Array<T> out = array<T>(NoInit, size);
+            for(T& i: out) new(&i) T{std::forward<Args>(args)...};
+            return out;
+        }
+
+        /**
+         * @brief Allocate an in-place-initialized array
+         *
+         * Equivalent to @ref Array(InPlaceInitT, std::initializer_list<T>),
+         * but the memory is a block from the pool.
+         * @see @ref array(std::size_t)
+         */
+        template<class T> Array<T> array(InPlaceInitT, std::initializer_list<T> list) {
+            Array<T> out = array<T>(NoInit, list.size());
+            std::size_t i = 0;
+            for(const T& item: list) new(out.data() + i++) T{item};
+            return out;
+        }
+
+    private:
+        template<class T> friend void Implementation::poolDeleter(T*, std::size_t);
+
+        /* Every block is prefixed with a pointer to the pool, which makes the
+           deleter stateless. Free blocks store the next free block in their
+           data. */
+        enum: std::size_t {
+            HeaderSize = (sizeof(void*) + Alignment - 1)/Alignment*Alignment
+        };
+
+        static PoolAllocator* owner(void* block) {
+            return *reinterpret_cast<PoolAllocator**>(static_cast<char*>(block) - HeaderSize);
+        }
+
+        void allocateChunk();
+
+        std::size_t _blockSize, _blocksPerChunk;
+        char* _chunks;      /* Linked through the first pointer of a chunk */
+        void* _free;        /* Linked through the block data */
+        std::size_t _chunkCount, _usedCount;
+};
+
+namespace Implementation {
+    template<class T> void poolDeleter(T* data, std::size_t size) {
+        if(!data) return;
+        for(std::size_t i = 0; i != size; ++i) data[i].~T();
+        PoolAllocator::owner(data)->deallocate(data);
+    }
+}
+
+inline PoolAllocator::PoolAllocator(const std::size_t blockSize, const std::size_t blocksPerChunk): _blockSize{(blockSize + Alignment - 1)/Alignment*Alignment}, _blocksPerChunk{blocksPerChunk}, _chunks{}, _free{}, _chunkCount{}, _usedCount{} {
+    CORRADE_ASSERT(blockSize && blocksPerChunk,
+        "Containers::PoolAllocator: block size and count of blocks per chunk is expected to be non-zero but got" << blockSize << "and" << blocksPerChunk, );
+}
+
+inline PoolAllocator::~PoolAllocator() {
+    for(char* chunk = _chunks; chunk; ) {
+        char* const next = *reinterpret_cast<char**>(chunk);
+        delete[] chunk;
+        chunk = next;
+    }
+}
+
+inline void* PoolAllocator::allocate() {
+    if(!_free) allocateChunk();
+
+    void* const block = _free;
+    _free = *static_cast<void**>(block);
+    ++_usedCount;
+    return block;
+}
+
+inline void PoolAllocator::deallocate(void* const block) {
+    if(!block) return;
+    CORRADE_ASSERT(owner(block) == this,
+        "Containers::PoolAllocator::deallocate(): the block was not allocated from this pool", );
+
+    *static_cast<void**>(block) = _free;
+    _free = block;
+    --_usedCount;
+}
+
+inline void PoolAllocator::allocateChunk() {
+    /* The chunk starts with a pointer to the next chunk, padded to
+       alignment, then the blocks follow, each prefixed with the owner */
+    const std::size_t stride = HeaderSize + _blockSize;
+    char* const chunk = new char[HeaderSize + _blocksPerChunk*stride];
+    *reinterpret_cast<char**>(chunk) = _chunks;
+    _chunks = chunk;
+    ++_chunkCount;
+
+    /* Put the blocks into the free list in memory order */
+    for(std::size_t i = _blocksPerChunk; i != 0; --i) {
+        char* const header = chunk + HeaderSize + (i - 1)*stride;
+        *reinterpret_cast<PoolAllocator**>(header) = this;
+        void* const block = header + HeaderSize;
+        *static_cast<void**>(block) = _free;
+        _free = block;
+    }
+}
+
+template<class T> Array<T> PoolAllocator::array(NoInitT, const std::size_t size) {
+    static_assert(alignof(T) <= Alignment,
+        "over-aligned types are not supported");
+    CORRADE_ASSERT(size*sizeof(T) <= _blockSize,
+        "Containers::PoolAllocator::array(): can't fit" << size*sizeof(T) << "bytes into a block of" << _blockSize << "bytes", {});
+
+    if(!size) return Array<T>{nullptr, 0, Implementation::poolDeleter<T>};
+    return Array<T>{static_cast<T*>(allocate()), size, Implementation::poolDeleter<T>};
+}
+
+}}
+
+#endif
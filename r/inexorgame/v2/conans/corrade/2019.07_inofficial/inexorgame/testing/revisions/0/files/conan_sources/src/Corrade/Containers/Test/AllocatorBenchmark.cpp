@@ -0,0 +1,175 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Corrade/Containers/ArenaAllocator.h"
+#include "Corrade/Containers/PoolAllocator.h"
+#include "Corrade/TestSuite/Tester.h"
+
+namespace Corrade { namespace Containers { namespace Test { namespace {
+
+struct AllocatorBenchmark: TestSuite::Tester {
+    explicit AllocatorBenchmark();
+
+    void frameHeap();
+    void frameArena();
+    void frameArenaThreadLocal();
+
+    void smallHeap();
+    void smallPool();
+};
+
+/* Models temporaries of a frame loop -- a few large per-object arrays and
+   a lot of small per-drawable ones. The arrays are only touched so the
+   benchmark measures mainly the allocation cost. */
+enum: std::size_t {
+    ObjectCount = 1000,
+    SmallCount = 200,
+    SmallSize = 8
+};
+
+struct Matrix4 { float data[16]; };
+struct Vector3 { float data[3]; };
+
+AllocatorBenchmark::AllocatorBenchmark() {
+    addBenchmarks({&AllocatorBenchmark::frameHeap,
+                   &AllocatorBenchmark::frameArena,
+                   &AllocatorBenchmark::frameArenaThreadLocal,
+
+                   &AllocatorBenchmark::smallHeap,
+                   &AllocatorBenchmark::smallPool}, 50);
+}
+
+struct Heap {
+    template<class T> Array<T> allocate(std::size_t size) {
+        return Array<T>{NoInit, size};
+    }
+    void reset() {}
+};
+
+struct Arena {
+    template<class T> Array<T> allocate(std::size_t size) {
+        return arena.array<T>(NoInit, size);
+    }
+    void reset() { arena.reset(); }
+
+    ArenaAllocator arena;
+};
+
+struct ThreadLocalArena {
+    template<class T> Array<T> allocate(std::size_t size) {
+        return ArenaAllocator::threadLocal().array<T>(NoInit, size);
+    }
+    void reset() { ArenaAllocator::threadLocal().reset(); }
+};
+
+template<class Allocator> std::size_t frame(Allocator& allocator) {
+    std::size_t sum = 0;
+    {
+        Array<Matrix4> transformations = allocator.template allocate<Matrix4>(ObjectCount);
+        Array<unsigned> visible = allocator.template allocate<unsigned>(ObjectCount);
+        Array<float> distances = allocator.template allocate<float>(ObjectCount);
+        transformations[0].data[0] = 1.0f;
+        visible[0] = 1;
+        distances[0] = 1.0f;
+        sum += visible[0];
+
+        for(std::size_t i = 0; i != SmallCount; ++i) {
+            Array<Vector3> corners = allocator.template allocate<Vector3>(SmallSize);
+            corners[0].data[0] = float(i);
+            sum += std::size_t(corners[0].data[0]) & 1;
+        }
+    }
+    allocator.reset();
+    return sum;
+}
+
+void AllocatorBenchmark::frameHeap() {
+    Heap heap;
+    std::size_t sum = 0;
+    CORRADE_BENCHMARK(1)
+        sum += frame(heap);
+
+    CORRADE_VERIFY(sum);
+}
+
+void AllocatorBenchmark::frameArena() {
+    Arena arena;
+    std::size_t sum = 0;
+    CORRADE_BENCHMARK(1)
+        sum += frame(arena);
+
+    CORRADE_VERIFY(sum);
+    /* After the first frame all temporaries fit into the existing blocks */
+    CORRADE_COMPARE(arena.arena.usedSize(), 0);
+    CORRADE_COMPARE(arena.arena.blockCount(), 2);
+}
+
+void AllocatorBenchmark::frameArenaThreadLocal() {
+    ThreadLocalArena arena;
+    std::size_t sum = 0;
+    CORRADE_BENCHMARK(1)
+        sum += frame(arena);
+
+    CORRADE_VERIFY(sum);
+}
+
+void AllocatorBenchmark::smallHeap() {
+    std::size_t sum = 0;
+    CORRADE_BENCHMARK(1) {
+        Array<Array<Vector3>> arrays{SmallCount};
+        for(std::size_t i = 0; i != SmallCount; ++i) {
+            arrays[i] = Array<Vector3>{NoInit, SmallSize};
+            arrays[i][0].data[0] = float(i);
+        }
+        /* Free every second one and allocate again to fragment a bit */
+        for(std::size_t i = 0; i < SmallCount; i += 2)
+            arrays[i] = Array<Vector3>{NoInit, SmallSize};
+        sum += arrays.size();
+    }
+
+    CORRADE_VERIFY(sum);
+}
+
+void AllocatorBenchmark::smallPool() {
+    PoolAllocator pool{SmallSize*sizeof(Vector3), SmallCount};
+    std::size_t sum = 0;
+    CORRADE_BENCHMARK(1) {
+        Array<Array<Vector3>> arrays{SmallCount};
+        for(std::size_t i = 0; i != SmallCount; ++i) {
+            arrays[i] = pool.array<Vector3>(NoInit, SmallSize);
+            arrays[i][0].data[0] = float(i);
+        }
+        for(std::size_t i = 0; i < SmallCount; i += 2)
+            arrays[i] = pool.array<Vector3>(NoInit, SmallSize);
+        sum += arrays.size();
+    }
+
+    CORRADE_VERIFY(sum);
+    CORRADE_COMPARE(pool.usedCount(), 0);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Corrade::Containers::Test::AllocatorBenchmark)
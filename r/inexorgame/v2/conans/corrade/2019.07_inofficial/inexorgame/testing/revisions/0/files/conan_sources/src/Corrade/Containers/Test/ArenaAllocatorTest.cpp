@@ -0,0 +1,389 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "Corrade/Containers/ArenaAllocator.h"
+#include "Corrade/Containers/GrowableArray.h"
+#include "Corrade/TestSuite/Tester.h"
+#include "Corrade/TestSuite/Compare/Container.h"
+#include "Corrade/Utility/DebugStl.h" /** @todo remove when <sstream> is gone */
+
+namespace Corrade { namespace Containers { namespace Test { namespace {
+
+struct ArenaAllocatorTest: TestSuite::Tester {
+    explicit ArenaAllocatorTest();
+
+    void construct();
+    void constructMove();
+
+    void allocate();
+    void allocateZeroSize();
+    void allocateAligned();
+    void allocateInvalidAlignment();
+    void allocateNewBlock();
+    void allocateLargerThanBlock();
+
+    void reset();
+    void resetReuseLargerBlock();
+    void resetInsertNewBlock();
+
+    void view();
+    void arrayDefaultInit();
+    void arrayValueInit();
+    void arrayNoInit();
+    void arrayDirectInit();
+    void arrayInPlaceInit();
+    void arrayEmpty();
+    void arrayNonTrivial();
+    void arrayGrow();
+
+    void threadLocal();
+};
+
+struct Foo {
+    static int constructed;
+    static int destructed;
+
+    /*implicit*/ Foo(int a = 0) noexcept: a{a} { ++constructed; }
+    Foo(const Foo& other) noexcept: a{other.a} { ++constructed; }
+    ~Foo() { ++destructed; }
+
+    int a;
+};
+
+int Foo::constructed = 0;
+int Foo::destructed = 0;
+
+struct alignas(64) OverAligned {
+    char data[64];
+};
+
+ArenaAllocatorTest::ArenaAllocatorTest() {
+    addTests({&ArenaAllocatorTest::construct,
+              &ArenaAllocatorTest::constructMove,
+
+              &ArenaAllocatorTest::allocate,
+              &ArenaAllocatorTest::allocateZeroSize,
+              &ArenaAllocatorTest::allocateAligned,
+              &ArenaAllocatorTest::allocateInvalidAlignment,
+              &ArenaAllocatorTest::allocateNewBlock,
+              &ArenaAllocatorTest::allocateLargerThanBlock,
+
+              &ArenaAllocatorTest::reset,
+              &ArenaAllocatorTest::resetReuseLargerBlock,
+              &ArenaAllocatorTest::resetInsertNewBlock,
+
+              &ArenaAllocatorTest::view,
+              &ArenaAllocatorTest::arrayDefaultInit,
+              &ArenaAllocatorTest::arrayValueInit,
+              &ArenaAllocatorTest::arrayNoInit,
+              &ArenaAllocatorTest::arrayDirectInit,
+              &ArenaAllocatorTest::arrayInPlaceInit,
+              &ArenaAllocatorTest::arrayEmpty,
+              &ArenaAllocatorTest::arrayNonTrivial,
+              &ArenaAllocatorTest::arrayGrow,
+
+              &ArenaAllocatorTest::threadLocal});
+}
+
+void ArenaAllocatorTest::construct() {
+    ArenaAllocator a{1024};
+    CORRADE_COMPARE(a.blockSize(), 1024);
+    CORRADE_COMPARE(a.usedSize(), 0);
+    CORRADE_COMPARE(a.capacity(), 0);
+    CORRADE_COMPARE(a.blockCount(), 0);
+
+    ArenaAllocator b;
+    CORRADE_COMPARE(b.blockSize(), ArenaAllocator::DefaultBlockSize);
+}
+
+void ArenaAllocatorTest::constructMove() {
+    ArenaAllocator a{1024};
+    void* data = a.allocate(100);
+
+    ArenaAllocator b{std::move(a)};
+    CORRADE_COMPARE(a.capacity(), 0);
+    CORRADE_COMPARE(a.usedSize(), 0);
+    CORRADE_COMPARE(b.blockSize(), 1024);
+    CORRADE_COMPARE(b.capacity(), 1024);
+    CORRADE_COMPARE(b.usedSize(), 100);
+
+    ArenaAllocator c{16};
+    c.allocate(8);
+    c = std::move(b);
+    CORRADE_COMPARE(c.blockSize(), 1024);
+    CORRADE_COMPARE(c.usedSize(), 100);
+    CORRADE_COMPARE(b.blockSize(), 16);
+    CORRADE_COMPARE(b.capacity(), 16);
+
+    /* The allocation continues in the same block */
+    CORRADE_VERIFY(static_cast<char*>(c.allocate(16)) == static_cast<char*>(data) + 112);
+}
+
+void ArenaAllocatorTest::allocate() {
+    ArenaAllocator a{1024};
+
+    char* first = static_cast<char*>(a.allocate(13));
+    CORRADE_VERIFY(first);
+    CORRADE_COMPARE(reinterpret_cast<std::uintptr_t>(first) % ArenaAllocator::DefaultAlignment, 0);
+    CORRADE_COMPARE(a.usedSize(), 13);
+    CORRADE_COMPARE(a.capacity(), 1024);
+    CORRADE_COMPARE(a.blockCount(), 1);
+
+    /* Next allocation is padded to the default alignment */
+    char* second = static_cast<char*>(a.allocate(4));
+    CORRADE_COMPARE(second - first, ArenaAllocator::DefaultAlignment);
+    CORRADE_COMPARE(a.usedSize(), ArenaAllocator::DefaultAlignment + 4);
+
+    /* Smaller alignment packs tightly */
+    char* third = static_cast<char*>(a.allocate(3, 1));
+    CORRADE_COMPARE(third - second, 4);
+    CORRADE_COMPARE(a.usedSize(), ArenaAllocator::DefaultAlignment + 7);
+
+    /* The memory is writable */
+    for(std::size_t i = 0; i != 13; ++i) first[i] = char(i);
+    CORRADE_COMPARE(first[12], 12);
+}
+
+void ArenaAllocatorTest::allocateZeroSize() {
+    ArenaAllocator a{1024};
+    CORRADE_VERIFY(!a.allocate(0));
+    CORRADE_COMPARE(a.blockCount(), 0);
+}
+
+void ArenaAllocatorTest::allocateAligned() {
+    ArenaAllocator a{1024};
+    a.allocate(1, 1);
+
+    void* data = a.allocate(1, 256);
+    CORRADE_COMPARE(reinterpret_cast<std::uintptr_t>(data) % 256, 0);
+
+    /* Over-aligned allocation at the beginning of a fresh block, the block
+       has to be large enough for the worst-case padding */
+    ArenaAllocator b{64};
+    OverAligned* over = b.allocate<OverAligned>(NoInit, 1).data();
+    CORRADE_COMPARE(reinterpret_cast<std::uintptr_t>(over) % 64, 0);
+}
+
+void ArenaAllocatorTest::allocateInvalidAlignment() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    ArenaAllocator a;
+    a.allocate(16, 0);
+    a.allocate(16, 12);
+    CORRADE_COMPARE(out.str(),
+        "Containers::ArenaAllocator::allocate(): alignment 0 is not a power of two\n"
+        "Containers::ArenaAllocator::allocate(): alignment 12 is not a power of two\n");
+}
+
+void ArenaAllocatorTest::allocateNewBlock() {
+    ArenaAllocator a{64};
+    a.allocate(48);
+    CORRADE_COMPARE(a.blockCount(), 1);
+
+    /* Doesn't fit, the rest of the first block is counted as used */
+    a.allocate(32);
+    CORRADE_COMPARE(a.blockCount(), 2);
+    CORRADE_COMPARE(a.capacity(), 128);
+    CORRADE_COMPARE(a.usedSize(), 64 + 32);
+}
+
+void ArenaAllocatorTest::allocateLargerThanBlock() {
+    ArenaAllocator a{64};
+    a.allocate(16);
+
+    void* large = a.allocate(1000);
+    CORRADE_VERIFY(large);
+    CORRADE_COMPARE(a.blockCount(), 2);
+    CORRADE_COMPARE(a.capacity(), 64 + 1000);
+}
+
+void ArenaAllocatorTest::reset() {
+    ArenaAllocator a{64};
+    void* first = a.allocate(48);
+    a.allocate(48);
+    a.allocate(48);
+    CORRADE_COMPARE(a.blockCount(), 3);
+
+    a.reset();
+    CORRADE_COMPARE(a.usedSize(), 0);
+    CORRADE_COMPARE(a.blockCount(), 3);
+    CORRADE_COMPARE(a.capacity(), 3*64);
+
+    /* Same memory handed out again, no new blocks */
+    CORRADE_VERIFY(a.allocate(48) == first);
+    a.allocate(48);
+    a.allocate(48);
+    CORRADE_COMPARE(a.blockCount(), 3);
+}
+
+void ArenaAllocatorTest::resetReuseLargerBlock() {
+    ArenaAllocator a{64};
+    a.allocate(16);
+    void* large = a.allocate(1000);
+    CORRADE_COMPARE(a.blockCount(), 2);
+
+    a.reset();
+    a.allocate(48);
+    /* Doesn't fit into the first, the large second block is reused */
+    CORRADE_VERIFY(a.allocate(500) == large);
+    CORRADE_COMPARE(a.blockCount(), 2);
+}
+
+void ArenaAllocatorTest::resetInsertNewBlock() {
+    ArenaAllocator a{64};
+    a.allocate(48);
+    void* second = a.allocate(48);
+    CORRADE_COMPARE(a.blockCount(), 2);
+
+    a.reset();
+    a.allocate(48);
+    /* Doesn't fit into the second block either, a new one is inserted in
+       between and the second is used after */
+    a.allocate(100);
+    CORRADE_COMPARE(a.blockCount(), 3);
+    CORRADE_VERIFY(a.allocate(48) == second);
+    CORRADE_COMPARE(a.blockCount(), 3);
+}
+
+void ArenaAllocatorTest::view() {
+    ArenaAllocator a;
+    ArrayView<double> view = a.allocate<double>(NoInit, 5);
+    CORRADE_COMPARE(view.size(), 5);
+    CORRADE_COMPARE(reinterpret_cast<std::uintptr_t>(view.data()) % alignof(double), 0);
+    CORRADE_COMPARE(a.usedSize(), 5*sizeof(double));
+}
+
+void ArenaAllocatorTest::arrayDefaultInit() {
+    ArenaAllocator a;
+    Array<int> array = a.array<int>(3);
+    CORRADE_COMPARE(array.size(), 3);
+    CORRADE_VERIFY(array.deleter());
+    CORRADE_COMPARE(a.usedSize(), 3*sizeof(int));
+
+    Array<int> array2 = a.array<int>(DefaultInit, 2);
+    CORRADE_COMPARE(array2.size(), 2);
+}
+
+void ArenaAllocatorTest::arrayValueInit() {
+    ArenaAllocator a;
+    /* Dirty the memory first */
+    for(int& i: a.allocate<int>(NoInit, 4)) i = 0xbadbeef;
+    a.reset();
+
+    Array<int> array = a.array<int>(ValueInit, 4);
+    CORRADE_COMPARE_AS(array, (Array<int>{InPlaceInit, {0, 0, 0, 0}}),
+        TestSuite::Compare::Container);
+}
+
+void ArenaAllocatorTest::arrayNoInit() {
+    ArenaAllocator a;
+    Array<int> array = a.array<int>(NoInit, 3);
+    CORRADE_COMPARE(array.size(), 3);
+    array[0] = 1;
+    array[2] = 3;
+    CORRADE_COMPARE(array[2], 3);
+}
+
+void ArenaAllocatorTest::arrayDirectInit() {
+    ArenaAllocator a;
+    Array<int> array = a.array<int>(DirectInit, 3, -7);
+    CORRADE_COMPARE_AS(array, (Array<int>{InPlaceInit, {-7, -7, -7}}),
+        TestSuite::Compare::Container);
+}
+
+void ArenaAllocatorTest::arrayInPlaceInit() {
+    ArenaAllocator a;
+    Array<int> array = a.array<int>(InPlaceInit, {1, 2, 3});
+    CORRADE_COMPARE_AS(array, (Array<int>{InPlaceInit, {1, 2, 3}}),
+        TestSuite::Compare::Container);
+}
+
+void ArenaAllocatorTest::arrayEmpty() {
+    ArenaAllocator a;
+    Array<int> array = a.array<int>(0);
+    CORRADE_VERIFY(!array.data());
+    CORRADE_COMPARE(array.size(), 0);
+    CORRADE_COMPARE(a.blockCount(), 0);
+}
+
+void ArenaAllocatorTest::arrayNonTrivial() {
+    Foo::constructed = Foo::destructed = 0;
+
+    ArenaAllocator a;
+    {
+        Array<Foo> array = a.array<Foo>(DirectInit, 3, 5);
+        CORRADE_COMPARE(Foo::constructed, 3);
+        CORRADE_COMPARE(array[1].a, 5);
+
+        Array<std::string> strings = a.array<std::string>(InPlaceInit, {
+            "a string that's long enough to not fit into SSO", "b"});
+        CORRADE_COMPARE(strings[0], "a string that's long enough to not fit into SSO");
+    }
+
+    /* The deleter calls destructors */
+    CORRADE_COMPARE(Foo::destructed, 3);
+}
+
+void ArenaAllocatorTest::arrayGrow() {
+    ArenaAllocator a;
+    Array<int> array = a.array<int>(InPlaceInit, {1, 2});
+    const int* prev = array.data();
+    CORRADE_VERIFY(!arrayIsGrowable(array));
+
+    /* The contents get moved to the heap */
+    arrayAppend(array, 3);
+    CORRADE_VERIFY(arrayIsGrowable(array));
+    CORRADE_VERIFY(array.data() != prev);
+    CORRADE_COMPARE_AS(array, (Array<int>{InPlaceInit, {1, 2, 3}}),
+        TestSuite::Compare::Container);
+}
+
+void ArenaAllocatorTest::threadLocal() {
+    ArenaAllocator& a = ArenaAllocator::threadLocal();
+    CORRADE_VERIFY(&a == &ArenaAllocator::threadLocal());
+    CORRADE_COMPARE(a.blockSize(), ArenaAllocator::DefaultBlockSize);
+
+    #ifndef CORRADE_BUILD_MULTITHREADED
+    CORRADE_SKIP("CORRADE_BUILD_MULTITHREADED is not enabled, can't test thread-local instances.");
+    #else
+    ArenaAllocator* other{};
+    std::thread t{[&other]() {
+        other = &ArenaAllocator::threadLocal();
+        other->allocate(16);
+    }};
+    t.join();
+
+    CORRADE_VERIFY(other != &a);
+    #endif
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Corrade::Containers::Test::ArenaAllocatorTest)
@@ -0,0 +1,180 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <string>
+#include <vector>
+
+#include "Corrade/Containers/GrowableArray.h"
+#include "Corrade/TestSuite/Tester.h"
+
+namespace Corrade { namespace Containers { namespace Test { namespace {
+
+struct GrowableArrayBenchmark: TestSuite::Tester {
+    explicit GrowableArrayBenchmark();
+
+    void appendTrivialVector();
+    void appendTrivial();
+    void appendTrivialReservedVector();
+    void appendTrivialReserved();
+    void appendTrivialNoInit();
+
+    void appendNonTrivialVector();
+    void appendNonTrivial();
+
+    void resizeTrivialVector();
+    void resizeTrivialNoInit();
+};
+
+enum: std::size_t {
+    Count = 100000,
+    StringCount = 10000
+};
+
+GrowableArrayBenchmark::GrowableArrayBenchmark() {
+    addBenchmarks({&GrowableArrayBenchmark::appendTrivialVector,
+                   &GrowableArrayBenchmark::appendTrivial,
+                   &GrowableArrayBenchmark::appendTrivialReservedVector,
+                   &GrowableArrayBenchmark::appendTrivialReserved,
+                   &GrowableArrayBenchmark::appendTrivialNoInit,
+
+                   &GrowableArrayBenchmark::appendNonTrivialVector,
+                   &GrowableArrayBenchmark::appendNonTrivial,
+
+                   &GrowableArrayBenchmark::resizeTrivialVector,
+                   &GrowableArrayBenchmark::resizeTrivialNoInit}, 10);
+}
+
+void GrowableArrayBenchmark::appendTrivialVector() {
+    std::size_t size = 0;
+    CORRADE_BENCHMARK(1) {
+        std::vector<int> a;
+        for(std::size_t i = 0; i != Count; ++i) a.push_back(int(i));
+        size += a.size();
+    }
+
+    CORRADE_COMPARE(size, Count);
+}
+
+void GrowableArrayBenchmark::appendTrivial() {
+    std::size_t size = 0;
+    CORRADE_BENCHMARK(1) {
+        Array<int> a;
+        for(std::size_t i = 0; i != Count; ++i) arrayAppend(a, int(i));
+        size += a.size();
+    }
+
+    CORRADE_COMPARE(size, Count);
+}
+
+void GrowableArrayBenchmark::appendTrivialReservedVector() {
+    std::size_t size = 0;
+    CORRADE_BENCHMARK(1) {
+        std::vector<int> a;
+        a.reserve(Count);
+        for(std::size_t i = 0; i != Count; ++i) a.push_back(int(i));
+        size += a.size();
+    }
+
+    CORRADE_COMPARE(size, Count);
+}
+
+void GrowableArrayBenchmark::appendTrivialReserved() {
+    std::size_t size = 0;
+    CORRADE_BENCHMARK(1) {
+        Array<int> a;
+        arrayReserve(a, Count);
+        for(std::size_t i = 0; i != Count; ++i) arrayAppend(a, int(i));
+        size += a.size();
+    }
+
+    CORRADE_COMPARE(size, Count);
+}
+
+void GrowableArrayBenchmark::appendTrivialNoInit() {
+    std::size_t size = 0;
+    CORRADE_BENCHMARK(1) {
+        Array<int> a;
+        for(std::size_t i = 0; i != Count/100; ++i) {
+            ArrayView<int> chunk = arrayAppend(a, NoInit, 100);
+            for(std::size_t j = 0; j != 100; ++j) chunk[j] = int(i*100 + j);
+        }
+        size += a.size();
+    }
+
+    CORRADE_COMPARE(size, Count);
+}
+
+void GrowableArrayBenchmark::appendNonTrivialVector() {
+    std::size_t size = 0;
+    CORRADE_BENCHMARK(1) {
+        std::vector<std::string> a;
+        for(std::size_t i = 0; i != StringCount; ++i)
+            a.emplace_back("a string that doesn't fit into SSO");
+        size += a.size();
+    }
+
+    CORRADE_COMPARE(size, StringCount);
+}
+
+void GrowableArrayBenchmark::appendNonTrivial() {
+    std::size_t size = 0;
+    CORRADE_BENCHMARK(1) {
+        Array<std::string> a;
+        for(std::size_t i = 0; i != StringCount; ++i)
+            arrayAppend(a, InPlaceInit, "a string that doesn't fit into SSO");
+        size += a.size();
+    }
+
+    CORRADE_COMPARE(size, StringCount);
+}
+
+void GrowableArrayBenchmark::resizeTrivialVector() {
+    std::size_t size = 0;
+    CORRADE_BENCHMARK(1) {
+        std::vector<int> a;
+        /* Zero-fills all the memory even though it's overwritten right after */
+        a.resize(Count);
+        for(std::size_t i = 0; i != Count; ++i) a[i] = int(i);
+        size += a.size();
+    }
+
+    CORRADE_COMPARE(size, Count);
+}
+
+void GrowableArrayBenchmark::resizeTrivialNoInit() {
+    std::size_t size = 0;
+    CORRADE_BENCHMARK(1) {
+        Array<int> a;
+        arrayResize(a, NoInit, Count);
+        for(std::size_t i = 0; i != Count; ++i) a[i] = int(i);
+        size += a.size();
+    }
+
+    CORRADE_COMPARE(size, Count);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Corrade::Containers::Test::GrowableArrayBenchmark)
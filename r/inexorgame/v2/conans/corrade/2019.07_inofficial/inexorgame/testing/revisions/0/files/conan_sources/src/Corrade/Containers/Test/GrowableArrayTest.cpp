@@ -0,0 +1,735 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <string>
+
+#include "Corrade/Containers/GrowableArray.h"
+#include "Corrade/TestSuite/Tester.h"
+#include "Corrade/TestSuite/Compare/Container.h"
+#include "Corrade/TestSuite/Compare/Numeric.h"
+#include "Corrade/Utility/DebugStl.h" /** @todo remove when <sstream> is gone */
+#include "Corrade/Utility/FormatStl.h"
+
+namespace Corrade { namespace Containers { namespace Test { namespace {
+
+struct GrowableArrayTest: TestSuite::Tester {
+    explicit GrowableArrayTest();
+
+    template<class T> void reserveFromEmpty();
+    template<class T> void reserveFromNonGrowable();
+    template<class T> void reserveFromGrowable();
+    template<class T> void reserveFromGrowableNoOp();
+
+    template<class T> void resizeFromEmpty();
+    template<class T> void resizeFromNonGrowable();
+    template<class T> void resizeFromGrowable();
+    template<class T> void resizeFromGrowableNoRealloc();
+    template<class T> void resizeSmaller();
+    void resizeNoInit();
+    void resizeDefaultInit();
+    void resizeDirectInit();
+
+    template<class T> void appendFromEmpty();
+    template<class T> void appendFromNonGrowable();
+    template<class T> void appendFromGrowable();
+    template<class T> void appendFromGrowableNoRealloc();
+    template<class T> void appendFromMovedOut();
+    template<class T> void appendCopyFromItself();
+    template<class T> void appendInPlace();
+    template<class T> void appendList();
+    void appendNoInit();
+    void appendGrowthRatio();
+
+    template<class T> void removeSuffix();
+    template<class T> void removeSuffixNonGrowable();
+    void removeSuffixTooMuch();
+
+    template<class T> void shrinkNonGrowable();
+    template<class T> void shrink();
+
+    void explicitAllocator();
+    void nonTriviallyCopyableUsesNewAllocator();
+
+    void moveOnly();
+};
+
+struct Movable {
+    static int constructed;
+    static int destructed;
+    static int moved;
+
+    /*implicit*/ Movable(int a = 0) noexcept: a{a} { ++constructed; }
+    Movable(const Movable& other) noexcept: a{other.a} { ++constructed; }
+    Movable(Movable&& other) noexcept: a{other.a} {
+        ++constructed;
+        ++moved;
+    }
+    ~Movable() { ++destructed; }
+    Movable& operator=(const Movable&) = default;
+    Movable& operator=(Movable&&) = default;
+
+    /* Non-trivial to check the destruction is correct */
+    int a;
+};
+
+int Movable::constructed = 0;
+int Movable::destructed = 0;
+int Movable::moved = 0;
+
+struct MoveOnly {
+    /*implicit*/ MoveOnly(int a = 0) noexcept: a{new int{a}} {}
+    MoveOnly(const MoveOnly&) = delete;
+    MoveOnly(MoveOnly&& other) noexcept: a{other.a} { other.a = nullptr; }
+    ~MoveOnly() { delete a; }
+    MoveOnly& operator=(const MoveOnly&) = delete;
+    MoveOnly& operator=(MoveOnly&& other) noexcept {
+        std::swap(a, other.a);
+        return *this;
+    }
+
+    int* a;
+};
+
+template<class> struct TypeName;
+template<> struct TypeName<int> {
+    static const char* name() { return "int"; }
+};
+template<> struct TypeName<Movable> {
+    static const char* name() { return "Movable"; }
+};
+
+int value(int a) { return a; }
+int value(const Movable& a) { return a.a; }
+
+GrowableArrayTest::GrowableArrayTest() {
+    addTests<GrowableArrayTest>({
+        &GrowableArrayTest::reserveFromEmpty<int>,
+        &GrowableArrayTest::reserveFromEmpty<Movable>,
+        &GrowableArrayTest::reserveFromNonGrowable<int>,
+        &GrowableArrayTest::reserveFromNonGrowable<Movable>,
+        &GrowableArrayTest::reserveFromGrowable<int>,
+        &GrowableArrayTest::reserveFromGrowable<Movable>,
+        &GrowableArrayTest::reserveFromGrowableNoOp<int>,
+        &GrowableArrayTest::reserveFromGrowableNoOp<Movable>,
+
+        &GrowableArrayTest::resizeFromEmpty<int>,
+        &GrowableArrayTest::resizeFromEmpty<Movable>,
+        &GrowableArrayTest::resizeFromNonGrowable<int>,
+        &GrowableArrayTest::resizeFromNonGrowable<Movable>,
+        &GrowableArrayTest::resizeFromGrowable<int>,
+        &GrowableArrayTest::resizeFromGrowable<Movable>,
+        &GrowableArrayTest::resizeFromGrowableNoRealloc<int>,
+        &GrowableArrayTest::resizeFromGrowableNoRealloc<Movable>,
+        &GrowableArrayTest::resizeSmaller<int>,
+        &GrowableArrayTest::resizeSmaller<Movable>,
+        &GrowableArrayTest::resizeNoInit,
+        &GrowableArrayTest::resizeDefaultInit,
+        &GrowableArrayTest::resizeDirectInit,
+
+        &GrowableArrayTest::appendFromEmpty<int>,
+        &GrowableArrayTest::appendFromEmpty<Movable>,
+        &GrowableArrayTest::appendFromNonGrowable<int>,
+        &GrowableArrayTest::appendFromNonGrowable<Movable>,
+        &GrowableArrayTest::appendFromGrowable<int>,
+        &GrowableArrayTest::appendFromGrowable<Movable>,
+        &GrowableArrayTest::appendFromGrowableNoRealloc<int>,
+        &GrowableArrayTest::appendFromGrowableNoRealloc<Movable>,
+        &GrowableArrayTest::appendFromMovedOut<int>,
+        &GrowableArrayTest::appendFromMovedOut<Movable>,
+        &GrowableArrayTest::appendCopyFromItself<int>,
+        &GrowableArrayTest::appendCopyFromItself<Movable>,
+        &GrowableArrayTest::appendInPlace<int>,
+        &GrowableArrayTest::appendInPlace<Movable>,
+        &GrowableArrayTest::appendList<int>,
+        &GrowableArrayTest::appendList<Movable>,
+        &GrowableArrayTest::appendNoInit,
+        &GrowableArrayTest::appendGrowthRatio,
+
+        &GrowableArrayTest::removeSuffix<int>,
+        &GrowableArrayTest::removeSuffix<Movable>,
+        &GrowableArrayTest::removeSuffixNonGrowable<int>,
+        &GrowableArrayTest::removeSuffixNonGrowable<Movable>,
+        &GrowableArrayTest::removeSuffixTooMuch,
+
+        &GrowableArrayTest::shrinkNonGrowable<int>,
+        &GrowableArrayTest::shrinkNonGrowable<Movable>,
+        &GrowableArrayTest::shrink<int>,
+        &GrowableArrayTest::shrink<Movable>,
+
+        &GrowableArrayTest::explicitAllocator,
+        &GrowableArrayTest::nonTriviallyCopyableUsesNewAllocator,
+
+        &GrowableArrayTest::moveOnly});
+}
+
+template<class T> void GrowableArrayTest::reserveFromEmpty() {
+    setTestCaseName(Utility::formatString("reserveFromEmpty<{}>", TypeName<T>::name()));
+
+    Movable::constructed = Movable::destructed = Movable::moved = 0;
+    {
+        Array<T> a;
+        CORRADE_VERIFY(!arrayIsGrowable(a));
+        CORRADE_COMPARE(arrayCapacity(a), 0);
+
+        CORRADE_COMPARE(arrayReserve(a, 100), 100);
+        CORRADE_VERIFY(arrayIsGrowable(a));
+        CORRADE_VERIFY(a.data());
+        CORRADE_COMPARE(a.size(), 0);
+        CORRADE_COMPARE(arrayCapacity(a), 100);
+    }
+
+    /* Nothing is constructed by reserving */
+    CORRADE_COMPARE(Movable::constructed, 0);
+    CORRADE_COMPARE(Movable::destructed, 0);
+}
+
+template<class T> void GrowableArrayTest::reserveFromNonGrowable() {
+    setTestCaseName(Utility::formatString("reserveFromNonGrowable<{}>", TypeName<T>::name()));
+
+    Movable::constructed = Movable::destructed = Movable::moved = 0;
+    {
+        Array<T> a{3};
+        a[0] = 1;
+        a[1] = 2;
+        a[2] = 3;
+        const T* prev = a.data();
+        /* Ignore temporaries from the assignments above */
+        Movable::constructed = Movable::destructed = Movable::moved = 0;
+
+        CORRADE_COMPARE(arrayReserve(a, 100), 100);
+        CORRADE_VERIFY(arrayIsGrowable(a));
+        CORRADE_VERIFY(a.data() != prev);
+        CORRADE_COMPARE(a.size(), 3);
+        CORRADE_COMPARE(arrayCapacity(a), 100);
+        CORRADE_COMPARE(value(a[0]), 1);
+        CORRADE_COMPARE(value(a[1]), 2);
+        CORRADE_COMPARE(value(a[2]), 3);
+    }
+
+    if(std::is_same<T, Movable>::value) {
+        /* 3 moved, 3 originals and 3 moved destructed */
+        CORRADE_COMPARE(Movable::constructed, 3);
+        CORRADE_COMPARE(Movable::moved, 3);
+        CORRADE_COMPARE(Movable::destructed, 6);
+    }
+}
+
+template<class T> void GrowableArrayTest::reserveFromGrowable() {
+    setTestCaseName(Utility::formatString("reserveFromGrowable<{}>", TypeName<T>::name()));
+
+    Movable::constructed = Movable::destructed = Movable::moved = 0;
+    {
+        Array<T> a;
+        arrayAppend(a, T{1});
+        arrayAppend(a, T{2});
+        CORRADE_VERIFY(arrayIsGrowable(a));
+
+        CORRADE_COMPARE(arrayReserve(a, 100), 100);
+        CORRADE_VERIFY(arrayIsGrowable(a));
+        CORRADE_COMPARE(a.size(), 2);
+        CORRADE_COMPARE(arrayCapacity(a), 100);
+        CORRADE_COMPARE(value(a[0]), 1);
+        CORRADE_COMPARE(value(a[1]), 2);
+    }
+
+    CORRADE_COMPARE(Movable::constructed, Movable::destructed);
+}
+
+template<class T> void GrowableArrayTest::reserveFromGrowableNoOp() {
+    setTestCaseName(Utility::formatString("reserveFromGrowableNoOp<{}>", TypeName<T>::name()));
+
+    Array<T> a;
+    arrayReserve(a, 100);
+    const T* prev = a.data();
+
+    /* Smaller capacity is a no-op, the array is never shrunk */
+    CORRADE_COMPARE(arrayReserve(a, 50), 100);
+    CORRADE_COMPARE(arrayReserve(a, 100), 100);
+    CORRADE_VERIFY(a.data() == prev);
+    CORRADE_COMPARE(arrayCapacity(a), 100);
+}
+
+template<class T> void GrowableArrayTest::resizeFromEmpty() {
+    setTestCaseName(Utility::formatString("resizeFromEmpty<{}>", TypeName<T>::name()));
+
+    Movable::constructed = Movable::destructed = Movable::moved = 0;
+    {
+        Array<T> a;
+        arrayResize(a, 3);
+        CORRADE_VERIFY(arrayIsGrowable(a));
+        CORRADE_COMPARE(a.size(), 3);
+        CORRADE_COMPARE(arrayCapacity(a), 3);
+
+        /* Value-initialized */
+        CORRADE_COMPARE(value(a[0]), 0);
+        CORRADE_COMPARE(value(a[1]), 0);
+        CORRADE_COMPARE(value(a[2]), 0);
+    }
+
+    if(std::is_same<T, Movable>::value) {
+        CORRADE_COMPARE(Movable::constructed, 3);
+        CORRADE_COMPARE(Movable::moved, 0);
+        CORRADE_COMPARE(Movable::destructed, 3);
+    }
+}
+
+template<class T> void GrowableArrayTest::resizeFromNonGrowable() {
+    setTestCaseName(Utility::formatString("resizeFromNonGrowable<{}>", TypeName<T>::name()));
+
+    Movable::constructed = Movable::destructed = Movable::moved = 0;
+    {
+        Array<T> a{2};
+        a[0] = 1;
+        a[1] = 2;
+        Movable::constructed = Movable::destructed = Movable::moved = 0;
+        arrayResize(a, 4);
+        CORRADE_VERIFY(arrayIsGrowable(a));
+        CORRADE_COMPARE(a.size(), 4);
+        CORRADE_COMPARE(arrayCapacity(a), 4);
+        CORRADE_COMPARE(value(a[0]), 1);
+        CORRADE_COMPARE(value(a[1]), 2);
+        CORRADE_COMPARE(value(a[2]), 0);
+        CORRADE_COMPARE(value(a[3]), 0);
+    }
+
+    if(std::is_same<T, Movable>::value) {
+        /* 2 moved and 2 new, 2 originals destructed on reallocation */
+        CORRADE_COMPARE(Movable::constructed, 4);
+        CORRADE_COMPARE(Movable::moved, 2);
+        CORRADE_COMPARE(Movable::destructed, 6);
+    }
+}
+
+template<class T> void GrowableArrayTest::resizeFromGrowable() {
+    setTestCaseName(Utility::formatString("resizeFromGrowable<{}>", TypeName<T>::name()));
+
+    Movable::constructed = Movable::destructed = Movable::moved = 0;
+    {
+        Array<T> a;
+        arrayResize(a, 2);
+        a[0] = 1;
+        a[1] = 2;
+        arrayResize(a, 5);
+        CORRADE_VERIFY(arrayIsGrowable(a));
+        CORRADE_COMPARE(a.size(), 5);
+        CORRADE_COMPARE(arrayCapacity(a), 5);
+        CORRADE_COMPARE(value(a[0]), 1);
+        CORRADE_COMPARE(value(a[1]), 2);
+        CORRADE_COMPARE(value(a[4]), 0);
+    }
+
+    CORRADE_COMPARE(Movable::constructed, Movable::destructed);
+}
+
+template<class T> void GrowableArrayTest::resizeFromGrowableNoRealloc() {
+    setTestCaseName(Utility::formatString("resizeFromGrowableNoRealloc<{}>", TypeName<T>::name()));
+
+    Array<T> a;
+    arrayReserve(a, 10);
+    const T* prev = a.data();
+    arrayResize(a, 10);
+    CORRADE_VERIFY(a.data() == prev);
+    CORRADE_COMPARE(a.size(), 10);
+    CORRADE_COMPARE(arrayCapacity(a), 10);
+}
+
+template<class T> void GrowableArrayTest::resizeSmaller() {
+    setTestCaseName(Utility::formatString("resizeSmaller<{}>", TypeName<T>::name()));
+
+    Movable::constructed = Movable::destructed = Movable::moved = 0;
+    {
+        Array<T> a;
+        arrayResize(a, 10);
+        a[1] = 7;
+        const T* prev = a.data();
+        Movable::constructed = Movable::destructed = Movable::moved = 0;
+
+        arrayResize(a, 2);
+        CORRADE_VERIFY(a.data() == prev);
+        CORRADE_COMPARE(a.size(), 2);
+        CORRADE_COMPARE(arrayCapacity(a), 10);
+        CORRADE_COMPARE(value(a[1]), 7);
+
+        /* The excess elements got destructed right away */
+        if(std::is_same<T, Movable>::value)
+            CORRADE_COMPARE(Movable::destructed, 8);
+    }
+
+    if(std::is_same<T, Movable>::value)
+        CORRADE_COMPARE(Movable::destructed, 10);
+}
+
+void GrowableArrayTest::resizeNoInit() {
+    Array<int> a;
+    arrayResize(a, NoInit, 3);
+    CORRADE_VERIFY(arrayIsGrowable(a));
+    CORRADE_COMPARE(a.size(), 3);
+
+    Movable::constructed = Movable::destructed = Movable::moved = 0;
+    {
+        Array<Movable> b;
+        arrayResize(b, NoInit, 3);
+        CORRADE_COMPARE(Movable::constructed, 0);
+        for(std::size_t i = 0; i != 3; ++i) new(&b[i]) Movable{int(i)};
+    }
+
+    CORRADE_COMPARE(Movable::constructed, 3);
+    CORRADE_COMPARE(Movable::destructed, 3);
+}
+
+void GrowableArrayTest::resizeDefaultInit() {
+    Movable::constructed = Movable::destructed = Movable::moved = 0;
+    {
+        Array<Movable> a;
+        arrayResize(a, DefaultInit, 3);
+        CORRADE_VERIFY(arrayIsGrowable(a));
+        CORRADE_COMPARE(a.size(), 3);
+        CORRADE_COMPARE(Movable::constructed, 3);
+    }
+
+    CORRADE_COMPARE(Movable::destructed, 3);
+}
+
+void GrowableArrayTest::resizeDirectInit() {
+    Array<int> a;
+    arrayResize(a, DirectInit, 2, 7);
+    arrayResize(a, DirectInit, 4, -1);
+    CORRADE_VERIFY(arrayIsGrowable(a));
+    CORRADE_COMPARE_AS(a, (Array<int>{InPlaceInit, {7, 7, -1, -1}}),
+        TestSuite::Compare::Container);
+}
+
+template<class T> void GrowableArrayTest::appendFromEmpty() {
+    setTestCaseName(Utility::formatString("appendFromEmpty<{}>", TypeName<T>::name()));
+
+    Movable::constructed = Movable::destructed = Movable::moved = 0;
+    {
+        Array<T> a;
+        T& appended = arrayAppend(a, T{37});
+        CORRADE_VERIFY(arrayIsGrowable(a));
+        CORRADE_COMPARE(a.size(), 1);
+        CORRADE_VERIFY(&appended == &a.back());
+        CORRADE_COMPARE(value(a[0]), 37);
+
+        /* Small arrays are grown to at least 16 bytes including the capacity
+           stored in front */
+        CORRADE_COMPARE(arrayCapacity(a), (16 - sizeof(std::size_t))/sizeof(T));
+    }
+
+    if(std::is_same<T, Movable>::value) {
+        /* The temporary and the moved copy */
+        CORRADE_COMPARE(Movable::constructed, 2);
+        CORRADE_COMPARE(Movable::moved, 1);
+        CORRADE_COMPARE(Movable::destructed, 2);
+    }
+}
+
+template<class T> void GrowableArrayTest::appendFromNonGrowable() {
+    setTestCaseName(Utility::formatString("appendFromNonGrowable<{}>", TypeName<T>::name()));
+
+    Movable::constructed = Movable::destructed = Movable::moved = 0;
+    {
+        Array<T> a{1};
+        a[0] = 28;
+        const T value1{37};
+        arrayAppend(a, value1);
+        CORRADE_VERIFY(arrayIsGrowable(a));
+        CORRADE_COMPARE(a.size(), 2);
+        CORRADE_COMPARE(value(a[0]), 28);
+        CORRADE_COMPARE(value(a[1]), 37);
+    }
+
+    CORRADE_COMPARE(Movable::constructed, Movable::destructed);
+}
+
+template<class T> void GrowableArrayTest::appendFromGrowable() {
+    setTestCaseName(Utility::formatString("appendFromGrowable<{}>", TypeName<T>::name()));
+
+    Movable::constructed = Movable::destructed = Movable::moved = 0;
+    {
+        Array<T> a;
+        for(int i = 0; i != 1000; ++i) arrayAppend(a, T{i});
+        CORRADE_VERIFY(arrayIsGrowable(a));
+        CORRADE_COMPARE(a.size(), 1000);
+        CORRADE_VERIFY(arrayCapacity(a) >= 1000);
+        for(int i = 0; i != 1000; ++i)
+            CORRADE_COMPARE(value(a[i]), i);
+    }
+
+    CORRADE_COMPARE(Movable::constructed, Movable::destructed);
+}
+
+template<class T> void GrowableArrayTest::appendFromGrowableNoRealloc() {
+    setTestCaseName(Utility::formatString("appendFromGrowableNoRealloc<{}>", TypeName<T>::name()));
+
+    Array<T> a;
+    arrayReserve(a, 3);
+    const T* prev = a.data();
+    arrayAppend(a, T{1});
+    arrayAppend(a, T{2});
+    arrayAppend(a, T{3});
+    CORRADE_VERIFY(a.data() == prev);
+    CORRADE_COMPARE(arrayCapacity(a), 3);
+    CORRADE_COMPARE(value(a[2]), 3);
+}
+
+template<class T> void GrowableArrayTest::appendFromMovedOut() {
+    setTestCaseName(Utility::formatString("appendFromMovedOut<{}>", TypeName<T>::name()));
+
+    /* The move leaves the growable deleter in the original, with null data */
+    Array<T> a;
+    arrayAppend(a, T{1});
+    Array<T> b = std::move(a);
+    CORRADE_VERIFY(!a.data());
+    CORRADE_COMPARE(arrayCapacity(a), 0);
+
+    arrayAppend(a, T{2});
+    CORRADE_VERIFY(arrayIsGrowable(a));
+    CORRADE_COMPARE(a.size(), 1);
+    CORRADE_COMPARE(value(a[0]), 2);
+    CORRADE_COMPARE(value(b[0]), 1);
+}
+
+template<class T> void GrowableArrayTest::appendCopyFromItself() {
+    setTestCaseName(Utility::formatString("appendCopyFromItself<{}>", TypeName<T>::name()));
+
+    /* The array gets reallocated while the value points into it */
+    Array<T> a;
+    arrayResize(a, 2);
+    a[0] = 17;
+    a[1] = 35;
+    CORRADE_COMPARE(arrayCapacity(a), 2);
+
+    arrayAppend(a, a[0]);
+    arrayAppend(a, a[1]);
+    CORRADE_COMPARE(a.size(), 4);
+    CORRADE_COMPARE(value(a[2]), 17);
+    CORRADE_COMPARE(value(a[3]), 35);
+}
+
+template<class T> void GrowableArrayTest::appendInPlace() {
+    setTestCaseName(Utility::formatString("appendInPlace<{}>", TypeName<T>::name()));
+
+    Movable::constructed = Movable::destructed = Movable::moved = 0;
+    {
+        Array<T> a;
+        T& appended = arrayAppend(a, InPlaceInit, 25);
+        CORRADE_VERIFY(&appended == &a.back());
+        CORRADE_COMPARE(a.size(), 1);
+        CORRADE_COMPARE(value(a[0]), 25);
+    }
+
+    if(std::is_same<T, Movable>::value) {
+        CORRADE_COMPARE(Movable::constructed, 1);
+        CORRADE_COMPARE(Movable::moved, 0);
+        CORRADE_COMPARE(Movable::destructed, 1);
+    }
+}
+
+template<class T> void GrowableArrayTest::appendList() {
+    setTestCaseName(Utility::formatString("appendList<{}>", TypeName<T>::name()));
+
+    Movable::constructed = Movable::destructed = Movable::moved = 0;
+    {
+        Array<T> a;
+        arrayAppend(a, {T{1}, T{2}});
+        ArrayView<T> appended = arrayAppend(a, {T{3}, T{4}, T{5}});
+        CORRADE_COMPARE(appended.size(), 3);
+        CORRADE_VERIFY(appended.data() == a.data() + 2);
+        CORRADE_COMPARE(a.size(), 5);
+        for(std::size_t i = 0; i != 5; ++i)
+            CORRADE_COMPARE(value(a[i]), int(i + 1));
+
+        /* Appending an empty view is fine too */
+        arrayAppend(a, ArrayView<const T>{});
+        CORRADE_COMPARE(a.size(), 5);
+    }
+
+    CORRADE_COMPARE(Movable::constructed, Movable::destructed);
+}
+
+void GrowableArrayTest::appendNoInit() {
+    Array<int> a;
+    ArrayView<int> appended = arrayAppend(a, NoInit, 3);
+    CORRADE_COMPARE(appended.size(), 3);
+    CORRADE_VERIFY(appended.data() == a.data());
+    appended[0] = 1;
+    appended[1] = 2;
+    appended[2] = 3;
+
+    appended = arrayAppend(a, NoInit, 2);
+    CORRADE_VERIFY(appended.data() == a.data() + 3);
+    appended[0] = 4;
+    appended[1] = 5;
+
+    CORRADE_COMPARE_AS(a, (Array<int>{InPlaceInit, {1, 2, 3, 4, 5}}),
+        TestSuite::Compare::Container);
+}
+
+void GrowableArrayTest::appendGrowthRatio() {
+    Array<char> a;
+    std::size_t reallocations = 0;
+    std::size_t prevCapacity = 0;
+    for(std::size_t i = 0; i != 10000; ++i) {
+        arrayAppend(a, char(i));
+        if(arrayCapacity(a) != prevCapacity) {
+            /* Capacity is never grown by less than 50% */
+            if(prevCapacity) CORRADE_VERIFY(arrayCapacity(a) >= prevCapacity + prevCapacity/2);
+            prevCapacity = arrayCapacity(a);
+            ++reallocations;
+        }
+    }
+
+    /* Amortized growth, not one reallocation per append */
+    CORRADE_COMPARE_AS(reallocations, 25, TestSuite::Compare::Less);
+}
+
+template<class T> void GrowableArrayTest::removeSuffix() {
+    setTestCaseName(Utility::formatString("removeSuffix<{}>", TypeName<T>::name()));
+
+    Movable::constructed = Movable::destructed = Movable::moved = 0;
+    {
+        Array<T> a;
+        arrayAppend(a, {T{1}, T{2}, T{3}, T{4}});
+        const std::size_t capacity = arrayCapacity(a);
+        const T* prev = a.data();
+        const int destructed = Movable::destructed;
+
+        arrayRemoveSuffix(a);
+        arrayRemoveSuffix(a, 2);
+        CORRADE_VERIFY(a.data() == prev);
+        CORRADE_COMPARE(a.size(), 1);
+        CORRADE_COMPARE(arrayCapacity(a), capacity);
+        CORRADE_COMPARE(value(a[0]), 1);
+        if(std::is_same<T, Movable>::value)
+            CORRADE_COMPARE(Movable::destructed, destructed + 3);
+
+        /* Removing nothing is a no-op */
+        arrayRemoveSuffix(a, 0);
+        CORRADE_COMPARE(a.size(), 1);
+    }
+
+    CORRADE_COMPARE(Movable::constructed, Movable::destructed);
+}
+
+template<class T> void GrowableArrayTest::removeSuffixNonGrowable() {
+    setTestCaseName(Utility::formatString("removeSuffixNonGrowable<{}>", TypeName<T>::name()));
+
+    Movable::constructed = Movable::destructed = Movable::moved = 0;
+    {
+        Array<T> a{3};
+        a[0] = 1;
+        a[1] = 2;
+        arrayRemoveSuffix(a);
+        CORRADE_VERIFY(arrayIsGrowable(a));
+        CORRADE_COMPARE(a.size(), 2);
+        CORRADE_COMPARE(value(a[0]), 1);
+        CORRADE_COMPARE(value(a[1]), 2);
+    }
+
+    CORRADE_COMPARE(Movable::constructed, Movable::destructed);
+}
+
+void GrowableArrayTest::removeSuffixTooMuch() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    Array<int> a{3};
+    arrayRemoveSuffix(a, 4);
+    CORRADE_COMPARE(a.size(), 3);
+    CORRADE_COMPARE(out.str(), "Containers::arrayRemoveSuffix(): can't remove 4 elements from an array of size 3\n");
+}
+
+template<class T> void GrowableArrayTest::shrinkNonGrowable() {
+    setTestCaseName(Utility::formatString("shrinkNonGrowable<{}>", TypeName<T>::name()));
+
+    Array<T> a{3};
+    const T* prev = a.data();
+    CORRADE_COMPARE(arrayShrink(a), 3);
+    CORRADE_VERIFY(a.data() == prev);
+    CORRADE_VERIFY(!a.deleter());
+}
+
+template<class T> void GrowableArrayTest::shrink() {
+    setTestCaseName(Utility::formatString("shrink<{}>", TypeName<T>::name()));
+
+    Movable::constructed = Movable::destructed = Movable::moved = 0;
+    {
+        Array<T> a;
+        arrayReserve(a, 10);
+        arrayAppend(a, {T{1}, T{2}, T{3}});
+        CORRADE_COMPARE(arrayShrink(a), 3);
+        CORRADE_VERIFY(!arrayIsGrowable(a));
+        CORRADE_COMPARE(a.size(), 3);
+        CORRADE_COMPARE(arrayCapacity(a), 3);
+        CORRADE_COMPARE(value(a[0]), 1);
+        CORRADE_COMPARE(value(a[2]), 3);
+    }
+
+    CORRADE_COMPARE(Movable::constructed, Movable::destructed);
+}
+
+void GrowableArrayTest::explicitAllocator() {
+    /* A trivially copyable type can use the new allocator as well, but then
+       it's not recognized as growable by the default one */
+    Array<int> a;
+    arrayAppend<int, ArrayNewAllocator<int>>(a, 5);
+    arrayAppend<int, ArrayNewAllocator<int>>(a, {6, 7});
+    CORRADE_VERIFY((arrayIsGrowable<int, ArrayNewAllocator<int>>(a)));
+    CORRADE_VERIFY(!arrayIsGrowable(a));
+    CORRADE_COMPARE(a.size(), 3);
+    CORRADE_COMPARE_AS(a, (Array<int>{InPlaceInit, {5, 6, 7}}),
+        TestSuite::Compare::Container);
+
+    CORRADE_COMPARE((arrayShrink<int, ArrayNewAllocator<int>>(a)), 3);
+    CORRADE_VERIFY(!(arrayIsGrowable<int, ArrayNewAllocator<int>>(a)));
+}
+
+void GrowableArrayTest::nonTriviallyCopyableUsesNewAllocator() {
+    CORRADE_VERIFY((std::is_same<ArrayAllocator<int>, ArrayMallocAllocator<int>>::value));
+    CORRADE_VERIFY((std::is_same<ArrayAllocator<Movable>, ArrayNewAllocator<Movable>>::value));
+    CORRADE_VERIFY((std::is_same<ArrayAllocator<std::string>, ArrayNewAllocator<std::string>>::value));
+}
+
+void GrowableArrayTest::moveOnly() {
+    Array<MoveOnly> a;
+    arrayAppend(a, MoveOnly{1});
+    arrayAppend(a, InPlaceInit, 2);
+    for(int i = 3; i != 100; ++i) arrayAppend(a, MoveOnly{i});
+    arrayResize(a, 119);
+    arrayRemoveSuffix(a, 20);
+    arrayShrink(a);
+
+    CORRADE_COMPARE(a.size(), 99);
+    for(std::size_t i = 0; i != a.size(); ++i) {
+        CORRADE_VERIFY(a[i].a);
+        CORRADE_COMPARE(*a[i].a, int(i + 1));
+    }
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Corrade::Containers::Test::GrowableArrayTest)
@@ -0,0 +1,286 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <vector>
+
+#include "Corrade/Containers/PoolAllocator.h"
+#include "Corrade/TestSuite/Tester.h"
+#include "Corrade/TestSuite/Compare/Container.h"
+#include "Corrade/TestSuite/Compare/Numeric.h"
+#include "Corrade/Utility/DebugStl.h" /** @todo remove when <sstream> is gone */
+
+namespace Corrade { namespace Containers { namespace Test { namespace {
+
+struct PoolAllocatorTest: TestSuite::Tester {
+    explicit PoolAllocatorTest();
+
+    void construct();
+    void constructZero();
+
+    void allocate();
+    void allocateNewChunk();
+    void deallocateReuse();
+    void deallocateNull();
+    void deallocateForeign();
+
+    void arrayDefaultInit();
+    void arrayValueInit();
+    void arrayNoInit();
+    void arrayDirectInit();
+    void arrayInPlaceInit();
+    void arrayEmpty();
+    void arrayTooLarge();
+    void arrayNonTrivial();
+    void arrayMove();
+};
+
+struct Foo {
+    static int constructed;
+    static int destructed;
+
+    /*implicit*/ Foo(int a = 0) noexcept: a{a} { ++constructed; }
+    ~Foo() { ++destructed; }
+
+    int a;
+};
+
+int Foo::constructed = 0;
+int Foo::destructed = 0;
+
+PoolAllocatorTest::PoolAllocatorTest() {
+    addTests({&PoolAllocatorTest::construct,
+              &PoolAllocatorTest::constructZero,
+
+              &PoolAllocatorTest::allocate,
+              &PoolAllocatorTest::allocateNewChunk,
+              &PoolAllocatorTest::deallocateReuse,
+              &PoolAllocatorTest::deallocateNull,
+              &PoolAllocatorTest::deallocateForeign,
+
+              &PoolAllocatorTest::arrayDefaultInit,
+              &PoolAllocatorTest::arrayValueInit,
+              &PoolAllocatorTest::arrayNoInit,
+              &PoolAllocatorTest::arrayDirectInit,
+              &PoolAllocatorTest::arrayInPlaceInit,
+              &PoolAllocatorTest::arrayEmpty,
+              &PoolAllocatorTest::arrayTooLarge,
+              &PoolAllocatorTest::arrayNonTrivial,
+              &PoolAllocatorTest::arrayMove});
+}
+
+void PoolAllocatorTest::construct() {
+    PoolAllocator a{13, 4};
+    /* Rounded up to alignment */
+    CORRADE_COMPARE(a.blockSize(), 16);
+    CORRADE_COMPARE(a.blocksPerChunk(), 4);
+    CORRADE_COMPARE(a.usedCount(), 0);
+    CORRADE_COMPARE(a.capacity(), 0);
+
+    PoolAllocator b{64};
+    CORRADE_COMPARE(b.blocksPerChunk(), PoolAllocator::DefaultBlocksPerChunk);
+}
+
+void PoolAllocatorTest::constructZero() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    PoolAllocator a{0};
+    PoolAllocator b{16, 0};
+    CORRADE_COMPARE(out.str(),
+        "Containers::PoolAllocator: block size and count of blocks per chunk is expected to be non-zero but got 0 and 64\n"
+        "Containers::PoolAllocator: block size and count of blocks per chunk is expected to be non-zero but got 16 and 0\n");
+}
+
+void PoolAllocatorTest::allocate() {
+    PoolAllocator a{24, 4};
+    char* first = static_cast<char*>(a.allocate());
+    char* second = static_cast<char*>(a.allocate());
+    CORRADE_VERIFY(first);
+    CORRADE_VERIFY(second);
+    CORRADE_VERIFY(first != second);
+    CORRADE_COMPARE(reinterpret_cast<std::uintptr_t>(first) % PoolAllocator::Alignment, 0);
+    CORRADE_COMPARE(reinterpret_cast<std::uintptr_t>(second) % PoolAllocator::Alignment, 0);
+    CORRADE_COMPARE(a.usedCount(), 2);
+    CORRADE_COMPARE(a.capacity(), 4);
+
+    /* Blocks are handed out in memory order and don't overlap */
+    CORRADE_COMPARE_AS(std::size_t(second - first), a.blockSize(),
+        TestSuite::Compare::GreaterOrEqual);
+    for(std::size_t i = 0; i != 24; ++i) first[i] = 'a';
+    for(std::size_t i = 0; i != 24; ++i) second[i] = 'b';
+    CORRADE_COMPARE(first[23], 'a');
+
+    a.deallocate(first);
+    a.deallocate(second);
+    CORRADE_COMPARE(a.usedCount(), 0);
+}
+
+void PoolAllocatorTest::allocateNewChunk() {
+    PoolAllocator a{16, 4};
+    std::vector<void*> blocks;
+    for(std::size_t i = 0; i != 10; ++i) blocks.push_back(a.allocate());
+    CORRADE_COMPARE(a.usedCount(), 10);
+    CORRADE_COMPARE(a.capacity(), 12);
+
+    for(void* block: blocks) a.deallocate(block);
+    CORRADE_COMPARE(a.usedCount(), 0);
+    CORRADE_COMPARE(a.capacity(), 12);
+}
+
+void PoolAllocatorTest::deallocateReuse() {
+    PoolAllocator a{16, 4};
+    void* first = a.allocate();
+    a.allocate();
+    a.deallocate(first);
+
+    /* The last freed block is reused */
+    CORRADE_VERIFY(a.allocate() == first);
+    CORRADE_COMPARE(a.capacity(), 4);
+}
+
+void PoolAllocatorTest::deallocateNull() {
+    PoolAllocator a{16};
+    a.deallocate(nullptr);
+    CORRADE_COMPARE(a.usedCount(), 0);
+}
+
+void PoolAllocatorTest::deallocateForeign() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    PoolAllocator a{16}, b{16};
+    void* block = a.allocate();
+    b.deallocate(block);
+    CORRADE_COMPARE(out.str(), "Containers::PoolAllocator::deallocate(): the block was not allocated from this pool\n");
+    CORRADE_COMPARE(b.usedCount(), 0);
+    a.deallocate(block);
+}
+
+void PoolAllocatorTest::arrayDefaultInit() {
+    PoolAllocator a{64};
+    {
+        Array<int> array = a.array<int>(3);
+        CORRADE_COMPARE(array.size(), 3);
+        CORRADE_VERIFY(array.deleter());
+        CORRADE_COMPARE(a.usedCount(), 1);
+
+        Array<int> array2 = a.array<int>(DefaultInit, 16);
+        CORRADE_COMPARE(array2.size(), 16);
+        CORRADE_COMPARE(a.usedCount(), 2);
+    }
+
+    /* The deleter returns the blocks back */
+    CORRADE_COMPARE(a.usedCount(), 0);
+}
+
+void PoolAllocatorTest::arrayValueInit() {
+    PoolAllocator a{16, 1};
+    /* Dirty the memory first */
+    void* block = a.allocate();
+    for(std::size_t i = 0; i != 4; ++i) static_cast<int*>(block)[i] = 0xbadbeef;
+    a.deallocate(block);
+
+    Array<int> array = a.array<int>(ValueInit, 4);
+    CORRADE_VERIFY(array.data() == block);
+    CORRADE_COMPARE_AS(array, (Array<int>{InPlaceInit, {0, 0, 0, 0}}),
+        TestSuite::Compare::Container);
+}
+
+void PoolAllocatorTest::arrayNoInit() {
+    PoolAllocator a{64};
+    Array<int> array = a.array<int>(NoInit, 3);
+    CORRADE_COMPARE(array.size(), 3);
+    array[2] = 3;
+    CORRADE_COMPARE(array[2], 3);
+}
+
+void PoolAllocatorTest::arrayDirectInit() {
+    PoolAllocator a{64};
+    Array<int> array = a.array<int>(DirectInit, 3, -7);
+    CORRADE_COMPARE_AS(array, (Array<int>{InPlaceInit, {-7, -7, -7}}),
+        TestSuite::Compare::Container);
+}
+
+void PoolAllocatorTest::arrayInPlaceInit() {
+    PoolAllocator a{64};
+    Array<int> array = a.array<int>(InPlaceInit, {1, 2, 3});
+    CORRADE_COMPARE_AS(array, (Array<int>{InPlaceInit, {1, 2, 3}}),
+        TestSuite::Compare::Container);
+}
+
+void PoolAllocatorTest::arrayEmpty() {
+    PoolAllocator a{64};
+    {
+        Array<int> array = a.array<int>(0);
+        CORRADE_VERIFY(!array.data());
+        CORRADE_COMPARE(a.usedCount(), 0);
+    }
+    CORRADE_COMPARE(a.capacity(), 0);
+}
+
+void PoolAllocatorTest::arrayTooLarge() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    PoolAllocator a{16};
+    a.array<int>(5);
+    CORRADE_COMPARE(out.str(), "Containers::PoolAllocator::array(): can't fit 20 bytes into a block of 16 bytes\n");
+    CORRADE_COMPARE(a.usedCount(), 0);
+}
+
+void PoolAllocatorTest::arrayNonTrivial() {
+    Foo::constructed = Foo::destructed = 0;
+
+    PoolAllocator a{64};
+    {
+        Array<Foo> array = a.array<Foo>(DirectInit, 3, 5);
+        CORRADE_COMPARE(Foo::constructed, 3);
+        CORRADE_COMPARE(array[1].a, 5);
+    }
+
+    CORRADE_COMPARE(Foo::destructed, 3);
+    CORRADE_COMPARE(a.usedCount(), 0);
+}
+
+void PoolAllocatorTest::arrayMove() {
+    PoolAllocator a{64};
+    Array<int> b;
+    {
+        Array<int> array = a.array<int>(InPlaceInit, {1, 2, 3});
+        b = std::move(array);
+    }
+
+    /* Still in use, only the moved-from array was destroyed */
+    CORRADE_COMPARE(a.usedCount(), 1);
+    CORRADE_COMPARE(b[2], 3);
+
+    b = nullptr;
+    CORRADE_COMPARE(a.usedCount(), 0);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Corrade::Containers::Test::PoolAllocatorTest)
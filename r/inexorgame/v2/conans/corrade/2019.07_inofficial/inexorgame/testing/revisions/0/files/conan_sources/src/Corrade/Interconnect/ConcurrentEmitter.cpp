@@ -0,0 +1,278 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ConcurrentEmitter.h"
+
+#include <algorithm>
+#include <mutex>
+#include <thread>
+
+#include "Corrade/Containers/GrowableArray.h"
+
+namespace Corrade { namespace Interconnect {
+
+namespace Implementation {
+
+struct SignalDataLess {
+    bool operator()(const SignalData& a, const SignalData& b) const {
+        for(std::size_t i = 0; i != FunctionPointerSize; ++i)
+            if(a.data[i] != b.data[i]) return a.data[i] < b.data[i];
+        return false;
+    }
+
+    bool operator()(const ConcurrentConnectionEntry& a, const SignalData& b) const {
+        return operator()(a.signal, b);
+    }
+
+    bool operator()(const SignalData& a, const ConcurrentConnectionEntry& b) const {
+        return operator()(a, b.signal);
+    }
+};
+
+ConcurrentSlot::ConcurrentSlot(ConnectionData&& data, const std::uint64_t id, SlotQueue* const queue, void(*const post)()) noexcept: data{std::move(data)}, id{id}, queue{queue}, post{post}, references{1}, disconnected{false} {}
+
+void retainSlot(ConcurrentSlot& slot) {
+    slot.references.fetch_add(1, std::memory_order_relaxed);
+}
+
+void releaseSlot(ConcurrentSlot& slot) {
+    if(slot.references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        delete &slot;
+}
+
+std::size_t& concurrentCallbackDepth() {
+    #ifdef CORRADE_BUILD_MULTITHREADED
+    CORRADE_THREAD_LOCAL
+    #endif
+    static std::size_t depth = 0;
+    return depth;
+}
+
+}
+
+namespace {
+
+typedef Containers::Array<Implementation::ConcurrentConnectionEntry> Table;
+
+/* A table replaced by a newer one together with slots that were removed in
+   the process. Freed once no reader can see it anymore. */
+struct Retired {
+    Table* table;
+    Containers::Array<Implementation::ConcurrentSlot*> slots;
+};
+
+void reclaim(Containers::ArrayView<Retired> retired) {
+    for(Retired& r: retired) {
+        delete r.table;
+        for(Implementation::ConcurrentSlot* slot: r.slots)
+            Implementation::releaseSlot(*slot);
+    }
+}
+
+/* Copies the table, skipping the [removeBegin, removeEnd) range and
+   inserting an entry at the removeBegin position, if non-null */
+Table* copyTable(const Table* const previous, const std::size_t removeBegin, const std::size_t removeEnd, const Implementation::ConcurrentConnectionEntry* const insert) {
+    const std::size_t size = previous ? previous->size() : 0;
+    Table* const table = new Table{Containers::NoInit, size - (removeEnd - removeBegin) + (insert ? 1 : 0)};
+    std::size_t out = 0;
+    for(std::size_t i = 0; i != removeBegin; ++i)
+        new(&(*table)[out++]) Implementation::ConcurrentConnectionEntry((*previous)[i]);
+    if(insert)
+        new(&(*table)[out++]) Implementation::ConcurrentConnectionEntry(*insert);
+    for(std::size_t i = removeEnd; i != size; ++i)
+        new(&(*table)[out++]) Implementation::ConcurrentConnectionEntry((*previous)[i]);
+    return table;
+}
+
+std::pair<std::size_t, std::size_t> equalRange(const Table* const table, const Implementation::SignalData& signal) {
+    if(!table) return {};
+    const auto range = std::equal_range(table->begin(), table->end(), signal, Implementation::SignalDataLess{});
+    return {std::size_t(range.first - table->begin()), std::size_t(range.second - table->begin())};
+}
+
+}
+
+struct ConcurrentEmitter::State {
+    /* Current connection table, sorted by signal. Null if nothing was
+       connected yet. */
+    std::atomic<Table*> table{};
+    /* Readers register in a counter selected by the lowest bit of the epoch,
+       a writer waits until the counter of the previous epoch drops to zero */
+    std::atomic<std::size_t> epoch{};
+    mutable std::atomic<std::size_t> readers[2]{};
+
+    /* Guards everything below and all table modifications */
+    mutable std::mutex writeMutex;
+    /* Serializes waiting for readers */
+    std::mutex syncMutex;
+    Containers::Array<Retired> retired;
+    std::uint64_t nextId{1};
+
+    /* Replaces the current table, expects writeMutex to be locked */
+    void publish(std::unique_lock<std::mutex>& lock, Table* table, Containers::Array<Implementation::ConcurrentSlot*>&& removed);
+};
+
+void ConcurrentEmitter::State::publish(std::unique_lock<std::mutex>& lock, Table* const table, Containers::Array<Implementation::ConcurrentSlot*>&& removed) {
+    for(Implementation::ConcurrentSlot* slot: removed)
+        slot->disconnected.store(true, std::memory_order_relaxed);
+
+    Containers::arrayAppend(retired, Containers::InPlaceInit, this->table.exchange(table, std::memory_order_acq_rel), std::move(removed));
+
+    /* If we're inside a slot, one of the readers might be this thread and
+       waiting for it would deadlock. Leave the cleanup for later. */
+    if(Implementation::concurrentCallbackDepth()) return;
+
+    Containers::Array<Retired> reclaimed = std::move(retired);
+    lock.unlock();
+
+    /* Advance the epoch so new readers go to the other counter and wait until
+       all readers that could have seen the old tables are done. Readers of
+       epochs before the current one were waited for by previous writers. */
+    {
+        std::lock_guard<std::mutex> syncLock{syncMutex};
+        const std::size_t previous = epoch.fetch_add(1);
+        while(readers[previous & 1].load() != 0)
+            std::this_thread::yield();
+    }
+
+    reclaim(reclaimed);
+}
+
+ConcurrentEmitter::ConcurrentEmitter(): _state{Containers::pointer<State>()} {}
+
+ConcurrentEmitter::~ConcurrentEmitter() {
+    if(Table* table = _state->table.load()) {
+        for(const Implementation::ConcurrentConnectionEntry& entry: *table) {
+            entry.slot->disconnected.store(true, std::memory_order_relaxed);
+            Implementation::releaseSlot(*entry.slot);
+        }
+        delete table;
+    }
+
+    reclaim(_state->retired);
+}
+
+ConcurrentEmitter::Read ConcurrentEmitter::beginRead(const Implementation::SignalData& signal) const {
+    const State& state = *_state;
+
+    /* Register in the counter for current epoch. If the epoch changed in the
+       meantime, the writer might not have seen us, try again. */
+    std::size_t epoch;
+    for(;;) {
+        epoch = state.epoch.load();
+        state.readers[epoch & 1].fetch_add(1);
+        if(state.epoch.load() == epoch) break;
+        state.readers[epoch & 1].fetch_sub(1);
+    }
+
+    ++Implementation::concurrentCallbackDepth();
+
+    const Table* const table = state.table.load(std::memory_order_acquire);
+    if(!table) return {epoch, nullptr, nullptr};
+
+    const auto range = std::equal_range(table->begin(), table->end(), signal, Implementation::SignalDataLess{});
+    return {epoch, range.first, range.second};
+}
+
+void ConcurrentEmitter::endRead(const std::size_t epoch) const {
+    --Implementation::concurrentCallbackDepth();
+    _state->readers[epoch & 1].fetch_sub(1, std::memory_order_release);
+}
+
+bool ConcurrentEmitter::isConnected(const ConcurrentConnection& connection) const {
+    std::lock_guard<std::mutex> lock{_state->writeMutex};
+    const Table* const table = _state->table.load(std::memory_order_relaxed);
+    const std::pair<std::size_t, std::size_t> range = equalRange(table, connection._signal);
+    for(std::size_t i = range.first; i != range.second; ++i)
+        if((*table)[i].slot->id == connection._id) return true;
+
+    return false;
+}
+
+std::size_t ConcurrentEmitter::signalConnectionCount() const {
+    std::lock_guard<std::mutex> lock{_state->writeMutex};
+    const Table* const table = _state->table.load(std::memory_order_relaxed);
+    return table ? table->size() : 0;
+}
+
+std::size_t ConcurrentEmitter::signalConnectionCountInternal(const Implementation::SignalData& signal) const {
+    std::lock_guard<std::mutex> lock{_state->writeMutex};
+    const std::pair<std::size_t, std::size_t> range = equalRange(_state->table.load(std::memory_order_relaxed), signal);
+    return range.second - range.first;
+}
+
+ConcurrentConnection ConcurrentEmitter::connectInternal(const Implementation::SignalData& signal, Implementation::ConnectionData&& data, SlotQueue* const queue, void(*const post)()) {
+    std::unique_lock<std::mutex> lock{_state->writeMutex};
+    const std::uint64_t id = _state->nextId++;
+    const Implementation::ConcurrentConnectionEntry entry{signal, new Implementation::ConcurrentSlot{std::move(data), id, queue, post}};
+
+    /* Insert after all existing connections to the same signal so the slots
+       are called in the order they were connected */
+    const Table* const previous = _state->table.load(std::memory_order_relaxed);
+    const std::size_t position = equalRange(previous, signal).second;
+    _state->publish(lock, copyTable(previous, position, position, &entry), nullptr);
+
+    return ConcurrentConnection{signal, id};
+}
+
+void ConcurrentEmitter::disconnectInternal(const Implementation::SignalData& signal) {
+    std::unique_lock<std::mutex> lock{_state->writeMutex};
+    const Table* const previous = _state->table.load(std::memory_order_relaxed);
+    const std::pair<std::size_t, std::size_t> range = equalRange(previous, signal);
+    if(range.first == range.second) return;
+
+    Containers::Array<Implementation::ConcurrentSlot*> removed{Containers::NoInit, range.second - range.first};
+    for(std::size_t i = range.first; i != range.second; ++i)
+        removed[i - range.first] = (*previous)[i].slot;
+    _state->publish(lock, copyTable(previous, range.first, range.second, nullptr), std::move(removed));
+}
+
+void ConcurrentEmitter::disconnectAllSignals() {
+    std::unique_lock<std::mutex> lock{_state->writeMutex};
+    const Table* const previous = _state->table.load(std::memory_order_relaxed);
+    if(!previous || previous->empty()) return;
+
+    Containers::Array<Implementation::ConcurrentSlot*> removed{Containers::NoInit, previous->size()};
+    for(std::size_t i = 0; i != previous->size(); ++i)
+        removed[i] = (*previous)[i].slot;
+    _state->publish(lock, nullptr, std::move(removed));
+}
+
+bool disconnect(ConcurrentEmitter& emitter, const ConcurrentConnection& connection) {
+    ConcurrentEmitter::State& state = *emitter._state;
+    std::unique_lock<std::mutex> lock{state.writeMutex};
+    const Table* const previous = state.table.load(std::memory_order_relaxed);
+    const std::pair<std::size_t, std::size_t> range = equalRange(previous, connection._signal);
+    for(std::size_t i = range.first; i != range.second; ++i) {
+        if((*previous)[i].slot->id != connection._id) continue;
+
+        state.publish(lock, copyTable(previous, i, i + 1, nullptr), Containers::Array<Implementation::ConcurrentSlot*>{Containers::InPlaceInit, {(*previous)[i].slot}});
+        return true;
+    }
+
+    return false;
+}
+
+}}
@@ -0,0 +1,375 @@
+#ifndef Corrade_Interconnect_ConcurrentEmitter_h
+#define Corrade_Interconnect_ConcurrentEmitter_h
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Corrade::Interconnect::ConcurrentEmitter, @ref Corrade::Interconnect::ConcurrentConnection, function @ref Corrade::Interconnect::connect(), @ref Corrade::Interconnect::disconnect()
+ */
+
+#include <atomic>
+
+#include "Corrade/Containers/GrowableArray.h"
+#include "Corrade/Containers/Pointer.h"
+#include "Corrade/Interconnect/Emitter.h"
+
+namespace Corrade { namespace Interconnect {
+
+namespace Implementation {
+
+/* A connected slot. Referenced from the connection table and from every
+   message that's queued for it in a SlotQueue, deleted once the last
+   reference is gone. */
+struct CORRADE_INTERCONNECT_EXPORT ConcurrentSlot {
+    explicit ConcurrentSlot(ConnectionData&& data, std::uint64_t id, SlotQueue* queue, void(*post)()) noexcept;
+
+    ConnectionData data;
+    std::uint64_t id;
+    /* If non-null, emit() calls post() instead of data.call. The post()
+       returns false if it was told not to wait and the queue is full. */
+    SlotQueue* queue;
+    void(*post)();
+    std::atomic<std::size_t> references;
+    std::atomic<bool> disconnected;
+};
+
+CORRADE_INTERCONNECT_EXPORT void retainSlot(ConcurrentSlot& slot);
+CORRADE_INTERCONNECT_EXPORT void releaseSlot(ConcurrentSlot& slot);
+
+struct ConcurrentConnectionEntry {
+    SignalData signal;
+    ConcurrentSlot* slot;
+};
+
+/* Nesting depth of emit() and SlotQueue::dispatch() calls on current
+   thread, connection changes done inside those don't wait for readers */
+CORRADE_INTERCONNECT_LOCAL std::size_t& concurrentCallbackDepth();
+
+}
+
+/**
+@brief Connection to a @ref ConcurrentEmitter
+
+Returned by @ref Interconnect::connect(EmitterObject&, ConcurrentEmitter::Signal(Emitter::*)(Args...), Functor&&),
+allows to remove the connection later using
+@ref Interconnect::disconnect(ConcurrentEmitter&, const ConcurrentConnection&).
+Similarly to @ref Connection, destruction of the handle does not remove the
+connection.
+*/
+class ConcurrentConnection {
+    private:
+        /* https://bugzilla.gnome.org/show_bug.cgi?id=776986 */
+        #ifndef DOXYGEN_GENERATING_OUTPUT
+        friend ConcurrentEmitter;
+        friend CORRADE_INTERCONNECT_EXPORT bool disconnect(ConcurrentEmitter&, const ConcurrentConnection&);
+        #endif
+
+        explicit ConcurrentConnection(const Implementation::SignalData& signal, std::uint64_t id) noexcept: _signal(signal), _id{id} {}
+
+        Implementation::SignalData _signal;
+        std::uint64_t _id;
+};
+
+/**
+@brief Thread-safe emitter object
+
+A variant of @ref Emitter that can be emitted from and connected to from
+multiple threads at the same time. Signals are implemented the same way as
+with @ref Emitter, only with @ref ConcurrentEmitter::Signal as a return type:
+
+@code{.cpp}
+class Socket: public Interconnect::ConcurrentEmitter {
+    public:
+        Signal received(const std::string& data) {
+            return emit(&Socket::received, data);
+        }
+};
+@endcode
+
+@section Interconnect-ConcurrentEmitter-implementation Implementation details
+
+Instead of a hash map, connections are kept in a single immutable array sorted
+by signal, so @ref emit() is a binary search followed by a linear walk
+through contiguous memory, with no allocation and no locking. A connection
+change makes a modified copy of the array under a mutex and atomically swaps
+it in. The previous array is freed only after all emits that could still see
+it have finished --- each emit registers itself in one of two reader counters
+selected by a global epoch, the writer advances the epoch and waits until the
+counter of the previous epoch drops to zero. This makes connection changes
+considerably more expensive than with @ref Emitter, so the class is meant for
+signals that are emitted often and connected rarely.
+
+With concurrent access, the following holds:
+
+-   Emits running in parallel with a connection change see either the state
+    before or after the change, never anything in between. A slot
+    disconnected from another thread may thus still be called by an emit
+    that started before the disconnect, but not by any emit that started
+    after @ref Interconnect::disconnect(ConcurrentEmitter&, const ConcurrentConnection&)
+    returned.
+-   When called outside of a slot, a disconnect returns only once no emit
+    can call the slot anymore and all resources associated with the
+    connection are freed (unless it's a queued connection with messages still
+    pending, see below). Inside a slot or inside @ref SlotQueue::dispatch(),
+    the freeing is deferred to a later connection change or emitter
+    destruction to avoid a deadlock.
+-   Connections added or removed in a slot don't affect the emit that's
+    currently in progress, slots are always called in the order they were
+    connected.
+-   The emitter can't be destroyed while a signal is being emitted.
+
+Unlike @ref Emitter, only free functions, lambdas and function objects can be
+used as slots, as there's no thread-safe way to automatically remove the
+connection once a @ref Receiver is destroyed.
+
+@section Interconnect-ConcurrentEmitter-queued Queued connections
+
+By default, slots are called directly on the thread that emits the signal.
+When connecting with a @ref SlotQueue, the signal arguments are instead copied
+into a lock-free queue and the slot is called later from whichever thread
+calls @ref SlotQueue::dispatch(), which is useful for example for delivering
+events from a networking thread to the main loop. See the @ref SlotQueue
+documentation for details.
+*/
+class CORRADE_INTERCONNECT_EXPORT ConcurrentEmitter {
+    public:
+        /**
+         * @brief Signature for signals
+         *
+         * See @ref Emitter::Signal for more information.
+         */
+        class Signal {
+            friend ConcurrentEmitter;
+
+            private:
+                constexpr explicit Signal() = default;
+        };
+
+        explicit ConcurrentEmitter();
+
+        /** @brief Copying is not allowed */
+        ConcurrentEmitter(const ConcurrentEmitter&) = delete;
+
+        /** @brief Moving is not allowed */
+        ConcurrentEmitter(ConcurrentEmitter&&) = delete;
+
+        /** @brief Copying is not allowed */
+        ConcurrentEmitter& operator=(const ConcurrentEmitter&) = delete;
+
+        /** @brief Moving is not allowed */
+        ConcurrentEmitter& operator=(ConcurrentEmitter&&) = delete;
+
+        /**
+         * @brief Whether the emitter is connected to any slot
+         *
+         * @see @ref isConnected(), @ref signalConnectionCount()
+         */
+        bool hasSignalConnections() const {
+            return signalConnectionCount() != 0;
+        }
+
+        /**
+         * @brief Whether given signal is connected to any slot
+         *
+         * @see @ref isConnected(), @ref signalConnectionCount()
+         */
+        template<class Emitter, class ...Args> bool hasSignalConnections(Signal(Emitter::*signal)(Args...)) const {
+            return signalConnectionCount(signal) != 0;
+        }
+
+        /**
+         * @brief Whether given connection still exists
+         *
+         * It's the user responsibility to ensure that the @p connection
+         * corresponds to proper @ref ConcurrentEmitter instance.
+         */
+        bool isConnected(const ConcurrentConnection& connection) const;
+
+        /**
+         * @brief Count of connections to this emitter signals
+         *
+         * @see @ref hasSignalConnections()
+         */
+        std::size_t signalConnectionCount() const;
+
+        /**
+         * @brief Count of slots connected to given signal
+         *
+         * @see @ref hasSignalConnections()
+         */
+        template<class Emitter, class ...Args> std::size_t signalConnectionCount(Signal(Emitter::*signal)(Args...)) const {
+            return signalConnectionCountInternal(
+                #ifndef CORRADE_MSVC2019_COMPATIBILITY
+                Implementation::SignalData(signal)
+                #else
+                Implementation::SignalData::create<Emitter, Args...>(signal)
+                #endif
+                );
+        }
+
+        /**
+         * @brief Disconnect signal
+         *
+         * Disconnects all slots connected to given signal.
+         * @see @ref disconnectAllSignals()
+         */
+        template<class Emitter, class ...Args> void disconnectSignal(Signal(Emitter::*signal)(Args...)) {
+            disconnectInternal(
+                #ifndef CORRADE_MSVC2019_COMPATIBILITY
+                Implementation::SignalData(signal)
+                #else
+                Implementation::SignalData::create<Emitter, Args...>(signal)
+                #endif
+                );
+        }
+
+        /**
+         * @brief Disconnect everything from this emitter signals
+         *
+         * @see @ref disconnectSignal()
+         */
+        void disconnectAllSignals();
+
+    protected:
+        /* Nobody will need to have (and delete) ConcurrentEmitter*, thus this
+           is faster than public pure virtual destructor */
+        ~ConcurrentEmitter();
+
+        /**
+         * @brief Emit signal
+         * @param signal        Signal
+         * @param args          Arguments
+         *
+         * Can be called from multiple threads at the same time. Slots with a
+         * queued connection get a copy of the arguments, see
+         * @ref Interconnect-ConcurrentEmitter-queued for more information.
+         */
+        template<class Emitter, class ...Args> Signal emit(Signal(Emitter::*signal)(Args...), typename Implementation::Identity<Args>::Type... args);
+
+    private:
+        struct State;
+        struct Read {
+            std::size_t epoch;
+            const Implementation::ConcurrentConnectionEntry* begin;
+            const Implementation::ConcurrentConnectionEntry* end;
+        };
+
+        /* https://bugzilla.gnome.org/show_bug.cgi?id=776986 */
+        #ifndef DOXYGEN_GENERATING_OUTPUT
+        template<class EmitterObject, class Emitter, class Functor, class ...Args> friend ConcurrentConnection connect(EmitterObject&, Signal(Emitter::*)(Args...), Functor&&);
+        template<class EmitterObject, class Emitter, class Functor, class ...Args> friend ConcurrentConnection connect(EmitterObject&, Signal(Emitter::*)(Args...), SlotQueue&, Functor&&);
+        friend CORRADE_INTERCONNECT_EXPORT bool disconnect(ConcurrentEmitter&, const ConcurrentConnection&);
+        #endif
+
+        /* Registers current thread as a reader and returns the range of
+           connections for given signal, which stays valid until endRead() */
+        Read beginRead(const Implementation::SignalData& signal) const;
+        void endRead(std::size_t epoch) const;
+
+        std::size_t signalConnectionCountInternal(const Implementation::SignalData& signal) const;
+        ConcurrentConnection connectInternal(const Implementation::SignalData& signal, Implementation::ConnectionData&& data, SlotQueue* queue, void(*post)());
+        void disconnectInternal(const Implementation::SignalData& signal);
+
+        Containers::Pointer<State> _state;
+};
+
+/** @relatesalso ConcurrentEmitter
+@brief Connect signal to function slot
+@param emitter       Emitter
+@param signal        Signal
+@param slot          Slot
+
+Equivalent to @ref connect(EmitterObject&, Interconnect::Emitter::Signal(Emitter::*)(Args...), Functor&&)
+for a @ref ConcurrentEmitter. The slot gets called directly on the thread that
+emits the signal. The function is thread-safe, see
+@ref Interconnect-ConcurrentEmitter-implementation for details.
+@see @ref connect(EmitterObject&, ConcurrentEmitter::Signal(Emitter::*)(Args...), SlotQueue&, Functor&&)
+*/
+template<class EmitterObject, class Emitter, class Functor, class ...Args> ConcurrentConnection connect(EmitterObject& emitter, ConcurrentEmitter::Signal(Emitter::*signal)(Args...), Functor&& slot) {
+    static_assert(sizeof(ConcurrentEmitter::Signal(Emitter::*)(Args...)) <= sizeof(Implementation::SignalData),
+        "size of member function pointer is incorrectly assumed to be smaller");
+    static_assert(std::is_base_of<Emitter, EmitterObject>::value,
+        "Emitter object doesn't have given signal");
+
+    #ifndef CORRADE_MSVC2019_COMPATIBILITY
+    Implementation::SignalData signalData(signal);
+    #else
+    auto signalData = Implementation::SignalData::create<Emitter, Args...>(signal);
+    #endif
+    return emitter.connectInternal(signalData, Implementation::ConnectionData::createFunctor<Args...>(std::forward<Functor>(slot)), nullptr, nullptr);
+}
+
+/** @relatesalso ConcurrentEmitter
+@brief Disconnect a concurrent signal/slot connection
+@param emitter      Emitter
+@param connection   Connection handle returned by @ref connect()
+
+Returns @cpp false @ce if the connection doesn't exist anymore. It's the user
+responsibility to ensure that @p connection corresponds to given @p emitter
+instance. The function is thread-safe, see
+@ref Interconnect-ConcurrentEmitter-implementation for details.
+*/
+CORRADE_INTERCONNECT_EXPORT bool disconnect(ConcurrentEmitter& emitter, const ConcurrentConnection& connection);
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+template<class Emitter_, class ...Args> ConcurrentEmitter::Signal ConcurrentEmitter::emit(Signal(Emitter_::*signal)(Args...), typename Implementation::Identity<Args>::Type... args) {
+    const Read read = beginRead(
+        #ifndef CORRADE_MSVC2019_COMPATIBILITY
+        Implementation::SignalData(signal)
+        #else
+        Implementation::SignalData::create<Emitter_, Args...>(signal)
+        #endif
+        );
+    typedef bool(*Post)(Implementation::ConcurrentSlot&, bool, typename std::add_lvalue_reference<Args>::type...);
+
+    /* Queued slots whose queue was full. Waiting for the queue while being
+       registered as a reader would deadlock if the dispatching thread
+       changed connections in the meantime, so these are retained and posted
+       only after the read is done. Once one post is deferred, all following
+       ones are too, to keep the order. */
+    Containers::Array<Implementation::ConcurrentSlot*> deferred;
+    for(const Implementation::ConcurrentConnectionEntry* it = read.begin; it != read.end; ++it) {
+        Implementation::ConcurrentSlot& slot = *it->slot;
+        if(!slot.queue)
+            reinterpret_cast<void(*)(Implementation::ConnectionData::Storage&, Args&&...)>(slot.data.call)(slot.data.storage, std::forward<Args>(args)...);
+        else if(!deferred.empty() || !reinterpret_cast<Post>(slot.post)(slot, false, args...)) {
+            Implementation::retainSlot(slot);
+            Containers::arrayAppend(deferred, &slot);
+        }
+    }
+    endRead(read.epoch);
+
+    for(Implementation::ConcurrentSlot* slot: deferred) {
+        reinterpret_cast<Post>(slot->post)(*slot, true, args...);
+        Implementation::releaseSlot(*slot);
+    }
+
+    return Signal();
+}
+#endif
+
+}}
+
+#endif
@@ -39,6 +39,7 @@ namespace Corrade { namespace Interconnect {
 
 namespace Implementation {
     struct SignalDataHash;
+    struct SignalDataLess;
 
     enum: std::size_t { FunctionPointerSize =
         #ifndef CORRADE_TARGET_WINDOWS
@@ -92,6 +93,7 @@ namespace Implementation {
             #ifndef DOXYGEN_GENERATING_OUTPUT
             friend Interconnect::Emitter;
             friend SignalDataHash;
+            friend SignalDataLess;
             #endif
 
             #ifdef CORRADE_MSVC2019_COMPATIBILITY
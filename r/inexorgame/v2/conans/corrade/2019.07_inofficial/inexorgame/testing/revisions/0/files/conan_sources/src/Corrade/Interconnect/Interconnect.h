@@ -33,9 +33,12 @@
 
 namespace Corrade { namespace Interconnect {
 
+class ConcurrentConnection;
+class ConcurrentEmitter;
 class Connection;
 class Emitter;
 class Receiver;
+class SlotQueue;
 
 namespace Implementation {
     struct ConnectionData;
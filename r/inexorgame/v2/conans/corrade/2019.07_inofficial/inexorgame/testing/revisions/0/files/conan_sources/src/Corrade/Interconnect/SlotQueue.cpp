@@ -0,0 +1,113 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "SlotQueue.h"
+
+#include <thread>
+
+#include "Corrade/Utility/Assert.h"
+
+namespace Corrade { namespace Interconnect {
+
+namespace {
+    std::size_t roundUpToPowerOfTwo(const std::size_t value) {
+        std::size_t out = 1;
+        while(out < value) out <<= 1;
+        return out;
+    }
+}
+
+SlotQueue::SlotQueue(const std::size_t capacity): _messages{roundUpToPowerOfTwo(capacity)}, _enqueuePosition{0}, _padding{}, _dequeuePosition{0}, _dispatching{false} {
+    /* A cell is free for a push at position i if its sequence is i and ready
+       for a pop at position i if its sequence is i + 1 */
+    for(std::size_t i = 0; i != _messages.size(); ++i)
+        _messages[i].sequence.store(i, std::memory_order_relaxed);
+
+    CORRADE_ASSERT(capacity,
+        "Interconnect::SlotQueue: capacity is expected to be non-zero", );
+}
+
+SlotQueue::~SlotQueue() {
+    process(~std::size_t{}, false);
+}
+
+std::size_t SlotQueue::acquire(const bool wait) {
+    std::size_t position = _enqueuePosition.load(std::memory_order_relaxed);
+    for(;;) {
+        const std::size_t sequence = message(position).sequence.load(std::memory_order_acquire);
+        const std::ptrdiff_t difference = std::ptrdiff_t(sequence) - std::ptrdiff_t(position);
+
+        /* The cell is free, try to claim it. On failure position gets updated
+           with the current value. */
+        if(difference == 0) {
+            if(_enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                return position;
+
+        /* The queue is full, wait for dispatch() to make room */
+        } else if(difference < 0) {
+            if(!wait) return ~std::size_t{};
+            std::this_thread::yield();
+            position = _enqueuePosition.load(std::memory_order_relaxed);
+
+        /* Another thread claimed the cell, try again with the next one */
+        } else position = _enqueuePosition.load(std::memory_order_relaxed);
+    }
+}
+
+std::size_t SlotQueue::dispatch(const std::size_t maxCount) {
+    #ifndef CORRADE_NO_ASSERT
+    const bool dispatching =
+    #endif
+    _dispatching.exchange(true, std::memory_order_acquire);
+    CORRADE_ASSERT(!dispatching,
+        "Interconnect::SlotQueue::dispatch(): can't be called recursively or from multiple threads", {});
+
+    /* Connection changes done by the slots shouldn't wait for emits, as those
+       could be waiting for us to make room in the queue */
+    ++Implementation::concurrentCallbackDepth();
+    const std::size_t count = process(maxCount, true);
+    --Implementation::concurrentCallbackDepth();
+
+    _dispatching.store(false, std::memory_order_release);
+    return count;
+}
+
+std::size_t SlotQueue::process(const std::size_t maxCount, const bool call) {
+    std::size_t count = 0;
+    for(; count != maxCount; ++count, ++_dequeuePosition) {
+        Implementation::QueuedMessage& m = message(_dequeuePosition);
+        if(m.sequence.load(std::memory_order_acquire) != _dequeuePosition + 1)
+            break;
+
+        m.handle(m, call);
+
+        /* Make the cell free for the push one round later */
+        m.sequence.store(_dequeuePosition + _messages.size(), std::memory_order_release);
+    }
+
+    return count;
+}
+
+}}
@@ -0,0 +1,268 @@
+#ifndef Corrade_Interconnect_SlotQueue_h
+#define Corrade_Interconnect_SlotQueue_h
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Corrade::Interconnect::SlotQueue, function @ref Corrade::Interconnect::connect()
+ */
+
+#include <new>
+#include <tuple>
+
+#include "Corrade/Containers/Array.h"
+#include "Corrade/Interconnect/ConcurrentEmitter.h"
+
+namespace Corrade { namespace Interconnect {
+
+namespace Implementation {
+
+/* A cell of the SlotQueue ring buffer */
+struct QueuedMessage {
+    union Payload {
+        char data[6*sizeof(void*)];
+        void* pointer;
+        double alignDouble;
+        long long alignLongLong;
+    };
+
+    std::atomic<std::size_t> sequence;
+    /* Calls the slot if the second argument is true and it's still
+       connected, then destroys the arguments and releases the slot */
+    void(*handle)(QueuedMessage&, bool);
+    ConcurrentSlot* slot;
+    Payload payload;
+};
+
+template<std::size_t ...> struct QueuedSequence {};
+
+template<class A, class B> struct QueuedSequenceConcat;
+template<std::size_t ...first, std::size_t ...second> struct QueuedSequenceConcat<QueuedSequence<first...>, QueuedSequence<second...>> {
+    typedef QueuedSequence<first..., (sizeof...(first) + second)...> Type;
+};
+
+template<std::size_t N> struct GenerateQueuedSequence:
+    QueuedSequenceConcat<typename GenerateQueuedSequence<N/2>::Type,
+                         typename GenerateQueuedSequence<N - N/2>::Type> {};
+template<> struct GenerateQueuedSequence<1> { typedef QueuedSequence<0> Type; };
+template<> struct GenerateQueuedSequence<0> { typedef QueuedSequence<> Type; };
+
+/* Signal arguments are copied into the queue, so references are decayed to
+   values */
+template<class ...Args> struct QueuedArguments {
+    typedef std::tuple<typename std::decay<Args>::type...> Type;
+    enum: bool { Inline = sizeof(Type) <= sizeof(QueuedMessage::Payload) && alignof(Type) <= alignof(QueuedMessage::Payload) };
+};
+
+template<class ...Args, std::size_t ...sequence> void callQueued(ConcurrentSlot& slot, typename QueuedArguments<Args...>::Type& arguments, QueuedSequence<sequence...>) {
+    reinterpret_cast<void(*)(ConnectionData::Storage&, Args&&...)>(slot.data.call)(slot.data.storage, std::forward<Args>(std::get<sequence>(arguments))...);
+}
+
+template<class ...Args> void handleQueued(QueuedMessage& message, bool call) {
+    typedef typename QueuedArguments<Args...>::Type Arguments;
+    Arguments& arguments = QueuedArguments<Args...>::Inline ?
+        *reinterpret_cast<Arguments*>(message.payload.data) :
+        *static_cast<Arguments*>(message.payload.pointer);
+
+    if(call && !message.slot->disconnected.load(std::memory_order_relaxed))
+        callQueued<Args...>(*message.slot, arguments, typename GenerateQueuedSequence<sizeof...(Args)>::Type{});
+
+    if(QueuedArguments<Args...>::Inline) arguments.~Arguments();
+    else delete &arguments;
+    releaseSlot(*message.slot);
+}
+
+}
+
+/**
+@brief Queue for cross-thread slot calls
+
+Allows signals of a @ref ConcurrentEmitter emitted on one thread to be
+delivered to slots on another thread. A slot connected using
+@ref connect(EmitterObject&, ConcurrentEmitter::Signal(Emitter::*)(Args...), SlotQueue&, Functor&&)
+is not called directly by the emitting thread. Instead, the signal arguments
+are copied into the queue and the slot is called once the receiving thread
+calls @ref dispatch():
+
+@code{.cpp}
+Socket socket;
+Interconnect::SlotQueue queue;
+Interconnect::connect(socket, &Socket::received, queue, [](const std::string& data) {
+    // called on the main thread
+});
+
+// networking thread
+socket.received(data);
+
+// main loop
+queue.dispatch();
+@endcode
+
+The queue is a bounded lock-free ring buffer that any number of threads can
+push to at the same time, while only one thread is allowed to
+@ref dispatch() it. Messages from a single emitting thread are delivered in
+the order they were emitted. Arguments of up to six pointers in size are
+stored directly in the ring buffer, larger arguments are allocated on the
+heap.
+
+If the queue is full, the emitting thread waits until the receiving thread
+makes room by calling @ref dispatch(). The waiting is done only after all
+directly connected slots of given emit were called, so the receiving thread
+can still change connections of the emitter meanwhile. A slot called from
+@ref dispatch() however shouldn't emit signals that are queued to the same
+queue, as that could block forever if the queue is full.
+
+A slot that's disconnected while it has messages pending in the queue isn't
+called for them anymore, however the messages stay in the queue until
+dispatched. Both the emitter and the queue can be destroyed while messages
+are still pending, the queue destructor discards them without calling the
+slots.
+*/
+class CORRADE_INTERCONNECT_EXPORT SlotQueue {
+    public:
+        /**
+         * @brief Constructor
+         * @param capacity  Count of messages the queue can hold. Rounded up to
+         *      the nearest power of two, expected to be non-zero.
+         */
+        explicit SlotQueue(std::size_t capacity = 1024);
+
+        /** @brief Copying is not allowed */
+        SlotQueue(const SlotQueue&) = delete;
+
+        /** @brief Moving is not allowed */
+        SlotQueue(SlotQueue&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Discards all pending messages without calling their slots. Expects
+         * that no signals are being queued at the same time.
+         */
+        ~SlotQueue();
+
+        /** @brief Copying is not allowed */
+        SlotQueue& operator=(const SlotQueue&) = delete;
+
+        /** @brief Moving is not allowed */
+        SlotQueue& operator=(SlotQueue&&) = delete;
+
+        /** @brief Count of messages the queue can hold */
+        std::size_t capacity() const { return _messages.size(); }
+
+        /**
+         * @brief Call slots for pending messages
+         * @param maxCount  Max count of messages to process
+         * @return Count of processed messages
+         *
+         * Calls slots for messages in the queue until the queue is empty or
+         * @p maxCount messages are processed. Messages queued during the call
+         * may or may not be processed. Can't be called recursively from a
+         * slot or from more than one thread at the same time.
+         */
+        std::size_t dispatch(std::size_t maxCount = ~std::size_t{});
+
+    private:
+        /* https://bugzilla.gnome.org/show_bug.cgi?id=776986 */
+        #ifndef DOXYGEN_GENERATING_OUTPUT
+        template<class EmitterObject, class Emitter, class Functor, class ...Args> friend ConcurrentConnection connect(EmitterObject&, ConcurrentEmitter::Signal(Emitter::*)(Args...), SlotQueue&, Functor&&);
+        #endif
+
+        /* Called by ConcurrentEmitter::emit() through ConcurrentSlot::post.
+           If wait is false and the queue is full, returns false without
+           posting. */
+        template<class ...Args> static bool post(Implementation::ConcurrentSlot& slot, bool wait, typename std::add_lvalue_reference<Args>::type... args);
+
+        /* Claims a message cell. If the queue is full, waits until there's
+           room or returns ~std::size_t{} if wait is false. The cell becomes
+           visible to dispatch() after commit(). */
+        std::size_t acquire(bool wait);
+        Implementation::QueuedMessage& message(std::size_t position) {
+            return _messages[position & (_messages.size() - 1)];
+        }
+        void commit(std::size_t position) {
+            message(position).sequence.store(position + 1, std::memory_order_release);
+        }
+
+        CORRADE_INTERCONNECT_LOCAL std::size_t process(std::size_t maxCount, bool call);
+
+        Containers::Array<Implementation::QueuedMessage> _messages;
+        std::atomic<std::size_t> _enqueuePosition;
+        /* Keeping the producer and consumer state on separate cache lines */
+        char _padding[64 - sizeof(std::atomic<std::size_t>)];
+        std::size_t _dequeuePosition;
+        std::atomic<bool> _dispatching;
+};
+
+/** @relatesalso ConcurrentEmitter
+@brief Connect signal to a queued function slot
+@param emitter       Emitter
+@param signal        Signal
+@param queue         Queue to deliver the signal through
+@param slot          Slot
+
+Similar to @ref connect(EmitterObject&, ConcurrentEmitter::Signal(Emitter::*)(Args...), Functor&&),
+but instead of calling @p slot directly, the emit copies the signal arguments
+into @p queue and the slot gets called from @ref SlotQueue::dispatch(). The
+@p queue is expected to stay alive for as long as the connection exists. See
+@ref SlotQueue for more information.
+*/
+template<class EmitterObject, class Emitter, class Functor, class ...Args> ConcurrentConnection connect(EmitterObject& emitter, ConcurrentEmitter::Signal(Emitter::*signal)(Args...), SlotQueue& queue, Functor&& slot) {
+    static_assert(sizeof(ConcurrentEmitter::Signal(Emitter::*)(Args...)) <= sizeof(Implementation::SignalData),
+        "size of member function pointer is incorrectly assumed to be smaller");
+    static_assert(std::is_base_of<Emitter, EmitterObject>::value,
+        "Emitter object doesn't have given signal");
+
+    #ifndef CORRADE_MSVC2019_COMPATIBILITY
+    Implementation::SignalData signalData(signal);
+    #else
+    auto signalData = Implementation::SignalData::create<Emitter, Args...>(signal);
+    #endif
+    return emitter.connectInternal(signalData, Implementation::ConnectionData::createFunctor<Args...>(std::forward<Functor>(slot)), &queue, reinterpret_cast<void(*)()>(static_cast<bool(*)(Implementation::ConcurrentSlot&, bool, typename std::add_lvalue_reference<Args>::type...)>(SlotQueue::post<Args...>)));
+}
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+template<class ...Args> bool SlotQueue::post(Implementation::ConcurrentSlot& slot, const bool wait, typename std::add_lvalue_reference<Args>::type... args) {
+    typedef typename Implementation::QueuedArguments<Args...>::Type Arguments;
+
+    SlotQueue& queue = *slot.queue;
+    const std::size_t position = queue.acquire(wait);
+    if(position == ~std::size_t{}) return false;
+    Implementation::QueuedMessage& message = queue.message(position);
+    if(Implementation::QueuedArguments<Args...>::Inline)
+        new(message.payload.data) Arguments{args...};
+    else
+        message.payload.pointer = new Arguments{args...};
+    message.handle = Implementation::handleQueued<Args...>;
+    message.slot = &slot;
+    Implementation::retainSlot(slot);
+    queue.commit(position);
+    return true;
+}
+#endif
+
+}}
+
+#endif
@@ -0,0 +1,310 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <mutex>
+
+#include "Corrade/Interconnect/ConcurrentEmitter.h"
+#include "Corrade/Interconnect/SlotQueue.h"
+#include "Corrade/TestSuite/Tester.h"
+
+#if defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+#include <thread>
+#endif
+
+namespace Corrade { namespace Interconnect { namespace Test { namespace {
+
+struct ConcurrentEmitterBenchmark: TestSuite::Tester {
+    explicit ConcurrentEmitterBenchmark();
+
+    void connect1kEmitter();
+    void connect1kConcurrentEmitter();
+
+    void emit1000xEmitter();
+    void emit1000xConcurrentEmitter();
+    void emit1kSlotsEmitter();
+    void emit1kSlotsConcurrentEmitter();
+    void emit64SignalsEmitter();
+    void emit64SignalsConcurrentEmitter();
+    void emit1000xQueued();
+
+    void emitThreadedMutexEmitter();
+    void emitThreadedConcurrentEmitter();
+    void emitThreadedQueued();
+};
+
+ConcurrentEmitterBenchmark::ConcurrentEmitterBenchmark() {
+    addBenchmarks({&ConcurrentEmitterBenchmark::connect1kEmitter,
+                   &ConcurrentEmitterBenchmark::connect1kConcurrentEmitter}, 10);
+
+    addBenchmarks({&ConcurrentEmitterBenchmark::emit1000xEmitter,
+                   &ConcurrentEmitterBenchmark::emit1000xConcurrentEmitter,
+                   &ConcurrentEmitterBenchmark::emit1kSlotsEmitter,
+                   &ConcurrentEmitterBenchmark::emit1kSlotsConcurrentEmitter,
+                   &ConcurrentEmitterBenchmark::emit64SignalsEmitter,
+                   &ConcurrentEmitterBenchmark::emit64SignalsConcurrentEmitter,
+                   &ConcurrentEmitterBenchmark::emit1000xQueued}, 25);
+
+    addBenchmarks({&ConcurrentEmitterBenchmark::emitThreadedMutexEmitter,
+                   &ConcurrentEmitterBenchmark::emitThreadedConcurrentEmitter,
+                   &ConcurrentEmitterBenchmark::emitThreadedQueued}, 5);
+}
+
+int globalOutput;
+
+CORRADE_NEVER_INLINE void freeFunctionSlot(int value) {
+    globalOutput += value;
+}
+
+struct E: Emitter {
+    Signal fire(int value) {
+        return emit(&E::fire, value);
+    }
+
+    template<int i> Signal numbered(int value) {
+        #ifdef _MSC_VER /* See TemplatedPostman in Test.cpp */
+        _functionHash = i;
+        #endif
+        return emit(&E::numbered<i>, value);
+    }
+
+    #ifdef _MSC_VER
+    int _functionHash;
+    #endif
+};
+
+struct CE: ConcurrentEmitter {
+    Signal fire(int value) {
+        return emit(&CE::fire, value);
+    }
+
+    template<int i> Signal numbered(int value) {
+        #ifdef _MSC_VER /* See TemplatedPostman in Test.cpp */
+        _functionHash = i;
+        #endif
+        return emit(&CE::numbered<i>, value);
+    }
+
+    #ifdef _MSC_VER
+    int _functionHash;
+    #endif
+};
+
+/* Connects / emits signals numbered<0>() to numbered<i - 1>() */
+template<class Emitter, int i> struct Numbered {
+    static void connect(Emitter& emitter, std::size_t slotCount) {
+        for(std::size_t j = 0; j != slotCount; ++j)
+            Interconnect::connect(emitter, &Emitter::template numbered<i - 1>, freeFunctionSlot);
+        Numbered<Emitter, i - 1>::connect(emitter, slotCount);
+    }
+
+    static void emit(Emitter& emitter) {
+        emitter.template numbered<i - 1>(1);
+        Numbered<Emitter, i - 1>::emit(emitter);
+    }
+};
+
+template<class Emitter> struct Numbered<Emitter, 0> {
+    static void connect(Emitter&, std::size_t) {}
+    static void emit(Emitter&) {}
+};
+
+void ConcurrentEmitterBenchmark::connect1kEmitter() {
+    E emitter;
+
+    CORRADE_BENCHMARK(1000)
+        connect(emitter, &E::fire, freeFunctionSlot);
+
+    CORRADE_COMPARE(emitter.signalConnectionCount(), 1000);
+}
+
+void ConcurrentEmitterBenchmark::connect1kConcurrentEmitter() {
+    CE emitter;
+
+    CORRADE_BENCHMARK(1000)
+        connect(emitter, &CE::fire, freeFunctionSlot);
+
+    CORRADE_COMPARE(emitter.signalConnectionCount(), 1000);
+}
+
+void ConcurrentEmitterBenchmark::emit1000xEmitter() {
+    E emitter;
+    connect(emitter, &E::fire, freeFunctionSlot);
+
+    globalOutput = 0;
+    CORRADE_BENCHMARK(100) {
+        for(std::size_t i = 0; i != 1000; ++i)
+            emitter.fire(1);
+    }
+
+    CORRADE_COMPARE(globalOutput, 1000*100);
+}
+
+void ConcurrentEmitterBenchmark::emit1000xConcurrentEmitter() {
+    CE emitter;
+    connect(emitter, &CE::fire, freeFunctionSlot);
+
+    globalOutput = 0;
+    CORRADE_BENCHMARK(100) {
+        for(std::size_t i = 0; i != 1000; ++i)
+            emitter.fire(1);
+    }
+
+    CORRADE_COMPARE(globalOutput, 1000*100);
+}
+
+void ConcurrentEmitterBenchmark::emit1kSlotsEmitter() {
+    E emitter;
+    for(std::size_t i = 0; i != 1000; ++i)
+        connect(emitter, &E::fire, freeFunctionSlot);
+
+    globalOutput = 0;
+    CORRADE_BENCHMARK(100)
+        emitter.fire(1);
+
+    CORRADE_COMPARE(globalOutput, 1000*100);
+}
+
+void ConcurrentEmitterBenchmark::emit1kSlotsConcurrentEmitter() {
+    CE emitter;
+    for(std::size_t i = 0; i != 1000; ++i)
+        connect(emitter, &CE::fire, freeFunctionSlot);
+
+    globalOutput = 0;
+    CORRADE_BENCHMARK(100)
+        emitter.fire(1);
+
+    CORRADE_COMPARE(globalOutput, 1000*100);
+}
+
+void ConcurrentEmitterBenchmark::emit64SignalsEmitter() {
+    E emitter;
+    Numbered<E, 64>::connect(emitter, 16);
+
+    globalOutput = 0;
+    CORRADE_BENCHMARK(100)
+        Numbered<E, 64>::emit(emitter);
+
+    CORRADE_COMPARE(globalOutput, 64*16*100);
+}
+
+void ConcurrentEmitterBenchmark::emit64SignalsConcurrentEmitter() {
+    CE emitter;
+    Numbered<CE, 64>::connect(emitter, 16);
+
+    globalOutput = 0;
+    CORRADE_BENCHMARK(100)
+        Numbered<CE, 64>::emit(emitter);
+
+    CORRADE_COMPARE(globalOutput, 64*16*100);
+}
+
+void ConcurrentEmitterBenchmark::emit1000xQueued() {
+    CE emitter;
+    SlotQueue queue;
+    connect(emitter, &CE::fire, queue, freeFunctionSlot);
+
+    globalOutput = 0;
+    CORRADE_BENCHMARK(100) {
+        for(std::size_t i = 0; i != 1000; ++i)
+            emitter.fire(1);
+        queue.dispatch();
+    }
+
+    CORRADE_COMPARE(globalOutput, 1000*100);
+}
+
+#if defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+/* Four threads emitting 10k times each */
+template<class F> void emitThreaded(F emit) {
+    std::thread threads[4];
+    for(std::thread& thread: threads) thread = std::thread{[emit]() {
+        for(std::size_t i = 0; i != 10000; ++i) emit();
+    }};
+    for(std::thread& thread: threads) thread.join();
+}
+#endif
+
+void ConcurrentEmitterBenchmark::emitThreadedMutexEmitter() {
+    #if !defined(CORRADE_BUILD_MULTITHREADED) || defined(CORRADE_TARGET_EMSCRIPTEN)
+    CORRADE_SKIP("Threads are not available.");
+    #else
+    /* The plain emitter isn't thread-safe, so the only way to emit from
+       multiple threads is to guard it with a mutex, including the slot */
+    E emitter;
+    std::mutex mutex;
+    std::atomic<int> output{0};
+    connect(emitter, &E::fire, [&output](int value) { output += value; });
+
+    CORRADE_BENCHMARK(1) emitThreaded([&emitter, &mutex]() {
+        std::lock_guard<std::mutex> lock{mutex};
+        emitter.fire(1);
+    });
+
+    CORRADE_COMPARE(output, 4*10000);
+    #endif
+}
+
+void ConcurrentEmitterBenchmark::emitThreadedConcurrentEmitter() {
+    #if !defined(CORRADE_BUILD_MULTITHREADED) || defined(CORRADE_TARGET_EMSCRIPTEN)
+    CORRADE_SKIP("Threads are not available.");
+    #else
+    CE emitter;
+    std::atomic<int> output{0};
+    connect(emitter, &CE::fire, [&output](int value) { output += value; });
+
+    CORRADE_BENCHMARK(1) emitThreaded([&emitter]() {
+        emitter.fire(1);
+    });
+
+    CORRADE_COMPARE(output, 4*10000);
+    #endif
+}
+
+void ConcurrentEmitterBenchmark::emitThreadedQueued() {
+    #if !defined(CORRADE_BUILD_MULTITHREADED) || defined(CORRADE_TARGET_EMSCRIPTEN)
+    CORRADE_SKIP("Threads are not available.");
+    #else
+    /* Four threads emitting, delivered to this thread */
+    CE emitter;
+    SlotQueue queue;
+    int output = 0;
+    connect(emitter, &CE::fire, queue, [&output](int value) { output += value; });
+
+    CORRADE_BENCHMARK(1) {
+        std::thread producer{[&emitter]() {
+            emitThreaded([&emitter]() { emitter.fire(1); });
+        }};
+        while(output != 4*10000)
+            if(!queue.dispatch()) std::this_thread::yield();
+        producer.join();
+    }
+
+    CORRADE_COMPARE(output, 4*10000);
+    #endif
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Corrade::Interconnect::Test::ConcurrentEmitterBenchmark)
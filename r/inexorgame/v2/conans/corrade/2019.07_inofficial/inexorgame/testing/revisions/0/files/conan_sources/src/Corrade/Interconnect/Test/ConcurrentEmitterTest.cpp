@@ -0,0 +1,719 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <string>
+#include <vector>
+
+#include "Corrade/Containers/Optional.h"
+#include "Corrade/Interconnect/ConcurrentEmitter.h"
+#include "Corrade/Interconnect/SlotQueue.h"
+#include "Corrade/TestSuite/Tester.h"
+#include "Corrade/Utility/DebugStl.h"
+
+#if defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+#include <thread>
+#endif
+
+namespace Corrade { namespace Interconnect { namespace Test { namespace {
+
+struct ConcurrentEmitterTest: TestSuite::Tester {
+    explicit ConcurrentEmitterTest();
+
+    void connect();
+    void emit();
+    void emitOrder();
+    void emitManySignals();
+    void emitNoConnections();
+
+    void disconnect();
+    void disconnectSignal();
+    void disconnectAllSignals();
+    void destroyEmitter();
+
+    void changeConnectionsInSlot();
+    void disconnectSelfInSlot();
+
+    void queued();
+    void queuedCopiesArguments();
+    void queuedLargeArguments();
+    void queuedMaxCount();
+    void queuedDisconnectPending();
+    void queuedDestroyEmitterPending();
+    void queuedDestroyQueuePending();
+    void queuedChangeConnectionsInSlot();
+    void queueCapacity();
+
+    void threadedEmit();
+    void threadedEmitConnectionChanges();
+    void threadedQueued();
+    void threadedQueuedFullDisconnect();
+};
+
+ConcurrentEmitterTest::ConcurrentEmitterTest() {
+    addTests({&ConcurrentEmitterTest::connect,
+              &ConcurrentEmitterTest::emit,
+              &ConcurrentEmitterTest::emitOrder,
+              &ConcurrentEmitterTest::emitManySignals,
+              &ConcurrentEmitterTest::emitNoConnections,
+
+              &ConcurrentEmitterTest::disconnect,
+              &ConcurrentEmitterTest::disconnectSignal,
+              &ConcurrentEmitterTest::disconnectAllSignals,
+              &ConcurrentEmitterTest::destroyEmitter,
+
+              &ConcurrentEmitterTest::changeConnectionsInSlot,
+              &ConcurrentEmitterTest::disconnectSelfInSlot,
+
+              &ConcurrentEmitterTest::queued,
+              &ConcurrentEmitterTest::queuedCopiesArguments,
+              &ConcurrentEmitterTest::queuedLargeArguments,
+              &ConcurrentEmitterTest::queuedMaxCount,
+              &ConcurrentEmitterTest::queuedDisconnectPending,
+              &ConcurrentEmitterTest::queuedDestroyEmitterPending,
+              &ConcurrentEmitterTest::queuedDestroyQueuePending,
+              &ConcurrentEmitterTest::queuedChangeConnectionsInSlot,
+              &ConcurrentEmitterTest::queueCapacity,
+
+              &ConcurrentEmitterTest::threadedEmit,
+              &ConcurrentEmitterTest::threadedEmitConnectionChanges,
+              &ConcurrentEmitterTest::threadedQueued,
+              &ConcurrentEmitterTest::threadedQueuedFullDisconnect});
+}
+
+class Postman: public Interconnect::ConcurrentEmitter {
+    public:
+        Signal newMessage(int price, const std::string& message) {
+            return emit(&Postman::newMessage, price, message);
+        }
+
+        Signal paymentRequested(int amount) {
+            return emit(&Postman::paymentRequested, amount);
+        }
+
+        template<int i> Signal numbered(int value) {
+            #ifdef _MSC_VER /* See TemplatedPostman in Test.cpp */
+            _functionHash = i;
+            #endif
+            return emit(&Postman::numbered<i>, value);
+        }
+
+    private:
+        #ifdef _MSC_VER
+        int _functionHash;
+        #endif
+};
+
+/* Counts its own live instances, to verify the connections get freed */
+struct Counted {
+    static int count;
+
+    explicit Counted(int& output): output(&output) { ++count; }
+    Counted(const Counted& other): output{other.output} { ++count; }
+    ~Counted() { --count; }
+
+    void operator()(int amount) { *output += amount; }
+
+    int* output;
+};
+
+int Counted::count = 0;
+
+void ConcurrentEmitterTest::connect() {
+    Postman postman;
+    CORRADE_VERIFY(!postman.hasSignalConnections());
+    CORRADE_VERIFY(!postman.hasSignalConnections(&Postman::paymentRequested));
+
+    ConcurrentConnection a = Interconnect::connect(postman, &Postman::paymentRequested, [](int) {});
+    ConcurrentConnection b = Interconnect::connect(postman, &Postman::newMessage, [](int, const std::string&) {});
+    Interconnect::connect(postman, &Postman::paymentRequested, [](int) {});
+    CORRADE_VERIFY(postman.hasSignalConnections());
+    CORRADE_VERIFY(postman.hasSignalConnections(&Postman::paymentRequested));
+    CORRADE_VERIFY(!postman.hasSignalConnections(&Postman::numbered<0>));
+    CORRADE_VERIFY(postman.isConnected(a));
+    CORRADE_VERIFY(postman.isConnected(b));
+    CORRADE_COMPARE(postman.signalConnectionCount(), 3);
+    CORRADE_COMPARE(postman.signalConnectionCount(&Postman::paymentRequested), 2);
+    CORRADE_COMPARE(postman.signalConnectionCount(&Postman::newMessage), 1);
+}
+
+void ConcurrentEmitterTest::emit() {
+    Postman postman;
+
+    int money = 0;
+    std::vector<std::string> messages;
+    Interconnect::connect(postman, &Postman::newMessage, [&](int price, const std::string& message) {
+        money += price;
+        messages.push_back(message);
+    });
+    Interconnect::connect(postman, &Postman::paymentRequested, [&money](int amount) {
+        money -= amount;
+    });
+
+    postman.newMessage(60, "hello");
+    postman.paymentRequested(20);
+    postman.newMessage(40, "ahoy");
+    CORRADE_COMPARE(money, 80);
+    CORRADE_COMPARE(messages, (std::vector<std::string>{"hello", "ahoy"}));
+}
+
+void ConcurrentEmitterTest::emitOrder() {
+    Postman postman;
+
+    std::vector<int> out;
+    for(int i = 0; i != 5; ++i) {
+        Interconnect::connect(postman, &Postman::paymentRequested, [&out, i](int) {
+            out.push_back(i);
+        });
+        /* Interleaved with connections to other signals to have them in the
+           middle of the table */
+        Interconnect::connect(postman, &Postman::numbered<0>, [](int) {});
+        Interconnect::connect(postman, &Postman::numbered<1>, [](int) {});
+    }
+
+    postman.paymentRequested(0);
+    CORRADE_COMPARE(out, (std::vector<int>{0, 1, 2, 3, 4}));
+}
+
+void ConcurrentEmitterTest::emitManySignals() {
+    Postman postman;
+
+    int out[6]{};
+    Interconnect::connect(postman, &Postman::numbered<5>, [&out](int value) { out[5] += value; });
+    Interconnect::connect(postman, &Postman::numbered<0>, [&out](int value) { out[0] += value; });
+    Interconnect::connect(postman, &Postman::numbered<3>, [&out](int value) { out[3] += value; });
+    Interconnect::connect(postman, &Postman::numbered<1>, [&out](int value) { out[1] += value; });
+    Interconnect::connect(postman, &Postman::numbered<4>, [&out](int value) { out[4] += value; });
+    Interconnect::connect(postman, &Postman::numbered<3>, [&out](int value) { out[3] += value*10; });
+    Interconnect::connect(postman, &Postman::numbered<2>, [&out](int value) { out[2] += value; });
+
+    postman.numbered<0>(1);
+    postman.numbered<1>(2);
+    postman.numbered<2>(3);
+    postman.numbered<3>(4);
+    postman.numbered<4>(5);
+    postman.numbered<5>(6);
+    postman.numbered<6>(7);
+    CORRADE_COMPARE(out[0], 1);
+    CORRADE_COMPARE(out[1], 2);
+    CORRADE_COMPARE(out[2], 3);
+    CORRADE_COMPARE(out[3], 44);
+    CORRADE_COMPARE(out[4], 5);
+    CORRADE_COMPARE(out[5], 6);
+}
+
+void ConcurrentEmitterTest::emitNoConnections() {
+    Postman postman;
+
+    /* Shouldn't crash on the null table */
+    postman.paymentRequested(3);
+
+    int money = 0;
+    ConcurrentConnection connection = Interconnect::connect(postman, &Postman::paymentRequested, [&money](int amount) { money += amount; });
+    Interconnect::disconnect(postman, connection);
+
+    /* Shouldn't crash on an empty table either */
+    postman.paymentRequested(3);
+    CORRADE_COMPARE(money, 0);
+}
+
+void ConcurrentEmitterTest::disconnect() {
+    Postman postman;
+
+    int money = 0;
+    ConcurrentConnection a = Interconnect::connect(postman, &Postman::paymentRequested, [&money](int amount) { money += amount; });
+    ConcurrentConnection b = Interconnect::connect(postman, &Postman::paymentRequested, [&money](int amount) { money += amount*10; });
+    CORRADE_COMPARE(postman.signalConnectionCount(), 2);
+
+    CORRADE_VERIFY(Interconnect::disconnect(postman, a));
+    CORRADE_VERIFY(!postman.isConnected(a));
+    CORRADE_VERIFY(postman.isConnected(b));
+    CORRADE_COMPARE(postman.signalConnectionCount(), 1);
+
+    postman.paymentRequested(1);
+    CORRADE_COMPARE(money, 10);
+
+    /* Second time it does nothing */
+    CORRADE_VERIFY(!Interconnect::disconnect(postman, a));
+    CORRADE_COMPARE(postman.signalConnectionCount(), 1);
+}
+
+void ConcurrentEmitterTest::disconnectSignal() {
+    Postman postman;
+
+    int money = 0;
+    Interconnect::connect(postman, &Postman::paymentRequested, [&money](int amount) { money += amount; });
+    Interconnect::connect(postman, &Postman::paymentRequested, [&money](int amount) { money += amount; });
+    Interconnect::connect(postman, &Postman::numbered<0>, [&money](int amount) { money += amount*10; });
+    Interconnect::connect(postman, &Postman::newMessage, [](int, const std::string&) {});
+
+    postman.disconnectSignal(&Postman::paymentRequested);
+    CORRADE_COMPARE(postman.signalConnectionCount(), 2);
+    CORRADE_VERIFY(!postman.hasSignalConnections(&Postman::paymentRequested));
+
+    /* Disconnecting a signal that has no connections does nothing */
+    postman.disconnectSignal(&Postman::paymentRequested);
+    CORRADE_COMPARE(postman.signalConnectionCount(), 2);
+
+    postman.paymentRequested(1);
+    postman.numbered<0>(1);
+    CORRADE_COMPARE(money, 10);
+}
+
+void ConcurrentEmitterTest::disconnectAllSignals() {
+    Postman postman;
+
+    int money = 0;
+    ConcurrentConnection a = Interconnect::connect(postman, &Postman::paymentRequested, [&money](int amount) { money += amount; });
+    Interconnect::connect(postman, &Postman::numbered<0>, [&money](int amount) { money += amount; });
+
+    postman.disconnectAllSignals();
+    CORRADE_VERIFY(!postman.hasSignalConnections());
+    CORRADE_VERIFY(!postman.isConnected(a));
+
+    postman.paymentRequested(1);
+    postman.numbered<0>(1);
+    CORRADE_COMPARE(money, 0);
+
+    /* Connecting again works */
+    Interconnect::connect(postman, &Postman::paymentRequested, [&money](int amount) { money += amount; });
+    postman.paymentRequested(1);
+    CORRADE_COMPARE(money, 1);
+}
+
+void ConcurrentEmitterTest::destroyEmitter() {
+    int money = 0;
+    {
+        Postman postman;
+        ConcurrentConnection a = Interconnect::connect(postman, &Postman::paymentRequested, Counted{money});
+        Interconnect::connect(postman, &Postman::paymentRequested, Counted{money});
+        Interconnect::connect(postman, &Postman::numbered<0>, Counted{money});
+        CORRADE_COMPARE(Counted::count, 3);
+
+        Interconnect::disconnect(postman, a);
+        CORRADE_COMPARE(Counted::count, 2);
+
+        postman.paymentRequested(5);
+        CORRADE_COMPARE(money, 5);
+    }
+
+    CORRADE_COMPARE(Counted::count, 0);
+}
+
+void ConcurrentEmitterTest::changeConnectionsInSlot() {
+    Postman postman;
+
+    int money = 0;
+    std::vector<ConcurrentConnection> added;
+    ConcurrentConnection b = Interconnect::connect(postman, &Postman::paymentRequested, Counted{money});
+    Interconnect::connect(postman, &Postman::paymentRequested, [&](int) {
+        /* Neither of these affects the emit currently in progress */
+        added.push_back(Interconnect::connect(postman, &Postman::paymentRequested, Counted{money}));
+        Interconnect::disconnect(postman, b);
+    });
+    Interconnect::connect(postman, &Postman::paymentRequested, Counted{money});
+    CORRADE_COMPARE(Counted::count, 2);
+
+    /* The disconnected slot is still called in this emit but not the new one.
+       The disconnected slot is not freed until the next connection change
+       outside of a slot. */
+    postman.paymentRequested(1);
+    CORRADE_COMPARE(money, 2);
+    CORRADE_COMPARE(added.size(), 1);
+    CORRADE_VERIFY(!postman.isConnected(b));
+    CORRADE_VERIFY(postman.isConnected(added[0]));
+    CORRADE_COMPARE(Counted::count, 3);
+
+    /* Now the new one is called, but the lambda disconnects nothing */
+    postman.paymentRequested(1);
+    CORRADE_COMPARE(money, 4);
+    CORRADE_COMPARE(added.size(), 2);
+
+    /* This reclaims the connection disconnected in the slot */
+    Interconnect::disconnect(postman, added[1]);
+    CORRADE_COMPARE(Counted::count, 2);
+}
+
+void ConcurrentEmitterTest::disconnectSelfInSlot() {
+    Postman postman;
+
+    int called = 0;
+    bool disconnected = false;
+    Containers::Optional<ConcurrentConnection> self;
+    self = Interconnect::connect(postman, &Postman::paymentRequested, [&](int) {
+        ++called;
+        disconnected = Interconnect::disconnect(postman, *self);
+    });
+
+    postman.paymentRequested(1);
+    postman.paymentRequested(1);
+    CORRADE_COMPARE(called, 1);
+    CORRADE_VERIFY(disconnected);
+    CORRADE_VERIFY(!postman.hasSignalConnections());
+}
+
+void ConcurrentEmitterTest::queued() {
+    Postman postman;
+    SlotQueue queue;
+
+    int money = 0;
+    std::vector<std::string> messages;
+    Interconnect::connect(postman, &Postman::newMessage, queue, [&](int price, const std::string& message) {
+        money += price;
+        messages.push_back(message);
+    });
+    Interconnect::connect(postman, &Postman::paymentRequested, queue, [&money](int amount) {
+        money -= amount;
+    });
+    /* Direct connections mixed with queued ones */
+    int direct = 0;
+    Interconnect::connect(postman, &Postman::paymentRequested, [&direct](int amount) {
+        direct += amount;
+    });
+
+    postman.newMessage(60, "hello");
+    postman.paymentRequested(20);
+    postman.newMessage(40, "ahoy");
+
+    /* Nothing is called until dispatched */
+    CORRADE_COMPARE(money, 0);
+    CORRADE_VERIFY(messages.empty());
+    CORRADE_COMPARE(direct, 20);
+
+    CORRADE_COMPARE(queue.dispatch(), 3);
+    CORRADE_COMPARE(money, 80);
+    CORRADE_COMPARE(messages, (std::vector<std::string>{"hello", "ahoy"}));
+
+    /* Nothing left */
+    CORRADE_COMPARE(queue.dispatch(), 0);
+    CORRADE_COMPARE(money, 80);
+}
+
+void ConcurrentEmitterTest::queuedCopiesArguments() {
+    Postman postman;
+    SlotQueue queue;
+
+    std::vector<std::string> messages;
+    Interconnect::connect(postman, &Postman::newMessage, queue, [&](int, const std::string& message) {
+        messages.push_back(message);
+    });
+
+    {
+        std::string message = "hello";
+        postman.newMessage(0, message);
+        message = "bye";
+    }
+
+    queue.dispatch();
+    CORRADE_COMPARE(messages, (std::vector<std::string>{"hello"}));
+}
+
+void ConcurrentEmitterTest::queuedLargeArguments() {
+    struct Large {
+        std::string a, b, c;
+    };
+
+    struct E: ConcurrentEmitter {
+        Signal fire(const Large& large, int value) {
+            return emit(&E::fire, large, value);
+        }
+    } emitter;
+
+    CORRADE_VERIFY(!(Implementation::QueuedArguments<const Large&, int>::Inline));
+    CORRADE_VERIFY((Implementation::QueuedArguments<int, const std::string&>::Inline));
+
+    SlotQueue queue;
+    std::string out;
+    Interconnect::connect(emitter, &E::fire, queue, [&out](const Large& large, int value) {
+        out += large.a + large.b + large.c + std::to_string(value);
+    });
+
+    emitter.fire(Large{"a", "b", "c"}, 1);
+    emitter.fire(Large{"d", "e", "f"}, 2);
+    CORRADE_COMPARE(queue.dispatch(), 2);
+    CORRADE_COMPARE(out, "abc1def2");
+}
+
+void ConcurrentEmitterTest::queuedMaxCount() {
+    Postman postman;
+    SlotQueue queue;
+
+    std::vector<int> out;
+    Interconnect::connect(postman, &Postman::paymentRequested, queue, [&out](int amount) {
+        out.push_back(amount);
+    });
+
+    for(int i = 0; i != 5; ++i) postman.paymentRequested(i);
+
+    CORRADE_COMPARE(queue.dispatch(2), 2);
+    CORRADE_COMPARE(out, (std::vector<int>{0, 1}));
+    CORRADE_COMPARE(queue.dispatch(2), 2);
+    CORRADE_COMPARE(queue.dispatch(2), 1);
+    CORRADE_COMPARE(out, (std::vector<int>{0, 1, 2, 3, 4}));
+}
+
+void ConcurrentEmitterTest::queuedDisconnectPending() {
+    Postman postman;
+    SlotQueue queue;
+
+    int money = 0;
+    ConcurrentConnection a = Interconnect::connect(postman, &Postman::paymentRequested, queue, Counted{money});
+    Interconnect::connect(postman, &Postman::paymentRequested, queue, [&money](int amount) { money += amount*10; });
+
+    postman.paymentRequested(1);
+    Interconnect::disconnect(postman, a);
+
+    /* The functor is kept alive by the pending message */
+    CORRADE_COMPARE(Counted::count, 1);
+
+    /* The disconnected slot is not called anymore, the functor gets freed
+       once the message is processed */
+    CORRADE_COMPARE(queue.dispatch(), 2);
+    CORRADE_COMPARE(money, 10);
+    CORRADE_COMPARE(Counted::count, 0);
+}
+
+void ConcurrentEmitterTest::queuedDestroyEmitterPending() {
+    SlotQueue queue;
+
+    int money = 0;
+    {
+        Postman postman;
+        Interconnect::connect(postman, &Postman::paymentRequested, queue, Counted{money});
+        postman.paymentRequested(1);
+    }
+
+    CORRADE_COMPARE(Counted::count, 1);
+    CORRADE_COMPARE(queue.dispatch(), 1);
+    CORRADE_COMPARE(money, 0);
+    CORRADE_COMPARE(Counted::count, 0);
+}
+
+void ConcurrentEmitterTest::queuedDestroyQueuePending() {
+    Postman postman;
+
+    int money = 0;
+    {
+        SlotQueue queue;
+        Interconnect::connect(postman, &Postman::paymentRequested, queue, Counted{money});
+        postman.paymentRequested(1);
+
+        /* The arguments are destroyed as well */
+        Interconnect::connect(postman, &Postman::numbered<0>, queue, [](int) {});
+        postman.numbered<0>(1);
+
+        postman.disconnectAllSignals();
+        CORRADE_COMPARE(Counted::count, 1);
+    }
+
+    CORRADE_COMPARE(money, 0);
+    CORRADE_COMPARE(Counted::count, 0);
+}
+
+void ConcurrentEmitterTest::queuedChangeConnectionsInSlot() {
+    Postman postman;
+    SlotQueue queue;
+
+    int money = 0;
+    Containers::Optional<ConcurrentConnection> self;
+    self = Interconnect::connect(postman, &Postman::paymentRequested, queue, [&](int amount) {
+        money += amount;
+        Interconnect::disconnect(postman, *self);
+        Interconnect::connect(postman, &Postman::paymentRequested, Counted{money});
+    });
+
+    postman.paymentRequested(1);
+    postman.paymentRequested(1);
+    CORRADE_COMPARE(queue.dispatch(), 2);
+    CORRADE_COMPARE(money, 1);
+    CORRADE_COMPARE(Counted::count, 1);
+    CORRADE_COMPARE(postman.signalConnectionCount(), 1);
+
+    postman.paymentRequested(1);
+    CORRADE_COMPARE(money, 2);
+}
+
+void ConcurrentEmitterTest::queueCapacity() {
+    CORRADE_COMPARE(SlotQueue{}.capacity(), 1024);
+    CORRADE_COMPARE(SlotQueue{1}.capacity(), 1);
+    CORRADE_COMPARE(SlotQueue{5}.capacity(), 8);
+    CORRADE_COMPARE(SlotQueue{16}.capacity(), 16);
+
+    /* Filling the queue exactly to its capacity several times over */
+    Postman postman;
+    SlotQueue queue{4};
+    int money = 0;
+    Interconnect::connect(postman, &Postman::paymentRequested, queue, [&money](int amount) { money += amount; });
+    for(int i = 0; i != 3; ++i) {
+        for(int j = 0; j != 4; ++j) postman.paymentRequested(1);
+        CORRADE_COMPARE(queue.dispatch(), 4);
+    }
+    CORRADE_COMPARE(money, 12);
+}
+
+void ConcurrentEmitterTest::threadedEmit() {
+    #if !defined(CORRADE_BUILD_MULTITHREADED) || defined(CORRADE_TARGET_EMSCRIPTEN)
+    CORRADE_SKIP("Threads are not available.");
+    #else
+    Postman postman;
+
+    std::atomic<int> a{0}, b{0};
+    Interconnect::connect(postman, &Postman::paymentRequested, [&a](int amount) { a += amount; });
+    Interconnect::connect(postman, &Postman::paymentRequested, [&b](int amount) { b += amount*2; });
+
+    std::thread threads[4];
+    for(std::thread& thread: threads) thread = std::thread{[&postman]() {
+        for(std::size_t i = 0; i != 10000; ++i)
+            postman.paymentRequested(1);
+    }};
+    for(std::thread& thread: threads) thread.join();
+
+    CORRADE_COMPARE(a, 40000);
+    CORRADE_COMPARE(b, 80000);
+    #endif
+}
+
+void ConcurrentEmitterTest::threadedEmitConnectionChanges() {
+    #if !defined(CORRADE_BUILD_MULTITHREADED) || defined(CORRADE_TARGET_EMSCRIPTEN)
+    CORRADE_SKIP("Threads are not available.");
+    #else
+    Postman postman;
+
+    std::atomic<int> permanent{0}, temporary{0};
+    Interconnect::connect(postman, &Postman::paymentRequested, [&permanent](int amount) { permanent += amount; });
+
+    std::atomic<bool> done{false};
+    std::thread threads[3];
+    for(std::thread& thread: threads) thread = std::thread{[&postman, &done]() {
+        std::size_t i = 0;
+        while(!done || i < 1000) {
+            postman.paymentRequested(1);
+            ++i;
+        }
+    }};
+
+    /* Connecting and disconnecting heap-allocated functors while the other
+       threads emit. ASan / TSan would catch any use-after-free here. */
+    struct CountedAtomic {
+        void operator()(int amount) { *output += amount; }
+
+        Counted counted;
+        std::atomic<int>* output;
+    };
+    int unused;
+    for(std::size_t i = 0; i != 200; ++i) {
+        ConcurrentConnection a = Interconnect::connect(postman, &Postman::paymentRequested, CountedAtomic{Counted{unused}, &temporary});
+        ConcurrentConnection b = Interconnect::connect(postman, &Postman::paymentRequested, [&temporary](int amount) { temporary += amount; });
+        Interconnect::connect(postman, &Postman::numbered<0>, [](int) {});
+        Interconnect::disconnect(postman, a);
+        Interconnect::disconnect(postman, b);
+        postman.disconnectSignal(&Postman::numbered<0>);
+    }
+
+    done = true;
+    for(std::thread& thread: threads) thread.join();
+
+    CORRADE_COMPARE(postman.signalConnectionCount(), 1);
+    CORRADE_COMPARE(Counted::count, 0);
+    CORRADE_VERIFY(permanent >= 3000);
+    #endif
+}
+
+void ConcurrentEmitterTest::threadedQueued() {
+    #if !defined(CORRADE_BUILD_MULTITHREADED) || defined(CORRADE_TARGET_EMSCRIPTEN)
+    CORRADE_SKIP("Threads are not available.");
+    #else
+    struct E: ConcurrentEmitter {
+        Signal fire(std::size_t thread, int value) {
+            return emit(&E::fire, thread, value);
+        }
+    } emitter;
+
+    /* A small queue so the producers have to wait for the consumer */
+    SlotQueue queue{16};
+
+    int last[4]{-1, -1, -1, -1};
+    bool ordered = true;
+    int received = 0;
+    Interconnect::connect(emitter, &E::fire, queue, [&](std::size_t thread, int value) {
+        if(value != last[thread] + 1) ordered = false;
+        last[thread] = value;
+        ++received;
+    });
+
+    std::thread threads[4];
+    for(std::size_t i = 0; i != 4; ++i) threads[i] = std::thread{[&emitter, i]() {
+        for(int j = 0; j != 5000; ++j)
+            emitter.fire(i, j);
+    }};
+
+    while(received != 4*5000)
+        if(!queue.dispatch()) std::this_thread::yield();
+
+    for(std::thread& thread: threads) thread.join();
+
+    CORRADE_VERIFY(ordered);
+    CORRADE_COMPARE(last[0], 4999);
+    CORRADE_COMPARE(last[3], 4999);
+    CORRADE_COMPARE(queue.dispatch(), 0);
+    #endif
+}
+
+void ConcurrentEmitterTest::threadedQueuedFullDisconnect() {
+    #if !defined(CORRADE_BUILD_MULTITHREADED) || defined(CORRADE_TARGET_EMSCRIPTEN)
+    CORRADE_SKIP("Threads are not available.");
+    #else
+    Postman postman;
+    SlotQueue queue{2};
+
+    std::atomic<int> emitted{0};
+    int received = 0;
+    Interconnect::connect(postman, &Postman::paymentRequested, [&emitted](int) { ++emitted; });
+    ConcurrentConnection queued = Interconnect::connect(postman, &Postman::paymentRequested, queue, [&received](int) { ++received; });
+
+    std::atomic<bool> done{false};
+    std::thread thread{[&postman, &done]() {
+        for(std::size_t i = 0; i != 10; ++i)
+            postman.paymentRequested(1);
+        done = true;
+    }};
+
+    /* Wait until the third emit is waiting for the full queue and disconnect
+       before dispatching. The disconnect would wait forever if the emit
+       waited for the queue while registered as a reader. */
+    while(emitted < 3) std::this_thread::yield();
+    CORRADE_VERIFY(Interconnect::disconnect(postman, queued));
+
+    while(!done) queue.dispatch();
+    thread.join();
+    queue.dispatch();
+
+    CORRADE_COMPARE(emitted, 10);
+    CORRADE_COMPARE(received, 0);
+    #endif
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Corrade::Interconnect::Test::ConcurrentEmitterTest)
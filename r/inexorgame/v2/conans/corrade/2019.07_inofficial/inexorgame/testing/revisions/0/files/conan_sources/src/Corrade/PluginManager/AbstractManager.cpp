@@ -25,6 +25,7 @@
 
 #include "AbstractManager.h"
 
+#include <cstdint>
 #include <cstring>
 #include <algorithm>
 #include <functional>
@@ -32,6 +33,8 @@
 #include <sstream>
 #include <utility>
 
+#include "Corrade/Containers/Array.h"
+#include "Corrade/Containers/EnumSet.hpp"
 #include "Corrade/Containers/Optional.h"
 #include "Corrade/Containers/Reference.h"
 #include "Corrade/PluginManager/AbstractPlugin.h"
@@ -42,10 +45,14 @@
 #include "Corrade/Utility/String.h"
 
 #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
+#include <sys/stat.h>
+
 #include "Corrade/Utility/Directory.h"
+#include "Corrade/Utility/TaskScheduler.h"
 
 #ifndef CORRADE_TARGET_WINDOWS
 #include <dlfcn.h>
+#include <unistd.h>
 #else
 #ifndef WIN32_LEAN_AND_MEAN
 #define WIN32_LEAN_AND_MEAN /* Otherwise `#define interface struct` breaks everything */
@@ -107,8 +114,18 @@ struct AbstractManager::Plugin {
     #endif
 
     #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
+    /* For dynamic plugins with metadata not parsed yet, the plugin name and,
+       if DiscoveryFlag::MetadataCache is used, contents of its metadata file
+       pointing into State::metadataCache */
+    std::string name;
+    Containers::ArrayView<const char> cachedMetadata;
+
     /* Constructor for dynamic plugins */
     explicit Plugin(std::string name, const std::string& metadata, AbstractManager* manager);
+
+    /* Constructor for dynamic plugins with metadata parsed later by
+       AbstractManager::parseMetadata() */
+    explicit Plugin(std::string name, AbstractManager* manager);
     #endif
 
     /* Constructor for static plugins */
@@ -136,12 +153,176 @@ struct AbstractManager::State {
 
     #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
     std::string pluginDirectory;
+    DiscoveryFlags discoveryFlags;
+
+    /* Set if DiscoveryFlag::Lazy found plugins whose aliases are not known
+       yet. Mutable, together with aliases, because the aliases get resolved
+       on first query. */
+    mutable bool unresolvedAliases{};
+
+    /* Metadata cache for the current plugin directory, either mapped from the
+       file or generated and written there by setPluginDirectory() */
+    #if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+    Containers::Array<const char, Directory::MapDeleter> mappedMetadataCache;
+    #endif
+    Containers::Array<char> metadataCache;
+
+    /* Created on first parallel metadata parsing and reused for all
+       subsequent ones */
+    mutable Containers::Pointer<TaskScheduler> scheduler;
     #endif
     std::string pluginInterface;
-    std::map<std::string, Plugin&> aliases;
+    mutable std::map<std::string, Plugin&> aliases;
     std::map<std::string, std::vector<AbstractPlugin*>> instances;
 };
 
+#ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
+namespace {
+
+/* Layout of the metadata cache file. The header is followed by the name and
+   contents of the metadata file of each plugin, in the order of the sorted
+   directory listing:
+
+    -   4 bytes of magic, "CPMC"
+    -   4 bytes of version, doesn't match on a different endianness either
+    -   8 bytes of plugin directory modification time in nanoseconds
+    -   4 bytes of plugin count
+    -   for each plugin 4 bytes of name size, 4 bytes of metadata size, the
+        name and the metadata, without any padding
+
+   All values are in native endianness. As there's no alignment, they are
+   accessed with memcpy(). */
+constexpr const char MetadataCacheDirectory[] = "corrade-plugin-metadata-cache";
+constexpr const char MetadataCacheFilename[] = "metadata.cache";
+constexpr const char MetadataCacheMagic[]{'C', 'P', 'M', 'C'};
+constexpr std::uint32_t MetadataCacheVersion = 1;
+constexpr std::size_t MetadataCacheHeaderSize = 20;
+
+template<class T> T readUnaligned(const char* const data) {
+    T value;
+    std::memcpy(&value, data, sizeof(T));
+    return value;
+}
+
+template<class T> void writeUnaligned(char* const data, const T value) {
+    std::memcpy(data, &value, sizeof(T));
+}
+
+/* Returns 0 if the time can't be queried, the cache isn't used then */
+std::int64_t directoryModificationTime(const std::string& path) {
+    #ifndef CORRADE_TARGET_WINDOWS
+    struct stat st;
+    if(stat(path.data(), &st) != 0) return 0;
+    #ifdef CORRADE_TARGET_APPLE
+    return std::int64_t(st.st_mtimespec.tv_sec)*1000000000 + st.st_mtimespec.tv_nsec;
+    #else
+    return std::int64_t(st.st_mtim.tv_sec)*1000000000 + st.st_mtim.tv_nsec;
+    #endif
+    #else
+    struct _stat64 st;
+    if(_wstat64(widen(path).data(), &st) != 0) return 0;
+    return std::int64_t(st.st_mtime)*1000000000;
+    #endif
+}
+
+unsigned long processId() {
+    #ifndef CORRADE_TARGET_WINDOWS
+    return getpid();
+    #else
+    return GetCurrentProcessId();
+    #endif
+}
+
+/* Fills metadata with views on the cached metadata files, returns false if
+   the cache is invalid or doesn't match the modification time or the
+   plugin list */
+bool parseMetadataCache(const Containers::ArrayView<const char> data, const std::int64_t modificationTime, const std::vector<std::string>& names, std::vector<Containers::ArrayView<const char>>& metadata) {
+    if(data.size() < MetadataCacheHeaderSize ||
+       std::memcmp(data, MetadataCacheMagic, sizeof(MetadataCacheMagic)) != 0 ||
+       readUnaligned<std::uint32_t>(data + 4) != MetadataCacheVersion ||
+       readUnaligned<std::int64_t>(data + 8) != modificationTime ||
+       readUnaligned<std::uint32_t>(data + 16) != names.size())
+        return false;
+
+    metadata.clear();
+    metadata.reserve(names.size());
+    std::size_t offset = MetadataCacheHeaderSize;
+    for(const std::string& name: names) {
+        if(data.size() - offset < 8) return false;
+        const std::size_t nameSize = readUnaligned<std::uint32_t>(data + offset);
+        const std::size_t metadataSize = readUnaligned<std::uint32_t>(data + offset + 4);
+        offset += 8;
+        if(data.size() - offset < nameSize || nameSize != name.size() ||
+           std::memcmp(data + offset, name.data(), nameSize) != 0)
+            return false;
+        offset += nameSize;
+        if(data.size() - offset < metadataSize) return false;
+        metadata.push_back(data.slice(offset, offset + metadataSize));
+        offset += metadataSize;
+    }
+
+    return offset == data.size();
+}
+
+Containers::Array<char> generateMetadataCache(const std::int64_t modificationTime, const std::vector<std::string>& names, const std::vector<Containers::Array<char>>& metadata) {
+    std::size_t size = MetadataCacheHeaderSize;
+    for(std::size_t i = 0; i != names.size(); ++i)
+        size += 8 + names[i].size() + metadata[i].size();
+
+    Containers::Array<char> data{Containers::NoInit, size};
+    std::memcpy(data, MetadataCacheMagic, sizeof(MetadataCacheMagic));
+    writeUnaligned<std::uint32_t>(data + 4, MetadataCacheVersion);
+    writeUnaligned<std::int64_t>(data + 8, modificationTime);
+    writeUnaligned<std::uint32_t>(data + 16, names.size());
+    std::size_t offset = MetadataCacheHeaderSize;
+    for(std::size_t i = 0; i != names.size(); ++i) {
+        writeUnaligned<std::uint32_t>(data + offset, names[i].size());
+        writeUnaligned<std::uint32_t>(data + offset + 4, metadata[i].size());
+        offset += 8;
+        std::memcpy(data + offset, names[i].data(), names[i].size());
+        offset += names[i].size();
+        /* Empty Array has a null pointer, which memcpy() doesn't like */
+        if(!metadata[i].empty())
+            std::memcpy(data + offset, metadata[i], metadata[i].size());
+        offset += metadata[i].size();
+    }
+
+    return data;
+}
+
+/* Calls functor(i) for all i in [0, count), spread over multiple threads if
+   there's enough work. The scheduler is created on first use and kept for
+   subsequent calls. Error output of each call is captured and printed on the
+   calling thread afterwards, in order, so it's the same as with a plain
+   loop. */
+template<class F> void forEachInParallel(Containers::Pointer<TaskScheduler>& scheduler, const std::size_t count, F&& functor) {
+    /* Spawning threads for just a few plugins isn't worth it */
+    if(count <= 8 || TaskScheduler::hardwareThreadCount() < 2) {
+        for(std::size_t i = 0; i != count; ++i) functor(i);
+        return;
+    }
+
+    if(!scheduler) scheduler.reset(new TaskScheduler);
+
+    std::vector<std::string> errors(count);
+    scheduler->parallelFor(0, count, 8, [&](const std::size_t begin, const std::size_t end) {
+        for(std::size_t i = begin; i != end; ++i) {
+            std::ostringstream out;
+            {
+                Error redirectError{&out};
+                functor(i);
+            }
+            errors[i] = out.str();
+        }
+    });
+
+    for(const std::string& error: errors)
+        if(!error.empty()) Error{Debug::Flag::NoNewlineAtTheEnd} << error;
+}
+
+}
+#endif
+
 const int AbstractManager::Version = CORRADE_PLUGIN_VERSION;
 
 auto AbstractManager::initializeGlobalPluginStorage() -> GlobalPluginStorage& {
@@ -187,7 +368,7 @@ void AbstractManager::importStaticPlugin(std::string plugin, int _version, std::
 #endif
 
 #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
-AbstractManager::AbstractManager(std::string pluginInterface, const std::vector<std::string>& pluginSearchPaths, std::string pluginDirectory):
+AbstractManager::AbstractManager(std::string pluginInterface, const std::vector<std::string>& pluginSearchPaths, std::string pluginDirectory, const DiscoveryFlags discoveryFlags):
 #else
 AbstractManager::AbstractManager(std::string pluginInterface):
 #endif
@@ -229,6 +410,8 @@ AbstractManager::AbstractManager(std::string pluginInterface):
     }
 
     #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
+    _state->discoveryFlags = discoveryFlags;
+
     /* If plugin directory is set, use it, otherwise loop through */
     if(!pluginDirectory.empty()) setPluginDirectory(std::move(pluginDirectory));
     else {
@@ -267,6 +450,13 @@ AbstractManager::~AbstractManager() {
         }
 
         #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
+        /* Lazily discovered plugin that was never used, nothing to unload */
+        if(!it->second->metadata) {
+            delete it->second;
+            it = _plugins.plugins.erase(it);
+            continue;
+        }
+
         /* Try to unload the plugin (and all plugins that depend on it) */
         const LoadState loadState = unloadRecursiveInternal(*it->second);
 
@@ -348,31 +538,112 @@ void AbstractManager::setPluginDirectory(std::string directory) {
         } else ++it;
     }
 
+    /* All remaining plugins are loaded and thus have their metadata parsed,
+       so nothing references the previous metadata cache anymore */
+    #if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+    _state->mappedMetadataCache = nullptr;
+    #endif
+    _state->metadataCache = nullptr;
+    _state->unresolvedAliases = false;
+
+    /* The cache is kept in a subdirectory, so replacing it doesn't change the
+       modification time of the plugin directory. Creating the subdirectory
+       does, so do it before querying the time. Query the time before listing
+       the directory, so a change done in between makes the cache invalid next
+       time. */
+    const std::string cacheDirectory = Directory::join(_state->pluginDirectory, MetadataCacheDirectory);
+    std::int64_t modificationTime = 0;
+    if(_state->discoveryFlags & DiscoveryFlag::MetadataCache) {
+        if(!Directory::exists(cacheDirectory)) Directory::mkpath(cacheDirectory);
+        modificationTime = directoryModificationTime(_state->pluginDirectory);
+    }
+
     /* Find plugin files in the directory. Sort the list so we have predictable
        plugin preference behavior for aliases on systems that have random
        directory listing order. */
     const std::vector<std::string> d = Directory::list(_state->pluginDirectory,
         Directory::Flag::SkipDirectories|Directory::Flag::SkipDotAndDotDot|
         Directory::Flag::SortAscending);
+    std::vector<std::string> names;
     for(const std::string& filename: d) {
         /* File doesn't have module suffix, continue to next */
         if(!Utility::String::endsWith(filename, PLUGIN_FILENAME_SUFFIX))
             continue;
 
         /* Dig plugin name from filename */
-        const std::string name = filename.substr(0, filename.length() - sizeof(PLUGIN_FILENAME_SUFFIX) + 1);
+        names.push_back(filename.substr(0, filename.length() - sizeof(PLUGIN_FILENAME_SUFFIX) + 1));
+    }
+
+    /* Get contents of all metadata files from the cache. If it doesn't match,
+       read the files and write a new cache. */
+    std::vector<Containers::ArrayView<const char>> cachedMetadata;
+    if(modificationTime) {
+        const std::string cacheFilename = Directory::join(cacheDirectory, MetadataCacheFilename);
+
+        /* The cache is just an optimization, so be quiet about its errors */
+        Error redirectError{nullptr};
+
+        #if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+        if(Directory::exists(cacheFilename))
+            _state->mappedMetadataCache = Directory::mapRead(cacheFilename);
+        if(!parseMetadataCache(_state->mappedMetadataCache, modificationTime, names, cachedMetadata)) {
+            /* Unmap the file so it can be overwritten on Windows */
+            _state->mappedMetadataCache = nullptr;
+        #else
+        if(Directory::exists(cacheFilename))
+            _state->metadataCache = Directory::read(cacheFilename);
+        if(!parseMetadataCache(_state->metadataCache, modificationTime, names, cachedMetadata)) {
+        #endif
+            std::vector<Containers::Array<char>> metadata(names.size());
+            forEachInParallel(_state->scheduler, names.size(), [&](const std::size_t i) {
+                const std::string filename = Directory::join(_state->pluginDirectory, names[i] + ".conf");
+                if(Directory::exists(filename)) metadata[i] = Directory::read(filename);
+            });
+
+            _state->metadataCache = generateMetadataCache(modificationTime, names, metadata);
+
+            /* Other processes may have the previous cache mapped or be
+               reading it right now, so it's never overwritten in place.
+               Instead, a new file is written under a name unique to this
+               manager instance and then moved over the previous one. */
+            const std::string temporaryFilename = cacheFilename + "." + std::to_string(processId()) + "." + std::to_string(reinterpret_cast<std::uintptr_t>(this)) + ".tmp";
+            if(Directory::write(temporaryFilename, _state->metadataCache)) {
+                #ifdef CORRADE_TARGET_WINDOWS
+                /* _wrename() doesn't replace existing files. If the previous
+                   cache is still mapped by another process, the removal and
+                   thus also the move fails and the cache stays as it was. */
+                Directory::rm(cacheFilename);
+                #endif
+                if(!Directory::move(temporaryFilename, cacheFilename))
+                    Directory::rm(temporaryFilename);
+            }
+            CORRADE_INTERNAL_ASSERT_OUTPUT(parseMetadataCache(_state->metadataCache, modificationTime, names, cachedMetadata));
+        }
+    }
 
-        /* Skip the plugin if it is among loaded */
-        if(_plugins.plugins.find(name) != _plugins.plugins.end()) continue;
+    /* Skip plugins that are among loaded. Unless the discovery is lazy, parse
+       metadata of the rest right away, on multiple threads if there's many of
+       them. */
+    std::vector<Plugin*> plugins;
+    for(std::size_t i = 0; i != names.size(); ++i) {
+        if(_plugins.plugins.find(names[i]) != _plugins.plugins.end()) continue;
 
-        registerDynamicPlugin(name, new Plugin{name, Directory::join(_state->pluginDirectory, name + ".conf"), this});
+        Plugin* const plugin = new Plugin{names[i], this};
+        if(!cachedMetadata.empty()) plugin->cachedMetadata = cachedMetadata[i];
+        plugins.push_back(plugin);
     }
+    if(_state->discoveryFlags & DiscoveryFlag::Lazy)
+        _state->unresolvedAliases = !plugins.empty();
+    else parseMetadata(plugins);
+    for(Plugin* const plugin: plugins)
+        registerDynamicPlugin(plugin->metadata ? plugin->metadata->name() : plugin->name, plugin);
 
     /* If some of the currently loaded plugins aliased plugins that werre in
        the old plugin directory, these are no longer there. Refresh the alias
-       list with the new plugins. */
+       list with the new plugins. Lazily discovered plugins get their aliases
+       added in resolveAliases(). */
     for(auto p: _plugins.plugins) {
-        if(p.second->manager != this) continue;
+        if(p.second->manager != this || !p.second->metadata) continue;
 
         /* Add aliases to the list (only the ones that aren't already there are
            added, calling insert() won't overwrite the existing value) */
@@ -389,9 +660,76 @@ void AbstractManager::setPluginDirectory(std::string directory) {
 void AbstractManager::reloadPluginDirectory() {
     setPluginDirectory(pluginDirectory());
 }
+
+DiscoveryFlags AbstractManager::discoveryFlags() const {
+    return _state->discoveryFlags;
+}
+
+void AbstractManager::setDiscoveryFlags(const DiscoveryFlags flags) {
+    _state->discoveryFlags = flags;
+}
+
+void AbstractManager::parseMetadata(Plugin& plugin) const {
+    if(plugin.cachedMetadata) {
+        std::istringstream in{std::string(plugin.cachedMetadata, plugin.cachedMetadata.size())};
+        plugin.configuration = Utility::Configuration{in, Utility::Configuration::Flag::ReadOnly};
+    } else plugin.configuration = Utility::Configuration{Directory::join(_state->pluginDirectory, plugin.name + ".conf"), Utility::Configuration::Flag::ReadOnly};
+
+    plugin.metadata.emplace(std::move(plugin.name), plugin.configuration);
+    plugin.cachedMetadata = nullptr;
+    plugin.loadState = plugin.configuration.isValid() ? LoadState::NotLoaded : LoadState::WrongMetadataFile;
+}
+
+void AbstractManager::parseMetadata(const std::vector<Plugin*>& plugins) const {
+    forEachInParallel(_state->scheduler, plugins.size(), [&](const std::size_t i) {
+        parseMetadata(*plugins[i]);
+    });
+}
+
+void AbstractManager::resolveAliases() const {
+    if(!_state->unresolvedAliases) return;
+
+    std::vector<Plugin*> plugins;
+    for(const auto& plugin: _plugins.plugins)
+        if(plugin.second->manager == this && !plugin.second->metadata)
+            plugins.push_back(plugin.second);
+    parseMetadata(plugins);
+
+    /* Add aliases of all plugins in the same order as setPluginDirectory()
+       would, so the preference is the same as with non-lazy discovery */
+    for(const auto& plugin: _plugins.plugins) {
+        if(plugin.second->manager != this) continue;
+
+        /** @todo put back emplace() here when libc++ is fixed */
+        for(const std::string& alias: plugin.second->metadata->_provides)
+            _state->aliases.insert({alias, *plugin.second});
+    }
+
+    _state->unresolvedAliases = false;
+}
 #endif
 
+auto AbstractManager::findPlugin(const std::string& plugin) const -> Plugin* {
+    auto found = _state->aliases.find(plugin);
+    #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
+    if(found == _state->aliases.end() && _state->unresolvedAliases) {
+        resolveAliases();
+        found = _state->aliases.find(plugin);
+    }
+    #endif
+    if(found == _state->aliases.end()) return nullptr;
+
+    #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
+    if(!found->second.metadata) parseMetadata(found->second);
+    #endif
+    return &found->second;
+}
+
 void AbstractManager::setPreferredPlugins(const std::string& alias, const std::initializer_list<std::string> plugins) {
+    #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
+    resolveAliases();
+    #endif
+
     auto foundAlias = _state->aliases.find(alias);
     CORRADE_ASSERT(foundAlias != _state->aliases.end(),
         "PluginManager::Manager::setPreferredPlugins():" << alias << "is not a known alias", );
@@ -402,6 +740,10 @@ void AbstractManager::setPreferredPlugins(const std::string& alias, const std::i
         if(foundPlugin == _plugins.plugins.end() || foundPlugin->second->manager != this)
             continue;
 
+        #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
+        if(!foundPlugin->second->metadata) parseMetadata(*foundPlugin->second);
+        #endif
+
         CORRADE_ASSERT(std::find(foundPlugin->second->metadata->provides().begin(), foundPlugin->second->metadata->provides().end(), alias) != foundPlugin->second->metadata->provides().end(),
             "PluginManager::Manager::setPreferredPlugins():" << plugin << "does not provide" << alias, );
         _state->aliases.erase(foundAlias);
@@ -422,28 +764,29 @@ std::vector<std::string> AbstractManager::pluginList() const {
 }
 
 std::vector<std::string> AbstractManager::aliasList() const {
+    #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
+    resolveAliases();
+    #endif
+
     std::vector<std::string> names;
     for(const auto& alias: _state->aliases) names.push_back(alias.first);
     return names;
 }
 
 const PluginMetadata* AbstractManager::metadata(const std::string& plugin) const {
-    auto found = _state->aliases.find(plugin);
-    if(found != _state->aliases.end()) return &*found->second.metadata;
+    if(Plugin* const found = findPlugin(plugin)) return &*found->metadata;
 
     return nullptr;
 }
 
 PluginMetadata* AbstractManager::metadata(const std::string& plugin) {
-    auto found = _state->aliases.find(plugin);
-    if(found != _state->aliases.end()) return &*found->second.metadata;
+    if(Plugin* const found = findPlugin(plugin)) return &*found->metadata;
 
     return nullptr;
 }
 
 LoadState AbstractManager::loadState(const std::string& plugin) const {
-    auto found = _state->aliases.find(plugin);
-    if(found != _state->aliases.end()) return found->second.loadState;
+    if(Plugin* const found = findPlugin(plugin)) return found->loadState;
 
     return LoadState::NotFound;
 }
@@ -493,12 +836,11 @@ LoadState AbstractManager::load(const std::string& plugin) {
     }
     #endif
 
-    auto found = _state->aliases.find(plugin);
-    if(found != _state->aliases.end()) {
+    if(Plugin* const found = findPlugin(plugin)) {
         #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
-        return loadInternal(found->second);
+        return loadInternal(*found);
         #else
-        return found->second.loadState;
+        return found->loadState;
         #endif
     }
 
@@ -513,6 +855,9 @@ LoadState AbstractManager::load(const std::string& plugin) {
 
 #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
 LoadState AbstractManager::loadInternal(Plugin& plugin) {
+    /* A dependency that was discovered lazily and not used yet */
+    if(!plugin.metadata) parseMetadata(plugin);
+
     return loadInternal(plugin, Directory::join(_state->pluginDirectory, plugin.metadata->_name + PLUGIN_FILENAME_SUFFIX));
 }
 
@@ -646,12 +991,11 @@ LoadState AbstractManager::loadInternal(Plugin& plugin, const std::string& filen
 #endif
 
 LoadState AbstractManager::unload(const std::string& plugin) {
-    auto found = _state->aliases.find(plugin);
-    if(found != _state->aliases.end()) {
+    if(Plugin* const found = findPlugin(plugin)) {
         #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
-        return unloadInternal(found->second);
+        return unloadInternal(*found);
         #else
-        return found->second.loadState;
+        return found->loadState;
         #endif
     }
 
@@ -752,6 +1096,9 @@ void AbstractManager::registerDynamicPlugin(const std::string& name, Plugin* con
         CORRADE_INTERNAL_ASSERT_OUTPUT(_state->aliases.insert({name, *result.first->second}).second);
     }
 
+    /* With lazy discovery the aliases are added later in resolveAliases() */
+    if(!plugin->metadata) return;
+
     /* Add aliases to the list. Calling insert() won't overwrite the
        existing value, which ensures that the above note is still held. */
     for(const std::string& alias: result.first->second->metadata->_provides) {
@@ -765,27 +1112,27 @@ void AbstractManager::registerDynamicPlugin(const std::string& name, Plugin* con
 
 void AbstractManager::registerInstance(const std::string& plugin, AbstractPlugin& instance, const PluginMetadata*& metadata) {
     /** @todo assert proper interface */
-    auto found = _state->aliases.find(plugin);
+    Plugin* const found = findPlugin(plugin);
 
-    CORRADE_ASSERT(found != _state->aliases.end() && found->second.manager == this,
+    CORRADE_ASSERT(found && found->manager == this,
         "PluginManager::AbstractPlugin::AbstractPlugin(): attempt to register instance of plugin not known to given manager", );
 
     auto foundInstance = _state->instances.find(plugin);
 
     if(foundInstance == _state->instances.end())
-        foundInstance = _state->instances.insert({found->second.metadata->name(), {}}).first;
+        foundInstance = _state->instances.insert({found->metadata->name(), {}}).first;
 
     foundInstance->second.push_back(&instance);
 
-    metadata = &*found->second.metadata;
+    metadata = &*found->metadata;
 }
 
 void AbstractManager::unregisterInstance(const std::string& plugin, AbstractPlugin& instance) {
-    auto found = _state->aliases.find(plugin);
+    Plugin* const found = findPlugin(plugin);
 
-    CORRADE_INTERNAL_ASSERT(found != _state->aliases.end() && found->second.manager == this);
+    CORRADE_INTERNAL_ASSERT(found && found->manager == this);
 
-    auto foundInstance = _state->instances.find(found->second.metadata->name());
+    auto foundInstance = _state->instances.find(found->metadata->name());
     CORRADE_INTERNAL_ASSERT(foundInstance != _state->instances.end());
     std::vector<AbstractPlugin*>& instancesForPlugin = foundInstance->second;
 
@@ -798,12 +1145,12 @@ void AbstractManager::unregisterInstance(const std::string& plugin, AbstractPlug
 }
 
 Containers::Pointer<AbstractPlugin> AbstractManager::instantiateInternal(const std::string& plugin) {
-    auto found = _state->aliases.find(plugin);
+    Plugin* const found = findPlugin(plugin);
 
-    CORRADE_ASSERT(found != _state->aliases.end() && (found->second.loadState & LoadState::Loaded),
+    CORRADE_ASSERT(found && (found->loadState & LoadState::Loaded),
         "PluginManager::Manager::instantiate(): plugin" << plugin << "is not loaded", nullptr);
 
-    return Containers::pointer(static_cast<AbstractPlugin*>(found->second.instancer(*this, plugin)));
+    return Containers::pointer(static_cast<AbstractPlugin*>(found->instancer(*this, plugin)));
 }
 
 Containers::Pointer<AbstractPlugin> AbstractManager::loadAndInstantiateInternal(const std::string& plugin) {
@@ -829,6 +1176,8 @@ Containers::Pointer<AbstractPlugin> AbstractManager::loadAndInstantiateInternal(
 AbstractManager::Plugin::Plugin(std::string name, const std::string& metadata, AbstractManager* manager): configuration{metadata, Utility::Configuration::Flag::ReadOnly}, metadata{Containers::InPlaceInit, std::move(name), configuration}, manager{manager}, instancer{nullptr}, module{nullptr} {
     loadState = configuration.isValid() ? LoadState::NotLoaded : LoadState::WrongMetadataFile;
 }
+
+AbstractManager::Plugin::Plugin(std::string name, AbstractManager* manager): loadState{LoadState::NotLoaded}, manager{manager}, instancer{nullptr}, module{nullptr}, name{std::move(name)} {}
 #endif
 
 AbstractManager::Plugin::Plugin(StaticPlugin* staticPlugin): loadState{LoadState::Static}, manager{nullptr}, instancer{staticPlugin->instancer}, staticPlugin{staticPlugin} {}
@@ -867,6 +1216,25 @@ Utility::Debug& operator<<(Utility::Debug& debug, PluginManager::LoadState value
 
     return debug << "PluginManager::LoadState(" << Debug::nospace << reinterpret_cast<void*>(std::uint16_t(value)) << Debug::nospace << ")";
 }
+
+Utility::Debug& operator<<(Utility::Debug& debug, const PluginManager::DiscoveryFlag value) {
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(value) case PluginManager::DiscoveryFlag::value: return debug << "PluginManager::DiscoveryFlag::" #value;
+        _c(Lazy)
+        _c(MetadataCache)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "PluginManager::DiscoveryFlag(" << Debug::nospace << reinterpret_cast<void*>(std::uint8_t(value)) << Debug::nospace << ")";
+}
+
+Utility::Debug& operator<<(Utility::Debug& debug, const PluginManager::DiscoveryFlags value) {
+    return Containers::enumSetDebugOutput(debug, value, "PluginManager::DiscoveryFlags{}", {
+        PluginManager::DiscoveryFlag::Lazy,
+        PluginManager::DiscoveryFlag::MetadataCache});
+}
 #endif
 
 }}
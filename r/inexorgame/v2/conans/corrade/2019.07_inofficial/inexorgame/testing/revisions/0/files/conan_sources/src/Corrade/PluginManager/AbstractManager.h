@@ -26,7 +26,7 @@
 */
 
 /** @file
- * @brief Class @ref Corrade::PluginManager::AbstractManager, macro @ref CORRADE_PLUGIN_VERSION, @ref CORRADE_PLUGIN_REGISTER()
+ * @brief Class @ref Corrade::PluginManager::AbstractManager, enum @ref Corrade::PluginManager::LoadState, @ref Corrade::PluginManager::DiscoveryFlag, enum set @ref Corrade::PluginManager::LoadStates, @ref Corrade::PluginManager::DiscoveryFlags, macro @ref CORRADE_PLUGIN_VERSION, @ref CORRADE_PLUGIN_REGISTER()
  */
 
 #include "Corrade/Containers/EnumSet.h"
@@ -186,6 +186,63 @@ typedef Containers::EnumSet<LoadState> LoadStates;
 
 CORRADE_ENUMSET_OPERATORS(LoadStates)
 
+/**
+@brief Plugin discovery flag
+
+@see @ref DiscoveryFlags, @ref Manager::Manager(std::string, DiscoveryFlags),
+    @ref AbstractManager::setDiscoveryFlags()
+*/
+enum class DiscoveryFlag: unsigned char {
+    /**
+     * Only list plugin filenames in the plugin directory and parse metadata
+     * of a particular plugin on first call to @ref AbstractManager::metadata(),
+     * @ref AbstractManager::loadState() or @ref AbstractManager::load() with
+     * its name. Aliases provided by plugins are not known until the metadata
+     * are parsed, so the first query for a name that's not a plugin name and
+     * also @ref AbstractManager::aliasList() or
+     * @ref AbstractManager::setPreferredPlugins() parse metadata of all
+     * remaining plugins. The resulting plugin and alias state is the same as
+     * without this flag.
+     */
+    Lazy = 1 << 0,
+
+    /**
+     * Read metadata of all plugins from a single binary cache file in a
+     * `corrade-plugin-metadata-cache/` subdirectory of the plugin directory
+     * instead of opening every `*.conf` file separately. The cache is keyed
+     * by modification time of the plugin directory and by the list of
+     * plugins in it --- if either of these doesn't match or the cache
+     * doesn't exist yet, the metadata files are read again and the cache is
+     * regenerated. A regenerated cache is written to a temporary file first
+     * and then moved over the previous one, so processes sharing the same
+     * plugin directory never see a partially written cache. Errors when
+     * reading or writing the cache are silently ignored, the metadata files
+     * are used directly in that case.
+     *
+     * Note that modifying a `*.conf` file in place doesn't change the
+     * directory modification time, so the cache picks the change up only
+     * once a plugin is added, removed or renamed or the file is replaced
+     * with a new one, as package managers and `cmake --install` do.
+     */
+    MetadataCache = 1 << 1
+};
+
+/** @debugoperatorenum{DiscoveryFlag} */
+CORRADE_PLUGINMANAGER_EXPORT Utility::Debug& operator<<(Utility::Debug& debug, PluginManager::DiscoveryFlag value);
+
+/**
+@brief Plugin discovery flags
+
+@see @ref Manager::Manager(std::string, DiscoveryFlags),
+    @ref AbstractManager::setDiscoveryFlags()
+*/
+typedef Containers::EnumSet<DiscoveryFlag> DiscoveryFlags;
+
+CORRADE_ENUMSET_OPERATORS(DiscoveryFlags)
+
+/** @debugoperatorenum{DiscoveryFlags} */
+CORRADE_PLUGINMANAGER_EXPORT Utility::Debug& operator<<(Utility::Debug& debug, PluginManager::DiscoveryFlags value);
+
 /**
 @brief Non-templated base for plugin managers
 
@@ -251,6 +308,26 @@ class CORRADE_PLUGINMANAGER_EXPORT AbstractManager {
          *      @ref CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT "dynamic plugin support".
          */
         void reloadPluginDirectory();
+
+        /**
+         * @brief Plugin discovery flags
+         *
+         * @partialsupport Not available on platforms without
+         *      @ref CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT "dynamic plugin support".
+         */
+        DiscoveryFlags discoveryFlags() const;
+
+        /**
+         * @brief Set plugin discovery flags
+         *
+         * The flags are used by the next call to @ref setPluginDirectory()
+         * or @ref reloadPluginDirectory(), plugins that were already found
+         * are not affected. Use @ref Manager::Manager(std::string, DiscoveryFlags)
+         * to set the flags for the initial discovery.
+         * @partialsupport Not available on platforms without
+         *      @ref CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT "dynamic plugin support".
+         */
+        void setDiscoveryFlags(DiscoveryFlags flags);
         #endif
 
         /**
@@ -379,7 +456,7 @@ class CORRADE_PLUGINMANAGER_EXPORT AbstractManager {
         struct CORRADE_PLUGINMANAGER_LOCAL GlobalPluginStorage;
 
         #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
-        explicit AbstractManager(std::string pluginInterface, const std::vector<std::string>& pluginSearchPaths, std::string pluginDirectory);
+        explicit AbstractManager(std::string pluginInterface, const std::vector<std::string>& pluginSearchPaths, std::string pluginDirectory, DiscoveryFlags discoveryFlags = {});
         #else
         explicit AbstractManager(std::string pluginInterface);
         #endif
@@ -412,6 +489,11 @@ class CORRADE_PLUGINMANAGER_EXPORT AbstractManager {
 
         CORRADE_PLUGINMANAGER_LOCAL void registerDynamicPlugin(const std::string& name, Plugin* plugin);
 
+        /* Finds a plugin by its name or alias. With lazy discovery makes sure
+           the metadata of the found plugin are parsed and, if the name isn't
+           known yet, resolves aliases of all plugins first. */
+        CORRADE_PLUGINMANAGER_LOCAL Plugin* findPlugin(const std::string& plugin) const;
+
         CORRADE_PLUGINMANAGER_LOCAL void registerInstance(const std::string& plugin, AbstractPlugin& instance, const PluginMetadata*& metadata);
         CORRADE_PLUGINMANAGER_LOCAL void unregisterInstance(const std::string& plugin, AbstractPlugin& instance);
 
@@ -421,6 +503,10 @@ class CORRADE_PLUGINMANAGER_EXPORT AbstractManager {
         CORRADE_PLUGINMANAGER_LOCAL LoadState unloadInternal(Plugin& plugin);
         CORRADE_PLUGINMANAGER_LOCAL LoadState unloadRecursive(const std::string& plugin);
         CORRADE_PLUGINMANAGER_LOCAL LoadState unloadRecursiveInternal(Plugin& plugin);
+
+        CORRADE_PLUGINMANAGER_LOCAL void parseMetadata(Plugin& plugin) const;
+        CORRADE_PLUGINMANAGER_LOCAL void parseMetadata(const std::vector<Plugin*>& plugins) const;
+        CORRADE_PLUGINMANAGER_LOCAL void resolveAliases() const;
         #endif
 
         Containers::Pointer<State> _state;
@@ -56,8 +56,8 @@ for a detailed usage tutorial.
 
 Plugins are searched in the following directories, in order:
 
-1.  If a non-empty `pluginDirectory` was passed to the @ref Manager(std::string)
-    constructor, plugins are searched there.
+1.  If a non-empty `pluginDirectory` was passed to the
+    @ref Manager(std::string, DiscoveryFlags) constructor, plugins are searched there.
 2.  Otherwise, it's expected that given plugin interface defined
     @ref AbstractPlugin::pluginSearchPaths(). The search goes through the
     entries and stops once an existing directory is found.
@@ -71,6 +71,28 @@ and no plugin with the same name is expected to be loaded at the same time. If
 loading succeeds, the module is exposed through the API under its basename
 (excluding extension).
 
+@section PluginManager-Manager-discovery Plugin discovery
+
+By default, metadata of all plugins in the plugin directory are read and parsed
+already in the constructor and in @ref setPluginDirectory(). With many plugins
+the metadata files are parsed on multiple threads, if Corrade is built with
+`BUILD_MULTITHREADED`. The worker threads are created on first use and kept
+for the whole lifetime of the manager. Startup of applications that use only a
+few plugins out of many, especially if the plugin directory is on a slow
+filesystem, can be sped up further with @ref DiscoveryFlags passed to the
+constructor:
+
+-   @ref DiscoveryFlag::Lazy only lists the plugin directory and parses
+    metadata of a plugin only once it's queried or loaded
+-   @ref DiscoveryFlag::MetadataCache reads metadata of all plugins from a
+    single cache file in the `corrade-plugin-metadata-cache/` subdirectory of
+    the plugin directory, regenerating it when the directory contents change
+
+@code{.cpp}
+PluginManager::Manager<Trade::AbstractImporter> manager{{},
+    PluginManager::DiscoveryFlag::Lazy|PluginManager::DiscoveryFlag::MetadataCache};
+@endcode
+
 @section PluginManager-Manager-reload Plugin loading, instantiation and unloading
 
 A plugin is loaded by calling @ref load() with given plugin name or alias.
@@ -114,6 +136,8 @@ template<class T> class Manager: public AbstractManager {
          * @param pluginDirectory   Optional directory where plugins will be
          *      searched. See @ref PluginManager-Manager-paths for more
          *      information.
+         * @param discoveryFlags    Plugin discovery flags. See
+         *      @ref PluginManager-Manager-discovery for more information.
          *
          * First goes through list of static plugins and finds ones that use
          * the same interface as this manager instance. Then gets list of all
@@ -122,15 +146,18 @@ template<class T> class Manager: public AbstractManager {
          *      should have all dependencies present. Also, dynamic plugins
          *      with the same name as another static plugin are skipped.
          * @see @ref pluginList()
-         * @partialsupport The @p pluginDirectory parameter has no effect on
-         *      platforms without
+         * @partialsupport The @p pluginDirectory and @p discoveryFlags
+         *      parameters have no effect on platforms without
          *      @ref CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT "dynamic plugin support".
          */
-        explicit Manager(std::string pluginDirectory = {}):
+        explicit Manager(std::string pluginDirectory = {}, DiscoveryFlags discoveryFlags = {}):
             #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
-            AbstractManager{T::pluginInterface(), T::pluginSearchPaths(), std::move(pluginDirectory)} {}
+            AbstractManager{T::pluginInterface(), T::pluginSearchPaths(), std::move(pluginDirectory), discoveryFlags} {}
             #else
-            AbstractManager{T::pluginInterface()} { static_cast<void>(pluginDirectory); }
+            AbstractManager{T::pluginInterface()} {
+                static_cast<void>(pluginDirectory);
+                static_cast<void>(discoveryFlags);
+            }
             #endif
 
         /**
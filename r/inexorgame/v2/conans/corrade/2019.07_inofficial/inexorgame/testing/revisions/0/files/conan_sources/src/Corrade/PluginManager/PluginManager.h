@@ -33,6 +33,8 @@ namespace Corrade { namespace PluginManager {
 
 enum class LoadState: unsigned short;
 /* LoadStates won't be used without LoadState definition */
+enum class DiscoveryFlag: unsigned char;
+/* DiscoveryFlags won't be used without DiscoveryFlag definition */
 
 class AbstractManager;
 template<class> class AbstractManagingPlugin;
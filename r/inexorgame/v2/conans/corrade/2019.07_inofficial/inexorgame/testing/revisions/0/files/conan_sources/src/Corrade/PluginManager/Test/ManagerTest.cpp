@@ -33,6 +33,7 @@
 #include "Corrade/Utility/DebugStl.h" /** @todo remove when <sstream> is gone */
 #include "Corrade/Utility/Directory.h"
 #include "Corrade/Utility/Configuration.h"
+#include "Corrade/Utility/FormatStl.h"
 
 #include "AbstractAnimal.h"
 #include "AbstractFood.h"
@@ -112,11 +113,25 @@ struct ManagerTest: TestSuite::Tester {
     void setPreferredPluginsOverridePrimaryPlugin();
     #endif
 
+    #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
+    void discoveryLazy();
+    void discoveryLazyAliases();
+    void discoveryLazyWrongMetadataFile();
+    void discoveryLazyDependency();
+    void discoveryLazyReloadPluginDirectory();
+    void discoveryParallel();
+    void discoveryMetadataCache();
+    void discoveryMetadataCacheInvalid();
+    void discoveryMetadataCacheLazy();
+    #endif
+
     #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
     void utf8Path();
     #endif
 
     void debug();
+    void debugDiscoveryFlag();
+    void debugDiscoveryFlags();
 };
 
 ManagerTest::ManagerTest() {
@@ -178,11 +193,25 @@ ManagerTest::ManagerTest() {
               &ManagerTest::setPreferredPluginsOverridePrimaryPlugin,
               #endif
 
+              #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
+              &ManagerTest::discoveryLazy,
+              &ManagerTest::discoveryLazyAliases,
+              &ManagerTest::discoveryLazyWrongMetadataFile,
+              &ManagerTest::discoveryLazyDependency,
+              &ManagerTest::discoveryLazyReloadPluginDirectory,
+              &ManagerTest::discoveryParallel,
+              &ManagerTest::discoveryMetadataCache,
+              &ManagerTest::discoveryMetadataCacheInvalid,
+              &ManagerTest::discoveryMetadataCacheLazy,
+              #endif
+
               #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
               &ManagerTest::utf8Path,
               #endif
 
-              &ManagerTest::debug});
+              &ManagerTest::debug,
+              &ManagerTest::debugDiscoveryFlag,
+              &ManagerTest::debugDiscoveryFlags});
 
     initialize();
 }
@@ -938,6 +967,268 @@ void ManagerTest::setPreferredPluginsOverridePrimaryPlugin() {
     CORRADE_COMPARE(manager.metadata("Dog")->name(), "Dog");
 }
 
+void ManagerTest::discoveryLazy() {
+    PluginManager::Manager<AbstractAnimal> manager{{}, DiscoveryFlag::Lazy};
+    CORRADE_COMPARE(manager.discoveryFlags(), DiscoveryFlag::Lazy);
+
+    /* The plugin list doesn't need any metadata */
+    CORRADE_COMPARE_AS(manager.pluginList(), (std::vector<std::string>{
+        "Bulldog", "Canary", "Dog", "PitBull", "Snail"}), TestSuite::Compare::Container);
+
+    CORRADE_VERIFY(manager.metadata("Dog"));
+    CORRADE_COMPARE(manager.metadata("Dog")->provides(), (std::vector<std::string>{"JustSomeMammal", "AGoodBoy"}));
+    CORRADE_COMPARE(manager.metadata("Dog")->data().value("description"), "A simple dog plugin.");
+    CORRADE_COMPARE(manager.loadState("Dog"), LoadState::NotLoaded);
+    CORRADE_COMPARE(manager.load("Dog"), LoadState::Loaded);
+
+    {
+        Containers::Pointer<AbstractAnimal> animal = manager.instantiate("Dog");
+        CORRADE_VERIFY(animal);
+        CORRADE_COMPARE(animal->name(), "Doug");
+    }
+
+    CORRADE_COMPARE(manager.unload("Dog"), LoadState::NotLoaded);
+}
+
+void ManagerTest::discoveryLazyAliases() {
+    /* Plugins are global, so only one manager can have them at a time */
+    std::vector<std::string> aliases;
+    std::vector<std::string> aliasNames;
+    {
+        PluginManager::Manager<AbstractAnimal> manager;
+        aliases = manager.aliasList();
+        for(const std::string& alias: aliases)
+            aliasNames.push_back(manager.metadata(alias)->name());
+    }
+
+    PluginManager::Manager<AbstractAnimal> manager{{}, DiscoveryFlag::Lazy};
+
+    /* Aliases are resolved on first query for a name that isn't a plugin */
+    CORRADE_COMPARE(manager.loadState("JustSomeMammal"), LoadState::NotLoaded);
+    CORRADE_VERIFY(manager.metadata("JustSomeMammal"));
+    CORRADE_COMPARE(manager.metadata("JustSomeMammal")->name(), "Dog");
+
+    /* Everything is the same as with eager discovery */
+    CORRADE_COMPARE_AS(manager.aliasList(), aliases,
+        TestSuite::Compare::Container);
+    std::vector<std::string> lazyAliasNames;
+    for(const std::string& alias: aliases)
+        lazyAliasNames.push_back(manager.metadata(alias)->name());
+    CORRADE_COMPARE_AS(lazyAliasNames, aliasNames,
+        TestSuite::Compare::Container);
+
+    /* Preferred plugins resolve the aliases too */
+    manager.reloadPluginDirectory();
+    manager.setPreferredPlugins("JustSomeMammal", {"PitBull"});
+    CORRADE_COMPARE(manager.metadata("JustSomeMammal")->name(), "PitBull");
+}
+
+void ManagerTest::discoveryLazyWrongMetadataFile() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    PluginManager::Manager<WrongMetadata> manager{{}, DiscoveryFlag::Lazy};
+    /* Nothing is parsed until the plugin is queried */
+    CORRADE_COMPARE(out.str(), "");
+
+    CORRADE_COMPARE(manager.loadState("WrongMetadata"), LoadState::WrongMetadataFile);
+    CORRADE_COMPARE(manager.load("WrongMetadata"), LoadState::WrongMetadataFile);
+    CORRADE_COMPARE(out.str(),
+        "Utility::Configuration::Configuration(): missing equals for a value\n"
+        "PluginManager::Manager::load(): plugin WrongMetadata is not ready to load: PluginManager::LoadState::WrongMetadataFile\n");
+}
+
+void ManagerTest::discoveryLazyDependency() {
+    PluginManager::Manager<AbstractAnimal> manager{{}, DiscoveryFlag::Lazy};
+
+    /* Dog gets parsed and loaded as a dependency */
+    CORRADE_COMPARE(manager.load("PitBull"), LoadState::Loaded);
+    CORRADE_COMPARE(manager.loadState("Dog"), LoadState::Loaded);
+    CORRADE_COMPARE(manager.metadata("Dog")->usedBy(), std::vector<std::string>{"PitBull"});
+
+    /* Manager destruction unloads both, the unused plugins are just
+       deleted */
+}
+
+void ManagerTest::discoveryLazyReloadPluginDirectory() {
+    PluginManager::Manager<AbstractAnimal> manager;
+    CORRADE_COMPARE(manager.discoveryFlags(), DiscoveryFlags{});
+    CORRADE_COMPARE(manager.load("Dog"), LoadState::Loaded);
+
+    /* Applied on the next reload, the loaded plugin stays untouched */
+    manager.setDiscoveryFlags(DiscoveryFlag::Lazy);
+    CORRADE_COMPARE(manager.discoveryFlags(), DiscoveryFlag::Lazy);
+    manager.reloadPluginDirectory();
+    CORRADE_COMPARE(manager.loadState("Dog"), LoadState::Loaded);
+    CORRADE_COMPARE(manager.metadata("AGoodBoy")->name(), "Dog");
+    CORRADE_COMPARE(manager.metadata("PitBull")->depends(), std::vector<std::string>{"Dog"});
+    CORRADE_COMPARE_AS(manager.aliasList(), (std::vector<std::string>{
+        "AGoodBoy", "Bulldog", "Canary", "Dog", "JustSomeBird", "JustSomeMammal", "PitBull", "Snail"}), TestSuite::Compare::Container);
+}
+
+void ManagerTest::discoveryParallel() {
+    /* Enough plugins to parse them on multiple threads, if available. Only
+       metadata are needed, so the plugin binaries are just empty files. */
+    const std::string pluginsDir = Utility::Directory::join(PLUGINS_DIR, "discovery-parallel");
+    CORRADE_VERIFY(Utility::Directory::mkpath(pluginsDir));
+    std::vector<std::string> expectedPlugins{"Canary"};
+    for(std::size_t i = 0; i != 40; ++i) {
+        const std::string name = Utility::formatString("Plugin{:.2}", i);
+        expectedPlugins.push_back(name);
+        CORRADE_VERIFY(Utility::Directory::writeString(
+            Utility::Directory::join(pluginsDir, name + PLUGIN_FILENAME_SUFFIX), {}));
+        CORRADE_VERIFY(Utility::Directory::writeString(
+            Utility::Directory::join(pluginsDir, name + ".conf"),
+            i % 13 == 5 ? "broken\n" : Utility::formatString(
+                "provides=Alias{}\n[data]\nindex={}\n", i % 2, i)));
+    }
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    PluginManager::Manager<AbstractAnimal> manager{pluginsDir};
+    CORRADE_COMPARE_AS(manager.pluginList(), expectedPlugins,
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(manager.metadata("Plugin04")->data().value<int>("index"), 4);
+    CORRADE_COMPARE(manager.metadata("Plugin37")->data().value<int>("index"), 37);
+    CORRADE_COMPARE(manager.loadState("Plugin05"), LoadState::WrongMetadataFile);
+    CORRADE_COMPARE(manager.loadState("Plugin18"), LoadState::WrongMetadataFile);
+    CORRADE_COMPARE(manager.loadState("Plugin31"), LoadState::WrongMetadataFile);
+
+    /* The first plugin providing the alias wins, same as when parsing
+       serially */
+    CORRADE_COMPARE(manager.metadata("Alias0")->name(), "Plugin00");
+    CORRADE_COMPARE(manager.metadata("Alias1")->name(), "Plugin01");
+
+    /* Errors are printed in order and not interleaved */
+    CORRADE_COMPARE(out.str(),
+        "Utility::Configuration::Configuration(): missing equals for a value\n"
+        "Utility::Configuration::Configuration(): missing equals for a value\n"
+        "Utility::Configuration::Configuration(): missing equals for a value\n");
+}
+
+void ManagerTest::discoveryMetadataCache() {
+    const std::string pluginsDir = Utility::Directory::join(PLUGINS_DIR, "discovery-cache");
+    const std::string cacheDir = Utility::Directory::join(pluginsDir, "corrade-plugin-metadata-cache");
+    const std::string cacheFile = Utility::Directory::join(cacheDir, "metadata.cache");
+    CORRADE_VERIFY(Utility::Directory::mkpath(pluginsDir));
+    Utility::Directory::rm(cacheFile);
+    Utility::Directory::rm(Utility::Directory::join(pluginsDir, std::string("PitBull") + PLUGIN_FILENAME_SUFFIX));
+    Utility::Directory::rm(Utility::Directory::join(pluginsDir, "PitBull.conf"));
+    CORRADE_VERIFY(Utility::Directory::write(
+        Utility::Directory::join(pluginsDir, std::string("Dog") + PLUGIN_FILENAME_SUFFIX),
+        Utility::Directory::mapRead(Utility::Directory::join(PLUGINS_DIR, std::string("Dog") + PLUGIN_FILENAME_SUFFIX))));
+    CORRADE_VERIFY(Utility::Directory::write(
+        Utility::Directory::join(pluginsDir, "Dog.conf"),
+        Utility::Directory::mapRead(Utility::Directory::join(PLUGINS_DIR, "Dog.conf"))));
+
+    /* The first run creates the cache */
+    {
+        PluginManager::Manager<AbstractAnimal> manager{pluginsDir, DiscoveryFlag::MetadataCache};
+        CORRADE_COMPARE(manager.metadata("AGoodBoy")->name(), "Dog");
+        CORRADE_VERIFY(Utility::Directory::exists(cacheFile));
+    }
+
+    /* Modifying the file in place doesn't change the directory modification
+       time, so the cached metadata are used instead */
+    CORRADE_VERIFY(Utility::Directory::writeString(
+        Utility::Directory::join(pluginsDir, "Dog.conf"),
+        "provides=AFluffyBoy\n"));
+    {
+        PluginManager::Manager<AbstractAnimal> manager{pluginsDir, DiscoveryFlag::MetadataCache};
+        CORRADE_COMPARE(manager.metadata("Dog")->provides(), (std::vector<std::string>{"JustSomeMammal", "AGoodBoy"}));
+        CORRADE_COMPARE(manager.metadata("Dog")->data().value("description"), "A simple dog plugin.");
+        CORRADE_COMPARE(manager.load("Dog"), LoadState::Loaded);
+    }
+
+    /* Without the cache the actual file is used */
+    {
+        PluginManager::Manager<AbstractAnimal> manager{pluginsDir};
+        CORRADE_COMPARE(manager.metadata("Dog")->provides(), std::vector<std::string>{"AFluffyBoy"});
+    }
+
+    /* Adding a plugin makes the cache invalid and it gets regenerated */
+    CORRADE_VERIFY(Utility::Directory::write(
+        Utility::Directory::join(pluginsDir, std::string("PitBull") + PLUGIN_FILENAME_SUFFIX),
+        Utility::Directory::mapRead(Utility::Directory::join(PLUGINS_DIR, std::string("PitBull") + PLUGIN_FILENAME_SUFFIX))));
+    CORRADE_VERIFY(Utility::Directory::write(
+        Utility::Directory::join(pluginsDir, "PitBull.conf"),
+        Utility::Directory::mapRead(Utility::Directory::join(PLUGINS_DIR, "PitBull.conf"))));
+    {
+        PluginManager::Manager<AbstractAnimal> manager{pluginsDir, DiscoveryFlag::MetadataCache};
+        CORRADE_COMPARE(manager.metadata("Dog")->provides(), std::vector<std::string>{"AFluffyBoy"});
+        CORRADE_COMPARE(manager.metadata("JustSomeMammal")->name(), "PitBull");
+        CORRADE_COMPARE(manager.load("PitBull"), LoadState::Loaded);
+    }
+
+    /* The cache is replaced with a temporary file, nothing is left behind */
+    CORRADE_COMPARE_AS(Utility::Directory::list(cacheDir, Utility::Directory::Flag::SkipDotAndDotDot),
+        std::vector<std::string>{"metadata.cache"},
+        TestSuite::Compare::Container);
+}
+
+void ManagerTest::discoveryMetadataCacheInvalid() {
+    const std::string pluginsDir = Utility::Directory::join(PLUGINS_DIR, "discovery-cache-invalid");
+    const std::string cacheDir = Utility::Directory::join(pluginsDir, "corrade-plugin-metadata-cache");
+    const std::string cacheFile = Utility::Directory::join(cacheDir, "metadata.cache");
+    CORRADE_VERIFY(Utility::Directory::mkpath(cacheDir));
+    CORRADE_VERIFY(Utility::Directory::writeString(
+        Utility::Directory::join(pluginsDir, std::string("Dog") + PLUGIN_FILENAME_SUFFIX), {}));
+    CORRADE_VERIFY(Utility::Directory::write(
+        Utility::Directory::join(pluginsDir, "Dog.conf"),
+        Utility::Directory::mapRead(Utility::Directory::join(PLUGINS_DIR, "Dog.conf"))));
+    CORRADE_VERIFY(Utility::Directory::writeString(cacheFile, "CPMC garbage"));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    /* The broken cache is silently regenerated */
+    {
+        PluginManager::Manager<AbstractAnimal> manager{pluginsDir, DiscoveryFlag::MetadataCache};
+        CORRADE_COMPARE(manager.metadata("AGoodBoy")->name(), "Dog");
+    }
+    const std::string cache = Utility::Directory::readString(cacheFile);
+    CORRADE_VERIFY(cache.size() > 12);
+
+    /* A truncated cache as well */
+    CORRADE_VERIFY(Utility::Directory::writeString(cacheFile, cache.substr(0, cache.size() - 1)));
+    {
+        PluginManager::Manager<AbstractAnimal> manager{pluginsDir, DiscoveryFlag::MetadataCache};
+        CORRADE_COMPARE(manager.metadata("AGoodBoy")->name(), "Dog");
+    }
+    CORRADE_COMPARE(Utility::Directory::readString(cacheFile), cache);
+
+    CORRADE_COMPARE(out.str(), "");
+}
+
+void ManagerTest::discoveryMetadataCacheLazy() {
+    const std::string pluginsDir = Utility::Directory::join(PLUGINS_DIR, "discovery-cache-lazy");
+    CORRADE_VERIFY(Utility::Directory::mkpath(pluginsDir));
+    CORRADE_VERIFY(Utility::Directory::writeString(
+        Utility::Directory::join(pluginsDir, std::string("Dog") + PLUGIN_FILENAME_SUFFIX), {}));
+    CORRADE_VERIFY(Utility::Directory::write(
+        Utility::Directory::join(pluginsDir, "Dog.conf"),
+        Utility::Directory::mapRead(Utility::Directory::join(PLUGINS_DIR, "Dog.conf"))));
+    CORRADE_VERIFY(Utility::Directory::writeString(
+        Utility::Directory::join(pluginsDir, std::string("Broken") + PLUGIN_FILENAME_SUFFIX), {}));
+    CORRADE_VERIFY(Utility::Directory::writeString(
+        Utility::Directory::join(pluginsDir, "Broken.conf"), "broken\n"));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    /* Once generating the cache and once using it */
+    for(std::size_t i = 0; i != 2; ++i) {
+        PluginManager::Manager<AbstractAnimal> manager{pluginsDir, DiscoveryFlag::Lazy|DiscoveryFlag::MetadataCache};
+        CORRADE_COMPARE(manager.metadata("Dog")->data().value("description"), "A simple dog plugin.");
+        CORRADE_COMPARE(out.str(), "");
+        CORRADE_COMPARE(manager.metadata("AGoodBoy")->name(), "Dog");
+        CORRADE_COMPARE(manager.loadState("Broken"), LoadState::WrongMetadataFile);
+        CORRADE_COMPARE(out.str(), "Utility::Configuration::Configuration(): missing equals for a value\n");
+        out.str({});
+    }
+}
+
 void ManagerTest::utf8Path() {
     /* Copy the dog plugin to a new UTF-8 path */
     const std::string utf8PluginsDir = Utility::Directory::join(PLUGINS_DIR, "hýždě");
@@ -974,6 +1265,20 @@ void ManagerTest::debug() {
     CORRADE_COMPARE(o.str(), "PluginManager::LoadState::Static PluginManager::LoadState(0x3f)\n");
 }
 
+void ManagerTest::debugDiscoveryFlag() {
+    std::ostringstream o;
+
+    Debug(&o) << DiscoveryFlag::MetadataCache << DiscoveryFlag(0xf0);
+    CORRADE_COMPARE(o.str(), "PluginManager::DiscoveryFlag::MetadataCache PluginManager::DiscoveryFlag(0xf0)\n");
+}
+
+void ManagerTest::debugDiscoveryFlags() {
+    std::ostringstream o;
+
+    Debug(&o) << (DiscoveryFlag::Lazy|DiscoveryFlag::MetadataCache) << DiscoveryFlags{};
+    CORRADE_COMPARE(o.str(), "PluginManager::DiscoveryFlag::Lazy|PluginManager::DiscoveryFlag::MetadataCache PluginManager::DiscoveryFlags{}\n");
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Corrade::PluginManager::Test::ManagerTest)
@@ -0,0 +1,339 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "TaskScheduler.h"
+
+#include "Corrade/configure.h"
+
+#if defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include "Corrade/Containers/Array.h"
+#include "Corrade/Utility/Macros.h"
+#endif
+
+namespace Corrade { namespace Utility {
+
+#if defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+namespace {
+
+/* Fixed-size Chase-Lev deque, with memory orderings as described in Lê et
+   al., Correct and Efficient Work-Stealing for Weak Memory Models (PPoPP
+   2013), except that push() publishes with a release store instead of a
+   release fence. Only the owning worker pushes and pops at the bottom, any
+   thread can steal from the top. Instead of growing, push() fails if the
+   deque is full and the caller executes the task directly. */
+class Deque {
+    public:
+        enum: std::size_t { Capacity = 4096 };
+
+        bool push(Implementation::Task* task) {
+            const std::size_t bottom = _bottom.load(std::memory_order_relaxed);
+            const std::size_t top = _top.load(std::memory_order_acquire);
+            if(bottom - top >= Capacity) return false;
+
+            _buffer[bottom % Capacity].store(task, std::memory_order_relaxed);
+            _bottom.store(bottom + 1, std::memory_order_release);
+            return true;
+        }
+
+        Implementation::Task* pop() {
+            /* Indices are unsigned, so bail early to avoid a wraparound */
+            std::size_t bottom = _bottom.load(std::memory_order_relaxed);
+            if(bottom == _top.load(std::memory_order_relaxed)) return nullptr;
+
+            bottom -= 1;
+            _bottom.store(bottom, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            std::size_t top = _top.load(std::memory_order_relaxed);
+
+            /* Lost the last element to a thief */
+            if(top > bottom) {
+                _bottom.store(bottom + 1, std::memory_order_relaxed);
+                return nullptr;
+            }
+
+            Implementation::Task* task = _buffer[bottom % Capacity].load(std::memory_order_relaxed);
+
+            /* Last element, race with thieves for it */
+            if(top == bottom) {
+                if(!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                    task = nullptr;
+                _bottom.store(bottom + 1, std::memory_order_relaxed);
+            }
+
+            return task;
+        }
+
+        Implementation::Task* steal() {
+            std::size_t top = _top.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            const std::size_t bottom = _bottom.load(std::memory_order_acquire);
+            if(top >= bottom) return nullptr;
+
+            Implementation::Task* task = _buffer[top % Capacity].load(std::memory_order_relaxed);
+            if(!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                return nullptr;
+            return task;
+        }
+
+    private:
+        /* The buffer is between top and bottom so these two don't share a
+           cache line */
+        std::atomic<std::size_t> _top{0};
+        std::atomic<Implementation::Task*> _buffer[Capacity];
+        std::atomic<std::size_t> _bottom{0};
+};
+
+struct Worker {
+    Deque deque;
+    std::thread thread;
+    std::uint32_t random;
+};
+
+/* Worker index for threads that don't belong to the scheduler */
+constexpr std::size_t External = ~std::size_t{};
+
+/* How many times an idle worker looks for work before going to sleep */
+constexpr std::size_t IdleSpinCount = 64;
+
+}
+
+struct TaskScheduler::State {
+    explicit State(std::size_t workerCount): workers{Containers::DefaultInit, workerCount} {}
+
+    Implementation::Task* find(std::size_t index);
+
+    Containers::Array<Worker> workers;
+
+    /* Tasks submitted from outside of the workers */
+    std::mutex externalMutex;
+    std::deque<Implementation::Task*> external;
+    std::atomic<std::size_t> externalCount{0};
+
+    /* Count of submitted tasks that weren't taken yet, used to decide
+       whether to go to sleep */
+    std::atomic<std::size_t> queuedCount{0};
+
+    std::mutex sleepMutex;
+    std::condition_variable sleepCondition;
+    std::atomic<std::size_t> sleepingCount{0};
+    std::atomic<bool> stop{false};
+};
+
+namespace {
+
+/* The state is private to TaskScheduler, so it's stored just as an opaque
+   pointer for comparison */
+struct CurrentWorker {
+    const void* state;
+    std::size_t index;
+    std::uint32_t random;
+};
+
+CORRADE_THREAD_LOCAL CurrentWorker currentWorker{nullptr, External, 0x9e3779b9u};
+
+std::uint32_t xorshift(std::uint32_t& state) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+}
+
+Implementation::Task* TaskScheduler::State::find(const std::size_t index) {
+    Implementation::Task* task = nullptr;
+
+    /* Own deque first */
+    if(index != External) task = workers[index].deque.pop();
+
+    /* Then externally submitted tasks. The counter avoids locking the mutex
+       when there's nothing. */
+    if(!task && externalCount.load(std::memory_order_acquire)) {
+        std::lock_guard<std::mutex> lock{externalMutex};
+        if(!external.empty()) {
+            task = external.front();
+            external.pop_front();
+            externalCount.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+
+    /* Then try stealing from others, starting at a random victim */
+    if(!task && !workers.empty()) {
+        const std::size_t start = xorshift(index == External ? currentWorker.random : workers[index].random) % workers.size();
+        for(std::size_t i = 0; i != workers.size() && !task; ++i) {
+            const std::size_t victim = (start + i) % workers.size();
+            if(victim != index) task = workers[victim].deque.steal();
+        }
+    }
+
+    if(task) queuedCount.fetch_sub(1, std::memory_order_relaxed);
+    return task;
+}
+#else
+struct TaskScheduler::State {};
+#endif
+
+std::size_t TaskScheduler::hardwareThreadCount() {
+    #if defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+    const std::size_t count = std::thread::hardware_concurrency();
+    return count ? count : 1;
+    #else
+    return 1;
+    #endif
+}
+
+TaskScheduler::TaskScheduler(std::size_t threadCount) {
+    #if defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+    _threadCount = threadCount ? threadCount : hardwareThreadCount();
+    _state.emplace(_threadCount - 1);
+    for(std::size_t i = 0; i != _state->workers.size(); ++i) {
+        _state->workers[i].random = 0x9e3779b9u*(i + 1);
+        _state->workers[i].thread = std::thread{workerLoop, std::ref(*_state), i};
+    }
+    #else
+    static_cast<void>(threadCount);
+    _threadCount = 1;
+    _state.emplace();
+    #endif
+}
+
+TaskScheduler::~TaskScheduler() {
+    #if defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+    {
+        std::lock_guard<std::mutex> lock{_state->sleepMutex};
+        _state->stop.store(true);
+    }
+    _state->sleepCondition.notify_all();
+    for(Worker& worker: _state->workers) worker.thread.join();
+    #endif
+}
+
+void TaskScheduler::execute(Implementation::Task* const task) {
+    /* The task deletes itself, so fetch the group first. The decrement has
+       to be the last access to the group as it might get destroyed right
+       after. */
+    TaskGroup& group = task->group;
+    task->call(task);
+    group._pending.fetch_sub(1, std::memory_order_release);
+}
+
+void TaskScheduler::workerLoop(State& state, const std::size_t index) {
+    #if defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+    currentWorker.state = &state;
+    currentWorker.index = index;
+
+    for(;;) {
+        Implementation::Task* task = nullptr;
+        for(std::size_t i = 0; i != IdleSpinCount && !task; ++i) {
+            task = state.find(index);
+            if(!task && state.stop.load(std::memory_order_relaxed)) return;
+            if(!task) std::this_thread::yield();
+        }
+
+        if(task) {
+            execute(task);
+            continue;
+        }
+
+        /* Nothing to do for a while, go to sleep. The sleeping count is
+           incremented before checking the queued count, submit() does it the
+           other way around, so either this sees the new task or submit() sees
+           this thread sleeping and wakes it up. */
+        std::unique_lock<std::mutex> lock{state.sleepMutex};
+        state.sleepingCount.fetch_add(1);
+        state.sleepCondition.wait(lock, [&state]() {
+            return state.queuedCount.load() || state.stop.load();
+        });
+        state.sleepingCount.fetch_sub(1);
+    }
+    #else
+    static_cast<void>(state);
+    static_cast<void>(index);
+    #endif
+}
+
+void TaskScheduler::submit(Implementation::Task* const task) {
+    #if defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+    State& state = *_state;
+    state.queuedCount.fetch_add(1);
+
+    /* Submitting from one of the workers, push to its own deque. If it's
+       full, execute the task directly. */
+    if(currentWorker.state == &state) {
+        if(!state.workers[currentWorker.index].deque.push(task)) {
+            state.queuedCount.fetch_sub(1, std::memory_order_relaxed);
+            execute(task);
+            return;
+        }
+
+    /* Submitting from outside */
+    } else {
+        std::lock_guard<std::mutex> lock{state.externalMutex};
+        state.external.push_back(task);
+        state.externalCount.fetch_add(1, std::memory_order_release);
+    }
+
+    if(state.sleepingCount.load()) {
+        std::lock_guard<std::mutex> lock{state.sleepMutex};
+        state.sleepCondition.notify_one();
+    }
+    #else
+    /* TaskGroup::run() executes the tasks directly in this case */
+    static_cast<void>(task);
+    CORRADE_ASSERT_UNREACHABLE();
+    #endif
+}
+
+bool TaskScheduler::runPending() {
+    #if defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+    Implementation::Task* const task = _state->find(currentWorker.state == _state.get() ? currentWorker.index : External);
+    if(!task) return false;
+
+    execute(task);
+    return true;
+    #else
+    return false;
+    #endif
+}
+
+void TaskGroup::wait() {
+    while(_pending.load(std::memory_order_acquire)) {
+        /* Help with executing pending tasks. If there's nothing, the
+           remaining tasks of this group are being executed by others. */
+        if(!_scheduler.runPending()) {
+            #if defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+            std::this_thread::yield();
+            #endif
+        }
+    }
+}
+
+}}
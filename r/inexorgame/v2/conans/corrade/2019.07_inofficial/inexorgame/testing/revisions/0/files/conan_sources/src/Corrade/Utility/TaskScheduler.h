@@ -0,0 +1,308 @@
+#ifndef Corrade_Utility_TaskScheduler_h
+#define Corrade_Utility_TaskScheduler_h
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Corrade::Utility::TaskScheduler, @ref Corrade::Utility::TaskGroup
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "Corrade/Containers/Pointer.h"
+#include "Corrade/Utility/Assert.h"
+#include "Corrade/Utility/visibility.h"
+
+namespace Corrade { namespace Utility {
+
+class TaskGroup;
+
+namespace Implementation {
+    struct Task {
+        explicit Task(void(*call)(Task*), TaskGroup& group) noexcept: call{call}, group(group) {}
+
+        /* Calls the task and deletes it afterwards */
+        void(*call)(Task*);
+        TaskGroup& group;
+    };
+
+    template<class F> struct FunctorTask: Task {
+        template<class G> explicit FunctorTask(TaskGroup& group, G&& functor): Task{callFunctor, group}, functor(std::forward<G>(functor)) {}
+
+        static void callFunctor(Task* task) {
+            FunctorTask<F>* self = static_cast<FunctorTask<F>*>(task);
+            self->functor();
+            delete self;
+        }
+
+        F functor;
+    };
+}
+
+/**
+@brief Work-stealing task scheduler
+
+Executes tasks submitted through @ref TaskGroup or @ref parallelFor() on a pool
+of worker threads. Each worker has its own fixed-size Chase-Lev deque, new
+tasks spawned from a worker are pushed to the bottom of its deque and taken
+back in LIFO order, which keeps the working set hot in the cache. Idle workers
+steal from the top of deques of other workers, taking the oldest and thus
+usually the largest pieces of work. Tasks submitted from threads that don't
+belong to the scheduler go to a shared queue. Workers that can't find any work
+for a while go to sleep and are woken up again once new tasks arrive.
+
+Threads waiting for a @ref TaskGroup help executing pending tasks, so the
+thread that created the scheduler counts as one of its threads as well. A
+scheduler with @ref threadCount() equal to @cpp 3 @ce thus spawns two worker
+threads. A scheduler is meant to be long-lived and shared --- creating one
+per call would make thread creation dominate over any gains.
+
+@code{.cpp}
+Utility::TaskScheduler scheduler;
+
+Containers::Array<float> data = …;
+scheduler.parallelFor(0, data.size(), 4096, [&](std::size_t begin, std::size_t end) {
+    for(std::size_t i = begin; i != end; ++i)
+        data[i] = std::sqrt(data[i]);
+});
+@endcode
+
+Tasks are expected to not throw exceptions and it's not allowed to destroy
+the scheduler while there are still tasks executing.
+
+@section Utility-TaskScheduler-single-threaded Single-threaded fallback
+
+If @ref threadCount() is @cpp 1 @ce, no worker threads are created and all
+tasks are executed directly in the calling thread in submission order, with
+@ref parallelFor() processing the chunks in increasing order. That's always
+the case if Corrade is built without @ref CORRADE_BUILD_MULTITHREADED and on
+@ref CORRADE_TARGET_EMSCRIPTEN "Emscripten", where threads are not generally
+available. Because @ref parallelFor() splits the range the same way
+regardless of thread count, chunk-local results are also the same --- only
+their execution order differs.
+*/
+class CORRADE_UTILITY_EXPORT TaskScheduler {
+    public:
+        /**
+         * @brief Hardware thread count
+         *
+         * Returns the number of concurrent threads supported by the system,
+         * or @cpp 1 @ce if it can't be detected, if Corrade is built without
+         * @ref CORRADE_BUILD_MULTITHREADED or on
+         * @ref CORRADE_TARGET_EMSCRIPTEN "Emscripten".
+         */
+        static std::size_t hardwareThreadCount();
+
+        /**
+         * @brief Constructor
+         * @param threadCount   Thread count including the calling thread.
+         *      If @cpp 0 @ce, @ref hardwareThreadCount() is used.
+         *
+         * Spawns @cpp threadCount - 1 @ce worker threads. If Corrade is built
+         * without @ref CORRADE_BUILD_MULTITHREADED or on
+         * @ref CORRADE_TARGET_EMSCRIPTEN "Emscripten", the count is always
+         * @cpp 1 @ce. See
+         * @ref Utility-TaskScheduler-single-threaded for more information.
+         */
+        explicit TaskScheduler(std::size_t threadCount = 0);
+
+        /** @brief Copying is not allowed */
+        TaskScheduler(const TaskScheduler&) = delete;
+
+        /** @brief Moving is not allowed */
+        TaskScheduler(TaskScheduler&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Stops and joins all worker threads. Expects that all
+         * @ref TaskGroup instances using this scheduler are already done.
+         */
+        ~TaskScheduler();
+
+        /** @brief Copying is not allowed */
+        TaskScheduler& operator=(const TaskScheduler&) = delete;
+
+        /** @brief Moving is not allowed */
+        TaskScheduler& operator=(TaskScheduler&&) = delete;
+
+        /**
+         * @brief Thread count
+         *
+         * Count of worker threads plus one for the calling thread.
+         */
+        std::size_t threadCount() const { return _threadCount; }
+
+        /**
+         * @brief Parallel for loop over an index range
+         * @param begin         Begin of the range
+         * @param end           End of the range
+         * @param grainSize     Maximal size of a chunk
+         * @param functor       Functor called with @cpp (std::size_t begin, std::size_t end) @ce
+         *      of each chunk
+         *
+         * Recursively splits the range in halves until the chunks are not
+         * larger than @p grainSize, spawning the upper halves as tasks that
+         * can be stolen by other threads, and waits until all chunks are
+         * processed. The chunk boundaries depend only on the range and
+         * @p grainSize, not on the thread count. The grain size should be
+         * large enough for the work in a chunk to outweigh the cost of
+         * spawning a task. Expects that @p grainSize is not zero. Can be
+         * called from inside other tasks.
+         */
+        template<class F> void parallelFor(std::size_t begin, std::size_t end, std::size_t grainSize, F&& functor);
+
+    private:
+        friend TaskGroup;
+
+        struct State;
+
+        CORRADE_UTILITY_LOCAL static void execute(Implementation::Task* task);
+        CORRADE_UTILITY_LOCAL static void workerLoop(State& state, std::size_t index);
+        void submit(Implementation::Task* task);
+        bool runPending();
+
+        std::size_t _threadCount;
+        Containers::Pointer<State> _state;
+};
+
+/**
+@brief Task group
+
+Spawns tasks on a @ref TaskScheduler and allows to wait for their completion.
+Tasks can spawn further tasks into the same or a different group.
+
+@code{.cpp}
+Utility::TaskGroup group{scheduler};
+for(const std::string& file: files)
+    group.run([&file]() { process(file); });
+
+group.wait();
+@endcode
+*/
+class CORRADE_UTILITY_EXPORT TaskGroup {
+    public:
+        /** @brief Constructor */
+        explicit TaskGroup(TaskScheduler& scheduler) noexcept: _scheduler(scheduler), _pending{0} {}
+
+        /** @brief Copying is not allowed */
+        TaskGroup(const TaskGroup&) = delete;
+
+        /** @brief Moving is not allowed */
+        TaskGroup(TaskGroup&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Calls @ref wait().
+         */
+        ~TaskGroup() { wait(); }
+
+        /** @brief Copying is not allowed */
+        TaskGroup& operator=(const TaskGroup&) = delete;
+
+        /** @brief Moving is not allowed */
+        TaskGroup& operator=(TaskGroup&&) = delete;
+
+        /** @brief Scheduler the group is using */
+        TaskScheduler& scheduler() { return _scheduler; }
+
+        /**
+         * @brief Run a task
+         *
+         * Submits @p functor to the scheduler. If
+         * @ref TaskScheduler::threadCount() is @cpp 1 @ce, the functor is
+         * called directly.
+         */
+        template<class F> void run(F&& functor);
+
+        /**
+         * @brief Wait for all tasks in the group
+         *
+         * While waiting, the calling thread executes pending tasks of the
+         * scheduler, so it's safe to call from inside a task.
+         */
+        void wait();
+
+    private:
+        friend TaskScheduler;
+
+        TaskScheduler& _scheduler;
+        std::atomic<std::size_t> _pending;
+};
+
+namespace Implementation {
+    /* Splitting for single-threaded execution, calls the functor in order */
+    template<class F> void parallelForSerial(const std::size_t begin, const std::size_t end, const std::size_t grainSize, F& functor) {
+        if(end - begin > grainSize) {
+            const std::size_t middle = begin + (end - begin)/2;
+            parallelForSerial(begin, middle, grainSize, functor);
+            parallelForSerial(middle, end, grainSize, functor);
+        } else if(begin != end) functor(begin, end);
+    }
+
+    /* Spawns the upper halves as tasks and continues with the lower half.
+       Has to produce the same chunks as parallelForSerial(). */
+    template<class F> void parallelForRange(TaskGroup& group, const std::size_t begin, const std::size_t end, const std::size_t grainSize, F& functor) {
+        if(end - begin > grainSize) {
+            const std::size_t middle = begin + (end - begin)/2;
+            group.run([&group, middle, end, grainSize, &functor]() {
+                parallelForRange(group, middle, end, grainSize, functor);
+            });
+            parallelForRange(group, begin, middle, grainSize, functor);
+        } else if(begin != end) functor(begin, end);
+    }
+}
+
+template<class F> void TaskScheduler::parallelFor(const std::size_t begin, const std::size_t end, const std::size_t grainSize, F&& functor) {
+    CORRADE_ASSERT(grainSize, "Utility::TaskScheduler::parallelFor(): grain size can't be zero", );
+    CORRADE_ASSERT(begin <= end, "Utility::TaskScheduler::parallelFor(): invalid range" << begin << end, );
+
+    if(_threadCount == 1) {
+        Implementation::parallelForSerial(begin, end, grainSize, functor);
+        return;
+    }
+
+    TaskGroup group{*this};
+    Implementation::parallelForRange(group, begin, end, grainSize, functor);
+    group.wait();
+}
+
+template<class F> void TaskGroup::run(F&& functor) {
+    if(_scheduler._threadCount == 1) {
+        functor();
+        return;
+    }
+
+    _pending.fetch_add(1, std::memory_order_relaxed);
+    _scheduler.submit(new Implementation::FunctorTask<typename std::decay<F>::type>{*this, std::forward<F>(functor)});
+}
+
+}}
+
+#endif
@@ -0,0 +1,171 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <atomic>
+#include <cmath>
+
+#include "Corrade/Containers/Array.h"
+#include "Corrade/TestSuite/Tester.h"
+#include "Corrade/Utility/FormatStl.h"
+#include "Corrade/Utility/TaskScheduler.h"
+
+namespace Corrade { namespace Utility { namespace Test { namespace {
+
+struct TaskSchedulerBenchmark: TestSuite::Tester {
+    explicit TaskSchedulerBenchmark();
+
+    void spawnBaseline();
+    void spawn();
+    void spawnFromTask();
+    void parallelForOverhead();
+
+    void computeBaseline();
+    void compute();
+};
+
+/* Thread counts to measure scaling with. Counts larger than the hardware
+   thread count are oversubscribed and thus only measure the overhead. */
+constexpr std::size_t ThreadCounts[]{1, 2, 4, 8, 16, 32, 64};
+
+enum: std::size_t {
+    TaskCount = 1000,
+    DataSize = 1 << 20,
+    GrainSize = 4096
+};
+
+TaskSchedulerBenchmark::TaskSchedulerBenchmark() {
+    addBenchmarks({&TaskSchedulerBenchmark::spawnBaseline}, 10);
+
+    addInstancedBenchmarks({&TaskSchedulerBenchmark::spawn,
+                            &TaskSchedulerBenchmark::spawnFromTask,
+                            &TaskSchedulerBenchmark::parallelForOverhead}, 10,
+        Containers::arraySize(ThreadCounts));
+
+    addBenchmarks({&TaskSchedulerBenchmark::computeBaseline}, 10);
+
+    addInstancedBenchmarks({&TaskSchedulerBenchmark::compute}, 10,
+        Containers::arraySize(ThreadCounts));
+}
+
+CORRADE_NEVER_INLINE void nothing(std::atomic<std::size_t>& counter) {
+    counter.fetch_add(1, std::memory_order_relaxed);
+}
+
+void TaskSchedulerBenchmark::spawnBaseline() {
+    std::atomic<std::size_t> counter{0};
+
+    /* Calling the functions directly, for comparison */
+    CORRADE_BENCHMARK(1)
+        for(std::size_t i = 0; i != TaskCount; ++i)
+            nothing(counter);
+
+    CORRADE_COMPARE(counter.load(), std::size_t(TaskCount));
+}
+
+void TaskSchedulerBenchmark::spawn() {
+    const std::size_t threadCount = ThreadCounts[testCaseInstanceId()];
+    setTestCaseDescription(formatString("{} threads", threadCount));
+
+    TaskScheduler scheduler{threadCount};
+    std::atomic<std::size_t> counter{0};
+
+    /* Spawning from outside of the scheduler, going through the shared
+       queue */
+    CORRADE_BENCHMARK(1) {
+        TaskGroup group{scheduler};
+        for(std::size_t i = 0; i != TaskCount; ++i)
+            group.run([&counter]() { nothing(counter); });
+    }
+
+    CORRADE_COMPARE(counter.load(), std::size_t(TaskCount));
+}
+
+void TaskSchedulerBenchmark::spawnFromTask() {
+    const std::size_t threadCount = ThreadCounts[testCaseInstanceId()];
+    setTestCaseDescription(formatString("{} threads", threadCount));
+
+    TaskScheduler scheduler{threadCount};
+    std::atomic<std::size_t> counter{0};
+
+    /* Spawning from a worker, going through its deque */
+    CORRADE_BENCHMARK(1) {
+        TaskGroup group{scheduler};
+        group.run([&group, &counter]() {
+            for(std::size_t i = 0; i != TaskCount; ++i)
+                group.run([&counter]() { nothing(counter); });
+        });
+    }
+
+    CORRADE_COMPARE(counter.load(), std::size_t(TaskCount));
+}
+
+void TaskSchedulerBenchmark::parallelForOverhead() {
+    const std::size_t threadCount = ThreadCounts[testCaseInstanceId()];
+    setTestCaseDescription(formatString("{} threads", threadCount));
+
+    TaskScheduler scheduler{threadCount};
+    std::atomic<std::size_t> counter{0};
+
+    /* A chunk per index, so it's mostly just the splitting and spawning */
+    CORRADE_BENCHMARK(1)
+        scheduler.parallelFor(0, TaskCount, 1, [&counter](std::size_t, std::size_t) {
+            nothing(counter);
+        });
+
+    CORRADE_COMPARE(counter.load(), std::size_t(TaskCount));
+}
+
+void fill(Containers::ArrayView<float> data, std::size_t begin, std::size_t end) {
+    for(std::size_t i = begin; i != end; ++i)
+        data[i] = std::sqrt(std::sin(float(i))*std::sin(float(i)) + 1.0f);
+}
+
+void TaskSchedulerBenchmark::computeBaseline() {
+    Containers::Array<float> data{Containers::NoInit, DataSize};
+
+    CORRADE_BENCHMARK(1)
+        fill(data, 0, data.size());
+
+    CORRADE_COMPARE(data[0], 1.0f);
+}
+
+void TaskSchedulerBenchmark::compute() {
+    const std::size_t threadCount = ThreadCounts[testCaseInstanceId()];
+    setTestCaseDescription(formatString("{} threads", threadCount));
+
+    TaskScheduler scheduler{threadCount};
+    Containers::Array<float> data{Containers::NoInit, DataSize};
+
+    CORRADE_BENCHMARK(1)
+        scheduler.parallelFor(0, data.size(), GrainSize, [&data](std::size_t begin, std::size_t end) {
+            fill(data, begin, end);
+        });
+
+    CORRADE_COMPARE(data[0], 1.0f);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Corrade::Utility::Test::TaskSchedulerBenchmark)
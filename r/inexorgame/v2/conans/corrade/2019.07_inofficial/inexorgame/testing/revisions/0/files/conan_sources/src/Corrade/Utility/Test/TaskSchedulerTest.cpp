@@ -0,0 +1,340 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015, 2016,
+                2017, 2018, 2019 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <sstream>
+#include <vector>
+
+#include "Corrade/Containers/Array.h"
+#include "Corrade/TestSuite/Tester.h"
+#include "Corrade/TestSuite/Compare/Container.h"
+#include "Corrade/Utility/DebugStl.h"
+#include "Corrade/Utility/TaskScheduler.h"
+
+namespace Corrade { namespace Utility { namespace Test { namespace {
+
+struct TaskSchedulerTest: TestSuite::Tester {
+    explicit TaskSchedulerTest();
+
+    void hardwareThreadCount();
+    void construct();
+    void constructDefault();
+
+    void run();
+    void runSingleThreaded();
+    void runNested();
+    void runMany();
+    void waitEmpty();
+    void waitInDestructor();
+
+    void parallelFor();
+    void parallelForSingleThreaded();
+    void parallelForChunks();
+    void parallelForEmpty();
+    void parallelForNested();
+    void parallelForZeroGrainSize();
+    void parallelForInvalidRange();
+};
+
+const struct {
+    const char* name;
+    std::size_t threadCount;
+} ThreadCountData[]{
+    {"single-threaded", 1},
+    {"2 threads", 2},
+    {"4 threads", 4},
+    {"16 threads", 16}
+};
+
+TaskSchedulerTest::TaskSchedulerTest() {
+    addTests({&TaskSchedulerTest::hardwareThreadCount,
+              &TaskSchedulerTest::construct,
+              &TaskSchedulerTest::constructDefault});
+
+    addInstancedTests({&TaskSchedulerTest::run}, Containers::arraySize(ThreadCountData));
+
+    addTests({&TaskSchedulerTest::runSingleThreaded});
+
+    addInstancedTests({&TaskSchedulerTest::runNested,
+                       &TaskSchedulerTest::runMany,
+                       &TaskSchedulerTest::waitEmpty,
+                       &TaskSchedulerTest::waitInDestructor,
+                       &TaskSchedulerTest::parallelFor},
+        Containers::arraySize(ThreadCountData));
+
+    addTests({&TaskSchedulerTest::parallelForSingleThreaded,
+              &TaskSchedulerTest::parallelForChunks});
+
+    addInstancedTests({&TaskSchedulerTest::parallelForEmpty,
+                       &TaskSchedulerTest::parallelForNested},
+        Containers::arraySize(ThreadCountData));
+
+    addTests({&TaskSchedulerTest::parallelForZeroGrainSize,
+              &TaskSchedulerTest::parallelForInvalidRange});
+}
+
+void TaskSchedulerTest::hardwareThreadCount() {
+    const std::size_t count = TaskScheduler::hardwareThreadCount();
+    CORRADE_VERIFY(count >= 1);
+
+    #if !defined(CORRADE_BUILD_MULTITHREADED) || defined(CORRADE_TARGET_EMSCRIPTEN)
+    CORRADE_COMPARE(count, 1);
+    #endif
+}
+
+void TaskSchedulerTest::construct() {
+    TaskScheduler scheduler{3};
+    #if defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+    CORRADE_COMPARE(scheduler.threadCount(), 3);
+    #else
+    CORRADE_COMPARE(scheduler.threadCount(), 1);
+    #endif
+}
+
+void TaskSchedulerTest::constructDefault() {
+    TaskScheduler scheduler;
+    CORRADE_COMPARE(scheduler.threadCount(), TaskScheduler::hardwareThreadCount());
+}
+
+void TaskSchedulerTest::run() {
+    auto&& data = ThreadCountData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    TaskScheduler scheduler{data.threadCount};
+    TaskGroup group{scheduler};
+    CORRADE_VERIFY(&group.scheduler() == &scheduler);
+
+    std::atomic<int> a{0}, b{0};
+    group.run([&a]() { a += 1; });
+    group.run([&b]() { b += 2; });
+    group.wait();
+
+    CORRADE_COMPARE(a.load(), 1);
+    CORRADE_COMPARE(b.load(), 2);
+}
+
+void TaskSchedulerTest::runSingleThreaded() {
+    TaskScheduler scheduler{1};
+    TaskGroup group{scheduler};
+
+    /* The tasks are executed directly in given order */
+    std::vector<int> order;
+    group.run([&order]() { order.push_back(1); });
+    CORRADE_COMPARE(order, (std::vector<int>{1}));
+    group.run([&order]() { order.push_back(2); });
+    group.run([&order]() { order.push_back(3); });
+    group.wait();
+    CORRADE_COMPARE(order, (std::vector<int>{1, 2, 3}));
+}
+
+void TaskSchedulerTest::runNested() {
+    auto&& data = ThreadCountData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    TaskScheduler scheduler{data.threadCount};
+    std::atomic<int> count{0};
+
+    {
+        TaskGroup group{scheduler};
+        for(std::size_t i = 0; i != 16; ++i) group.run([&scheduler, &count]() {
+            /* Waiting for an inner group from inside a task */
+            TaskGroup inner{scheduler};
+            for(std::size_t j = 0; j != 16; ++j)
+                inner.run([&count]() { ++count; });
+            inner.wait();
+            ++count;
+        });
+    }
+
+    CORRADE_COMPARE(count.load(), 16*17);
+}
+
+void TaskSchedulerTest::runMany() {
+    auto&& data = ThreadCountData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    TaskScheduler scheduler{data.threadCount};
+    TaskGroup group{scheduler};
+    std::atomic<int> count{0};
+
+    /* Spawning more tasks from a single task than fits into a worker deque,
+       the rest gets executed directly */
+    group.run([&group, &count]() {
+        for(std::size_t i = 0; i != 10000; ++i)
+            group.run([&count]() { ++count; });
+    });
+    group.wait();
+
+    CORRADE_COMPARE(count.load(), 10000);
+}
+
+void TaskSchedulerTest::waitEmpty() {
+    auto&& data = ThreadCountData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    TaskScheduler scheduler{data.threadCount};
+    TaskGroup group{scheduler};
+    group.wait();
+    group.wait();
+
+    /* Just verify it doesn't hang */
+    CORRADE_VERIFY(true);
+}
+
+void TaskSchedulerTest::waitInDestructor() {
+    auto&& data = ThreadCountData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    TaskScheduler scheduler{data.threadCount};
+    std::atomic<int> count{0};
+    {
+        TaskGroup group{scheduler};
+        for(std::size_t i = 0; i != 100; ++i)
+            group.run([&count]() { ++count; });
+    }
+
+    CORRADE_COMPARE(count.load(), 100);
+}
+
+void TaskSchedulerTest::parallelFor() {
+    auto&& data = ThreadCountData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    TaskScheduler scheduler{data.threadCount};
+
+    /* Every index should be visited exactly once */
+    Containers::Array<std::atomic<int>> visited{100003};
+    for(std::atomic<int>& i: visited) i = 0;
+    scheduler.parallelFor(3, 100003, 1000, [&visited](std::size_t begin, std::size_t end) {
+        for(std::size_t i = begin; i != end; ++i) ++visited[i];
+    });
+
+    Containers::Array<int> actual{visited.size()};
+    Containers::Array<int> expected{visited.size()};
+    for(std::size_t i = 0; i != visited.size(); ++i) {
+        actual[i] = visited[i];
+        expected[i] = i < 3 ? 0 : 1;
+    }
+    CORRADE_COMPARE_AS(actual, expected, TestSuite::Compare::Container);
+}
+
+void TaskSchedulerTest::parallelForSingleThreaded() {
+    TaskScheduler scheduler{1};
+
+    /* The chunks are processed in order */
+    std::vector<std::size_t> chunks;
+    scheduler.parallelFor(0, 1000, 300, [&chunks](std::size_t begin, std::size_t end) {
+        chunks.push_back(begin);
+        chunks.push_back(end);
+    });
+    CORRADE_COMPARE(chunks, (std::vector<std::size_t>{
+        0, 250, 250, 500, 500, 750, 750, 1000}));
+}
+
+void TaskSchedulerTest::parallelForChunks() {
+    /* The chunks should be the same regardless of thread count */
+    Containers::Array<std::size_t> expected{Containers::ValueInit, 1000};
+    {
+        TaskScheduler scheduler{1};
+        scheduler.parallelFor(0, 1000, 7, [&expected](std::size_t begin, std::size_t end) {
+            expected[begin] = end;
+        });
+    }
+
+    std::size_t maxChunkSize = 0;
+    for(std::size_t i = 0; i != expected.size(); ++i)
+        if(expected[i]) maxChunkSize = std::max(maxChunkSize, expected[i] - i);
+    CORRADE_COMPARE(maxChunkSize, 7);
+
+    for(std::size_t threadCount: {2, 4, 16}) {
+        TaskScheduler scheduler{threadCount};
+        Containers::Array<std::size_t> actual{Containers::ValueInit, 1000};
+        scheduler.parallelFor(0, 1000, 7, [&actual](std::size_t begin, std::size_t end) {
+            actual[begin] = end;
+        });
+
+        CORRADE_COMPARE_AS(actual, expected, TestSuite::Compare::Container);
+    }
+}
+
+void TaskSchedulerTest::parallelForEmpty() {
+    auto&& data = ThreadCountData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    TaskScheduler scheduler{data.threadCount};
+    std::atomic<int> called{0};
+    scheduler.parallelFor(5, 5, 1, [&called](std::size_t, std::size_t) { ++called; });
+    CORRADE_COMPARE(called.load(), 0);
+
+    /* Range smaller than grain size is a single call */
+    std::size_t begin{}, end{};
+    scheduler.parallelFor(5, 15, 100, [&](std::size_t b, std::size_t e) {
+        ++called;
+        begin = b;
+        end = e;
+    });
+    CORRADE_COMPARE(called.load(), 1);
+    CORRADE_COMPARE(begin, 5);
+    CORRADE_COMPARE(end, 15);
+}
+
+void TaskSchedulerTest::parallelForNested() {
+    auto&& data = ThreadCountData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    TaskScheduler scheduler{data.threadCount};
+    std::atomic<std::size_t> sum{0};
+    scheduler.parallelFor(0, 64, 1, [&scheduler, &sum](std::size_t begin, std::size_t end) {
+        for(std::size_t i = begin; i != end; ++i)
+            scheduler.parallelFor(0, 1000, 10, [&sum](std::size_t b, std::size_t e) {
+                sum += e - b;
+            });
+    });
+
+    CORRADE_COMPARE(sum.load(), 64*1000);
+}
+
+void TaskSchedulerTest::parallelForZeroGrainSize() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    TaskScheduler scheduler{1};
+    scheduler.parallelFor(0, 10, 0, [](std::size_t, std::size_t) {});
+    CORRADE_COMPARE(out.str(), "Utility::TaskScheduler::parallelFor(): grain size can't be zero\n");
+}
+
+void TaskSchedulerTest::parallelForInvalidRange() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    TaskScheduler scheduler{1};
+    scheduler.parallelFor(10, 5, 1, [](std::size_t, std::size_t) {});
+    CORRADE_COMPARE(out.str(), "Utility::TaskScheduler::parallelFor(): invalid range 10 5\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Corrade::Utility::Test::TaskSchedulerTest)
@@ -88,6 +88,7 @@
 #  TgaImageConverter            - TGA image converter plugin
 #  TgaImporter                  - TGA importer plugin
 #  WavAudioImporter             - WAV audio importer plugin
+#  animationcompressor          - magnum-animationcompressor executable
 #  distancefieldconverter       - magnum-distancefieldconverter executable
 #  fontconverter                - magnum-fontconverter executable
 #  imageconverter               - magnum-imageconverter executable
@@ -358,7 +359,8 @@ set(_MAGNUM_PLUGIN_COMPONENT_LIST
     MagnumFont MagnumFontConverter ObjImporter TgaImageConverter TgaImporter
     WavAudioImporter)
 set(_MAGNUM_EXECUTABLE_COMPONENT_LIST
-    distancefieldconverter fontconverter imageconverter gl-info al-info)
+    animationcompressor distancefieldconverter fontconverter imageconverter
+    gl-info al-info)
 
 # Inter-component dependencies
 set(_MAGNUM_Audio_DEPENDENCIES )
@@ -877,7 +879,14 @@ foreach(_component ${Magnum_FIND_COMPONENTS})
         # No special setup for AnySceneImporter plugin
         # No special setup for MagnumFont plugin
         # No special setup for MagnumFontConverter plugin
-        # No special setup for ObjImporter plugin
+
+        # ObjImporter plugin, threads are used for parsing large meshes
+        if(_component STREQUAL ObjImporter AND NOT CORRADE_TARGET_EMSCRIPTEN)
+            find_package(Threads REQUIRED)
+            set_property(TARGET Magnum::${_component} APPEND PROPERTY
+                INTERFACE_LINK_LIBRARIES Threads::Threads)
+        endif()
+
         # No special setup for TgaImageConverter plugin
         # No special setup for TgaImporter plugin
         # No special setup for WavAudioImporter plugin
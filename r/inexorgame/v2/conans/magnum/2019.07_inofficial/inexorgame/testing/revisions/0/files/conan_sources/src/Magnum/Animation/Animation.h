@@ -45,10 +45,12 @@ enum class Interpolation: UnsignedByte;
 enum class Extrapolation: UnsignedByte;
 
 template<class T, class K = T> class Player;
+class QuantizedQuaternion;
 
 template<class K, class V, class R = ResultOf<V>> class Track;
 template<class K> class TrackViewStorage;
 template<class K, class V, class R = ResultOf<V>> class TrackView;
+template<class K, class V, class R, R(*)(const V&, const V&, Float)> class TrackBatch;
 #endif
 
 }}
@@ -26,9 +26,10 @@
 */
 
 /** @file
- * @brief Alias @ref Magnum::Animation::ResultOf, enum @ref Magnum::Animation::Interpolation. @ref Magnum::Animation::Extrapolation, function @ref Magnum::Animation::interpolatorFor(), @ref Magnum::Animation::interpolate(), @ref Magnum::Animation::interpolateStrict(), @ref Magnum::Animation::ease(), @ref Magnum::Animation::easeClamped() @ref Magnum::Animation::unpack(), @ref Magnum::Animation::unpackEase(), @ref Magnum::Animation::unpackEaseClamped()
+ * @brief Alias @ref Magnum::Animation::ResultOf, enum @ref Magnum::Animation::Interpolation. @ref Magnum::Animation::Extrapolation, function @ref Magnum::Animation::interpolatorFor(), @ref Magnum::Animation::findKeyframe(), @ref Magnum::Animation::keyframeLookupTable(), @ref Magnum::Animation::interpolate(), @ref Magnum::Animation::interpolateStrict(), @ref Magnum::Animation::ease(), @ref Magnum::Animation::easeClamped() @ref Magnum::Animation::unpack(), @ref Magnum::Animation::unpackEase(), @ref Magnum::Animation::unpackEaseClamped()
  */
 
+#include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/StridedArrayView.h>
 
 #include "Magnum/Magnum.h"
@@ -162,6 +163,52 @@ enum class Extrapolation: UnsignedByte {
 /** @debugoperatorenum{Extrapolation} */
 MAGNUM_EXPORT Debug& operator<<(Debug& debug, Extrapolation value);
 
+/**
+@brief Find a keyframe matching given frame
+@tparam K           Key type
+@param keys         Keys
+@param frame        Frame to search for
+@param hint         Hint for keyframe search
+@param lookupTable  Optional lookup table created by @ref keyframeLookupTable()
+
+Finds the last keyframe which is not larger than @p frame and saves its index
+to @p hint. The result is clamped to the range @f$ [0 ; n - 2] @f$, so both
+@cpp keys[hint] @ce and @cpp keys[hint + 1] @ce are always valid. Expects that
+there are at least two keyframes.
+
+The search first checks the keyframe at @p hint and the one immediately
+following, so sequential playback with a @p hint preserved across calls is
+@f$ \mathcal{O}(1) @f$. If @p frame is outside of that range, a branchless
+binary search is done, making random seeks and reverse playback
+@f$ \mathcal{O}(\log n) @f$ instead of rewinding and searching linearly from
+the beginning. If @p lookupTable is not empty, the binary search is further
+narrowed down to keyframes inside the table bucket that contains @p frame,
+which pays off for long tracks with evenly distributed keyframes.
+
+Used internally from @ref interpolate() and @ref interpolateStrict().
+@experimental
+*/
+template<class K> void findKeyframe(const Containers::StridedArrayView1D<const K>& keys, K frame, std::size_t& hint, Containers::ArrayView<const UnsignedInt> lookupTable = nullptr);
+
+/**
+@brief Create a keyframe lookup table
+@tparam K           Key type
+@param keys         Keys
+@param bucketCount  Count of buckets in the table
+
+Splits the time range between first and last keyframe into @p bucketCount
+uniform buckets and for each records index of the last keyframe not larger
+than the bucket start. Pass the result to @ref findKeyframe(),
+@ref interpolate() or @ref interpolateStrict() to limit the binary search to
+just the keyframes inside given bucket. A good bucket count is roughly the key
+count divided by a small constant, the table then takes four bytes per bucket.
+If there's less than two keys or the keys span an empty time range, an empty
+table is returned.
+@see @ref Track::setLookupTable(), @ref TrackView::setLookupTable()
+@experimental
+*/
+template<class K> Containers::Array<UnsignedInt> keyframeLookupTable(const Containers::StridedArrayView1D<const K>& keys, std::size_t bucketCount);
+
 /**
 @brief Interpolate animation value
 @tparam K           Key type
@@ -174,10 +221,12 @@ MAGNUM_EXPORT Debug& operator<<(Debug& debug, Extrapolation value);
 @param interpolator Interpolator function
 @param frame        Frame at which to interpolate
 @param hint         Hint for keyframe search
+@param lookupTable  Optional lookup table created by @ref keyframeLookupTable()
 
-Does a linear search over the keyframes until it finds last keyframe which is
-not larger than @p frame. Once the keyframe is found, reference to it and the immediately following keyframe is passed to @p interpolator along with
-calculated interpolation factor, returning the interpolated value.
+Uses @ref findKeyframe() to find last keyframe which is not larger than
+@p frame. Once the keyframe is found, reference to it and the immediately
+following keyframe is passed to @p interpolator along with calculated
+interpolation factor, returning the interpolated value.
 
 -   In case the first keyframe is already larger than @p frame or @p frame is
     larger or equal to the last keyframe, either the first two or last two
@@ -187,9 +236,10 @@ calculated interpolation factor, returning the interpolated value.
     the interpolator.
 -   In case no keyframes are present, default-constructed value is returned.
 
-The @p hint parameter hints where to start the linear search and is updated
-with keyframe index matching @p frame. If @p frame is earlier than @p hint, the
-search is restarted from the beginning.
+The @p hint parameter hints where to start the search and is updated with
+keyframe index matching @p frame. If @p frame is not in the keyframe pair at
+@p hint or the pair immediately following, a binary search is done, optionally
+accelerated with @p lookupTable.
 
 Used internally from @ref Track::at() / @ref TrackView::at(), see @ref Track
 documentation for more information.
@@ -198,17 +248,18 @@ documentation for more information.
     @ref Math::slerp(), @ref Math::sclerp()
 @experimental
 */
-template<class K, class V, class R = ResultOf<V>> R interpolate(const Containers::StridedArrayView1D<const K>& keys, const Containers::StridedArrayView1D<const V>& values, Extrapolation before, Extrapolation after, R(*interpolator)(const V&, const V&, Float), K frame, std::size_t& hint);
+template<class K, class V, class R = ResultOf<V>> R interpolate(const Containers::StridedArrayView1D<const K>& keys, const Containers::StridedArrayView1D<const V>& values, Extrapolation before, Extrapolation after, R(*interpolator)(const V&, const V&, Float), K frame, std::size_t& hint, Containers::ArrayView<const UnsignedInt> lookupTable = nullptr);
 
 /**
 @brief Interpolate animation value with strict constraints
 
-Does a linear search over the keyframes until it finds last keyframe which is
-not larger than @p frame. Once the keyframe is found, reference to it and the immediately following keyframe is passed to @p interpolator along with
-calculated interpolation factor, returning the interpolated value. The @p hint
-parameter hints where to start the linear search and is updated with keyframe
-index matching @p frame. If @p frame is earlier than @p hint, the search is
-restarted from the beginning.
+Uses @ref findKeyframe() to find last keyframe which is not larger than
+@p frame. Once the keyframe is found, reference to it and the immediately
+following keyframe is passed to @p interpolator along with calculated
+interpolation factor, returning the interpolated value. The @p hint parameter
+hints where to start the search and is updated with keyframe index matching
+@p frame, @p lookupTable optionally accelerates the search if the hint is far
+off.
 
 This is a stricter but more performant version of @ref interpolate() with
 implicit @ref Extrapolation::Extrapolated behavior. Expects that there are
@@ -221,7 +272,7 @@ Used internally from @ref Track::atStrict() / @ref TrackView::atStrict(), see
     @ref Math::sclerp()
 @experimental
 */
-template<class K, class V, class R = ResultOf<V>> R interpolateStrict(const Containers::StridedArrayView1D<const K>& keys, const Containers::StridedArrayView1D<const V>& values, R(*interpolator)(const V&, const V&, Float), K frame, std::size_t& hint);
+template<class K, class V, class R = ResultOf<V>> R interpolateStrict(const Containers::StridedArrayView1D<const K>& keys, const Containers::StridedArrayView1D<const V>& values, R(*interpolator)(const V&, const V&, Float), K frame, std::size_t& hint, Containers::ArrayView<const UnsignedInt> lookupTable = nullptr);
 
 /**
 @brief Combine easing function and an interpolator
@@ -368,7 +419,79 @@ template<class V, class R> auto interpolatorFor(Interpolation interpolation) ->
     return Implementation::TypeTraits<V, R>::interpolator(interpolation);
 }
 
-template<class K, class V, class R> R interpolate(const Containers::StridedArrayView1D<const K>& keys, const Containers::StridedArrayView1D<const V>& values, const Extrapolation before, const Extrapolation after, R(*const interpolator)(const V&, const V&, Float), K frame, std::size_t& hint) {
+namespace Implementation {
+
+/* Returns the largest index in [first, last] for which the key is not larger
+   than frame, or first if there's none. The loop body compiles to a
+   conditional move, so there are no hard-to-predict branches. */
+template<class K> std::size_t searchKeyframe(const Containers::StridedArrayView1D<const K>& keys, const K frame, std::size_t first, const std::size_t last) {
+    std::size_t count = last - first + 1;
+    while(count > 1) {
+        const std::size_t half = count/2;
+        first = keys[first + half] <= frame ? first + half : first;
+        count -= half;
+    }
+    return first;
+}
+
+}
+
+template<class K> void findKeyframe(const Containers::StridedArrayView1D<const K>& keys, const K frame, std::size_t& hint, const Containers::ArrayView<const UnsignedInt> lookupTable) {
+    CORRADE_ASSERT(keys.size() >= 2, "Animation::findKeyframe(): at least two keyframes required", );
+
+    const std::size_t last = keys.size() - 2;
+
+    /* Sequential playback -- the frame is either in the keyframe pair at the
+       hint or in the next one */
+    std::size_t first = 0;
+    if(hint <= last && keys[hint] <= frame) {
+        if(hint == last || frame < keys[hint + 1]) return;
+        if(hint + 1 == last || frame < keys[hint + 2]) {
+            ++hint;
+            return;
+        }
+        first = hint + 2;
+    }
+
+    /* Narrow the range down using the lookup table. Because the bucket is
+       calculated with floats, it might be off by one for frames close to
+       bucket boundaries, in which case the bound is not used. */
+    std::size_t end = last;
+    if(!lookupTable.empty() && first == 0) {
+        const Float bucket = (Float(frame) - Float(keys[0]))*lookupTable.size()/
+            (Float(keys[last + 1]) - Float(keys[0]));
+        if(bucket >= 0.0f) {
+            const std::size_t i = std::size_t(Math::min(bucket, Float(lookupTable.size() - 1)));
+            const std::size_t tableFirst = lookupTable[i];
+            const std::size_t tableEnd = i + 1 < lookupTable.size() ? lookupTable[i + 1] : last;
+            if(keys[tableFirst] <= frame) first = tableFirst;
+            if(tableEnd < last && frame < keys[tableEnd + 1]) end = tableEnd;
+        }
+    }
+
+    hint = Implementation::searchKeyframe(keys, frame, first, end);
+}
+
+template<class K> Containers::Array<UnsignedInt> keyframeLookupTable(const Containers::StridedArrayView1D<const K>& keys, const std::size_t bucketCount) {
+    if(keys.size() < 2 || !bucketCount) return nullptr;
+
+    const Float begin = Float(keys[0]);
+    const Float duration = Float(keys[keys.size() - 1]) - begin;
+    if(!(duration > 0.0f)) return nullptr;
+
+    /* Keys are sorted, so the whole table can be filled in a single pass */
+    Containers::Array<UnsignedInt> table{Containers::NoInit, bucketCount};
+    std::size_t key = 0;
+    for(std::size_t i = 0; i != bucketCount; ++i) {
+        const Float time = begin + duration*i/bucketCount;
+        while(key + 2 < keys.size() && Float(keys[key + 1]) <= time) ++key;
+        table[i] = key;
+    }
+
+    return table;
+}
+
+template<class K, class V, class R> R interpolate(const Containers::StridedArrayView1D<const K>& keys, const Containers::StridedArrayView1D<const V>& values, const Extrapolation before, const Extrapolation after, R(*const interpolator)(const V&, const V&, Float), K frame, std::size_t& hint, const Containers::ArrayView<const UnsignedInt> lookupTable) {
     CORRADE_ASSERT(keys.size() == values.size(), "Animation::interpolate(): keys and values don't have the same size", {});
 
     /* No data, return default-constructed value */
@@ -383,12 +506,8 @@ template<class K, class V, class R> R interpolate(const Containers::StridedArray
         return interpolator(values[0], values[0], 0.0f);
     }
 
-    /* Rewind from the beginning if hint is too late */
-    if(hint >= keys.size() || frame < keys[hint]) hint = 0;
-
-    /* Go through the keys until we find a pair that is around given time */
-    while(hint + 2 < keys.size() && frame >= keys[hint + 1])
-        ++hint;
+    /* Find a pair of keys that is around given time */
+    findKeyframe(keys, frame, hint, lookupTable);
 
     /* Special extrapolation outside of range. Usual extrapolation is handled
        below. */
@@ -404,16 +523,12 @@ template<class K, class V, class R> R interpolate(const Containers::StridedArray
         Math::lerpInverted(Float(keys[hint]), Float(keys[hint + 1]), Float(frame)));
 }
 
-template<class K, class V, class R> R interpolateStrict(const Containers::StridedArrayView1D<const K>& keys, const Containers::StridedArrayView1D<const V>& values, R(*const interpolator)(const V&, const V&, Float), const K frame, std::size_t& hint) {
+template<class K, class V, class R> R interpolateStrict(const Containers::StridedArrayView1D<const K>& keys, const Containers::StridedArrayView1D<const V>& values, R(*const interpolator)(const V&, const V&, Float), const K frame, std::size_t& hint, const Containers::ArrayView<const UnsignedInt> lookupTable) {
     CORRADE_ASSERT(keys.size() >= 2, "Animation::interpolateStrict(): at least two keyframes required", {});
     CORRADE_ASSERT(keys.size() == values.size(), "Animation::interpolateStrict(): keys and values don't have the same size", {});
 
-    /* Rewind from the beginning if hint is too late */
-    if(hint >= keys.size() || frame < keys[hint]) hint = 0;
-
-    /* Go through the keys until we find a pair that is around given time */
-    while(hint + 2 < keys.size() && frame >= keys[hint + 1])
-        ++hint;
+    /* Find a pair of keys that is around given time */
+    findKeyframe(keys, frame, hint, lookupTable);
 
     return interpolator(values[hint], values[hint + 1],
         Math::lerpInverted(Float(keys[hint]), Float(keys[hint + 1]), Float(frame)));
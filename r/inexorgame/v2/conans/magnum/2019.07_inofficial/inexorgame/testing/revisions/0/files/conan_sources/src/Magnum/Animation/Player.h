@@ -766,10 +766,24 @@ template<class T, class K
          * corresponding to the new pause time in order to correctly "park" the
          * animation. After that, no more updates are done until the animation
          * is started again or @ref seekBy() / @ref seekTo() is called.
-         * @see @ref elapsed()
+         * @see @ref elapsed(), @ref advanceKey()
          */
         Player<T, K>& advance(T time);
 
+        /**
+         * @brief Advance the player state without updating tracks
+         * @return Key at which the tracks should be updated or
+         *      @ref Containers::NullOpt if there's nothing to update
+         *
+         * Updates the player state the same way as @ref advance(T), but
+         * instead of updating tracks added to this player returns the
+         * absolute key at which they would be evaluated. Useful for driving
+         * a @ref TrackBatch, where the player is used only to control the
+         * playback. Since there are no tracks to calculate the duration from
+         * in that case, it's expected to be specified via @ref setDuration().
+         */
+        Containers::Optional<K> advanceKey(T time);
+
     private:
         struct Track;
 
@@ -295,18 +295,28 @@ template<class T, class K> std::pair<UnsignedInt, K> Player<T, K>::elapsed(const
 }
 
 template<class T, class K> Player<T, K>& Player<T, K>::advance(const T time) {
-    /* Get the elapsed time. If we shouldn't advance anything (player already
-       stopped / not yet playing, quit */
-    Containers::Optional<std::pair<UnsignedInt, K>> elapsed = Implementation::playerElapsed(_duration.size(), _playCount, _scaler, time, _startTime, _stopPauseTime, _state);
-    if(!elapsed) return *this;
+    /* If we shouldn't advance anything (player already stopped / not yet
+       playing), quit */
+    const Containers::Optional<K> key = advanceKey(time);
+    if(!key) return *this;
 
-    /* Advance all tracks. Properly handle durations that don't start at 0. */
+    /* Advance all tracks */
     for(Track& t: _tracks)
-        t.advancer(t.track, _duration.min() + elapsed->second, t.hint, t.destination, t.userCallback, t.userCallbackData);
+        t.advancer(t.track, *key, t.hint, t.destination, t.userCallback, t.userCallbackData);
 
     return *this;
 }
 
+template<class T, class K> Containers::Optional<K> Player<T, K>::advanceKey(const T time) {
+    /* Get the elapsed time. If we shouldn't advance anything (player already
+       stopped / not yet playing, quit */
+    Containers::Optional<std::pair<UnsignedInt, K>> elapsed = Implementation::playerElapsed(_duration.size(), _playCount, _scaler, time, _startTime, _stopPauseTime, _state);
+    if(!elapsed) return {};
+
+    /* Properly handle durations that don't start at 0 */
+    return _duration.min() + elapsed->second;
+}
+
 }}
 
 #endif
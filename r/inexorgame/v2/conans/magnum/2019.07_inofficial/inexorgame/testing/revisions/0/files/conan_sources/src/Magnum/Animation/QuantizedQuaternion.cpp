@@ -0,0 +1,116 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "QuantizedQuaternion.h"
+
+#include "Magnum/Animation/Interpolation.h"
+#include "Magnum/Math/Quaternion.h"
+
+namespace Magnum { namespace Animation {
+
+namespace {
+    /* The three smallest components are in [-1/sqrt(2), 1/sqrt(2)], mapped
+       symmetrically to [0, 32766] so zero is represented exactly */
+    constexpr Float Scale = 1.414213562373095f*16383.0f;
+}
+
+QuantizedQuaternion::QuantizedQuaternion(const Quaternion& quaternion) noexcept {
+    const Float data[]{quaternion.vector().x(), quaternion.vector().y(), quaternion.vector().z(), quaternion.scalar()};
+
+    UnsignedInt largest = 0;
+    for(UnsignedInt i = 1; i != 4; ++i)
+        if(Math::abs(data[i]) > Math::abs(data[largest])) largest = i;
+
+    /* q and -q is the same rotation, flip so the omitted component is
+       positive */
+    const Float sign = data[largest] < 0.0f ? -1.0f : 1.0f;
+
+    UnsignedLong bits = UnsignedLong(largest) << 45;
+    for(UnsignedInt i = 0, shift = 30; i != 4; ++i) {
+        if(i == largest) continue;
+        const Int value = Int(Math::round(Math::clamp(sign*data[i]*Scale, -16383.0f, 16383.0f))) + 16383;
+        bits |= UnsignedLong(value) << shift;
+        shift -= 15;
+    }
+
+    _data[0] = UnsignedShort(bits);
+    _data[1] = UnsignedShort(bits >> 16);
+    _data[2] = UnsignedShort(bits >> 32);
+}
+
+Quaternion QuantizedQuaternion::quaternion() const {
+    const UnsignedLong bits = UnsignedLong(_data[0])|
+        (UnsignedLong(_data[1]) << 16)|
+        (UnsignedLong(_data[2]) << 32);
+    const UnsignedInt largest = bits >> 45;
+
+    Float data[4];
+    Float lengthSquared = 0.0f;
+    for(UnsignedInt i = 0, shift = 30; i != 4; ++i) {
+        if(i == largest) continue;
+        data[i] = (Int((bits >> shift) & 0x7fff) - 16383)/Scale;
+        lengthSquared += data[i]*data[i];
+        shift -= 15;
+    }
+    data[largest] = Math::sqrt(Math::max(1.0f - lengthSquared, 0.0f));
+
+    return {{data[0], data[1], data[2]}, data[3]};
+}
+
+Quaternion select(const QuantizedQuaternion& a, const QuantizedQuaternion& b, const Float t) {
+    return (t < 1.0f ? a : b).quaternion();
+}
+
+Quaternion slerpShortestPath(const QuantizedQuaternion& a, const QuantizedQuaternion& b, const Float t) {
+    const Quaternion unpackedA = a.quaternion();
+    const Quaternion unpackedB = b.quaternion();
+
+    /* Math::slerpShortestPath() returns the first quaternion if the two are
+       too close, which would make densely sampled tracks snap to keyframes.
+       Normalized lerp is precise enough in that case. */
+    if(Math::abs(Math::dot(unpackedA, unpackedB)) >= 1.0f - Math::TypeTraits<Float>::epsilon())
+        return Math::lerpShortestPath(unpackedA, unpackedB, t);
+
+    return Math::slerpShortestPath(unpackedA, unpackedB, t);
+}
+
+namespace Implementation {
+
+auto TypeTraits<QuantizedQuaternion, Quaternion>::interpolator(Interpolation interpolation) -> Interpolator {
+    switch(interpolation) {
+        case Interpolation::Constant: return select;
+        case Interpolation::Linear: return slerpShortestPath;
+
+        case Interpolation::Spline:
+        case Interpolation::Custom: ; /* nope */
+    }
+
+    CORRADE_ASSERT(false, "Animation::interpolatorFor(): can't deduce interpolator function for" << interpolation, {});
+}
+
+}
+
+}}
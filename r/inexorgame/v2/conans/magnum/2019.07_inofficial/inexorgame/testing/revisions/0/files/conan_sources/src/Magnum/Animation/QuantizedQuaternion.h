@@ -0,0 +1,146 @@
+#ifndef Magnum_Animation_QuantizedQuaternion_h
+#define Magnum_Animation_QuantizedQuaternion_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Animation::QuantizedQuaternion, function @ref Magnum::Animation::select(const QuantizedQuaternion&, const QuantizedQuaternion&, Float), @ref Magnum::Animation::slerpShortestPath(const QuantizedQuaternion&, const QuantizedQuaternion&, Float)
+ */
+
+#include "Magnum/Magnum.h"
+#include "Magnum/visibility.h"
+#include "Magnum/Animation/Animation.h"
+
+namespace Magnum { namespace Animation {
+
+/**
+@brief Quantized quaternion
+
+Stores an unit quaternion in 48 bits using the *smallest three* encoding ---
+index of the component with the largest absolute value is stored in two bits
+and the remaining three components, which are always in range
+@f$ [-\frac{1}{\sqrt{2}}, \frac{1}{\sqrt{2}}] @f$, are stored as 15-bit
+fixed-point values. The largest component is reconstructed from the unit
+length constraint, with its sign chosen to be positive (@f$ q @f$ and
+@f$ -q @f$ represent the same rotation). Maximal error of the stored
+components is about @cpp 2.2e-5f @ce and about @cpp 6.0e-5f @ce for the
+reconstructed one, which is less than a hundredth of a degree for the
+represented rotation, at 6 bytes instead of 16.
+
+The type can be used directly as a value type of @ref Track and @ref TrackView
+with @ref Quaternion as the result type, with the values unpacked on the fly
+during interpolation:
+
+@code{.cpp}
+Containers::ArrayView<const Float> keys = …;
+Containers::ArrayView<const Animation::QuantizedQuaternion> values = …;
+Animation::TrackView<Float, Animation::QuantizedQuaternion> track{keys, values,
+    Animation::Interpolation::Linear};
+
+Quaternion rotation = track.at(time);
+@endcode
+
+@ref Interpolation::Constant maps to
+@ref select(const QuantizedQuaternion&, const QuantizedQuaternion&, Float) and
+@ref Interpolation::Linear to
+@ref slerpShortestPath(const QuantizedQuaternion&, const QuantizedQuaternion&, Float).
+@see @ref Trade::compressAnimation()
+@experimental
+*/
+class MAGNUM_EXPORT QuantizedQuaternion {
+    public:
+        /**
+         * @brief Default constructor
+         *
+         * Creates an identity rotation.
+         */
+        constexpr /*implicit*/ QuantizedQuaternion() noexcept: _data{0xbfff, 0xdfff, 0x6fff} {}
+
+        /**
+         * @brief Construct from a quaternion
+         *
+         * Expects that the quaternion is normalized.
+         */
+        explicit QuantizedQuaternion(const Quaternion& quaternion) noexcept;
+
+        /** @brief Equality comparison */
+        bool operator==(const QuantizedQuaternion& other) const {
+            return _data[0] == other._data[0] && _data[1] == other._data[1] && _data[2] == other._data[2];
+        }
+
+        /** @brief Non-equality comparison */
+        bool operator!=(const QuantizedQuaternion& other) const {
+            return !operator==(other);
+        }
+
+        /** @brief Unpacked quaternion */
+        Quaternion quaternion() const;
+
+        /** @brief Raw data */
+        const UnsignedShort* data() const { return _data; }
+
+    private:
+        UnsignedShort _data[3];
+};
+
+/**
+@brief Constant interpolation of quantized quaternions
+
+Equivalent to @ref Math::select(const T&, const T&, U) done on unpacked
+quaternions.
+@experimental
+*/
+MAGNUM_EXPORT Quaternion select(const QuantizedQuaternion& a, const QuantizedQuaternion& b, Float t);
+
+/**
+@brief Spherical linear shortest-path interpolation of quantized quaternions
+
+Equivalent to @ref Math::slerpShortestPath(const Quaternion<T>&, const Quaternion<T>&, T)
+done on unpacked quaternions, except that if the quaternions are too close for
+the spherical interpolation, @ref Math::lerpShortestPath(const Quaternion<T>&, const Quaternion<T>&, T)
+is used instead of returning the first quaternion. That makes a difference for
+densely sampled tracks, which would otherwise snap to keyframes.
+@experimental
+*/
+MAGNUM_EXPORT Quaternion slerpShortestPath(const QuantizedQuaternion& a, const QuantizedQuaternion& b, Float t);
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+namespace Implementation {
+
+template<> struct ResultTraits<QuantizedQuaternion> {
+    typedef Quaternion Type;
+};
+template<> struct MAGNUM_EXPORT TypeTraits<QuantizedQuaternion, Quaternion> {
+    typedef Quaternion(*Interpolator)(const QuantizedQuaternion&, const QuantizedQuaternion&, Float);
+
+    static Interpolator interpolator(Interpolation interpolation);
+};
+
+}
+#endif
+
+}}
+
+#endif
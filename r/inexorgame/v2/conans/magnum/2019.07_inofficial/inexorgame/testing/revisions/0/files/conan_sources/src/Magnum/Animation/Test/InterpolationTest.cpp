@@ -0,0 +1,270 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <vector>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/ArrayViewStl.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Animation/Interpolation.h"
+
+namespace Magnum { namespace Animation { namespace Test { namespace {
+
+struct InterpolationTest: TestSuite::Tester {
+    explicit InterpolationTest();
+
+    void findKeyframe();
+    void findKeyframeTwoKeys();
+    void findKeyframeIntegerKeys();
+    void findKeyframeNotEnoughKeys();
+
+    void lookupTable();
+    void lookupTableEmpty();
+
+    private:
+        void verifyFindKeyframe(const std::vector<Float>& keys, const std::vector<Float>& frames, Containers::ArrayView<const UnsignedInt> lookupTable);
+};
+
+/* Non-uniform spacing and runs of duplicate keys, which the binary search has
+   to resolve to the same keyframe as the linear search did */
+std::vector<Float> uniformKeys() {
+    std::vector<Float> keys;
+    for(std::size_t i = 0; i != 100; ++i) keys.push_back(0.5f*i - 3.0f);
+    return keys;
+}
+
+std::vector<Float> nonUniformKeys() {
+    std::vector<Float> keys;
+    for(std::size_t i = 0; i != 100; ++i) keys.push_back(0.01f*i*i);
+    return keys;
+}
+
+std::vector<Float> duplicateKeys() {
+    return {0.0f, 0.0f, 1.0f, 2.0f, 2.0f, 2.0f, 3.0f, 3.5f, 3.5f, 4.0f,
+            7.0f, 7.0f, 7.0f, 7.0f, 8.0f, 9.0f, 9.0f};
+}
+
+const struct {
+    const char* name;
+    std::vector<Float>(*keys)();
+} KeyData[]{
+    {"uniform", uniformKeys},
+    {"non-uniform", nonUniformKeys},
+    {"duplicate keys", duplicateKeys}
+};
+
+/* Zero buckets means no table */
+const std::size_t BucketCounts[]{0, 1, 3, 16, 100, 1000};
+
+InterpolationTest::InterpolationTest() {
+    addInstancedTests({&InterpolationTest::findKeyframe},
+        Containers::arraySize(KeyData));
+
+    addTests({&InterpolationTest::findKeyframeTwoKeys,
+              &InterpolationTest::findKeyframeIntegerKeys,
+              &InterpolationTest::findKeyframeNotEnoughKeys});
+
+    addInstancedTests({&InterpolationTest::lookupTable},
+        Containers::arraySize(KeyData));
+
+    addTests({&InterpolationTest::lookupTableEmpty});
+}
+
+/* The linear search that findKeyframe() replaced, used as a reference */
+template<class K> std::size_t findKeyframeLinear(const std::vector<K>& keys, const K frame, std::size_t hint) {
+    if(hint >= keys.size() || frame < keys[hint]) hint = 0;
+    while(hint + 2 < keys.size() && frame >= keys[hint + 1])
+        ++hint;
+    return hint;
+}
+
+/* Frames exactly at, right around and in between all keys, outside of the
+   key range and at bucket boundaries of all tested lookup tables */
+std::vector<Float> framesFor(const std::vector<Float>& keys) {
+    std::vector<Float> frames;
+    for(std::size_t i = 0; i != keys.size(); ++i) {
+        frames.push_back(keys[i]);
+        frames.push_back(std::nextafter(keys[i], -1.0e10f));
+        frames.push_back(std::nextafter(keys[i], 1.0e10f));
+        if(i + 1 != keys.size()) frames.push_back((keys[i] + keys[i + 1])*0.5f);
+    }
+
+    frames.push_back(keys.front() - 1.0f);
+    frames.push_back(keys.front() - 1000.0f);
+    frames.push_back(keys.back() + 1.0f);
+    frames.push_back(keys.back() + 1000.0f);
+
+    const Float begin = keys.front();
+    const Float duration = keys.back() - keys.front();
+    for(const std::size_t bucketCount: BucketCounts) {
+        if(!bucketCount) continue;
+        for(std::size_t i = 0; i <= bucketCount; ++i) {
+            const Float edge = begin + duration*i/bucketCount;
+            frames.push_back(edge);
+            frames.push_back(std::nextafter(edge, -1.0e10f));
+            frames.push_back(std::nextafter(edge, 1.0e10f));
+        }
+    }
+
+    return frames;
+}
+
+void InterpolationTest::verifyFindKeyframe(const std::vector<Float>& keys, const std::vector<Float>& frames, const Containers::ArrayView<const UnsignedInt> lookupTable) {
+    const Containers::StridedArrayView1D<const Float> keyView = Containers::arrayView(keys);
+
+    /* Each frame searched without a hint, with a stale out-of-range hint,
+       and with the hint of the previous frame in forward, reverse and
+       pseudo-random order */
+    std::size_t forwardHint = 0, reverseHint = 0, randomHint = 0;
+    std::size_t random = 0;
+    for(std::size_t i = 0; i != frames.size(); ++i) {
+        const Float frame = frames[i];
+        const std::size_t expected = findKeyframeLinear(keys, frame, 0);
+
+        std::size_t hint = 0;
+        Animation::findKeyframe(keyView, frame, hint, lookupTable);
+        CORRADE_COMPARE(hint, expected);
+
+        hint = keys.size() + 5;
+        Animation::findKeyframe(keyView, frame, hint, lookupTable);
+        CORRADE_COMPARE(hint, expected);
+
+        Animation::findKeyframe(keyView, frame, forwardHint, lookupTable);
+        CORRADE_COMPARE(forwardHint, expected);
+
+        const Float reverseFrame = frames[frames.size() - i - 1];
+        Animation::findKeyframe(keyView, reverseFrame, reverseHint, lookupTable);
+        CORRADE_COMPARE(reverseHint, findKeyframeLinear(keys, reverseFrame, 0));
+
+        random = (random*1103515245 + 12345) % 2147483648u;
+        const Float randomFrame = frames[random % frames.size()];
+        Animation::findKeyframe(keyView, randomFrame, randomHint, lookupTable);
+        CORRADE_COMPARE(randomHint, findKeyframeLinear(keys, randomFrame, 0));
+    }
+}
+
+void InterpolationTest::findKeyframe() {
+    auto&& data = KeyData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    const std::vector<Float> keys = data.keys();
+    const std::vector<Float> frames = framesFor(keys);
+
+    /* Sorted frames to test sequential playback */
+    std::vector<Float> sortedFrames = frames;
+    std::sort(sortedFrames.begin(), sortedFrames.end());
+
+    for(const std::size_t bucketCount: BucketCounts) {
+        const Containers::Array<UnsignedInt> lookupTable = keyframeLookupTable(Containers::StridedArrayView1D<const Float>{Containers::arrayView(keys)}, bucketCount);
+        CORRADE_COMPARE(lookupTable.size(), bucketCount);
+
+        verifyFindKeyframe(keys, frames, lookupTable);
+        verifyFindKeyframe(keys, sortedFrames, lookupTable);
+    }
+}
+
+void InterpolationTest::findKeyframeTwoKeys() {
+    const Float keys[]{1.0f, 3.0f};
+    for(const Float frame: {-1.0f, 1.0f, 2.0f, 3.0f, 5.0f}) {
+        std::size_t hint = 0;
+        Animation::findKeyframe(Containers::StridedArrayView1D<const Float>{keys}, frame, hint);
+        CORRADE_COMPARE(hint, 0);
+
+        hint = 1;
+        Animation::findKeyframe(Containers::StridedArrayView1D<const Float>{keys}, frame, hint);
+        CORRADE_COMPARE(hint, 0);
+    }
+}
+
+void InterpolationTest::findKeyframeIntegerKeys() {
+    const std::vector<Int> keys{-5, -5, 0, 3, 3, 3, 10, 11, 20};
+    const Containers::StridedArrayView1D<const Int> keyView = Containers::arrayView(keys);
+    const Containers::Array<UnsignedInt> lookupTable = keyframeLookupTable(keyView, 5);
+
+    std::size_t forwardHint = 0, tableHint = 0;
+    for(Int frame = -10; frame != 30; ++frame) {
+        const std::size_t expected = findKeyframeLinear(keys, frame, 0);
+
+        Animation::findKeyframe(keyView, frame, forwardHint);
+        CORRADE_COMPARE(forwardHint, expected);
+
+        Animation::findKeyframe(keyView, frame, tableHint, lookupTable);
+        CORRADE_COMPARE(tableHint, expected);
+
+        std::size_t hint = keys.size() - 1;
+        Animation::findKeyframe(keyView, frame, hint, lookupTable);
+        CORRADE_COMPARE(hint, expected);
+    }
+}
+
+void InterpolationTest::findKeyframeNotEnoughKeys() {
+    const Float keys[]{1.0f};
+    std::size_t hint = 0;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Animation::findKeyframe(Containers::StridedArrayView1D<const Float>{keys}, 1.0f, hint);
+    CORRADE_COMPARE(out.str(), "Animation::findKeyframe(): at least two keyframes required\n");
+}
+
+void InterpolationTest::lookupTable() {
+    auto&& data = KeyData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    const std::vector<Float> keys = data.keys();
+    const Float begin = keys.front();
+    const Float duration = keys.back() - keys.front();
+    for(const std::size_t bucketCount: {std::size_t{1}, std::size_t{3}, std::size_t{16}, std::size_t{1000}}) {
+        const Containers::Array<UnsignedInt> table = keyframeLookupTable(Containers::StridedArrayView1D<const Float>{Containers::arrayView(keys)}, bucketCount);
+        CORRADE_COMPARE(table.size(), bucketCount);
+
+        /* Each bucket points to the keyframe the linear search would find
+           for the bucket start, and the table is monotonic */
+        for(std::size_t i = 0; i != bucketCount; ++i) {
+            CORRADE_COMPARE(table[i], findKeyframeLinear(keys, begin + duration*i/bucketCount, 0));
+            if(i) CORRADE_VERIFY(table[i - 1] <= table[i]);
+        }
+        CORRADE_COMPARE(table[0], findKeyframeLinear(keys, keys.front(), 0));
+    }
+}
+
+void InterpolationTest::lookupTableEmpty() {
+    const Float oneKey[]{1.0f};
+    const Float sameKeys[]{2.0f, 2.0f, 2.0f};
+    const Float keys[]{1.0f, 2.0f};
+
+    CORRADE_VERIFY(keyframeLookupTable(Containers::StridedArrayView1D<const Float>{}, 4).empty());
+    CORRADE_VERIFY(keyframeLookupTable(Containers::StridedArrayView1D<const Float>{oneKey}, 4).empty());
+    CORRADE_VERIFY(keyframeLookupTable(Containers::StridedArrayView1D<const Float>{sameKeys}, 4).empty());
+    CORRADE_VERIFY(keyframeLookupTable(Containers::StridedArrayView1D<const Float>{keys}, 0).empty());
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Animation::Test::InterpolationTest)
@@ -0,0 +1,269 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Animation/QuantizedQuaternion.h"
+#include "Magnum/Animation/Track.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Quaternion.h"
+
+namespace Magnum { namespace Animation { namespace Test { namespace {
+
+struct QuantizedQuaternionTest: TestSuite::Tester {
+    explicit QuantizedQuaternionTest();
+
+    void constructDefault();
+    void construct();
+    void constructNegated();
+    void constructZeroComponents();
+    void constructLargestComponent();
+    void compare();
+
+    void errorBounds();
+
+    void select();
+    void slerpShortestPath();
+    void slerpShortestPathClose();
+
+    void interpolatorFor();
+    void interpolatorForInvalid();
+    void track();
+};
+
+QuantizedQuaternionTest::QuantizedQuaternionTest() {
+    addTests({&QuantizedQuaternionTest::constructDefault,
+              &QuantizedQuaternionTest::construct,
+              &QuantizedQuaternionTest::constructNegated,
+              &QuantizedQuaternionTest::constructZeroComponents,
+              &QuantizedQuaternionTest::constructLargestComponent,
+              &QuantizedQuaternionTest::compare,
+
+              &QuantizedQuaternionTest::errorBounds,
+
+              &QuantizedQuaternionTest::select,
+              &QuantizedQuaternionTest::slerpShortestPath,
+              &QuantizedQuaternionTest::slerpShortestPathClose,
+
+              &QuantizedQuaternionTest::interpolatorFor,
+              &QuantizedQuaternionTest::interpolatorForInvalid,
+              &QuantizedQuaternionTest::track});
+}
+
+using namespace Math::Literals;
+
+/* Documented bounds of a single component and of the represented rotation */
+constexpr Float StoredComponentError = 2.2e-5f;
+constexpr Float ReconstructedComponentError = 6.0e-5f;
+constexpr Deg AngleError{0.01f};
+
+/* Angle of the relative rotation, without going through acos() of the dot
+   product which is too imprecise for small angles */
+Rad angle(const Quaternion& a, const Quaternion& b) {
+    const Quaternion difference = a.conjugated()*b;
+    return Rad{2.0f*std::atan2(difference.vector().length(), Math::abs(difference.scalar()))};
+}
+
+void QuantizedQuaternionTest::constructDefault() {
+    constexpr QuantizedQuaternion a;
+    QuantizedQuaternion b;
+    CORRADE_COMPARE(a.quaternion(), Quaternion{});
+    CORRADE_COMPARE(b.quaternion(), Quaternion{});
+    CORRADE_VERIFY(a == QuantizedQuaternion{Quaternion{}});
+}
+
+void QuantizedQuaternionTest::construct() {
+    const Quaternion q = Quaternion::rotation(35.0_degf, Vector3{1.0f, -2.0f, 0.5f}.normalized());
+    const QuantizedQuaternion a{q};
+    CORRADE_COMPARE(sizeof(QuantizedQuaternion), 6);
+
+    const Quaternion unpacked = a.quaternion();
+    CORRADE_VERIFY(unpacked.isNormalized());
+    CORRADE_COMPARE_AS(Float(angle(unpacked, q)), Float(Rad{AngleError}),
+        TestSuite::Compare::Less);
+
+    /* Packing an unpacked value again gives the same data */
+    CORRADE_VERIFY(QuantizedQuaternion{unpacked} == a);
+}
+
+void QuantizedQuaternionTest::constructNegated() {
+    /* q and -q is the same rotation, the representation is the same */
+    const Quaternion q = Quaternion::rotation(120.0_degf, Vector3{0.3f, 0.4f, -0.2f}.normalized());
+    CORRADE_VERIFY(QuantizedQuaternion{q} == QuantizedQuaternion{-q});
+
+    /* The largest component is always positive after unpacking */
+    const Quaternion unpacked = QuantizedQuaternion{-q}.quaternion();
+    CORRADE_COMPARE_AS(Math::dot(unpacked, q), 0.0f,
+        TestSuite::Compare::Greater);
+}
+
+void QuantizedQuaternionTest::constructZeroComponents() {
+    /* Zero is represented exactly, so a rotation around an axis stays around
+       the same axis */
+    const Quaternion unpacked = QuantizedQuaternion{Quaternion::rotation(30.0_degf, Vector3::yAxis())}.quaternion();
+    CORRADE_COMPARE(unpacked.vector().x(), 0.0f);
+    CORRADE_COMPARE(unpacked.vector().z(), 0.0f);
+    CORRADE_COMPARE_AS(Float(angle(unpacked, Quaternion::rotation(30.0_degf, Vector3::yAxis()))),
+        Float(Rad{AngleError}), TestSuite::Compare::Less);
+}
+
+void QuantizedQuaternionTest::constructLargestComponent() {
+    /* Each of the four components being the largest one, positive and
+       negative */
+    const Quaternion quaternions[]{
+        Quaternion{{0.8f, 0.4f, -0.2f}, 0.4f}.normalized(),
+        Quaternion{{-0.3f, -0.9f, 0.1f}, 0.2f}.normalized(),
+        Quaternion{{0.1f, 0.5f, 0.7f}, -0.4f}.normalized(),
+        Quaternion{{0.2f, -0.3f, 0.4f}, -0.8f}.normalized()
+    };
+    for(const Quaternion& q: quaternions) {
+        const Quaternion unpacked = QuantizedQuaternion{q}.quaternion();
+        const Quaternion expected = Math::dot(unpacked, q) < 0.0f ? -q : q;
+        CORRADE_COMPARE_AS(Math::abs(unpacked.vector() - expected.vector()).max(),
+            ReconstructedComponentError, TestSuite::Compare::LessOrEqual);
+        CORRADE_COMPARE_AS(Math::abs(unpacked.scalar() - expected.scalar()),
+            ReconstructedComponentError, TestSuite::Compare::LessOrEqual);
+    }
+}
+
+void QuantizedQuaternionTest::compare() {
+    const QuantizedQuaternion a{Quaternion::rotation(15.0_degf, Vector3::xAxis())};
+    const QuantizedQuaternion b{Quaternion::rotation(15.0_degf, Vector3::xAxis())};
+    const QuantizedQuaternion c{Quaternion::rotation(15.1_degf, Vector3::xAxis())};
+    CORRADE_VERIFY(a == b);
+    CORRADE_VERIFY(!(a != b));
+    CORRADE_VERIFY(a != c);
+    CORRADE_VERIFY(!(a == c));
+}
+
+void QuantizedQuaternionTest::errorBounds() {
+    /* Deterministic set of rotations around axes in all directions */
+    Float maxStoredError = 0.0f;
+    Float maxReconstructedError = 0.0f;
+    Rad maxAngleError{0.0f};
+    for(std::size_t i = 0; i != 10000; ++i) {
+        const Quaternion q = Quaternion::rotation(Rad(0.37f*i),
+            Vector3{std::sin(1.7f*i), std::cos(0.3f*i), std::sin(0.77f*i + 1.0f)}.normalized());
+        const Quaternion unpacked = QuantizedQuaternion{q}.quaternion();
+        const Quaternion expected = Math::dot(unpacked, q) < 0.0f ? -q : q;
+
+        const Float data[]{expected.vector().x(), expected.vector().y(), expected.vector().z(), expected.scalar()};
+        const Float unpackedData[]{unpacked.vector().x(), unpacked.vector().y(), unpacked.vector().z(), unpacked.scalar()};
+        std::size_t largest = 0;
+        for(std::size_t j = 1; j != 4; ++j)
+            if(Math::abs(data[j]) > Math::abs(data[largest])) largest = j;
+
+        for(std::size_t j = 0; j != 4; ++j) {
+            const Float error = Math::abs(unpackedData[j] - data[j]);
+            if(j == largest)
+                maxReconstructedError = Math::max(maxReconstructedError, error);
+            else
+                maxStoredError = Math::max(maxStoredError, error);
+        }
+
+        maxAngleError = Math::max(maxAngleError, angle(unpacked, q));
+    }
+
+    CORRADE_COMPARE_AS(maxStoredError, StoredComponentError,
+        TestSuite::Compare::LessOrEqual);
+    CORRADE_COMPARE_AS(maxReconstructedError, ReconstructedComponentError,
+        TestSuite::Compare::LessOrEqual);
+    CORRADE_COMPARE_AS(Float(Deg(maxAngleError)), Float(AngleError),
+        TestSuite::Compare::Less);
+}
+
+void QuantizedQuaternionTest::select() {
+    const QuantizedQuaternion a{Quaternion::rotation(15.0_degf, Vector3::xAxis())};
+    const QuantizedQuaternion b{Quaternion::rotation(75.0_degf, Vector3::zAxis())};
+    CORRADE_COMPARE(Animation::select(a, b, 0.0f), a.quaternion());
+    CORRADE_COMPARE(Animation::select(a, b, 0.8f), a.quaternion());
+    CORRADE_COMPARE(Animation::select(a, b, 1.0f), b.quaternion());
+}
+
+void QuantizedQuaternionTest::slerpShortestPath() {
+    const QuantizedQuaternion a{Quaternion::rotation(15.0_degf, Vector3::xAxis())};
+    /* More than 180° apart, so the shortest path is different */
+    const QuantizedQuaternion b{-Quaternion::rotation(200.0_degf, Vector3::zAxis())};
+
+    for(Float t: {0.0f, 0.25f, 0.5f, 1.0f})
+        CORRADE_COMPARE(Animation::slerpShortestPath(a, b, t),
+            Math::slerpShortestPath(a.quaternion(), b.quaternion(), t));
+}
+
+void QuantizedQuaternionTest::slerpShortestPathClose() {
+    /* Math::slerpShortestPath() would return the first quaternion for too
+       close rotations, the quantized variant falls back to a normalized
+       lerp */
+    const Quaternion a = Quaternion::rotation(15.0_degf, Vector3::xAxis());
+    const Quaternion b = Quaternion::rotation(15.2_degf, Vector3::xAxis());
+    const QuantizedQuaternion qa{a}, qb{b};
+    CORRADE_COMPARE(Math::slerpShortestPath(qa.quaternion(), qb.quaternion(), 0.5f), qa.quaternion());
+
+    const Quaternion result = Animation::slerpShortestPath(qa, qb, 0.5f);
+    CORRADE_VERIFY(result.isNormalized());
+    CORRADE_COMPARE(result, Math::lerpShortestPath(qa.quaternion(), qb.quaternion(), 0.5f));
+    CORRADE_VERIFY(result != qa.quaternion());
+}
+
+void QuantizedQuaternionTest::interpolatorFor() {
+    const auto constant = Animation::interpolatorFor<QuantizedQuaternion, Quaternion>(Interpolation::Constant);
+    const auto linear = Animation::interpolatorFor<QuantizedQuaternion, Quaternion>(Interpolation::Linear);
+    CORRADE_VERIFY(constant == static_cast<Quaternion(*)(const QuantizedQuaternion&, const QuantizedQuaternion&, Float)>(Animation::select));
+    CORRADE_VERIFY(linear == static_cast<Quaternion(*)(const QuantizedQuaternion&, const QuantizedQuaternion&, Float)>(Animation::slerpShortestPath));
+}
+
+void QuantizedQuaternionTest::interpolatorForInvalid() {
+    std::ostringstream out;
+    Error redirectError{&out};
+    Animation::interpolatorFor<QuantizedQuaternion, Quaternion>(Interpolation::Spline);
+    Animation::interpolatorFor<QuantizedQuaternion, Quaternion>(Interpolation::Custom);
+    CORRADE_COMPARE(out.str(),
+        "Animation::interpolatorFor(): can't deduce interpolator function for Animation::Interpolation::Spline\n"
+        "Animation::interpolatorFor(): can't deduce interpolator function for Animation::Interpolation::Custom\n");
+}
+
+void QuantizedQuaternionTest::track() {
+    const Quaternion a = Quaternion::rotation(0.0_degf, Vector3::yAxis());
+    const Quaternion b = Quaternion::rotation(90.0_degf, Vector3::yAxis());
+    const Float keys[]{0.0f, 2.0f};
+    const QuantizedQuaternion values[]{QuantizedQuaternion{a}, QuantizedQuaternion{b}};
+
+    const TrackView<Float, QuantizedQuaternion> linear{keys, values, Interpolation::Linear};
+    CORRADE_COMPARE_AS(Float(angle(linear.at(1.0f), Quaternion::rotation(45.0_degf, Vector3::yAxis()))),
+        Float(Rad{AngleError}), TestSuite::Compare::Less);
+    CORRADE_COMPARE_AS(Float(angle(linear.at(3.0f), b)),
+        Float(Rad{AngleError}), TestSuite::Compare::Less);
+
+    const TrackView<Float, QuantizedQuaternion> constant{keys, values, Interpolation::Constant};
+    CORRADE_COMPARE(constant.at(1.0f), values[0].quaternion());
+    CORRADE_COMPARE(constant.at(2.0f), values[1].quaternion());
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Animation::Test::QuantizedQuaternionTest)
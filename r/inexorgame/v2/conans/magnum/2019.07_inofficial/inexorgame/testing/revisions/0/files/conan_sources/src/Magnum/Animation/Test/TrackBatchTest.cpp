@@ -0,0 +1,346 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <vector>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Animation/TrackBatch.h"
+#include "Magnum/Math/Functions.h"
+
+namespace Magnum { namespace Animation { namespace Test { namespace {
+
+struct TrackBatchTest: TestSuite::Tester {
+    explicit TrackBatchTest();
+
+    void construct();
+    void add();
+    void addInterpolatorMismatch();
+    void clear();
+
+    void advance();
+    void advanceNotEnoughKeys();
+    void advanceNotEnoughDestinations();
+
+    void playerAdvanceKey();
+    void advancePlayers();
+    void advancePlayersNotEnoughPlayers();
+    void advancePlayersNotEnoughDestinations();
+
+    void advanceThreaded();
+};
+
+typedef TrackBatch<Float, Float, Float, Math::lerp> LinearBatch;
+
+const struct {
+    const char* name;
+    UnsignedInt threadCount;
+} AdvanceThreadedData[]{
+    {"two threads", 2},
+    {"four threads", 4},
+    {"all scheduler threads", 0},
+    {"more threads than tracks", 1000}
+};
+
+TrackBatchTest::TrackBatchTest() {
+    addTests({&TrackBatchTest::construct,
+              &TrackBatchTest::add,
+              &TrackBatchTest::addInterpolatorMismatch,
+              &TrackBatchTest::clear,
+
+              &TrackBatchTest::advance,
+              &TrackBatchTest::advanceNotEnoughKeys,
+              &TrackBatchTest::advanceNotEnoughDestinations,
+
+              &TrackBatchTest::playerAdvanceKey,
+              &TrackBatchTest::advancePlayers,
+              &TrackBatchTest::advancePlayersNotEnoughPlayers,
+              &TrackBatchTest::advancePlayersNotEnoughDestinations});
+
+    addInstancedTests({&TrackBatchTest::advanceThreaded},
+        Containers::arraySize(AdvanceThreadedData));
+}
+
+const Track<Float, Float> Linear{{
+    {0.0f, 0.0f},
+    {1.0f, 2.0f},
+    {2.0f, 6.0f}
+}, Math::lerp};
+
+const Track<Float, Float> Constant{{
+    {0.0f, 0.0f},
+    {1.0f, 2.0f},
+    {2.0f, 6.0f}
+}, Math::select};
+
+void TrackBatchTest::construct() {
+    LinearBatch batch;
+    CORRADE_VERIFY(LinearBatch::interpolator() == Linear.interpolator());
+    CORRADE_VERIFY(batch.isEmpty());
+    CORRADE_COMPARE(batch.size(), 0);
+    CORRADE_COMPARE(batch.playerCount(), 0);
+    CORRADE_COMPARE(batch.destinationCount(), 0);
+}
+
+void TrackBatchTest::add() {
+    LinearBatch batch;
+    batch.add(Linear, 2, 0)
+         .add(Linear, 0, 4);
+    CORRADE_VERIFY(!batch.isEmpty());
+    CORRADE_COMPARE(batch.size(), 2);
+    CORRADE_COMPARE(batch.playerCount(), 3);
+    CORRADE_COMPARE(batch.destinationCount(), 5);
+}
+
+void TrackBatchTest::addInterpolatorMismatch() {
+    LinearBatch batch;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    batch.add(Constant, 0, 0);
+
+    CORRADE_VERIFY(batch.isEmpty());
+    CORRADE_COMPARE(batch.playerCount(), 0);
+    CORRADE_COMPARE(batch.destinationCount(), 0);
+    CORRADE_COMPARE(out.str(), "Animation::TrackBatch::add(): track interpolator doesn't match the batch interpolator\n");
+}
+
+void TrackBatchTest::clear() {
+    LinearBatch batch;
+    batch.add(Linear, 2, 0)
+         .add(Linear, 0, 4)
+         .clear();
+    CORRADE_VERIFY(batch.isEmpty());
+    CORRADE_COMPARE(batch.playerCount(), 0);
+    CORRADE_COMPARE(batch.destinationCount(), 0);
+}
+
+void TrackBatchTest::advance() {
+    LinearBatch batch;
+    batch.add(Linear, 0, 2)
+         .add(Linear, 1, 0)
+         .add(Linear, 1, 1);
+
+    const Float keys[]{0.5f, 1.5f};
+    Float destinations[]{-1.0f, -1.0f, -1.0f};
+    batch.advance(Containers::arrayView(keys), Containers::arrayView(destinations));
+    CORRADE_COMPARE(destinations[0], 4.0f);
+    CORRADE_COMPARE(destinations[1], 4.0f);
+    CORRADE_COMPARE(destinations[2], 1.0f);
+}
+
+void TrackBatchTest::advanceNotEnoughKeys() {
+    LinearBatch batch;
+    batch.add(Linear, 1, 0);
+
+    const Float keys[]{0.5f};
+    Float destinations[1];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    batch.advance(Containers::arrayView(keys), Containers::arrayView(destinations));
+    CORRADE_COMPARE(out.str(), "Animation::TrackBatch::advance(): expected at least 2 keys but got 1\n");
+}
+
+void TrackBatchTest::advanceNotEnoughDestinations() {
+    LinearBatch batch;
+    batch.add(Linear, 0, 1);
+
+    const Float keys[]{0.5f};
+    Float destinations[1];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    batch.advance(Containers::arrayView(keys), Containers::arrayView(destinations));
+    CORRADE_COMPARE(out.str(), "Animation::TrackBatch::advance(): expected at least 2 destinations but got 1\n");
+}
+
+void TrackBatchTest::playerAdvanceKey() {
+    Player<Float> player;
+    player.setDuration({1.0f, 3.0f});
+
+    /* Not playing yet */
+    CORRADE_VERIFY(!player.advanceKey(0.5f));
+
+    /* Scheduled to start in the future */
+    player.play(2.0f);
+    CORRADE_VERIFY(!player.advanceKey(1.5f));
+
+    /* Key is offset by the duration start */
+    CORRADE_COMPARE(player.advanceKey(2.5f), 1.5f);
+    CORRADE_COMPARE(player.state(), State::Playing);
+
+    /* Paused, the key is parked at the pause time once and then nothing */
+    player.pause(3.0f);
+    CORRADE_COMPARE(player.advanceKey(3.5f), 2.0f);
+    CORRADE_VERIFY(!player.advanceKey(4.0f));
+    CORRADE_COMPARE(player.state(), State::Paused);
+
+    /* Resumed, continuing from where it was paused */
+    player.play(5.0f);
+    CORRADE_COMPARE(player.advanceKey(5.5f), 2.5f);
+
+    /* Ran out, giving the duration end and stopping */
+    CORRADE_COMPARE(player.advanceKey(10.0f), 3.0f);
+    CORRADE_COMPARE(player.state(), State::Stopped);
+    CORRADE_VERIFY(!player.advanceKey(11.0f));
+
+    /* Stopped explicitly, the key is reset to the duration start once */
+    player.play(20.0f);
+    CORRADE_COMPARE(player.advanceKey(20.5f), 1.5f);
+    player.stop();
+    CORRADE_COMPARE(player.advanceKey(21.0f), 1.0f);
+    CORRADE_VERIFY(!player.advanceKey(21.5f));
+}
+
+void TrackBatchTest::advancePlayers() {
+    LinearBatch batch;
+    batch.add(Linear, 0, 0)
+         .add(Linear, 1, 1)
+         .add(Linear, 2, 2)
+         .add(Linear, 2, 3);
+
+    Player<Float> players[3];
+    for(Player<Float>& player: players) player.setDuration({0.0f, 2.0f});
+    players[0].play(1.0f);
+    /* players[1] is never played */
+    players[2].play(0.0f);
+
+    Float destinations[]{-1.0f, -1.0f, -1.0f, -1.0f};
+    batch.advance(1.5f, Containers::arrayView(players), Containers::arrayView(destinations));
+    CORRADE_COMPARE(destinations[0], 1.0f);
+    CORRADE_COMPARE(destinations[1], -1.0f);
+    CORRADE_COMPARE(destinations[2], 4.0f);
+    CORRADE_COMPARE(destinations[3], 4.0f);
+
+    /* Tracks of a paused player are updated once with the parked key and then
+       left untouched */
+    players[2].pause(1.75f);
+    batch.advance(1.75f, Containers::arrayView(players), Containers::arrayView(destinations));
+    CORRADE_COMPARE(destinations[0], 1.5f);
+    CORRADE_COMPARE(destinations[1], -1.0f);
+    CORRADE_COMPARE(destinations[2], 5.0f);
+    CORRADE_COMPARE(destinations[3], 5.0f);
+
+    destinations[2] = destinations[3] = -1.0f;
+    batch.advance(2.0f, Containers::arrayView(players), Containers::arrayView(destinations));
+    CORRADE_COMPARE(destinations[0], 2.0f);
+    CORRADE_COMPARE(destinations[1], -1.0f);
+    CORRADE_COMPARE(destinations[2], -1.0f);
+    CORRADE_COMPARE(destinations[3], -1.0f);
+}
+
+void TrackBatchTest::advancePlayersNotEnoughPlayers() {
+    LinearBatch batch;
+    batch.add(Linear, 1, 0);
+
+    Player<Float> players[1];
+    Float destinations[1];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    batch.advance(0.0f, Containers::arrayView(players), Containers::arrayView(destinations));
+    CORRADE_COMPARE(out.str(), "Animation::TrackBatch::advance(): expected at least 2 players but got 1\n");
+}
+
+void TrackBatchTest::advancePlayersNotEnoughDestinations() {
+    LinearBatch batch;
+    batch.add(Linear, 0, 1);
+
+    Player<Float> players[1];
+    Float destinations[1];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    batch.advance(0.0f, Containers::arrayView(players), Containers::arrayView(destinations));
+    CORRADE_COMPARE(out.str(), "Animation::TrackBatch::advance(): expected at least 2 destinations but got 1\n");
+}
+
+void TrackBatchTest::advanceThreaded() {
+    auto&& data = AdvanceThreadedData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* Each player has a different count of tracks so the ranges have to be
+       aligned to player boundaries. Destinations are interleaved with other
+       data to test strides. */
+    struct Joint {
+        Float value;
+        Int padding;
+    };
+    constexpr UnsignedInt PlayerCount = 500;
+    LinearBatch batch;
+    std::size_t destinationCount = 0;
+    for(UnsignedInt i = 0; i != PlayerCount; ++i)
+        for(UnsignedInt j = 0; j != i%4 + 1; ++j)
+            batch.add(Linear, i, destinationCount++);
+    CORRADE_COMPARE_AS(batch.size(), 512, TestSuite::Compare::Greater);
+
+    std::vector<Joint> joints(destinationCount, Joint{-1.0f, 1337});
+    std::vector<Joint> expected(destinationCount, Joint{-1.0f, 1337});
+    const Containers::StridedArrayView1D<Float> destinations{Containers::arrayView(joints.data(), joints.size()), &joints[0].value, joints.size(), sizeof(Joint)};
+
+    /* Keys going back and forth to test that the per-track hints are
+       consistent across ranges */
+    for(Float time: {0.25f, 1.75f, 0.5f, 2.5f}) {
+        Float keys[PlayerCount];
+        for(UnsignedInt i = 0; i != PlayerCount; ++i)
+            keys[i] = time + (i%7)*0.125f;
+
+        batch.advance(Containers::arrayView(keys), destinations, data.threadCount);
+
+        std::size_t destination = 0;
+        for(UnsignedInt i = 0; i != PlayerCount; ++i)
+            for(UnsignedInt j = 0; j != i%4 + 1; ++j)
+                expected[destination++].value = Linear.at(keys[i]);
+
+        for(std::size_t i = 0; i != destinationCount; ++i) {
+            CORRADE_COMPARE(joints[i].value, expected[i].value);
+            CORRADE_COMPARE(joints[i].padding, 1337);
+        }
+    }
+
+    /* Player variant, with every third player stopped */
+    std::vector<Player<Float>> players(PlayerCount);
+    for(UnsignedInt i = 0; i != PlayerCount; ++i) {
+        players[i].setDuration({0.0f, 2.0f});
+        if(i%3) players[i].play(i*0.001f);
+    }
+    for(Joint& joint: joints) joint.value = -1.0f;
+    batch.advance(1.0f, Containers::arrayView(players.data(), players.size()), destinations, data.threadCount);
+
+    std::size_t destination = 0;
+    for(UnsignedInt i = 0; i != PlayerCount; ++i) {
+        for(UnsignedInt j = 0; j != i%4 + 1; ++j) {
+            CORRADE_COMPARE(joints[destination++].value, i%3 ?
+                Linear.at(1.0f - i*0.001f) : -1.0f);
+        }
+    }
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Animation::Test::TrackBatchTest)
@@ -0,0 +1,157 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <vector>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Animation/Track.h"
+#include "Magnum/Math/Functions.h"
+
+namespace Magnum { namespace Animation { namespace Test { namespace {
+
+struct TrackBenchmark: TestSuite::Tester {
+    explicit TrackBenchmark();
+
+    void linearSearch();
+    void binarySearch();
+    void lookupTable();
+};
+
+enum: std::size_t {
+    KeyCount = 4096,
+    FrameCount = 65536
+};
+
+enum class Playback {
+    Sequential,
+    Random,
+    Reverse
+};
+
+const struct {
+    const char* name;
+    Playback playback;
+} PlaybackData[]{
+    {"sequential", Playback::Sequential},
+    {"random", Playback::Random},
+    {"reverse", Playback::Reverse}
+};
+
+TrackBenchmark::TrackBenchmark() {
+    addInstancedBenchmarks({&TrackBenchmark::linearSearch,
+                            &TrackBenchmark::binarySearch,
+                            &TrackBenchmark::lookupTable}, 10,
+        Containers::arraySize(PlaybackData));
+}
+
+/* Unevenly spaced keyframes, like a compressed animation would have */
+Containers::Array<std::pair<Float, Float>> trackData() {
+    Containers::Array<std::pair<Float, Float>> data{Containers::NoInit, KeyCount};
+    Float key = 0.0f;
+    for(std::size_t i = 0; i != KeyCount; ++i) {
+        data[i] = {key, Float(i % 17)};
+        key += 0.01f + 0.02f*(i % 5);
+    }
+    return data;
+}
+
+std::vector<Float> frames(const Track<Float, Float>& track, const Playback playback) {
+    const Float begin = track.keys()[0];
+    const Float duration = track.keys()[track.size() - 1] - begin;
+
+    std::vector<Float> frames(FrameCount);
+    std::size_t random = 0;
+    for(std::size_t i = 0; i != FrameCount; ++i) {
+        std::size_t position = i;
+        if(playback == Playback::Reverse)
+            position = FrameCount - i - 1;
+        else if(playback == Playback::Random)
+            position = random = (random*1103515245 + 12345) % 2147483648u % FrameCount;
+        frames[i] = begin + duration*position/FrameCount;
+    }
+    return frames;
+}
+
+/* The keyframe search done by interpolate() before it used a binary search,
+   rewinding to the beginning whenever the frame is before the hint */
+Float atLinear(const Track<Float, Float>& track, const Float frame, std::size_t& hint) {
+    const Containers::StridedArrayView1D<const Float> keys = track.keys();
+    if(hint >= keys.size() || frame < keys[hint]) hint = 0;
+    while(hint + 2 < keys.size() && frame >= keys[hint + 1])
+        ++hint;
+    return Math::lerp(track.values()[hint], track.values()[hint + 1],
+        Math::lerpInverted(keys[hint], keys[hint + 1], frame));
+}
+
+void TrackBenchmark::linearSearch() {
+    auto&& data = PlaybackData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    const Track<Float, Float> track{trackData(), Math::lerp};
+    const std::vector<Float> frames = Test::frames(track, data.playback);
+
+    Float result = 0.0f;
+    std::size_t hint = 0;
+    CORRADE_BENCHMARK(1)
+        for(const Float frame: frames) result += atLinear(track, frame, hint);
+
+    CORRADE_VERIFY(result > 0.0f);
+}
+
+void TrackBenchmark::binarySearch() {
+    auto&& data = PlaybackData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    const Track<Float, Float> track{trackData(), Math::lerp};
+    const std::vector<Float> frames = Test::frames(track, data.playback);
+
+    Float result = 0.0f;
+    std::size_t hint = 0;
+    CORRADE_BENCHMARK(1)
+        for(const Float frame: frames) result += track.at(frame, hint);
+
+    CORRADE_VERIFY(result > 0.0f);
+}
+
+void TrackBenchmark::lookupTable() {
+    auto&& data = PlaybackData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Track<Float, Float> track{trackData(), Math::lerp};
+    track.setLookupTable(KeyCount/4);
+    const std::vector<Float> frames = Test::frames(track, data.playback);
+
+    Float result = 0.0f;
+    std::size_t hint = 0;
+    CORRADE_BENCHMARK(1)
+        for(const Float frame: frames) result += track.at(frame, hint);
+
+    CORRADE_VERIFY(result > 0.0f);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Animation::Test::TrackBenchmark)
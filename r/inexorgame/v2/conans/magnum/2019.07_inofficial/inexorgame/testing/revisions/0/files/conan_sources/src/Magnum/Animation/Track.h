@@ -76,12 +76,31 @@ performance. You have the following options:
 @subsection Animation-Track-performance-hint Keyframe hinting
 
 The @ref Track and @ref TrackView classes are fully stateless and the
-@ref at(K) const function performs a linear search for matching keyframe from
-the beginning every time. You can use @ref at(K, std::size_t&) const to
-remember last used keyframe index and pass it in the next iteration as a hint:
+@ref at(K) const function performs a binary search for matching keyframe every
+time. You can use @ref at(K, std::size_t&) const to remember last used
+keyframe index and pass it in the next iteration as a hint:
 
 @snippet MagnumAnimation.cpp Track-performance-hint
 
+With the hint, sequential playback checks just the hinted keyframe and the one
+after it. Random seeks (scrubbing, resynchronization over network) and reverse
+playback fall back to the binary search, see @ref findKeyframe() for details.
+
+@subsection Animation-Track-performance-lookup-table Keyframe lookup table
+
+For long tracks that are seeked randomly, the binary search can be narrowed
+down with a lookup table that splits the track duration into uniform buckets.
+Create it with @ref setLookupTable() on the @ref Track, or with
+@ref keyframeLookupTable() and pass it to @ref TrackView::setLookupTable() in
+case of a @ref TrackView. Views created from a @ref Track reference its lookup
+table, so the track has to stay in scope and unmodified for as long as the
+views are used.
+
+@code{.cpp}
+Animation::Track<Float, Vector3> track{std::move(data), Animation::Interpolation::Linear};
+track.setLookupTable(track.size()/4);
+@endcode
+
 @subsection Animation-Track-performance-strict Strict interpolation
 
 While it's possible to have different @ref Extrapolation modes for frames
@@ -145,7 +164,7 @@ template<class K, class V, class R
          * functions return @cpp nullptr @ce, @ref at() always returns a
          * default-constructed value.
          */
-        explicit Track() noexcept: _data{}, _interpolator{}, _before{}, _after{} {}
+        explicit Track() noexcept: _data{}, _interpolator{}, _before{}, _after{}, _lookupTable{} {}
 
         /**
          * @brief Construct with custom interpolator
@@ -244,7 +263,9 @@ template<class K, class V, class R
 
         /** @brief Conversion to a view */
         operator TrackView<K, V, R>() const noexcept {
-            return TrackView<K, V, R>{_data, _interpolation, _interpolator, _before, _after};
+            TrackView<K, V, R> view{_data, _interpolation, _interpolator, _before, _after};
+            view.setLookupTable(_lookupTable);
+            return view;
         }
 
         /**
@@ -323,11 +344,34 @@ template<class K, class V, class R
          */
         const std::pair<K, V>& operator[](std::size_t i) const { return _data[i]; }
 
+        /**
+         * @brief Keyframe lookup table
+         *
+         * Empty by default.
+         * @see @ref setLookupTable()
+         */
+        Containers::ArrayView<const UnsignedInt> lookupTable() const { return _lookupTable; }
+
+        /**
+         * @brief Create a keyframe lookup table
+         * @return Reference to self (for method chaining)
+         *
+         * Creates a table with @p bucketCount buckets using
+         * @ref keyframeLookupTable(), which is then used by @ref at() and
+         * @ref atStrict() to speed up keyframe search. Passing @cpp 0 @ce
+         * removes the table. See @ref Animation-Track-performance-lookup-table
+         * for more information.
+         */
+        Track<K, V, R>& setLookupTable(std::size_t bucketCount) {
+            _lookupTable = keyframeLookupTable(keys(), bucketCount);
+            return *this;
+        }
+
         /**
          * @brief Animated value at a given time
          *
          * Calls @ref interpolate(), see its documentation for more
-         * information. Note that this function performs a linear search every
+         * information. Note that this function performs a binary search every
          * time, use @ref at(K, std::size_t&) const to supply a search hint.
          * @see @ref atStrict(K, std::size_t&) const,
          *      @ref at(Interpolator, K) const
@@ -372,7 +416,7 @@ template<class K, class V, class R
          * @see @ref atStrict(Interpolator, K, std::size_t&) const
          */
         R at(Interpolator interpolator, K frame, std::size_t& hint) const {
-            return interpolate(keys(), values(), _before, _after, interpolator, frame, hint);
+            return interpolate(keys(), values(), _before, _after, interpolator, frame, hint, _lookupTable);
         }
 
         /**
@@ -396,7 +440,7 @@ template<class K, class V, class R
          * @see @ref at(K, std::size_t&) const
          */
         R atStrict(Interpolator interpolator, K frame, std::size_t& hint) const {
-            return interpolateStrict(keys(), values(), interpolator, frame, hint);
+            return interpolateStrict(keys(), values(), interpolator, frame, hint, _lookupTable);
         }
 
     private:
@@ -404,6 +448,7 @@ template<class K, class V, class R
         Interpolator _interpolator;
         Interpolation _interpolation;
         Extrapolation _before, _after;
+        Containers::Array<UnsignedInt> _lookupTable;
 };
 
 /**
@@ -417,7 +462,7 @@ template<class K> class TrackViewStorage {
         /** @brief Key type */
         typedef K KeyType;
 
-        constexpr /*implicit*/ TrackViewStorage() noexcept: _keys{}, _values{}, _interpolator{}, _interpolation{}, _before{}, _after{} {}
+        constexpr /*implicit*/ TrackViewStorage() noexcept: _keys{}, _values{}, _interpolator{}, _interpolation{}, _before{}, _after{}, _lookupTable{} {}
 
         /**
          * @brief Interpolation behavior
@@ -470,16 +515,27 @@ template<class K> class TrackViewStorage {
             return _keys;
         }
 
+        /**
+         * @brief Keyframe lookup table
+         *
+         * Empty by default.
+         * @see @ref TrackView::setLookupTable()
+         */
+        Containers::ArrayView<const UnsignedInt> lookupTable() const {
+            return _lookupTable;
+        }
+
     private:
         template<class, class, class> friend class TrackView;
 
-        template<class V, class R> explicit TrackViewStorage(const Containers::StridedArrayView1D<const K>& keys, const Containers::StridedArrayView1D<const V>& values, Interpolation interpolation, R(*interpolator)(const V&, const V&, Float), Extrapolation before, Extrapolation after) noexcept: _keys{keys}, _values{reinterpret_cast<const Containers::StridedArrayView1D<const char>&>(values)}, _interpolator{reinterpret_cast<void(*)()>(interpolator)}, _interpolation{interpolation}, _before{before}, _after{after} {}
+        template<class V, class R> explicit TrackViewStorage(const Containers::StridedArrayView1D<const K>& keys, const Containers::StridedArrayView1D<const V>& values, Interpolation interpolation, R(*interpolator)(const V&, const V&, Float), Extrapolation before, Extrapolation after) noexcept: _keys{keys}, _values{reinterpret_cast<const Containers::StridedArrayView1D<const char>&>(values)}, _interpolator{reinterpret_cast<void(*)()>(interpolator)}, _interpolation{interpolation}, _before{before}, _after{after}, _lookupTable{} {}
 
         Containers::StridedArrayView1D<const K> _keys;
         Containers::StridedArrayView1D<const char> _values;
         void(*_interpolator)(void);
         Interpolation _interpolation;
         Extrapolation _before, _after;
+        Containers::ArrayView<const UnsignedInt> _lookupTable;
 };
 
 /**
@@ -666,11 +722,26 @@ template<class K, class V, class R
             return {TrackViewStorage<K>::_keys[i], values()[i]};
         }
 
+        /**
+         * @brief Set keyframe lookup table
+         * @return Reference to self (for method chaining)
+         *
+         * The @p table is expected to be created by
+         * @ref keyframeLookupTable() from @ref keys() and is used by
+         * @ref at() and @ref atStrict() to speed up keyframe search. The view
+         * doesn't take ownership of the table. See
+         * @ref Animation-Track-performance-lookup-table for more information.
+         */
+        TrackView<K, V, R>& setLookupTable(Containers::ArrayView<const UnsignedInt> table) {
+            TrackViewStorage<K>::_lookupTable = table;
+            return *this;
+        }
+
         /**
          * @brief Animated value at a given time
          *
          * Calls @ref interpolate(), see its documentation for more
-         * information. Note that this function performs a linear search every
+         * information. Note that this function performs a binary search every
          * time, use @ref at(K, std::size_t&) const to supply a search hint.
          * @see @ref atStrict(K, std::size_t&) const,
          *      @ref at(Interpolator, K) const
@@ -715,7 +786,7 @@ template<class K, class V, class R
          * @see @ref atStrict(Interpolator, K, std::size_t&) const
          */
         R at(Interpolator interpolator, K frame, std::size_t& hint) const {
-            return interpolate(TrackViewStorage<K>::_keys, values(), TrackViewStorage<K>::_before, TrackViewStorage<K>::_after, interpolator, frame, hint);
+            return interpolate(TrackViewStorage<K>::_keys, values(), TrackViewStorage<K>::_before, TrackViewStorage<K>::_after, interpolator, frame, hint, TrackViewStorage<K>::_lookupTable);
         }
 
         /**
@@ -739,7 +810,7 @@ template<class K, class V, class R
          * @see @ref at(K, std::size_t&) const
          */
         R atStrict(Interpolator interpolator, K frame, std::size_t& hint) const {
-            return interpolateStrict(TrackViewStorage<K>::_keys, values(), interpolator, frame, hint);
+            return interpolateStrict(TrackViewStorage<K>::_keys, values(), interpolator, frame, hint, TrackViewStorage<K>::_lookupTable);
         }
 };
 
@@ -0,0 +1,68 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "TrackBatch.h"
+
+#include <Corrade/Utility/TaskScheduler.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Implementation/taskScheduler.h"
+
+namespace Magnum { namespace Animation { namespace Implementation {
+
+namespace {
+    constexpr std::size_t MinimalTracksPerThread = 256;
+}
+
+void trackBatchParallelFor(const Containers::ArrayView<const UnsignedInt> players, UnsignedInt threadCount, void(*const function)(void*, std::size_t, std::size_t), void* const state) {
+    if(!threadCount) threadCount = Magnum::Implementation::taskScheduler().threadCount();
+    threadCount = Math::min(std::size_t(threadCount), Math::max(players.size()/MinimalTracksPerThread, std::size_t{1}));
+    if(threadCount == 1) {
+        function(state, 0, players.size());
+        return;
+    }
+
+    /* Split the tracks into roughly equal chunks, moving each boundary
+       forward so tracks of a single player don't get split between two
+       chunks. The boundaries are calculated independently for each chunk,
+       but moving them is monotonic, so the chunks are still contiguous. */
+    auto chunkBegin = [players, threadCount](const std::size_t chunk) {
+        std::size_t begin = players.size()*chunk/threadCount;
+        while(begin && begin < players.size() && players[begin] == players[begin - 1])
+            ++begin;
+        return begin;
+    };
+
+    Magnum::Implementation::taskScheduler().parallelFor(0, threadCount, 1, [&](const std::size_t begin, const std::size_t end) {
+        for(std::size_t chunk = begin; chunk != end; ++chunk) {
+            const std::size_t chunkEnd = chunkBegin(chunk + 1);
+            const std::size_t chunkStart = chunkBegin(chunk);
+            if(chunkStart != chunkEnd) function(state, chunkStart, chunkEnd);
+        }
+    });
+}
+
+}}}
@@ -0,0 +1,361 @@
+#ifndef Magnum_Animation_TrackBatch_h
+#define Magnum_Animation_TrackBatch_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Animation::TrackBatch
+ */
+
+#include <vector>
+#include <Corrade/Containers/Optional.h>
+
+#include "Magnum/Animation/Player.h"
+
+namespace Magnum { namespace Animation {
+
+namespace Implementation {
+    MAGNUM_EXPORT void trackBatchParallelFor(Containers::ArrayView<const UnsignedInt> players, UnsignedInt threadCount, void(*function)(void*, std::size_t, std::size_t), void* state);
+}
+
+/**
+@brief Batch of animation tracks
+@tparam K       Key type
+@tparam V       Value type
+@tparam R       Result type
+@tparam interpolatorFunction Interpolator function used for all tracks
+
+Evaluates tracks of many players at once. While @ref Player is convenient for
+animating a handful of objects, each of its tracks is updated through an
+indirect call taking a type-erased track view and destination pointer, which
+becomes a bottleneck when animating thousands of characters. A batch instead
+groups all tracks with the same key, value and result type and the same
+interpolator together, no matter which player they belong to, and updates them
+in a single tight loop over contiguous track and keyframe hint arrays. The
+interpolator is a template parameter, so the compiler is able to inline it
+into the loop.
+
+@section Animation-TrackBatch-usage Basic usage
+
+Each track is added together with an index of the player it belongs to and an
+index of its destination. The destinations are then passed as a strided view
+on every @ref advance() call, which means they can be for example a member of
+an array of per-joint transformation structures for all characters:
+
+@code{.cpp}
+struct Joint {
+    Vector3 translation;
+    Quaternion rotation;
+    Vector3 scaling;
+};
+std::vector<Joint> joints;
+
+Animation::TrackBatch<Float, Quaternion, Quaternion, Math::slerp> rotations;
+for(std::size_t i = 0; i != characterCount; ++i)
+    for(std::size_t j = 0; j != jointCount; ++j)
+        rotations.add(rotationTracks[j], i, i*jointCount + j);
+
+// every frame, with one key for each character
+rotations.advance(keys, Containers::StridedArrayView1D<Quaternion>{
+    Containers::arrayView(joints), &joints[0].rotation, joints.size(),
+    sizeof(Joint)});
+@endcode
+
+The keys can be calculated by any means, but the batch can be also driven by
+an array of @ref Player instances using
+@ref advance(T, Containers::ArrayView<Player<T, K>>, const Containers::StridedArrayView1D<R>&, UnsignedInt).
+In that case the players are used only to control the playback and are
+advanced using @ref Player::advanceKey(), tracks of players that are stopped
+or paused are not updated.
+
+@section Animation-TrackBatch-performance Performance tuning
+
+All tracks in the batch share a single interpolator, passed as a template
+parameter. The keyframe search remembers the last found keyframe for each
+track the same way as @ref Track::at(K, std::size_t&) const does, so the
+search is usually just a few comparisons when the animation moves forward. If
+a track has a lookup table set via @ref Track::setLookupTable(), it's used by
+the batch as well.
+
+Tracks are evaluated in the order they were added. If @p threadCount passed
+to @ref advance() is not @cpp 1 @ce, the batch is split into ranges of tracks
+that are evaluated in parallel on a task scheduler shared by the whole
+library, with @cpp 0 @ce meaning all threads of the scheduler. No threads are
+created during the call. The ranges are split only between tracks of two
+different players, so adding all tracks of one player after each other keeps
+all data of given player in a single range. Each range gets at least
+@cpp 256 @ce tracks, smaller batches are evaluated on the calling thread
+directly. It's expected that no two tracks share the same destination. If
+Corrade is built without `BUILD_MULTITHREADED` or on
+@ref CORRADE_TARGET_EMSCRIPTEN "Emscripten", all ranges are evaluated on the
+calling thread.
+@experimental
+*/
+template<class K, class V, class R, R(*interpolatorFunction)(const V&, const V&, Float)> class TrackBatch {
+    public:
+        /** @brief Key type */
+        typedef K KeyType;
+
+        /** @brief Value type */
+        typedef V ValueType;
+
+        /** @brief Result type */
+        typedef R ResultType;
+
+        /** @brief Interpolation function */
+        typedef ResultType(*Interpolator)(const ValueType&, const ValueType&, Float);
+
+        /** @brief Constructor */
+        explicit TrackBatch() noexcept: _playerCount{}, _destinationCount{} {}
+
+        /** @brief Interpolator function */
+        static constexpr Interpolator interpolator() { return interpolatorFunction; }
+
+        /** @brief Whether the batch is empty */
+        bool isEmpty() const { return _tracks.empty(); }
+
+        /** @brief Count of tracks in the batch */
+        std::size_t size() const { return _tracks.size(); }
+
+        /**
+         * @brief Player count
+         *
+         * One more than the largest player index passed to @ref add(), or
+         * @cpp 0 @ce if the batch is empty. The key view passed to
+         * @ref advance() is expected to have at least this size.
+         */
+        UnsignedInt playerCount() const { return _playerCount; }
+
+        /**
+         * @brief Destination count
+         *
+         * One more than the largest destination index passed to @ref add(),
+         * or @cpp 0 @ce if the batch is empty. The destination view passed to
+         * @ref advance() is expected to have at least this size.
+         */
+        std::size_t destinationCount() const { return _destinationCount; }
+
+        /**
+         * @brief Reserve memory for given count of tracks
+         *
+         * Useful to avoid reallocations when adding a large amount of tracks.
+         */
+        TrackBatch<K, V, R, interpolatorFunction>& reserve(std::size_t size);
+
+        /**
+         * @brief Add a track
+         * @param track         Track to add
+         * @param player        Index of a player to take the key from
+         * @param destination   Index of a destination to write the result to
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that the track interpolator is the same as
+         * @ref interpolator(). The batch stores just a @ref TrackView, for
+         * every @ref Track instance you have to ensure that it stays alive
+         * for the whole lifetime of the batch.
+         */
+        TrackBatch<K, V, R, interpolatorFunction>& add(const TrackView<K, V, R>& track, UnsignedInt player, std::size_t destination);
+
+        /**
+         * @brief Clear the batch
+         * @return Reference to self (for method chaining)
+         *
+         * Removes all tracks, the allocated memory is kept.
+         */
+        TrackBatch<K, V, R, interpolatorFunction>& clear();
+
+        /**
+         * @brief Advance the batch
+         * @param keys          Key for each player
+         * @param destinations  Destinations to write the results to
+         * @param threadCount   Count of threads to use. @cpp 0 @ce means
+         *      all available cores.
+         *
+         * Evaluates all tracks at a key corresponding to their player and
+         * writes the results to corresponding destinations. Expects that
+         * @p keys has at least @ref playerCount() items and
+         * @p destinations has at least @ref destinationCount() items.
+         */
+        void advance(const Containers::StridedArrayView1D<const K>& keys, const Containers::StridedArrayView1D<R>& destinations, UnsignedInt threadCount = 1);
+
+        /**
+         * @brief Advance the batch using players
+         * @param time          Time to advance the players to
+         * @param players       Players controlling the playback
+         * @param destinations  Destinations to write the results to
+         * @param threadCount   Count of threads to use. @cpp 0 @ce means
+         *      all available cores.
+         *
+         * Calls @ref Player::advanceKey() on each of @p players and then
+         * evaluates tracks of players that got advanced, tracks of other
+         * players are left untouched. Tracks added directly to the players
+         * are not updated. Expects that @p players has at least
+         * @ref playerCount() items and @p destinations has at least
+         * @ref destinationCount() items.
+         */
+        template<class T> void advance(T time, Containers::ArrayView<Player<T, K>> players, const Containers::StridedArrayView1D<R>& destinations, UnsignedInt threadCount = 1);
+
+    private:
+        struct Track {
+            Containers::StridedArrayView1D<const K> keys;
+            Containers::StridedArrayView1D<const V> values;
+            Containers::ArrayView<const UnsignedInt> lookupTable;
+            Extrapolation before, after;
+        };
+
+        struct AdvanceState {
+            TrackBatch<K, V, R, interpolatorFunction>& batch;
+            const Containers::StridedArrayView1D<const K>& keys;
+            const char* advanced;
+            const Containers::StridedArrayView1D<R>& destinations;
+        };
+
+        static void advanceRange(void* state, std::size_t begin, std::size_t end);
+
+        UnsignedInt _playerCount;
+        std::size_t _destinationCount;
+
+        /* Kept as separate arrays so the hot loop touches only what it
+           needs */
+        std::vector<Track> _tracks;
+        std::vector<UnsignedInt> _players;
+        std::vector<std::size_t> _destinations;
+        std::vector<std::size_t> _hints;
+
+        /* Scratch memory for the player variant of advance() */
+        std::vector<K> _keys;
+        std::vector<char> _advanced;
+};
+
+template<class K, class V, class R, R(*interpolatorFunction)(const V&, const V&, Float)> TrackBatch<K, V, R, interpolatorFunction>& TrackBatch<K, V, R, interpolatorFunction>::reserve(const std::size_t size) {
+    _tracks.reserve(size);
+    _players.reserve(size);
+    _destinations.reserve(size);
+    _hints.reserve(size);
+    return *this;
+}
+
+template<class K, class V, class R, R(*interpolatorFunction)(const V&, const V&, Float)> TrackBatch<K, V, R, interpolatorFunction>& TrackBatch<K, V, R, interpolatorFunction>::add(const TrackView<K, V, R>& track, const UnsignedInt player, const std::size_t destination) {
+    CORRADE_ASSERT(track.interpolator() == interpolatorFunction,
+        "Animation::TrackBatch::add(): track interpolator doesn't match the batch interpolator", *this);
+    _tracks.push_back(Track{track.keys(), track.values(), track.lookupTable(), track.before(), track.after()});
+    _players.push_back(player);
+    _destinations.push_back(destination);
+    _hints.push_back(0);
+    _playerCount = Math::max(_playerCount, player + 1);
+    _destinationCount = Math::max(_destinationCount, destination + 1);
+    return *this;
+}
+
+template<class K, class V, class R, R(*interpolatorFunction)(const V&, const V&, Float)> TrackBatch<K, V, R, interpolatorFunction>& TrackBatch<K, V, R, interpolatorFunction>::clear() {
+    _tracks.clear();
+    _players.clear();
+    _destinations.clear();
+    _hints.clear();
+    _playerCount = 0;
+    _destinationCount = 0;
+    return *this;
+}
+
+template<class K, class V, class R, R(*interpolatorFunction)(const V&, const V&, Float)> void TrackBatch<K, V, R, interpolatorFunction>::advanceRange(void* const state, const std::size_t begin, const std::size_t end) {
+    const AdvanceState& s = *static_cast<const AdvanceState*>(state);
+    const Track* const tracks = s.batch._tracks.data();
+    const UnsignedInt* const players = s.batch._players.data();
+    const std::size_t* const destinations = s.batch._destinations.data();
+    std::size_t* const hints = s.batch._hints.data();
+
+    for(std::size_t i = begin; i != end; ++i) {
+        const UnsignedInt player = players[i];
+        if(s.advanced && !s.advanced[player]) continue;
+
+        /* Same as interpolate(), but calling the interpolator directly so it
+           can be inlined */
+        const Track& t = tracks[i];
+        R& destination = s.destinations[destinations[i]];
+        K frame = s.keys[player];
+        if(t.keys.size() < 2) {
+            if(!t.keys.size() ||
+               (frame < t.keys[0] && t.before == Extrapolation::DefaultConstructed) ||
+               (frame > t.keys[0] && t.after == Extrapolation::DefaultConstructed))
+                destination = R{};
+            else destination = interpolatorFunction(t.values[0], t.values[0], 0.0f);
+            continue;
+        }
+
+        std::size_t& hint = hints[i];
+        findKeyframe(t.keys, frame, hint, t.lookupTable);
+        if(frame < t.keys[hint]) {
+            if(t.before == Extrapolation::DefaultConstructed) {
+                destination = R{};
+                continue;
+            }
+            if(t.before == Extrapolation::Constant) frame = t.keys[hint];
+        } else if(frame >= t.keys[hint + 1]) {
+            if(t.after == Extrapolation::DefaultConstructed) {
+                destination = R{};
+                continue;
+            }
+            if(t.after == Extrapolation::Constant) frame = t.keys[hint + 1];
+        }
+
+        destination = interpolatorFunction(t.values[hint], t.values[hint + 1],
+            Math::lerpInverted(Float(t.keys[hint]), Float(t.keys[hint + 1]), Float(frame)));
+    }
+}
+
+template<class K, class V, class R, R(*interpolatorFunction)(const V&, const V&, Float)> void TrackBatch<K, V, R, interpolatorFunction>::advance(const Containers::StridedArrayView1D<const K>& keys, const Containers::StridedArrayView1D<R>& destinations, const UnsignedInt threadCount) {
+    CORRADE_ASSERT(keys.size() >= _playerCount,
+        "Animation::TrackBatch::advance(): expected at least" << _playerCount << "keys but got" << keys.size(), );
+    CORRADE_ASSERT(destinations.size() >= _destinationCount,
+        "Animation::TrackBatch::advance(): expected at least" << _destinationCount << "destinations but got" << destinations.size(), );
+
+    AdvanceState state{*this, keys, nullptr, destinations};
+    Implementation::trackBatchParallelFor(Containers::arrayView(_players.data(), _players.size()), threadCount, advanceRange, &state);
+}
+
+template<class K, class V, class R, R(*interpolatorFunction)(const V&, const V&, Float)> template<class T> void TrackBatch<K, V, R, interpolatorFunction>::advance(const T time, const Containers::ArrayView<Player<T, K>> players, const Containers::StridedArrayView1D<R>& destinations, const UnsignedInt threadCount) {
+    CORRADE_ASSERT(players.size() >= _playerCount,
+        "Animation::TrackBatch::advance(): expected at least" << _playerCount << "players but got" << players.size(), );
+    CORRADE_ASSERT(destinations.size() >= _destinationCount,
+        "Animation::TrackBatch::advance(): expected at least" << _destinationCount << "destinations but got" << destinations.size(), );
+
+    /* Advance the players first, remembering which of them should update
+       their tracks */
+    _keys.resize(players.size());
+    _advanced.resize(players.size());
+    for(std::size_t i = 0; i != players.size(); ++i) {
+        const Containers::Optional<K> key = players[i].advanceKey(time);
+        _advanced[i] = bool(key);
+        if(key) _keys[i] = *key;
+    }
+
+    const Containers::StridedArrayView1D<const K> keys{Containers::arrayView(_keys.data(), _keys.size()), _keys.data(), _keys.size(), sizeof(K)};
+    AdvanceState state{*this, keys, _advanced.data(), destinations};
+    Implementation::trackBatchParallelFor(Containers::arrayView(_players.data(), _players.size()), threadCount, advanceRange, &state);
+}
+
+}}
+
+#endif
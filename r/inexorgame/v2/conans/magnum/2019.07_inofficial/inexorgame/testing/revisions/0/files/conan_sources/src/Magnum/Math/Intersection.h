@@ -214,6 +214,33 @@ Checks for each plane of the frustum whether the sphere is behind the plane
 */
 template<class T> bool sphereFrustum(const Vector3<T>& sphereCenter, T sphereRadius, const Frustum<T>& frustum);
 
+/**
+@brief Intersection of a ray and a range
+@param rayOrigin            Origin of the ray
+@param inverseRayDirection  Inverse ray direction
+@param range                Range
+@return @cpp true @ce if the ray intersects the range, @cpp false @ce
+    otherwise
+
+Uses the slab method, clipping the ray parameter @f$ t @f$ by the pair of
+planes bounding the range in each dimension and checking that the remaining
+interval is not empty and not entirely behind the ray origin: @f[
+    \begin{array}{rcl}
+        \boldsymbol t_1 & = & (\boldsymbol{min} - \boldsymbol o) \boldsymbol d^{-1} \\
+        \boldsymbol t_2 & = & (\boldsymbol{max} - \boldsymbol o) \boldsymbol d^{-1} \\
+        t_{near} & = & \max(\max_i(\min(t_{1_i}, t_{2_i})), 0) \\
+        t_{far} & = & \min_i(\max(t_{1_i}, t_{2_i})) \\
+        t_{near} & \le & t_{far}
+    \end{array}
+@f]
+
+The inverse direction is taken as a parameter, as it's usually tested against
+many ranges. Zero direction components result in infinite inverse
+components, which is handled correctly, except for the case where the ray
+origin lies exactly on a plane parallel to the ray.
+*/
+template<class T> bool rayRange(const Vector3<T>& rayOrigin, const Vector3<T>& inverseRayDirection, const Range3D<T>& range);
+
 /**
 @brief Intersection of a point and a cone
 @param point        The point
@@ -445,6 +472,17 @@ template<class T> bool rangeFrustum(const Range3D<T>& range, const Frustum<T>& f
     return true;
 }
 
+template<class T> bool rayRange(const Vector3<T>& rayOrigin, const Vector3<T>& inverseRayDirection, const Range3D<T>& range) {
+    const Vector3<T> t1 = (range.min() - rayOrigin)*inverseRayDirection;
+    const Vector3<T> t2 = (range.max() - rayOrigin)*inverseRayDirection;
+    const Vector3<T> tMin = Math::min(t1, t2);
+    const Vector3<T> tMax = Math::max(t1, t2);
+
+    const T tNear = Math::max(tMin.max(), T(0));
+    const T tFar = tMax.min();
+    return tNear <= tFar;
+}
+
 template<class T> bool aabbFrustum(const Vector3<T>& aabbCenter, const Vector3<T>& aabbExtents, const Frustum<T>& frustum) {
     for(const Vector4<T>& plane: frustum) {
         const Vector3<T> absPlaneNormal = Math::abs(plane.xyz());
@@ -0,0 +1,439 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "QuaternionBatch.h"
+
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/Quaternion.h"
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define MAGNUM_MATH_QUATERNIONBATCH_AVX
+#define MAGNUM_MATH_QUATERNIONBATCH_SSE2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MAGNUM_MATH_QUATERNIONBATCH_SSE2
+/* GCC and Clang can compile AVX code without AVX being enabled globally, so
+   pick it at runtime if the CPU supports it */
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define MAGNUM_MATH_QUATERNIONBATCH_AVX
+#define MAGNUM_MATH_QUATERNIONBATCH_AVX_RUNTIME
+#define MAGNUM_MATH_QUATERNIONBATCH_AVX_TARGET __attribute__((target("avx")))
+#endif
+#endif
+
+#if defined(MAGNUM_MATH_QUATERNIONBATCH_AVX) && !defined(MAGNUM_MATH_QUATERNIONBATCH_AVX_TARGET)
+#define MAGNUM_MATH_QUATERNIONBATCH_AVX_TARGET
+#endif
+
+namespace Magnum { namespace Math {
+
+namespace {
+
+enum class Operation {
+    Lerp,
+    LerpShortestPath,
+    Slerp,
+    SlerpShortestPath
+};
+
+/* Same as lerp(), lerpShortestPath(), slerp() and slerpShortestPath(), but
+   without the normalization assertions, so the items processed here behave
+   the same as the ones processed by the SIMD kernels */
+inline Quaternion<Float> interpolateScalar(const Operation operation, const Quaternion<Float>& a, const Quaternion<Float>& b, const Float t) {
+    const Float cosHalfAngle = dot(a, b);
+    const bool shortestPath = operation == Operation::LerpShortestPath || operation == Operation::SlerpShortestPath;
+    const Quaternion<Float> shortestA = shortestPath && cosHalfAngle < 0.0f ? -a : a;
+
+    if(operation == Operation::Lerp || operation == Operation::LerpShortestPath)
+        return ((1.0f - t)*shortestA + t*b).normalized();
+
+    /* Avoid division by zero */
+    if(std::abs(cosHalfAngle) >= 1.0f - TypeTraits<Float>::epsilon())
+        return a;
+
+    const Float angle = std::acos(shortestPath ? std::abs(cosHalfAngle) : cosHalfAngle);
+    return (std::sin((1.0f - t)*angle)*shortestA + std::sin(t*angle)*b)/std::sin(angle);
+}
+
+inline Matrix4<Float> transformationScalar(const Vector3<Float>& translation, const Quaternion<Float>& rotation, const Vector3<Float>& scaling) {
+    const Matrix3x3<Float> r = rotation.toMatrix();
+    return {{r[0]*scaling.x(), 0.0f},
+            {r[1]*scaling.y(), 0.0f},
+            {r[2]*scaling.z(), 0.0f},
+            {translation, 1.0f}};
+}
+
+#if defined(MAGNUM_MATH_QUATERNIONBATCH_SSE2) || defined(MAGNUM_MATH_QUATERNIONBATCH_AVX)
+/* Building blocks shared by the SSE2 and AVX kernels below. The AVX variants
+   operate on two 128-bit lanes, each holding four items, so the transpose
+   from four interleaved XYZW quaternions to separate X, Y, Z, W registers is
+   the same sequence in both cases. The comparison and rounding intrinsics
+   differ, the rest is just a different prefix. */
+template<class T> T splat(Float);
+
+/* Unchecked element access, the view sizes are checked upfront and the bounds
+   checks would otherwise be a significant portion of the loads and stores */
+template<class T> inline T& at(const Corrade::Containers::StridedArrayView1D<T>& view, const std::size_t i) {
+    typedef typename std::conditional<std::is_const<T>::value, const char, char>::type Byte;
+    return *reinterpret_cast<T*>(static_cast<Byte*>(view.data()) + std::ptrdiff_t(i)*view.stride());
+}
+
+#define MAGNUM_MATH_QUATERNIONBATCH_DEFINE_OPERATIONS(type, prefix, target) \
+    target inline type add(type a, type b) { return prefix ## _add_ps(a, b); } \
+    target inline type sub(type a, type b) { return prefix ## _sub_ps(a, b); } \
+    target inline type mul(type a, type b) { return prefix ## _mul_ps(a, b); } \
+    target inline type div(type a, type b) { return prefix ## _div_ps(a, b); } \
+    target inline type sqrt(type a) { return prefix ## _sqrt_ps(a); }      \
+    target inline type bitAnd(type a, type b) { return prefix ## _and_ps(a, b); } \
+    target inline type bitXor(type a, type b) { return prefix ## _xor_ps(a, b); } \
+    /* Picks b where the mask is set, a otherwise */                        \
+    target inline type select(type mask, type a, type b) {                 \
+        return prefix ## _or_ps(prefix ## _andnot_ps(mask, a), prefix ## _and_ps(mask, b)); \
+    }                                                                       \
+    target inline void transpose(type& a, type& b, type& c, type& d) {     \
+        const type ab01 = prefix ## _unpacklo_ps(a, b);                    \
+        const type cd01 = prefix ## _unpacklo_ps(c, d);                    \
+        const type ab23 = prefix ## _unpackhi_ps(a, b);                    \
+        const type cd23 = prefix ## _unpackhi_ps(c, d);                    \
+        a = prefix ## _shuffle_ps(ab01, cd01, _MM_SHUFFLE(1, 0, 1, 0));    \
+        b = prefix ## _shuffle_ps(ab01, cd01, _MM_SHUFFLE(3, 2, 3, 2));    \
+        c = prefix ## _shuffle_ps(ab23, cd23, _MM_SHUFFLE(1, 0, 1, 0));    \
+        d = prefix ## _shuffle_ps(ab23, cd23, _MM_SHUFFLE(3, 2, 3, 2));    \
+    }
+
+#ifdef MAGNUM_MATH_QUATERNIONBATCH_SSE2
+MAGNUM_MATH_QUATERNIONBATCH_DEFINE_OPERATIONS(__m128, _mm, )
+template<> inline __m128 splat<__m128>(Float a) { return _mm_set1_ps(a); }
+inline __m128 cmpge(__m128 a, __m128 b) { return _mm_cmpge_ps(a, b); }
+inline __m128 cmplt(__m128 a, __m128 b) { return _mm_cmplt_ps(a, b); }
+inline __m128 cmpneq(__m128 a, __m128 b) { return _mm_cmpneq_ps(a, b); }
+inline __m128 round(__m128 a) { return _mm_cvtepi32_ps(_mm_cvtps_epi32(a)); }
+#endif
+#ifdef MAGNUM_MATH_QUATERNIONBATCH_AVX
+MAGNUM_MATH_QUATERNIONBATCH_DEFINE_OPERATIONS(__m256, _mm256, MAGNUM_MATH_QUATERNIONBATCH_AVX_TARGET)
+template<> MAGNUM_MATH_QUATERNIONBATCH_AVX_TARGET inline __m256 splat<__m256>(Float a) { return _mm256_set1_ps(a); }
+MAGNUM_MATH_QUATERNIONBATCH_AVX_TARGET inline __m256 cmpge(__m256 a, __m256 b) { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+MAGNUM_MATH_QUATERNIONBATCH_AVX_TARGET inline __m256 cmplt(__m256 a, __m256 b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+MAGNUM_MATH_QUATERNIONBATCH_AVX_TARGET inline __m256 cmpneq(__m256 a, __m256 b) { return _mm256_cmp_ps(a, b, _CMP_NEQ_UQ); }
+MAGNUM_MATH_QUATERNIONBATCH_AVX_TARGET inline __m256 round(__m256 a) { return _mm256_round_ps(a, _MM_FROUND_TO_NEAREST_INT|_MM_FROUND_NO_EXC); }
+#endif
+
+#undef MAGNUM_MATH_QUATERNIONBATCH_DEFINE_OPERATIONS
+#endif
+
+#ifdef MAGNUM_MATH_QUATERNIONBATCH_SSE2
+inline void loadTransposed(const Corrade::Containers::StridedArrayView1D<const Quaternion<Float>>& data, const std::size_t i, __m128& x, __m128& y, __m128& z, __m128& w) {
+    x = _mm_loadu_ps(at(data, i + 0).data());
+    y = _mm_loadu_ps(at(data, i + 1).data());
+    z = _mm_loadu_ps(at(data, i + 2).data());
+    w = _mm_loadu_ps(at(data, i + 3).data());
+    transpose(x, y, z, w);
+}
+
+inline void storeTransposed(Float* const a, Float* const b, Float* const c, Float* const d, __m128 x, __m128 y, __m128 z, __m128 w) {
+    transpose(x, y, z, w);
+    _mm_storeu_ps(a, x);
+    _mm_storeu_ps(b, y);
+    _mm_storeu_ps(c, z);
+    _mm_storeu_ps(d, w);
+}
+
+inline void storeTransposed(const Corrade::Containers::StridedArrayView1D<Quaternion<Float>>& data, const std::size_t i, const __m128 x, const __m128 y, const __m128 z, const __m128 w) {
+    storeTransposed(at(data, i + 0).data(), at(data, i + 1).data(), at(data, i + 2).data(), at(data, i + 3).data(), x, y, z, w);
+}
+
+inline void storeTransposed(const Corrade::Containers::StridedArrayView1D<Matrix4<Float>>& data, const std::size_t i, const std::size_t column, const __m128 x, const __m128 y, const __m128 z, const __m128 w) {
+    storeTransposed(at(data, i + 0)[column].data(), at(data, i + 1)[column].data(), at(data, i + 2)[column].data(), at(data, i + 3)[column].data(), x, y, z, w);
+}
+
+inline __m128 loadScalars(const Corrade::Containers::StridedArrayView1D<const Float>& data, const std::size_t i, __m128) {
+    return _mm_setr_ps(at(data, i + 0), at(data, i + 1), at(data, i + 2), at(data, i + 3));
+}
+
+inline void loadComponents(const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& data, const std::size_t i, __m128& x, __m128& y, __m128& z) {
+    const Vector3<Float> &a = at(data, i + 0), &b = at(data, i + 1), &c = at(data, i + 2), &d = at(data, i + 3);
+    x = _mm_setr_ps(a.x(), b.x(), c.x(), d.x());
+    y = _mm_setr_ps(a.y(), b.y(), c.y(), d.y());
+    z = _mm_setr_ps(a.z(), b.z(), c.z(), d.z());
+}
+#endif
+
+#ifdef MAGNUM_MATH_QUATERNIONBATCH_AVX
+/* Items 0-3 go to the lower lane, 4-7 to the upper */
+MAGNUM_MATH_QUATERNIONBATCH_AVX_TARGET inline __m256 loadLanes(const Float* const lo, const Float* const hi) {
+    return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(lo)), _mm_loadu_ps(hi), 1);
+}
+
+MAGNUM_MATH_QUATERNIONBATCH_AVX_TARGET inline void storeLanes(Float* const lo, Float* const hi, const __m256 value) {
+    _mm_storeu_ps(lo, _mm256_castps256_ps128(value));
+    _mm_storeu_ps(hi, _mm256_extractf128_ps(value, 1));
+}
+
+MAGNUM_MATH_QUATERNIONBATCH_AVX_TARGET inline void loadTransposed(const Corrade::Containers::StridedArrayView1D<const Quaternion<Float>>& data, const std::size_t i, __m256& x, __m256& y, __m256& z, __m256& w) {
+    x = loadLanes(at(data, i + 0).data(), at(data, i + 4).data());
+    y = loadLanes(at(data, i + 1).data(), at(data, i + 5).data());
+    z = loadLanes(at(data, i + 2).data(), at(data, i + 6).data());
+    w = loadLanes(at(data, i + 3).data(), at(data, i + 7).data());
+    transpose(x, y, z, w);
+}
+
+MAGNUM_MATH_QUATERNIONBATCH_AVX_TARGET inline void storeTransposed(const Corrade::Containers::StridedArrayView1D<Quaternion<Float>>& data, const std::size_t i, __m256 x, __m256 y, __m256 z, __m256 w) {
+    transpose(x, y, z, w);
+    storeLanes(at(data, i + 0).data(), at(data, i + 4).data(), x);
+    storeLanes(at(data, i + 1).data(), at(data, i + 5).data(), y);
+    storeLanes(at(data, i + 2).data(), at(data, i + 6).data(), z);
+    storeLanes(at(data, i + 3).data(), at(data, i + 7).data(), w);
+}
+
+MAGNUM_MATH_QUATERNIONBATCH_AVX_TARGET inline void storeTransposed(const Corrade::Containers::StridedArrayView1D<Matrix4<Float>>& data, const std::size_t i, const std::size_t column, __m256 x, __m256 y, __m256 z, __m256 w) {
+    transpose(x, y, z, w);
+    storeLanes(at(data, i + 0)[column].data(), at(data, i + 4)[column].data(), x);
+    storeLanes(at(data, i + 1)[column].data(), at(data, i + 5)[column].data(), y);
+    storeLanes(at(data, i + 2)[column].data(), at(data, i + 6)[column].data(), z);
+    storeLanes(at(data, i + 3)[column].data(), at(data, i + 7)[column].data(), w);
+}
+
+MAGNUM_MATH_QUATERNIONBATCH_AVX_TARGET inline __m256 loadScalars(const Corrade::Containers::StridedArrayView1D<const Float>& data, const std::size_t i, __m256) {
+    return _mm256_setr_ps(at(data, i + 0), at(data, i + 1), at(data, i + 2), at(data, i + 3), at(data, i + 4), at(data, i + 5), at(data, i + 6), at(data, i + 7));
+}
+
+MAGNUM_MATH_QUATERNIONBATCH_AVX_TARGET inline void loadComponents(const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& data, const std::size_t i, __m256& x, __m256& y, __m256& z) {
+    Float xs[8], ys[8], zs[8];
+    for(std::size_t j = 0; j != 8; ++j) {
+        const Vector3<Float>& v = at(data, i + j);
+        xs[j] = v.x();
+        ys[j] = v.y();
+        zs[j] = v.z();
+    }
+    x = _mm256_loadu_ps(xs);
+    y = _mm256_loadu_ps(ys);
+    z = _mm256_loadu_ps(zs);
+}
+#endif
+
+#if defined(MAGNUM_MATH_QUATERNIONBATCH_SSE2) || defined(MAGNUM_MATH_QUATERNIONBATCH_AVX)
+/* The kernels are written just once using the above building blocks and then
+   expanded for each instruction set, as GCC and Clang don't allow AVX
+   intrinsics to be called from a template that isn't itself marked with the
+   AVX target. The arccos approximation is from Abramowitz & Stegun 4.4.46
+   with an absolute error below 2e-8, the sine is a degree 11 Taylor
+   polynomial after reducing the argument to [-pi/2, pi/2]. The entry points
+   get a distinct name per instruction set instead of being overloaded on a
+   vector type tag, as passing an AVX type by value from a function without
+   the AVX target would be an ABI mismatch. */
+#define MAGNUM_MATH_QUATERNIONBATCH_DEFINE_KERNELS(type, width, suffix, target) \
+    target inline type abs(type a) {                                        \
+        return bitXor(a, bitAnd(a, splat<type>(-0.0f)));                    \
+    }                                                                       \
+    target inline type acos(type a) {                                       \
+        const type absA = abs(a);                                           \
+        type p = splat<type>(-0.0012624911f);                               \
+        p = add(mul(p, absA), splat<type>(0.0066700901f));                  \
+        p = add(mul(p, absA), splat<type>(-0.0170881256f));                 \
+        p = add(mul(p, absA), splat<type>(0.0308918810f));                  \
+        p = add(mul(p, absA), splat<type>(-0.0501743046f));                 \
+        p = add(mul(p, absA), splat<type>(0.0889789874f));                  \
+        p = add(mul(p, absA), splat<type>(-0.2145988016f));                 \
+        p = add(mul(p, absA), splat<type>(1.5707963050f));                  \
+        const type out = mul(sqrt(sub(splat<type>(1.0f), absA)), p);        \
+        return select(cmplt(a, splat<type>(0.0f)), out,                     \
+            sub(splat<type>(Constants<Float>::pi()), out));                 \
+    }                                                                       \
+    target inline type sin(type a) {                                        \
+        /* a = k*pi + r, sin(a) = (-1)^k sin(r), pi split into two parts   \
+           to keep the precision */                                         \
+        const type k = round(mul(a, splat<type>(1.0f/Constants<Float>::pi()))); \
+        const type r = sub(sub(a, mul(k, splat<type>(3.140625f))),          \
+            mul(k, splat<type>(9.67653589793e-4f)));                        \
+        const type halfK = round(mul(k, splat<type>(0.5f)));                \
+        const type odd = cmpneq(k, add(halfK, halfK));                      \
+        const type r2 = mul(r, r);                                          \
+        type p = splat<type>(-1.0f/39916800.0f);                            \
+        p = add(mul(p, r2), splat<type>(1.0f/362880.0f));                   \
+        p = add(mul(p, r2), splat<type>(-1.0f/5040.0f));                    \
+        p = add(mul(p, r2), splat<type>(1.0f/120.0f));                      \
+        p = add(mul(p, r2), splat<type>(-1.0f/6.0f));                       \
+        const type out = add(r, mul(mul(r, r2), p));                        \
+        return bitXor(out, bitAnd(odd, splat<type>(-0.0f)));                \
+    }                                                                       \
+    target inline void interpolate(const Operation operation, type (&a)[4], const type (&b)[4], const type t) { \
+        const type one = splat<type>(1.0f);                                 \
+        const type d = add(add(mul(a[0], b[0]), mul(a[1], b[1])),           \
+                           add(mul(a[2], b[2]), mul(a[3], b[3])));          \
+        const bool shortestPath = operation == Operation::LerpShortestPath || \
+                                  operation == Operation::SlerpShortestPath; \
+        /* Flip the first quaternion if the second is on the other side */ \
+        const type flip = shortestPath ? bitAnd(d, splat<type>(-0.0f)) : splat<type>(0.0f); \
+                                                                            \
+        if(operation == Operation::Lerp || operation == Operation::LerpShortestPath) { \
+            const type oneMinusT = sub(one, t);                             \
+            for(std::size_t i = 0; i != 4; ++i)                             \
+                a[i] = add(mul(oneMinusT, bitXor(a[i], flip)), mul(t, b[i])); \
+            const type invLength = div(one, sqrt(add(                        \
+                add(mul(a[0], a[0]), mul(a[1], a[1])),                      \
+                add(mul(a[2], a[2]), mul(a[3], a[3])))));                   \
+            for(std::size_t i = 0; i != 4; ++i)                             \
+                a[i] = mul(a[i], invLength);                                \
+            return;                                                         \
+        }                                                                   \
+                                                                            \
+        /* The first quaternion is returned verbatim for (anti)parallel    \
+           quaternions to avoid division by zero, the same as in the       \
+           scalar variant */                                                \
+        const type parallel = cmpge(abs(d), splat<type>(1.0f - TypeTraits<Float>::epsilon())); \
+        const type angle = acos(shortestPath ? abs(d) : d);                 \
+        const type invSinAngle = div(one, sin(angle));                      \
+        const type weightA = mul(sin(mul(sub(one, t), angle)), invSinAngle); \
+        const type weightB = mul(sin(mul(t, angle)), invSinAngle);          \
+        for(std::size_t i = 0; i != 4; ++i)                                 \
+            a[i] = select(parallel,                                         \
+                add(mul(weightA, bitXor(a[i], flip)), mul(weightB, b[i])), a[i]); \
+    }                                                                       \
+    target std::size_t interpolateInto ## suffix(const Operation operation, const Corrade::Containers::StridedArrayView1D<const Quaternion<Float>>& normalizedA, const Corrade::Containers::StridedArrayView1D<const Quaternion<Float>>& normalizedB, const Corrade::Containers::StridedArrayView1D<const Float>& t, const Corrade::Containers::StridedArrayView1D<Quaternion<Float>>& out) { \
+        std::size_t i = 0;                                                  \
+        for(; i + width <= out.size(); i += width) {                        \
+            type a[4], b[4];                                                \
+            loadTransposed(normalizedA, i, a[0], a[1], a[2], a[3]);         \
+            loadTransposed(normalizedB, i, b[0], b[1], b[2], b[3]);         \
+            interpolate(operation, a, b, loadScalars(t, i, type{}));                \
+            storeTransposed(out, i, a[0], a[1], a[2], a[3]);                \
+        }                                                                   \
+        return i;                                                           \
+    }                                                                       \
+    target std::size_t transformationMatricesInto ## suffix(const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& translations, const Corrade::Containers::StridedArrayView1D<const Quaternion<Float>>& rotations, const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& scalings, const Corrade::Containers::StridedArrayView1D<Matrix4<Float>>& out) { \
+        const type zero = splat<type>(0.0f);                                \
+        const type one = splat<type>(1.0f);                                 \
+        const type two = splat<type>(2.0f);                                 \
+        std::size_t i = 0;                                                  \
+        for(; i + width <= out.size(); i += width) {                        \
+            type x, y, z, w, sx, sy, sz;                                    \
+            loadTransposed(rotations, i, x, y, z, w);                       \
+            loadComponents(scalings, i, sx, sy, sz);                        \
+                                                                            \
+            /* Same operations as in Quaternion::toMatrix() */              \
+            const type xx = mul(two, mul(x, x));                            \
+            const type yy = mul(two, mul(y, y));                            \
+            const type zz = mul(two, mul(z, z));                            \
+            const type xy = mul(two, mul(x, y));                            \
+            const type xz = mul(two, mul(x, z));                            \
+            const type yz = mul(two, mul(y, z));                            \
+            const type xw = mul(two, mul(x, w));                            \
+            const type yw = mul(two, mul(y, w));                            \
+            const type zw = mul(two, mul(z, w));                            \
+            storeTransposed(out, i, 0,                                      \
+                mul(sub(sub(one, yy), zz), sx),                             \
+                mul(add(xy, zw), sx),                                       \
+                mul(sub(xz, yw), sx), zero);                                \
+            storeTransposed(out, i, 1,                                      \
+                mul(sub(xy, zw), sy),                                       \
+                mul(sub(sub(one, xx), zz), sy),                             \
+                mul(add(yz, xw), sy), zero);                                \
+            storeTransposed(out, i, 2,                                      \
+                mul(add(xz, yw), sz),                                       \
+                mul(sub(yz, xw), sz),                                       \
+                mul(sub(sub(one, xx), yy), sz), zero);                      \
+            for(std::size_t j = 0; j != width; ++j)                         \
+                at(out, i + j)[3] = {at(translations, i + j), 1.0f};                \
+        }                                                                   \
+        return i;                                                           \
+    }
+
+#ifdef MAGNUM_MATH_QUATERNIONBATCH_SSE2
+MAGNUM_MATH_QUATERNIONBATCH_DEFINE_KERNELS(__m128, 4, Sse2, )
+#endif
+#ifdef MAGNUM_MATH_QUATERNIONBATCH_AVX
+MAGNUM_MATH_QUATERNIONBATCH_DEFINE_KERNELS(__m256, 8, Avx, MAGNUM_MATH_QUATERNIONBATCH_AVX_TARGET)
+#endif
+
+#undef MAGNUM_MATH_QUATERNIONBATCH_DEFINE_KERNELS
+#endif
+
+void interpolateInto(const Operation operation, const Corrade::Containers::StridedArrayView1D<const Quaternion<Float>>& normalizedA, const Corrade::Containers::StridedArrayView1D<const Quaternion<Float>>& normalizedB, const Corrade::Containers::StridedArrayView1D<const Float>& t, const Corrade::Containers::StridedArrayView1D<Quaternion<Float>>& out) {
+    std::size_t i = 0;
+    #if defined(MAGNUM_MATH_QUATERNIONBATCH_AVX_RUNTIME)
+    static const bool hasAvx = __builtin_cpu_supports("avx");
+    i = hasAvx ? interpolateIntoAvx(operation, normalizedA, normalizedB, t, out) :
+        interpolateIntoSse2(operation, normalizedA, normalizedB, t, out);
+    #elif defined(MAGNUM_MATH_QUATERNIONBATCH_AVX)
+    i = interpolateIntoAvx(operation, normalizedA, normalizedB, t, out);
+    #elif defined(MAGNUM_MATH_QUATERNIONBATCH_SSE2)
+    i = interpolateIntoSse2(operation, normalizedA, normalizedB, t, out);
+    #endif
+
+    /* Remaining items or everything if there's no SIMD */
+    for(; i != out.size(); ++i)
+        out[i] = interpolateScalar(operation, normalizedA[i], normalizedB[i], t[i]);
+}
+
+}
+
+void lerpInto(const Corrade::Containers::StridedArrayView1D<const Quaternion<Float>>& normalizedA, const Corrade::Containers::StridedArrayView1D<const Quaternion<Float>>& normalizedB, const Corrade::Containers::StridedArrayView1D<const Float>& t, const Corrade::Containers::StridedArrayView1D<Quaternion<Float>>& out) {
+    CORRADE_ASSERT(normalizedA.size() == out.size() && normalizedB.size() == out.size() && t.size() == out.size(),
+        "Math::lerpInto(): expected views of the same size but got" << normalizedA.size() << Corrade::Utility::Debug::nospace << "," << normalizedB.size() << Corrade::Utility::Debug::nospace << "," << t.size() << "and" << out.size(), );
+    interpolateInto(Operation::Lerp, normalizedA, normalizedB, t, out);
+}
+
+void lerpShortestPathInto(const Corrade::Containers::StridedArrayView1D<const Quaternion<Float>>& normalizedA, const Corrade::Containers::StridedArrayView1D<const Quaternion<Float>>& normalizedB, const Corrade::Containers::StridedArrayView1D<const Float>& t, const Corrade::Containers::StridedArrayView1D<Quaternion<Float>>& out) {
+    CORRADE_ASSERT(normalizedA.size() == out.size() && normalizedB.size() == out.size() && t.size() == out.size(),
+        "Math::lerpShortestPathInto(): expected views of the same size but got" << normalizedA.size() << Corrade::Utility::Debug::nospace << "," << normalizedB.size() << Corrade::Utility::Debug::nospace << "," << t.size() << "and" << out.size(), );
+    interpolateInto(Operation::LerpShortestPath, normalizedA, normalizedB, t, out);
+}
+
+void slerpInto(const Corrade::Containers::StridedArrayView1D<const Quaternion<Float>>& normalizedA, const Corrade::Containers::StridedArrayView1D<const Quaternion<Float>>& normalizedB, const Corrade::Containers::StridedArrayView1D<const Float>& t, const Corrade::Containers::StridedArrayView1D<Quaternion<Float>>& out) {
+    CORRADE_ASSERT(normalizedA.size() == out.size() && normalizedB.size() == out.size() && t.size() == out.size(),
+        "Math::slerpInto(): expected views of the same size but got" << normalizedA.size() << Corrade::Utility::Debug::nospace << "," << normalizedB.size() << Corrade::Utility::Debug::nospace << "," << t.size() << "and" << out.size(), );
+    interpolateInto(Operation::Slerp, normalizedA, normalizedB, t, out);
+}
+
+void slerpShortestPathInto(const Corrade::Containers::StridedArrayView1D<const Quaternion<Float>>& normalizedA, const Corrade::Containers::StridedArrayView1D<const Quaternion<Float>>& normalizedB, const Corrade::Containers::StridedArrayView1D<const Float>& t, const Corrade::Containers::StridedArrayView1D<Quaternion<Float>>& out) {
+    CORRADE_ASSERT(normalizedA.size() == out.size() && normalizedB.size() == out.size() && t.size() == out.size(),
+        "Math::slerpShortestPathInto(): expected views of the same size but got" << normalizedA.size() << Corrade::Utility::Debug::nospace << "," << normalizedB.size() << Corrade::Utility::Debug::nospace << "," << t.size() << "and" << out.size(), );
+    interpolateInto(Operation::SlerpShortestPath, normalizedA, normalizedB, t, out);
+}
+
+void transformationMatricesInto(const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& translations, const Corrade::Containers::StridedArrayView1D<const Quaternion<Float>>& rotations, const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& scalings, const Corrade::Containers::StridedArrayView1D<Matrix4<Float>>& out) {
+    CORRADE_ASSERT(translations.size() == out.size() && rotations.size() == out.size() && scalings.size() == out.size(),
+        "Math::transformationMatricesInto(): expected views of the same size but got" << translations.size() << Corrade::Utility::Debug::nospace << "," << rotations.size() << Corrade::Utility::Debug::nospace << "," << scalings.size() << "and" << out.size(), );
+
+    std::size_t i = 0;
+    #if defined(MAGNUM_MATH_QUATERNIONBATCH_AVX_RUNTIME)
+    static const bool hasAvx = __builtin_cpu_supports("avx");
+    i = hasAvx ? transformationMatricesIntoAvx(translations, rotations, scalings, out) :
+        transformationMatricesIntoSse2(translations, rotations, scalings, out);
+    #elif defined(MAGNUM_MATH_QUATERNIONBATCH_AVX)
+    i = transformationMatricesIntoAvx(translations, rotations, scalings, out);
+    #elif defined(MAGNUM_MATH_QUATERNIONBATCH_SSE2)
+    i = transformationMatricesIntoSse2(translations, rotations, scalings, out);
+    #endif
+
+    /* Remaining items or everything if there's no SIMD */
+    for(; i != out.size(); ++i)
+        out[i] = transformationScalar(translations[i], rotations[i], scalings[i]);
+}
+
+}}
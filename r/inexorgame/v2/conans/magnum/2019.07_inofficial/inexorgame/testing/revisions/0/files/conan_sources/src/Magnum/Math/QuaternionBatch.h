@@ -0,0 +1,116 @@
+#ifndef Magnum_Math_QuaternionBatch_h
+#define Magnum_Math_QuaternionBatch_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::Math::lerpInto(), @ref Magnum::Math::lerpShortestPathInto(), @ref Magnum::Math::slerpInto(), @ref Magnum::Math::slerpShortestPathInto(), @ref Magnum::Math::transformationMatricesInto()
+ */
+
+#include <Corrade/Containers/StridedArrayView.h>
+
+#include "Magnum/Types.h"
+#include "Magnum/visibility.h"
+#include "Magnum/Math/Math.h"
+
+namespace Magnum { namespace Math {
+
+/**
+@{ @name Batch quaternion functions
+
+These functions process whole ranges of quaternions at once. The data are
+transposed from the usual interleaved layout to separate X, Y, Z and W
+registers and processed four or eight at a time using SSE2 or AVX, whichever
+is available. On x86 with GCC and Clang the AVX variant is picked at runtime
+based on CPU capabilities even if the library isn't compiled with AVX enabled.
+Items that don't fill a whole register and all items on platforms without SIMD
+support are processed using the scalar functions. Unlike the scalar variants,
+the inputs are not checked for being normalized.
+*/
+
+/**
+@brief Linear interpolation of quaternion ranges
+@param[in] normalizedA  First quaternions
+@param[in] normalizedB  Second quaternions
+@param[in] t            Interpolation phases
+@param[out] out         Where to put the interpolated quaternions
+
+Batch variant of @ref lerp(const Quaternion<T>&, const Quaternion<T>&, T),
+expects that all views have the same size. The result is the same as with the
+scalar function up to floating-point precision.
+*/
+MAGNUM_EXPORT void lerpInto(const Corrade::Containers::StridedArrayView1D<const Quaternion<Float>>& normalizedA, const Corrade::Containers::StridedArrayView1D<const Quaternion<Float>>& normalizedB, const Corrade::Containers::StridedArrayView1D<const Float>& t, const Corrade::Containers::StridedArrayView1D<Quaternion<Float>>& out);
+
+/**
+@brief Linear shortest-path interpolation of quaternion ranges
+
+Batch variant of @ref lerpShortestPath(const Quaternion<T>&, const Quaternion<T>&, T),
+see @ref lerpInto() for more information.
+*/
+MAGNUM_EXPORT void lerpShortestPathInto(const Corrade::Containers::StridedArrayView1D<const Quaternion<Float>>& normalizedA, const Corrade::Containers::StridedArrayView1D<const Quaternion<Float>>& normalizedB, const Corrade::Containers::StridedArrayView1D<const Float>& t, const Corrade::Containers::StridedArrayView1D<Quaternion<Float>>& out);
+
+/**
+@brief Spherical linear interpolation of quaternion ranges
+
+Batch variant of @ref slerp(const Quaternion<T>&, const Quaternion<T>&, T),
+expects that all views have the same size. The SIMD variants use polynomial
+approximations of @f$ \arccos @f$ and @f$ \sin @f$, the result differs from
+the scalar function by less than @cpp 1.0e-6f @ce. An exception are nearly
+opposite quaternions, where the calculation is ill-conditioned in both cases
+and the difference can reach @cpp 1.0e-4f @ce. That doesn't happen with
+@ref slerpShortestPathInto().
+*/
+MAGNUM_EXPORT void slerpInto(const Corrade::Containers::StridedArrayView1D<const Quaternion<Float>>& normalizedA, const Corrade::Containers::StridedArrayView1D<const Quaternion<Float>>& normalizedB, const Corrade::Containers::StridedArrayView1D<const Float>& t, const Corrade::Containers::StridedArrayView1D<Quaternion<Float>>& out);
+
+/**
+@brief Spherical linear shortest-path interpolation of quaternion ranges
+
+Batch variant of @ref slerpShortestPath(const Quaternion<T>&, const Quaternion<T>&, T),
+see @ref slerpInto() for more information.
+*/
+MAGNUM_EXPORT void slerpShortestPathInto(const Corrade::Containers::StridedArrayView1D<const Quaternion<Float>>& normalizedA, const Corrade::Containers::StridedArrayView1D<const Quaternion<Float>>& normalizedB, const Corrade::Containers::StridedArrayView1D<const Float>& t, const Corrade::Containers::StridedArrayView1D<Quaternion<Float>>& out);
+
+/**
+@brief Create transformation matrices from translation, rotation and scaling ranges
+@param[in] translations Translations
+@param[in] rotations    Rotations
+@param[in] scalings     Scalings
+@param[out] out         Where to put the transformation matrices
+
+Equivalent to the following for each item, expects that all views have the
+same size:
+
+@code{.cpp}
+out[i] = Matrix4::from(rotations[i].toMatrix(), translations[i])*
+    Matrix4::scaling(scalings[i]);
+@endcode
+*/
+MAGNUM_EXPORT void transformationMatricesInto(const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& translations, const Corrade::Containers::StridedArrayView1D<const Quaternion<Float>>& rotations, const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& scalings, const Corrade::Containers::StridedArrayView1D<Matrix4<Float>>& out);
+
+/*@}*/
+
+}}
+
+#endif
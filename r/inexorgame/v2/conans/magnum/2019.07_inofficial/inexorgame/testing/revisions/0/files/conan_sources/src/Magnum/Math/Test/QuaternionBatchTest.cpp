@@ -0,0 +1,291 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <vector>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/ArrayViewStl.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/Quaternion.h"
+#include "Magnum/Math/QuaternionBatch.h"
+
+namespace Magnum { namespace Math { namespace Test { namespace {
+
+struct QuaternionBatchTest: Corrade::TestSuite::Tester {
+    explicit QuaternionBatchTest();
+
+    void lerp();
+    void lerpShortestPath();
+    void slerp();
+    void slerpShortestPath();
+    void transformationMatrices();
+
+    void slerpSame();
+    void slerpNearlyOpposite();
+    void strided();
+};
+
+typedef Math::Quaternion<Float> Quaternion;
+typedef Math::Vector3<Float> Vector3;
+typedef Math::Matrix4<Float> Matrix4;
+typedef Math::Rad<Float> Rad;
+
+/* Sizes that exercise both full SSE2 and AVX registers as well as the scalar
+   remainder */
+const struct {
+    const char* name;
+    std::size_t size;
+} SizeData[]{
+    {"one", 1},
+    {"three", 3},
+    {"one SSE2 register", 4},
+    {"seven", 7},
+    {"one AVX register", 8},
+    {"thirteen", 13},
+    {"hundred", 100}
+};
+
+QuaternionBatchTest::QuaternionBatchTest() {
+    addInstancedTests({&QuaternionBatchTest::lerp,
+                       &QuaternionBatchTest::lerpShortestPath,
+                       &QuaternionBatchTest::slerp,
+                       &QuaternionBatchTest::slerpShortestPath,
+                       &QuaternionBatchTest::transformationMatrices},
+        Corrade::Containers::arraySize(SizeData));
+
+    addTests({&QuaternionBatchTest::slerpSame,
+              &QuaternionBatchTest::slerpNearlyOpposite,
+              &QuaternionBatchTest::strided});
+}
+
+/* Deterministic set of normalized quaternions in all directions, with every
+   other pair being more than 90° apart to test the shortest path
+   variants */
+struct Data {
+    explicit Data(const std::size_t size): a{Corrade::Containers::NoInit, size}, b{Corrade::Containers::NoInit, size}, t{Corrade::Containers::NoInit, size}, out{Corrade::Containers::NoInit, size} {
+        for(std::size_t i = 0; i != size; ++i) {
+            a[i] = Quaternion::rotation(Rad(0.7f*i - 2.0f),
+                Vector3{std::sin(1.0f*i), std::cos(1.3f*i), 0.5f}.normalized());
+            b[i] = Quaternion::rotation(Rad(1.1f*i + 0.3f),
+                Vector3{0.25f, std::sin(0.9f*i), std::cos(0.4f*i)}.normalized());
+            if(i % 2) b[i] = -b[i];
+            t[i] = (i % 11)/10.0f;
+        }
+    }
+
+    Corrade::Containers::Array<Quaternion> a, b;
+    Corrade::Containers::Array<Float> t;
+    Corrade::Containers::Array<Quaternion> out;
+};
+
+Float maxDifference(const Corrade::Containers::ArrayView<const Quaternion> actual, const Corrade::Containers::ArrayView<const Quaternion> expected) {
+    CORRADE_INTERNAL_ASSERT(actual.size() == expected.size());
+
+    Float maxDifference = 0.0f;
+    for(std::size_t i = 0; i != actual.size(); ++i) {
+        const Quaternion difference = actual[i] - expected[i];
+        maxDifference = Math::max(maxDifference,
+            Math::max(Math::abs(difference.vector()).max(),
+                      std::abs(difference.scalar())));
+    }
+    return maxDifference;
+}
+
+void QuaternionBatchTest::lerp() {
+    auto&& data = SizeData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Data d{data.size};
+    Corrade::Containers::Array<Quaternion> expected{Corrade::Containers::NoInit, data.size};
+    for(std::size_t i = 0; i != data.size; ++i)
+        expected[i] = Math::lerp(d.a[i], d.b[i], d.t[i]);
+
+    lerpInto(d.a, d.b, d.t, d.out);
+    CORRADE_COMPARE_AS(maxDifference(d.out, expected), 1.0e-6f,
+        Corrade::TestSuite::Compare::LessOrEqual);
+}
+
+void QuaternionBatchTest::lerpShortestPath() {
+    auto&& data = SizeData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Data d{data.size};
+    Corrade::Containers::Array<Quaternion> expected{Corrade::Containers::NoInit, data.size};
+    for(std::size_t i = 0; i != data.size; ++i)
+        expected[i] = Math::lerpShortestPath(d.a[i], d.b[i], d.t[i]);
+
+    lerpShortestPathInto(d.a, d.b, d.t, d.out);
+    CORRADE_COMPARE_AS(maxDifference(d.out, expected), 1.0e-6f,
+        Corrade::TestSuite::Compare::LessOrEqual);
+}
+
+void QuaternionBatchTest::slerp() {
+    auto&& data = SizeData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Data d{data.size};
+    Corrade::Containers::Array<Quaternion> expected{Corrade::Containers::NoInit, data.size};
+    for(std::size_t i = 0; i != data.size; ++i)
+        expected[i] = Math::slerp(d.a[i], d.b[i], d.t[i]);
+
+    slerpInto(d.a, d.b, d.t, d.out);
+
+    /* Nearly opposite quaternions are ill-conditioned and have a larger
+       documented difference, verify them separately */
+    std::vector<Quaternion> actualRegular, expectedRegular,
+        actualOpposite, expectedOpposite;
+    for(std::size_t i = 0; i != data.size; ++i) {
+        const bool opposite = Math::dot(d.a[i], d.b[i]) < -0.95f;
+        (opposite ? actualOpposite : actualRegular).push_back(d.out[i]);
+        (opposite ? expectedOpposite : expectedRegular).push_back(expected[i]);
+    }
+    CORRADE_COMPARE_AS(maxDifference(actualRegular, expectedRegular), 1.0e-6f,
+        Corrade::TestSuite::Compare::LessOrEqual);
+    CORRADE_COMPARE_AS(maxDifference(actualOpposite, expectedOpposite), 1.0e-4f,
+        Corrade::TestSuite::Compare::LessOrEqual);
+}
+
+void QuaternionBatchTest::slerpShortestPath() {
+    auto&& data = SizeData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Data d{data.size};
+    Corrade::Containers::Array<Quaternion> expected{Corrade::Containers::NoInit, data.size};
+    for(std::size_t i = 0; i != data.size; ++i)
+        expected[i] = Math::slerpShortestPath(d.a[i], d.b[i], d.t[i]);
+
+    slerpShortestPathInto(d.a, d.b, d.t, d.out);
+    CORRADE_COMPARE_AS(maxDifference(d.out, expected), 1.0e-6f,
+        Corrade::TestSuite::Compare::LessOrEqual);
+}
+
+void QuaternionBatchTest::transformationMatrices() {
+    auto&& data = SizeData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Data d{data.size};
+    Corrade::Containers::Array<Vector3> translations{Corrade::Containers::NoInit, data.size};
+    Corrade::Containers::Array<Vector3> scalings{Corrade::Containers::NoInit, data.size};
+    Corrade::Containers::Array<Matrix4> out{Corrade::Containers::NoInit, data.size};
+    for(std::size_t i = 0; i != data.size; ++i) {
+        translations[i] = {1.0f*i, -2.0f, 0.5f*i};
+        scalings[i] = {1.0f + 0.1f*i, 2.0f, 0.5f};
+    }
+
+    transformationMatricesInto(translations, d.a, scalings, out);
+    for(std::size_t i = 0; i != data.size; ++i)
+        CORRADE_COMPARE(out[i], Matrix4::from(d.a[i].toMatrix(), translations[i])*Matrix4::scaling(scalings[i]));
+}
+
+void QuaternionBatchTest::slerpSame() {
+    /* The SIMD kernels have to return the first argument for (nearly) equal
+       and opposite quaternions the same way as the scalar variant instead of
+       dividing by zero */
+    Data d{8};
+    for(std::size_t i = 0; i != 8; ++i)
+        d.b[i] = i % 2 ? -d.a[i] : d.a[i];
+
+    Corrade::Containers::Array<Quaternion> expected{Corrade::Containers::NoInit, 8};
+    for(std::size_t i = 0; i != 8; ++i)
+        expected[i] = Math::slerp(d.a[i], d.b[i], d.t[i]);
+    slerpInto(d.a, d.b, d.t, d.out);
+    CORRADE_COMPARE_AS(maxDifference(d.out, expected), 1.0e-6f,
+        Corrade::TestSuite::Compare::LessOrEqual);
+
+    for(std::size_t i = 0; i != 8; ++i)
+        expected[i] = Math::slerpShortestPath(d.a[i], d.b[i], d.t[i]);
+    slerpShortestPathInto(d.a, d.b, d.t, d.out);
+    CORRADE_COMPARE_AS(maxDifference(d.out, expected), 1.0e-6f,
+        Corrade::TestSuite::Compare::LessOrEqual);
+}
+
+void QuaternionBatchTest::slerpNearlyOpposite() {
+    /* Ill-conditioned in both the scalar and SIMD variant, the documented
+       difference is larger */
+    Data d{8};
+    for(std::size_t i = 0; i != 8; ++i)
+        d.b[i] = -(d.a[i]*Quaternion::rotation(Rad(0.01f + 0.005f*i), Vector3::xAxis()));
+
+    Corrade::Containers::Array<Quaternion> expected{Corrade::Containers::NoInit, 8};
+    for(std::size_t i = 0; i != 8; ++i)
+        expected[i] = Math::slerp(d.a[i], d.b[i], d.t[i]);
+    slerpInto(d.a, d.b, d.t, d.out);
+    CORRADE_COMPARE_AS(maxDifference(d.out, expected), 1.0e-4f,
+        Corrade::TestSuite::Compare::LessOrEqual);
+
+    /* The shortest path variant isn't affected */
+    for(std::size_t i = 0; i != 8; ++i)
+        expected[i] = Math::slerpShortestPath(d.a[i], d.b[i], d.t[i]);
+    slerpShortestPathInto(d.a, d.b, d.t, d.out);
+    CORRADE_COMPARE_AS(maxDifference(d.out, expected), 1.0e-6f,
+        Corrade::TestSuite::Compare::LessOrEqual);
+}
+
+void QuaternionBatchTest::strided() {
+    struct Item {
+        Quaternion a;
+        Float t;
+        Quaternion b;
+        Quaternion out;
+    };
+
+    Data d{13};
+    Item items[13];
+    for(std::size_t i = 0; i != 13; ++i) {
+        items[i].a = d.a[i];
+        items[i].b = d.b[i];
+        items[i].t = d.t[i];
+        items[i].out = Quaternion{Vector3{1337.0f}, 1337.0f};
+    }
+
+    Corrade::Containers::Array<Quaternion> expected{Corrade::Containers::NoInit, 13};
+    for(std::size_t i = 0; i != 13; ++i)
+        expected[i] = Math::slerpShortestPath(d.a[i], d.b[i], d.t[i]);
+
+    const Corrade::Containers::ArrayView<Item> view = items;
+    slerpShortestPathInto(
+        {view, &items[0].a, 13, sizeof(Item)},
+        {view, &items[0].b, 13, sizeof(Item)},
+        {view, &items[0].t, 13, sizeof(Item)},
+        {view, &items[0].out, 13, sizeof(Item)});
+
+    for(std::size_t i = 0; i != 13; ++i) d.out[i] = items[i].out;
+    CORRADE_COMPARE_AS(maxDifference(d.out, expected), 1.0e-6f,
+        Corrade::TestSuite::Compare::LessOrEqual);
+
+    /* The inputs are left untouched */
+    for(std::size_t i = 0; i != 13; ++i) {
+        CORRADE_COMPARE(items[i].a, d.a[i]);
+        CORRADE_COMPARE(items[i].b, d.b[i]);
+        CORRADE_COMPARE(items[i].t, d.t[i]);
+    }
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Math::Test::QuaternionBatchTest)
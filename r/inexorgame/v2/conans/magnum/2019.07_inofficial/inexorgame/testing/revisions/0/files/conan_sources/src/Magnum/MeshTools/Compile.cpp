@@ -36,6 +36,7 @@
 #include "Magnum/MeshTools/GenerateNormals.h"
 #include "Magnum/MeshTools/Duplicate.h"
 #include "Magnum/MeshTools/Interleave.h"
+#include "Magnum/MeshTools/Pack.h"
 #include "Magnum/Trade/MeshData2D.h"
 #include "Magnum/Trade/MeshData3D.h"
 
@@ -280,6 +281,39 @@ GL::Mesh compile(const Trade::MeshData3D& meshData, CompileFlags flags) {
     return mesh;
 }
 
+GL::Mesh compilePacked(const Trade::MeshData3D& meshData, Matrix4& positionTransformation, const PackedNormalFormat normalFormat, const PackedTextureCoordinateFormat textureCoordinateFormat) {
+    GL::Mesh mesh;
+    mesh.setPrimitive(meshData.primitive());
+
+    PackedVertexData3D packed = packVertices(meshData, normalFormat, textureCoordinateFormat);
+    positionTransformation = packed.positionTransformation;
+
+    /* Fill vertex buffer with the packed data and add all attributes, the
+       last one taking over the ownership */
+    GL::Buffer vertexBuffer{GL::Buffer::TargetHint::Array};
+    vertexBuffer.setData(packed.data, GL::BufferUsage::StaticDraw);
+    for(std::size_t i = 0; i + 1 < packed.attributes.size(); ++i)
+        mesh.addVertexBuffer(vertexBuffer, packed.attributes[i].first, packed.stride, packed.attributes[i].second);
+    mesh.addVertexBuffer(std::move(vertexBuffer), packed.attributes.back().first, packed.stride, packed.attributes.back().second);
+
+    /* If indexed, fill index buffer and configure indexed mesh */
+    if(meshData.isIndexed()) {
+        Containers::Array<char> indexData;
+        MeshIndexType indexType;
+        UnsignedInt indexStart, indexEnd;
+        std::tie(indexData, indexType, indexStart, indexEnd) = MeshTools::compressIndices(meshData.indices());
+
+        GL::Buffer indexBuffer{GL::Buffer::TargetHint::ElementArray};
+        indexBuffer.setData(indexData, GL::BufferUsage::StaticDraw);
+        mesh.setCount(meshData.indices().size())
+            .setIndexBuffer(std::move(indexBuffer), 0, indexType, indexStart, indexEnd);
+
+    /* Else set vertex count */
+    } else mesh.setCount(meshData.positions(0).size());
+
+    return mesh;
+}
+
 #ifdef MAGNUM_BUILD_DEPRECATED
 std::tuple<GL::Mesh, std::unique_ptr<GL::Buffer>, std::unique_ptr<GL::Buffer>> compile(const Trade::MeshData3D& meshData, GL::BufferUsage) {
     return std::make_tuple(compile(meshData),
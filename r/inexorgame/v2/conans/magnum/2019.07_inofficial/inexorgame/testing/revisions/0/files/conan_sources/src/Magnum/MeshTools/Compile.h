@@ -26,7 +26,7 @@
 */
 
 /** @file
- * @brief Function @ref Magnum::MeshTools::compile()
+ * @brief Function @ref Magnum::MeshTools::compile(), @ref Magnum::MeshTools::compilePacked()
  */
 
 #include "Magnum/configure.h"
@@ -37,6 +37,7 @@
 #include "Magnum/Magnum.h"
 #include "Magnum/GL/GL.h"
 #include "Magnum/Trade/Trade.h"
+#include "Magnum/MeshTools/Pack.h"
 #include "Magnum/MeshTools/visibility.h"
 
 #ifdef MAGNUM_BUILD_DEPRECATED
@@ -151,6 +152,42 @@ MAGNUM_MESHTOOLS_EXPORT GL::Mesh compile(const Trade::MeshData3D& meshData, Comp
 CORRADE_DEPRECATED("use compile(const Trade::MeshData3D&) instead") MAGNUM_MESHTOOLS_EXPORT std::tuple<GL::Mesh, std::unique_ptr<GL::Buffer>, std::unique_ptr<GL::Buffer>> compile(const Trade::MeshData3D& meshData, GL::BufferUsage usage);
 #endif
 
+/**
+@brief Compile 3D mesh data with quantized vertex attributes
+@param[in] meshData                 Mesh data
+@param[out] positionTransformation  Transformation converting the packed
+    positions back to the original space
+@param[in] normalFormat             Packed normal format
+@param[in] textureCoordinateFormat  Packed texture coordinate format
+
+Like @ref compile(const Trade::MeshData3D&, CompileFlags), but packs the
+vertex data using @ref packVertices() first, resulting in less than half of
+the vertex memory. The attributes are bound to the same
+@ref Shaders::Generic3D attributes, the positions however need the
+@p positionTransformation multiplied into the transformation matrix passed to
+the shader. With @ref PackedNormalFormat::Octahedral the shader needs to
+decode the normals itself, see @ref packNormalsOctahedralInto() for details.
+
+@note This function is available only if Magnum is compiled with
+    @ref MAGNUM_TARGET_GL enabled (done by default). See @ref building-features
+    for more information.
+
+@see @ref shaders-generic
+*/
+MAGNUM_MESHTOOLS_EXPORT GL::Mesh compilePacked(const Trade::MeshData3D& meshData, Matrix4& positionTransformation, PackedNormalFormat normalFormat =
+    #ifndef MAGNUM_TARGET_GLES2
+    PackedNormalFormat::Int2101010Rev
+    #else
+    PackedNormalFormat::Byte
+    #endif
+    , PackedTextureCoordinateFormat textureCoordinateFormat =
+    #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+    PackedTextureCoordinateFormat::Half
+    #else
+    PackedTextureCoordinateFormat::UnsignedShortNormalized
+    #endif
+    );
+
 }}
 #else
 #error this header is available only in the OpenGL build
@@ -31,11 +31,99 @@
 
 #include "Magnum/Math/FunctionsBatch.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MAGNUM_MESHTOOLS_COMPRESSINDICES_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define MAGNUM_MESHTOOLS_COMPRESSINDICES_NEON
+#endif
+
 namespace Magnum { namespace MeshTools {
 
 namespace {
 
-template<class T> inline Containers::Array<char> compress(const std::vector<UnsignedInt>& indices) {
+/* Min and max of given indices, the first value when empty. Contiguous views
+   are processed eight values at a time, with two independent accumulators
+   to hide latency. SSE2 doesn't have unsigned 32-bit min/max, so the values
+   are offset to signed range and selected with a signed comparison. The scan
+   is memory-bound, so wider instruction sets wouldn't help much. */
+std::pair<UnsignedInt, UnsignedInt> minmax(const Containers::StridedArrayView1D<const UnsignedInt>& indices) {
+    if(indices.empty()) return {};
+
+    UnsignedInt min = indices[0], max = indices[0];
+    std::size_t i = 0;
+    if(indices.stride() == sizeof(UnsignedInt)) {
+        const UnsignedInt* const data = &indices[0];
+        const std::size_t end = indices.size() & ~std::size_t{7};
+        #if defined(MAGNUM_MESHTOOLS_COMPRESSINDICES_SSE2)
+        if(end) {
+            const __m128i bias = _mm_set1_epi32(Int(0x80000000u));
+            __m128i min0 = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data)), bias);
+            __m128i max0 = min0;
+            __m128i min1 = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 4)), bias);
+            __m128i max1 = min1;
+            for(i = 8; i != end; i += 8) {
+                const __m128i a = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)), bias);
+                const __m128i b = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + 4)), bias);
+                const __m128i aLess = _mm_cmplt_epi32(a, min0);
+                const __m128i bLess = _mm_cmplt_epi32(b, min1);
+                const __m128i aGreater = _mm_cmpgt_epi32(a, max0);
+                const __m128i bGreater = _mm_cmpgt_epi32(b, max1);
+                min0 = _mm_or_si128(_mm_and_si128(aLess, a), _mm_andnot_si128(aLess, min0));
+                min1 = _mm_or_si128(_mm_and_si128(bLess, b), _mm_andnot_si128(bLess, min1));
+                max0 = _mm_or_si128(_mm_and_si128(aGreater, a), _mm_andnot_si128(aGreater, max0));
+                max1 = _mm_or_si128(_mm_and_si128(bGreater, b), _mm_andnot_si128(bGreater, max1));
+            }
+            alignas(16) UnsignedInt mins[8], maxs[8];
+            _mm_store_si128(reinterpret_cast<__m128i*>(mins), _mm_xor_si128(min0, bias));
+            _mm_store_si128(reinterpret_cast<__m128i*>(mins + 4), _mm_xor_si128(min1, bias));
+            _mm_store_si128(reinterpret_cast<__m128i*>(maxs), _mm_xor_si128(max0, bias));
+            _mm_store_si128(reinterpret_cast<__m128i*>(maxs + 4), _mm_xor_si128(max1, bias));
+            for(std::size_t j = 0; j != 8; ++j) {
+                min = Math::min(min, mins[j]);
+                max = Math::max(max, maxs[j]);
+            }
+        }
+        #elif defined(MAGNUM_MESHTOOLS_COMPRESSINDICES_NEON)
+        if(end) {
+            uint32x4_t min0 = vld1q_u32(data), max0 = min0;
+            uint32x4_t min1 = vld1q_u32(data + 4), max1 = min1;
+            for(i = 8; i != end; i += 8) {
+                const uint32x4_t a = vld1q_u32(data + i);
+                const uint32x4_t b = vld1q_u32(data + i + 4);
+                min0 = vminq_u32(min0, a);
+                min1 = vminq_u32(min1, b);
+                max0 = vmaxq_u32(max0, a);
+                max1 = vmaxq_u32(max1, b);
+            }
+            UnsignedInt mins[8], maxs[8];
+            vst1q_u32(mins, min0);
+            vst1q_u32(mins + 4, min1);
+            vst1q_u32(maxs, max0);
+            vst1q_u32(maxs + 4, max1);
+            for(std::size_t j = 0; j != 8; ++j) {
+                min = Math::min(min, mins[j]);
+                max = Math::max(max, maxs[j]);
+            }
+        }
+        #else
+        static_cast<void>(data);
+        static_cast<void>(end);
+        #endif
+    }
+
+    /* Remaining items or everything if there's no SIMD or the view is not
+       contiguous */
+    for(; i != indices.size(); ++i) {
+        min = Math::min(min, indices[i]);
+        max = Math::max(max, indices[i]);
+    }
+
+    return {min, max};
+}
+
+template<class T> inline Containers::Array<char> compress(const Containers::StridedArrayView1D<const UnsignedInt>& indices) {
     Containers::Array<char> buffer(indices.size()*sizeof(T));
     for(std::size_t i = 0; i != indices.size(); ++i) {
         T index = static_cast<T>(indices[i]);
@@ -48,8 +136,11 @@ template<class T> inline Containers::Array<char> compress(const std::vector<Unsi
 }
 
 std::tuple<Containers::Array<char>, MeshIndexType, UnsignedInt, UnsignedInt> compressIndices(const std::vector<UnsignedInt>& indices) {
-    /** @todo Performance hint when range can be represented by smaller value? */
-    const auto minmax = Math::minmax<UnsignedInt>(indices);
+    return compressIndices(Containers::stridedArrayView(indices));
+}
+
+std::tuple<Containers::Array<char>, MeshIndexType, UnsignedInt, UnsignedInt> compressIndices(const Containers::StridedArrayView1D<const UnsignedInt>& indices) {
+    const auto minmax = MeshTools::minmax(indices);
     Containers::Array<char> data;
     MeshIndexType type;
     switch(Math::log(256, minmax.second)) {
@@ -75,8 +166,12 @@ std::tuple<Containers::Array<char>, MeshIndexType, UnsignedInt, UnsignedInt> com
 }
 
 template<class T> Containers::Array<T> compressIndicesAs(const std::vector<UnsignedInt>& indices) {
+    return compressIndicesAs<T>(Containers::stridedArrayView(indices));
+}
+
+template<class T> Containers::Array<T> compressIndicesAs(const Containers::StridedArrayView1D<const UnsignedInt>& indices) {
     #if !defined(CORRADE_NO_ASSERT) || defined(CORRADE_GRACEFUL_ASSERT)
-    const auto max = Math::max<UnsignedInt>(indices);
+    const UnsignedInt max = minmax(indices).second;
     CORRADE_ASSERT(Math::log(256, max) < sizeof(T), "MeshTools::compressIndicesAs(): type too small to represent value" << max, {});
     #endif
 
@@ -90,5 +185,73 @@ template<class T> Containers::Array<T> compressIndicesAs(const std::vector<Unsig
 template Containers::Array<UnsignedByte> compressIndicesAs(const std::vector<UnsignedInt>&);
 template Containers::Array<UnsignedShort> compressIndicesAs(const std::vector<UnsignedInt>&);
 template Containers::Array<UnsignedInt> compressIndicesAs(const std::vector<UnsignedInt>&);
+template Containers::Array<UnsignedByte> compressIndicesAs(const Containers::StridedArrayView1D<const UnsignedInt>&);
+template Containers::Array<UnsignedShort> compressIndicesAs(const Containers::StridedArrayView1D<const UnsignedInt>&);
+template Containers::Array<UnsignedInt> compressIndicesAs(const Containers::StridedArrayView1D<const UnsignedInt>&);
+
+std::pair<Containers::Array<UnsignedShort>, std::vector<CompressedIndexRange>> compressIndicesSplit(const Containers::StridedArrayView1D<const UnsignedInt>& indices, const MeshPrimitive primitive) {
+    std::size_t primitiveSize{};
+    switch(primitive) {
+        case MeshPrimitive::Points: primitiveSize = 1; break;
+        case MeshPrimitive::Lines: primitiveSize = 2; break;
+        case MeshPrimitive::Triangles: primitiveSize = 3; break;
+        default:
+            CORRADE_ASSERT(false,
+                "MeshTools::compressIndicesSplit(): unsupported primitive" << primitive, {});
+            /* Not reached with asserts enabled, but primitiveSize would be
+               zero below otherwise */
+            return {};
+    }
+    CORRADE_ASSERT(indices.size() % primitiveSize == 0,
+        "MeshTools::compressIndicesSplit(): index count" << indices.size() << "not divisible by" << primitiveSize, {});
+
+    /* 65535 is reserved for primitive restart, so the largest difference
+       that fits is 65534 */
+    constexpr UnsignedInt MaxDifference = 65534;
+
+    Containers::Array<UnsignedShort> out{Containers::NoInit, indices.size()};
+    std::vector<CompressedIndexRange> ranges;
+    if(indices.empty()) return {std::move(out), std::move(ranges)};
+
+    /* Find the ranges, if the whole mesh fits it's just one */
+    const std::pair<UnsignedInt, UnsignedInt> meshMinmax = minmax(indices);
+    if(meshMinmax.second - meshMinmax.first <= MaxDifference) {
+        ranges.push_back({0, indices.size(), meshMinmax.first, 0, UnsignedShort(meshMinmax.second - meshMinmax.first)});
+    } else {
+        CompressedIndexRange range{0, 0, indices[0], 0, 0};
+        UnsignedInt rangeMax = indices[0];
+        for(std::size_t i = 0; i != indices.size(); i += primitiveSize) {
+            UnsignedInt primitiveMin = indices[i], primitiveMax = indices[i];
+            for(std::size_t j = 1; j != primitiveSize; ++j) {
+                primitiveMin = Math::min(primitiveMin, indices[i + j]);
+                primitiveMax = Math::max(primitiveMax, indices[i + j]);
+            }
+            CORRADE_ASSERT(primitiveMax - primitiveMin <= MaxDifference,
+                "MeshTools::compressIndicesSplit(): primitive" << i/primitiveSize << "spans more than 65535 vertices", {});
+
+            const UnsignedInt min = Math::min(range.baseVertex, primitiveMin);
+            const UnsignedInt max = Math::max(rangeMax, primitiveMax);
+            if(range.indexCount && max - min > MaxDifference) {
+                range.indexEnd = UnsignedShort(rangeMax - range.baseVertex);
+                ranges.push_back(range);
+                range = {i, primitiveSize, primitiveMin, 0, 0};
+                rangeMax = primitiveMax;
+            } else {
+                range.indexCount += primitiveSize;
+                range.baseVertex = min;
+                rangeMax = max;
+            }
+        }
+        range.indexEnd = UnsignedShort(rangeMax - range.baseVertex);
+        ranges.push_back(range);
+    }
+
+    /* Write the indices relative to the range base */
+    for(const CompressedIndexRange& range: ranges)
+        for(std::size_t i = range.indexOffset, end = range.indexOffset + range.indexCount; i != end; ++i)
+            out[i] = UnsignedShort(indices[i] - range.baseVertex);
+
+    return {std::move(out), std::move(ranges)};
+}
 
 }}
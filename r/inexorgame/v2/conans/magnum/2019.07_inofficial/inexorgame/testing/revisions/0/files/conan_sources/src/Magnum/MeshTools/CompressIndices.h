@@ -26,11 +26,13 @@
 */
 
 /** @file
- * @brief Function @ref Magnum::MeshTools::compressIndices()
+ * @brief Function @ref Magnum::MeshTools::compressIndices(), @ref Magnum::MeshTools::compressIndicesAs(), @ref Magnum::MeshTools::compressIndicesSplit(), struct @ref Magnum::MeshTools::CompressedIndexRange
  */
 
 #include <tuple>
+#include <utility>
 #include <vector>
+#include <Corrade/Containers/StridedArrayView.h>
 
 #include "Magnum/Mesh.h"
 #include "Magnum/MeshTools/visibility.h"
@@ -55,6 +57,20 @@ Example usage:
 */
 std::tuple<Containers::Array<char>, MeshIndexType, UnsignedInt, UnsignedInt> MAGNUM_MESHTOOLS_EXPORT compressIndices(const std::vector<UnsignedInt>& indices);
 
+/**
+@brief Compress vertex indices
+@param indices  Index array
+@return Index range, type and compressed index array
+
+Same as @ref compressIndices(const std::vector<UnsignedInt>&), but takes a
+strided view, so the indices can come directly from an interleaved or
+memory-mapped buffer without a copy to a @ref std::vector first. The index
+range is found with a SIMD scan if the view is contiguous. An empty view
+results in an empty @ref MeshIndexType::UnsignedByte array.
+@see @ref compressIndicesSplit()
+*/
+std::tuple<Containers::Array<char>, MeshIndexType, UnsignedInt, UnsignedInt> MAGNUM_MESHTOOLS_EXPORT compressIndices(const Containers::StridedArrayView1D<const UnsignedInt>& indices);
+
 /**
 @brief Compress vertex indices as given type
 
@@ -70,12 +86,98 @@ Example usage:
 */
 template<class T> MAGNUM_MESHTOOLS_EXPORT Containers::Array<T> compressIndicesAs(const std::vector<UnsignedInt>& indices);
 
+/**
+@brief Compress vertex indices as given type
+
+Same as @ref compressIndicesAs(const std::vector<UnsignedInt>&), but takes a
+strided view.
+*/
+template<class T> MAGNUM_MESHTOOLS_EXPORT Containers::Array<T> compressIndicesAs(const Containers::StridedArrayView1D<const UnsignedInt>& indices);
+
 #if defined(CORRADE_TARGET_WINDOWS) && !defined(__MINGW32__)
 extern template MAGNUM_MESHTOOLS_EXPORT Containers::Array<UnsignedByte> compressIndicesAs<UnsignedByte>(const std::vector<UnsignedInt>&);
 extern template MAGNUM_MESHTOOLS_EXPORT Containers::Array<UnsignedShort> compressIndicesAs<UnsignedShort>(const std::vector<UnsignedInt>&);
 extern template MAGNUM_MESHTOOLS_EXPORT Containers::Array<UnsignedInt> compressIndicesAs<UnsignedInt>(const std::vector<UnsignedInt>&);
+extern template MAGNUM_MESHTOOLS_EXPORT Containers::Array<UnsignedByte> compressIndicesAs<UnsignedByte>(const Containers::StridedArrayView1D<const UnsignedInt>&);
+extern template MAGNUM_MESHTOOLS_EXPORT Containers::Array<UnsignedShort> compressIndicesAs<UnsignedShort>(const Containers::StridedArrayView1D<const UnsignedInt>&);
+extern template MAGNUM_MESHTOOLS_EXPORT Containers::Array<UnsignedInt> compressIndicesAs<UnsignedInt>(const Containers::StridedArrayView1D<const UnsignedInt>&);
 #endif
 
+/**
+@brief Index range of a split mesh
+
+@see @ref compressIndicesSplit()
+*/
+struct CompressedIndexRange {
+    /** @brief Offset of the first index in the compressed index array */
+    std::size_t indexOffset;
+
+    /** @brief Index count */
+    std::size_t indexCount;
+
+    /**
+     * @brief Base vertex
+     *
+     * Value to add to the compressed indices to get the original ones.
+     */
+    UnsignedInt baseVertex;
+
+    /** @brief Minimal compressed index value in the range */
+    UnsignedShort indexStart;
+
+    /** @brief Maximal compressed index value in the range */
+    UnsignedShort indexEnd;
+};
+
+/**
+@brief Compress vertex indices to 16 bits, splitting the mesh if needed
+@param indices      Index array
+@param primitive    Mesh primitive
+@return Compressed index array and ranges it's split into
+
+Splits the index array into consecutive ranges where the difference between
+the smallest and largest index is less than @cpp 65535 @ce and stores each
+range relative to its smallest index as 16-bit values. That way also meshes
+with more than 65535 vertices can be drawn with 16-bit indices, saving half of
+the index bandwidth, which is especially useful on mobile and WebGL targets.
+Each range is then drawn separately with its base vertex:
+
+@code{.cpp}
+Containers::Array<UnsignedShort> indices;
+std::vector<MeshTools::CompressedIndexRange> ranges;
+std::tie(indices, ranges) = MeshTools::compressIndicesSplit(data);
+
+GL::Buffer indexBuffer;
+indexBuffer.setData(indices);
+for(const MeshTools::CompressedIndexRange& range: ranges) {
+    mesh.setCount(range.indexCount)
+        .setBaseVertex(range.baseVertex)
+        .setIndexBuffer(indexBuffer, range.indexOffset*2,
+            MeshIndexType::UnsignedShort, range.indexStart, range.indexEnd);
+    shader.draw(mesh);
+}
+@endcode
+
+Where base vertex isn't available (OpenGL ES and WebGL), offset the vertex
+buffer by @cpp range.baseVertex*stride @ce instead. The value @cpp 65535 @ce
+is never used, so the indices are safe to use with primitive restart, which
+is always enabled on WebGL 2.
+
+The ranges never split a primitive, which is why only
+@ref MeshPrimitive::Points, @ref MeshPrimitive::Lines and
+@ref MeshPrimitive::Triangles are supported and @p indices is expected to
+have a size divisible by the primitive size. The primitive order is kept, so
+any previous vertex cache optimization is preserved. The ranges are found
+greedily in index order, so the count of ranges is the lowest if the vertex
+data are ordered by first use, for example by
+@ref optimizeVertexFetchInPlace(). A single primitive spanning more than
+@cpp 65535 @ce vertices, i.e. with the difference between its smallest and
+largest index over @cpp 65534 @ce, is an assertion failure. If the index
+range of the whole mesh fits, there's just one range.
+@see @ref compressIndices()
+*/
+std::pair<Containers::Array<UnsignedShort>, std::vector<CompressedIndexRange>> MAGNUM_MESHTOOLS_EXPORT compressIndicesSplit(const Containers::StridedArrayView1D<const UnsignedInt>& indices, MeshPrimitive primitive = MeshPrimitive::Triangles);
+
 }}
 
 #endif
@@ -28,8 +28,11 @@
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/StridedArrayView.h>
 
+#include <Corrade/Utility/TaskScheduler.h>
+
 #include "Magnum/Math/Functions.h"
 #include "Magnum/Math/Vector3.h"
+#include "Magnum/Implementation/taskScheduler.h"
 
 #ifdef MAGNUM_BUILD_DEPRECATED
 #include <vector>
@@ -86,15 +89,162 @@ std::pair<std::vector<UnsignedInt>, std::vector<Vector3>> generateFlatNormals(co
 }
 #endif
 
-#if defined(CORRADE_MSVC2019_COMPATIBILITY) && !defined(CORRADE_MSVC2017_COMPATIBILITY)
-/* When using /permissive- with MSVC2019, using namespace inside the function
-   below FOR SOME REASON gets lost when instantiating the template. That's
-   stupid but what can we do -- the only way to work around that is to move it
-   outside the function. */
-using namespace Math::Literals;
-#endif
+namespace {
+
+typedef std::pair<Vector3, Math::Vector3<Rad>> CrossAngle;
+
+/* Cross product and interior angles of a face. Shared by the serial and the
+   parallel variant so they give the same results. */
+CrossAngle crossAngle(const Vector3& v0, const Vector3& v1, const Vector3& v2) {
+    CrossAngle out;
+
+    /* Cross product */
+    out.first = Math::cross(v2 - v1, v0 - v1);
+
+    /* If any of the vectors is zero, the normalization would result in a NaN
+       and the angle calculation will assert. This happens also when any of
+       the original positions is NaN. If that's the case, skip the rest. Given
+       triangle will then contribute with a zero total angle, effectively
+       getting ignored for normal calculation. */
+    const Vector3 v10n = (v1 - v0).normalized();
+    const Vector3 v20n = (v2 - v0).normalized();
+    const Vector3 v21n = (v2 - v1).normalized();
+    if(Math::isNan(v10n) || Math::isNan(v20n) || Math::isNan(v21n)) {
+        out.second = Math::Vector3<Rad>{Math::ZeroInit};
+        return out;
+    }
+
+    /* Inner angle at each vertex of the triangle. The last one can be
+       calculated as a remainder to 180°. */
+    using namespace Math::Literals;
+    out.second[0] = Math::angle(v10n, v20n);
+    out.second[1] = Math::angle(-v10n, v21n);
+    out.second[2] = Rad(180.0_degf) - out.second[0] - out.second[1];
+    return out;
+}
+
+/* Angle between two sides of the triangle that share vertex `v`. The shared
+   vertex can be one of the three, if it's there more than once, the first
+   occurence is used. */
+template<class T> inline Rad cornerAngle(const CrossAngle& crossAngle, const std::size_t v, const T v0i, const T v1i, const T v2i) {
+    if(v == v0i) return crossAngle.second[0];
+    if(v == v1i) return crossAngle.second[1];
+    if(v == v2i) return crossAngle.second[2];
+    CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+/* Meshes with less triangles per thread than this are processed on fewer
+   threads */
+constexpr std::size_t MinimalTrianglesPerThread = 16384;
 
-template<class T> void generateSmoothNormalsInto(const Containers::StridedArrayView1D<const T>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<Vector3>& normals) {
+/* Vertices are accumulated in blocks of this size, small enough for the
+   normals of a block to stay in cache */
+constexpr std::size_t VertexBlockSize = 4096;
+
+/* Calls f(chunk) for each of the chunkCount chunks on the shared scheduler */
+template<class F> void parallelFor(const std::size_t chunkCount, F f) {
+    Magnum::Implementation::taskScheduler().parallelFor(0, chunkCount, 1, [&f](const std::size_t begin, const std::size_t end) {
+        for(std::size_t chunk = begin; chunk != end; ++chunk) f(chunk);
+    });
+}
+
+template<class T> void generateSmoothNormalsParallelInto(const Containers::StridedArrayView1D<const T>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<Vector3>& normals, const std::size_t threadCount) {
+    const std::size_t triangleCount = indices.size()/3;
+    const std::size_t blockCount = (positions.size() + VertexBlockSize - 1)/VertexBlockSize;
+    auto triangleRangeBegin = [&](std::size_t thread) {
+        return triangleCount*thread/threadCount;
+    };
+
+    /* First pass, for each range of triangles calculate the cross products
+       and angles and count references to each vertex block. Out-of-bounds
+       indices are remembered and skipped, as the assert can't be fired from
+       a thread. */
+    Containers::Array<CrossAngle> crossAngles{Containers::NoInit, triangleCount};
+    Containers::Array<std::size_t> blockCounts{Containers::ValueInit, threadCount*blockCount};
+    Containers::Array<std::size_t> firstInvalid{Containers::NoInit, threadCount};
+    parallelFor(threadCount, [&](std::size_t thread) {
+        std::size_t* const counts = blockCounts + thread*blockCount;
+        firstInvalid[thread] = indices.size();
+        for(std::size_t t = triangleRangeBegin(thread), end = triangleRangeBegin(thread + 1); t != end; ++t) {
+            const T v0i = indices[t*3 + 0];
+            const T v1i = indices[t*3 + 1];
+            const T v2i = indices[t*3 + 2];
+            if(v0i >= positions.size() || v1i >= positions.size() || v2i >= positions.size()) {
+                if(firstInvalid[thread] == indices.size())
+                    firstInvalid[thread] = t*3 + (v0i >= positions.size() ? 0 : v1i >= positions.size() ? 1 : 2);
+                crossAngles[t] = {};
+                continue;
+            }
+
+            crossAngles[t] = crossAngle(positions[v0i], positions[v1i], positions[v2i]);
+            ++counts[v0i/VertexBlockSize];
+            ++counts[v1i/VertexBlockSize];
+            ++counts[v2i/VertexBlockSize];
+        }
+    });
+
+    #ifndef CORRADE_NO_ASSERT
+    for(std::size_t i: firstInvalid)
+        CORRADE_ASSERT(i == indices.size(), "MeshTools::generateSmoothNormals(): index" << indices[i] << "out of bounds for" << positions.size() << "elements", );
+    #endif
+
+    /* Turn the counts into offsets ordered by vertex block first and thread
+       second. As the threads process triangle ranges in order, each block
+       then lists its triangle corners in the same order as the serial
+       version goes through them. The counts are laid out by thread first, so
+       this can't be done in place. */
+    Containers::Array<std::size_t> cornerOffsets{Containers::NoInit, threadCount*blockCount + 1};
+    {
+        std::size_t offset = 0;
+        for(std::size_t block = 0; block != blockCount; ++block) {
+            for(std::size_t thread = 0; thread != threadCount; ++thread) {
+                cornerOffsets[block*threadCount + thread] = offset;
+                offset += blockCounts[thread*blockCount + block];
+            }
+        }
+        cornerOffsets[threadCount*blockCount] = offset;
+    }
+
+    /* Second pass, put the corners into buckets, again for each range of
+       triangles in parallel */
+    Containers::Array<UnsignedInt> corners{Containers::NoInit, cornerOffsets[threadCount*blockCount]};
+    parallelFor(threadCount, [&](std::size_t thread) {
+        for(std::size_t i = triangleRangeBegin(thread)*3, end = triangleRangeBegin(thread + 1)*3; i != end; ++i) {
+            const std::size_t v = indices[i];
+            if(v >= positions.size()) continue;
+            corners[cornerOffsets[v/VertexBlockSize*threadCount + thread]++] = i;
+        }
+    });
+
+    /* Now each cornerOffsets[block*threadCount + thread] points to where the
+       next thread starts, so the range for block is from
+       cornerOffsets[block*threadCount - 1] (or 0) to
+       cornerOffsets[(block + 1)*threadCount - 1]. Last pass, each thread
+       accumulates and normalizes a range of vertex blocks. */
+    parallelFor(threadCount, [&](std::size_t thread) {
+        for(std::size_t block = blockCount*thread/threadCount, blockEnd = blockCount*(thread + 1)/threadCount; block != blockEnd; ++block) {
+            const std::size_t vertexBegin = block*VertexBlockSize;
+            const std::size_t vertexEnd = Math::min(vertexBegin + VertexBlockSize, positions.size());
+            for(std::size_t v = vertexBegin; v != vertexEnd; ++v)
+                normals[v] = Vector3{Math::ZeroInit};
+
+            for(std::size_t c = block ? cornerOffsets[block*threadCount - 1] : 0, end = cornerOffsets[(block + 1)*threadCount - 1]; c != end; ++c) {
+                const std::size_t i = corners[c];
+                const std::size_t baseIndex = i - i%3;
+                const std::size_t v = indices[i];
+                const CrossAngle& crossAngle = crossAngles[i/3];
+                normals[v] += crossAngle.first*Float(cornerAngle(crossAngle, v, indices[baseIndex + 0], indices[baseIndex + 1], indices[baseIndex + 2]));
+            }
+
+            for(std::size_t v = vertexBegin; v != vertexEnd; ++v)
+                normals[v] = normals[v].normalized();
+        }
+    });
+}
+
+}
+
+template<class T> void generateSmoothNormalsInto(const Containers::StridedArrayView1D<const T>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<Vector3>& normals, UnsignedInt threadCount) {
     CORRADE_ASSERT(indices.size() % 3 == 0,
         "MeshTools::generateSmoothNormalsInto(): index count not divisible by 3", );
     CORRADE_ASSERT(normals.size() == positions.size(),
@@ -102,6 +252,11 @@ template<class T> void generateSmoothNormalsInto(const Containers::StridedArrayV
 
     if(indices.empty()) return;
 
+    if(!threadCount) threadCount = Magnum::Implementation::taskScheduler().threadCount();
+    threadCount = Math::min(std::size_t(threadCount), Math::max(indices.size()/3/MinimalTrianglesPerThread, std::size_t{1}));
+    if(threadCount > 1)
+        return generateSmoothNormalsParallelInto(indices, positions, normals, threadCount);
+
     /* Gather count of triangles for every vertex. This abuses the output
        storage to avoid extra allocations, zero-initialize it first to avoid
        random memory getting used. */
@@ -126,9 +281,9 @@ template<class T> void generateSmoothNormalsInto(const Containers::StridedArrayV
     /* Gather triangle IDs for every vertex. For vertex i,
        triangleIds[triangleOffset[i]] until triangleIds[triangleOffset[i + 1]]
        contains IDs of triangles that contain it. */
-    Containers::Array<T> triangleIds{Containers::NoInit, indices.size()};
+    Containers::Array<UnsignedInt> triangleIds{Containers::NoInit, indices.size()};
     for(std::size_t i = 0; i != indices.size(); ++i) {
-        const T triangleId = i/3;
+        const UnsignedInt triangleId = i/3;
         const T vertexId = indices[i];
 
         /* How many triangle IDs is still left to be written, which also means
@@ -143,38 +298,9 @@ template<class T> void generateSmoothNormalsInto(const Containers::StridedArrayV
     /* Precalculate cross product and interior angles of each face --- the loop
        below would otherwise calculate it for every vertex, which is at least
        3x as much work */
-    Containers::Array<std::pair<Vector3, Math::Vector3<Rad>>> crossAngles{Math::NoInit, indices.size()/3};
-    for(std::size_t i = 0; i != crossAngles.size(); ++i) {
-        const Vector3 v0 = positions[indices[i*3 + 0]];
-        const Vector3 v1 = positions[indices[i*3 + 1]];
-        const Vector3 v2 = positions[indices[i*3 + 2]];
-
-        /* Cross product */
-        crossAngles[i].first = Math::cross(v2 - v1, v0 - v1);
-
-        /* If any of the vectors is zero, the normalization would result in a
-           NaN and the angle calculation will assert. This happens also when
-           any of the original positions is NaN. If that's the case, skip the
-           rest. Given triangle will then contribute with a zero total angle,
-           effectively getting ignored for normal calculation. */
-        const Vector3 v10n = (v1 - v0).normalized();
-        const Vector3 v20n = (v2 - v0).normalized();
-        const Vector3 v21n = (v2 - v1).normalized();
-        if(Math::isNan(v10n) || Math::isNan(v20n) || Math::isNan(v21n)) {
-            crossAngles[i].second = Math::Vector3<Rad>{Math::ZeroInit};
-            continue;
-        }
-
-        /* Inner angle at each vertex of the triangle. The last one can be
-           calculated as a remainder to 180°. */
-        /* This using namespace doesn't work with MSVC2019 with /permissive-
-           (it gets lost when instantiating?!), so it's duplicated above */
-        using namespace Math::Literals;
-        crossAngles[i].second[0] = Math::angle(v10n, v20n);
-        crossAngles[i].second[1] = Math::angle(-v10n, v21n);
-        crossAngles[i].second[2] = Rad(180.0_degf)
-            - crossAngles[i].second[0] - crossAngles[i].second[1];
-    }
+    Containers::Array<CrossAngle> crossAngles{Containers::NoInit, indices.size()/3};
+    for(std::size_t i = 0; i != crossAngles.size(); ++i)
+        crossAngles[i] = crossAngle(positions[indices[i*3 + 0]], positions[indices[i*3 + 1]], positions[indices[i*3 + 2]]);
 
     /* For every vertex v, calculate normals from all faces it belongs to and
        average them */
@@ -191,15 +317,7 @@ template<class T> void generateSmoothNormalsInto(const Containers::StridedArrayV
 
             /* Cross product is a vector in direction of the normal with length
                equal to size of the parallelogram */
-            const std::pair<Vector3, Math::Vector3<Rad>>& crossAngle = crossAngles[triangleIds[t]];
-
-            /* Angle between two sides of the triangle that share vertex `v`.
-               The shared vertex can be one of the three. */
-            Rad angle;
-            if(v == v0i) angle = crossAngle.second[0];
-            else if(v == v1i) angle = crossAngle.second[1];
-            else if(v == v2i) angle = crossAngle.second[2];
-            else CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+            const CrossAngle& crossAngle = crossAngles[triangleIds[t]];
 
             /* The normal is cross.normalized(), we need to multiply it it by
                surface area which is cross.length()/2. Since normalization is
@@ -209,7 +327,7 @@ template<class T> void generateSmoothNormalsInto(const Containers::StridedArrayV
                that as well. Finally we need to weight by the angle, and in
                that case only the ratio is important as well, so it doesn't
                matter if degrees or radians. */
-            normals[v] += crossAngle.first*Float(angle);
+            normals[v] += crossAngle.first*Float(cornerAngle(crossAngle, v, v0i, v1i, v2i));
         }
 
         /* Normalize the accumulated direction */
@@ -218,21 +336,21 @@ template<class T> void generateSmoothNormalsInto(const Containers::StridedArrayV
 }
 
 #ifndef DOXYGEN_GENERATING_OUTPUT
-template void generateSmoothNormalsInto<UnsignedByte>(const Containers::StridedArrayView1D<const UnsignedByte>&, const Containers::StridedArrayView1D<const Vector3>&, const Containers::StridedArrayView1D<Vector3>&);
-template void generateSmoothNormalsInto<UnsignedShort>(const Containers::StridedArrayView1D<const UnsignedShort>&, const Containers::StridedArrayView1D<const Vector3>&, const Containers::StridedArrayView1D<Vector3>&);
-template void generateSmoothNormalsInto<UnsignedInt>(const Containers::StridedArrayView1D<const UnsignedInt>&, const Containers::StridedArrayView1D<const Vector3>&, const Containers::StridedArrayView1D<Vector3>&);
+template void generateSmoothNormalsInto<UnsignedByte>(const Containers::StridedArrayView1D<const UnsignedByte>&, const Containers::StridedArrayView1D<const Vector3>&, const Containers::StridedArrayView1D<Vector3>&, UnsignedInt);
+template void generateSmoothNormalsInto<UnsignedShort>(const Containers::StridedArrayView1D<const UnsignedShort>&, const Containers::StridedArrayView1D<const Vector3>&, const Containers::StridedArrayView1D<Vector3>&, UnsignedInt);
+template void generateSmoothNormalsInto<UnsignedInt>(const Containers::StridedArrayView1D<const UnsignedInt>&, const Containers::StridedArrayView1D<const Vector3>&, const Containers::StridedArrayView1D<Vector3>&, UnsignedInt);
 #endif
 
-template<class T> Containers::Array<Vector3> generateSmoothNormals(const Containers::StridedArrayView1D<const T>& indices, const Containers::StridedArrayView1D<const Vector3>& positions) {
+template<class T> Containers::Array<Vector3> generateSmoothNormals(const Containers::StridedArrayView1D<const T>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const UnsignedInt threadCount) {
     Containers::Array<Vector3> out{Containers::NoInit, positions.size()};
-    generateSmoothNormalsInto(indices, positions, out);
+    generateSmoothNormalsInto(indices, positions, out, threadCount);
     return out;
 }
 
 #ifndef DOXYGEN_GENERATING_OUTPUT
-template Containers::Array<Vector3> generateSmoothNormals<UnsignedByte>(const Containers::StridedArrayView1D<const UnsignedByte>&, const Containers::StridedArrayView1D<const Vector3>&);
-template Containers::Array<Vector3> generateSmoothNormals<UnsignedShort>(const Containers::StridedArrayView1D<const UnsignedShort>&, const Containers::StridedArrayView1D<const Vector3>&);
-template Containers::Array<Vector3> generateSmoothNormals<UnsignedInt>(const Containers::StridedArrayView1D<const UnsignedInt>&, const Containers::StridedArrayView1D<const Vector3>&);
+template Containers::Array<Vector3> generateSmoothNormals<UnsignedByte>(const Containers::StridedArrayView1D<const UnsignedByte>&, const Containers::StridedArrayView1D<const Vector3>&, UnsignedInt);
+template Containers::Array<Vector3> generateSmoothNormals<UnsignedShort>(const Containers::StridedArrayView1D<const UnsignedShort>&, const Containers::StridedArrayView1D<const Vector3>&, UnsignedInt);
+template Containers::Array<Vector3> generateSmoothNormals<UnsignedInt>(const Containers::StridedArrayView1D<const UnsignedInt>&, const Containers::StridedArrayView1D<const Vector3>&, UnsignedInt);
 #endif
 
 }}
@@ -0,0 +1,293 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "Meshlets.h"
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/Math/Frustum.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/MeshTools/Tipsify.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+constexpr UnsignedShort NoLocalIndex = 0xffff;
+
+/* Calculates bounding sphere and normal cone of the last meshlet and resets
+   the local index mapping for its vertices */
+void finishMeshlet(MeshletData& out, const Meshlet& meshlet, const Containers::ArrayView<const UnsignedInt> indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::ArrayView<const UnsignedInt> triangleIds, Containers::ArrayView<UnsignedShort> localIndex) {
+    const UnsignedInt* const vertices = out.vertices.data() + meshlet.vertexOffset;
+    for(std::size_t i = 0; i != meshlet.vertexCount; ++i)
+        localIndex[vertices[i]] = NoLocalIndex;
+
+    /* Bounding sphere using Ritter's algorithm -- start with the most distant
+       pair of axis extremes, grow to include all points and then calculate
+       the exact radius for the final center */
+    UnsignedInt minima[3]{}, maxima[3]{};
+    for(UnsignedInt i = 0; i != meshlet.vertexCount; ++i) {
+        const Vector3& p = positions[vertices[i]];
+        for(std::size_t j = 0; j != 3; ++j) {
+            if(p[j] < positions[vertices[minima[j]]][j]) minima[j] = i;
+            if(p[j] > positions[vertices[maxima[j]]][j]) maxima[j] = i;
+        }
+    }
+    std::size_t axis = 0;
+    Float axisDistance = -1.0f;
+    for(std::size_t j = 0; j != 3; ++j) {
+        const Float distance = (positions[vertices[maxima[j]]] - positions[vertices[minima[j]]]).dot();
+        if(distance > axisDistance) {
+            axis = j;
+            axisDistance = distance;
+        }
+    }
+    Vector3 center = (positions[vertices[minima[axis]]] + positions[vertices[maxima[axis]]])*0.5f;
+    Float radius = Math::sqrt(axisDistance)*0.5f;
+    for(UnsignedInt i = 0; i != meshlet.vertexCount; ++i) {
+        const Vector3& p = positions[vertices[i]];
+        const Float distance = (p - center).length();
+        if(distance > radius) {
+            const Float newRadius = (radius + distance)*0.5f;
+            center += (p - center)*((newRadius - radius)/distance);
+            radius = newRadius;
+        }
+    }
+    radius = 0.0f;
+    for(UnsignedInt i = 0; i != meshlet.vertexCount; ++i)
+        radius = Math::max(radius, (positions[vertices[i]] - center).length());
+    out.boundingSpheres.emplace_back(center, radius);
+
+    /* Normal cone -- average of the triangle normals as the axis, angle given
+       by the most diverging normal */
+    Containers::Array<Vector3> normals{Containers::NoInit, meshlet.triangleCount};
+    std::size_t normalCount = 0;
+    Vector3 coneAxis;
+    for(std::size_t i = 0; i != meshlet.triangleCount; ++i) {
+        const UnsignedInt t = triangleIds[i];
+        const Vector3& a = positions[indices[t*3 + 0]];
+        const Vector3 normal = Math::cross(positions[indices[t*3 + 1]] - a, positions[indices[t*3 + 2]] - a);
+        const Float length = normal.length();
+        if(length == 0.0f) continue;
+        normals[normalCount] = normal/length;
+        coneAxis += normals[normalCount];
+        ++normalCount;
+    }
+    const Float axisLength = coneAxis.length();
+    if(!normalCount || axisLength < 1.0e-6f) {
+        out.normalCones.emplace_back(Vector3{}, 1.0f);
+        return;
+    }
+    coneAxis /= axisLength;
+    Float minDot = 1.0f;
+    for(std::size_t i = 0; i != normalCount; ++i)
+        minDot = Math::min(minDot, Math::dot(coneAxis, normals[i]));
+    out.normalCones.emplace_back(coneAxis, minDot <= 0.0f ? 1.0f :
+        Math::sqrt(1.0f - minDot*minDot));
+}
+
+}
+
+MeshletData buildMeshlets(const Containers::ArrayView<const UnsignedInt> indices, const Containers::StridedArrayView1D<const Vector3> positions, const UnsignedInt maxVertexCount, const UnsignedInt maxTriangleCount) {
+    CORRADE_ASSERT(indices.size() % 3 == 0,
+        "MeshTools::buildMeshlets(): index count not divisible by 3", {});
+    CORRADE_ASSERT(maxVertexCount >= 3 && maxVertexCount <= 256,
+        "MeshTools::buildMeshlets(): expected max vertex count between 3 and 256 but got" << maxVertexCount, {});
+    CORRADE_ASSERT(maxTriangleCount,
+        "MeshTools::buildMeshlets(): expected non-zero max triangle count", {});
+
+    const UnsignedInt vertexCount = positions.size();
+    #if !defined(CORRADE_NO_ASSERT) || defined(CORRADE_GRACEFUL_ASSERT)
+    for(const UnsignedInt index: indices)
+        CORRADE_ASSERT(index < vertexCount,
+            "MeshTools::buildMeshlets(): index" << index << "out of bounds for" << vertexCount << "vertices", {});
+    #endif
+
+    /* Neighboring triangles for each vertex, per-vertex live triangle count */
+    std::vector<UnsignedInt> liveTriangleCount, neighborOffset, neighbors;
+    Implementation::Tipsify::buildAdjacency(indices, vertexCount, liveTriangleCount, neighborOffset, neighbors);
+
+    /* Per-triangle emitted flag, meshlet-local index of each vertex and IDs
+       of triangles in current meshlet */
+    const std::size_t triangleCount = indices.size()/3;
+    std::vector<bool> emitted(triangleCount);
+    Containers::Array<UnsignedShort> localIndex{Containers::NoInit, vertexCount};
+    for(UnsignedShort& i: localIndex) i = NoLocalIndex;
+    Containers::Array<UnsignedInt> triangleIds{Containers::NoInit, maxTriangleCount};
+
+    /* Not yet emitted triangles adjacent to the current meshlet. Each
+       triangle is added only once per meshlet, which is tracked by storing
+       ID of the meshlet (plus one) that last added it. */
+    std::vector<UnsignedInt> candidates;
+    Containers::Array<UnsignedInt> candidateMeshlet{Containers::ValueInit, triangleCount};
+
+    MeshletData out;
+    out.triangles.reserve(indices.size());
+    Meshlet meshlet{0, 0, 0, 0};
+    Vector3 centroidSum;
+    std::size_t emittedCount = 0;
+    std::size_t cursor = 0;
+    while(emittedCount != triangleCount) {
+        UnsignedInt best = ~UnsignedInt{};
+
+        /* Grow the meshlet by an adjacent triangle that adds the least new
+           vertices and is closest to the meshlet center. Emitted triangles
+           are removed from the candidate list on the way. */
+        if(meshlet.triangleCount) {
+            const Vector3 centroid = centroidSum/Float(meshlet.vertexCount);
+            UnsignedInt bestNewVertexCount = 4;
+            Float bestDistance{};
+            for(std::size_t i = 0; i < candidates.size(); ++i) {
+                const UnsignedInt t = candidates[i];
+                if(emitted[t]) {
+                    candidates[i--] = candidates.back();
+                    candidates.pop_back();
+                    continue;
+                }
+
+                const UnsignedInt a = indices[t*3 + 0];
+                const UnsignedInt b = indices[t*3 + 1];
+                const UnsignedInt c = indices[t*3 + 2];
+                const UnsignedInt newVertexCount =
+                    (localIndex[a] == NoLocalIndex) +
+                    (localIndex[b] == NoLocalIndex && b != a) +
+                    (localIndex[c] == NoLocalIndex && c != a && c != b);
+                if(meshlet.vertexCount + newVertexCount > maxVertexCount || newVertexCount > bestNewVertexCount) continue;
+
+                const Float distance = ((positions[a] + positions[b] + positions[c])*(1.0f/3.0f) - centroid).dot();
+                if(newVertexCount < bestNewVertexCount || distance < bestDistance) {
+                    best = t;
+                    bestNewVertexCount = newVertexCount;
+                    bestDistance = distance;
+                }
+            }
+
+        /* Start a new meshlet next to the previous one, if possible */
+        } else if(!out.meshlets.empty()) {
+            const Meshlet& previous = out.meshlets.back();
+            for(std::size_t i = previous.vertexOffset; i != previous.vertexOffset + previous.vertexCount && best == ~UnsignedInt{}; ++i) {
+                const UnsignedInt v = out.vertices[i];
+                if(!liveTriangleCount[v]) continue;
+
+                for(UnsignedInt ti = neighborOffset[v]; ti != neighborOffset[v + 1]; ++ti) if(!emitted[neighbors[ti]]) {
+                    best = neighbors[ti];
+                    break;
+                }
+            }
+        }
+
+        /* If the connected part is exhausted, continue with the next unused
+           triangle in index order, if it fits */
+        if(best == ~UnsignedInt{} && candidates.empty()) {
+            while(emitted[cursor]) ++cursor;
+            UnsignedInt newVertexCount = 0;
+            for(std::size_t i = 0; i != 3; ++i) {
+                const UnsignedInt v = indices[cursor*3 + i];
+                if(localIndex[v] != NoLocalIndex) continue;
+                bool duplicate = false;
+                for(std::size_t j = 0; j != i; ++j)
+                    if(indices[cursor*3 + j] == v) duplicate = true;
+                if(!duplicate) ++newVertexCount;
+            }
+            if(meshlet.vertexCount + newVertexCount <= maxVertexCount)
+                best = cursor;
+        }
+
+        /* Add the triangle to the meshlet */
+        if(best != ~UnsignedInt{}) {
+            for(std::size_t i = 0; i != 3; ++i) {
+                const UnsignedInt v = indices[best*3 + i];
+                if(localIndex[v] == NoLocalIndex) {
+                    localIndex[v] = meshlet.vertexCount++;
+                    out.vertices.push_back(v);
+                    centroidSum += positions[v];
+
+                    for(UnsignedInt ti = neighborOffset[v]; ti != neighborOffset[v + 1]; ++ti) {
+                        const UnsignedInt t = neighbors[ti];
+                        if(emitted[t] || candidateMeshlet[t] == out.meshlets.size() + 1) continue;
+                        candidateMeshlet[t] = out.meshlets.size() + 1;
+                        candidates.push_back(t);
+                    }
+                }
+                out.triangles.push_back(localIndex[v]);
+                --liveTriangleCount[v];
+            }
+            emitted[best] = true;
+            triangleIds[meshlet.triangleCount++] = best;
+            ++emittedCount;
+        }
+
+        /* Finish the meshlet if it's full, if nothing else fits or if this
+           was the last triangle */
+        if(best == ~UnsignedInt{} || meshlet.triangleCount == maxTriangleCount || emittedCount == triangleCount) {
+            out.meshlets.push_back(meshlet);
+            finishMeshlet(out, meshlet, indices, positions, triangleIds.prefix(meshlet.triangleCount), localIndex);
+            meshlet = Meshlet{UnsignedInt(out.vertices.size()), UnsignedInt(out.triangles.size()), 0, 0};
+            centroidSum = {};
+            candidates.clear();
+        }
+    }
+
+    return out;
+}
+
+std::size_t cullMeshlets(const MeshletData& meshlets, const Frustum& frustum, const Vector3& cameraPosition, const Containers::ArrayView<UnsignedInt> visible) {
+    CORRADE_ASSERT(visible.size() >= meshlets.meshlets.size(),
+        "MeshTools::cullMeshlets(): expected at least" << meshlets.meshlets.size() << "output items but got" << visible.size(), {});
+
+    /* Normalize the planes so the sphere test can compare distances directly */
+    Vector4 planes[6];
+    for(std::size_t i = 0; i != 6; ++i)
+        planes[i] = frustum[i]/frustum[i].xyz().length();
+
+    std::size_t count = 0;
+    for(std::size_t i = 0; i != meshlets.meshlets.size(); ++i) {
+        const Vector4& sphere = meshlets.boundingSpheres[i];
+        const Vector3 center = sphere.xyz();
+
+        /* Frustum test */
+        bool inside = true;
+        for(const Vector4& plane: planes) if(Math::dot(plane.xyz(), center) + plane.w() < -sphere.w()) {
+            inside = false;
+            break;
+        }
+        if(!inside) continue;
+
+        /* Backface test */
+        const Vector4& cone = meshlets.normalCones[i];
+        const Vector3 direction = center - cameraPosition;
+        if(Math::dot(direction, cone.xyz()) >= cone.w()*direction.length() + sphere.w())
+            continue;
+
+        visible[count++] = i;
+    }
+
+    return count;
+}
+
+}}
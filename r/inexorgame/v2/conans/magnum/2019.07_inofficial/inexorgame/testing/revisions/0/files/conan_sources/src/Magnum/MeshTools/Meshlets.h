@@ -0,0 +1,166 @@
+#ifndef Magnum_MeshTools_Meshlets_h
+#define Magnum_MeshTools_Meshlets_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Struct @ref Magnum::MeshTools::Meshlet, @ref Magnum::MeshTools::MeshletData, function @ref Magnum::MeshTools::buildMeshlets(), @ref Magnum::MeshTools::cullMeshlets()
+ */
+
+#include <vector>
+#include <Corrade/Containers/StridedArrayView.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Vector4.h"
+#include "Magnum/MeshTools/visibility.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Meshlet
+
+A contiguous range in the @ref MeshletData::vertices and
+@ref MeshletData::triangles arrays. The layout is tightly packed in 16 bytes,
+so an array of these can be uploaded to a GPU buffer directly.
+@see @ref buildMeshlets()
+*/
+struct Meshlet {
+    /** @brief Offset of the first vertex in @ref MeshletData::vertices */
+    UnsignedInt vertexOffset;
+
+    /**
+     * @brief Offset of the first triangle in @ref MeshletData::triangles
+     *
+     * Counted in array items, not triangles, so it's always divisible by
+     * @cpp 3 @ce.
+     */
+    UnsignedInt triangleOffset;
+
+    /** @brief Vertex count */
+    UnsignedInt vertexCount;
+
+    /** @brief Triangle count */
+    UnsignedInt triangleCount;
+};
+
+/**
+@brief Meshlet data
+
+All arrays are flat and indexed by meshlet ID, except for @ref vertices and
+@ref triangles, which are referenced from @ref meshlets.
+@see @ref buildMeshlets(), @ref cullMeshlets()
+*/
+struct MeshletData {
+    /** @brief Meshlet ranges */
+    std::vector<Meshlet> meshlets;
+
+    /**
+     * @brief Meshlet vertices
+     *
+     * Indices into the original vertex data, each meshlet references a range
+     * of these.
+     */
+    std::vector<UnsignedInt> vertices;
+
+    /**
+     * @brief Meshlet triangles
+     *
+     * Three items per triangle, each being an index into the meshlet's range
+     * of @ref vertices.
+     */
+    std::vector<UnsignedByte> triangles;
+
+    /**
+     * @brief Bounding spheres
+     *
+     * Center in the XYZ components, radius in W. Can be tested against a
+     * @ref Math::Frustum.
+     */
+    std::vector<Vector4> boundingSpheres;
+
+    /**
+     * @brief Normal cones
+     *
+     * Normalized cone axis in the XYZ components, sine of the cone half-angle
+     * in W. If the triangle normals of the meshlet span a hemisphere or more,
+     * the W component is @cpp 1.0f @ce and the meshlet can't be backface
+     * culled. See @ref cullMeshlets() for how to use this value.
+     */
+    std::vector<Vector4> normalCones;
+};
+
+/**
+@brief Split a triangle mesh into meshlets
+@param indices          Triangle indices
+@param positions        Vertex positions
+@param maxVertexCount   Max vertex count per meshlet, at most @cpp 256 @ce
+@param maxTriangleCount Max triangle count per meshlet
+
+Splits the mesh into small clusters of triangles suitable for cluster-based
+culling on the CPU or for mesh shaders. The default limits are what's
+commonly recommended for mesh shaders. The meshlets are built greedily using
+the vertex-triangle adjacency also used by @ref tipsify() --- each meshlet
+starts from a triangle adjacent to the previous meshlet and is then grown by
+adjacent triangles that add the least new vertices, with ties broken by
+distance to the meshlet center, until either of the limits is reached. Once
+a connected part of the mesh is exhausted, the meshlet continues with the
+next unused triangle in index order.
+
+Each meshlet gets a bounding sphere and a normal cone calculated from its
+triangles with counter-clockwise winding. Degenerate triangles are kept in
+the meshlets but don't contribute to the normal cone. The
+@p indices array is expected to have size divisible by @cpp 3 @ce and all
+values less than size of @p positions.
+@see @ref cullMeshlets()
+*/
+MAGNUM_MESHTOOLS_EXPORT MeshletData buildMeshlets(Containers::ArrayView<const UnsignedInt> indices, Containers::StridedArrayView1D<const Vector3> positions, UnsignedInt maxVertexCount = 64, UnsignedInt maxTriangleCount = 126);
+
+/**
+@brief Cull meshlets against a frustum and a camera position
+@param[in] meshlets         Meshlet data
+@param[in] frustum          Frustum, in the same space as the meshlet data
+@param[in] cameraPosition   Camera position, in the same space as the
+    meshlet data
+@param[out] visible         Where to put IDs of visible meshlets
+@return Count of IDs written to @p visible
+
+Performs a sphere test against all six planes of @p frustum, and for meshlets
+that pass it a backface test using the normal cone: a meshlet with bounding
+sphere center @f$ \boldsymbol{c} @f$, radius @f$ r @f$, cone axis
+@f$ \boldsymbol{a} @f$ and cone half-angle sine @f$ s @f$ is culled if @f[
+    (\boldsymbol{c} - \boldsymbol{p}) \cdot \boldsymbol{a} \ge
+        s |\boldsymbol{c} - \boldsymbol{p}| + r
+@f]
+
+where @f$ \boldsymbol{p} @f$ is @p cameraPosition. The test is conservative
+and works for perspective projection; for orthographic projection pass a
+point far behind the camera along the view direction. The @p visible array
+is expected to have at least as many elements as there are meshlets.
+*/
+MAGNUM_MESHTOOLS_EXPORT std::size_t cullMeshlets(const MeshletData& meshlets, const Frustum& frustum, const Vector3& cameraPosition, Containers::ArrayView<UnsignedInt> visible);
+
+}}
+
+#endif
@@ -0,0 +1,183 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "OptimizeOverdraw.h"
+
+#include <algorithm>
+#include <vector>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/Math/Vector3.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+/* Simulated FIFO post-transform cache, same as in analyzeVertexCache() */
+struct FifoCache {
+    explicit FifoCache(std::size_t vertexCount, UnsignedInt size): timestamp{Containers::ValueInit, vertexCount}, size{size}, time{size + 1} {}
+
+    /* Makes all vertices miss on next access */
+    void flush() { time += size + 1; }
+
+    UnsignedInt access(UnsignedInt v) {
+        if(time - timestamp[v] <= size) return 0;
+        timestamp[v] = time++;
+        return 1;
+    }
+
+    Containers::Array<UnsignedInt> timestamp;
+    UnsignedInt size, time;
+};
+
+template<class T> void optimizeOverdrawInPlaceImplementation(const Containers::ArrayView<T>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const UnsignedInt cacheSize, const Float threshold) {
+    CORRADE_ASSERT(indices.size() % 3 == 0,
+        "MeshTools::optimizeOverdrawInPlace(): index count not divisible by 3", );
+    CORRADE_ASSERT(cacheSize,
+        "MeshTools::optimizeOverdrawInPlace(): cache size can't be zero", );
+    #ifndef CORRADE_NO_ASSERT
+    for(const T index: indices)
+        CORRADE_ASSERT(index < positions.size(),
+            "MeshTools::optimizeOverdrawInPlace(): index" << index << "out of bounds for" << positions.size() << "vertices", );
+    #endif
+
+    const std::size_t triangleCount = indices.size()/3;
+    if(!triangleCount) return;
+
+    /* Hard cluster boundaries are where a triangle misses all three
+       vertices, i.e. where the cache optimizer hit a dead end. Soft
+       boundaries are inside the hard clusters, whenever the ACMR since the
+       last boundary drops below the threshold. The array contains index of
+       first triangle of each cluster, terminated with triangle count. */
+    std::vector<UnsignedInt> hardBoundaries;
+    std::vector<UnsignedInt> clusters;
+    {
+        FifoCache cache{positions.size(), cacheSize};
+        Containers::Array<UnsignedInt> misses{Containers::NoInit, triangleCount};
+        for(std::size_t i = 0; i != triangleCount; ++i) {
+            misses[i] = cache.access(indices[i*3]) +
+                        cache.access(indices[i*3 + 1]) +
+                        cache.access(indices[i*3 + 2]);
+            if(!i || misses[i] == 3) hardBoundaries.push_back(i);
+        }
+        hardBoundaries.push_back(triangleCount);
+
+        for(std::size_t h = 0; h + 1 < hardBoundaries.size(); ++h) {
+            const UnsignedInt begin = hardBoundaries[h];
+            const UnsignedInt end = hardBoundaries[h + 1];
+
+            UnsignedInt clusterMisses = 0;
+            for(UnsignedInt i = begin; i != end; ++i)
+                clusterMisses += misses[i];
+            const Float clusterThreshold = threshold*clusterMisses/(end - begin);
+
+            /* Simulate the cache again, flushing it on each new soft
+               boundary so the ACMR matches what the reordered mesh will
+               have */
+            cache.flush();
+            clusters.push_back(begin);
+            UnsignedInt softBegin = begin;
+            UnsignedInt softMisses = 0;
+            for(UnsignedInt i = begin; i != end; ++i) {
+                softMisses += cache.access(indices[i*3]) +
+                              cache.access(indices[i*3 + 1]) +
+                              cache.access(indices[i*3 + 2]);
+                if(i + 1 != end && softMisses <= clusterThreshold*(i + 1 - softBegin)) {
+                    clusters.push_back(i + 1);
+                    softBegin = i + 1;
+                    softMisses = 0;
+                    cache.flush();
+                }
+            }
+        }
+        clusters.push_back(triangleCount);
+    }
+
+    /* Mesh centroid, area-weighted */
+    Vector3 meshCentroid;
+    Float meshArea = 0.0f;
+    for(std::size_t i = 0; i != triangleCount; ++i) {
+        const Vector3 a = positions[indices[i*3]];
+        const Vector3 b = positions[indices[i*3 + 1]];
+        const Vector3 c = positions[indices[i*3 + 2]];
+        const Float area = Math::cross(b - a, c - a).length();
+        meshCentroid += (a + b + c)*area;
+        meshArea += area;
+    }
+    if(meshArea > 0.0f) meshCentroid /= 3.0f*meshArea;
+
+    /* Occlusion potential of each cluster. The cluster normal is the sum of
+       non-normalized triangle normals, which makes it area-weighted. */
+    const std::size_t clusterCount = clusters.size() - 1;
+    Containers::Array<std::pair<Float, UnsignedInt>> sortKeys{Containers::NoInit, clusterCount};
+    for(std::size_t cluster = 0; cluster != clusterCount; ++cluster) {
+        Vector3 centroid;
+        Vector3 normal;
+        Float area = 0.0f;
+        for(UnsignedInt i = clusters[cluster]; i != clusters[cluster + 1]; ++i) {
+            const Vector3 a = positions[indices[i*3]];
+            const Vector3 b = positions[indices[i*3 + 1]];
+            const Vector3 c = positions[indices[i*3 + 2]];
+            const Vector3 n = Math::cross(b - a, c - a);
+            const Float triangleArea = n.length();
+            centroid += (a + b + c)*triangleArea;
+            normal += n;
+            area += triangleArea;
+        }
+        if(area > 0.0f) centroid /= 3.0f*area;
+        const Float normalLength = normal.length();
+        if(normalLength > 0.0f) normal /= normalLength;
+
+        sortKeys[cluster] = {-Math::dot(centroid - meshCentroid, normal), UnsignedInt(cluster)};
+    }
+
+    /* Sort the clusters with highest potential first, keeping the original
+       order for clusters with the same potential */
+    std::stable_sort(sortKeys.begin(), sortKeys.end(), [](const std::pair<Float, UnsignedInt>& a, const std::pair<Float, UnsignedInt>& b) {
+        return a.first < b.first;
+    });
+
+    /* Write the clusters in the new order */
+    Containers::Array<T> original{Containers::NoInit, indices.size()};
+    std::copy(indices.begin(), indices.end(), original.begin());
+    T* out = indices.begin();
+    for(const std::pair<Float, UnsignedInt>& key: sortKeys)
+        out = std::copy(original + clusters[key.second]*3, original + clusters[key.second + 1]*3, out);
+}
+
+}
+
+void optimizeOverdrawInPlace(const Containers::ArrayView<UnsignedInt>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const UnsignedInt cacheSize, const Float threshold) {
+    optimizeOverdrawInPlaceImplementation(indices, positions, cacheSize, threshold);
+}
+
+void optimizeOverdrawInPlace(const Containers::ArrayView<UnsignedShort>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const UnsignedInt cacheSize, const Float threshold) {
+    optimizeOverdrawInPlaceImplementation(indices, positions, cacheSize, threshold);
+}
+
+}}
@@ -0,0 +1,79 @@
+#ifndef Magnum_MeshTools_OptimizeOverdraw_h
+#define Magnum_MeshTools_OptimizeOverdraw_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::MeshTools::optimizeOverdrawInPlace()
+ */
+
+#include <Corrade/Containers/StridedArrayView.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/MeshTools/visibility.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Optimize the mesh for reduced overdraw
+@param[in,out] indices  Triangle indices to operate on
+@param[in] positions    Vertex positions
+@param[in] cacheSize    Post-transform vertex cache size
+@param[in] threshold    Allowed ACMR degradation
+
+Reorders clusters of triangles so the ones that are likely to occlude others
+are drawn first, without depending on the view direction. Algorithm used:
+*Pedro V. Sander, Diego Nehab, and Joshua Barczak --- Fast Triangle Reordering
+for Vertex Locality and Reduced Overdraw, SIGGRAPH 2007,
+http://gfx.cs.princeton.edu/pubs/Sander_2007_%3ETR/index.php*.
+
+The index array is expected to be already optimized for the post-transform
+vertex cache using @ref tipsify() or @ref optimizeVertexCacheInPlace(). It's
+first split into clusters at points where the simulated FIFO cache of
+@p cacheSize entries gets flushed. Each cluster is then further split at
+points where its average cache miss ratio is below @p threshold times the
+ratio of the whole cluster --- the default @cpp 1.05f @ce allows ACMR to get
+about 5% worse in exchange for smaller clusters and thus better overdraw
+reduction, @cpp 1.0f @ce keeps the ACMR unchanged. The clusters are then
+sorted by their occlusion potential, which is the dot product of the
+area-weighted cluster normal with a vector from mesh centroid to cluster
+centroid.
+
+The @p indices array is expected to have size divisible by @cpp 3 @ce and all
+values less than size of @p positions.
+@see @ref analyzeVertexCache()
+*/
+void MAGNUM_MESHTOOLS_EXPORT optimizeOverdrawInPlace(const Containers::ArrayView<UnsignedInt>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, UnsignedInt cacheSize, Float threshold = 1.05f);
+
+/**
+@overload
+
+Vertex count is expected to be representable in 16 bits.
+*/
+void MAGNUM_MESHTOOLS_EXPORT optimizeOverdrawInPlace(const Containers::ArrayView<UnsignedShort>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, UnsignedInt cacheSize, Float threshold = 1.05f);
+
+}}
+
+#endif
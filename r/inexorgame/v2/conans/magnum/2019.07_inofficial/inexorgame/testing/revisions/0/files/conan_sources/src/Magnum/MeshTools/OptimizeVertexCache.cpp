@@ -0,0 +1,235 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "OptimizeVertexCache.h"
+
+#include <cmath>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+/* Constants from the paper */
+constexpr std::size_t CacheSize = 32;
+constexpr std::size_t MaxValence = 32;
+constexpr Float CacheDecayPower = 1.5f;
+constexpr Float LastTriangleScore = 0.75f;
+constexpr Float ValenceBoostScale = 2.0f;
+constexpr Float ValenceBoostPower = 0.5f;
+
+/* Score tables, position 0 in the cache table is for vertices not in cache,
+   position 0 in the valence table is for vertices without live triangles */
+struct ScoreTables {
+    ScoreTables();
+
+    Float cache[CacheSize + 1];
+    Float valence[MaxValence + 1];
+};
+
+ScoreTables::ScoreTables() {
+    cache[0] = 0.0f;
+    for(std::size_t i = 0; i != CacheSize; ++i) {
+        /* Vertices used in the last triangle get a fixed score to avoid
+           preferring the same triangle over and over */
+        if(i < 3) cache[i + 1] = LastTriangleScore;
+        else cache[i + 1] = std::pow(1.0f - Float(i - 3)/(CacheSize - 3), CacheDecayPower);
+    }
+
+    valence[0] = -1.0f;
+    for(std::size_t i = 1; i <= MaxValence; ++i)
+        valence[i] = ValenceBoostScale*std::pow(Float(i), -ValenceBoostPower);
+}
+
+inline Float vertexScore(const ScoreTables& tables, Int cachePosition, UnsignedInt liveTriangleCount) {
+    if(!liveTriangleCount) return -1.0f;
+    return tables.cache[cachePosition + 1] + tables.valence[liveTriangleCount < MaxValence ? liveTriangleCount : MaxValence];
+}
+
+template<class T> void optimizeVertexCacheInPlaceImplementation(const Containers::ArrayView<T>& indices, const UnsignedInt vertexCount) {
+    CORRADE_ASSERT(indices.size() % 3 == 0,
+        "MeshTools::optimizeVertexCacheInPlace(): index count not divisible by 3", );
+
+    const std::size_t triangleCount = indices.size()/3;
+    static const ScoreTables tables;
+
+    /* Per-vertex live triangle count and neighbor offset. Neighbors of i-th
+       vertex are in neighbors[neighborOffset[i]] ;
+       neighbors[neighborOffset[i] + liveTriangleCount[i]], emitted triangles
+       get swapped out of the range. */
+    Containers::Array<UnsignedInt> liveTriangleCount{Containers::ValueInit, vertexCount};
+    for(const T index: indices) {
+        CORRADE_ASSERT(index < vertexCount,
+            "MeshTools::optimizeVertexCacheInPlace(): index" << index << "out of bounds for" << vertexCount << "vertices", );
+        ++liveTriangleCount[index];
+    }
+    Containers::Array<UnsignedInt> neighborOffset{Containers::NoInit, vertexCount + 1};
+    neighborOffset[0] = 0;
+    for(std::size_t i = 0; i != vertexCount; ++i)
+        neighborOffset[i + 1] = neighborOffset[i] + liveTriangleCount[i];
+    Containers::Array<UnsignedInt> neighbors{Containers::NoInit, indices.size()};
+    {
+        Containers::Array<UnsignedInt> fill{Containers::NoInit, vertexCount};
+        for(std::size_t i = 0; i != vertexCount; ++i)
+            fill[i] = neighborOffset[i];
+        for(std::size_t i = 0; i != indices.size(); ++i)
+            neighbors[fill[indices[i]]++] = i/3;
+    }
+
+    /* Per-vertex and per-triangle score */
+    Containers::Array<Float> score{Containers::NoInit, vertexCount};
+    for(std::size_t i = 0; i != vertexCount; ++i)
+        score[i] = vertexScore(tables, -1, liveTriangleCount[i]);
+    Containers::Array<Float> triangleScore{Containers::NoInit, triangleCount};
+    for(std::size_t i = 0; i != triangleCount; ++i)
+        triangleScore[i] = score[indices[i*3]] + score[indices[i*3 + 1]] + score[indices[i*3 + 2]];
+
+    /* Emitted triangles are marked with negative score. The output is
+       written to a separate array and copied back at the end. */
+    Containers::Array<T> output{Containers::NoInit, indices.size()};
+
+    /* Simulated LRU cache. Has three more entries for vertices that get
+       pushed out by the newly added triangle. */
+    UnsignedInt cache[CacheSize + 3];
+    std::size_t cacheCount = 0;
+
+    /* Triangle to emit next and cursor for dead-end search */
+    std::size_t bestTriangle = 0;
+    std::size_t deadEndCursor = 0;
+    for(std::size_t out = 0; out != triangleCount; ++out) {
+        /* On dead-end, pick next triangle that wasn't emitted yet in the
+           original order. The cursor only goes forward, so this is linear
+           in total. */
+        if(bestTriangle == ~std::size_t{}) {
+            while(triangleScore[deadEndCursor] < 0.0f) ++deadEndCursor;
+            bestTriangle = deadEndCursor;
+        }
+
+        /* Emit the triangle */
+        const UnsignedInt a = indices[bestTriangle*3];
+        const UnsignedInt b = indices[bestTriangle*3 + 1];
+        const UnsignedInt c = indices[bestTriangle*3 + 2];
+        output[out*3] = a;
+        output[out*3 + 1] = b;
+        output[out*3 + 2] = c;
+        triangleScore[bestTriangle] = -1.0f;
+
+        /* Remove the triangle from adjacency of its vertices */
+        for(const UnsignedInt v: {a, b, c}) {
+            UnsignedInt* const begin = neighbors + neighborOffset[v];
+            UnsignedInt* const end = begin + liveTriangleCount[v];
+            for(UnsignedInt* t = begin; t != end; ++t) if(*t == bestTriangle) {
+                *t = *(end - 1);
+                break;
+            }
+            --liveTriangleCount[v];
+        }
+
+        /* Put the triangle vertices to front of the cache, move the rest
+           back, skipping the vertices that were just added */
+        UnsignedInt newCache[CacheSize + 3]{a, b, c};
+        std::size_t newCacheCount = 3;
+        for(std::size_t i = 0; i != cacheCount; ++i) {
+            const UnsignedInt v = cache[i];
+            if(v != a && v != b && v != c)
+                newCache[newCacheCount++] = v;
+        }
+
+        /* Update vertex scores and scores of their live triangles, find the
+           best one */
+        bestTriangle = ~std::size_t{};
+        Float bestScore = -1.0f;
+        for(std::size_t i = 0; i != newCacheCount; ++i) {
+            const UnsignedInt v = newCache[i];
+            const Float newScore = vertexScore(tables, i < CacheSize ? Int(i) : -1, liveTriangleCount[v]);
+            const Float scoreDelta = newScore - score[v];
+            score[v] = newScore;
+
+            for(const UnsignedInt* t = neighbors + neighborOffset[v], *end = t + liveTriangleCount[v]; t != end; ++t) {
+                triangleScore[*t] += scoreDelta;
+                if(triangleScore[*t] > bestScore) {
+                    bestScore = triangleScore[*t];
+                    bestTriangle = *t;
+                }
+            }
+        }
+
+        /* Keep only vertices that fit into the cache */
+        cacheCount = newCacheCount < CacheSize ? newCacheCount : CacheSize;
+        for(std::size_t i = 0; i != cacheCount; ++i) cache[i] = newCache[i];
+    }
+
+    for(std::size_t i = 0; i != indices.size(); ++i)
+        indices[i] = output[i];
+}
+
+template<class T> VertexCacheStatistics analyzeVertexCacheImplementation(const Containers::ArrayView<const T>& indices, const UnsignedInt vertexCount, const UnsignedInt cacheSize) {
+    CORRADE_ASSERT(indices.size() % 3 == 0,
+        "MeshTools::analyzeVertexCache(): index count not divisible by 3", {});
+    CORRADE_ASSERT(cacheSize,
+        "MeshTools::analyzeVertexCache(): cache size can't be zero", {});
+
+    /* A vertex is in the FIFO cache if less than cacheSize other vertices
+       were added after it. Zero timestamp means never transformed. */
+    Containers::Array<UnsignedInt> timestamp{Containers::ValueInit, vertexCount};
+    UnsignedInt time = cacheSize + 1;
+    UnsignedInt referencedCount = 0;
+    for(const T index: indices) {
+        CORRADE_ASSERT(index < vertexCount,
+            "MeshTools::analyzeVertexCache(): index" << index << "out of bounds for" << vertexCount << "vertices", {});
+        if(!timestamp[index]) ++referencedCount;
+        if(time - timestamp[index] > cacheSize)
+            timestamp[index] = time++;
+    }
+
+    VertexCacheStatistics out;
+    out.vertexTransformCount = time - cacheSize - 1;
+    out.acmr = indices.empty() ? 0.0f : Float(out.vertexTransformCount)/(indices.size()/3);
+    out.atvr = referencedCount ? Float(out.vertexTransformCount)/referencedCount : 0.0f;
+    return out;
+}
+
+}
+
+void optimizeVertexCacheInPlace(const Containers::ArrayView<UnsignedInt>& indices, const UnsignedInt vertexCount) {
+    optimizeVertexCacheInPlaceImplementation(indices, vertexCount);
+}
+
+void optimizeVertexCacheInPlace(const Containers::ArrayView<UnsignedShort>& indices, const UnsignedInt vertexCount) {
+    optimizeVertexCacheInPlaceImplementation(indices, vertexCount);
+}
+
+VertexCacheStatistics analyzeVertexCache(const Containers::ArrayView<const UnsignedInt>& indices, const UnsignedInt vertexCount, const UnsignedInt cacheSize) {
+    return analyzeVertexCacheImplementation(indices, vertexCount, cacheSize);
+}
+
+VertexCacheStatistics analyzeVertexCache(const Containers::ArrayView<const UnsignedShort>& indices, const UnsignedInt vertexCount, const UnsignedInt cacheSize) {
+    return analyzeVertexCacheImplementation(indices, vertexCount, cacheSize);
+}
+
+}}
@@ -0,0 +1,115 @@
+#ifndef Magnum_MeshTools_OptimizeVertexCache_h
+#define Magnum_MeshTools_OptimizeVertexCache_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::MeshTools::optimizeVertexCacheInPlace(), @ref Magnum::MeshTools::analyzeVertexCache(), struct @ref Magnum::MeshTools::VertexCacheStatistics
+ */
+
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/MeshTools/visibility.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Optimize the mesh for post-transform vertex cache
+@param[in,out] indices  Triangle indices to operate on
+@param[in] vertexCount  Vertex count
+
+Rearranges the index array for better usage of post-transform vertex cache
+using a greedy score-based algorithm: *Tom Forsyth --- Linear-Speed Vertex
+Cache Optimisation, 2006, https://tomforsyth1000.github.io/papers/fast_vert_cache_opt.html*.
+Each vertex is scored based on its position in a simulated LRU cache of
+@cpp 32 @ce entries and on count of its remaining triangles, the triangle
+with highest score of its vertices is emitted next. Compared to
+@ref tipsify() the result isn't tuned for one particular cache size, which
+makes it a better choice when the target hardware is not known in advance.
+
+The @p indices array is expected to have size divisible by @cpp 3 @ce and all
+values less than @p vertexCount. Vertex data are not touched, use
+@ref optimizeVertexFetchInPlace() afterwards to reorder them for better memory
+locality.
+@see @ref analyzeVertexCache(), @ref optimizeOverdrawInPlace()
+*/
+void MAGNUM_MESHTOOLS_EXPORT optimizeVertexCacheInPlace(const Containers::ArrayView<UnsignedInt>& indices, UnsignedInt vertexCount);
+
+/**
+@overload
+
+Vertex count is expected to be representable in 16 bits.
+*/
+void MAGNUM_MESHTOOLS_EXPORT optimizeVertexCacheInPlace(const Containers::ArrayView<UnsignedShort>& indices, UnsignedInt vertexCount);
+
+/**
+@brief Post-transform vertex cache statistics
+
+@see @ref analyzeVertexCache()
+*/
+struct VertexCacheStatistics {
+    /** @brief Count of vertex shader invocations */
+    UnsignedInt vertexTransformCount;
+
+    /**
+     * @brief Average cache miss ratio
+     *
+     * Vertex transform count divided by triangle count. Ranges from
+     * @cpp 3.0f @ce, which is the worst case, down to about @cpp 0.5f @ce
+     * for large regular meshes.
+     */
+    Float acmr;
+
+    /**
+     * @brief Average transform to vertex ratio
+     *
+     * Vertex transform count divided by count of vertices referenced by the
+     * index array. @cpp 1.0f @ce is the ideal value, where each vertex is
+     * transformed only once.
+     */
+    Float atvr;
+};
+
+/**
+@brief Analyze post-transform vertex cache efficiency
+@param indices      Triangle indices
+@param vertexCount  Vertex count
+@param cacheSize    Post-transform vertex cache size
+
+Simulates a FIFO cache of @p cacheSize entries, which is what most GPUs
+implement, and counts the cache misses. Useful for comparing the effect of
+@ref tipsify() and @ref optimizeVertexCacheInPlace() without having to run on
+a GPU. The @p indices array is expected to have size divisible by @cpp 3 @ce
+and all values less than @p vertexCount.
+*/
+VertexCacheStatistics MAGNUM_MESHTOOLS_EXPORT analyzeVertexCache(const Containers::ArrayView<const UnsignedInt>& indices, UnsignedInt vertexCount, UnsignedInt cacheSize);
+
+/** @overload */
+VertexCacheStatistics MAGNUM_MESHTOOLS_EXPORT analyzeVertexCache(const Containers::ArrayView<const UnsignedShort>& indices, UnsignedInt vertexCount, UnsignedInt cacheSize);
+
+}}
+
+#endif
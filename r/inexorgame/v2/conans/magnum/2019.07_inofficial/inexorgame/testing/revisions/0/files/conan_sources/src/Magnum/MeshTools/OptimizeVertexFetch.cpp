@@ -0,0 +1,95 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "OptimizeVertexFetch.h"
+
+#include <cstring>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+template<class T> std::size_t optimizeVertexFetchRemapInPlaceImplementation(const Containers::ArrayView<T>& indices, const Containers::StridedArrayView1D<UnsignedInt>& remap) {
+    for(UnsignedInt& i: remap) i = ~UnsignedInt{};
+
+    UnsignedInt count = 0;
+    for(T& index: indices) {
+        CORRADE_ASSERT(index < remap.size(),
+            "MeshTools::optimizeVertexFetchRemapInPlace(): index" << index << "out of bounds for" << remap.size() << "vertices", {});
+        UnsignedInt& target = remap[index];
+        if(target == ~UnsignedInt{}) target = count++;
+        index = T(target);
+    }
+
+    return count;
+}
+
+template<class T> std::size_t optimizeVertexFetchInPlaceImplementation(const Containers::ArrayView<T>& indices, const Containers::StridedArrayView2D<char>& vertices) {
+    CORRADE_ASSERT(vertices.stride()[1] == 1,
+        "MeshTools::optimizeVertexFetchInPlace(): second vertex view dimension is not contiguous", {});
+
+    const std::size_t vertexCount = vertices.size()[0];
+    const std::size_t vertexSize = vertices.size()[1];
+    Containers::Array<UnsignedInt> remap{Containers::NoInit, vertexCount};
+    const std::size_t count = optimizeVertexFetchRemapInPlaceImplementation(indices, Containers::StridedArrayView1D<UnsignedInt>{remap});
+
+    /* Copy the referenced vertices to a contiguous scratch buffer in the
+       new order and then back */
+    char* const begin = static_cast<char*>(vertices.data());
+    const std::ptrdiff_t stride = vertices.stride()[0];
+    Containers::Array<char> scratch{Containers::NoInit, count*vertexSize};
+    for(std::size_t i = 0; i != vertexCount; ++i) {
+        if(remap[i] == ~UnsignedInt{}) continue;
+        std::memcpy(scratch + remap[i]*vertexSize, begin + std::ptrdiff_t(i)*stride, vertexSize);
+    }
+    for(std::size_t i = 0; i != count; ++i)
+        std::memcpy(begin + std::ptrdiff_t(i)*stride, scratch + i*vertexSize, vertexSize);
+
+    return count;
+}
+
+}
+
+std::size_t optimizeVertexFetchRemapInPlace(const Containers::ArrayView<UnsignedInt>& indices, const Containers::StridedArrayView1D<UnsignedInt>& remap) {
+    return optimizeVertexFetchRemapInPlaceImplementation(indices, remap);
+}
+
+std::size_t optimizeVertexFetchRemapInPlace(const Containers::ArrayView<UnsignedShort>& indices, const Containers::StridedArrayView1D<UnsignedInt>& remap) {
+    return optimizeVertexFetchRemapInPlaceImplementation(indices, remap);
+}
+
+std::size_t optimizeVertexFetchInPlace(const Containers::ArrayView<UnsignedInt>& indices, const Containers::StridedArrayView2D<char>& vertices) {
+    return optimizeVertexFetchInPlaceImplementation(indices, vertices);
+}
+
+std::size_t optimizeVertexFetchInPlace(const Containers::ArrayView<UnsignedShort>& indices, const Containers::StridedArrayView2D<char>& vertices) {
+    return optimizeVertexFetchInPlaceImplementation(indices, vertices);
+}
+
+}}
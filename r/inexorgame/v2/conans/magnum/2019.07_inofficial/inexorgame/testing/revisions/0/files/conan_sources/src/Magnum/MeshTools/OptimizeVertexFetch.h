@@ -0,0 +1,93 @@
+#ifndef Magnum_MeshTools_OptimizeVertexFetch_h
+#define Magnum_MeshTools_OptimizeVertexFetch_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::MeshTools::optimizeVertexFetchInPlace(), @ref Magnum::MeshTools::optimizeVertexFetchRemapInPlace()
+ */
+
+#include <Corrade/Containers/StridedArrayView.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/MeshTools/visibility.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Optimize the mesh for vertex fetch
+@param[in,out] indices  Index array to operate on
+@param[out] remap       Vertex remapping table
+@return Count of vertices referenced by the index array
+
+Calculates a vertex remapping table that puts the vertices in the order in
+which they are first referenced by @p indices and updates the index array to
+match it. After reordering the vertex data with the table, vertices used by
+consecutive triangles are close to each other in memory, which improves
+pre-transform vertex cache efficiency. It's meant to be used after
+@ref tipsify() or @ref optimizeVertexCacheInPlace(), as these don't touch
+the vertex data.
+
+The @p remap array is expected to have the same size as the vertex data.
+Vertex at position @cpp i @ce in the original data should be put to position
+@cpp remap[i] @ce, vertices not referenced by the index array get
+@cpp 0xffffffffu @ce and can be dropped. Useful when the vertex data are in
+multiple non-interleaved arrays, otherwise use
+@ref optimizeVertexFetchInPlace() which does the reordering for you.
+*/
+std::size_t MAGNUM_MESHTOOLS_EXPORT optimizeVertexFetchRemapInPlace(const Containers::ArrayView<UnsignedInt>& indices, const Containers::StridedArrayView1D<UnsignedInt>& remap);
+
+/**
+@overload
+
+Vertex count is expected to be representable in 16 bits.
+*/
+std::size_t MAGNUM_MESHTOOLS_EXPORT optimizeVertexFetchRemapInPlace(const Containers::ArrayView<UnsignedShort>& indices, const Containers::StridedArrayView1D<UnsignedInt>& remap);
+
+/**
+@brief Optimize the mesh for vertex fetch
+@param[in,out] indices  Index array to operate on
+@param[in,out] vertices Vertex data to operate on
+@return Count of vertices referenced by the index array
+
+Calls @ref optimizeVertexFetchRemapInPlace() and reorders the @p vertices
+accordingly. The first dimension of @p vertices is the vertices, the second
+dimension is bytes of each vertex and is expected to be contiguous, which
+means it can be used to reorder whole interleaved vertices at once. Vertices
+referenced by the index array are moved to the front, the rest is left in
+unspecified state and can be dropped.
+*/
+std::size_t MAGNUM_MESHTOOLS_EXPORT optimizeVertexFetchInPlace(const Containers::ArrayView<UnsignedInt>& indices, const Containers::StridedArrayView2D<char>& vertices);
+
+/**
+@overload
+
+Vertex count is expected to be representable in 16 bits.
+*/
+std::size_t MAGNUM_MESHTOOLS_EXPORT optimizeVertexFetchInPlace(const Containers::ArrayView<UnsignedShort>& indices, const Containers::StridedArrayView2D<char>& vertices);
+
+}}
+
+#endif
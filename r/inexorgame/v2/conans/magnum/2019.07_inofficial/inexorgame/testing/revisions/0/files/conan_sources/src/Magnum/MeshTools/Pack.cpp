@@ -0,0 +1,239 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "Pack.h"
+
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/Packing.h"
+#include "Magnum/Math/Range.h"
+
+#ifdef MAGNUM_TARGET_GL
+#include "Magnum/Trade/MeshData3D.h"
+
+/* This header is included only privately and doesn't introduce any linker
+   dependency, thus it's completely safe */
+#include "Magnum/Shaders/Generic.h"
+#endif
+
+namespace Magnum { namespace MeshTools {
+
+Matrix4 packPositionsInto(const Containers::StridedArrayView1D<const Vector3> positions, const Containers::StridedArrayView1D<Math::Vector3<UnsignedShort>> out) {
+    CORRADE_ASSERT(positions.size() == out.size(),
+        "MeshTools::packPositionsInto(): expected" << positions.size() << "output items but got" << out.size(), {});
+
+    if(positions.empty()) return {};
+
+    /* Bounds of the whole mesh, scale uniformly by the largest dimension */
+    Range3D bounds{positions[0], positions[0]};
+    for(const Vector3& position: positions) {
+        bounds.min() = Math::min(bounds.min(), position);
+        bounds.max() = Math::max(bounds.max(), position);
+    }
+    Float size = bounds.size().max();
+    if(size == 0.0f) size = 1.0f;
+    const Float invertedSize = 1.0f/size;
+
+    for(std::size_t i = 0; i != positions.size(); ++i)
+        out[i] = Math::pack<Math::Vector3<UnsignedShort>>(Math::clamp((positions[i] - bounds.min())*invertedSize, 0.0f, 1.0f));
+
+    return Matrix4::translation(bounds.min())*Matrix4::scaling(Vector3{size});
+}
+
+void packNormalsInto(const Containers::StridedArrayView1D<const Vector3> normals, const Containers::StridedArrayView1D<UnsignedInt> out) {
+    CORRADE_ASSERT(normals.size() == out.size(),
+        "MeshTools::packNormalsInto(): expected" << normals.size() << "output items but got" << out.size(), );
+
+    for(std::size_t i = 0; i != normals.size(); ++i) {
+        const Vector3i packed = Math::pack<Vector3i, 10>(Math::clamp(normals[i], -1.0f, 1.0f));
+        out[i] = (UnsignedInt(packed.x()) & 0x3ff) |
+                 (UnsignedInt(packed.y()) & 0x3ff) << 10 |
+                 (UnsignedInt(packed.z()) & 0x3ff) << 20;
+    }
+}
+
+void packNormalsInto(const Containers::StridedArrayView1D<const Vector3> normals, const Containers::StridedArrayView1D<Math::Vector4<Byte>> out) {
+    CORRADE_ASSERT(normals.size() == out.size(),
+        "MeshTools::packNormalsInto(): expected" << normals.size() << "output items but got" << out.size(), );
+
+    for(std::size_t i = 0; i != normals.size(); ++i)
+        out[i] = {Math::pack<Math::Vector3<Byte>>(Math::clamp(normals[i], -1.0f, 1.0f)), 0};
+}
+
+void packNormalsOctahedralInto(const Containers::StridedArrayView1D<const Vector3> normals, const Containers::StridedArrayView1D<Math::Vector2<Short>> out) {
+    CORRADE_ASSERT(normals.size() == out.size(),
+        "MeshTools::packNormalsOctahedralInto(): expected" << normals.size() << "output items but got" << out.size(), );
+
+    for(std::size_t i = 0; i != normals.size(); ++i) {
+        const Vector3& normal = normals[i];
+
+        /* Project onto the octahedron, zero vectors map to the center */
+        const Float length = Math::abs(normal).sum();
+        if(length == 0.0f) {
+            out[i] = {};
+            continue;
+        }
+        Vector2 encoded = normal.xy()/length;
+
+        /* Fold the lower hemisphere over the diagonals */
+        if(normal.z() < 0.0f) encoded = (Vector2{1.0f} - Math::abs(encoded.flipped()))*
+            Vector2{encoded.x() >= 0.0f ? 1.0f : -1.0f,
+                    encoded.y() >= 0.0f ? 1.0f : -1.0f};
+
+        out[i] = Math::pack<Math::Vector2<Short>>(Math::clamp(encoded, -1.0f, 1.0f));
+    }
+}
+
+void packTextureCoordinatesInto(const Containers::StridedArrayView1D<const Vector2> textureCoordinates, const Containers::StridedArrayView1D<Math::Vector2<UnsignedShort>> out, const PackedTextureCoordinateFormat format) {
+    CORRADE_ASSERT(textureCoordinates.size() == out.size(),
+        "MeshTools::packTextureCoordinatesInto(): expected" << textureCoordinates.size() << "output items but got" << out.size(), );
+
+    if(format == PackedTextureCoordinateFormat::Half) {
+        for(std::size_t i = 0; i != textureCoordinates.size(); ++i)
+            out[i] = Math::packHalf(textureCoordinates[i]);
+    } else {
+        for(std::size_t i = 0; i != textureCoordinates.size(); ++i)
+            out[i] = Math::pack<Math::Vector2<UnsignedShort>>(Math::clamp(textureCoordinates[i], 0.0f, 1.0f));
+    }
+}
+
+void packColorsInto(const Containers::StridedArrayView1D<const Color4> colors, const Containers::StridedArrayView1D<Color4ub> out) {
+    CORRADE_ASSERT(colors.size() == out.size(),
+        "MeshTools::packColorsInto(): expected" << colors.size() << "output items but got" << out.size(), );
+
+    for(std::size_t i = 0; i != colors.size(); ++i)
+        out[i] = Math::pack<Color4ub>(Math::clamp(colors[i], 0.0f, 1.0f));
+}
+
+#ifdef MAGNUM_TARGET_GL
+PackedVertexData3D packVertices(const Trade::MeshData3D& meshData, const PackedNormalFormat normalFormat, const PackedTextureCoordinateFormat textureCoordinateFormat) {
+    #ifdef MAGNUM_TARGET_GLES2
+    CORRADE_ASSERT(normalFormat != PackedNormalFormat::Int2101010Rev,
+        "MeshTools::packVertices(): packed 10.10.10.2 normals are not available on OpenGL ES 2.0", {});
+    #endif
+    #if defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2)
+    CORRADE_ASSERT(textureCoordinateFormat != PackedTextureCoordinateFormat::Half,
+        "MeshTools::packVertices(): half-float texture coordinates are not available on WebGL 1.0", {});
+    #endif
+
+    const std::vector<Vector3>& positions = meshData.positions(0);
+
+    /* Positions have two bytes of padding, everything else is four bytes */
+    GLsizei stride = 8;
+    const GLintptr normalOffset = stride;
+    if(meshData.hasNormals()) stride += 4;
+    const GLintptr textureCoordinateOffset = stride;
+    if(meshData.hasTextureCoords2D()) stride += 4;
+    const GLintptr colorOffset = stride;
+    if(meshData.hasColors()) stride += 4;
+
+    PackedVertexData3D out{Containers::Array<char>{Containers::ValueInit, std::size_t(stride)*positions.size()}, stride, {}, {}};
+
+    /* Positions */
+    out.positionTransformation = packPositionsInto(
+        Containers::arrayView(positions.data(), positions.size()),
+        {out.data, reinterpret_cast<Math::Vector3<UnsignedShort>*>(out.data.data()), positions.size(), stride});
+    out.attributes.emplace_back(GLintptr{}, GL::DynamicAttribute{
+        GL::DynamicAttribute::Kind::GenericNormalized,
+        Shaders::Generic3D::Position::Location,
+        GL::DynamicAttribute::Components::Three,
+        GL::DynamicAttribute::DataType::UnsignedShort});
+
+    /* Normals */
+    if(meshData.hasNormals()) {
+        const std::vector<Vector3>& normals = meshData.normals(0);
+        const Containers::StridedArrayView1D<const Vector3> input = Containers::arrayView(normals.data(), normals.size());
+        char* const data = out.data + normalOffset;
+        if(normalFormat == PackedNormalFormat::Octahedral) {
+            packNormalsOctahedralInto(input, {out.data, reinterpret_cast<Math::Vector2<Short>*>(data), normals.size(), stride});
+            out.attributes.emplace_back(normalOffset, GL::DynamicAttribute{
+                GL::DynamicAttribute::Kind::GenericNormalized,
+                Shaders::Generic3D::Normal::Location,
+                GL::DynamicAttribute::Components::Two,
+                GL::DynamicAttribute::DataType::Short});
+        } else if(normalFormat == PackedNormalFormat::Byte) {
+            packNormalsInto(input, {out.data, reinterpret_cast<Math::Vector4<Byte>*>(data), normals.size(), stride});
+            out.attributes.emplace_back(normalOffset, GL::DynamicAttribute{
+                GL::DynamicAttribute::Kind::GenericNormalized,
+                Shaders::Generic3D::Normal::Location,
+                GL::DynamicAttribute::Components::Three,
+                GL::DynamicAttribute::DataType::Byte});
+        }
+        #ifndef MAGNUM_TARGET_GLES2
+        else {
+            packNormalsInto(input, {out.data, reinterpret_cast<UnsignedInt*>(data), normals.size(), stride});
+            out.attributes.emplace_back(normalOffset, GL::DynamicAttribute{
+                GL::DynamicAttribute::Kind::GenericNormalized,
+                Shaders::Generic3D::Normal::Location,
+                GL::DynamicAttribute::Components::Four,
+                GL::DynamicAttribute::DataType::Int2101010Rev});
+        }
+        #endif
+    }
+
+    /* Texture coordinates */
+    if(meshData.hasTextureCoords2D()) {
+        const std::vector<Vector2>& textureCoordinates = meshData.textureCoords2D(0);
+        packTextureCoordinatesInto(
+            Containers::arrayView(textureCoordinates.data(), textureCoordinates.size()),
+            {out.data, reinterpret_cast<Math::Vector2<UnsignedShort>*>(out.data + textureCoordinateOffset), textureCoordinates.size(), stride},
+            textureCoordinateFormat);
+        out.attributes.emplace_back(textureCoordinateOffset, GL::DynamicAttribute{
+            #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+            textureCoordinateFormat == PackedTextureCoordinateFormat::Half ?
+                GL::DynamicAttribute::Kind::Generic :
+            #endif
+                GL::DynamicAttribute::Kind::GenericNormalized,
+            Shaders::Generic3D::TextureCoordinates::Location,
+            GL::DynamicAttribute::Components::Two,
+            #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+            textureCoordinateFormat == PackedTextureCoordinateFormat::Half ?
+                GL::DynamicAttribute::DataType::HalfFloat :
+            #endif
+                GL::DynamicAttribute::DataType::UnsignedShort});
+    }
+
+    /* Colors */
+    if(meshData.hasColors()) {
+        const std::vector<Color4>& colors = meshData.colors(0);
+        packColorsInto(
+            Containers::arrayView(colors.data(), colors.size()),
+            {out.data, reinterpret_cast<Color4ub*>(out.data + colorOffset), colors.size(), stride});
+        out.attributes.emplace_back(colorOffset, GL::DynamicAttribute{
+            GL::DynamicAttribute::Kind::GenericNormalized,
+            Shaders::Generic3D::Color4::Location,
+            GL::DynamicAttribute::Components::Four,
+            GL::DynamicAttribute::DataType::UnsignedByte});
+    }
+
+    return out;
+}
+#endif
+
+}}
@@ -0,0 +1,290 @@
+#ifndef Magnum_MeshTools_Pack_h
+#define Magnum_MeshTools_Pack_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::MeshTools::packPositionsInto(), @ref Magnum::MeshTools::packNormalsInto(), @ref Magnum::MeshTools::packNormalsOctahedralInto(), @ref Magnum::MeshTools::packTextureCoordinatesInto(), @ref Magnum::MeshTools::packColorsInto(), @ref Magnum::MeshTools::packVertices(), enum @ref Magnum::MeshTools::PackedNormalFormat, @ref Magnum::MeshTools::PackedTextureCoordinateFormat, struct @ref Magnum::MeshTools::PackedVertexData3D
+ */
+
+#include <Corrade/Containers/StridedArrayView.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/MeshTools/visibility.h"
+
+#ifdef MAGNUM_TARGET_GL
+#include <utility>
+#include <vector>
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/GL/Attribute.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Trade/Trade.h"
+#endif
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Packed normal format
+
+@see @ref packNormalsInto(), @ref packVertices()
+*/
+enum class PackedNormalFormat: UnsignedByte {
+    /**
+     * Signed normalized 10.10.10.2 packed integer stored in an
+     * @ref Magnum::UnsignedInt "UnsignedInt", with the last component
+     * being zero. Four bytes per normal, directly usable by the builtin
+     * shaders.
+     * @requires_gles30 Packed attributes are not available in OpenGL ES 2.0.
+     * @requires_webgl20 Packed attributes are not available in WebGL 1.0.
+     */
+    Int2101010Rev,
+
+    /**
+     * Signed normalized bytes stored in a @cpp Math::Vector4<Byte> @ce, with
+     * the last component being zero. Four bytes per normal with less
+     * precision than @ref PackedNormalFormat::Int2101010Rev, but available
+     * everywhere and directly usable by the builtin shaders.
+     */
+    Byte,
+
+    /**
+     * Octahedral encoding stored as two signed normalized shorts in a
+     * @cpp Math::Vector2<Short> @ce. Four bytes per normal with the best
+     * precision of all formats, but the shader has to decode it, which the
+     * builtin shaders don't do --- see @ref packNormalsOctahedralInto() for
+     * the decoding routine.
+     */
+    Octahedral
+};
+
+/**
+@brief Packed texture coordinate format
+
+@see @ref packTextureCoordinatesInto(), @ref packVertices()
+*/
+enum class PackedTextureCoordinateFormat: UnsignedByte {
+    /**
+     * Half-floats stored in a @cpp Math::Vector2<UnsignedShort> @ce.
+     * Suitable also for repeating textures, but the precision drops with
+     * larger values.
+     * @requires_gl30 Extension @gl_extension{ARB,half_float_vertex}
+     * @requires_gles30 Extension @gl_extension{OES,vertex_half_float} in
+     *      OpenGL ES 2.0
+     * @requires_webgl20 Half float vertex attributes are not available in
+     *      WebGL 1.0.
+     */
+    Half,
+
+    /**
+     * Unsigned normalized shorts stored in a
+     * @cpp Math::Vector2<UnsignedShort> @ce. Uniform precision, but values
+     * outside of the @f$ [0, 1] @f$ range get clamped.
+     */
+    UnsignedShortNormalized
+};
+
+/**
+@brief Pack positions into an existing array
+@param[in] positions    Vertex positions
+@param[out] out         Where to put the packed positions
+@return Transformation converting the packed positions back to the original
+    space
+
+Quantizes the positions to unsigned normalized 16-bit integers relative to
+bounds of the whole mesh. In order to keep normals valid, the scale is the
+same in all three directions and equal to size of the largest bounding box
+dimension. The returned transformation is a translation to the minimal
+bounding box corner combined with a uniform scaling, so instead of
+dequantizing the data you can just multiply it into the transformation matrix
+used for rendering. Because the scaling is uniform, it doesn't affect normal
+direction and the normal matrix derived from the combined transformation stays
+valid.
+
+Expects that both views have the same size. An empty input results in an
+identity transformation.
+@see @ref Math::pack(), @ref Math::unpack()
+*/
+MAGNUM_MESHTOOLS_EXPORT Matrix4 packPositionsInto(Containers::StridedArrayView1D<const Vector3> positions, Containers::StridedArrayView1D<Math::Vector3<UnsignedShort>> out);
+
+/**
+@brief Pack normals into 10.10.10.2 integers
+@param[in] normals      Normalized vertex normals
+@param[out] out         Where to put the packed normals
+
+Packs the normals to the signed normalized
+@ref PackedNormalFormat::Int2101010Rev format with X in the lowest bits. Expects
+that both views have the same size.
+*/
+MAGNUM_MESHTOOLS_EXPORT void packNormalsInto(Containers::StridedArrayView1D<const Vector3> normals, Containers::StridedArrayView1D<UnsignedInt> out);
+
+/**
+@brief Pack normals into bytes
+@param[in] normals      Normalized vertex normals
+@param[out] out         Where to put the packed normals
+
+Packs the normals to signed normalized bytes as described in
+@ref PackedNormalFormat::Byte. Expects that both views have the same size.
+*/
+MAGNUM_MESHTOOLS_EXPORT void packNormalsInto(Containers::StridedArrayView1D<const Vector3> normals, Containers::StridedArrayView1D<Math::Vector4<Byte>> out);
+
+/**
+@brief Pack normals using octahedral encoding
+@param[in] normals      Normalized vertex normals
+@param[out] out         Where to put the packed normals
+
+Projects the normals onto an octahedron and unfolds it into a square, as
+described in *Zina H. Cigolle, Sam Donow, Daniel Evangelakos, Michael Mara,
+Morgan McGuire, Quirin Meyer --- A Survey of Efficient Representations for
+Independent Unit Vectors, 2014*, with the result stored as signed normalized
+shorts. Zero vectors are encoded as @f$ (0, 0) @f$, which decodes to
+@f$ (0, 0, 1) @f$. Expects that both views have the same size. The encoded
+normals can be decoded in a shader for example like this:
+
+@code{.glsl}
+vec3 decodeNormal(vec2 e) {
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    float t = max(-n.z, 0.0);
+    n.xy += vec2(n.x >= 0.0 ? -t : t, n.y >= 0.0 ? -t : t);
+    return normalize(n);
+}
+@endcode
+*/
+MAGNUM_MESHTOOLS_EXPORT void packNormalsOctahedralInto(Containers::StridedArrayView1D<const Vector3> normals, Containers::StridedArrayView1D<Math::Vector2<Short>> out);
+
+/**
+@brief Pack texture coordinates into an existing array
+@param[in] textureCoordinates   Vertex texture coordinates
+@param[out] out                 Where to put the packed texture coordinates
+@param[in] format               Packed format
+
+Converts the texture coordinates either to half-floats or to unsigned
+normalized shorts, based on @p format. Expects that both views have the same
+size.
+@see @ref Math::packHalf(), @ref Math::pack()
+*/
+MAGNUM_MESHTOOLS_EXPORT void packTextureCoordinatesInto(Containers::StridedArrayView1D<const Vector2> textureCoordinates, Containers::StridedArrayView1D<Math::Vector2<UnsignedShort>> out, PackedTextureCoordinateFormat format);
+
+/**
+@brief Pack colors into an existing array
+@param[in] colors       Vertex colors
+@param[out] out         Where to put the packed colors
+
+Converts the colors to unsigned normalized bytes, values outside of the
+@f$ [0, 1] @f$ range get clamped. Expects that both views have the same
+size.
+@see @ref Math::pack()
+*/
+MAGNUM_MESHTOOLS_EXPORT void packColorsInto(Containers::StridedArrayView1D<const Color4> colors, Containers::StridedArrayView1D<Color4ub> out);
+
+#if defined(MAGNUM_TARGET_GL) || defined(DOXYGEN_GENERATING_OUTPUT)
+/**
+@brief Packed vertex data
+
+@see @ref packVertices()
+*/
+struct PackedVertexData3D {
+    /** @brief Interleaved vertex data */
+    Containers::Array<char> data;
+
+    /** @brief Vertex stride */
+    GLsizei stride;
+
+    /**
+     * @brief Position transformation
+     *
+     * Has to be multiplied into the transformation used for rendering, see
+     * @ref packPositionsInto() for details.
+     */
+    Matrix4 positionTransformation;
+
+    /**
+     * @brief Attribute offsets and descriptions
+     *
+     * Offset of each attribute in the vertex, together with description
+     * suitable for @ref GL::Mesh::addVertexBuffer(Buffer&, GLintptr, GLsizei, const DynamicAttribute&).
+     * Locations match the @ref Shaders::Generic3D attributes.
+     */
+    std::vector<std::pair<GLintptr, GL::DynamicAttribute>> attributes;
+};
+
+/**
+@brief Pack 3D mesh vertex data
+@param meshData                 Mesh data
+@param normalFormat             Packed normal format
+@param textureCoordinateFormat  Packed texture coordinate format
+
+Interleaves first set of positions, normals, texture coordinates and colors
+of @p meshData into a single buffer, each quantized as following:
+
+-   positions using @ref packPositionsInto(), taking 8 bytes with the last
+    two being padding to keep the following attributes four-byte aligned
+-   normals, if present, using @ref packNormalsInto() or
+    @ref packNormalsOctahedralInto() based on @p normalFormat, taking 4 bytes
+-   texture coordinates, if present, using @ref packTextureCoordinatesInto(),
+    taking 4 bytes
+-   colors, if present, using @ref packColorsInto(), taking 4 bytes
+
+Compared to the 48 bytes per vertex that @ref compile() uses for a mesh with
+all four attributes that's a 2.4x reduction. The index data, if any, are left
+untouched, pass them to @ref compressIndices() to pack them as well. Example
+usage:
+
+@code{.cpp}
+Trade::MeshData3D data = …;
+MeshTools::PackedVertexData3D packed = MeshTools::packVertices(data);
+
+GL::Buffer vertices;
+vertices.setData(packed.data);
+
+GL::Mesh mesh;
+for(const auto& attribute: packed.attributes)
+    mesh.addVertexBuffer(vertices, attribute.first, packed.stride, attribute.second);
+@endcode
+
+@note This function is available only if Magnum is compiled with
+    @ref MAGNUM_TARGET_GL enabled (done by default). See @ref building-features
+    for more information.
+
+@see @ref compilePacked()
+*/
+MAGNUM_MESHTOOLS_EXPORT PackedVertexData3D packVertices(const Trade::MeshData3D& meshData, PackedNormalFormat normalFormat =
+    #ifndef MAGNUM_TARGET_GLES2
+    PackedNormalFormat::Int2101010Rev
+    #else
+    PackedNormalFormat::Byte
+    #endif
+    , PackedTextureCoordinateFormat textureCoordinateFormat =
+    #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+    PackedTextureCoordinateFormat::Half
+    #else
+    PackedTextureCoordinateFormat::UnsignedShortNormalized
+    #endif
+    );
+#endif
+
+}}
+
+#endif
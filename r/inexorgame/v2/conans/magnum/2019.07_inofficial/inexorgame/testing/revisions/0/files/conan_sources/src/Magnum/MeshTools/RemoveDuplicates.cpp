@@ -0,0 +1,108 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "RemoveDuplicates.h"
+
+#include <cstring>
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+/* Hashes the bytes eight at a time, with the MurmurHash3 finalizer at the
+   end. Not cryptographically strong in any way, but good enough for hash
+   table indexing. */
+UnsignedLong hashBytes(const char* data, std::size_t size) {
+    UnsignedLong hash = 0xcbf29ce484222325ull ^ size;
+    for(; size >= 8; data += 8, size -= 8) {
+        UnsignedLong word;
+        std::memcpy(&word, data, 8);
+        hash = (hash ^ word)*0x9e3779b97f4a7c15ull;
+        hash ^= hash >> 32;
+    }
+    if(size) {
+        UnsignedLong word = 0;
+        std::memcpy(&word, data, size);
+        hash = (hash ^ word)*0x9e3779b97f4a7c15ull;
+    }
+
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdull;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ull;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+}
+
+std::size_t removeDuplicatesInPlaceInto(const Containers::StridedArrayView2D<char>& data, const Containers::StridedArrayView1D<UnsignedInt>& indices) {
+    CORRADE_ASSERT(indices.size() == data.size()[0],
+        "MeshTools::removeDuplicatesInPlaceInto(): output index array has" << indices.size() << "elements but expected" << data.size()[0], {});
+    CORRADE_ASSERT(data.stride()[1] == 1,
+        "MeshTools::removeDuplicatesInPlaceInto(): second data view dimension is not contiguous", {});
+
+    const std::size_t dataSize = data.size()[0];
+    const std::size_t typeSize = data.size()[1];
+    char* const begin = static_cast<char*>(data.data());
+    const std::ptrdiff_t stride = data.stride()[0];
+
+    /* Table containing index of the unique element for each hash. The
+       capacity is a power of two at least twice the element count to keep
+       the probe sequences short. */
+    std::size_t capacity = 16;
+    while(capacity < 2*dataSize) capacity <<= 1;
+    const std::size_t mask = capacity - 1;
+    Containers::Array<UnsignedInt> table{Containers::DirectInit, capacity, ~UnsignedInt{}};
+
+    std::size_t count = 0;
+    for(std::size_t i = 0; i != dataSize; ++i) {
+        const char* const element = begin + std::ptrdiff_t(i)*stride;
+
+        /* Find either the same element or an empty slot */
+        std::size_t slot = hashBytes(element, typeSize) & mask;
+        for(; table[slot] != ~UnsignedInt{} && std::memcmp(begin + std::ptrdiff_t(table[slot])*stride, element, typeSize) != 0; slot = (slot + 1) & mask);
+
+        /* Not found, add a new unique element, moving it to the front */
+        if(table[slot] == ~UnsignedInt{}) {
+            table[slot] = count;
+            if(i != count)
+                std::memcpy(begin + std::ptrdiff_t(count)*stride, element, typeSize);
+            ++count;
+        }
+
+        indices[i] = table[slot];
+    }
+
+    return count;
+}
+
+std::pair<Containers::Array<UnsignedInt>, std::size_t> removeDuplicatesInPlace(const Containers::StridedArrayView2D<char>& data) {
+    Containers::Array<UnsignedInt> indices{Containers::NoInit, data.size()[0]};
+    const std::size_t count = removeDuplicatesInPlaceInto(data, Containers::StridedArrayView1D<UnsignedInt>{indices});
+    return {std::move(indices), count};
+}
+
+}}
@@ -26,17 +26,22 @@
 */
 
 /** @file
- * @brief Function @ref Magnum::MeshTools::removeDuplicates()
+ * @brief Function @ref Magnum::MeshTools::removeDuplicates(), @ref Magnum::MeshTools::removeDuplicatesInPlace(), @ref Magnum::MeshTools::removeDuplicatesInPlaceInto(), @ref Magnum::MeshTools::removeDuplicatesFuzzyInPlace(), @ref Magnum::MeshTools::removeDuplicatesFuzzyInPlaceInto()
  */
 
 #include <limits>
 #include <numeric>
 #include <unordered_map>
+#include <utility>
 #include <vector>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Assert.h>
 #include <Corrade/Utility/MurmurHash2.h>
 
 #include "Magnum/Magnum.h"
 #include "Magnum/Math/Functions.h"
+#include "Magnum/MeshTools/visibility.h"
 
 namespace Magnum { namespace MeshTools {
 
@@ -47,6 +52,33 @@ namespace Implementation {
                 return *reinterpret_cast<const std::size_t*>(Utility::MurmurHash2()(reinterpret_cast<const char*>(&data), sizeof(data)).byteArray());
             }
     };
+
+    /* Cheap hash of integer grid cell coordinates, FNV-1a on whole
+       components followed by the MurmurHash3 finalizer to spread the bits
+       into the low bits used for table indexing */
+    template<std::size_t size> inline UnsignedInt cellHash(const Math::Vector<size, Int>& cell) {
+        UnsignedInt hash = 2166136261u;
+        for(std::size_t i = 0; i != size; ++i)
+            hash = (hash ^ UnsignedInt(cell[i]))*16777619u;
+        hash ^= hash >> 16;
+        hash *= 0x85ebca6bu;
+        hash ^= hash >> 13;
+        hash *= 0xc2b2ae35u;
+        hash ^= hash >> 16;
+        return hash;
+    }
+
+    constexpr UnsignedInt pow3(std::size_t exponent) {
+        return exponent ? 3*pow3(exponent - 1) : 1;
+    }
+
+    /* Type-erased view on bytes of each element. Going through arrayCast()
+       instead of constructing the view from a memory range, as the
+       constructor expects the range to be at least size*stride bytes,
+       which is more than the elements actually span. */
+    template<class T> Containers::StridedArrayView2D<char> bytes(const Containers::StridedArrayView1D<T>& view) {
+        return Containers::arrayCast<2, char>(view);
+    }
 }
 
 /**
@@ -60,7 +92,7 @@ Removes duplicate data from the array by collapsing them into buckets of size
 @p epsilon. First vector in given bucket is used, other ones are thrown away,
 no interpolation is done. Note that this function is meant to be used for
 floating-point data (or generally with non-zero @p epsilon), for discrete data
-the usual sorting method is much more efficient.
+use @ref removeDuplicatesInPlace(), which is much more efficient.
 
 If you want to remove duplicate data from already indexed array, first remove
 duplicates as if the array wasn't indexed at all and then use @ref duplicate()
@@ -74,6 +106,11 @@ to combine the resulting index arrays to single index array and reorder the
 data accordingly:
 
 @snippet MagnumMeshTools.cpp removeDuplicates2
+
+This function does @cpp Vector::Size + 1 @ce passes over the data, each
+inserting into a node-based hash map. For large meshes, interleaved vertex data
+or when a single-pass fuzzy comparison is desired, use
+@ref removeDuplicatesFuzzyInPlace() instead.
 */
 template<class Vector> std::vector<UnsignedInt> removeDuplicates(std::vector<Vector>& data, typename Vector::Type epsilon = Math::TypeTraits<typename Vector::Type>::epsilon()) {
     /* Get bounds */
@@ -140,6 +177,174 @@ template<class Vector> std::vector<UnsignedInt> removeDuplicates(std::vector<Vec
     return resultIndices;
 }
 
+/**
+@brief Remove duplicate data from given array in-place
+@param[in,out] data     Input data array
+@param[out] indices     Resulting index array
+@return Count of unique data
+
+Compares the data bitwise, which makes it suitable for discrete data such as
+packed normals, colors, half-floats or whole interleaved vertices. The first
+dimension of @p data is the elements, the second dimension is bytes of each
+element and is expected to be contiguous. The elements are hashed and
+inserted into a flat open-addressing hash table, which means the whole
+operation is done in a single pass.
+
+Unique data are moved to the front of @p data, keeping their original order,
+and @p indices are filled with a mapping from the original position to the
+unique data. The @p indices array is expected to have the same size as the
+first dimension of @p data. For floating-point data, where bitwise comparison
+is not desirable, use @ref removeDuplicatesFuzzyInPlaceInto() instead.
+@see @ref removeDuplicatesInPlace()
+*/
+std::size_t MAGNUM_MESHTOOLS_EXPORT removeDuplicatesInPlaceInto(const Containers::StridedArrayView2D<char>& data, const Containers::StridedArrayView1D<UnsignedInt>& indices);
+
+/**
+@brief Remove duplicate data from given typed array in-place
+
+Convenience overload of @ref removeDuplicatesInPlaceInto(const Containers::StridedArrayView2D<char>&, const Containers::StridedArrayView1D<UnsignedInt>&)
+comparing whole @p T values bitwise. The @p T type is expected to not have any
+padding.
+*/
+template<class T> std::size_t removeDuplicatesInPlaceInto(const Containers::StridedArrayView1D<T>& data, const Containers::StridedArrayView1D<UnsignedInt>& indices) {
+    return removeDuplicatesInPlaceInto(Implementation::bytes(data), indices);
+}
+
+/**
+@brief Remove duplicate data from given array in-place
+@param[in,out] data     Input data array
+@return Index array and count of unique data
+
+Allocates the index array and calls @ref removeDuplicatesInPlaceInto(const Containers::StridedArrayView2D<char>&, const Containers::StridedArrayView1D<UnsignedInt>&),
+see its documentation for more information.
+*/
+std::pair<Containers::Array<UnsignedInt>, std::size_t> MAGNUM_MESHTOOLS_EXPORT removeDuplicatesInPlace(const Containers::StridedArrayView2D<char>& data);
+
+/**
+@brief Remove duplicate data from given typed array in-place
+
+Convenience overload of @ref removeDuplicatesInPlace(const Containers::StridedArrayView2D<char>&)
+comparing whole @p T values bitwise. The @p T type is expected to not have any
+padding.
+*/
+template<class T> std::pair<Containers::Array<UnsignedInt>, std::size_t> removeDuplicatesInPlace(const Containers::StridedArrayView1D<T>& data) {
+    return removeDuplicatesInPlace(Implementation::bytes(data));
+}
+
+/**
+@brief Remove duplicate floating-point vector data from given array in-place
+@param[in,out] data     Input data array
+@param[out] indices     Resulting index array
+@param[in] epsilon      Epsilon value, vertices nearer than this distance in
+    each component will be melt together
+@return Count of unique data
+
+Unlike @ref removeDuplicates(), this function does a single pass over the data.
+The space is split into a grid of cells of size @p epsilon, which are stored in
+a flat open-addressing hash table. For each vector, its own cell and all
+neighboring cells are checked for an already existing unique vector that's
+closer than @p epsilon in each component. If such vector is found, it's used,
+otherwise the vector is added as a new unique one. No interpolation is done.
+
+Unique data are moved to the front of @p data, keeping their original order,
+and @p indices are filled with a mapping from the original position to the
+unique data. The @p data view can be strided, which allows deduplicating a
+single attribute of interleaved vertex data in-place. The @p indices array is
+expected to have the same size as @p data. The @p epsilon is enlarged if
+needed so the grid cell coordinates fit into a 32-bit integer.
+@see @ref removeDuplicatesFuzzyInPlace()
+*/
+template<class Vector> std::size_t removeDuplicatesFuzzyInPlaceInto(const Containers::StridedArrayView1D<Vector>& data, const Containers::StridedArrayView1D<UnsignedInt>& indices, typename Vector::Type epsilon = Math::TypeTraits<typename Vector::Type>::epsilon()) {
+    typedef typename Vector::Type T;
+    typedef Math::Vector<Vector::Size, Int> Cell;
+
+    CORRADE_ASSERT(indices.size() == data.size(),
+        "MeshTools::removeDuplicatesFuzzyInPlaceInto(): output index array has" << indices.size() << "elements but expected" << data.size(), {});
+    CORRADE_ASSERT(epsilon > T(0),
+        "MeshTools::removeDuplicatesFuzzyInPlaceInto(): epsilon is expected to be positive but got" << epsilon, {});
+    if(data.empty()) return 0;
+
+    /* Get bounds */
+    Vector min = data[0], max = data[0];
+    for(const Vector& v: data) {
+        min = Math::min(v, min);
+        max = Math::max(v, max);
+    }
+
+    /* Make epsilon so large that the cell coordinates including the
+       neighbors fit into a signed 32-bit integer. Using just half of the
+       range leaves a margin for the rounding in the division below, which
+       could otherwise produce 2^31 for the largest value. */
+    epsilon = Math::max(epsilon, T((max - min).max()/T(std::numeric_limits<Int>::max()/2)));
+
+    /* Table containing index of the unique vector for each occupied cell.
+       Two vectors in the same cell are always nearer than epsilon, so there's
+       at most one unique vector per cell. The capacity is a power of two at
+       least twice the vector count to keep the probe sequences short. */
+    std::size_t capacity = 16;
+    while(capacity < 2*data.size()) capacity <<= 1;
+    const std::size_t mask = capacity - 1;
+    Containers::Array<UnsignedInt> table{Containers::DirectInit, capacity, ~UnsignedInt{}};
+    Containers::Array<Cell> cells{Containers::NoInit, data.size()};
+
+    std::size_t count = 0;
+    for(std::size_t i = 0; i != data.size(); ++i) {
+        const Vector v = data[i];
+        const Cell cell{(v - min)/epsilon};
+
+        /* Find a slot for the cell. If it's occupied, the vector is a
+           duplicate of the one in it. */
+        std::size_t slot = Implementation::cellHash(cell) & mask;
+        for(; table[slot] != ~UnsignedInt{} && cells[table[slot]] != cell; slot = (slot + 1) & mask);
+        UnsignedInt found = table[slot];
+
+        /* Otherwise check the neighbor cells, starting from 1 as the zeroth
+           neighbor is the cell itself */
+        for(UnsignedInt n = 1; n != Implementation::pow3(Vector::Size) && found == ~UnsignedInt{}; ++n) {
+            Cell neighbor = cell;
+            for(UnsignedInt j = 0, m = n; j != Vector::Size; ++j, m /= 3)
+                neighbor[j] += m % 3 == 2 ? -1 : Int(m % 3);
+
+            for(std::size_t neighborSlot = Implementation::cellHash(neighbor) & mask; table[neighborSlot] != ~UnsignedInt{}; neighborSlot = (neighborSlot + 1) & mask) {
+                const UnsignedInt candidate = table[neighborSlot];
+                if(cells[candidate] != neighbor) continue;
+                if((Math::abs(data[candidate] - v) < Vector{epsilon}).all())
+                    found = candidate;
+                break;
+            }
+        }
+
+        /* Not found, add a new unique vector, moving it to the front */
+        if(found == ~UnsignedInt{}) {
+            found = count;
+            table[slot] = found;
+            cells[found] = cell;
+            if(i != count) data[count] = v;
+            ++count;
+        }
+
+        indices[i] = found;
+    }
+
+    return count;
+}
+
+/**
+@brief Remove duplicate floating-point vector data from given array in-place
+@param[in,out] data     Input data array
+@param[in] epsilon      Epsilon value, vertices nearer than this distance in
+    each component will be melt together
+@return Index array and count of unique data
+
+Allocates the index array and calls @ref removeDuplicatesFuzzyInPlaceInto(),
+see its documentation for more information.
+*/
+template<class Vector> std::pair<Containers::Array<UnsignedInt>, std::size_t> removeDuplicatesFuzzyInPlace(const Containers::StridedArrayView1D<Vector>& data, typename Vector::Type epsilon = Math::TypeTraits<typename Vector::Type>::epsilon()) {
+    Containers::Array<UnsignedInt> indices{Containers::NoInit, data.size()};
+    const std::size_t count = removeDuplicatesFuzzyInPlaceInto(data, Containers::StridedArrayView1D<UnsignedInt>{indices}, epsilon);
+    return {std::move(indices), count};
+}
+
 }}
 
 #endif
@@ -0,0 +1,364 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "Simplify.h"
+
+#include <algorithm>
+#include <cstring>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/Math/Constants.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/Math/Vector3.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+/* Symmetric 4x4 matrix of a quadric, together with the total weight of all
+   planes added to it */
+struct Quadric {
+    Double a00, a11, a22, a10, a20, a21, b0, b1, b2, c, w;
+};
+
+void addPlane(Quadric& q, const Vector3d& n, const Double d, const Double w) {
+    q.a00 += w*n.x()*n.x();
+    q.a11 += w*n.y()*n.y();
+    q.a22 += w*n.z()*n.z();
+    q.a10 += w*n.y()*n.x();
+    q.a20 += w*n.z()*n.x();
+    q.a21 += w*n.z()*n.y();
+    q.b0 += w*n.x()*d;
+    q.b1 += w*n.y()*d;
+    q.b2 += w*n.z()*d;
+    q.c += w*d*d;
+    q.w += w;
+}
+
+void addQuadric(Quadric& a, const Quadric& b) {
+    a.a00 += b.a00;
+    a.a11 += b.a11;
+    a.a22 += b.a22;
+    a.a10 += b.a10;
+    a.a20 += b.a20;
+    a.a21 += b.a21;
+    a.b0 += b.b0;
+    a.b1 += b.b1;
+    a.b2 += b.b2;
+    a.c += b.c;
+    a.w += b.w;
+}
+
+/* Weighted average of squared distances of the point from all planes in the
+   quadric */
+Double quadricError(const Quadric& q, const Vector3d& p) {
+    if(!q.w) return 0.0;
+
+    const Double x = p.x(), y = p.y(), z = p.z();
+    const Double error =
+        q.a00*x*x + q.a11*y*y + q.a22*z*z +
+        2.0*(q.a10*x*y + q.a20*x*z + q.a21*y*z) +
+        2.0*(q.b0*x + q.b1*y + q.b2*z) + q.c;
+    return Math::max(error, 0.0)/q.w;
+}
+
+struct Collapse {
+    UnsignedInt from, to;
+    Double error;
+};
+
+inline UnsignedLong edgeKey(const UnsignedInt a, const UnsignedInt b) {
+    return UnsignedLong(a) << 32 | b;
+}
+
+}
+
+std::size_t simplifyInto(const Containers::ArrayView<const UnsignedInt>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView2D<const Float>& attributes, const Containers::ArrayView<const Float>& attributeWeights, const std::size_t targetIndexCount, const Float targetError, const Containers::ArrayView<UnsignedInt>& out, Float* const resultError) {
+    CORRADE_ASSERT(indices.size() % 3 == 0,
+        "MeshTools::simplifyInto(): index count not divisible by 3", {});
+    CORRADE_ASSERT(out.size() >= indices.size(),
+        "MeshTools::simplifyInto(): output array too small, expected at least" << indices.size() << "but got" << out.size(), {});
+    CORRADE_ASSERT(attributes.size()[1] == attributeWeights.size() && (attributeWeights.empty() || attributes.size()[0] == positions.size()),
+        "MeshTools::simplifyInto(): expected attributes for" << positions.size() << "vertices and" << attributeWeights.size() << "components but got" << attributes.size()[0] << "vertices and" << attributes.size()[1] << "components", {});
+    #ifndef CORRADE_NO_ASSERT
+    for(const UnsignedInt index: indices)
+        CORRADE_ASSERT(index < positions.size(),
+            "MeshTools::simplifyInto(): index" << index << "out of bounds for" << positions.size() << "elements", {});
+    #endif
+
+    if(resultError) *resultError = 0.0f;
+    std::size_t indexCount = indices.size();
+    std::copy(indices.begin(), indices.end(), out.begin());
+    if(indexCount <= targetIndexCount) return indexCount;
+
+    const UnsignedInt vertexCount = positions.size();
+    const std::size_t attributeCount = attributeWeights.size();
+
+    /* Positions normalized to a unit cube, so the errors are relative to the
+       mesh size. Done in doubles to have enough precision in the quadrics. */
+    Range3D bounds{positions[indices[0]], positions[indices[0]]};
+    for(const UnsignedInt index: indices)
+        bounds = {Math::min(bounds.min(), positions[index]), Math::max(bounds.max(), positions[index])};
+    const Float extent = bounds.size().max();
+    const Double scale = extent > 0.0f ? 1.0/Double(extent) : 1.0;
+    Containers::Array<Vector3d> normalized{Containers::NoInit, vertexCount};
+    for(std::size_t i = 0; i != vertexCount; ++i)
+        normalized[i] = Vector3d(positions[i] - bounds.min())*scale;
+
+    /* Group vertices with bitwise equal positions together. Vertices sharing
+       a position with others are on attribute seams and get locked, edges
+       are compared on the groups so the seams aren't treated as borders. */
+    Containers::Array<UnsignedInt> positionRemap{Containers::NoInit, vertexCount};
+    Containers::Array<bool> locked{Containers::ValueInit, vertexCount};
+    {
+        Containers::Array<UnsignedInt> sorted{Containers::NoInit, vertexCount};
+        for(UnsignedInt i = 0; i != vertexCount; ++i) sorted[i] = i;
+        std::sort(sorted.begin(), sorted.end(), [&](UnsignedInt a, UnsignedInt b) {
+            const int result = std::memcmp(&positions[a], &positions[b], sizeof(Vector3));
+            return result < 0 || (result == 0 && a < b);
+        });
+        for(std::size_t i = 0; i != vertexCount; ) {
+            std::size_t end = i + 1;
+            while(end != vertexCount && std::memcmp(&positions[sorted[i]], &positions[sorted[end]], sizeof(Vector3)) == 0) ++end;
+            for(std::size_t j = i; j != end; ++j) {
+                positionRemap[sorted[j]] = sorted[i];
+                if(end - i > 1) locked[sorted[j]] = true;
+            }
+            i = end;
+        }
+    }
+
+    /* Lock vertices on borders and non-manifold edges, which are the edges
+       that don't have exactly one opposite edge */
+    {
+        Containers::Array<UnsignedLong> edges{Containers::NoInit, indexCount};
+        for(std::size_t i = 0; i != indexCount; ++i)
+            edges[i] = edgeKey(positionRemap[out[i]], positionRemap[out[i - i%3 + (i + 1)%3]]);
+        std::sort(edges.begin(), edges.end());
+
+        Containers::Array<bool> positionLocked{Containers::ValueInit, vertexCount};
+        for(std::size_t i = 0; i != indexCount; ) {
+            std::size_t end = i + 1;
+            while(end != indexCount && edges[end] == edges[i]) ++end;
+
+            const UnsignedInt a = edges[i] >> 32;
+            const UnsignedInt b = edges[i] & 0xffffffffu;
+            const UnsignedLong opposite = edgeKey(b, a);
+            const auto oppositeRange = std::equal_range(edges.begin(), edges.end(), opposite);
+            if(end - i != 1 || oppositeRange.second - oppositeRange.first != 1)
+                positionLocked[a] = positionLocked[b] = true;
+
+            i = end;
+        }
+
+        for(UnsignedInt i = 0; i != vertexCount; ++i)
+            if(positionLocked[positionRemap[i]]) locked[i] = true;
+    }
+
+    /* Initial quadrics from planes of all triangles, weighted by area */
+    Containers::Array<Quadric> quadrics{Containers::ValueInit, vertexCount};
+    for(std::size_t i = 0; i != indexCount; i += 3) {
+        const Vector3d& p0 = normalized[out[i + 0]];
+        const Vector3d& p1 = normalized[out[i + 1]];
+        const Vector3d& p2 = normalized[out[i + 2]];
+        const Vector3d cross = Math::cross(p1 - p0, p2 - p0);
+        const Double length = cross.length();
+        if(!length) continue;
+
+        const Vector3d normal = cross/length;
+        const Double d = -Math::dot(normal, p0);
+        for(std::size_t j = 0; j != 3; ++j)
+            addPlane(quadrics[out[i + j]], normal, d, length*0.5);
+    }
+
+    const Double maxError = Double(targetError)*Double(targetError);
+    Double error = 0.0;
+    auto collapseError = [&](const UnsignedInt from, const UnsignedInt to) {
+        Double e = quadricError(quadrics[from], normalized[to]);
+        for(std::size_t i = 0; i != attributeCount; ++i) {
+            const Double difference = Double(attributeWeights[i])*Double(attributes[from][i] - attributes[to][i]);
+            e += difference*difference;
+        }
+        return e;
+    };
+
+    Containers::Array<UnsignedInt> triangleOffset{Containers::NoInit, vertexCount + 1};
+    Containers::Array<UnsignedInt> triangleIds{Containers::NoInit, indexCount};
+    Containers::Array<UnsignedInt> collapseTarget{Containers::NoInit, vertexCount};
+    Containers::Array<bool> touched{Containers::NoInit, vertexCount};
+    for(UnsignedInt i = 0; i != vertexCount; ++i) collapseTarget[i] = i;
+    std::vector<Collapse> collapses;
+
+    /* Each pass collects all candidate collapses, sorts them by error and
+       performs as many as possible without two of them affecting the same
+       triangle */
+    while(indexCount > targetIndexCount) {
+        /* Triangles around each vertex */
+        std::fill(triangleOffset.begin(), triangleOffset.end(), 0);
+        for(std::size_t i = 0; i != indexCount; ++i) ++triangleOffset[out[i] + 1];
+        for(std::size_t i = 0; i != vertexCount; ++i) triangleOffset[i + 1] += triangleOffset[i];
+        for(std::size_t i = 0; i != indexCount; ++i) triangleIds[triangleOffset[out[i]]++] = i/3;
+        for(std::size_t i = vertexCount; i != 0; --i) triangleOffset[i] = triangleOffset[i - 1];
+        triangleOffset[0] = 0;
+
+        /* For each edge pick the cheaper direction that's allowed */
+        collapses.clear();
+        for(std::size_t i = 0; i != indexCount; ++i) {
+            const UnsignedInt a = out[i];
+            const UnsignedInt b = out[i - i%3 + (i + 1)%3];
+            if(locked[a] && locked[b]) continue;
+            const Double ab = locked[a] ? Constantsd::inf() : collapseError(a, b);
+            const Double ba = locked[b] ? Constantsd::inf() : collapseError(b, a);
+            if(ab <= ba) collapses.push_back({a, b, ab});
+            else collapses.push_back({b, a, ba});
+        }
+        std::sort(collapses.begin(), collapses.end(), [](const Collapse& a, const Collapse& b) {
+            return a.error < b.error;
+        });
+
+        std::fill(touched.begin(), touched.end(), false);
+        const std::size_t trianglesToRemove = (indexCount - targetIndexCount + 2)/3;
+        std::size_t removedTriangles = 0;
+        std::size_t performedCollapses = 0;
+        for(const Collapse& collapse: collapses) {
+            if(collapse.error > maxError || removedTriangles >= trianglesToRemove) break;
+            if(touched[collapse.from] || touched[collapse.to]) continue;
+
+            /* Reject the collapse if any of the remaining triangles would
+               flip. Triangles containing both vertices will get removed. */
+            const Vector3d& to = normalized[collapse.to];
+            std::size_t removed = 0;
+            bool flips = false;
+            for(std::size_t t = triangleOffset[collapse.from]; t != triangleOffset[collapse.from + 1]; ++t) {
+                const UnsignedInt* const triangle = out + triangleIds[t]*3;
+                if(triangle[0] == collapse.to || triangle[1] == collapse.to || triangle[2] == collapse.to) {
+                    ++removed;
+                    continue;
+                }
+
+                const Vector3d& p0 = normalized[triangle[0]];
+                const Vector3d& p1 = normalized[triangle[1]];
+                const Vector3d& p2 = normalized[triangle[2]];
+                const Vector3d& q0 = triangle[0] == collapse.from ? to : p0;
+                const Vector3d& q1 = triangle[1] == collapse.from ? to : p1;
+                const Vector3d& q2 = triangle[2] == collapse.from ? to : p2;
+                if(Math::dot(Math::cross(p1 - p0, p2 - p0), Math::cross(q1 - q0, q2 - q0)) <= 0.0) {
+                    flips = true;
+                    break;
+                }
+            }
+            if(flips) continue;
+
+            /* Perform the collapse and lock all vertices around so the
+               triangles affected by it aren't touched again in this pass */
+            collapseTarget[collapse.from] = collapse.to;
+            addQuadric(quadrics[collapse.to], quadrics[collapse.from]);
+            for(std::size_t t = triangleOffset[collapse.from]; t != triangleOffset[collapse.from + 1]; ++t)
+                for(std::size_t j = 0; j != 3; ++j)
+                    touched[out[triangleIds[t]*3 + j]] = true;
+            touched[collapse.to] = true;
+            removedTriangles += removed;
+            error = Math::max(error, collapse.error);
+            ++performedCollapses;
+        }
+
+        if(!performedCollapses) break;
+
+        /* Apply the collapses and remove degenerate triangles */
+        std::size_t newIndexCount = 0;
+        for(std::size_t i = 0; i != indexCount; i += 3) {
+            const UnsignedInt a = collapseTarget[out[i + 0]];
+            const UnsignedInt b = collapseTarget[out[i + 1]];
+            const UnsignedInt c = collapseTarget[out[i + 2]];
+            if(a == b || b == c || c == a) continue;
+            out[newIndexCount++] = a;
+            out[newIndexCount++] = b;
+            out[newIndexCount++] = c;
+        }
+        indexCount = newIndexCount;
+
+        for(const Collapse& collapse: collapses)
+            collapseTarget[collapse.from] = collapse.from;
+    }
+
+    if(resultError) *resultError = Float(std::sqrt(error));
+    return indexCount;
+}
+
+std::size_t simplifyInto(const Containers::ArrayView<const UnsignedInt>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const std::size_t targetIndexCount, const Float targetError, const Containers::ArrayView<UnsignedInt>& out, Float* const resultError) {
+    return simplifyInto(indices, positions, nullptr, nullptr, targetIndexCount, targetError, out, resultError);
+}
+
+Containers::Array<UnsignedInt> simplify(const Containers::ArrayView<const UnsignedInt>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView2D<const Float>& attributes, const Containers::ArrayView<const Float>& attributeWeights, const std::size_t targetIndexCount, const Float targetError, Float* const resultError) {
+    Containers::Array<UnsignedInt> out{Containers::NoInit, indices.size()};
+    const std::size_t size = simplifyInto(indices, positions, attributes, attributeWeights, targetIndexCount, targetError, out, resultError);
+
+    Containers::Array<UnsignedInt> result{Containers::NoInit, size};
+    std::copy(out.begin(), out.begin() + size, result.begin());
+    return result;
+}
+
+Containers::Array<UnsignedInt> simplify(const Containers::ArrayView<const UnsignedInt>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const std::size_t targetIndexCount, const Float targetError, Float* const resultError) {
+    return simplify(indices, positions, nullptr, nullptr, targetIndexCount, targetError, resultError);
+}
+
+std::vector<Containers::Array<UnsignedInt>> generateLods(const Containers::ArrayView<const UnsignedInt>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView2D<const Float>& attributes, const Containers::ArrayView<const Float>& attributeWeights, const UnsignedInt lodCount, const Float triangleRatio, const Float targetError) {
+    CORRADE_ASSERT(triangleRatio > 0.0f && triangleRatio < 1.0f,
+        "MeshTools::generateLods(): expected triangle ratio between 0 and 1 but got" << triangleRatio, {});
+
+    std::vector<Containers::Array<UnsignedInt>> lods;
+    if(!lodCount) return lods;
+    lods.reserve(lodCount);
+
+    Containers::Array<UnsignedInt> lod{Containers::NoInit, indices.size()};
+    std::copy(indices.begin(), indices.end(), lod.begin());
+    lods.push_back(std::move(lod));
+
+    Containers::Array<UnsignedInt> out{Containers::NoInit, indices.size()};
+    while(lods.size() < lodCount) {
+        const std::size_t previousSize = lods.back().size();
+        const std::size_t targetIndexCount = std::size_t(previousSize/3*triangleRatio)*3;
+        const std::size_t size = simplifyInto(indices, positions, attributes, attributeWeights, targetIndexCount, targetError, out);
+
+        /* Stop if the error limit doesn't allow any further reduction */
+        if(size >= previousSize) break;
+
+        Containers::Array<UnsignedInt> next{Containers::NoInit, size};
+        std::copy(out.begin(), out.begin() + size, next.begin());
+        lods.push_back(std::move(next));
+    }
+
+    return lods;
+}
+
+std::vector<Containers::Array<UnsignedInt>> generateLods(const Containers::ArrayView<const UnsignedInt>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const UnsignedInt lodCount, const Float triangleRatio, const Float targetError) {
+    return generateLods(indices, positions, nullptr, nullptr, lodCount, triangleRatio, targetError);
+}
+
+}}
@@ -0,0 +1,156 @@
+#ifndef Magnum_MeshTools_Simplify_h
+#define Magnum_MeshTools_Simplify_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::MeshTools::simplifyInto(), @ref Magnum::MeshTools::simplify(), @ref Magnum::MeshTools::generateLods()
+ */
+
+#include <vector>
+#include <Corrade/Containers/StridedArrayView.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/MeshTools/visibility.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Simplify a mesh into an existing array
+@param[in] indices          Triangle indices
+@param[in] positions        Vertex positions
+@param[in] attributes       Additional vertex attributes, first dimension
+    being vertices and second attribute components
+@param[in] attributeWeights Weight of each attribute component
+@param[in] targetIndexCount Index count to reduce the mesh to
+@param[in] targetError      Max allowed error, relative to mesh size
+@param[out] out             Where to put the simplified indices
+@param[out] resultError     If not @cpp nullptr @ce, max error of the
+    performed simplifications is saved here
+@return Count of indices written to @p out
+
+Reduces the triangle count by collapsing edges, with the cost of each
+collapse calculated using quadric error metrics: *Michael Garland, Paul S.
+Heckbert --- Surface Simplification Using Quadric Error Metrics, 1997*. The
+collapses are half-edge collapses, meaning a vertex is always merged into one
+of its neighbors instead of being moved to a new position. Thanks to that
+the result references the original vertex data, which means multiple
+simplified index buffers can share a single vertex buffer --- see
+@ref generateLods().
+
+The error is measured as a distance relative to the largest dimension of the
+mesh bounding box, so for example @cpp 0.01f @ce means the simplified
+surface is allowed to deviate by 1% of the mesh size. The simplification stops
+either when the index count gets to @p targetIndexCount or when no collapse
+with an error below @p targetError is possible.
+
+For every collapse, differences in @p attributes between the removed vertex
+and the vertex it gets merged to are multiplied by corresponding
+@p attributeWeights and added to the error, which means for example a weight
+of @cpp 0.5f @ce for normals will consider a normal difference of
+@cpp 0.1f @ce equivalent to 5% of mesh size in position. Pass an empty view
+to take only the positions into account.
+
+Vertices on open mesh borders and on non-manifold edges are locked, as well
+as vertices sharing the same position with other vertices, such as on
+texture coordinate or normal discontinuities. This keeps the mesh outline and
+the attribute seams intact, but also means that meshes where no vertices
+are shared, such as flat-shaded meshes, can't be simplified. Use
+@ref removeDuplicates() to merge the vertices first in that case. Collapses
+that would flip a neighboring triangle are rejected.
+
+The @p indices array is expected to have a size divisible by @cpp 3 @ce and
+all values less than size of @p positions, @p attributes are expected to
+have the same size as @p positions in the first dimension and the same size
+as @p attributeWeights in the second dimension. The @p out array is expected
+to be at least as large as @p indices. Useful when you need to interface for
+example with STL containers --- in that case @cpp #include @ce
+@ref Corrade/Containers/ArrayViewStl.h to get implicit conversions.
+@see @ref optimizeVertexCacheInPlace(), @ref optimizeVertexFetchInPlace()
+*/
+std::size_t MAGNUM_MESHTOOLS_EXPORT simplifyInto(const Containers::ArrayView<const UnsignedInt>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView2D<const Float>& attributes, const Containers::ArrayView<const Float>& attributeWeights, std::size_t targetIndexCount, Float targetError, const Containers::ArrayView<UnsignedInt>& out, Float* resultError = nullptr);
+
+/**
+@brief Simplify a mesh into an existing array using just vertex positions
+
+Same as calling @ref simplifyInto(const Containers::ArrayView<const UnsignedInt>&, const Containers::StridedArrayView1D<const Vector3>&, const Containers::StridedArrayView2D<const Float>&, const Containers::ArrayView<const Float>&, std::size_t, Float, const Containers::ArrayView<UnsignedInt>&, Float*)
+with empty @p attributes and @p attributeWeights.
+*/
+std::size_t MAGNUM_MESHTOOLS_EXPORT simplifyInto(const Containers::ArrayView<const UnsignedInt>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, std::size_t targetIndexCount, Float targetError, const Containers::ArrayView<UnsignedInt>& out, Float* resultError = nullptr);
+
+/**
+@brief Simplify a mesh
+
+Like @ref simplifyInto(const Containers::ArrayView<const UnsignedInt>&, const Containers::StridedArrayView1D<const Vector3>&, const Containers::StridedArrayView2D<const Float>&, const Containers::ArrayView<const Float>&, std::size_t, Float, const Containers::ArrayView<UnsignedInt>&, Float*),
+but returns a newly allocated array of the resulting size.
+*/
+Containers::Array<UnsignedInt> MAGNUM_MESHTOOLS_EXPORT simplify(const Containers::ArrayView<const UnsignedInt>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView2D<const Float>& attributes, const Containers::ArrayView<const Float>& attributeWeights, std::size_t targetIndexCount, Float targetError, Float* resultError = nullptr);
+
+/**
+@brief Simplify a mesh using just vertex positions
+
+Like @ref simplifyInto(const Containers::ArrayView<const UnsignedInt>&, const Containers::StridedArrayView1D<const Vector3>&, std::size_t, Float, const Containers::ArrayView<UnsignedInt>&, Float*),
+but returns a newly allocated array of the resulting size.
+*/
+Containers::Array<UnsignedInt> MAGNUM_MESHTOOLS_EXPORT simplify(const Containers::ArrayView<const UnsignedInt>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, std::size_t targetIndexCount, Float targetError, Float* resultError = nullptr);
+
+/**
+@brief Generate a chain of mesh LODs
+@param indices          Triangle indices
+@param positions        Vertex positions
+@param attributes       Additional vertex attributes, first dimension being
+    vertices and second attribute components
+@param attributeWeights Weight of each attribute component
+@param lodCount         Max count of generated levels, including the
+    original mesh
+@param triangleRatio    Ratio of triangle count between two consecutive
+    levels
+@param targetError      Max allowed error, relative to mesh size
+
+Returns index buffers for up to @p lodCount levels of detail, all
+referencing the original vertex data. The first item is a copy of
+@p indices, each next one is simplified from the original mesh using
+@ref simplifyInto() with target index count of the previous level multiplied
+by @p triangleRatio. The chain ends earlier if a level couldn't be reduced any
+further without exceeding @p targetError.
+
+Expects that @p triangleRatio is greater than @cpp 0.0f @ce and less than
+@cpp 1.0f @ce. Since the vertex data are shared, it's advised to call
+@ref optimizeVertexCacheInPlace() on each level and
+@ref optimizeVertexFetchInPlace() on the first level afterwards.
+*/
+std::vector<Containers::Array<UnsignedInt>> MAGNUM_MESHTOOLS_EXPORT generateLods(const Containers::ArrayView<const UnsignedInt>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView2D<const Float>& attributes, const Containers::ArrayView<const Float>& attributeWeights, UnsignedInt lodCount, Float triangleRatio = 0.5f, Float targetError = 0.01f);
+
+/**
+@brief Generate a chain of mesh LODs using just vertex positions
+
+Same as calling @ref generateLods(const Containers::ArrayView<const UnsignedInt>&, const Containers::StridedArrayView1D<const Vector3>&, const Containers::StridedArrayView2D<const Float>&, const Containers::ArrayView<const Float>&, UnsignedInt, Float, Float)
+with empty @p attributes and @p attributeWeights.
+*/
+std::vector<Containers::Array<UnsignedInt>> MAGNUM_MESHTOOLS_EXPORT generateLods(const Containers::ArrayView<const UnsignedInt>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, UnsignedInt lodCount, Float triangleRatio = 0.5f, Float targetError = 0.01f);
+
+}}
+
+#endif
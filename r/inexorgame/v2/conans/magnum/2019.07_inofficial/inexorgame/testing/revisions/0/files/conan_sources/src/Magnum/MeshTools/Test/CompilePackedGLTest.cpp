@@ -0,0 +1,100 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Magnum/Mesh.h"
+#include "Magnum/GL/Mesh.h"
+#include "Magnum/GL/OpenGLTester.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/MeshTools/Compile.h"
+#include "Magnum/MeshTools/Pack.h"
+#include "Magnum/Trade/MeshData3D.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+struct CompilePackedGLTest: GL::OpenGLTester {
+    explicit CompilePackedGLTest();
+
+    void indexed();
+    void nonIndexed();
+    void octahedralNormals();
+};
+
+CompilePackedGLTest::CompilePackedGLTest() {
+    addTests({&CompilePackedGLTest::indexed,
+              &CompilePackedGLTest::nonIndexed,
+              &CompilePackedGLTest::octahedralNormals});
+}
+
+void CompilePackedGLTest::indexed() {
+    const Trade::MeshData3D data{MeshPrimitive::Triangles, {0, 1, 2, 2, 1, 3},
+        {{{0.0f, 0.0f, 0.0f}, {2.0f, 0.0f, 0.0f}, {0.0f, 2.0f, 0.0f}, {2.0f, 2.0f, 1.0f}}},
+        {{Vector3::zAxis(), Vector3::zAxis(), Vector3::zAxis(), Vector3::zAxis()}},
+        {{{0.0f, 0.0f}, {1.0f, 0.0f}, {0.0f, 1.0f}, {1.0f, 1.0f}}},
+        {}};
+
+    Matrix4 positionTransformation;
+    GL::Mesh mesh = compilePacked(data, positionTransformation);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    CORRADE_COMPARE(positionTransformation, Matrix4::scaling(Vector3{2.0f}));
+    CORRADE_COMPARE(mesh.primitive(), GL::MeshPrimitive::Triangles);
+    CORRADE_VERIFY(mesh.isIndexed());
+    CORRADE_COMPARE(mesh.indexType(), GL::MeshIndexType::UnsignedByte);
+    CORRADE_COMPARE(mesh.count(), 6);
+}
+
+void CompilePackedGLTest::nonIndexed() {
+    const Trade::MeshData3D data{MeshPrimitive::Points, {},
+        {{{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 4.0f}, {1.0f, 1.0f, 1.0f}}},
+        {}, {}, {{Color4{1.0f}, Color4{0.5f}, Color4{0.0f}}}};
+
+    Matrix4 positionTransformation;
+    GL::Mesh mesh = compilePacked(data, positionTransformation);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    CORRADE_COMPARE(positionTransformation, Matrix4::scaling(Vector3{4.0f}));
+    CORRADE_COMPARE(mesh.primitive(), GL::MeshPrimitive::Points);
+    CORRADE_VERIFY(!mesh.isIndexed());
+    CORRADE_COMPARE(mesh.count(), 3);
+}
+
+void CompilePackedGLTest::octahedralNormals() {
+    const Trade::MeshData3D data{MeshPrimitive::Triangles, {},
+        {{{0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}}},
+        {{Vector3::zAxis(), Vector3::zAxis(), Vector3::zAxis()}},
+        {}, {}};
+
+    Matrix4 positionTransformation;
+    GL::Mesh mesh = compilePacked(data, positionTransformation, PackedNormalFormat::Octahedral, PackedTextureCoordinateFormat::UnsignedShortNormalized);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    CORRADE_COMPARE(positionTransformation, Matrix4{});
+    CORRADE_COMPARE(mesh.count(), 3);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::CompilePackedGLTest)
@@ -0,0 +1,287 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/ArrayViewStl.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Mesh.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/MeshTools/CompressIndices.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+struct CompressIndicesTest: TestSuite::Tester {
+    explicit CompressIndicesTest();
+
+    void split();
+    void splitEmpty();
+    void splitLarge();
+    void splitBoundary();
+    void splitPrimitiveBoundary();
+    void splitPoints();
+    void splitLines();
+    void splitStrided();
+    void splitPrimitiveTooLarge();
+    void splitUnsupportedPrimitive();
+    void splitWrongIndexCount();
+
+    private:
+        void verifySplit(const Containers::StridedArrayView1D<const UnsignedInt>& indices, const Containers::ArrayView<const UnsignedShort> compressed, const std::vector<CompressedIndexRange>& ranges, std::size_t primitiveSize);
+};
+
+CompressIndicesTest::CompressIndicesTest() {
+    addTests({&CompressIndicesTest::split,
+              &CompressIndicesTest::splitEmpty,
+              &CompressIndicesTest::splitLarge,
+              &CompressIndicesTest::splitBoundary,
+              &CompressIndicesTest::splitPrimitiveBoundary,
+              &CompressIndicesTest::splitPoints,
+              &CompressIndicesTest::splitLines,
+              &CompressIndicesTest::splitStrided,
+              &CompressIndicesTest::splitPrimitiveTooLarge,
+              &CompressIndicesTest::splitUnsupportedPrimitive,
+              &CompressIndicesTest::splitWrongIndexCount});
+}
+
+/* Checks that the ranges are contiguous, aligned to primitives, use only
+   values in [indexStart, indexEnd] below 65535 and give back the original
+   indices */
+void CompressIndicesTest::verifySplit(const Containers::StridedArrayView1D<const UnsignedInt>& indices, const Containers::ArrayView<const UnsignedShort> compressed, const std::vector<CompressedIndexRange>& ranges, const std::size_t primitiveSize) {
+    CORRADE_COMPARE(compressed.size(), indices.size());
+
+    std::size_t offset = 0;
+    for(const CompressedIndexRange& range: ranges) {
+        CORRADE_COMPARE(range.indexOffset, offset);
+        CORRADE_VERIFY(range.indexCount);
+        CORRADE_COMPARE(range.indexCount % primitiveSize, 0);
+        CORRADE_VERIFY(range.indexStart <= range.indexEnd);
+        CORRADE_VERIFY(range.indexEnd < 65535);
+
+        UnsignedShort min = 65535, max = 0;
+        for(std::size_t i = range.indexOffset; i != range.indexOffset + range.indexCount; ++i) {
+            CORRADE_COMPARE(compressed[i] + range.baseVertex, indices[i]);
+            min = Math::min(min, compressed[i]);
+            max = Math::max(max, compressed[i]);
+        }
+        CORRADE_COMPARE(range.indexStart, min);
+        CORRADE_COMPARE(range.indexEnd, max);
+
+        offset += range.indexCount;
+    }
+    CORRADE_COMPARE(offset, indices.size());
+}
+
+void CompressIndicesTest::split() {
+    const UnsignedInt indices[]{
+        100000, 100003, 100001,
+        100002, 100001, 100003
+    };
+
+    Containers::Array<UnsignedShort> compressed;
+    std::vector<CompressedIndexRange> ranges;
+    std::tie(compressed, ranges) = compressIndicesSplit(indices);
+
+    /* Everything fits into a single range */
+    const UnsignedShort expected[]{
+        0, 3, 1,
+        2, 1, 3
+    };
+    CORRADE_COMPARE_AS(Containers::arrayView(compressed),
+        Containers::arrayView(expected),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(ranges.size(), 1);
+    CORRADE_COMPARE(ranges[0].indexOffset, 0);
+    CORRADE_COMPARE(ranges[0].indexCount, 6);
+    CORRADE_COMPARE(ranges[0].baseVertex, 100000);
+    CORRADE_COMPARE(ranges[0].indexStart, 0);
+    CORRADE_COMPARE(ranges[0].indexEnd, 3);
+}
+
+void CompressIndicesTest::splitEmpty() {
+    Containers::Array<UnsignedShort> compressed;
+    std::vector<CompressedIndexRange> ranges;
+    std::tie(compressed, ranges) = compressIndicesSplit(nullptr);
+    CORRADE_COMPARE(compressed.size(), 0);
+    CORRADE_COMPARE(ranges.size(), 0);
+}
+
+void CompressIndicesTest::splitLarge() {
+    /* A strip-like triangle sequence over 200k vertices, with every
+       triangle also referencing a vertex 1000 back */
+    std::vector<UnsignedInt> indices;
+    for(UnsignedInt i = 1000; i + 2 < 200000; i += 2)
+        indices.insert(indices.end(), {i, i + 2, i - 1000});
+
+    Containers::Array<UnsignedShort> compressed;
+    std::vector<CompressedIndexRange> ranges;
+    std::tie(compressed, ranges) = compressIndicesSplit(indices);
+
+    /* 200k vertices need at least four ranges */
+    CORRADE_VERIFY(ranges.size() >= 4);
+    CORRADE_VERIFY(ranges.size() <= 5);
+    verifySplit(indices, compressed, ranges, 3);
+}
+
+void CompressIndicesTest::splitBoundary() {
+    /* Difference of 65534 still fits into one range */
+    {
+        const UnsignedInt indices[]{10, 65544, 11};
+        Containers::Array<UnsignedShort> compressed;
+        std::vector<CompressedIndexRange> ranges;
+        std::tie(compressed, ranges) = compressIndicesSplit(indices);
+        CORRADE_COMPARE(ranges.size(), 1);
+        CORRADE_COMPARE(ranges[0].indexEnd, 65534);
+        verifySplit(indices, compressed, ranges, 3);
+    }
+
+    /* 65535 is reserved for primitive restart, so this has to be split */
+    {
+        const UnsignedInt indices[]{
+            10, 11, 12,
+            65545, 65544, 65543
+        };
+        Containers::Array<UnsignedShort> compressed;
+        std::vector<CompressedIndexRange> ranges;
+        std::tie(compressed, ranges) = compressIndicesSplit(indices);
+        CORRADE_COMPARE(ranges.size(), 2);
+        CORRADE_COMPARE(ranges[0].baseVertex, 10);
+        CORRADE_COMPARE(ranges[0].indexEnd, 2);
+        CORRADE_COMPARE(ranges[1].indexOffset, 3);
+        CORRADE_COMPARE(ranges[1].baseVertex, 65543);
+        CORRADE_COMPARE(ranges[1].indexEnd, 2);
+        verifySplit(indices, compressed, ranges, 3);
+    }
+}
+
+void CompressIndicesTest::splitPrimitiveBoundary() {
+    /* The second triangle has its first index still fitting into the first
+       range, but the others don't, so it goes to the next range whole */
+    const UnsignedInt indices[]{
+        0, 1, 2,
+        10, 65540, 65541,
+        65542, 65541, 65540
+    };
+
+    Containers::Array<UnsignedShort> compressed;
+    std::vector<CompressedIndexRange> ranges;
+    std::tie(compressed, ranges) = compressIndicesSplit(indices);
+    CORRADE_COMPARE(ranges.size(), 2);
+    CORRADE_COMPARE(ranges[0].indexCount, 3);
+    CORRADE_COMPARE(ranges[1].indexOffset, 3);
+    CORRADE_COMPARE(ranges[1].indexCount, 6);
+    CORRADE_COMPARE(ranges[1].baseVertex, 10);
+    CORRADE_COMPARE(ranges[1].indexEnd, 65532);
+    verifySplit(indices, compressed, ranges, 3);
+}
+
+void CompressIndicesTest::splitPoints() {
+    const UnsignedInt indices[]{5, 70000, 6, 140000, 139999};
+
+    Containers::Array<UnsignedShort> compressed;
+    std::vector<CompressedIndexRange> ranges;
+    std::tie(compressed, ranges) = compressIndicesSplit(indices, MeshPrimitive::Points);
+    CORRADE_COMPARE(ranges.size(), 4);
+    CORRADE_COMPARE(ranges[3].indexCount, 2);
+    verifySplit(indices, compressed, ranges, 1);
+}
+
+void CompressIndicesTest::splitLines() {
+    const UnsignedInt indices[]{
+        0, 1,
+        1, 65534,
+        65534, 65600
+    };
+
+    Containers::Array<UnsignedShort> compressed;
+    std::vector<CompressedIndexRange> ranges;
+    std::tie(compressed, ranges) = compressIndicesSplit(indices, MeshPrimitive::Lines);
+    CORRADE_COMPARE(ranges.size(), 2);
+    CORRADE_COMPARE(ranges[0].indexCount, 4);
+    CORRADE_COMPARE(ranges[1].indexCount, 2);
+    CORRADE_COMPARE(ranges[1].baseVertex, 65534);
+    verifySplit(indices, compressed, ranges, 2);
+}
+
+void CompressIndicesTest::splitStrided() {
+    const struct {
+        UnsignedInt index;
+        Float padding;
+    } data[]{
+        {0, 0.0f}, {1, 0.0f}, {2, 0.0f},
+        {100000, 0.0f}, {100001, 0.0f}, {100002, 0.0f}
+    };
+    const Containers::StridedArrayView1D<const UnsignedInt> indices{
+        Containers::arrayView(data), &data[0].index, 6, sizeof(data[0])};
+
+    Containers::Array<UnsignedShort> compressed;
+    std::vector<CompressedIndexRange> ranges;
+    std::tie(compressed, ranges) = compressIndicesSplit(indices);
+    CORRADE_COMPARE(ranges.size(), 2);
+    verifySplit(indices, compressed, ranges, 3);
+}
+
+void CompressIndicesTest::splitPrimitiveTooLarge() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    /* A difference of 65535 is too much for a single primitive */
+    const UnsignedInt indices[]{
+        0, 1, 2,
+        3, 65538, 4
+    };
+    compressIndicesSplit(indices);
+    CORRADE_COMPARE(out.str(), "MeshTools::compressIndicesSplit(): primitive 1 spans more than 65535 vertices\n");
+}
+
+void CompressIndicesTest::splitUnsupportedPrimitive() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    const UnsignedInt indices[]{0, 1, 2, 3};
+    compressIndicesSplit(indices, MeshPrimitive::TriangleStrip);
+    CORRADE_COMPARE(out.str(), "MeshTools::compressIndicesSplit(): unsupported primitive MeshPrimitive::TriangleStrip\n");
+}
+
+void CompressIndicesTest::splitWrongIndexCount() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    const UnsignedInt indices[]{0, 1, 2, 3};
+    compressIndicesSplit(indices);
+    compressIndicesSplit(indices, MeshPrimitive::Lines);
+    compressIndicesSplit(Containers::arrayView(indices).prefix(3), MeshPrimitive::Lines);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::compressIndicesSplit(): index count 4 not divisible by 3\n"
+        "MeshTools::compressIndicesSplit(): index count 3 not divisible by 2\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::CompressIndicesTest)
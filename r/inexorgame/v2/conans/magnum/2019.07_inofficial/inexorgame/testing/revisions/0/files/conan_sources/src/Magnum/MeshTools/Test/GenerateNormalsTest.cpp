@@ -0,0 +1,262 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/GenerateNormals.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+struct GenerateNormalsTest: TestSuite::Tester {
+    explicit GenerateNormalsTest();
+
+    void flat();
+    void flatWrongCount();
+    void flatIntoWrongSize();
+
+    void smooth();
+    void smoothEmpty();
+    template<class T> void smoothParallel();
+    void smoothParallelOutOfBounds();
+    void smoothOutOfBounds();
+    void smoothWrongCount();
+    void smoothIntoWrongSize();
+};
+
+const struct {
+    const char* name;
+    UnsignedInt threadCount;
+} ParallelData[]{
+    {"2 threads", 2},
+    {"3 threads", 3},
+    {"4 threads", 4},
+    {"all scheduler threads", 0},
+    {"more threads than triangle chunks", 1000}
+};
+
+GenerateNormalsTest::GenerateNormalsTest() {
+    addTests({&GenerateNormalsTest::flat,
+              &GenerateNormalsTest::flatWrongCount,
+              &GenerateNormalsTest::flatIntoWrongSize,
+
+              &GenerateNormalsTest::smooth,
+              &GenerateNormalsTest::smoothEmpty});
+
+    addInstancedTests<GenerateNormalsTest>({
+        &GenerateNormalsTest::smoothParallel<UnsignedShort>,
+        &GenerateNormalsTest::smoothParallel<UnsignedInt>},
+        Containers::arraySize(ParallelData));
+
+    addTests({&GenerateNormalsTest::smoothParallelOutOfBounds,
+              &GenerateNormalsTest::smoothOutOfBounds,
+              &GenerateNormalsTest::smoothWrongCount,
+              &GenerateNormalsTest::smoothIntoWrongSize});
+}
+
+/* A 200x200 quad heightfield, large enough to go through the parallel path
+   and with the vertices spanning several vertex blocks */
+constexpr std::size_t GridSize = 200;
+
+Containers::Array<Vector3> gridPositions() {
+    Containers::Array<Vector3> positions{Containers::NoInit, (GridSize + 1)*(GridSize + 1)};
+    for(std::size_t y = 0; y <= GridSize; ++y)
+        for(std::size_t x = 0; x <= GridSize; ++x)
+            positions[y*(GridSize + 1) + x] = {Float(x), Float(y), Math::sin(Rad(x*0.1f))*Math::cos(Rad(y*0.13f))};
+    return positions;
+}
+
+template<class T> Containers::Array<T> gridIndices() {
+    Containers::Array<T> indices{Containers::NoInit, GridSize*GridSize*6};
+    std::size_t i = 0;
+    for(std::size_t y = 0; y != GridSize; ++y) {
+        for(std::size_t x = 0; x != GridSize; ++x) {
+            const T a = y*(GridSize + 1) + x;
+            const T b = a + 1;
+            const T c = a + GridSize + 1;
+            const T d = c + 1;
+            indices[i++] = a;
+            indices[i++] = b;
+            indices[i++] = d;
+            indices[i++] = a;
+            indices[i++] = d;
+            indices[i++] = c;
+        }
+    }
+    return indices;
+}
+
+void GenerateNormalsTest::flat() {
+    const Vector3 positions[]{
+        {-1.0f, 0.0f, 0.0f},
+        { 1.0f, 0.0f, 0.0f},
+        { 0.0f, 1.0f, 0.0f},
+
+        { 0.0f, 0.0f, 1.0f},
+        { 0.0f, 1.0f, 0.0f},
+        { 0.0f, 0.0f, 0.0f}
+    };
+
+    const Vector3 expected[]{
+        Vector3::zAxis(), Vector3::zAxis(), Vector3::zAxis(),
+        -Vector3::xAxis(), -Vector3::xAxis(), -Vector3::xAxis()
+    };
+
+    Containers::Array<Vector3> normals = generateFlatNormals(positions);
+    CORRADE_COMPARE_AS(Containers::arrayView(normals),
+        Containers::arrayView(expected),
+        TestSuite::Compare::Container);
+}
+
+void GenerateNormalsTest::flatWrongCount() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    const Vector3 positions[7];
+    generateFlatNormals(positions);
+    CORRADE_COMPARE(out.str(), "MeshTools::generateFlatNormalsInto(): position count not divisible by 3\n");
+}
+
+void GenerateNormalsTest::flatIntoWrongSize() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    const Vector3 positions[6];
+    Vector3 normals[7];
+    generateFlatNormalsInto(positions, normals);
+    CORRADE_COMPARE(out.str(), "MeshTools::generateFlatNormalsInto(): bad output size, expected 6 but got 7\n");
+}
+
+void GenerateNormalsTest::smooth() {
+    /* Two triangles sharing an edge and folded by 90 degrees. The shared
+       vertices get a normal in between, the others keep the face normal. */
+    const Vector3 positions[]{
+        {0.0f, 0.0f, 0.0f},
+        {1.0f, 0.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f},
+        {0.0f, 0.0f, 1.0f}
+    };
+    const UnsignedByte indices[]{
+        0, 1, 2,
+        0, 2, 3
+    };
+
+    const Vector3 expected[]{
+        Vector3{1.0f, 0.0f, 1.0f}.normalized(),
+        Vector3::zAxis(),
+        Vector3{1.0f, 0.0f, 1.0f}.normalized(),
+        Vector3::xAxis()
+    };
+
+    Containers::Array<Vector3> normals = generateSmoothNormals(Containers::stridedArrayView(indices), Containers::stridedArrayView(positions));
+    CORRADE_COMPARE_AS(Containers::arrayView(normals),
+        Containers::arrayView(expected),
+        TestSuite::Compare::Container);
+}
+
+void GenerateNormalsTest::smoothEmpty() {
+    /* Should not crash or assert */
+    Containers::Array<Vector3> normals = generateSmoothNormals(Containers::StridedArrayView1D<const UnsignedInt>{}, Containers::StridedArrayView1D<const Vector3>{}, 0);
+    CORRADE_COMPARE(normals.size(), 0);
+}
+
+template<class T> void GenerateNormalsTest::smoothParallel() {
+    auto&& data = ParallelData[testCaseInstanceId()];
+    setTestCaseName(std::string{"smoothParallel<"} + Math::TypeTraits<T>::name() + ">");
+    setTestCaseDescription(data.name);
+
+    const Containers::Array<Vector3> positions = gridPositions();
+    const Containers::Array<T> indices = gridIndices<T>();
+
+    const Containers::Array<Vector3> expected = generateSmoothNormals(Containers::stridedArrayView(indices), Containers::stridedArrayView(positions), 1);
+    const Containers::Array<Vector3> normals = generateSmoothNormals(Containers::stridedArrayView(indices), Containers::stridedArrayView(positions), data.threadCount);
+
+    /* Each vertex is accumulated in the same order regardless of the thread
+       count, so the output should be bit-exact */
+    CORRADE_COMPARE(normals.size(), expected.size());
+    CORRADE_VERIFY(std::memcmp(normals, expected, expected.size()*sizeof(Vector3)) == 0);
+
+    /* The middle of the grid is a smooth surface facing roughly up */
+    const Vector3 middle = normals[GridSize/2*(GridSize + 1) + GridSize/2];
+    CORRADE_VERIFY(middle.isNormalized());
+    CORRADE_VERIFY(middle.z() > 0.5f);
+}
+
+void GenerateNormalsTest::smoothParallelOutOfBounds() {
+    const Containers::Array<Vector3> positions = gridPositions();
+    Containers::Array<UnsignedInt> indices = gridIndices<UnsignedInt>();
+    /* The first out-of-bounds index gets reported even though the threads
+       find them in arbitrary order */
+    indices[indices.size()*3/4 + 1] = positions.size() + 7;
+    indices[indices.size()/2 + 2] = positions.size();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    generateSmoothNormals(Containers::StridedArrayView1D<const UnsignedInt>{indices}, Containers::stridedArrayView(positions), 4);
+    CORRADE_COMPARE(out.str(), "MeshTools::generateSmoothNormals(): index 40401 out of bounds for 40401 elements\n");
+}
+
+void GenerateNormalsTest::smoothOutOfBounds() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    const Vector3 positions[3];
+    const UnsignedInt indices[]{0, 1, 3};
+    generateSmoothNormals(Containers::stridedArrayView(indices), Containers::stridedArrayView(positions));
+    CORRADE_COMPARE(out.str(), "MeshTools::generateSmoothNormals(): index 3 out of bounds for 3 elements\n");
+}
+
+void GenerateNormalsTest::smoothWrongCount() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    const Vector3 positions[3];
+    const UnsignedInt indices[7]{};
+    generateSmoothNormals(Containers::stridedArrayView(indices), Containers::stridedArrayView(positions));
+    CORRADE_COMPARE(out.str(), "MeshTools::generateSmoothNormalsInto(): index count not divisible by 3\n");
+}
+
+void GenerateNormalsTest::smoothIntoWrongSize() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    const Vector3 positions[3];
+    const UnsignedInt indices[3]{};
+    Vector3 normals[4];
+    generateSmoothNormalsInto(Containers::stridedArrayView(indices), Containers::stridedArrayView(positions), Containers::stridedArrayView(normals));
+    CORRADE_COMPARE(out.str(), "MeshTools::generateSmoothNormalsInto(): bad output size, expected 3 but got 4\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::GenerateNormalsTest)
@@ -0,0 +1,424 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <array>
+#include <sstream>
+#include <Corrade/Containers/ArrayViewStl.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/FormatStl.h>
+
+#include "Magnum/Math/Frustum.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/MeshTools/Meshlets.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+struct MeshletsTest: TestSuite::Tester {
+    explicit MeshletsTest();
+
+    void build();
+    void buildFlat();
+    void buildDisconnected();
+    void buildDegenerate();
+    void buildEmpty();
+    void buildWrongIndexCount();
+    void buildInvalidLimits();
+    void buildIndexOutOfBounds();
+
+    void cullBackfacing();
+    void cullFrustum();
+    void cullConservative();
+    void cullEmpty();
+    void cullWrongSize();
+};
+
+const struct {
+    const char* name;
+    UnsignedInt maxVertexCount, maxTriangleCount;
+} BuildData[]{
+    {"defaults", 64, 126},
+    {"single triangle", 3, 1},
+    {"vertex-limited", 10, 100},
+    {"triangle-limited", 256, 8},
+    {"max", 256, 512}
+};
+
+MeshletsTest::MeshletsTest() {
+    addInstancedTests({&MeshletsTest::build},
+        Containers::arraySize(BuildData));
+
+    addTests({&MeshletsTest::buildFlat,
+              &MeshletsTest::buildDisconnected,
+              &MeshletsTest::buildDegenerate,
+              &MeshletsTest::buildEmpty,
+              &MeshletsTest::buildWrongIndexCount,
+              &MeshletsTest::buildInvalidLimits,
+              &MeshletsTest::buildIndexOutOfBounds,
+
+              &MeshletsTest::cullBackfacing,
+              &MeshletsTest::cullFrustum,
+              &MeshletsTest::cullConservative,
+              &MeshletsTest::cullEmpty,
+              &MeshletsTest::cullWrongSize});
+}
+
+struct Mesh {
+    std::vector<Vector3> positions;
+    std::vector<UnsignedInt> indices;
+};
+
+/* UV sphere with shared vertices and counter-clockwise outward-facing
+   triangles */
+Mesh sphere(const UnsignedInt rings, const UnsignedInt segments) {
+    Mesh mesh;
+    mesh.positions.push_back(Vector3::yAxis());
+    for(UnsignedInt ring = 1; ring != rings; ++ring) {
+        const Rad theta{Constants::pi()*ring/rings};
+        for(UnsignedInt segment = 0; segment != segments; ++segment) {
+            const Rad phi{Constants::tau()*segment/segments};
+            mesh.positions.emplace_back(Math::sin(theta)*Math::sin(phi), Math::cos(theta), Math::sin(theta)*Math::cos(phi));
+        }
+    }
+    mesh.positions.push_back(-Vector3::yAxis());
+
+    const UnsignedInt south = mesh.positions.size() - 1;
+    auto vertex = [&](const UnsignedInt ring, const UnsignedInt segment) {
+        return 1 + (ring - 1)*segments + segment%segments;
+    };
+    auto triangle = [&](const UnsignedInt a, const UnsignedInt b, const UnsignedInt c) {
+        /* Flip to face outwards */
+        const Vector3 normal = Math::cross(mesh.positions[b] - mesh.positions[a], mesh.positions[c] - mesh.positions[a]);
+        if(Math::dot(normal, mesh.positions[a] + mesh.positions[b] + mesh.positions[c]) >= 0.0f)
+            mesh.indices.insert(mesh.indices.end(), {a, b, c});
+        else mesh.indices.insert(mesh.indices.end(), {a, c, b});
+    };
+    for(UnsignedInt segment = 0; segment != segments; ++segment) {
+        triangle(0, vertex(1, segment), vertex(1, segment + 1));
+        for(UnsignedInt ring = 1; ring + 1 < rings; ++ring) {
+            triangle(vertex(ring, segment), vertex(ring + 1, segment), vertex(ring + 1, segment + 1));
+            triangle(vertex(ring, segment), vertex(ring + 1, segment + 1), vertex(ring, segment + 1));
+        }
+        triangle(south, vertex(rings - 1, segment + 1), vertex(rings - 1, segment));
+    }
+    return mesh;
+}
+
+/* A size x size quad grid in the XY plane, facing +Z */
+Mesh grid(const UnsignedInt size, const Vector3& offset = {}) {
+    Mesh mesh;
+    for(UnsignedInt y = 0; y <= size; ++y)
+        for(UnsignedInt x = 0; x <= size; ++x)
+            mesh.positions.push_back(offset + Vector3{Float(x), Float(y), 0.0f});
+    for(UnsignedInt y = 0; y != size; ++y) {
+        for(UnsignedInt x = 0; x != size; ++x) {
+            const UnsignedInt a = y*(size + 1) + x;
+            const UnsignedInt c = a + size + 1;
+            mesh.indices.insert(mesh.indices.end(), {a, a + 1, c + 1, a, c + 1, c});
+        }
+    }
+    return mesh;
+}
+
+void MeshletsTest::build() {
+    auto&& data = BuildData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    const Mesh mesh = sphere(16, 24);
+    const MeshletData meshlets = buildMeshlets(mesh.indices, mesh.positions, data.maxVertexCount, data.maxTriangleCount);
+    CORRADE_COMPARE(meshlets.boundingSpheres.size(), meshlets.meshlets.size());
+    CORRADE_COMPARE(meshlets.normalCones.size(), meshlets.meshlets.size());
+
+    std::vector<std::array<UnsignedInt, 3>> triangles;
+    for(std::size_t i = 0; i != meshlets.meshlets.size(); ++i) {
+        const Meshlet& meshlet = meshlets.meshlets[i];
+        CORRADE_VERIFY(meshlet.vertexCount <= data.maxVertexCount);
+        CORRADE_VERIFY(meshlet.triangleCount <= data.maxTriangleCount);
+        CORRADE_VERIFY(meshlet.triangleCount);
+        CORRADE_COMPARE(meshlet.triangleOffset % 3, 0);
+        CORRADE_VERIFY(meshlet.vertexOffset + meshlet.vertexCount <= meshlets.vertices.size());
+        CORRADE_VERIFY(meshlet.triangleOffset + meshlet.triangleCount*3 <= meshlets.triangles.size());
+
+        const Vector4 sphere = meshlets.boundingSpheres[i];
+        const Vector4 cone = meshlets.normalCones[i];
+        CORRADE_VERIFY(cone.w() >= 0.0f);
+        CORRADE_VERIFY(cone.w() <= 1.0f);
+        if(cone.w() < 1.0f) CORRADE_VERIFY(cone.xyz().isNormalized());
+        const Float cosine = Math::sqrt(1.0f - cone.w()*cone.w());
+
+        for(UnsignedInt t = 0; t != meshlet.triangleCount; ++t) {
+            std::array<UnsignedInt, 3> triangle;
+            for(UnsignedInt j = 0; j != 3; ++j) {
+                const UnsignedByte local = meshlets.triangles[meshlet.triangleOffset + t*3 + j];
+                CORRADE_VERIFY(local < meshlet.vertexCount);
+                triangle[j] = meshlets.vertices[meshlet.vertexOffset + local];
+
+                /* All vertices are inside the bounding sphere */
+                CORRADE_VERIFY((mesh.positions[triangle[j]] - sphere.xyz()).length() <= sphere.w()*1.0001f);
+            }
+
+            /* All triangle normals are inside the cone */
+            if(cone.w() < 1.0f) {
+                const Vector3 normal = Math::cross(
+                    mesh.positions[triangle[1]] - mesh.positions[triangle[0]],
+                    mesh.positions[triangle[2]] - mesh.positions[triangle[0]]).normalized();
+                CORRADE_VERIFY(Math::dot(normal, cone.xyz()) >= cosine - 1.0e-5f);
+            }
+
+            triangles.push_back(triangle);
+        }
+    }
+
+    /* Each original triangle is there exactly once, with the winding kept */
+    std::vector<std::array<UnsignedInt, 3>> expected;
+    for(std::size_t i = 0; i != mesh.indices.size(); i += 3)
+        expected.push_back({{mesh.indices[i], mesh.indices[i + 1], mesh.indices[i + 2]}});
+    auto rotateSmallestFirst = [](std::array<UnsignedInt, 3>& t) {
+        std::rotate(t.begin(), std::min_element(t.begin(), t.end()), t.end());
+    };
+    for(auto& t: triangles) rotateSmallestFirst(t);
+    for(auto& t: expected) rotateSmallestFirst(t);
+    std::sort(triangles.begin(), triangles.end());
+    std::sort(expected.begin(), expected.end());
+    CORRADE_VERIFY(triangles == expected);
+
+    /* The meshlets are filled up reasonably, not one triangle each */
+    if(data.maxTriangleCount >= 8 && data.maxVertexCount >= 10)
+        CORRADE_VERIFY(meshlets.meshlets.size() < mesh.indices.size()/3/4);
+}
+
+void MeshletsTest::buildFlat() {
+    const Mesh mesh = grid(16);
+    const MeshletData meshlets = buildMeshlets(mesh.indices, mesh.positions);
+    CORRADE_VERIFY(!meshlets.meshlets.empty());
+
+    /* All triangles face the same direction, so the cones are degenerate */
+    for(const Vector4& cone: meshlets.normalCones) {
+        CORRADE_COMPARE(cone.xyz(), Vector3::zAxis());
+        CORRADE_COMPARE(cone.w(), 0.0f);
+    }
+}
+
+void MeshletsTest::buildDisconnected() {
+    /* Two grids far apart, with the second one referenced first in the
+       index buffer */
+    const Mesh a = grid(4);
+    const Mesh b = grid(4, {100.0f, 0.0f, 0.0f});
+    Mesh mesh;
+    mesh.positions = a.positions;
+    mesh.positions.insert(mesh.positions.end(), b.positions.begin(), b.positions.end());
+    for(const UnsignedInt i: b.indices) mesh.indices.push_back(i + a.positions.size());
+    mesh.indices.insert(mesh.indices.end(), a.indices.begin(), a.indices.end());
+
+    const MeshletData meshlets = buildMeshlets(mesh.indices, mesh.positions);
+
+    /* Both grids fit into a single meshlet. The part the meshlet started
+       with is exhausted first before continuing with the other. */
+    CORRADE_COMPARE(meshlets.meshlets.size(), 1);
+    CORRADE_COMPARE(meshlets.meshlets[0].triangleCount, 64);
+    CORRADE_COMPARE(meshlets.meshlets[0].vertexCount, 50);
+    for(UnsignedInt i = 0; i != 64*3; ++i) {
+        const UnsignedInt vertex = meshlets.vertices[meshlets.triangles[i]];
+        if(i < 32*3) CORRADE_VERIFY(vertex >= 25);
+        else CORRADE_VERIFY(vertex < 25);
+    }
+
+    /* The bounding sphere spans both */
+    const Vector4 sphere = meshlets.boundingSpheres[0];
+    for(const Vector3& corner: {Vector3{0.0f, 0.0f, 0.0f},
+                                Vector3{0.0f, 4.0f, 0.0f},
+                                Vector3{104.0f, 0.0f, 0.0f},
+                                Vector3{104.0f, 4.0f, 0.0f}})
+        CORRADE_VERIFY((corner - sphere.xyz()).length() <= sphere.w()*1.0001f);
+}
+
+void MeshletsTest::buildDegenerate() {
+    const Vector3 positions[]{
+        {0.0f, 0.0f, 0.0f},
+        {1.0f, 0.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f},
+        {2.0f, 0.0f, 0.0f}
+    };
+    /* The second triangle has zero area */
+    const UnsignedInt indices[]{
+        0, 1, 2,
+        0, 1, 3
+    };
+
+    const MeshletData meshlets = buildMeshlets(indices, positions);
+    CORRADE_COMPARE(meshlets.meshlets.size(), 1);
+    CORRADE_COMPARE(meshlets.meshlets[0].triangleCount, 2);
+    CORRADE_COMPARE(meshlets.meshlets[0].vertexCount, 4);
+
+    /* It doesn't affect the cone */
+    CORRADE_COMPARE(meshlets.normalCones[0], (Vector4{0.0f, 0.0f, 1.0f, 0.0f}));
+}
+
+void MeshletsTest::buildEmpty() {
+    const MeshletData meshlets = buildMeshlets(nullptr, nullptr);
+    CORRADE_VERIFY(meshlets.meshlets.empty());
+    CORRADE_VERIFY(meshlets.vertices.empty());
+    CORRADE_VERIFY(meshlets.triangles.empty());
+    CORRADE_VERIFY(meshlets.boundingSpheres.empty());
+    CORRADE_VERIFY(meshlets.normalCones.empty());
+}
+
+void MeshletsTest::buildWrongIndexCount() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    const Vector3 positions[3];
+    const UnsignedInt indices[4]{};
+    buildMeshlets(indices, positions);
+    CORRADE_COMPARE(out.str(), "MeshTools::buildMeshlets(): index count not divisible by 3\n");
+}
+
+void MeshletsTest::buildInvalidLimits() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    const Vector3 positions[3];
+    const UnsignedInt indices[3]{};
+    buildMeshlets(indices, positions, 2, 126);
+    buildMeshlets(indices, positions, 257, 126);
+    buildMeshlets(indices, positions, 64, 0);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::buildMeshlets(): expected max vertex count between 3 and 256 but got 2\n"
+        "MeshTools::buildMeshlets(): expected max vertex count between 3 and 256 but got 257\n"
+        "MeshTools::buildMeshlets(): expected non-zero max triangle count\n");
+}
+
+void MeshletsTest::buildIndexOutOfBounds() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    const Vector3 positions[3];
+    const UnsignedInt indices[]{0, 1, 2, 2, 1, 3};
+    buildMeshlets(indices, positions);
+    CORRADE_COMPARE(out.str(), "MeshTools::buildMeshlets(): index 3 out of bounds for 3 vertices\n");
+}
+
+/* Frustum of a camera at given position looking at the origin */
+Frustum cameraFrustum(const Vector3& position) {
+    const Matrix4 camera = Matrix4::lookAt(position, {}, Vector3::yAxis());
+    return Frustum::fromMatrix(Matrix4::perspectiveProjection(Deg(60.0f), 1.0f, 0.1f, 100.0f)*camera.invertedRigid());
+}
+
+void MeshletsTest::cullBackfacing() {
+    const Mesh mesh = grid(16, {-8.0f, -8.0f, 0.0f});
+    const MeshletData meshlets = buildMeshlets(mesh.indices, mesh.positions);
+    std::vector<UnsignedInt> visible(meshlets.meshlets.size());
+
+    /* Looking at the front, everything is visible */
+    const Vector3 front{0.0f, 0.0f, 20.0f};
+    CORRADE_COMPARE(cullMeshlets(meshlets, cameraFrustum(front), front, visible), meshlets.meshlets.size());
+    for(std::size_t i = 0; i != visible.size(); ++i)
+        CORRADE_COMPARE(visible[i], i);
+
+    /* Looking at the back, nothing is */
+    const Vector3 back{0.0f, 0.0f, -20.0f};
+    CORRADE_COMPARE(cullMeshlets(meshlets, cameraFrustum(back), back, visible), 0);
+}
+
+void MeshletsTest::cullFrustum() {
+    const Mesh mesh = grid(16, {-8.0f, -8.0f, 0.0f});
+    const MeshletData meshlets = buildMeshlets(mesh.indices, mesh.positions, 16, 16);
+    std::vector<UnsignedInt> visible(meshlets.meshlets.size());
+
+    /* A camera close to the grid sees only the meshlets near the center */
+    const Vector3 camera{0.0f, 0.0f, 2.0f};
+    const Frustum frustum = cameraFrustum(camera);
+    const std::size_t count = cullMeshlets(meshlets, frustum, camera, visible);
+    CORRADE_VERIFY(count > 0);
+    CORRADE_VERIFY(count < meshlets.meshlets.size());
+
+    for(std::size_t i = 0; i != count; ++i) {
+        const Vector4 sphere = meshlets.boundingSpheres[visible[i]];
+        CORRADE_VERIFY(Math::abs(sphere.xyz()).max() < 1.2f + sphere.w());
+    }
+}
+
+void MeshletsTest::cullConservative() {
+    const Mesh mesh = sphere(24, 32);
+    const MeshletData meshlets = buildMeshlets(mesh.indices, mesh.positions, 32, 32);
+    std::vector<UnsignedInt> visible(meshlets.meshlets.size());
+
+    for(const Vector3& camera: {Vector3{0.0f, 0.0f, 3.0f},
+                                Vector3{2.0f, 1.5f, -1.0f},
+                                Vector3{-1.2f, 0.0f, 0.5f}}) {
+        const Frustum frustum = cameraFrustum(camera);
+        const std::size_t count = cullMeshlets(meshlets, frustum, camera, visible);
+
+        /* Some are culled, but not all */
+        CORRADE_VERIFY(count > 0);
+        CORRADE_VERIFY(count < meshlets.meshlets.size());
+
+        /* Brute-force check that every meshlet with a front-facing triangle
+           having a vertex inside the frustum is among the visible ones */
+        std::vector<bool> isVisible(meshlets.meshlets.size());
+        for(std::size_t i = 0; i != count; ++i) isVisible[visible[i]] = true;
+        for(std::size_t i = 0; i != meshlets.meshlets.size(); ++i) {
+            const Meshlet& meshlet = meshlets.meshlets[i];
+            bool shouldBeVisible = false;
+            for(UnsignedInt t = 0; t != meshlet.triangleCount && !shouldBeVisible; ++t) {
+                Vector3 p[3];
+                for(UnsignedInt j = 0; j != 3; ++j)
+                    p[j] = mesh.positions[meshlets.vertices[meshlet.vertexOffset + meshlets.triangles[meshlet.triangleOffset + t*3 + j]]];
+                if(Math::dot(Math::cross(p[1] - p[0], p[2] - p[0]), p[0] - camera) >= 0.0f)
+                    continue;
+                for(const Vector3& v: p) {
+                    bool inside = true;
+                    for(std::size_t plane = 0; plane != 6; ++plane)
+                        if(Math::dot(frustum[plane].xyz(), v) + frustum[plane].w() < 0.0f) inside = false;
+                    if(inside) shouldBeVisible = true;
+                }
+            }
+
+            if(shouldBeVisible) CORRADE_VERIFY(isVisible[i]);
+        }
+    }
+}
+
+void MeshletsTest::cullEmpty() {
+    const MeshletData meshlets;
+    CORRADE_COMPARE(cullMeshlets(meshlets, cameraFrustum({0.0f, 0.0f, 1.0f}), {0.0f, 0.0f, 1.0f}, nullptr), 0);
+}
+
+void MeshletsTest::cullWrongSize() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    const Mesh mesh = grid(16);
+    const MeshletData meshlets = buildMeshlets(mesh.indices, mesh.positions, 16, 16);
+    std::vector<UnsignedInt> visible(meshlets.meshlets.size() - 1);
+    cullMeshlets(meshlets, cameraFrustum({0.0f, 0.0f, 1.0f}), {0.0f, 0.0f, 1.0f}, visible);
+    CORRADE_COMPARE(out.str(), Utility::formatString("MeshTools::cullMeshlets(): expected at least {} output items but got {}\n", meshlets.meshlets.size(), visible.size()));
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::MeshletsTest)
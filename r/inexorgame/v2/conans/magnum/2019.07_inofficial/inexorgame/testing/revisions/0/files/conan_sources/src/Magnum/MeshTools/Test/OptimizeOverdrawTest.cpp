@@ -0,0 +1,142 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/OptimizeOverdraw.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+struct OptimizeOverdrawTest: TestSuite::Tester {
+    explicit OptimizeOverdrawTest();
+
+    void optimize();
+    void optimizeUnsignedShort();
+    void optimizeSameOcclusion();
+    void optimizeEmpty();
+    void optimizeNotDivisibleByThree();
+    void optimizeZeroCacheSize();
+    void optimizeIndexOutOfBounds();
+};
+
+OptimizeOverdrawTest::OptimizeOverdrawTest() {
+    addTests({&OptimizeOverdrawTest::optimize,
+              &OptimizeOverdrawTest::optimizeUnsignedShort,
+              &OptimizeOverdrawTest::optimizeSameOcclusion,
+              &OptimizeOverdrawTest::optimizeEmpty,
+              &OptimizeOverdrawTest::optimizeNotDivisibleByThree,
+              &OptimizeOverdrawTest::optimizeZeroCacheSize,
+              &OptimizeOverdrawTest::optimizeIndexOutOfBounds});
+}
+
+/* Two disconnected triangles facing +Z, the first one behind the mesh
+   centroid, the second one in front of it */
+const Vector3 Positions[]{
+    {0.0f, 0.0f, -1.0f},
+    {1.0f, 0.0f, -1.0f},
+    {0.0f, 1.0f, -1.0f},
+    {0.0f, 0.0f, 1.0f},
+    {1.0f, 0.0f, 1.0f},
+    {0.0f, 1.0f, 1.0f}
+};
+
+void OptimizeOverdrawTest::optimize() {
+    /* Each triangle is a separate cluster, the front one has a higher
+       occlusion potential and thus gets drawn first */
+    UnsignedInt indices[]{0, 1, 2, 3, 4, 5};
+    optimizeOverdrawInPlace(indices, Positions, 16);
+
+    const UnsignedInt expected[]{3, 4, 5, 0, 1, 2};
+    CORRADE_COMPARE_AS(Containers::arrayView(indices), Containers::arrayView(expected),
+        TestSuite::Compare::Container);
+}
+
+void OptimizeOverdrawTest::optimizeUnsignedShort() {
+    UnsignedShort indices[]{0, 1, 2, 3, 4, 5};
+    optimizeOverdrawInPlace(indices, Positions, 16);
+
+    const UnsignedShort expected[]{3, 4, 5, 0, 1, 2};
+    CORRADE_COMPARE_AS(Containers::arrayView(indices), Containers::arrayView(expected),
+        TestSuite::Compare::Container);
+}
+
+void OptimizeOverdrawTest::optimizeSameOcclusion() {
+    /* Both triangles in the same plane through the centroid, the original
+       order is kept */
+    const Vector3 positions[]{
+        {0.0f, 0.0f, 0.0f},
+        {1.0f, 0.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f},
+        {2.0f, 0.0f, 0.0f},
+        {3.0f, 0.0f, 0.0f},
+        {2.0f, 1.0f, 0.0f}
+    };
+    UnsignedInt indices[]{3, 4, 5, 0, 1, 2};
+    optimizeOverdrawInPlace(indices, positions, 16);
+
+    const UnsignedInt expected[]{3, 4, 5, 0, 1, 2};
+    CORRADE_COMPARE_AS(Containers::arrayView(indices), Containers::arrayView(expected),
+        TestSuite::Compare::Container);
+}
+
+void OptimizeOverdrawTest::optimizeEmpty() {
+    optimizeOverdrawInPlace(Containers::ArrayView<UnsignedInt>{}, Positions, 16);
+    CORRADE_VERIFY(true);
+}
+
+void OptimizeOverdrawTest::optimizeNotDivisibleByThree() {
+    UnsignedInt indices[4]{};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    optimizeOverdrawInPlace(indices, Positions, 16);
+    CORRADE_COMPARE(out.str(), "MeshTools::optimizeOverdrawInPlace(): index count not divisible by 3\n");
+}
+
+void OptimizeOverdrawTest::optimizeZeroCacheSize() {
+    UnsignedInt indices[3]{};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    optimizeOverdrawInPlace(indices, Positions, 0);
+    CORRADE_COMPARE(out.str(), "MeshTools::optimizeOverdrawInPlace(): cache size can't be zero\n");
+}
+
+void OptimizeOverdrawTest::optimizeIndexOutOfBounds() {
+    UnsignedInt indices[]{0, 1, 6};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    optimizeOverdrawInPlace(indices, Positions, 16);
+    CORRADE_COMPARE(out.str(), "MeshTools::optimizeOverdrawInPlace(): index 6 out of bounds for 6 vertices\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::OptimizeOverdrawTest)
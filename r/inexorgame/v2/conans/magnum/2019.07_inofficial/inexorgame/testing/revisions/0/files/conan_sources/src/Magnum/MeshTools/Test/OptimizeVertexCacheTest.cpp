@@ -0,0 +1,199 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <random>
+#include <sstream>
+#include <tuple>
+#include <vector>
+#include <Corrade/Containers/ArrayViewStl.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/MeshTools/OptimizeVertexCache.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+struct OptimizeVertexCacheTest: TestSuite::Tester {
+    explicit OptimizeVertexCacheTest();
+
+    void optimize();
+    void optimizeUnsignedShort();
+    void optimizeEmpty();
+    void optimizeNotDivisibleByThree();
+    void optimizeIndexOutOfBounds();
+
+    void analyze();
+    void analyzeSmallCache();
+    void analyzeNotDivisibleByThree();
+    void analyzeZeroCacheSize();
+    void analyzeIndexOutOfBounds();
+};
+
+OptimizeVertexCacheTest::OptimizeVertexCacheTest() {
+    addTests({&OptimizeVertexCacheTest::optimize,
+              &OptimizeVertexCacheTest::optimizeUnsignedShort,
+              &OptimizeVertexCacheTest::optimizeEmpty,
+              &OptimizeVertexCacheTest::optimizeNotDivisibleByThree,
+              &OptimizeVertexCacheTest::optimizeIndexOutOfBounds,
+
+              &OptimizeVertexCacheTest::analyze,
+              &OptimizeVertexCacheTest::analyzeSmallCache,
+              &OptimizeVertexCacheTest::analyzeNotDivisibleByThree,
+              &OptimizeVertexCacheTest::analyzeZeroCacheSize,
+              &OptimizeVertexCacheTest::analyzeIndexOutOfBounds});
+}
+
+/* A grid of size*size quads split into triangles, with the triangle order
+   shuffled to make the vertex cache usage bad */
+template<class T> std::vector<T> shuffledGrid(const UnsignedInt size) {
+    std::vector<std::tuple<T, T, T>> triangles;
+    for(UnsignedInt y = 0; y != size; ++y) for(UnsignedInt x = 0; x != size; ++x) {
+        const T a = y*(size + 1) + x, b = a + 1, c = a + size + 1, d = c + 1;
+        triangles.emplace_back(a, b, d);
+        triangles.emplace_back(a, d, c);
+    }
+    std::shuffle(triangles.begin(), triangles.end(), std::minstd_rand{});
+
+    std::vector<T> indices;
+    for(const std::tuple<T, T, T>& t: triangles) {
+        indices.push_back(std::get<0>(t));
+        indices.push_back(std::get<1>(t));
+        indices.push_back(std::get<2>(t));
+    }
+    return indices;
+}
+
+/* Triangles sorted, to verify the optimizer only reorders them */
+template<class T> std::vector<std::tuple<T, T, T>> sortedTriangles(const std::vector<T>& indices) {
+    std::vector<std::tuple<T, T, T>> triangles;
+    for(std::size_t i = 0; i != indices.size(); i += 3)
+        triangles.emplace_back(indices[i], indices[i + 1], indices[i + 2]);
+    std::sort(triangles.begin(), triangles.end());
+    return triangles;
+}
+
+void OptimizeVertexCacheTest::optimize() {
+    std::vector<UnsignedInt> indices = shuffledGrid<UnsignedInt>(16);
+    const std::vector<UnsignedInt> original = indices;
+    const VertexCacheStatistics before = analyzeVertexCache(Containers::arrayView(indices), 17*17, 16);
+
+    optimizeVertexCacheInPlace(Containers::arrayView(indices), 17*17);
+    const VertexCacheStatistics after = analyzeVertexCache(Containers::arrayView(indices), 17*17, 16);
+
+    /* The triangles, including their winding, stay the same, only the order
+       changes */
+    CORRADE_VERIFY(sortedTriangles(indices) == sortedTriangles(original));
+
+    /* A regular grid gets close to one transform per triangle */
+    CORRADE_VERIFY(after.acmr < before.acmr);
+    CORRADE_VERIFY(after.acmr < 0.8f);
+    CORRADE_VERIFY(after.atvr < 1.5f);
+}
+
+void OptimizeVertexCacheTest::optimizeUnsignedShort() {
+    std::vector<UnsignedInt> indices = shuffledGrid<UnsignedInt>(8);
+    std::vector<UnsignedShort> indicesShort = shuffledGrid<UnsignedShort>(8);
+
+    optimizeVertexCacheInPlace(Containers::arrayView(indices), 9*9);
+    optimizeVertexCacheInPlace(Containers::arrayView(indicesShort), 9*9);
+
+    /* Same result regardless of the index type */
+    CORRADE_COMPARE_AS(indicesShort, (std::vector<UnsignedShort>{indices.begin(), indices.end()}),
+        TestSuite::Compare::Container);
+}
+
+void OptimizeVertexCacheTest::optimizeEmpty() {
+    optimizeVertexCacheInPlace(Containers::ArrayView<UnsignedInt>{}, 0);
+    CORRADE_VERIFY(true);
+}
+
+void OptimizeVertexCacheTest::optimizeNotDivisibleByThree() {
+    UnsignedInt indices[4]{};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    optimizeVertexCacheInPlace(indices, 3);
+    CORRADE_COMPARE(out.str(), "MeshTools::optimizeVertexCacheInPlace(): index count not divisible by 3\n");
+}
+
+void OptimizeVertexCacheTest::optimizeIndexOutOfBounds() {
+    UnsignedInt indices[]{0, 1, 3};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    optimizeVertexCacheInPlace(indices, 3);
+    CORRADE_COMPARE(out.str(), "MeshTools::optimizeVertexCacheInPlace(): index 3 out of bounds for 3 vertices\n");
+}
+
+void OptimizeVertexCacheTest::analyze() {
+    /* Two triangles sharing an edge, each vertex transformed once */
+    const UnsignedInt indices[]{0, 1, 2, 2, 1, 3};
+    const VertexCacheStatistics stats = analyzeVertexCache(indices, 4, 16);
+    CORRADE_COMPARE(stats.vertexTransformCount, 4);
+    CORRADE_COMPARE(stats.acmr, 2.0f);
+    CORRADE_COMPARE(stats.atvr, 1.0f);
+}
+
+void OptimizeVertexCacheTest::analyzeSmallCache() {
+    /* With a single-entry FIFO only the immediately repeated 2 is a hit */
+    const UnsignedShort indices[]{0, 1, 2, 2, 1, 3};
+    const VertexCacheStatistics stats = analyzeVertexCache(indices, 4, 1);
+    CORRADE_COMPARE(stats.vertexTransformCount, 5);
+    CORRADE_COMPARE(stats.acmr, 2.5f);
+    CORRADE_COMPARE(stats.atvr, 1.25f);
+}
+
+void OptimizeVertexCacheTest::analyzeNotDivisibleByThree() {
+    const UnsignedInt indices[4]{};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    analyzeVertexCache(indices, 3, 16);
+    CORRADE_COMPARE(out.str(), "MeshTools::analyzeVertexCache(): index count not divisible by 3\n");
+}
+
+void OptimizeVertexCacheTest::analyzeZeroCacheSize() {
+    const UnsignedInt indices[3]{};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    analyzeVertexCache(indices, 3, 0);
+    CORRADE_COMPARE(out.str(), "MeshTools::analyzeVertexCache(): cache size can't be zero\n");
+}
+
+void OptimizeVertexCacheTest::analyzeIndexOutOfBounds() {
+    const UnsignedInt indices[]{0, 1, 3};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    analyzeVertexCache(indices, 3, 16);
+    CORRADE_COMPARE(out.str(), "MeshTools::analyzeVertexCache(): index 3 out of bounds for 3 vertices\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::OptimizeVertexCacheTest)
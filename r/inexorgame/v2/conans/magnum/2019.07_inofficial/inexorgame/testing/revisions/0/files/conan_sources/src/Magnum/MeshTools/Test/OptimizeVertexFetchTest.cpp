@@ -0,0 +1,130 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Vector2.h"
+#include "Magnum/MeshTools/OptimizeVertexFetch.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+struct OptimizeVertexFetchTest: TestSuite::Tester {
+    explicit OptimizeVertexFetchTest();
+
+    void remap();
+    void remapUnsignedShort();
+    void remapIndexOutOfBounds();
+
+    void optimize();
+    void optimizeNonContiguous();
+};
+
+OptimizeVertexFetchTest::OptimizeVertexFetchTest() {
+    addTests({&OptimizeVertexFetchTest::remap,
+              &OptimizeVertexFetchTest::remapUnsignedShort,
+              &OptimizeVertexFetchTest::remapIndexOutOfBounds,
+
+              &OptimizeVertexFetchTest::optimize,
+              &OptimizeVertexFetchTest::optimizeNonContiguous});
+}
+
+void OptimizeVertexFetchTest::remap() {
+    /* Vertices 2 and 4 are not referenced */
+    UnsignedInt indices[]{3, 1, 3, 0, 1, 0};
+    UnsignedInt remap[5];
+    CORRADE_COMPARE(optimizeVertexFetchRemapInPlace(indices, remap), 3);
+
+    const UnsignedInt expectedIndices[]{0, 1, 0, 2, 1, 2};
+    const UnsignedInt expectedRemap[]{2, 1, ~UnsignedInt{}, 0, ~UnsignedInt{}};
+    CORRADE_COMPARE_AS(Containers::arrayView(indices), Containers::arrayView(expectedIndices),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(Containers::arrayView(remap), Containers::arrayView(expectedRemap),
+        TestSuite::Compare::Container);
+}
+
+void OptimizeVertexFetchTest::remapUnsignedShort() {
+    UnsignedShort indices[]{3, 1, 3, 0, 1, 0};
+    UnsignedInt remap[5];
+    CORRADE_COMPARE(optimizeVertexFetchRemapInPlace(indices, remap), 3);
+
+    const UnsignedShort expectedIndices[]{0, 1, 0, 2, 1, 2};
+    const UnsignedInt expectedRemap[]{2, 1, ~UnsignedInt{}, 0, ~UnsignedInt{}};
+    CORRADE_COMPARE_AS(Containers::arrayView(indices), Containers::arrayView(expectedIndices),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(Containers::arrayView(remap), Containers::arrayView(expectedRemap),
+        TestSuite::Compare::Container);
+}
+
+void OptimizeVertexFetchTest::remapIndexOutOfBounds() {
+    UnsignedInt indices[]{0, 1, 5};
+    UnsignedInt remap[5];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    optimizeVertexFetchRemapInPlace(indices, remap);
+    CORRADE_COMPARE(out.str(), "MeshTools::optimizeVertexFetchRemapInPlace(): index 5 out of bounds for 5 vertices\n");
+}
+
+void OptimizeVertexFetchTest::optimize() {
+    Vector2 vertices[]{
+        {0.0f, 0.0f},
+        {1.0f, 1.0f},
+        {2.0f, 2.0f},
+        {3.0f, 3.0f},
+        {4.0f, 4.0f}
+    };
+    UnsignedInt indices[]{3, 1, 3, 0, 1, 0};
+    CORRADE_COMPARE(optimizeVertexFetchInPlace(indices, Containers::arrayCast<2, char>(Containers::stridedArrayView(vertices))), 3);
+
+    /* The referenced vertices are moved to the front in order of first
+       use, the rest is unspecified */
+    const UnsignedInt expectedIndices[]{0, 1, 0, 2, 1, 2};
+    const Vector2 expectedVertices[]{
+        {3.0f, 3.0f},
+        {1.0f, 1.0f},
+        {0.0f, 0.0f}
+    };
+    CORRADE_COMPARE_AS(Containers::arrayView(indices), Containers::arrayView(expectedIndices),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(Containers::arrayView(vertices).prefix(3), Containers::arrayView(expectedVertices),
+        TestSuite::Compare::Container);
+}
+
+void OptimizeVertexFetchTest::optimizeNonContiguous() {
+    UnsignedInt indices[]{0, 1, 2};
+    char vertices[12]{};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    optimizeVertexFetchInPlace(indices, Containers::StridedArrayView2D<char>{vertices, {3, 2}, {4, 2}});
+    CORRADE_COMPARE(out.str(), "MeshTools::optimizeVertexFetchInPlace(): second vertex view dimension is not contiguous\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::OptimizeVertexFetchTest)
@@ -0,0 +1,449 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstring>
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/Packing.h"
+#include "Magnum/MeshTools/Pack.h"
+
+#ifdef MAGNUM_TARGET_GL
+#include "Magnum/Mesh.h"
+#include "Magnum/Shaders/Generic.h"
+#include "Magnum/Trade/MeshData3D.h"
+#endif
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+using namespace Math::Literals;
+
+struct PackTest: TestSuite::Tester {
+    explicit PackTest();
+
+    void positions();
+    void positionsStrided();
+    void positionsSinglePoint();
+    void positionsEmpty();
+    void positionsWrongSize();
+
+    void normals1010102();
+    void normalsByte();
+    void normalsOctahedral();
+    void normalsOctahedralZero();
+    void normalsWrongSize();
+
+    void textureCoordinatesHalf();
+    void textureCoordinatesUnsignedShort();
+    void textureCoordinatesWrongSize();
+
+    void colors();
+    void colorsWrongSize();
+
+    #ifdef MAGNUM_TARGET_GL
+    void vertices();
+    void verticesPositionsOnly();
+    void verticesOctahedral();
+    #endif
+};
+
+PackTest::PackTest() {
+    addTests({&PackTest::positions,
+              &PackTest::positionsStrided,
+              &PackTest::positionsSinglePoint,
+              &PackTest::positionsEmpty,
+              &PackTest::positionsWrongSize,
+
+              &PackTest::normals1010102,
+              &PackTest::normalsByte,
+              &PackTest::normalsOctahedral,
+              &PackTest::normalsOctahedralZero,
+              &PackTest::normalsWrongSize,
+
+              &PackTest::textureCoordinatesHalf,
+              &PackTest::textureCoordinatesUnsignedShort,
+              &PackTest::textureCoordinatesWrongSize,
+
+              &PackTest::colors,
+              &PackTest::colorsWrongSize,
+
+              #ifdef MAGNUM_TARGET_GL
+              &PackTest::vertices,
+              &PackTest::verticesPositionsOnly,
+              &PackTest::verticesOctahedral
+              #endif
+              });
+}
+
+/* Normals spread over the whole sphere, including the axes and the
+   octahedron folding edges */
+Containers::Array<Vector3> sphereNormals() {
+    constexpr std::size_t Rings = 17;
+    constexpr std::size_t Segments = 32;
+    Containers::Array<Vector3> normals{Containers::NoInit, Rings*Segments + 6};
+    std::size_t i = 0;
+    for(std::size_t ring = 0; ring != Rings; ++ring) {
+        const Rad theta{Constants::pi()*(ring + 0.5f)/Rings};
+        for(std::size_t segment = 0; segment != Segments; ++segment) {
+            const Rad phi{Constants::tau()*segment/Segments};
+            normals[i++] = {Math::sin(theta)*Math::cos(phi), Math::sin(theta)*Math::sin(phi), Math::cos(theta)};
+        }
+    }
+    normals[i++] = Vector3::xAxis();
+    normals[i++] = -Vector3::xAxis();
+    normals[i++] = Vector3::yAxis();
+    normals[i++] = -Vector3::yAxis();
+    normals[i++] = Vector3::zAxis();
+    normals[i++] = -Vector3::zAxis();
+    return normals;
+}
+
+/* The decoding routine from the packNormalsOctahedralInto() docs */
+Vector3 decodeOctahedral(const Math::Vector2<Short>& packed) {
+    const Vector2 e = Math::unpack<Vector2>(packed);
+    Vector3 n{e, 1.0f - Math::abs(e.x()) - Math::abs(e.y())};
+    const Float t = Math::max(-n.z(), 0.0f);
+    n.x() += n.x() >= 0.0f ? -t : t;
+    n.y() += n.y() >= 0.0f ? -t : t;
+    return n.normalized();
+}
+
+void PackTest::positions() {
+    const Vector3 positions[]{
+        {-1.0f, 2.0f, 0.5f},
+        {3.0f, -2.0f, 0.25f},
+        {0.0f, 0.0f, 0.0f},
+        {1.5f, 1.0f, -0.5f}
+    };
+    Math::Vector3<UnsignedShort> packed[4];
+    const Matrix4 transformation = packPositionsInto(positions, packed);
+
+    /* Translation to the min corner and uniform scale by the largest
+       dimension, which is 4 in both X and Y */
+    CORRADE_COMPARE(transformation, Matrix4::translation({-1.0f, -2.0f, -0.5f})*Matrix4::scaling(Vector3{4.0f}));
+    CORRADE_COMPARE(packed[0], (Math::Vector3<UnsignedShort>{0, 65535, 16384}));
+    CORRADE_COMPARE(packed[1], (Math::Vector3<UnsignedShort>{65535, 0, 12288}));
+
+    /* Reconstructed positions are within half a quantization step */
+    for(std::size_t i = 0; i != Containers::arraySize(positions); ++i) {
+        const Vector3 unpacked = transformation.transformPoint(Math::unpack<Vector3>(packed[i]));
+        CORRADE_VERIFY((unpacked - positions[i]).max() <= 4.0f/65535.0f);
+        CORRADE_VERIFY((positions[i] - unpacked).max() <= 4.0f/65535.0f);
+    }
+}
+
+void PackTest::positionsStrided() {
+    struct Vertex {
+        Vector3 position;
+        Math::Vector3<UnsignedShort> packed;
+        UnsignedShort sentinel;
+    } vertices[]{
+        {{0.0f, 0.0f, 0.0f}, {}, 0xdead},
+        {{1.0f, 0.5f, 0.25f}, {}, 0xbeef},
+        {{2.0f, 1.0f, 0.5f}, {}, 0xcafe}
+    };
+    const Matrix4 transformation = packPositionsInto(
+        {Containers::arrayView(vertices), &vertices[0].position, 3, sizeof(Vertex)},
+        {Containers::arrayView(vertices), &vertices[0].packed, 3, sizeof(Vertex)});
+
+    CORRADE_COMPARE(transformation, Matrix4::scaling(Vector3{2.0f}));
+    CORRADE_COMPARE(vertices[0].packed, (Math::Vector3<UnsignedShort>{0, 0, 0}));
+    CORRADE_COMPARE(vertices[1].packed, (Math::Vector3<UnsignedShort>{32768, 16384, 8192}));
+    CORRADE_COMPARE(vertices[2].packed, (Math::Vector3<UnsignedShort>{65535, 32768, 16384}));
+    CORRADE_COMPARE(vertices[0].sentinel, 0xdead);
+    CORRADE_COMPARE(vertices[1].sentinel, 0xbeef);
+    CORRADE_COMPARE(vertices[2].sentinel, 0xcafe);
+}
+
+void PackTest::positionsSinglePoint() {
+    /* Zero-size bounds shouldn't result in a division by zero */
+    const Vector3 positions[]{{1.0f, 2.0f, 3.0f}, {1.0f, 2.0f, 3.0f}};
+    Math::Vector3<UnsignedShort> packed[2];
+    const Matrix4 transformation = packPositionsInto(positions, packed);
+    CORRADE_COMPARE(transformation, Matrix4::translation({1.0f, 2.0f, 3.0f}));
+    CORRADE_COMPARE(packed[0], Math::Vector3<UnsignedShort>{});
+    CORRADE_COMPARE(packed[1], Math::Vector3<UnsignedShort>{});
+}
+
+void PackTest::positionsEmpty() {
+    CORRADE_COMPARE(packPositionsInto(nullptr, nullptr), Matrix4{});
+}
+
+void PackTest::positionsWrongSize() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    const Vector3 positions[3];
+    Math::Vector3<UnsignedShort> packed[2];
+    packPositionsInto(positions, packed);
+    CORRADE_COMPARE(out.str(), "MeshTools::packPositionsInto(): expected 3 output items but got 2\n");
+}
+
+void PackTest::normals1010102() {
+    const Vector3 normals[]{
+        Vector3::xAxis(),
+        -Vector3::yAxis(),
+        Vector3::zAxis(),
+        /* Gets clamped */
+        {2.0f, -2.0f, 0.0f}
+    };
+    UnsignedInt packed[4];
+    packNormalsInto(normals, packed);
+    CORRADE_COMPARE(packed[0], 0x000001ff);
+    CORRADE_COMPARE(packed[1], 0x00080400);
+    CORRADE_COMPARE(packed[2], 0x1ff00000);
+    CORRADE_COMPARE(packed[3], 0x000805ff);
+
+    /* Sign-extending and unpacking each component gets the normal back */
+    Containers::Array<Vector3> sphere = sphereNormals();
+    Containers::Array<UnsignedInt> sphereSigned{Containers::NoInit, sphere.size()};
+    packNormalsInto(sphere, sphereSigned);
+    for(std::size_t i = 0; i != sphere.size(); ++i) {
+        const Vector3i components{
+            Int(sphereSigned[i] << 22) >> 22,
+            Int(sphereSigned[i] << 12) >> 22,
+            Int(sphereSigned[i] << 2) >> 22};
+        CORRADE_COMPARE(sphereSigned[i] >> 30, 0);
+        const Vector3 unpacked = Math::unpack<Vector3, 10>(components);
+        CORRADE_VERIFY(Math::abs(unpacked - sphere[i]).max() <= 1.0f/511.0f);
+    }
+}
+
+void PackTest::normalsByte() {
+    const Vector3 normals[]{
+        Vector3::xAxis(),
+        -Vector3::yAxis(),
+        Vector3{0.6f, 0.0f, 0.8f},
+        {2.0f, -2.0f, 0.0f}
+    };
+    Math::Vector4<Byte> packed[4];
+    packNormalsInto(normals, packed);
+    CORRADE_COMPARE(packed[0], (Math::Vector4<Byte>{127, 0, 0, 0}));
+    CORRADE_COMPARE(packed[1], (Math::Vector4<Byte>{0, -127, 0, 0}));
+    CORRADE_COMPARE(packed[2], (Math::Vector4<Byte>{76, 0, 102, 0}));
+    CORRADE_COMPARE(packed[3], (Math::Vector4<Byte>{127, -127, 0, 0}));
+}
+
+void PackTest::normalsOctahedral() {
+    const Vector3 normals[]{
+        Vector3::zAxis(),
+        -Vector3::zAxis(),
+        Vector3::xAxis(),
+        -Vector3::yAxis()
+    };
+    Math::Vector2<Short> packed[4];
+    packNormalsOctahedralInto(normals, packed);
+    CORRADE_COMPARE(packed[0], (Math::Vector2<Short>{0, 0}));
+    CORRADE_COMPARE(packed[1], (Math::Vector2<Short>{32767, 32767}));
+    CORRADE_COMPARE(packed[2], (Math::Vector2<Short>{32767, 0}));
+    CORRADE_COMPARE(packed[3], (Math::Vector2<Short>{0, -32767}));
+
+    /* Decoding with the routine from the docs gets the normals back with
+       a precision better than the 10.10.10.2 format */
+    Containers::Array<Vector3> sphere = sphereNormals();
+    Containers::Array<Math::Vector2<Short>> spherePacked{Containers::NoInit, sphere.size()};
+    packNormalsOctahedralInto(sphere, spherePacked);
+    for(std::size_t i = 0; i != sphere.size(); ++i) {
+        const Vector3 decoded = decodeOctahedral(spherePacked[i]);
+        CORRADE_VERIFY(Math::abs(decoded - sphere[i]).max() <= 1.0f/4096.0f);
+    }
+}
+
+void PackTest::normalsOctahedralZero() {
+    const Vector3 normals[]{Vector3{}};
+    Math::Vector2<Short> packed[]{{1, 1}};
+    packNormalsOctahedralInto(normals, packed);
+    CORRADE_COMPARE(packed[0], (Math::Vector2<Short>{0, 0}));
+    CORRADE_COMPARE(decodeOctahedral(packed[0]), Vector3::zAxis());
+}
+
+void PackTest::normalsWrongSize() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    const Vector3 normals[3];
+    UnsignedInt packed1010102[2];
+    Math::Vector4<Byte> packedByte[4];
+    Math::Vector2<Short> packedOctahedral[1];
+    packNormalsInto(normals, packed1010102);
+    packNormalsInto(normals, packedByte);
+    packNormalsOctahedralInto(normals, packedOctahedral);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::packNormalsInto(): expected 3 output items but got 2\n"
+        "MeshTools::packNormalsInto(): expected 3 output items but got 4\n"
+        "MeshTools::packNormalsOctahedralInto(): expected 3 output items but got 1\n");
+}
+
+void PackTest::textureCoordinatesHalf() {
+    const Vector2 textureCoordinates[]{
+        {0.0f, 1.0f},
+        {0.5f, -2.0f},
+        {3.25f, 0.125f}
+    };
+    Math::Vector2<UnsignedShort> packed[3];
+    packTextureCoordinatesInto(textureCoordinates, packed, PackedTextureCoordinateFormat::Half);
+
+    /* Values outside of [0, 1] are kept */
+    for(std::size_t i = 0; i != Containers::arraySize(textureCoordinates); ++i)
+        CORRADE_COMPARE(Math::unpackHalf(packed[i]), textureCoordinates[i]);
+}
+
+void PackTest::textureCoordinatesUnsignedShort() {
+    const Vector2 textureCoordinates[]{
+        {0.0f, 1.0f},
+        {0.5f, -2.0f},
+        {3.25f, 0.25f}
+    };
+    Math::Vector2<UnsignedShort> packed[3];
+    packTextureCoordinatesInto(textureCoordinates, packed, PackedTextureCoordinateFormat::UnsignedShortNormalized);
+
+    /* Values outside of [0, 1] are clamped */
+    CORRADE_COMPARE(packed[0], (Math::Vector2<UnsignedShort>{0, 65535}));
+    CORRADE_COMPARE(packed[1], (Math::Vector2<UnsignedShort>{32768, 0}));
+    CORRADE_COMPARE(packed[2], (Math::Vector2<UnsignedShort>{65535, 16384}));
+}
+
+void PackTest::textureCoordinatesWrongSize() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    const Vector2 textureCoordinates[3];
+    Math::Vector2<UnsignedShort> packed[4];
+    packTextureCoordinatesInto(textureCoordinates, packed, PackedTextureCoordinateFormat::Half);
+    CORRADE_COMPARE(out.str(), "MeshTools::packTextureCoordinatesInto(): expected 3 output items but got 4\n");
+}
+
+void PackTest::colors() {
+    const Color4 colors[]{
+        {1.0f, 0.0f, 0.5f, 1.0f},
+        /* Gets clamped */
+        {2.0f, -1.0f, 0.25f, 0.0f}
+    };
+    Color4ub packed[2];
+    packColorsInto(colors, packed);
+    CORRADE_COMPARE(packed[0], (Color4ub{255, 0, 128, 255}));
+    CORRADE_COMPARE(packed[1], (Color4ub{255, 0, 64, 0}));
+}
+
+void PackTest::colorsWrongSize() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    const Color4 colors[3];
+    Color4ub packed[2];
+    packColorsInto(colors, packed);
+    CORRADE_COMPARE(out.str(), "MeshTools::packColorsInto(): expected 3 output items but got 2\n");
+}
+
+#ifdef MAGNUM_TARGET_GL
+void PackTest::vertices() {
+    const Trade::MeshData3D data{MeshPrimitive::Triangles, {0, 1, 2},
+        {{{0.0f, 0.0f, 0.0f}, {2.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}}},
+        {{Vector3::zAxis(), Vector3::zAxis(), -Vector3::xAxis()}},
+        {{{0.0f, 0.0f}, {1.0f, 0.0f}, {0.0f, 0.5f}}},
+        {{0xff0000ff_rgbaf, 0x00ff00ff_rgbaf, 0x0000ff80_rgbaf}}};
+
+    PackedVertexData3D packed = packVertices(data, PackedNormalFormat::Byte, PackedTextureCoordinateFormat::UnsignedShortNormalized);
+    CORRADE_COMPARE(packed.stride, 20);
+    CORRADE_COMPARE(packed.data.size(), 3*20);
+    CORRADE_COMPARE(packed.positionTransformation, Matrix4::scaling(Vector3{2.0f}));
+
+    CORRADE_COMPARE(packed.attributes.size(), 4);
+    CORRADE_COMPARE(packed.attributes[0].first, 0);
+    CORRADE_COMPARE(packed.attributes[0].second.location(), Shaders::Generic3D::Position::Location);
+    CORRADE_VERIFY(packed.attributes[0].second.components() == GL::DynamicAttribute::Components::Three);
+    CORRADE_VERIFY(packed.attributes[0].second.dataType() == GL::DynamicAttribute::DataType::UnsignedShort);
+    CORRADE_COMPARE(packed.attributes[1].first, 8);
+    CORRADE_COMPARE(packed.attributes[1].second.location(), Shaders::Generic3D::Normal::Location);
+    CORRADE_VERIFY(packed.attributes[1].second.dataType() == GL::DynamicAttribute::DataType::Byte);
+    CORRADE_COMPARE(packed.attributes[2].first, 12);
+    CORRADE_COMPARE(packed.attributes[2].second.location(), Shaders::Generic3D::TextureCoordinates::Location);
+    CORRADE_VERIFY(packed.attributes[2].second.dataType() == GL::DynamicAttribute::DataType::UnsignedShort);
+    CORRADE_COMPARE(packed.attributes[3].first, 16);
+    CORRADE_COMPARE(packed.attributes[3].second.location(), Shaders::Generic3D::Color4::Location);
+    CORRADE_VERIFY(packed.attributes[3].second.dataType() == GL::DynamicAttribute::DataType::UnsignedByte);
+
+    /* Second vertex, with zero padding after the position */
+    const char* const vertex = packed.data + 20;
+    Math::Vector3<UnsignedShort> position;
+    Math::Vector4<Byte> normal;
+    Math::Vector2<UnsignedShort> textureCoordinates;
+    Color4ub color;
+    UnsignedShort padding;
+    std::memcpy(&position, vertex + 0, sizeof(position));
+    std::memcpy(&padding, vertex + 6, sizeof(padding));
+    std::memcpy(&normal, vertex + 8, sizeof(normal));
+    std::memcpy(&textureCoordinates, vertex + 12, sizeof(textureCoordinates));
+    std::memcpy(&color, vertex + 16, sizeof(color));
+    CORRADE_COMPARE(position, (Math::Vector3<UnsignedShort>{65535, 0, 0}));
+    CORRADE_COMPARE(padding, 0);
+    CORRADE_COMPARE(normal, (Math::Vector4<Byte>{0, 0, 127, 0}));
+    CORRADE_COMPARE(textureCoordinates, (Math::Vector2<UnsignedShort>{65535, 0}));
+    CORRADE_COMPARE(color, (Color4ub{0, 255, 0, 255}));
+}
+
+void PackTest::verticesPositionsOnly() {
+    const Trade::MeshData3D data{MeshPrimitive::Points, {},
+        {{{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 4.0f}}}, {}, {}, {}};
+
+    PackedVertexData3D packed = packVertices(data);
+    CORRADE_COMPARE(packed.stride, 8);
+    CORRADE_COMPARE(packed.data.size(), 2*8);
+    CORRADE_COMPARE(packed.attributes.size(), 1);
+    CORRADE_COMPARE(packed.positionTransformation, Matrix4::scaling(Vector3{4.0f}));
+
+    Math::Vector3<UnsignedShort> position;
+    std::memcpy(&position, packed.data + 8, sizeof(position));
+    CORRADE_COMPARE(position, (Math::Vector3<UnsignedShort>{0, 0, 65535}));
+}
+
+void PackTest::verticesOctahedral() {
+    const Trade::MeshData3D data{MeshPrimitive::Points, {},
+        {{{0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}}},
+        {{Vector3::zAxis(), -Vector3::yAxis()}}, {}, {}};
+
+    PackedVertexData3D packed = packVertices(data, PackedNormalFormat::Octahedral);
+    CORRADE_COMPARE(packed.stride, 12);
+    CORRADE_COMPARE(packed.attributes.size(), 2);
+    CORRADE_COMPARE(packed.attributes[1].first, 8);
+    CORRADE_VERIFY(packed.attributes[1].second.components() == GL::DynamicAttribute::Components::Two);
+    CORRADE_VERIFY(packed.attributes[1].second.dataType() == GL::DynamicAttribute::DataType::Short);
+
+    Math::Vector2<Short> normal;
+    std::memcpy(&normal, packed.data + 12 + 8, sizeof(normal));
+    CORRADE_COMPARE(normal, (Math::Vector2<Short>{0, -32767}));
+}
+#endif
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::PackTest)
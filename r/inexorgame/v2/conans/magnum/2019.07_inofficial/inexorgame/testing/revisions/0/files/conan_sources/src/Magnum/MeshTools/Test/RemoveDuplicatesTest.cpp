@@ -0,0 +1,315 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/ArrayViewStl.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Vector2.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/RemoveDuplicates.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+struct RemoveDuplicatesTest: TestSuite::Tester {
+    explicit RemoveDuplicatesTest();
+
+    void inPlace();
+    void inPlaceEmpty();
+    void inPlaceBytes();
+    void inPlaceLarge();
+    void inPlaceIntoWrongIndexCount();
+    void inPlaceIntoNonContiguous();
+
+    void fuzzyInPlace();
+    void fuzzyInPlaceEmpty();
+    void fuzzyInPlaceCellBoundary();
+    void fuzzyInPlaceStrided();
+    void fuzzyInPlaceMatchesRemoveDuplicates();
+    void fuzzyInPlaceLargeRange();
+    void fuzzyInPlaceIntoWrongIndexCount();
+    void fuzzyInPlaceInvalidEpsilon();
+};
+
+RemoveDuplicatesTest::RemoveDuplicatesTest() {
+    addTests({&RemoveDuplicatesTest::inPlace,
+              &RemoveDuplicatesTest::inPlaceEmpty,
+              &RemoveDuplicatesTest::inPlaceBytes,
+              &RemoveDuplicatesTest::inPlaceLarge,
+              &RemoveDuplicatesTest::inPlaceIntoWrongIndexCount,
+              &RemoveDuplicatesTest::inPlaceIntoNonContiguous,
+
+              &RemoveDuplicatesTest::fuzzyInPlace,
+              &RemoveDuplicatesTest::fuzzyInPlaceEmpty,
+              &RemoveDuplicatesTest::fuzzyInPlaceCellBoundary,
+              &RemoveDuplicatesTest::fuzzyInPlaceStrided,
+              &RemoveDuplicatesTest::fuzzyInPlaceMatchesRemoveDuplicates,
+              &RemoveDuplicatesTest::fuzzyInPlaceLargeRange,
+              &RemoveDuplicatesTest::fuzzyInPlaceIntoWrongIndexCount,
+              &RemoveDuplicatesTest::fuzzyInPlaceInvalidEpsilon});
+}
+
+void RemoveDuplicatesTest::inPlace() {
+    Math::Vector3<UnsignedByte> data[]{
+        {1, 2, 3},
+        {4, 5, 6},
+        {1, 2, 3},
+        {1, 2, 4}, /* Differs only in the last byte */
+        {4, 5, 6}
+    };
+
+    std::pair<Containers::Array<UnsignedInt>, std::size_t> out = removeDuplicatesInPlace(Containers::stridedArrayView(data));
+
+    const UnsignedInt expectedIndices[]{0, 1, 0, 2, 1};
+    const Math::Vector3<UnsignedByte> expectedData[]{
+        {1, 2, 3},
+        {4, 5, 6},
+        {1, 2, 4}
+    };
+    CORRADE_COMPARE_AS(out.first, Containers::arrayView(expectedIndices),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(Containers::arrayView(data).prefix(out.second), Containers::arrayView(expectedData),
+        TestSuite::Compare::Container);
+}
+
+void RemoveDuplicatesTest::inPlaceEmpty() {
+    std::pair<Containers::Array<UnsignedInt>, std::size_t> out = removeDuplicatesInPlace(Containers::StridedArrayView1D<Vector3>{});
+    CORRADE_VERIFY(out.first.empty());
+    CORRADE_COMPARE(out.second, 0);
+}
+
+void RemoveDuplicatesTest::inPlaceBytes() {
+    /* Comparing just the first three bytes of each four-byte vertex, the
+       last byte is ignored and not moved */
+    UnsignedByte vertices[][4]{
+        {1, 2, 3, 10},
+        {1, 2, 3, 11},
+        {4, 5, 6, 12},
+        {4, 5, 6, 13},
+        {7, 8, 9, 14}
+    };
+
+    UnsignedInt indices[5];
+    Containers::StridedArrayView2D<char> data{
+        Containers::arrayView(reinterpret_cast<char*>(vertices), sizeof(vertices)),
+        {5, 3}, {4, 1}};
+    CORRADE_COMPARE(removeDuplicatesInPlaceInto(data, Containers::stridedArrayView(indices)), 3);
+
+    const UnsignedInt expectedIndices[]{0, 0, 1, 1, 2};
+    const UnsignedByte expectedData[][4]{
+        {1, 2, 3, 10},
+        {4, 5, 6, 11},
+        {7, 8, 9, 12},
+        {4, 5, 6, 13},
+        {7, 8, 9, 14}
+    };
+    CORRADE_COMPARE_AS(Containers::arrayView(indices), Containers::arrayView(expectedIndices),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(Containers::arrayView(&vertices[0][0], 20), Containers::arrayView(&expectedData[0][0], 20),
+        TestSuite::Compare::Container);
+}
+
+void RemoveDuplicatesTest::inPlaceLarge() {
+    /* Enough data to make the table grow beyond its initial size, with each
+       value repeated three times in a row */
+    std::vector<UnsignedInt> data, expectedIndices, expectedData;
+    for(UnsignedInt i = 0; i != 3000; ++i) {
+        data.push_back(i/3*7919);
+        expectedIndices.push_back(i/3);
+    }
+    for(UnsignedInt i = 0; i != 1000; ++i) expectedData.push_back(i*7919);
+
+    std::pair<Containers::Array<UnsignedInt>, std::size_t> out = removeDuplicatesInPlace(Containers::stridedArrayView(data));
+    CORRADE_COMPARE(out.second, 1000);
+    CORRADE_COMPARE_AS(Containers::arrayView(out.first), Containers::arrayView(expectedIndices),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(Containers::arrayView(data).prefix(out.second), Containers::arrayView(expectedData),
+        TestSuite::Compare::Container);
+}
+
+void RemoveDuplicatesTest::inPlaceIntoWrongIndexCount() {
+    Vector2 data[3]{};
+    UnsignedInt indices[2];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    removeDuplicatesInPlaceInto(Containers::stridedArrayView(data), Containers::stridedArrayView(indices));
+    CORRADE_COMPARE(out.str(), "MeshTools::removeDuplicatesInPlaceInto(): output index array has 2 elements but expected 3\n");
+}
+
+void RemoveDuplicatesTest::inPlaceIntoNonContiguous() {
+    char data[12]{};
+    UnsignedInt indices[3];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    removeDuplicatesInPlaceInto(Containers::StridedArrayView2D<char>{data, {3, 2}, {4, 2}}, Containers::stridedArrayView(indices));
+    CORRADE_COMPARE(out.str(), "MeshTools::removeDuplicatesInPlaceInto(): second data view dimension is not contiguous\n");
+}
+
+void RemoveDuplicatesTest::fuzzyInPlace() {
+    Vector2 data[]{
+        {1.0f, 2.0f},
+        {5.0f, 1.0f},
+        {1.05f, 2.02f}, /* Duplicate of the first */
+        {5.0f, 1.0f},   /* Exact duplicate of the second */
+        {1.0f, 2.15f}   /* Too far from the first in the second component */
+    };
+
+    std::pair<Containers::Array<UnsignedInt>, std::size_t> out = removeDuplicatesFuzzyInPlace(Containers::stridedArrayView(data), 0.1f);
+
+    const UnsignedInt expectedIndices[]{0, 1, 0, 1, 2};
+    const Vector2 expectedData[]{
+        {1.0f, 2.0f},
+        {5.0f, 1.0f},
+        {1.0f, 2.15f}
+    };
+    CORRADE_COMPARE_AS(out.first, Containers::arrayView(expectedIndices),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(Containers::arrayView(data).prefix(out.second), Containers::arrayView(expectedData),
+        TestSuite::Compare::Container);
+}
+
+void RemoveDuplicatesTest::fuzzyInPlaceEmpty() {
+    std::pair<Containers::Array<UnsignedInt>, std::size_t> out = removeDuplicatesFuzzyInPlace(Containers::StridedArrayView1D<Vector2>{});
+    CORRADE_VERIFY(out.first.empty());
+    CORRADE_COMPARE(out.second, 0);
+}
+
+void RemoveDuplicatesTest::fuzzyInPlaceCellBoundary() {
+    /* With the minimum at zero there's a grid cell boundary at 2.0, the
+       second and third vector are in neighboring cells but still nearer than
+       epsilon. The last one is in a cell neighboring the third, but that one
+       isn't unique so it's not considered. */
+    Vector2 data[]{
+        {0.0f, 0.0f},
+        {1.99f, 0.0f},
+        {2.01f, 0.0f},
+        {3.5f, 0.0f}
+    };
+
+    UnsignedInt indices[4];
+    CORRADE_COMPARE(removeDuplicatesFuzzyInPlaceInto(Containers::stridedArrayView(data), Containers::stridedArrayView(indices), 1.0f), 3);
+
+    const UnsignedInt expected[]{0, 1, 1, 2};
+    CORRADE_COMPARE_AS(Containers::arrayView(indices), Containers::arrayView(expected),
+        TestSuite::Compare::Container);
+}
+
+void RemoveDuplicatesTest::fuzzyInPlaceStrided() {
+    struct Vertex {
+        Vector3 position;
+        UnsignedInt id;
+    } vertices[]{
+        {{0.0f, 0.0f, 0.0f}, 0},
+        {{1.0f, 0.0f, 0.0f}, 1},
+        {{0.0f, 0.0f, 0.000001f}, 2},
+        {{1.0f, 0.0f, 0.0f}, 3}
+    };
+
+    /* Only the positions get moved, the other attribute stays untouched */
+    Containers::StridedArrayView1D<Vector3> positions{vertices, &vertices[0].position, 4, sizeof(Vertex)};
+    std::pair<Containers::Array<UnsignedInt>, std::size_t> out = removeDuplicatesFuzzyInPlace(positions, 0.001f);
+    CORRADE_COMPARE(out.second, 2);
+
+    const UnsignedInt expected[]{0, 1, 0, 1};
+    CORRADE_COMPARE_AS(out.first, Containers::arrayView(expected),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(vertices[1].position, (Vector3{1.0f, 0.0f, 0.0f}));
+    CORRADE_COMPARE(vertices[2].id, 2);
+    CORRADE_COMPARE(vertices[3].id, 3);
+}
+
+void RemoveDuplicatesTest::fuzzyInPlaceMatchesRemoveDuplicates() {
+    /* Clusters of slightly jittered copies of points on a grid. The clusters
+       are far enough from each other for both the bucketing in
+       removeDuplicates() and the neighbor lookup here to agree. */
+    std::vector<Vector3> data;
+    for(Int z = 0; z != 5; ++z)
+        for(Int y = 0; y != 5; ++y)
+            for(Int x = 0; x != 5; ++x)
+                for(Int i = 0; i != 3; ++i)
+                    data.push_back(Vector3{Vector3i{x, y, z}} + Vector3{Float(i - 1)*0.01f});
+
+    std::vector<Vector3> original = data;
+    std::vector<Vector3> expected = data;
+    const std::vector<UnsignedInt> expectedIndices = removeDuplicates(expected, 0.1f);
+
+    std::pair<Containers::Array<UnsignedInt>, std::size_t> out = removeDuplicatesFuzzyInPlace(Containers::stridedArrayView(data), 0.1f);
+    CORRADE_COMPARE(out.second, expected.size());
+    CORRADE_COMPARE(out.second, 125);
+
+    /* Each original vector maps to an unique one nearer than epsilon, and
+       copies of the same point all map to the same one */
+    for(std::size_t i = 0; i != original.size(); ++i) {
+        CORRADE_VERIFY((Math::abs(data[out.first[i]] - original[i]) < Vector3{0.1f}).all());
+        CORRADE_COMPARE(out.first[i], out.first[i - i%3]);
+        CORRADE_COMPARE(out.first[i] == out.first[0], expectedIndices[i] == expectedIndices[0]);
+    }
+}
+
+void RemoveDuplicatesTest::fuzzyInPlaceLargeRange() {
+    /* The range divided by epsilon doesn't fit into 32 bits, so epsilon gets
+       enlarged. Nearby values get merged, the extremes stay separate. */
+    Vector2 data[]{
+        {-1.0e9f, 0.0f},
+        {1.0e9f, 0.0f},
+        {0.0f, 0.0f},
+        {0.0f, 0.1f}
+    };
+
+    std::pair<Containers::Array<UnsignedInt>, std::size_t> out = removeDuplicatesFuzzyInPlace(Containers::stridedArrayView(data), 1.0e-6f);
+    CORRADE_COMPARE(out.second, 3);
+
+    const UnsignedInt expected[]{0, 1, 2, 2};
+    CORRADE_COMPARE_AS(out.first, Containers::arrayView(expected),
+        TestSuite::Compare::Container);
+}
+
+void RemoveDuplicatesTest::fuzzyInPlaceIntoWrongIndexCount() {
+    Vector2 data[3]{};
+    UnsignedInt indices[2];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    removeDuplicatesFuzzyInPlaceInto(Containers::stridedArrayView(data), Containers::stridedArrayView(indices));
+    CORRADE_COMPARE(out.str(), "MeshTools::removeDuplicatesFuzzyInPlaceInto(): output index array has 2 elements but expected 3\n");
+}
+
+void RemoveDuplicatesTest::fuzzyInPlaceInvalidEpsilon() {
+    Vector2 data[3]{};
+    UnsignedInt indices[3];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    removeDuplicatesFuzzyInPlaceInto(Containers::stridedArrayView(data), Containers::stridedArrayView(indices), 0.0f);
+    CORRADE_COMPARE(out.str(), "MeshTools::removeDuplicatesFuzzyInPlaceInto(): epsilon is expected to be positive but got 0\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::RemoveDuplicatesTest)
@@ -0,0 +1,362 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <vector>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/ArrayViewStl.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/Simplify.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+struct SimplifyTest: TestSuite::Tester {
+    explicit SimplifyTest();
+
+    void flat();
+    void targetIndexCount();
+    void alreadySmallEnough();
+    void targetError();
+    void attributes();
+    void borderLocked();
+    void seamLocked();
+    void empty();
+
+    void wrongIndexCount();
+    void outputTooSmall();
+    void wrongAttributeSize();
+    void indexOutOfBounds();
+
+    void lods();
+    void lodsNone();
+    void lodsInvalidRatio();
+};
+
+SimplifyTest::SimplifyTest() {
+    addTests({&SimplifyTest::flat,
+              &SimplifyTest::targetIndexCount,
+              &SimplifyTest::alreadySmallEnough,
+              &SimplifyTest::targetError,
+              &SimplifyTest::attributes,
+              &SimplifyTest::borderLocked,
+              &SimplifyTest::seamLocked,
+              &SimplifyTest::empty,
+
+              &SimplifyTest::wrongIndexCount,
+              &SimplifyTest::outputTooSmall,
+              &SimplifyTest::wrongAttributeSize,
+              &SimplifyTest::indexOutOfBounds,
+
+              &SimplifyTest::lods,
+              &SimplifyTest::lodsNone,
+              &SimplifyTest::lodsInvalidRatio});
+}
+
+/* A size x size quad grid in the XY plane, optionally displaced along Z */
+struct Grid {
+    explicit Grid(const std::size_t size, const Float bumpiness = 0.0f) {
+        for(std::size_t y = 0; y <= size; ++y)
+            for(std::size_t x = 0; x <= size; ++x)
+                positions.emplace_back(Float(x), Float(y), bumpiness*Math::sin(Rad(x*0.7f))*Math::cos(Rad(y*0.5f)));
+
+        for(std::size_t y = 0; y != size; ++y) {
+            for(std::size_t x = 0; x != size; ++x) {
+                const UnsignedInt a = y*(size + 1) + x;
+                const UnsignedInt b = a + 1;
+                const UnsignedInt c = a + size + 1;
+                const UnsignedInt d = c + 1;
+                indices.insert(indices.end(), {a, b, d, a, d, c});
+            }
+        }
+    }
+
+    std::vector<Vector3> positions;
+    std::vector<UnsignedInt> indices;
+};
+
+/* Sum of triangle areas projected to the XY plane, negative for triangles
+   that got flipped */
+Float projectedArea(const Containers::ArrayView<const UnsignedInt> indices, const std::vector<Vector3>& positions) {
+    Float area = 0.0f;
+    for(std::size_t i = 0; i != indices.size(); i += 3) {
+        const Vector3 a = positions[indices[i + 0]];
+        const Vector3 b = positions[indices[i + 1]];
+        const Vector3 c = positions[indices[i + 2]];
+        area += Math::cross(b - a, c - a).z()*0.5f;
+    }
+    return area;
+}
+
+void SimplifyTest::flat() {
+    const Grid grid{10};
+
+    Float error = -1.0f;
+    Containers::Array<UnsignedInt> out = simplify(grid.indices, grid.positions, 0, 0.01f, &error);
+
+    /* All inner vertices can be collapsed with no error, the border is
+       locked, so there's at least a fan for each border vertex left */
+    CORRADE_VERIFY(out.size() < grid.indices.size()/4);
+    CORRADE_COMPARE(out.size() % 3, 0);
+    CORRADE_COMPARE(error, 0.0f);
+
+    /* The result covers exactly the original area with nothing flipped */
+    CORRADE_COMPARE(projectedArea(out, grid.positions), 100.0f);
+    for(std::size_t i = 0; i != out.size(); i += 3) {
+        const Vector3 a = grid.positions[out[i + 0]];
+        const Vector3 b = grid.positions[out[i + 1]];
+        const Vector3 c = grid.positions[out[i + 2]];
+        CORRADE_VERIFY(Math::cross(b - a, c - a).z() > 0.0f);
+    }
+}
+
+void SimplifyTest::targetIndexCount() {
+    const Grid grid{10};
+
+    Containers::Array<UnsignedInt> out = simplify(grid.indices, grid.positions, 300, 1.0f);
+
+    /* Each collapse removes two triangles, so the count can't get exactly to
+       the target, but it shouldn't go further than needed either */
+    CORRADE_VERIFY(out.size() <= 300);
+    CORRADE_VERIFY(out.size() >= 300 - 2*3);
+    CORRADE_COMPARE(projectedArea(out, grid.positions), 100.0f);
+}
+
+void SimplifyTest::alreadySmallEnough() {
+    const Grid grid{4};
+
+    Float error = -1.0f;
+    Containers::Array<UnsignedInt> out = simplify(grid.indices, grid.positions, grid.indices.size(), 1.0f, &error);
+    CORRADE_COMPARE_AS(Containers::arrayView(out),
+        Containers::arrayView<const UnsignedInt>(grid.indices),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(error, 0.0f);
+}
+
+void SimplifyTest::targetError() {
+    const Grid grid{20, 2.0f};
+
+    /* With zero allowed error nothing can be collapsed on a curved surface */
+    Float errorNone = -1.0f;
+    Containers::Array<UnsignedInt> none = simplify(grid.indices, grid.positions, 0, 0.0f, &errorNone);
+    CORRADE_COMPARE(none.size(), grid.indices.size());
+    CORRADE_COMPARE(errorNone, 0.0f);
+
+    /* A larger error allows more collapses, and the result error stays
+       within the limit */
+    Float errorSmall = -1.0f;
+    Containers::Array<UnsignedInt> small = simplify(grid.indices, grid.positions, 0, 0.01f, &errorSmall);
+    Float errorLarge = -1.0f;
+    Containers::Array<UnsignedInt> large = simplify(grid.indices, grid.positions, 0, 0.1f, &errorLarge);
+    CORRADE_VERIFY(small.size() < grid.indices.size());
+    CORRADE_VERIFY(large.size() < small.size());
+    CORRADE_VERIFY(errorSmall > 0.0f);
+    CORRADE_VERIFY(errorSmall <= 0.01f);
+    CORRADE_VERIFY(errorLarge > errorSmall);
+    CORRADE_VERIFY(errorLarge <= 0.1f);
+}
+
+void SimplifyTest::attributes() {
+    const Grid grid{10};
+
+    /* A material-ID-like attribute that's different in each quadrant of the
+       grid, so only collapses inside a quadrant don't change it */
+    std::vector<Float> attributes;
+    for(const Vector3& position: grid.positions) {
+        attributes.push_back(position.x() < 5.0f ? 0.0f : 1.0f);
+        attributes.push_back(position.y() < 5.0f ? 0.0f : 1.0f);
+    }
+    const Containers::StridedArrayView2D<const Float> attributeView{
+        Containers::arrayView(attributes), {grid.positions.size(), 2},
+        {2*sizeof(Float), sizeof(Float)}};
+
+    /* A zero weight makes the attributes not matter at all */
+    const Float zeroWeights[]{0.0f, 0.0f};
+    Containers::Array<UnsignedInt> positionsOnly = simplify(grid.indices, grid.positions, 0, 0.01f);
+    Containers::Array<UnsignedInt> zeroWeighted = simplify(grid.indices, grid.positions, attributeView, zeroWeights, 0, 0.01f);
+    CORRADE_COMPARE_AS(Containers::arrayView(zeroWeighted),
+        Containers::arrayView(positionsOnly),
+        TestSuite::Compare::Container);
+
+    /* A nonzero weight prevents collapses that change the attribute */
+    const Float weights[]{1.0f, 1.0f};
+    Float error = -1.0f;
+    Containers::Array<UnsignedInt> weighted = simplify(grid.indices, grid.positions, attributeView, weights, 0, 0.01f, &error);
+    CORRADE_VERIFY(weighted.size() > positionsOnly.size());
+    CORRADE_VERIFY(weighted.size() < grid.indices.size());
+    CORRADE_VERIFY(error <= 0.01f);
+    CORRADE_COMPARE(projectedArea(weighted, grid.positions), 100.0f);
+}
+
+void SimplifyTest::borderLocked() {
+    /* A single row of quads has all vertices on the border, nothing can be
+       collapsed */
+    std::vector<Vector3> positions{
+        {0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {2.0f, 0.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f}, {1.0f, 1.0f, 0.0f}, {2.0f, 1.0f, 0.0f}
+    };
+    const UnsignedInt indices[]{
+        0, 1, 4, 0, 4, 3,
+        1, 2, 5, 1, 5, 4
+    };
+
+    Containers::Array<UnsignedInt> out = simplify(indices, positions, 0, 1.0f);
+    CORRADE_COMPARE_AS(Containers::arrayView(out),
+        Containers::arrayView(indices),
+        TestSuite::Compare::Container);
+}
+
+void SimplifyTest::seamLocked() {
+    /* Grid with the middle vertex split into two sharing the same position,
+       as if there was a texture seam going through it. The other inner
+       vertices still get collapsed but the seam vertices stay. */
+    Grid grid{4};
+    const UnsignedInt middle = 2*5 + 2;
+    const UnsignedInt split = grid.positions.size();
+    grid.positions.push_back(grid.positions[middle]);
+    for(std::size_t i = grid.indices.size()/2; i != grid.indices.size(); ++i)
+        if(grid.indices[i] == middle) grid.indices[i] = split;
+
+    Containers::Array<UnsignedInt> out = simplify(grid.indices, grid.positions, 0, 0.01f);
+    CORRADE_VERIFY(out.size() < grid.indices.size());
+    CORRADE_COMPARE(projectedArea(out, grid.positions), 16.0f);
+
+    bool hasMiddle = false, hasSplit = false;
+    for(const UnsignedInt i: out) {
+        if(i == middle) hasMiddle = true;
+        if(i == split) hasSplit = true;
+    }
+    CORRADE_VERIFY(hasMiddle);
+    CORRADE_VERIFY(hasSplit);
+}
+
+void SimplifyTest::empty() {
+    Float error = -1.0f;
+    Containers::Array<UnsignedInt> out = simplify(nullptr, nullptr, 0, 1.0f, &error);
+    CORRADE_COMPARE(out.size(), 0);
+    CORRADE_COMPARE(error, 0.0f);
+}
+
+void SimplifyTest::wrongIndexCount() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    const Vector3 positions[3];
+    const UnsignedInt indices[4]{};
+    simplify(indices, positions, 0, 1.0f);
+    CORRADE_COMPARE(out.str(), "MeshTools::simplifyInto(): index count not divisible by 3\n");
+}
+
+void SimplifyTest::outputTooSmall() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    const Vector3 positions[3];
+    const UnsignedInt indices[6]{};
+    UnsignedInt output[5];
+    simplifyInto(indices, positions, 0, 1.0f, output);
+    CORRADE_COMPARE(out.str(), "MeshTools::simplifyInto(): output array too small, expected at least 6 but got 5\n");
+}
+
+void SimplifyTest::wrongAttributeSize() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    const Vector3 positions[3];
+    const UnsignedInt indices[3]{};
+    const Float attributes[8]{};
+    const Float weights[2]{};
+    simplify(indices, positions, Containers::StridedArrayView2D<const Float>{attributes, {4, 2}, {8, 4}}, weights, 0, 1.0f);
+    simplify(indices, positions, Containers::StridedArrayView2D<const Float>{attributes, {3, 2}, {8, 4}}, Containers::arrayView(weights).prefix(1), 0, 1.0f);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::simplifyInto(): expected attributes for 3 vertices and 2 components but got 4 vertices and 2 components\n"
+        "MeshTools::simplifyInto(): expected attributes for 3 vertices and 1 components but got 3 vertices and 2 components\n");
+}
+
+void SimplifyTest::indexOutOfBounds() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    const Vector3 positions[3];
+    const UnsignedInt indices[]{0, 1, 2, 2, 3, 1};
+    simplify(indices, positions, 0, 1.0f);
+    CORRADE_COMPARE(out.str(), "MeshTools::simplifyInto(): index 3 out of bounds for 3 elements\n");
+}
+
+void SimplifyTest::lods() {
+    const Grid grid{20, 2.0f};
+
+    /* With a large enough error each next level has at most half the
+       triangles of the previous */
+    std::vector<Containers::Array<UnsignedInt>> lods = generateLods(grid.indices, grid.positions, 3, 0.5f, 1.0f);
+    CORRADE_COMPARE(lods.size(), 3);
+    CORRADE_COMPARE_AS(Containers::arrayView(lods[0]),
+        Containers::arrayView<const UnsignedInt>(grid.indices),
+        TestSuite::Compare::Container);
+    for(std::size_t i = 1; i != lods.size(); ++i) {
+        CORRADE_COMPARE(lods[i].size() % 3, 0);
+        CORRADE_VERIFY(lods[i].size() <= lods[i - 1].size()/3/2*3);
+        for(const UnsignedInt index: lods[i])
+            CORRADE_VERIFY(index < grid.positions.size());
+    }
+
+    /* With a small error the levels get limited by it, but are still getting
+       smaller */
+    std::vector<Containers::Array<UnsignedInt>> limited = generateLods(grid.indices, grid.positions, 8, 0.5f, 0.05f);
+    CORRADE_VERIFY(limited.size() > 1);
+    CORRADE_VERIFY(limited.size() < 8);
+    for(std::size_t i = 1; i != limited.size(); ++i)
+        CORRADE_VERIFY(limited[i].size() < limited[i - 1].size());
+
+    /* With zero error the chain stops right after the original */
+    std::vector<Containers::Array<UnsignedInt>> exact = generateLods(grid.indices, grid.positions, 4, 0.5f, 0.0f);
+    CORRADE_COMPARE(exact.size(), 1);
+}
+
+void SimplifyTest::lodsNone() {
+    const Grid grid{4};
+    CORRADE_COMPARE(generateLods(grid.indices, grid.positions, 0).size(), 0);
+}
+
+void SimplifyTest::lodsInvalidRatio() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    const Grid grid{4};
+    generateLods(grid.indices, grid.positions, 3, 0.0f);
+    generateLods(grid.indices, grid.positions, 3, 1.0f);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::generateLods(): expected triangle ratio between 0 and 1 but got 0\n"
+        "MeshTools::generateLods(): expected triangle ratio between 0 and 1 but got 1\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::SimplifyTest)
@@ -0,0 +1,146 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <array>
+#include <random>
+#include <vector>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/MeshTools/OptimizeVertexCache.h"
+#include "Magnum/MeshTools/Tipsify.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+struct TipsifyBenchmark: TestSuite::Tester {
+    explicit TipsifyBenchmark();
+
+    void vector();
+    void view();
+    void viewScratch();
+    void viewScratchUnsignedShort();
+    void optimizeVertexCache();
+};
+
+enum: UnsignedInt {
+    GridSize = 128,
+    VertexCount = (GridSize + 1)*(GridSize + 1),
+    CacheSize = 24
+};
+
+TipsifyBenchmark::TipsifyBenchmark() {
+    addBenchmarks({&TipsifyBenchmark::vector,
+                   &TipsifyBenchmark::view,
+                   &TipsifyBenchmark::viewScratch,
+                   &TipsifyBenchmark::viewScratchUnsignedShort,
+                   &TipsifyBenchmark::optimizeVertexCache}, 10);
+}
+
+/* A grid of quads split into triangles, in a shuffled order so there's
+   something to optimize */
+template<class T> std::vector<T> shuffledGrid() {
+    std::vector<std::array<T, 3>> triangles;
+    for(UnsignedInt y = 0; y != GridSize; ++y) for(UnsignedInt x = 0; x != GridSize; ++x) {
+        const T a = y*(GridSize + 1) + x, b = a + 1, c = a + GridSize + 1, d = c + 1;
+        triangles.push_back({{a, b, d}});
+        triangles.push_back({{a, d, c}});
+    }
+    std::shuffle(triangles.begin(), triangles.end(), std::minstd_rand{});
+
+    std::vector<T> indices;
+    for(const std::array<T, 3>& t: triangles)
+        indices.insert(indices.end(), t.begin(), t.end());
+    return indices;
+}
+
+void TipsifyBenchmark::vector() {
+    const std::vector<UnsignedInt> original = shuffledGrid<UnsignedInt>();
+    std::vector<UnsignedInt> indices;
+
+    CORRADE_BENCHMARK(1) {
+        indices = original;
+        tipsify(indices, VertexCount, CacheSize);
+    }
+
+    CORRADE_VERIFY(analyzeVertexCache(Containers::arrayView(indices.data(), indices.size()), VertexCount, CacheSize).acmr < 0.8f);
+}
+
+void TipsifyBenchmark::view() {
+    const std::vector<UnsignedInt> original = shuffledGrid<UnsignedInt>();
+    std::vector<UnsignedInt> indices;
+
+    /* Allocating the scratch memory on every call */
+    CORRADE_BENCHMARK(1) {
+        indices = original;
+        tipsify(Containers::arrayView(indices.data(), indices.size()), VertexCount, CacheSize);
+    }
+
+    CORRADE_VERIFY(analyzeVertexCache(Containers::arrayView(indices.data(), indices.size()), VertexCount, CacheSize).acmr < 0.8f);
+}
+
+void TipsifyBenchmark::viewScratch() {
+    const std::vector<UnsignedInt> original = shuffledGrid<UnsignedInt>();
+    std::vector<UnsignedInt> indices;
+    Containers::Array<UnsignedInt> scratch{Containers::NoInit, tipsifyScratchSize(original.size(), VertexCount)};
+
+    /* Reusing the same scratch memory, no allocations */
+    CORRADE_BENCHMARK(1) {
+        indices = original;
+        tipsify(Containers::arrayView(indices.data(), indices.size()), VertexCount, CacheSize, scratch);
+    }
+
+    CORRADE_VERIFY(analyzeVertexCache(Containers::arrayView(indices.data(), indices.size()), VertexCount, CacheSize).acmr < 0.8f);
+}
+
+void TipsifyBenchmark::viewScratchUnsignedShort() {
+    const std::vector<UnsignedShort> original = shuffledGrid<UnsignedShort>();
+    std::vector<UnsignedShort> indices;
+    Containers::Array<UnsignedInt> scratch{Containers::NoInit, tipsifyScratchSize(original.size(), VertexCount)};
+
+    CORRADE_BENCHMARK(1) {
+        indices = original;
+        tipsify(Containers::arrayView(indices.data(), indices.size()), VertexCount, CacheSize, scratch);
+    }
+
+    CORRADE_VERIFY(analyzeVertexCache(Containers::arrayView(indices.data(), indices.size()), VertexCount, CacheSize).acmr < 0.8f);
+}
+
+void TipsifyBenchmark::optimizeVertexCache() {
+    const std::vector<UnsignedInt> original = shuffledGrid<UnsignedInt>();
+    std::vector<UnsignedInt> indices;
+
+    /* For comparison with the score-based optimizer */
+    CORRADE_BENCHMARK(1) {
+        indices = original;
+        optimizeVertexCacheInPlace(Containers::arrayView(indices.data(), indices.size()), VertexCount);
+    }
+
+    CORRADE_VERIFY(analyzeVertexCache(Containers::arrayView(indices.data(), indices.size()), VertexCount, CacheSize).acmr < 0.8f);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::TipsifyBenchmark)
@@ -0,0 +1,165 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <vector>
+#include <Corrade/Containers/ArrayViewStl.h>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/MeshTools/Transform.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+using namespace Math::Literals;
+
+struct TransformBenchmark: TestSuite::Tester {
+    explicit TransformBenchmark();
+
+    void pointsScalar();
+    void pointsBatched();
+    void pointsProjectiveScalar();
+    void pointsProjectiveBatched();
+    void vectorsQuaternionScalar();
+    void vectorsQuaternionBatched();
+};
+
+enum: std::size_t { VertexCount = 65536 };
+
+/* Positions alone, so the batched variant can use the register
+   transposition, and interleaved with a normal and texture coordinates,
+   where it has to gather the data */
+const struct {
+    const char* name;
+    std::size_t stride;
+} LayoutData[]{
+    {"packed", 1},
+    {"interleaved", 3}
+};
+
+TransformBenchmark::TransformBenchmark() {
+    addInstancedBenchmarks({&TransformBenchmark::pointsScalar,
+                            &TransformBenchmark::pointsBatched,
+                            &TransformBenchmark::pointsProjectiveScalar,
+                            &TransformBenchmark::pointsProjectiveBatched,
+                            &TransformBenchmark::vectorsQuaternionScalar,
+                            &TransformBenchmark::vectorsQuaternionBatched}, 25,
+        Containers::arraySize(LayoutData));
+}
+
+const Matrix4 Transformation =
+    Matrix4::translation({1.0f, -2.0f, 3.5f})*
+    Matrix4::rotation(35.0_degf, Vector3{1.0f, 2.0f, -0.5f}.normalized())*
+    Matrix4::scaling({2.0f, 0.5f, 3.0f});
+
+const Matrix4 Projection = Matrix4::perspectiveProjection(60.0_degf, 1.5f, 0.1f, 100.0f)*Matrix4::translation({0.0f, 0.0f, -20.0f});
+
+const Quaternion Rotation = Quaternion::rotation(35.0_degf, Vector3{1.0f, 2.0f, -0.5f}.normalized());
+
+struct Data {
+    explicit Data(const std::size_t stride): storage(VertexCount*stride) {
+        for(std::size_t i = 0; i != storage.size(); ++i)
+            storage[i] = {Float(i % 101), Float(i % 37), 1.0f/(i + 1)};
+        view = {Containers::arrayView(storage), storage.data(), VertexCount, std::ptrdiff_t(stride*sizeof(Vector3))};
+    }
+
+    std::vector<Vector3> storage;
+    Containers::StridedArrayView1D<Vector3> view;
+};
+
+void TransformBenchmark::pointsScalar() {
+    auto&& layout = LayoutData[testCaseInstanceId()];
+    setTestCaseDescription(layout.name);
+
+    Data data{layout.stride};
+    CORRADE_BENCHMARK(1) {
+        for(Vector3& point: data.view) point = Transformation.transformPoint(point);
+    }
+
+    CORRADE_VERIFY(data.view[1].dot() > 0.0f);
+}
+
+void TransformBenchmark::pointsBatched() {
+    auto&& layout = LayoutData[testCaseInstanceId()];
+    setTestCaseDescription(layout.name);
+
+    Data data{layout.stride};
+    CORRADE_BENCHMARK(1) {
+        transformPointsInPlace(Transformation, data.view);
+    }
+
+    CORRADE_VERIFY(data.view[1].dot() > 0.0f);
+}
+
+void TransformBenchmark::pointsProjectiveScalar() {
+    auto&& layout = LayoutData[testCaseInstanceId()];
+    setTestCaseDescription(layout.name);
+
+    Data data{layout.stride};
+    CORRADE_BENCHMARK(1) {
+        for(Vector3& point: data.view) point = Projection.transformPoint(point);
+    }
+
+    CORRADE_VERIFY(data.view[1].dot() > 0.0f);
+}
+
+void TransformBenchmark::pointsProjectiveBatched() {
+    auto&& layout = LayoutData[testCaseInstanceId()];
+    setTestCaseDescription(layout.name);
+
+    Data data{layout.stride};
+    CORRADE_BENCHMARK(1) {
+        transformPointsInPlace(Projection, data.view);
+    }
+
+    CORRADE_VERIFY(data.view[1].dot() > 0.0f);
+}
+
+void TransformBenchmark::vectorsQuaternionScalar() {
+    auto&& layout = LayoutData[testCaseInstanceId()];
+    setTestCaseDescription(layout.name);
+
+    Data data{layout.stride};
+    CORRADE_BENCHMARK(1) {
+        for(Vector3& vector: data.view) vector = Rotation.transformVectorNormalized(vector);
+    }
+
+    CORRADE_VERIFY(data.view[1].dot() > 0.0f);
+}
+
+void TransformBenchmark::vectorsQuaternionBatched() {
+    auto&& layout = LayoutData[testCaseInstanceId()];
+    setTestCaseDescription(layout.name);
+
+    Data data{layout.stride};
+    CORRADE_BENCHMARK(1) {
+        transformVectorsInPlace(Rotation, data.view);
+    }
+
+    CORRADE_VERIFY(data.view[1].dot() > 0.0f);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::TransformBenchmark)
@@ -0,0 +1,253 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <vector>
+#include <Corrade/Containers/ArrayViewStl.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/MeshTools/Transform.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+using namespace Math::Literals;
+
+struct TransformTest: TestSuite::Tester {
+    explicit TransformTest();
+
+    void pointsMatrix();
+    void pointsMatrixStrided();
+    void pointsMatrixProjective();
+    void pointsDualQuaternion();
+    void pointsDualQuaternionNotNormalized();
+
+    void vectorsMatrix();
+    void vectorsMatrixStrided();
+    void vectorsQuaternion();
+    void vectorsQuaternionNotNormalized();
+
+    void generic();
+};
+
+/* Sizes around the SSE2, NEON and AVX batch sizes to test the scalar tail */
+const struct {
+    std::size_t size;
+} SizeData[]{
+    {0}, {1}, {3}, {4}, {5}, {7}, {8}, {9}, {15}, {16}, {33}
+};
+
+TransformTest::TransformTest() {
+    addInstancedTests({&TransformTest::pointsMatrix,
+                       &TransformTest::pointsMatrixStrided,
+                       &TransformTest::pointsMatrixProjective,
+                       &TransformTest::pointsDualQuaternion},
+        Containers::arraySize(SizeData));
+
+    addTests({&TransformTest::pointsDualQuaternionNotNormalized});
+
+    addInstancedTests({&TransformTest::vectorsMatrix,
+                       &TransformTest::vectorsMatrixStrided,
+                       &TransformTest::vectorsQuaternion},
+        Containers::arraySize(SizeData));
+
+    addTests({&TransformTest::vectorsQuaternionNotNormalized,
+
+              &TransformTest::generic});
+}
+
+const Matrix4 Transformation =
+    Matrix4::translation({1.0f, -2.0f, 3.5f})*
+    Matrix4::rotation(35.0_degf, Vector3{1.0f, 2.0f, -0.5f}.normalized())*
+    Matrix4::scaling({2.0f, 0.5f, 3.0f});
+
+const Quaternion Rotation = Quaternion::rotation(35.0_degf, Vector3{1.0f, 2.0f, -0.5f}.normalized());
+
+std::vector<Vector3> points(const std::size_t size) {
+    std::vector<Vector3> out;
+    for(std::size_t i = 0; i != size; ++i)
+        out.push_back({0.5f*i - 3.0f, 1.0f/(i + 1), 7.0f - 0.25f*i*i});
+    return out;
+}
+
+void TransformTest::pointsMatrix() {
+    const std::size_t size = SizeData[testCaseInstanceId()].size;
+    setTestCaseDescription(std::to_string(size));
+
+    const std::vector<Vector3> original = points(size);
+    std::vector<Vector3> transformed = original;
+    transformPointsInPlace(Transformation, Containers::stridedArrayView(transformed));
+
+    CORRADE_COMPARE(transformed.size(), size);
+    for(std::size_t i = 0; i != size; ++i)
+        CORRADE_COMPARE(transformed[i], Transformation.transformPoint(original[i]));
+}
+
+void TransformTest::pointsMatrixStrided() {
+    const std::size_t size = SizeData[testCaseInstanceId()].size;
+    setTestCaseDescription(std::to_string(size));
+
+    struct Vertex {
+        Vector3 position;
+        Vector2 textureCoordinates;
+    };
+    const std::vector<Vector3> original = points(size);
+    /* One extra vertex after the view, which should stay untouched */
+    std::vector<Vertex> vertices;
+    for(std::size_t i = 0; i != size; ++i)
+        vertices.push_back({original[i], {Float(i), 0.5f}});
+    vertices.push_back({{1.0f, 2.0f, 3.0f}, {}});
+
+    transformPointsInPlace(Transformation, Containers::StridedArrayView1D<Vector3>{Containers::arrayView(vertices), &vertices[0].position, size, sizeof(Vertex)});
+
+    for(std::size_t i = 0; i != size; ++i) {
+        CORRADE_COMPARE(vertices[i].position, Transformation.transformPoint(original[i]));
+        /* The other data are untouched */
+        CORRADE_COMPARE(vertices[i].textureCoordinates, (Vector2{Float(i), 0.5f}));
+    }
+    CORRADE_COMPARE(vertices.back().position, (Vector3{1.0f, 2.0f, 3.0f}));
+}
+
+void TransformTest::pointsMatrixProjective() {
+    const std::size_t size = SizeData[testCaseInstanceId()].size;
+    setTestCaseDescription(std::to_string(size));
+
+    const Matrix4 projection = Matrix4::perspectiveProjection(60.0_degf, 1.5f, 0.1f, 100.0f)*Matrix4::translation({0.0f, 0.0f, -20.0f});
+
+    const std::vector<Vector3> original = points(size);
+    std::vector<Vector3> transformed = original;
+    transformPointsInPlace(projection, Containers::stridedArrayView(transformed));
+
+    CORRADE_COMPARE(transformed.size(), size);
+    for(std::size_t i = 0; i != size; ++i)
+        CORRADE_COMPARE(transformed[i], projection.transformPoint(original[i]));
+}
+
+void TransformTest::pointsDualQuaternion() {
+    const std::size_t size = SizeData[testCaseInstanceId()].size;
+    setTestCaseDescription(std::to_string(size));
+
+    const DualQuaternion transformation = DualQuaternion::translation({1.0f, -2.0f, 3.5f})*DualQuaternion{Rotation};
+
+    const std::vector<Vector3> original = points(size);
+    std::vector<Vector3> transformed = original;
+    transformPointsInPlace(transformation, Containers::stridedArrayView(transformed));
+
+    CORRADE_COMPARE(transformed.size(), size);
+    for(std::size_t i = 0; i != size; ++i)
+        CORRADE_COMPARE(transformed[i], transformation.transformPointNormalized(original[i]));
+}
+
+void TransformTest::pointsDualQuaternionNotNormalized() {
+    std::vector<Vector3> transformed = points(3);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    transformPointsInPlace(DualQuaternion{Quaternion{{}, 2.0f}}, Containers::stridedArrayView(transformed));
+    CORRADE_COMPARE(out.str(), "MeshTools::transformPointsInPlace(): dual quaternion DualQuaternion({{0, 0, 0}, 2}, {{0, 0, 0}, 0}) is not normalized\n");
+
+    /* The data are left untouched */
+    CORRADE_COMPARE(transformed[2], points(3)[2]);
+}
+
+void TransformTest::vectorsMatrix() {
+    const std::size_t size = SizeData[testCaseInstanceId()].size;
+    setTestCaseDescription(std::to_string(size));
+
+    const std::vector<Vector3> original = points(size);
+    std::vector<Vector3> transformed = original;
+    transformVectorsInPlace(Transformation, Containers::stridedArrayView(transformed));
+
+    CORRADE_COMPARE(transformed.size(), size);
+    for(std::size_t i = 0; i != size; ++i)
+        CORRADE_COMPARE(transformed[i], Transformation.transformVector(original[i]));
+}
+
+void TransformTest::vectorsMatrixStrided() {
+    const std::size_t size = SizeData[testCaseInstanceId()].size;
+    setTestCaseDescription(std::to_string(size));
+
+    struct Vertex {
+        Vector3 position;
+        Vector3 normal;
+    };
+    const std::vector<Vector3> original = points(size);
+    /* One extra vertex after the view, which should stay untouched */
+    std::vector<Vertex> vertices;
+    for(std::size_t i = 0; i != size; ++i)
+        vertices.push_back({original[i], original[i]});
+    vertices.push_back({{}, {1.0f, 2.0f, 3.0f}});
+
+    transformVectorsInPlace(Transformation, Containers::StridedArrayView1D<Vector3>{Containers::arrayView(vertices), &vertices[0].normal, size, sizeof(Vertex)});
+
+    for(std::size_t i = 0; i != size; ++i) {
+        CORRADE_COMPARE(vertices[i].normal, Transformation.transformVector(original[i]));
+        CORRADE_COMPARE(vertices[i].position, original[i]);
+    }
+    CORRADE_COMPARE(vertices.back().normal, (Vector3{1.0f, 2.0f, 3.0f}));
+}
+
+void TransformTest::vectorsQuaternion() {
+    const std::size_t size = SizeData[testCaseInstanceId()].size;
+    setTestCaseDescription(std::to_string(size));
+
+    const std::vector<Vector3> original = points(size);
+    std::vector<Vector3> transformed = original;
+    transformVectorsInPlace(Rotation, Containers::stridedArrayView(transformed));
+
+    CORRADE_COMPARE(transformed.size(), size);
+    for(std::size_t i = 0; i != size; ++i)
+        CORRADE_COMPARE(transformed[i], Rotation.transformVectorNormalized(original[i]));
+}
+
+void TransformTest::vectorsQuaternionNotNormalized() {
+    std::vector<Vector3> transformed = points(3);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    transformVectorsInPlace(Quaternion{{1.0f, 2.0f, 3.0f}, 4.0f}, Containers::stridedArrayView(transformed));
+    CORRADE_COMPARE(out.str(), "MeshTools::transformVectorsInPlace(): quaternion Quaternion({1, 2, 3}, 4) is not normalized\n");
+
+    CORRADE_COMPARE(transformed[2], points(3)[2]);
+}
+
+void TransformTest::generic() {
+    /* Containers such as std::vector pick the generic templates, which should
+       give the same result as the batched variants */
+    const std::vector<Vector3> original = points(17);
+
+    std::vector<Vector3> batchedPoints = original;
+    transformPointsInPlace(Transformation, Containers::stridedArrayView(batchedPoints));
+    CORRADE_COMPARE(transformPoints(Transformation, original), batchedPoints);
+
+    std::vector<Vector3> batchedVectors = original;
+    transformVectorsInPlace(Transformation, Containers::stridedArrayView(batchedVectors));
+    CORRADE_COMPARE(transformVectors(Transformation, original), batchedVectors);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::TransformTest)
@@ -26,8 +26,13 @@
 #include "Tipsify.h"
 
 #include <stack>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
 
-namespace Magnum { namespace MeshTools { namespace Implementation {
+namespace Magnum { namespace MeshTools {
+
+namespace Implementation {
 
 void Tipsify::operator()(std::size_t cacheSize) {
     /* Neighboring triangles for each vertex, per-vertex live triangle count */
@@ -130,6 +135,10 @@ void Tipsify::operator()(std::size_t cacheSize) {
 }
 
 void Tipsify::buildAdjacency(std::vector<UnsignedInt>& liveTriangleCount, std::vector<UnsignedInt>& neighborOffset, std::vector<UnsignedInt>& neighbors) const {
+    buildAdjacency({indices.data(), indices.size()}, vertexCount, liveTriangleCount, neighborOffset, neighbors);
+}
+
+void Tipsify::buildAdjacency(const Containers::ArrayView<const UnsignedInt> indices, const UnsignedInt vertexCount, std::vector<UnsignedInt>& liveTriangleCount, std::vector<UnsignedInt>& neighborOffset, std::vector<UnsignedInt>& neighbors) {
     /* How many times is each vertex referenced == count of neighboring
        triangles for each vertex */
     liveTriangleCount.clear();
@@ -158,4 +167,174 @@ void Tipsify::buildAdjacency(std::vector<UnsignedInt>& liveTriangleCount, std::v
         neighbors[neighborOffset[indices[i]+1]++] = i/3;
 }
 
-}}}
+}
+
+namespace {
+
+/* Scratch memory layout, all in UnsignedInt elements */
+struct ScratchLayout {
+    explicit ScratchLayout(std::size_t indexCount, UnsignedInt vertexCount):
+        liveTriangleCount{0},
+        neighborOffset{liveTriangleCount + vertexCount},
+        neighbors{neighborOffset + vertexCount + 1},
+        timestamp{neighbors + indexCount},
+        deadEndStack{timestamp + vertexCount},
+        outputIndices{deadEndStack + indexCount},
+        emitted{outputIndices + indexCount},
+        size{emitted + (indexCount/3 + 31)/32} {}
+
+    std::size_t liveTriangleCount, neighborOffset, neighbors, timestamp, deadEndStack, outputIndices, emitted, size;
+};
+
+template<class T> void tipsifyImplementation(const Containers::ArrayView<T>& indices, const UnsignedInt vertexCount, const std::size_t cacheSize, const Containers::ArrayView<UnsignedInt>& scratch) {
+    CORRADE_ASSERT(indices.size() % 3 == 0,
+        "MeshTools::tipsify(): index count not divisible by 3", );
+    const ScratchLayout layout{indices.size(), vertexCount};
+    CORRADE_ASSERT(scratch.size() >= layout.size,
+        "MeshTools::tipsify(): expected at least" << layout.size << "scratch elements but got" << scratch.size(), );
+
+    UnsignedInt* const liveTriangleCount = scratch + layout.liveTriangleCount;
+    UnsignedInt* const neighborOffset = scratch + layout.neighborOffset;
+    UnsignedInt* const neighbors = scratch + layout.neighbors;
+    UnsignedInt* const timestamp = scratch + layout.timestamp;
+    UnsignedInt* const deadEndStack = scratch + layout.deadEndStack;
+    UnsignedInt* const outputIndices = scratch + layout.outputIndices;
+    UnsignedInt* const emitted = scratch + layout.emitted;
+
+    /* Build the adjacency the same way as Implementation::Tipsify does,
+       just into the scratch memory */
+    for(std::size_t i = 0; i != vertexCount; ++i) {
+        liveTriangleCount[i] = 0;
+        timestamp[i] = 0;
+    }
+    for(const T index: indices) {
+        CORRADE_ASSERT(index < vertexCount,
+            "MeshTools::tipsify(): index" << index << "out of bounds for" << vertexCount << "vertices", );
+        ++liveTriangleCount[index];
+    }
+    neighborOffset[0] = 0;
+    UnsignedInt sum = 0;
+    for(std::size_t i = 0; i != vertexCount; ++i) {
+        neighborOffset[i + 1] = sum;
+        sum += liveTriangleCount[i];
+    }
+    for(std::size_t i = 0; i != indices.size(); ++i)
+        neighbors[neighborOffset[indices[i] + 1]++] = i/3;
+    for(std::size_t i = 0, end = (indices.size()/3 + 31)/32; i != end; ++i)
+        emitted[i] = 0;
+
+    /* Global time, dead-end stack size and output index count */
+    UnsignedInt time = cacheSize + 1;
+    std::size_t deadEndStackSize = 0;
+    std::size_t outputIndexCount = 0;
+
+    /* Starting vertex for fanning, cursor */
+    UnsignedInt fanningVertex = vertexCount ? 0 : 0xFFFFFFFFu;
+    UnsignedInt i = 0;
+    while(fanningVertex != 0xFFFFFFFFu) {
+        /* Candidates for next fanning vertex (in 1-ring around fanning
+           vertex) are the same vertices that get pushed to the dead-end
+           stack in this step, so the stack is used for both */
+        const std::size_t candidatesBegin = deadEndStackSize;
+
+        /* For all neighbors of fanning vertex */
+        for(UnsignedInt ti = neighborOffset[fanningVertex]; ti != neighborOffset[fanningVertex + 1]; ++ti) {
+            const UnsignedInt t = neighbors[ti];
+
+            /* Continue if already emitted */
+            if(emitted[t >> 5] & (1u << (t & 31))) continue;
+            emitted[t >> 5] |= 1u << (t & 31);
+
+            /* Write all vertices of the triangle to output buffer */
+            for(UnsignedInt vi = 0; vi != 3; ++vi) {
+                const UnsignedInt v = indices[vi + t*3];
+
+                outputIndices[outputIndexCount++] = v;
+                deadEndStack[deadEndStackSize++] = v;
+
+                /* Decrease live triangle count */
+                --liveTriangleCount[v];
+
+                /* If not in cache, set timestamp */
+                if(time - timestamp[v] > cacheSize)
+                    timestamp[v] = time++;
+            }
+        }
+
+        /* Get next fanning vertex */
+        fanningVertex = 0xFFFFFFFFu;
+
+        /* Go through candidates in 1-ring around fanning vertex */
+        Int candidatePriority = -1;
+        for(std::size_t c = candidatesBegin; c != deadEndStackSize; ++c) {
+            const UnsignedInt v = deadEndStack[c];
+
+            /* Skip if it doesn't have any live triangles */
+            if(!liveTriangleCount[v]) continue;
+
+            /* Get most fresh candidate which will still be in cache even
+               after fanning. Every fanned triangle will generate at most
+               two cache misses, thus 2*liveTriangleCount */
+            Int priority = 0;
+            if(time - timestamp[v] + 2*liveTriangleCount[v] <= cacheSize)
+                priority = time - timestamp[v];
+            if(priority > candidatePriority) {
+                fanningVertex = v;
+                candidatePriority = priority;
+            }
+        }
+
+        /* On dead-end */
+        if(fanningVertex == 0xFFFFFFFFu) {
+            /* Find vertex with live triangles in dead-end stack */
+            while(deadEndStackSize) {
+                const UnsignedInt d = deadEndStack[--deadEndStackSize];
+                if(!liveTriangleCount[d]) continue;
+                fanningVertex = d;
+                break;
+            }
+
+            /* If not found, find next arbitrary vertex with live
+               triangles */
+            if(fanningVertex == 0xFFFFFFFFu) while(++i < vertexCount) {
+                if(!liveTriangleCount[i]) continue;
+
+                fanningVertex = i;
+                break;
+            }
+        }
+    }
+
+    /* Copy the optimized index buffer back */
+    for(std::size_t j = 0; j != indices.size(); ++j)
+        indices[j] = T(outputIndices[j]);
+}
+
+template<class T> void tipsifyImplementation(const Containers::ArrayView<T>& indices, const UnsignedInt vertexCount, const std::size_t cacheSize) {
+    Containers::Array<UnsignedInt> scratch{Containers::NoInit, tipsifyScratchSize(indices.size(), vertexCount)};
+    tipsifyImplementation(indices, vertexCount, cacheSize, scratch);
+}
+
+}
+
+std::size_t tipsifyScratchSize(const std::size_t indexCount, const UnsignedInt vertexCount) {
+    return ScratchLayout{indexCount, vertexCount}.size;
+}
+
+void tipsify(const Containers::ArrayView<UnsignedInt>& indices, const UnsignedInt vertexCount, const std::size_t cacheSize, const Containers::ArrayView<UnsignedInt>& scratch) {
+    tipsifyImplementation(indices, vertexCount, cacheSize, scratch);
+}
+
+void tipsify(const Containers::ArrayView<UnsignedShort>& indices, const UnsignedInt vertexCount, const std::size_t cacheSize, const Containers::ArrayView<UnsignedInt>& scratch) {
+    tipsifyImplementation(indices, vertexCount, cacheSize, scratch);
+}
+
+void tipsify(const Containers::ArrayView<UnsignedInt>& indices, const UnsignedInt vertexCount, const std::size_t cacheSize) {
+    tipsifyImplementation(indices, vertexCount, cacheSize);
+}
+
+void tipsify(const Containers::ArrayView<UnsignedShort>& indices, const UnsignedInt vertexCount, const std::size_t cacheSize) {
+    tipsifyImplementation(indices, vertexCount, cacheSize);
+}
+
+}}
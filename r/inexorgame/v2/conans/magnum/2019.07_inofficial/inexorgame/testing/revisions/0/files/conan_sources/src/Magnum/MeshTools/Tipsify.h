@@ -26,12 +26,13 @@
 */
 
 /** @file
- * @brief Function @ref Magnum::MeshTools::tipsify()
+ * @brief Function @ref Magnum::MeshTools::tipsify(), @ref Magnum::MeshTools::tipsifyScratchSize()
  */
 
 #include <vector>
+#include <Corrade/Containers/ArrayView.h>
 
-#include "Magnum/Types.h"
+#include "Magnum/Magnum.h"
 #include "Magnum/MeshTools/visibility.h"
 
 namespace Magnum { namespace MeshTools {
@@ -53,6 +54,14 @@ class MAGNUM_MESHTOOLS_EXPORT Tipsify {
          */
         void buildAdjacency(std::vector<UnsignedInt>& liveTriangleCount, std::vector<UnsignedInt>& neighborOffset, std::vector<UnsignedInt>& neighbors) const;
 
+        /**
+         * @brief Build vertex-triangle adjacency for given index array
+         *
+         * Same as above, but usable without a @ref Tipsify instance and on
+         * an arbitrary index view (used by @ref buildMeshlets()).
+         */
+        static void buildAdjacency(Containers::ArrayView<const UnsignedInt> indices, UnsignedInt vertexCount, std::vector<UnsignedInt>& liveTriangleCount, std::vector<UnsignedInt>& neighborOffset, std::vector<UnsignedInt>& neighbors);
+
     private:
         std::vector<UnsignedInt>& indices;
         const UnsignedInt vertexCount;
@@ -71,12 +80,70 @@ array for beter usage of post-transform vertex cache. Algorithm used:
 *Pedro V. Sander, Diego Nehab, and Joshua Barczak --- Fast Triangle Reordering
 for Vertex Locality and Reduced Overdraw, SIGGRAPH 2007,
 http://gfx.cs.princeton.edu/pubs/Sander_2007_%3ETR/index.php*.
+@see @ref optimizeVertexCacheInPlace(), @ref optimizeOverdrawInPlace(),
+    @ref optimizeVertexFetchInPlace(), @ref analyzeVertexCache()
 @todo Ability to compute vertex count automatically
 */
 inline void tipsify(std::vector<UnsignedInt>& indices, UnsignedInt vertexCount, std::size_t cacheSize) {
     Implementation::Tipsify(indices, vertexCount)(cacheSize);
 }
 
+/**
+@brief Scratch memory size needed for tipsifying a mesh
+@param indexCount   Index count
+@param vertexCount  Vertex count
+
+Returns count of @ref Magnum::UnsignedInt "UnsignedInt" elements that need to
+be passed to @ref tipsify(const Containers::ArrayView<UnsignedInt>&, UnsignedInt, std::size_t, const Containers::ArrayView<UnsignedInt>&).
+The scratch memory is linear in both index and vertex count.
+*/
+std::size_t MAGNUM_MESHTOOLS_EXPORT tipsifyScratchSize(std::size_t indexCount, UnsignedInt vertexCount);
+
+/**
+@brief Tipsify the mesh in-place using a scratch buffer
+@param[in,out] indices  Indices array to operate on
+@param[in] vertexCount  Vertex count
+@param[in] cacheSize    Post-transform vertex cache size
+@param[in] scratch      Scratch memory
+
+Uses the same algorithm as
+@ref tipsify(std::vector<UnsignedInt>&, UnsignedInt, std::size_t), but
+operates on a view and doesn't do any heap allocation. On a dead-end, the next
+fanning vertex is taken from the dead-end stack first and only if none of the
+vertices there has any live triangles left, the next vertex with live
+triangles in index order is picked. The @ref tipsify(std::vector<UnsignedInt>&, UnsignedInt, std::size_t)
+variant always picks the next vertex in index order, the resulting index order
+thus may differ between the two. The @p scratch array is expected to have at
+least @ref tipsifyScratchSize() elements, its contents are overwritten. Useful
+when processing many meshes in a row, where a single scratch buffer sized for
+the largest mesh can be reused for all of them. The @p indices array is
+expected to have size divisible by @cpp 3 @ce and all values less than
+@p vertexCount.
+*/
+void MAGNUM_MESHTOOLS_EXPORT tipsify(const Containers::ArrayView<UnsignedInt>& indices, UnsignedInt vertexCount, std::size_t cacheSize, const Containers::ArrayView<UnsignedInt>& scratch);
+
+/**
+@overload
+
+Vertex count is expected to be representable in 16 bits.
+*/
+void MAGNUM_MESHTOOLS_EXPORT tipsify(const Containers::ArrayView<UnsignedShort>& indices, UnsignedInt vertexCount, std::size_t cacheSize, const Containers::ArrayView<UnsignedInt>& scratch);
+
+/**
+@brief Tipsify the mesh in-place
+
+Allocates a scratch buffer of @ref tipsifyScratchSize() elements and calls
+@ref tipsify(const Containers::ArrayView<UnsignedInt>&, UnsignedInt, std::size_t, const Containers::ArrayView<UnsignedInt>&).
+*/
+void MAGNUM_MESHTOOLS_EXPORT tipsify(const Containers::ArrayView<UnsignedInt>& indices, UnsignedInt vertexCount, std::size_t cacheSize);
+
+/**
+@overload
+
+Vertex count is expected to be representable in 16 bits.
+*/
+void MAGNUM_MESHTOOLS_EXPORT tipsify(const Containers::ArrayView<UnsignedShort>& indices, UnsignedInt vertexCount, std::size_t cacheSize);
+
 }}
 
 #endif
@@ -0,0 +1,327 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "Transform.h"
+
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define MAGNUM_MESHTOOLS_TRANSFORM_AVX
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MAGNUM_MESHTOOLS_TRANSFORM_SSE2
+/* GCC and Clang can compile AVX code without AVX being enabled globally, so
+   pick it at runtime if the CPU supports it */
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define MAGNUM_MESHTOOLS_TRANSFORM_AVX
+#define MAGNUM_MESHTOOLS_TRANSFORM_AVX_RUNTIME
+#define MAGNUM_MESHTOOLS_TRANSFORM_AVX_TARGET __attribute__((target("avx")))
+#endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define MAGNUM_MESHTOOLS_TRANSFORM_NEON
+#endif
+
+#if defined(MAGNUM_MESHTOOLS_TRANSFORM_AVX) && !defined(MAGNUM_MESHTOOLS_TRANSFORM_AVX_TARGET)
+#define MAGNUM_MESHTOOLS_TRANSFORM_AVX_TARGET
+#endif
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+/* Gathering the components into separate arrays transposes the data to SoA
+   for any stride. The compiler turns the fixed-size loops into
+   plain loads and stores. Going through raw pointers instead of the view
+   operator[], as its range check would be done for every item. */
+template<std::size_t size> inline void gather(const Containers::StridedArrayView1D<Vector3>& data, const std::size_t offset, Float* x, Float* y, Float* z) {
+    const char* p = static_cast<const char*>(data.data()) + offset*data.stride();
+    for(std::size_t i = 0; i != size; ++i, p += data.stride()) {
+        const Vector3& v = *reinterpret_cast<const Vector3*>(p);
+        x[i] = v.x();
+        y[i] = v.y();
+        z[i] = v.z();
+    }
+}
+
+template<std::size_t size> inline void scatter(const Containers::StridedArrayView1D<Vector3>& data, const std::size_t offset, const Float* x, const Float* y, const Float* z) {
+    char* p = static_cast<char*>(data.data()) + offset*data.stride();
+    for(std::size_t i = 0; i != size; ++i, p += data.stride())
+        *reinterpret_cast<Vector3*>(p) = {x[i], y[i], z[i]};
+}
+
+/* The operations are done in the same order as in Matrix4::operator*(), so
+   the result is bit-exact with Matrix4::transformPoint() and
+   transformVector() */
+inline Vector3 transformScalar(const Matrix4& matrix, const bool projective, const Vector3& v) {
+    const Vector3 out = matrix[0].xyz()*v.x() + matrix[1].xyz()*v.y() + matrix[2].xyz()*v.z() + matrix[3].xyz();
+    if(!projective) return out;
+    return out/(matrix[0].w()*v.x() + matrix[1].w()*v.y() + matrix[2].w()*v.z() + matrix[3].w());
+}
+
+/* For tightly packed data, the transposition between XYZXYZXYZXYZ and
+   XXXX YYYY ZZZZ is done with shuffles in registers instead. The shuffle and
+   unpack instructions operate on 128-bit lanes, so the same sequence works for
+   SSE2 and for AVX, where each lane handles four vectors. */
+#define MAGNUM_MESHTOOLS_TRANSFORM_DEFINE_TRANSPOSE(type, prefix, target) \
+    target inline void transposeToSoA(type a, type b, type c, type& x, type& y, type& z) { \
+        /* a = x0 y0 z0 x1, b = y1 z1 x2 y2, c = z2 x3 y3 z3 */             \
+        const type xy23 = prefix ## _shuffle_ps(b, c, _MM_SHUFFLE(2, 1, 3, 2)); \
+        const type yz01 = prefix ## _shuffle_ps(a, b, _MM_SHUFFLE(1, 0, 2, 1)); \
+        x = prefix ## _shuffle_ps(a, xy23, _MM_SHUFFLE(2, 0, 3, 0));       \
+        y = prefix ## _shuffle_ps(yz01, xy23, _MM_SHUFFLE(3, 1, 2, 0));    \
+        z = prefix ## _shuffle_ps(yz01, c, _MM_SHUFFLE(3, 0, 3, 1));       \
+    }                                                                       \
+    target inline void transposeToAoS(type x, type y, type z, type& a, type& b, type& c) { \
+        const type xyLo = prefix ## _unpacklo_ps(x, y); /* x0 y0 x1 y1 */  \
+        const type xyHi = prefix ## _unpackhi_ps(x, y); /* x2 y2 x3 y3 */  \
+        const type yzLo = prefix ## _unpacklo_ps(y, z); /* y0 z0 y1 z1 */  \
+        const type yzHi = prefix ## _unpackhi_ps(y, z); /* y2 z2 y3 z3 */  \
+        const type zxLo = prefix ## _unpacklo_ps(z, x); /* z0 x0 z1 x1 */  \
+        const type zxHi = prefix ## _unpackhi_ps(z, x); /* z2 x2 z3 x3 */  \
+        a = prefix ## _shuffle_ps(xyLo, zxLo, _MM_SHUFFLE(3, 0, 1, 0));    \
+        b = prefix ## _shuffle_ps(yzLo, xyHi, _MM_SHUFFLE(1, 0, 3, 2));    \
+        c = prefix ## _shuffle_ps(zxHi, yzHi, _MM_SHUFFLE(3, 2, 3, 0));    \
+    }
+
+#if defined(MAGNUM_MESHTOOLS_TRANSFORM_SSE2) || defined(MAGNUM_MESHTOOLS_TRANSFORM_AVX)
+MAGNUM_MESHTOOLS_TRANSFORM_DEFINE_TRANSPOSE(__m128, _mm, )
+#endif
+#ifdef MAGNUM_MESHTOOLS_TRANSFORM_AVX
+MAGNUM_MESHTOOLS_TRANSFORM_DEFINE_TRANSPOSE(__m256, _mm256, MAGNUM_MESHTOOLS_TRANSFORM_AVX_TARGET)
+#endif
+
+#undef MAGNUM_MESHTOOLS_TRANSFORM_DEFINE_TRANSPOSE
+
+#ifdef MAGNUM_MESHTOOLS_TRANSFORM_AVX
+MAGNUM_MESHTOOLS_TRANSFORM_AVX_TARGET inline void transformAvx(const __m256 (&m)[4][4], const bool projective, __m256& x, __m256& y, __m256& z) {
+    __m256 out[4];
+    for(std::size_t row = 0; row != (projective ? 4 : 3); ++row)
+        out[row] = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(
+            _mm256_mul_ps(m[0][row], x),
+            _mm256_mul_ps(m[1][row], y)),
+            _mm256_mul_ps(m[2][row], z)),
+            m[3][row]);
+    if(projective) for(std::size_t row = 0; row != 3; ++row)
+        out[row] = _mm256_div_ps(out[row], out[3]);
+    x = out[0];
+    y = out[1];
+    z = out[2];
+}
+
+MAGNUM_MESHTOOLS_TRANSFORM_AVX_TARGET std::size_t transformAvx(const Matrix4& matrix, const bool projective, const Containers::StridedArrayView1D<Vector3>& data) {
+    __m256 m[4][4];
+    for(std::size_t col = 0; col != 4; ++col)
+        for(std::size_t row = 0; row != 4; ++row)
+            m[col][row] = _mm256_set1_ps(matrix[col][row]);
+
+    std::size_t i = 0;
+    if(data.stride() == sizeof(Vector3)) {
+        for(; i + 8 <= data.size(); i += 8) {
+            /* Vectors 0-3 go to the lower lane, 4-7 to the upper */
+            Float* const p = data[i].data();
+            __m256 a = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p + 0)), _mm_loadu_ps(p + 12), 1);
+            __m256 b = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p + 4)), _mm_loadu_ps(p + 16), 1);
+            __m256 c = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p + 8)), _mm_loadu_ps(p + 20), 1);
+            __m256 x, y, z;
+            transposeToSoA(a, b, c, x, y, z);
+            transformAvx(m, projective, x, y, z);
+            transposeToAoS(x, y, z, a, b, c);
+            _mm_storeu_ps(p + 0, _mm256_castps256_ps128(a));
+            _mm_storeu_ps(p + 4, _mm256_castps256_ps128(b));
+            _mm_storeu_ps(p + 8, _mm256_castps256_ps128(c));
+            _mm_storeu_ps(p + 12, _mm256_extractf128_ps(a, 1));
+            _mm_storeu_ps(p + 16, _mm256_extractf128_ps(b, 1));
+            _mm_storeu_ps(p + 20, _mm256_extractf128_ps(c, 1));
+        }
+
+    } else for(; i + 8 <= data.size(); i += 8) {
+        alignas(32) Float xs[8], ys[8], zs[8];
+        gather<8>(data, i, xs, ys, zs);
+        __m256 x = _mm256_load_ps(xs);
+        __m256 y = _mm256_load_ps(ys);
+        __m256 z = _mm256_load_ps(zs);
+        transformAvx(m, projective, x, y, z);
+        _mm256_store_ps(xs, x);
+        _mm256_store_ps(ys, y);
+        _mm256_store_ps(zs, z);
+        scatter<8>(data, i, xs, ys, zs);
+    }
+
+    return i;
+}
+#endif
+
+#ifdef MAGNUM_MESHTOOLS_TRANSFORM_SSE2
+inline void transformSse2(const __m128 (&m)[4][4], const bool projective, __m128& x, __m128& y, __m128& z) {
+    __m128 out[4];
+    for(std::size_t row = 0; row != (projective ? 4 : 3); ++row)
+        out[row] = _mm_add_ps(_mm_add_ps(_mm_add_ps(
+            _mm_mul_ps(m[0][row], x),
+            _mm_mul_ps(m[1][row], y)),
+            _mm_mul_ps(m[2][row], z)),
+            m[3][row]);
+    if(projective) for(std::size_t row = 0; row != 3; ++row)
+        out[row] = _mm_div_ps(out[row], out[3]);
+    x = out[0];
+    y = out[1];
+    z = out[2];
+}
+
+std::size_t transformSse2(const Matrix4& matrix, const bool projective, const Containers::StridedArrayView1D<Vector3>& data) {
+    __m128 m[4][4];
+    for(std::size_t col = 0; col != 4; ++col)
+        for(std::size_t row = 0; row != 4; ++row)
+            m[col][row] = _mm_set1_ps(matrix[col][row]);
+
+    std::size_t i = 0;
+    if(data.stride() == sizeof(Vector3)) {
+        for(; i + 4 <= data.size(); i += 4) {
+            Float* const p = data[i].data();
+            __m128 a = _mm_loadu_ps(p + 0);
+            __m128 b = _mm_loadu_ps(p + 4);
+            __m128 c = _mm_loadu_ps(p + 8);
+            __m128 x, y, z;
+            transposeToSoA(a, b, c, x, y, z);
+            transformSse2(m, projective, x, y, z);
+            transposeToAoS(x, y, z, a, b, c);
+            _mm_storeu_ps(p + 0, a);
+            _mm_storeu_ps(p + 4, b);
+            _mm_storeu_ps(p + 8, c);
+        }
+
+    } else for(; i + 4 <= data.size(); i += 4) {
+        alignas(16) Float xs[4], ys[4], zs[4];
+        gather<4>(data, i, xs, ys, zs);
+        __m128 x = _mm_load_ps(xs);
+        __m128 y = _mm_load_ps(ys);
+        __m128 z = _mm_load_ps(zs);
+        transformSse2(m, projective, x, y, z);
+        _mm_store_ps(xs, x);
+        _mm_store_ps(ys, y);
+        _mm_store_ps(zs, z);
+        scatter<4>(data, i, xs, ys, zs);
+    }
+
+    return i;
+}
+#endif
+
+#ifdef MAGNUM_MESHTOOLS_TRANSFORM_NEON
+std::size_t transformNeon(const Matrix4& matrix, const bool projective, const Containers::StridedArrayView1D<Vector3>& data) {
+    float32x4_t m[4][4];
+    for(std::size_t col = 0; col != 4; ++col)
+        for(std::size_t row = 0; row != 4; ++row)
+            m[col][row] = vdupq_n_f32(matrix[col][row]);
+
+    std::size_t i = 0;
+    for(; i + 4 <= data.size(); i += 4) {
+        Float x[4], y[4], z[4], w[4];
+        gather<4>(data, i, x, y, z);
+        const float32x4_t vx = vld1q_f32(x);
+        const float32x4_t vy = vld1q_f32(y);
+        const float32x4_t vz = vld1q_f32(z);
+
+        float32x4_t out[4];
+        for(std::size_t row = 0; row != (projective ? 4 : 3); ++row)
+            out[row] = vaddq_f32(vaddq_f32(vaddq_f32(
+                vmulq_f32(m[0][row], vx),
+                vmulq_f32(m[1][row], vy)),
+                vmulq_f32(m[2][row], vz)),
+                m[3][row]);
+
+        vst1q_f32(x, out[0]);
+        vst1q_f32(y, out[1]);
+        vst1q_f32(z, out[2]);
+
+        /* ARMv7 NEON has no division instruction */
+        if(projective) {
+            vst1q_f32(w, out[3]);
+            for(std::size_t j = 0; j != 4; ++j) {
+                x[j] /= w[j];
+                y[j] /= w[j];
+                z[j] /= w[j];
+            }
+        }
+
+        scatter<4>(data, i, x, y, z);
+    }
+
+    return i;
+}
+#endif
+
+void transformInPlace(const Matrix4& matrix, const bool projective, const Containers::StridedArrayView1D<Vector3>& data) {
+    std::size_t i = 0;
+    #if defined(MAGNUM_MESHTOOLS_TRANSFORM_AVX_RUNTIME)
+    static const bool hasAvx = __builtin_cpu_supports("avx");
+    i = hasAvx ? transformAvx(matrix, projective, data) :
+        transformSse2(matrix, projective, data);
+    #elif defined(MAGNUM_MESHTOOLS_TRANSFORM_AVX)
+    i = transformAvx(matrix, projective, data);
+    #elif defined(MAGNUM_MESHTOOLS_TRANSFORM_SSE2)
+    i = transformSse2(matrix, projective, data);
+    #elif defined(MAGNUM_MESHTOOLS_TRANSFORM_NEON)
+    i = transformNeon(matrix, projective, data);
+    #endif
+
+    /* Remaining items or everything if there's no SIMD */
+    for(; i != data.size(); ++i)
+        data[i] = transformScalar(matrix, projective, data[i]);
+}
+
+}
+
+void transformVectorsInPlace(const Matrix4& matrix, const Containers::StridedArrayView1D<Vector3> vectors) {
+    /* Matrix4::transformVector() multiplies the translation by zero, which is
+       the same as adding zero */
+    Matrix4 linear = matrix;
+    linear[3] = {};
+    transformInPlace(linear, false, vectors);
+}
+
+void transformVectorsInPlace(const Quaternion& normalizedQuaternion, const Containers::StridedArrayView1D<Vector3> vectors) {
+    CORRADE_ASSERT(normalizedQuaternion.isNormalized(),
+        "MeshTools::transformVectorsInPlace(): quaternion" << normalizedQuaternion << "is not normalized", );
+    transformInPlace(Matrix4::from(normalizedQuaternion.toMatrix(), {}), false, vectors);
+}
+
+void transformPointsInPlace(const Matrix4& matrix, const Containers::StridedArrayView1D<Vector3> points) {
+    /* Dividing by one doesn't change anything, so skip it for affine
+       transformations */
+    transformInPlace(matrix, matrix.row(3) != Vector4{0.0f, 0.0f, 0.0f, 1.0f}, points);
+}
+
+void transformPointsInPlace(const DualQuaternion& normalizedDualQuaternion, const Containers::StridedArrayView1D<Vector3> points) {
+    CORRADE_ASSERT(normalizedDualQuaternion.isNormalized(),
+        "MeshTools::transformPointsInPlace(): dual quaternion" << normalizedDualQuaternion << "is not normalized", );
+    transformInPlace(normalizedDualQuaternion.toMatrix(), false, points);
+}
+
+}}
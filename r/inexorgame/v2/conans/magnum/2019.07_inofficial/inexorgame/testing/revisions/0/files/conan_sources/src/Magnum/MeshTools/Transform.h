@@ -29,8 +29,12 @@
  * @brief Function @ref Magnum::MeshTools::transformVectorsInPlace(), @ref Magnum::MeshTools::transformVectors(), @ref Magnum::MeshTools::transformPointsInPlace(), @ref Magnum::MeshTools::transformPoints()
  */
 
+#include <Corrade/Containers/StridedArrayView.h>
+
+#include "Magnum/Magnum.h"
 #include "Magnum/Math/DualQuaternion.h"
 #include "Magnum/Math/DualComplex.h"
+#include "Magnum/MeshTools/visibility.h"
 
 namespace Magnum { namespace MeshTools {
 
@@ -74,6 +78,38 @@ template<class T, class U> void transformVectorsInPlace(const Math::Quaternion<T
     for(auto& vector: vectors) vector = normalizedQuaternion.transformVectorNormalized(vector);
 }
 
+/**
+@brief Transform a strided array of vectors in-place using given matrix
+
+Batched variant of @ref transformVectorsInPlace(const Math::Matrix4<T>&, U&)
+for @ref Vector3 data, for example positions or normals in an interleaved
+vertex buffer. The vectors are processed in batches, transposed to separate
+X, Y and Z registers and transformed using SSE2, AVX or NEON, whichever
+is available. On x86 with GCC and Clang the AVX variant is picked at runtime
+based on CPU capabilities even if the library isn't compiled with AVX
+enabled, on other platforms the choice is done at compile time. Remaining
+vectors and platforms with no SIMD support use a scalar loop.
+
+The result is the same as @ref Matrix4::transformVector() applied to each
+vector. Note that containers such as @ref std::vector or
+@ref Corrade::Containers::Array "Containers::Array" pick the generic template
+and have to be explicitly converted to a strided view to use this overload.
+@see @ref transformPointsInPlace(const Matrix4&, Containers::StridedArrayView1D<Vector3>)
+*/
+/* Taking the view by value so it's preferred over the generic U& template for
+   lvalues as well */
+void MAGNUM_MESHTOOLS_EXPORT transformVectorsInPlace(const Matrix4& matrix, Containers::StridedArrayView1D<Vector3> vectors);
+
+/**
+@brief Transform a strided array of vectors in-place using given quaternion
+
+Converts @p normalizedQuaternion to a rotation matrix and then does the same
+as @ref transformVectorsInPlace(const Matrix4&, Containers::StridedArrayView1D<Vector3>).
+Expects that the quaternion is normalized. The result may differ from
+@ref Quaternion::transformVectorNormalized() in the last few bits.
+*/
+void MAGNUM_MESHTOOLS_EXPORT transformVectorsInPlace(const Quaternion& normalizedQuaternion, Containers::StridedArrayView1D<Vector3> vectors);
+
 /**
 @brief Transform vectors using given transformation
 
@@ -125,6 +161,28 @@ template<class T, class U> void transformPointsInPlace(const Math::DualQuaternio
     for(auto& point: points) point = normalizedDualQuaternion.transformPointNormalized(point);
 }
 
+/**
+@brief Transform a strided array of points in-place using given matrix
+
+Batched variant of @ref transformPointsInPlace(const Math::Matrix4<T>&, U&)
+for @ref Vector3 data, with the same vectorization as
+@ref transformVectorsInPlace(const Matrix4&, Containers::StridedArrayView1D<Vector3>).
+The result is the same as @ref Matrix4::transformPoint() applied to each
+point, including the perspective division. If the last row of @p matrix is
+@f$ (0, 0, 0, 1) @f$, the division is skipped.
+*/
+void MAGNUM_MESHTOOLS_EXPORT transformPointsInPlace(const Matrix4& matrix, Containers::StridedArrayView1D<Vector3> points);
+
+/**
+@brief Transform a strided array of points in-place using given dual quaternion
+
+Converts @p normalizedDualQuaternion to a transformation matrix and then does
+the same as @ref transformPointsInPlace(const Matrix4&, Containers::StridedArrayView1D<Vector3>).
+Expects that the dual quaternion is normalized. The result may differ from
+@ref DualQuaternion::transformPointNormalized() in the last few bits.
+*/
+void MAGNUM_MESHTOOLS_EXPORT transformPointsInPlace(const DualQuaternion& normalizedDualQuaternion, Containers::StridedArrayView1D<Vector3> points);
+
 /**
 @brief Transform points using given transformation
 
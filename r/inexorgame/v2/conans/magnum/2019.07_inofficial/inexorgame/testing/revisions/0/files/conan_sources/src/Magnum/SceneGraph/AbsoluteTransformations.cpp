@@ -0,0 +1,57 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "AbsoluteTransformations.h"
+
+#include <Corrade/Utility/TaskScheduler.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Implementation/taskScheduler.h"
+
+namespace Magnum { namespace SceneGraph { namespace Implementation {
+
+namespace {
+    /* Don't bother other threads with just a handful of objects */
+    constexpr std::size_t MinimalObjectsPerThread = 1024;
+}
+
+UnsignedInt absoluteTransformationsThreadCount(UnsignedInt threadCount, const std::size_t objectCount) {
+    if(!threadCount) threadCount = Magnum::Implementation::taskScheduler().threadCount();
+    return Math::min(std::size_t(threadCount), Math::max(objectCount/MinimalObjectsPerThread, std::size_t{1}));
+}
+
+void absoluteTransformationsParallelFor(const std::size_t count, const UnsignedInt threadCount, void(*const function)(void*, std::size_t, std::size_t), void* const state) {
+    const std::size_t grainSize = Math::max((count + threadCount - 1)/threadCount, MinimalObjectsPerThread);
+    if(count <= grainSize) {
+        function(state, 0, count);
+        return;
+    }
+
+    Magnum::Implementation::taskScheduler().parallelFor(0, count, grainSize, [function, state](const std::size_t begin, const std::size_t end) {
+        function(state, begin, end);
+    });
+}
+
+}}}
@@ -0,0 +1,290 @@
+#ifndef Magnum_SceneGraph_AbsoluteTransformations_h
+#define Magnum_SceneGraph_AbsoluteTransformations_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::SceneGraph::absoluteTransformationsInto(), @ref Magnum::SceneGraph::absoluteTransformationMatrices(), @ref Magnum::SceneGraph::drawableTransformations()
+ */
+
+#include <functional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/SceneGraph/Camera.h"
+#include "Magnum/SceneGraph/Drawable.h"
+#include "Magnum/SceneGraph/Object.h"
+#include "Magnum/SceneGraph/visibility.h"
+
+namespace Magnum { namespace SceneGraph {
+
+namespace Implementation {
+
+/* Thread count to use for given object count, resolving 0 to the thread
+   count of the shared task scheduler. Returns 1 if it's not worth it or
+   threads are not available. */
+MAGNUM_SCENEGRAPH_EXPORT UnsignedInt absoluteTransformationsThreadCount(UnsignedInt threadCount, std::size_t objectCount);
+
+/* Calls function(state, begin, end) for at most threadCount chunks of
+   [0, count) on the shared task scheduler */
+MAGNUM_SCENEGRAPH_EXPORT void absoluteTransformationsParallelFor(std::size_t count, UnsignedInt threadCount, void(*function)(void*, std::size_t, std::size_t), void* state);
+
+/* Computes absolute transformations for objects in given range. The
+   ancestor chain of the previous object is remembered, so siblings and
+   cousins that are next to each other in the list share the composition
+   of their common ancestors. The composition is always done top-down,
+   starting with the initial transformation, so the result doesn't depend
+   on the object order or on how the list was split among threads. */
+template<class Transformation> void absoluteTransformationsInto(const std::reference_wrapper<Object<Transformation>>* const objects, const std::size_t count, const Containers::StridedArrayView1D<typename Transformation::DataType>& out, const typename Transformation::DataType& initialTransformation) {
+    /* Ancestors of current object, from the object up to the root */
+    std::vector<const Object<Transformation>*> ancestors;
+    /* Previous chain from the root down, with absolute transformations */
+    std::vector<std::pair<const Object<Transformation>*, typename Transformation::DataType>> chain;
+
+    for(std::size_t i = 0; i != count; ++i) {
+        ancestors.clear();
+        for(const Object<Transformation>* o = &objects[i].get(); o; o = o->parent())
+            ancestors.push_back(o);
+
+        /* Find how much of the previous chain can be reused */
+        std::size_t common = 0;
+        const std::size_t depth = ancestors.size();
+        while(common != chain.size() && common != depth && chain[common].first == ancestors[depth - common - 1])
+            ++common;
+        chain.erase(chain.begin() + common, chain.end());
+
+        /* Compose the rest top-down */
+        for(std::size_t j = common; j != depth; ++j) {
+            const Object<Transformation>* o = ancestors[depth - j - 1];
+            chain.emplace_back(o, Implementation::Transformation<Transformation>::compose(
+                j ? chain.back().second : initialTransformation,
+                o->transformation()));
+        }
+
+        out[i] = chain.back().second;
+    }
+}
+
+/* Parallel variant. All objects and their ancestors are collected into a
+   list of unique nodes, sorted by their depth in the hierarchy. Each depth
+   level is then processed in parallel, composing every node exactly once
+   with the already calculated absolute transformation of its parent. The
+   composition order is the same as above, so the results are too. */
+template<class Transformation> void absoluteTransformationsIntoParallel(const std::vector<std::reference_wrapper<Object<Transformation>>>& objects, const Containers::StridedArrayView1D<typename Transformation::DataType>& out, const typename Transformation::DataType& initialTransformation, const UnsignedInt threadCount) {
+    constexpr std::size_t NoParent = ~std::size_t{};
+
+    /* Assign an index to each object and all its ancestors, remembering the
+       index of the parent and the depth */
+    std::unordered_map<const Object<Transformation>*, std::size_t> nodeIds;
+    std::vector<std::pair<const Object<Transformation>*, std::size_t>> nodes;
+    std::vector<std::size_t> depths;
+    std::vector<std::size_t> objectNodes;
+    std::vector<const Object<Transformation>*> unvisited;
+    nodeIds.reserve(objects.size());
+    nodes.reserve(objects.size());
+    depths.reserve(objects.size());
+    objectNodes.reserve(objects.size());
+    for(const Object<Transformation>& object: objects) {
+        /* Go up until an already visited ancestor or the root is found */
+        unvisited.clear();
+        std::size_t parent = NoParent;
+        for(const Object<Transformation>* o = &object; o; o = o->parent()) {
+            const auto found = nodeIds.find(o);
+            if(found != nodeIds.end()) {
+                parent = found->second;
+                break;
+            }
+            unvisited.push_back(o);
+        }
+
+        /* Add the unvisited ones top-down */
+        for(std::size_t i = unvisited.size(); i != 0; --i) {
+            const std::size_t id = nodes.size();
+            nodeIds.emplace(unvisited[i - 1], id);
+            nodes.emplace_back(unvisited[i - 1], parent);
+            depths.push_back(parent == NoParent ? 0 : depths[parent] + 1);
+            parent = id;
+        }
+
+        objectNodes.push_back(parent);
+    }
+
+    /* Sort the nodes by depth */
+    std::vector<std::size_t> levelOffsets;
+    for(const std::size_t depth: depths) {
+        if(depth + 2 > levelOffsets.size()) levelOffsets.resize(depth + 2);
+        ++levelOffsets[depth + 1];
+    }
+    for(std::size_t i = 1; i < levelOffsets.size(); ++i)
+        levelOffsets[i] += levelOffsets[i - 1];
+    std::vector<std::size_t> sorted(nodes.size());
+    {
+        std::vector<std::size_t> offsets{levelOffsets};
+        for(std::size_t i = 0; i != nodes.size(); ++i)
+            sorted[offsets[depths[i]]++] = i;
+    }
+
+    /* Process the levels top-down, each in parallel */
+    struct State {
+        const std::vector<std::pair<const Object<Transformation>*, std::size_t>>& nodes;
+        const std::size_t* sorted;
+        std::vector<typename Transformation::DataType>& transformations;
+        const typename Transformation::DataType& initialTransformation;
+    };
+    std::vector<typename Transformation::DataType> transformations(nodes.size());
+    for(std::size_t level = 0; level + 1 < levelOffsets.size(); ++level) {
+        State state{nodes, sorted.data() + levelOffsets[level], transformations, initialTransformation};
+        absoluteTransformationsParallelFor(levelOffsets[level + 1] - levelOffsets[level], threadCount, [](void* data, const std::size_t begin, const std::size_t end) {
+            const State& state = *static_cast<const State*>(data);
+            for(std::size_t i = begin; i != end; ++i) {
+                const std::size_t id = state.sorted[i];
+                const std::pair<const Object<Transformation>*, std::size_t>& node = state.nodes[id];
+                state.transformations[id] = Implementation::Transformation<Transformation>::compose(
+                    node.second == NoParent ? state.initialTransformation : state.transformations[node.second],
+                    node.first->transformation());
+            }
+        }, &state);
+    }
+
+    for(std::size_t i = 0; i != objects.size(); ++i)
+        out[i] = transformations[objectNodes[i]];
+}
+
+}
+
+/**
+@brief Compute absolute transformations of given objects in parallel
+@param[in] objects      Objects to compute the transformations for
+@param[out] out         Where to put the transformations
+@param[in] initialTransformation Initial transformation, applied before the
+    root object transformation
+@param[in] threadCount  Thread count. @cpp 0 @ce means to use all available
+    hardware threads.
+
+An alternative to @ref Object::transformations() for wide hierarchies with
+many objects. Transformation of each object is composed top-down from
+@p initialTransformation and transformations of all its ancestors, in the
+same order as @ref Object::setClean() does it. The results are thus
+bit-identical regardless of @p threadCount or of the order of @p objects, for
+all transformation implementations.
+
+If more than one thread is used, the objects and their ancestors are grouped
+by depth in the hierarchy and each level is processed in parallel, so every
+ancestor is composed exactly once. The work is done on a task scheduler
+shared by all of Magnum, @p threadCount only limits how many chunks each
+level is split into. In the serial case, objects that are next to each other
+in the list and share ancestors reuse the ancestor composition, so it's
+advised to order the list in hierarchy order.
+
+The @p out view is expected to have the same size as @p objects. The objects
+are only read from, which means they can't be modified from other threads
+while this function is running. Multiple threads are used only if Corrade is
+built with `BUILD_MULTITHREADED` and not on
+@ref CORRADE_TARGET_EMSCRIPTEN "Emscripten", otherwise the computation is
+done serially.
+@see @ref absoluteTransformationMatrices(), @ref drawableTransformations()
+*/
+template<class Transformation> void absoluteTransformationsInto(const std::vector<std::reference_wrapper<Object<Transformation>>>& objects, const Containers::StridedArrayView1D<typename Transformation::DataType>& out, const typename Transformation::DataType& initialTransformation = typename Transformation::DataType{}, UnsignedInt threadCount = 1) {
+    CORRADE_ASSERT(out.size() == objects.size(),
+        "SceneGraph::absoluteTransformationsInto(): expected output view size" << objects.size() << "but got" << out.size(), );
+
+    threadCount = Implementation::absoluteTransformationsThreadCount(threadCount, objects.size());
+    if(threadCount > 1) {
+        Implementation::absoluteTransformationsIntoParallel(objects, out, initialTransformation, threadCount);
+        return;
+    }
+
+    Implementation::absoluteTransformationsInto(objects.data(), objects.size(), out, initialTransformation);
+}
+
+/**
+@brief Compute absolute transformation matrices of given objects in parallel
+
+Calls @ref absoluteTransformationsInto() and converts the result to
+matrices. See its documentation for more information.
+@see @ref Object::transformationMatrices()
+*/
+template<class Transformation> std::vector<MatrixTypeFor<Transformation::Dimensions, typename Transformation::Type>> absoluteTransformationMatrices(const std::vector<std::reference_wrapper<Object<Transformation>>>& objects, const MatrixTypeFor<Transformation::Dimensions, typename Transformation::Type>& initialTransformationMatrix = MatrixTypeFor<Transformation::Dimensions, typename Transformation::Type>{}, UnsignedInt threadCount = 1) {
+    std::vector<typename Transformation::DataType> transformations(objects.size());
+    absoluteTransformationsInto(objects, Containers::StridedArrayView1D<typename Transformation::DataType>{Containers::arrayView(transformations.data(), transformations.size())}, Implementation::Transformation<Transformation>::fromMatrix(initialTransformationMatrix), threadCount);
+
+    std::vector<MatrixTypeFor<Transformation::Dimensions, typename Transformation::Type>> transformationMatrices(transformations.size());
+    for(std::size_t i = 0; i != transformations.size(); ++i)
+        transformationMatrices[i] = Implementation::Transformation<Transformation>::toMatrix(transformations[i]);
+    return transformationMatrices;
+}
+
+/**
+@brief Transformations of all drawables in the group relative to the camera, computed in parallel
+
+An alternative to @ref Camera::drawableTransformations() with the
+transformations computed using @ref absoluteTransformationsInto() on
+@p threadCount threads. The transformations are composed top-down from the
+camera matrix, while @ref Camera::drawableTransformations() composes them
+bottom-up from each object toward its root, so the results may differ in
+floating-point rounding. As with @ref Camera::drawableTransformations(), all
+objects in the group are expected to be of type
+@cpp Object<Transformation> @ce and part of the same scene as the camera.
+The result can be passed to @ref Camera::draw(const std::vector<std::pair<std::reference_wrapper<Drawable<dimensions, T>>, MatrixTypeFor<dimensions, T>>>&).
+
+Neither the camera nor the group know the transformation implementation of
+the objects, so the @p Transformation template parameter can't be deduced and
+has to be specified explicitly:
+
+@code{.cpp}
+SceneGraph::Camera3D camera{cameraObject};
+SceneGraph::DrawableGroup3D drawables;
+
+// all cores
+camera.draw(SceneGraph::drawableTransformations<SceneGraph::MatrixTransformation3D>(camera, drawables, 0));
+@endcode
+*/
+template<class Transformation> std::vector<std::pair<std::reference_wrapper<Drawable<Transformation::Dimensions, typename Transformation::Type>>, MatrixTypeFor<Transformation::Dimensions, typename Transformation::Type>>> drawableTransformations(Camera<Transformation::Dimensions, typename Transformation::Type>& camera, DrawableGroup<Transformation::Dimensions, typename Transformation::Type>& group, UnsignedInt threadCount = 1) {
+    CORRADE_ASSERT(camera.object().scene(),
+        "SceneGraph::drawableTransformations(): cannot draw when camera is not part of any scene", {});
+
+    /** @todo Ensure this doesn't crash, somehow */
+    std::vector<std::reference_wrapper<Object<Transformation>>> objects;
+    objects.reserve(group.size());
+    for(std::size_t i = 0; i != group.size(); ++i)
+        objects.push_back(static_cast<Object<Transformation>&>(group[i].object()));
+
+    /* Camera matrix cleans the camera object */
+    std::vector<MatrixTypeFor<Transformation::Dimensions, typename Transformation::Type>> transformations = absoluteTransformationMatrices(objects, camera.cameraMatrix(), threadCount);
+
+    std::vector<std::pair<std::reference_wrapper<Drawable<Transformation::Dimensions, typename Transformation::Type>>, MatrixTypeFor<Transformation::Dimensions, typename Transformation::Type>>> combined;
+    combined.reserve(group.size());
+    for(std::size_t i = 0; i != group.size(); ++i)
+        combined.emplace_back(group[i], transformations[i]);
+    return combined;
+}
+
+}}
+
+#endif
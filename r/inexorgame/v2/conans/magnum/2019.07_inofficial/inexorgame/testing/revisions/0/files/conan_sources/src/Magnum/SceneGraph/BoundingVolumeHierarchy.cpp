@@ -0,0 +1,429 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "BoundingVolumeHierarchy.h"
+
+#include <algorithm>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/Math/Frustum.h"
+#include "Magnum/Math/Intersection.h"
+#include "Magnum/SceneGraph/AbstractObject.h"
+
+namespace Magnum { namespace SceneGraph {
+
+namespace {
+
+constexpr UnsignedInt NoNode = ~UnsignedInt{};
+constexpr UnsignedInt BinCount = 16;
+
+/* Half of the surface area, the constant factor doesn't matter for SAH */
+inline Float halfArea(const Range3D& range) {
+    const Vector3 size = range.size();
+    return size.x()*size.y() + size.y()*size.z() + size.z()*size.x();
+}
+
+/* Unlike Math::join() this doesn't treat zero-size ranges as empty, as
+   point-like primitives are perfectly valid here */
+inline Range3D join(const Range3D& a, const Range3D& b) {
+    return {Math::min(a.min(), b.min()), Math::max(a.max(), b.max())};
+}
+
+struct BuildTask {
+    UnsignedInt parent, begin, end;
+    /* Node whose offset should be set to index of this node, if it's a
+       right child */
+    UnsignedInt leftSibling;
+};
+
+}
+
+BoundingVolumeHierarchy::BoundingVolumeHierarchy(): _dirtyNodeCount{} {}
+
+void BoundingVolumeHierarchy::build(const Containers::StridedArrayView1D<const Range3D>& bounds, const UnsignedInt maxLeafSize) {
+    CORRADE_ASSERT(maxLeafSize, "SceneGraph::BoundingVolumeHierarchy::build(): max leaf size can't be zero", );
+
+    const UnsignedInt primitiveCount = bounds.size();
+    _primitiveBounds.resize(primitiveCount);
+    _primitiveLeaves.assign(primitiveCount, NoNode);
+    _primitives.resize(primitiveCount);
+    _nodes.clear();
+    _nodeParents.clear();
+    _dirtyNodes.clear();
+    _dirtyNodeCount = 0;
+    if(!primitiveCount) return;
+
+    Containers::Array<Vector3> centroids{Containers::NoInit, primitiveCount};
+    for(UnsignedInt i = 0; i != primitiveCount; ++i) {
+        _primitives[i] = i;
+        _primitiveBounds[i] = bounds[i];
+        centroids[i] = bounds[i].center();
+    }
+
+    /* A binary tree with at least one primitive per leaf has at most
+       2n - 1 nodes */
+    _nodes.reserve(2*primitiveCount - 1);
+    _nodeParents.reserve(2*primitiveCount - 1);
+
+    /* Explicit stack instead of recursion, as degenerate inputs could result
+       in a very deep tree. The right child is pushed first so the left one
+       gets processed right after its parent, directly following it in the
+       node array. */
+    std::vector<BuildTask> stack{{NoNode, 0, primitiveCount, NoNode}};
+    while(!stack.empty()) {
+        const BuildTask task = stack.back();
+        stack.pop_back();
+
+        const UnsignedInt id = _nodes.size();
+        if(task.leftSibling != NoNode) _nodes[task.leftSibling].offset = id;
+
+        /* Node and centroid bounds */
+        Range3D nodeBounds = _primitiveBounds[_primitives[task.begin]];
+        Range3D centroidBounds{centroids[_primitives[task.begin]], centroids[_primitives[task.begin]]};
+        for(UnsignedInt i = task.begin + 1; i != task.end; ++i) {
+            const UnsignedInt primitive = _primitives[i];
+            nodeBounds = join(nodeBounds, _primitiveBounds[primitive]);
+            centroidBounds = join(centroidBounds, {centroids[primitive], centroids[primitive]});
+        }
+        _nodes.push_back({nodeBounds, task.begin, 0});
+        _nodeParents.push_back(task.parent);
+
+        const UnsignedInt count = task.end - task.begin;
+        UnsignedInt middle = task.begin;
+        if(count > 1) {
+            /* Bin the centroids along the largest centroid axis. If all
+               centroids are in the same place, there's no point in binning,
+               split in half if the node is too large. */
+            const Vector3 centroidSize = centroidBounds.size();
+            const Int axis = centroidSize.x() >= centroidSize.y() ?
+                (centroidSize.x() >= centroidSize.z() ? 0 : 2) :
+                (centroidSize.y() >= centroidSize.z() ? 1 : 2);
+            const Float axisMin = centroidBounds.min()[axis];
+            const Float axisSize = centroidSize[axis];
+            if(axisSize > 0.0f) {
+                const Float binScale = BinCount*(1.0f - 1.0e-6f)/axisSize;
+                UnsignedInt binCounts[BinCount]{};
+                Range3D binBounds[BinCount];
+                for(UnsignedInt i = task.begin; i != task.end; ++i) {
+                    const UnsignedInt primitive = _primitives[i];
+                    const UnsignedInt bin = Math::min(UnsignedInt((centroids[primitive][axis] - axisMin)*binScale), BinCount - 1);
+                    binBounds[bin] = binCounts[bin]++ ?
+                        join(binBounds[bin], _primitiveBounds[primitive]) :
+                        _primitiveBounds[primitive];
+                }
+
+                /* Sweep from the right to get area of each right half, then
+                   from the left evaluating cost of each split plane */
+                Float rightAreas[BinCount - 1];
+                {
+                    Range3D rightBounds;
+                    UnsignedInt rightCount = 0;
+                    for(UnsignedInt i = BinCount - 1; i != 0; --i) {
+                        if(binCounts[i]) rightBounds = rightCount ?
+                            join(rightBounds, binBounds[i]) : binBounds[i];
+                        rightCount += binCounts[i];
+                        rightAreas[i - 1] = halfArea(rightBounds);
+                    }
+                }
+
+                Float bestCost = Constants::inf();
+                UnsignedInt bestSplit = 0;
+                {
+                    Range3D leftBounds;
+                    UnsignedInt leftCount = 0;
+                    for(UnsignedInt i = 0; i != BinCount - 1; ++i) {
+                        if(binCounts[i]) leftBounds = leftCount ?
+                            join(leftBounds, binBounds[i]) : binBounds[i];
+                        leftCount += binCounts[i];
+                        if(!leftCount || leftCount == count) continue;
+                        const Float cost = halfArea(leftBounds)*leftCount + rightAreas[i]*(count - leftCount);
+                        if(cost < bestCost) {
+                            bestCost = cost;
+                            bestSplit = i;
+                        }
+                    }
+                }
+
+                /* Split if the node is too large or if it's cheaper than
+                   testing all primitives in it. Cost of a traversal step is
+                   assumed to be the same as of a primitive test. */
+                const Float nodeArea = halfArea(nodeBounds);
+                if(count > maxLeafSize || nodeArea + bestCost < nodeArea*count) {
+                    middle = std::partition(_primitives.begin() + task.begin, _primitives.begin() + task.end, [&](UnsignedInt primitive) {
+                        return Math::min(UnsignedInt((centroids[primitive][axis] - axisMin)*binScale), BinCount - 1) <= bestSplit;
+                    }) - _primitives.begin();
+                }
+
+            } else if(count > maxLeafSize) middle = task.begin + count/2;
+        }
+
+        /* Leaf */
+        if(middle == task.begin || middle == task.end) {
+            _nodes.back().count = count;
+            for(UnsignedInt i = task.begin; i != task.end; ++i)
+                _primitiveLeaves[_primitives[i]] = id;
+            continue;
+        }
+
+        stack.push_back({id, middle, task.end, id});
+        stack.push_back({id, task.begin, middle, NoNode});
+    }
+
+    _dirtyNodes.assign((_nodes.size() + 31)/32, 0);
+}
+
+Range3D BoundingVolumeHierarchy::bounds() const {
+    return _nodes.empty() ? Range3D{} : _nodes.front().bounds;
+}
+
+void BoundingVolumeHierarchy::setPrimitiveBounds(const UnsignedInt primitive, const Range3D& bounds) {
+    CORRADE_ASSERT(primitive < _primitiveBounds.size(),
+        "SceneGraph::BoundingVolumeHierarchy::setPrimitiveBounds(): index" << primitive << "out of range for" << _primitiveBounds.size() << "primitives", );
+
+    _primitiveBounds[primitive] = bounds;
+
+    /* Mark the leaf and its ancestors dirty. If a node is already marked,
+       all its ancestors are as well. */
+    for(UnsignedInt node = _primitiveLeaves[primitive]; node != NoNode; node = _nodeParents[node]) {
+        UnsignedInt& word = _dirtyNodes[node >> 5];
+        const UnsignedInt bit = 1u << (node & 31);
+        if(word & bit) break;
+        word |= bit;
+        ++_dirtyNodeCount;
+    }
+}
+
+void BoundingVolumeHierarchy::refit() {
+    if(!_dirtyNodeCount) return;
+
+    /* Children always have larger indices than their parents, so going
+       backwards updates them first. Whole clean words are skipped. */
+    for(std::size_t w = _dirtyNodes.size(); w != 0; --w) {
+        UnsignedInt& word = _dirtyNodes[w - 1];
+        if(!word) continue;
+
+        for(Int b = 31; b >= 0; --b) {
+            if(!(word & (1u << b))) continue;
+
+            Node& node = _nodes[((w - 1) << 5) + b];
+            if(node.count) {
+                Range3D bounds = _primitiveBounds[_primitives[node.offset]];
+                for(UnsignedInt i = node.offset + 1, end = node.offset + node.count; i != end; ++i)
+                    bounds = join(bounds, _primitiveBounds[_primitives[i]]);
+                node.bounds = bounds;
+            } else node.bounds = join((&node)[1].bounds, _nodes[node.offset].bounds);
+        }
+
+        word = 0;
+    }
+
+    _dirtyNodeCount = 0;
+}
+
+template<class NodeTest, class LeafTest> void BoundingVolumeHierarchy::query(NodeTest nodeTest, LeafTest leafTest, std::vector<UnsignedInt>& out) const {
+    if(_nodes.empty()) return;
+
+    std::vector<UnsignedInt> stack;
+    stack.reserve(64);
+    UnsignedInt id = 0;
+    for(;;) {
+        const Node& node = _nodes[id];
+        if(nodeTest(node.bounds)) {
+            /* Leaf, test all primitives */
+            if(node.count) {
+                for(UnsignedInt i = node.offset, end = node.offset + node.count; i != end; ++i) {
+                    const UnsignedInt primitive = _primitives[i];
+                    if(node.count == 1 || leafTest(_primitiveBounds[primitive]))
+                        out.push_back(primitive);
+                }
+
+            /* Interior node, continue with the left child which directly
+               follows, remember the right one for later */
+            } else {
+                stack.push_back(node.offset);
+                ++id;
+                continue;
+            }
+        }
+
+        if(stack.empty()) break;
+        id = stack.back();
+        stack.pop_back();
+    }
+}
+
+void BoundingVolumeHierarchy::queryFrustum(const Frustum& frustum, std::vector<UnsignedInt>& out) const {
+    const auto test = [&frustum](const Range3D& bounds) {
+        return Math::Intersection::rangeFrustum(bounds, frustum);
+    };
+    query(test, test, out);
+}
+
+void BoundingVolumeHierarchy::querySphere(const Vector3& center, const Float radius, std::vector<UnsignedInt>& out) const {
+    const Float radiusSquared = radius*radius;
+    const auto test = [&center, radiusSquared](const Range3D& bounds) {
+        return (Math::clamp(center, bounds.min(), bounds.max()) - center).dot() <= radiusSquared;
+    };
+    query(test, test, out);
+}
+
+void BoundingVolumeHierarchy::queryRange(const Range3D& range, std::vector<UnsignedInt>& out) const {
+    /* Math::intersects() treats the max as exclusive, here both ends are
+       inclusive so touching and zero-size bounds are reported as well */
+    const auto test = [&range](const Range3D& bounds) {
+        return (bounds.min() <= range.max()).all() && (range.min() <= bounds.max()).all();
+    };
+    query(test, test, out);
+}
+
+void BoundingVolumeHierarchy::queryRay(const Vector3& origin, const Vector3& direction, std::vector<UnsignedInt>& out) const {
+    const Vector3 inverseDirection = 1.0f/direction;
+    const auto test = [&origin, &inverseDirection](const Range3D& bounds) {
+        return Math::Intersection::rayRange(origin, inverseDirection, bounds);
+    };
+    query(test, test, out);
+}
+
+BoundingVolume::BoundingVolume(AbstractObject3D& object, BoundingVolumeGroup& group, const Range3D& bounds): AbstractFeature3D{object}, _group{&group}, _id{UnsignedInt(group._volumes.size())}, _dirty{true}, _queued{false}, _bounds{bounds} {
+    setCachedTransformations(CachedTransformation::Absolute);
+    group._volumes.push_back(this);
+    group._rebuildNeeded = true;
+}
+
+BoundingVolume::~BoundingVolume() {
+    if(!_group) return;
+
+    /* Move the last volume in place of this one. The ids change, so the
+       hierarchy has to be rebuilt. */
+    BoundingVolume* const last = _group->_volumes.back();
+    _group->_volumes[_id] = last;
+    last->_id = _id;
+    _group->_volumes.pop_back();
+    _group->_rebuildNeeded = true;
+}
+
+BoundingVolume& BoundingVolume::setBounds(const Range3D& bounds) {
+    _bounds = bounds;
+    markDirty();
+    return *this;
+}
+
+void BoundingVolume::markDirty() {
+    _dirty = true;
+
+    /* The object can get cleaned by someone else (e.g. a camera) before the
+       group is updated, so it's not enough to rely on the dirty flag alone
+       to know if the volume is in the list */
+    if(_queued || !_group) return;
+    _queued = true;
+    _group->_dirtyVolumes.push_back(_id);
+}
+
+void BoundingVolume::clean(const Matrix4& absoluteTransformationMatrix) {
+    /* Transform the center and calculate extents of the transformed box
+       (Arvo's method) */
+    const Vector3 center = absoluteTransformationMatrix.transformPoint(_bounds.center());
+    const Vector3 extents =
+        Math::abs(absoluteTransformationMatrix[0].xyz())*_bounds.sizeX()*0.5f +
+        Math::abs(absoluteTransformationMatrix[1].xyz())*_bounds.sizeY()*0.5f +
+        Math::abs(absoluteTransformationMatrix[2].xyz())*_bounds.sizeZ()*0.5f;
+    _absoluteBounds = {center - extents, center + extents};
+    _dirty = false;
+}
+
+BoundingVolumeGroup::BoundingVolumeGroup(const UnsignedInt maxLeafSize): _maxLeafSize{maxLeafSize}, _rebuildNeeded{false} {}
+
+BoundingVolumeGroup::~BoundingVolumeGroup() {
+    for(BoundingVolume* volume: _volumes) volume->_group = nullptr;
+}
+
+BoundingVolume& BoundingVolumeGroup::operator[](const std::size_t id) {
+    /* Returning the first volume so this can be tested with graceful
+       asserts. There's nothing to return for an empty group, at() throws
+       in that case instead of reading past the end. */
+    CORRADE_ASSERT(id < _volumes.size(),
+        "SceneGraph::BoundingVolumeGroup::operator[](): index" << id << "out of range for" << _volumes.size() << "volumes", *_volumes.at(0));
+    return *_volumes[id];
+}
+
+const BoundingVolume& BoundingVolumeGroup::operator[](const std::size_t id) const {
+    /* See above */
+    CORRADE_ASSERT(id < _volumes.size(),
+        "SceneGraph::BoundingVolumeGroup::operator[](): index" << id << "out of range for" << _volumes.size() << "volumes", *_volumes.at(0));
+    return *_volumes[id];
+}
+
+BoundingVolumeGroup& BoundingVolumeGroup::update() {
+    /* Gather changed volumes. On rebuild all volumes are considered, as
+       the ids in the queue may be stale. */
+    std::vector<BoundingVolume*> volumes;
+    if(_rebuildNeeded) {
+        volumes.reserve(_volumes.size());
+        for(BoundingVolume* volume: _volumes) {
+            volume->_queued = false;
+            volumes.push_back(volume);
+        }
+    } else for(UnsignedInt id: _dirtyVolumes) {
+        BoundingVolume* volume = _volumes[id];
+        volume->_queued = false;
+        volumes.push_back(volume);
+    }
+    _dirtyVolumes.clear();
+
+    /* Clean all dirty objects in one go, which calls clean() on the
+       volumes. Volumes that got dirty only because of setBounds() or were
+       added to an already clean object don't get cleaned this way, so
+       calculate their bounds directly. */
+    if(!volumes.empty()) {
+        std::vector<std::reference_wrapper<AbstractObject3D>> objects;
+        objects.reserve(volumes.size());
+        for(BoundingVolume* volume: volumes)
+            if(volume->object().isDirty()) objects.push_back(volume->object());
+        AbstractObject3D::setClean(objects);
+
+        for(BoundingVolume* volume: volumes)
+            if(volume->_dirty) volume->clean(volume->object().absoluteTransformationMatrix());
+    }
+
+    if(_rebuildNeeded) {
+        Containers::Array<Range3D> bounds{Containers::NoInit, _volumes.size()};
+        for(std::size_t i = 0; i != _volumes.size(); ++i)
+            bounds[i] = _volumes[i]->_absoluteBounds;
+        _hierarchy.build(bounds, _maxLeafSize);
+        _rebuildNeeded = false;
+
+    } else if(!volumes.empty()) {
+        for(BoundingVolume* volume: volumes)
+            _hierarchy.setPrimitiveBounds(volume->_id, volume->_absoluteBounds);
+        _hierarchy.refit();
+    }
+
+    return *this;
+}
+
+}}
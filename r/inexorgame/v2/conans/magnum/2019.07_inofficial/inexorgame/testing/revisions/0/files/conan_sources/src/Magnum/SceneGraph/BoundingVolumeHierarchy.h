@@ -0,0 +1,375 @@
+#ifndef Magnum_SceneGraph_BoundingVolumeHierarchy_h
+#define Magnum_SceneGraph_BoundingVolumeHierarchy_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::BoundingVolumeHierarchy, @ref Magnum::SceneGraph::BoundingVolume, @ref Magnum::SceneGraph::BoundingVolumeGroup
+ */
+
+#include <vector>
+#include <Corrade/Containers/StridedArrayView.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/SceneGraph/AbstractFeature.h"
+#include "Magnum/SceneGraph/visibility.h"
+
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Bounding volume hierarchy
+
+Spatial index over a set of axis-aligned bounding boxes, accelerating
+frustum, sphere, box and ray queries. Each box is identified by its index
+in the array passed to @ref build(). The hierarchy can be used standalone or
+maintained automatically for objects in a scene using
+@ref BoundingVolumeGroup.
+
+The tree is built top-down using the surface area heuristic evaluated on
+@cpp 16 @ce bins along the largest centroid axis. The nodes are stored in a
+single array in depth-first order, with the left child directly following
+its parent and only the right child index stored, so traversal mostly walks
+forward through memory.
+
+When the primitives move, instead of rebuilding the whole tree, call
+@ref setPrimitiveBounds() for each changed primitive and then @ref refit().
+That marks the leaf and all its ancestors in a dirty bitset and the refit
+then updates bounds of just the marked nodes, in a single reverse pass over
+the node array. The tree topology is not changed by the refit, so quality of
+the hierarchy may degrade if the primitives move significantly --- in that
+case it's advised to call @ref build() again.
+
+Leaf and node tests are done using @ref Math::Intersection::rangeFrustum(),
+@ref Math::Intersection::rayRange() and @ref Math::intersects().
+*/
+class MAGNUM_SCENEGRAPH_EXPORT BoundingVolumeHierarchy {
+    public:
+        /**
+         * @brief Constructor
+         *
+         * Creates an empty hierarchy, call @ref build() to populate it.
+         */
+        explicit BoundingVolumeHierarchy();
+
+        /**
+         * @brief Build the hierarchy
+         * @param bounds        Primitive bounds
+         * @param maxLeafSize   Max count of primitives in a leaf node
+         *
+         * Replaces any previous contents. The @p maxLeafSize is expected to
+         * be at least @cpp 1 @ce. Nodes with more primitives are always
+         * split, smaller nodes only if the surface area heuristic says it's
+         * cheaper than testing all primitives.
+         */
+        void build(const Containers::StridedArrayView1D<const Range3D>& bounds, UnsignedInt maxLeafSize = 4);
+
+        /** @brief Primitive count */
+        std::size_t primitiveCount() const { return _primitiveBounds.size(); }
+
+        /** @brief Node count */
+        std::size_t nodeCount() const { return _nodes.size(); }
+
+        /**
+         * @brief Bounds of all primitives
+         *
+         * Returns a default-constructed range if the hierarchy is empty. Not
+         * up-to-date if the hierarchy is dirty, call @ref refit() first.
+         */
+        Range3D bounds() const;
+
+        /** @brief Primitive bounds */
+        Containers::ArrayView<const Range3D> primitiveBounds() const {
+            return {_primitiveBounds.data(), _primitiveBounds.size()};
+        }
+
+        /**
+         * @brief Update primitive bounds
+         *
+         * Expects that @p primitive is less than @ref primitiveCount(). Marks
+         * the leaf containing the primitive and all its ancestors as dirty,
+         * call @ref refit() to update the node bounds.
+         */
+        void setPrimitiveBounds(UnsignedInt primitive, const Range3D& bounds);
+
+        /**
+         * @brief Whether the hierarchy needs a refit
+         *
+         * @see @ref setPrimitiveBounds()
+         */
+        bool isDirty() const { return _dirtyNodeCount; }
+
+        /**
+         * @brief Refit dirty nodes
+         *
+         * Updates bounds of all nodes marked as dirty by
+         * @ref setPrimitiveBounds() and clears the dirty bitset. Does nothing
+         * if the hierarchy is not dirty.
+         */
+        void refit();
+
+        /**
+         * @brief Query primitives intersecting a frustum
+         *
+         * Appends indices of all primitives whose bounds intersect
+         * @p frustum to @p out. As with
+         * @ref Math::Intersection::rangeFrustum(), some primitives near the
+         * frustum corners may be reported even though they're outside.
+         */
+        void queryFrustum(const Frustum& frustum, std::vector<UnsignedInt>& out) const;
+
+        /**
+         * @brief Query primitives intersecting a sphere
+         *
+         * Appends indices of all primitives whose bounds intersect a sphere
+         * of given @p center and @p radius to @p out.
+         */
+        void querySphere(const Vector3& center, Float radius, std::vector<UnsignedInt>& out) const;
+
+        /**
+         * @brief Query primitives intersecting a box
+         *
+         * Appends indices of all primitives whose bounds intersect @p range
+         * to @p out.
+         */
+        void queryRange(const Range3D& range, std::vector<UnsignedInt>& out) const;
+
+        /**
+         * @brief Query primitives intersecting a ray
+         *
+         * Appends indices of all primitives whose bounds intersect a ray
+         * starting at @p origin going in @p direction to @p out. Only the
+         * primitive bounds are tested, an exact test against the actual
+         * geometry is up to the caller.
+         */
+        void queryRay(const Vector3& origin, const Vector3& direction, std::vector<UnsignedInt>& out) const;
+
+    private:
+        struct Node {
+            Range3D bounds;
+            /* For leaves offset into _primitives, for interior nodes index
+               of the right child */
+            UnsignedInt offset;
+            /* Primitive count, zero for interior nodes */
+            UnsignedInt count;
+        };
+
+        MAGNUM_SCENEGRAPH_LOCAL void buildNode(UnsignedInt parent, UnsignedInt begin, UnsignedInt end, const Vector3* centroids, UnsignedInt maxLeafSize);
+        template<class NodeTest, class LeafTest> MAGNUM_SCENEGRAPH_LOCAL void query(NodeTest nodeTest, LeafTest leafTest, std::vector<UnsignedInt>& out) const;
+
+        std::vector<Node> _nodes;
+        std::vector<UnsignedInt> _nodeParents;
+        std::vector<UnsignedInt> _dirtyNodes;
+        std::size_t _dirtyNodeCount;
+        std::vector<UnsignedInt> _primitives;
+        std::vector<UnsignedInt> _primitiveLeaves;
+        std::vector<Range3D> _primitiveBounds;
+};
+
+class BoundingVolumeGroup;
+
+/**
+@brief Bounding volume
+
+Feature attaching an axis-aligned bounding box to an object, tracked in a
+@ref BoundingVolumeGroup. The box is in object-local coordinates, the group
+keeps a @ref BoundingVolumeHierarchy of the boxes transformed to world
+space.
+
+Transformation changes are picked up through the usual dirty-flag mechanism
+--- when the object or any of its parents is marked as dirty, the volume
+adds itself to a list of dirty volumes in the group. @ref BoundingVolumeGroup::update()
+then cleans just the dirty objects, updates their world bounds and refits
+only the part of the hierarchy that contains them.
+
+@code{.cpp}
+SceneGraph::BoundingVolumeGroup volumes;
+for(Object3D* o: objects)
+    new SceneGraph::BoundingVolume{*o, volumes, {{-1.0f, -1.0f, -1.0f}, {1.0f, 1.0f, 1.0f}}};
+
+// ... move some objects ...
+
+std::vector<UnsignedInt> visible;
+volumes.update().hierarchy().queryFrustum(frustum, visible);
+for(UnsignedInt i: visible) {
+    SceneGraph::BoundingVolume& volume = volumes[i];
+    // ...
+}
+@endcode
+
+@see @ref scenegraph
+*/
+class MAGNUM_SCENEGRAPH_EXPORT BoundingVolume: public AbstractFeature3D {
+    friend BoundingVolumeGroup;
+
+    public:
+        /**
+         * @brief Constructor
+         * @param object    Object holding the volume
+         * @param group     Group the volume belongs to
+         * @param bounds    Bounding box in object-local coordinates
+         */
+        explicit BoundingVolume(AbstractObject3D& object, BoundingVolumeGroup& group, const Range3D& bounds);
+
+        ~BoundingVolume();
+
+        /**
+         * @brief Group containing this volume
+         *
+         * Returns @cpp nullptr @ce if the group was destroyed before the
+         * volume.
+         */
+        BoundingVolumeGroup* group() { return _group; }
+        const BoundingVolumeGroup* group() const { return _group; } /**< @overload */
+
+        /**
+         * @brief Index of the volume in the group
+         *
+         * Corresponds to primitive indices returned by the
+         * @ref BoundingVolumeHierarchy queries. The index can change when
+         * another volume is removed from the group.
+         */
+        UnsignedInt id() const { return _id; }
+
+        /** @brief Bounding box in object-local coordinates */
+        Range3D bounds() const { return _bounds; }
+
+        /**
+         * @brief Set bounding box in object-local coordinates
+         * @return Reference to self (for method chaining)
+         *
+         * The change is propagated to the group hierarchy on next
+         * @ref BoundingVolumeGroup::update().
+         */
+        BoundingVolume& setBounds(const Range3D& bounds);
+
+        /**
+         * @brief Bounding box in world coordinates
+         *
+         * Axis-aligned box enclosing @ref bounds() transformed by object
+         * absolute transformation. Up-to-date only after
+         * @ref BoundingVolumeGroup::update().
+         */
+        Range3D absoluteBounds() const { return _absoluteBounds; }
+
+    private:
+        MAGNUM_SCENEGRAPH_LOCAL void markDirty() override;
+        MAGNUM_SCENEGRAPH_LOCAL void clean(const Matrix4& absoluteTransformationMatrix) override;
+
+        BoundingVolumeGroup* _group;
+        UnsignedInt _id;
+        bool _dirty, _queued;
+        Range3D _bounds, _absoluteBounds;
+};
+
+/**
+@brief Group of bounding volumes
+
+Owns a @ref BoundingVolumeHierarchy of all @ref BoundingVolume instances
+added to it. See @ref BoundingVolume for more information.
+*/
+class MAGNUM_SCENEGRAPH_EXPORT BoundingVolumeGroup {
+    friend BoundingVolume;
+
+    public:
+        /**
+         * @brief Constructor
+         * @param maxLeafSize   Max count of primitives in a leaf node, passed
+         *      to @ref BoundingVolumeHierarchy::build()
+         */
+        explicit BoundingVolumeGroup(UnsignedInt maxLeafSize = 4);
+
+        /** @brief Copying is not allowed */
+        BoundingVolumeGroup(const BoundingVolumeGroup&) = delete;
+
+        /** @brief Moving is not allowed */
+        BoundingVolumeGroup(BoundingVolumeGroup&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * The volumes are not destroyed, only detached from the group.
+         */
+        ~BoundingVolumeGroup();
+
+        /** @brief Copying is not allowed */
+        BoundingVolumeGroup& operator=(const BoundingVolumeGroup&) = delete;
+
+        /** @brief Moving is not allowed */
+        BoundingVolumeGroup& operator=(BoundingVolumeGroup&&) = delete;
+
+        /** @brief Count of volumes in the group */
+        std::size_t size() const { return _volumes.size(); }
+
+        /**
+         * @brief Volume at given index
+         *
+         * Expects that @p id is less than @ref size().
+         */
+        BoundingVolume& operator[](std::size_t id);
+        const BoundingVolume& operator[](std::size_t id) const; /**< @overload */
+
+        /**
+         * @brief Bounding volume hierarchy
+         *
+         * Primitive indices correspond to @ref BoundingVolume::id(). Not
+         * up-to-date until @ref update() is called.
+         */
+        const BoundingVolumeHierarchy& hierarchy() const { return _hierarchy; }
+
+        /**
+         * @brief Update the hierarchy
+         * @return Reference to self (for method chaining)
+         *
+         * If volumes were added or removed since last call, cleans all
+         * objects and rebuilds the whole hierarchy. Otherwise cleans only
+         * objects of volumes marked as dirty, updates their world bounds and
+         * refits the hierarchy. Does nothing if nothing changed.
+         */
+        BoundingVolumeGroup& update();
+
+        /**
+         * @brief Rebuild the hierarchy from scratch on next @ref update()
+         * @return Reference to self (for method chaining)
+         *
+         * Useful when the volumes moved significantly and the refitted
+         * hierarchy is no longer efficient.
+         */
+        BoundingVolumeGroup& setRebuildNeeded() {
+            _rebuildNeeded = true;
+            return *this;
+        }
+
+    private:
+        std::vector<BoundingVolume*> _volumes;
+        std::vector<UnsignedInt> _dirtyVolumes;
+        BoundingVolumeHierarchy _hierarchy;
+        UnsignedInt _maxLeafSize;
+        bool _rebuildNeeded;
+};
+
+}}
+
+#endif
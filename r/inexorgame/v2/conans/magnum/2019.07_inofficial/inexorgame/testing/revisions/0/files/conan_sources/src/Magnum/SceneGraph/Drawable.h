@@ -29,6 +29,8 @@
  * @brief Class @ref Magnum::SceneGraph::Drawable, @ref Magnum::SceneGraph::DrawableGroup, alias @ref Magnum::SceneGraph::BasicDrawable2D, @ref Magnum::SceneGraph::BasicDrawable3D, @ref Magnum::SceneGraph::BasicDrawableGroup2D, @ref Magnum::SceneGraph::BasicDrawableGroup3D, typedef @ref Magnum::SceneGraph::Drawable2D, @ref Magnum::SceneGraph::Drawable3D, @ref Magnum::SceneGraph::DrawableGroup2D, @ref Magnum::SceneGraph::DrawableGroup3D
  */
 
+#include "Magnum/DimensionTraits.h"
+#include "Magnum/Math/Range.h"
 #include "Magnum/SceneGraph/AbstractGroupedFeature.h"
 
 namespace Magnum { namespace SceneGraph {
@@ -167,6 +169,65 @@ template<UnsignedInt dimensions, class T> class Drawable: public AbstractGrouped
             return AbstractGroupedFeature<dimensions, Drawable<dimensions, T>, T>::group();
         }
 
+        /**
+         * @brief Whether the drawable has bounds
+         *
+         * Drawables without bounds are never culled. Bounds are not set by
+         * default.
+         * @see @ref setBoundingSphere(), @ref setBoundingBox(),
+         *      @ref culledDrawableTransformations()
+         */
+        bool hasBounds() const { return _boundingRadius >= T(0); }
+
+        /**
+         * @brief Bounding volume center
+         *
+         * Relative to the object the drawable is attached to.
+         */
+        VectorTypeFor<dimensions, T> boundingCenter() const { return _boundingCenter; }
+
+        /**
+         * @brief Bounding box half-extents
+         *
+         * Zero if the bounds were set with @ref setBoundingSphere().
+         */
+        VectorTypeFor<dimensions, T> boundingExtents() const { return _boundingExtents; }
+
+        /**
+         * @brief Bounding sphere radius
+         *
+         * Zero if the bounds were set with @ref setBoundingBox(), negative if
+         * no bounds are set.
+         */
+        T boundingRadius() const { return _boundingRadius; }
+
+        /**
+         * @brief Set bounding sphere
+         * @return Reference to self (for method chaining)
+         *
+         * The sphere is relative to the object the drawable is attached to.
+         * Expects that @p radius is not negative.
+         * @see @ref setBoundingBox(), @ref resetBounds()
+         */
+        Drawable<dimensions, T>& setBoundingSphere(const VectorTypeFor<dimensions, T>& center, T radius);
+
+        /**
+         * @brief Set bounding box
+         * @return Reference to self (for method chaining)
+         *
+         * The box is relative to the object the drawable is attached to.
+         * @see @ref setBoundingSphere(), @ref resetBounds()
+         */
+        Drawable<dimensions, T>& setBoundingBox(const RangeTypeFor<dimensions, T>& box);
+
+        /**
+         * @brief Reset bounds
+         * @return Reference to self (for method chaining)
+         *
+         * The drawable is then never culled.
+         */
+        Drawable<dimensions, T>& resetBounds();
+
         /**
          * @brief Draw the object using given camera
          * @param transformationMatrix  Object transformation relative to camera
@@ -176,6 +237,10 @@ template<UnsignedInt dimensions, class T> class Drawable: public AbstractGrouped
          * @ref SceneGraph::Camera::projectionMatrix() "Camera::projectionMatrix()".
          */
         virtual void draw(const MatrixTypeFor<dimensions, T>& transformationMatrix, Camera<dimensions, T>& camera) = 0;
+
+    private:
+        VectorTypeFor<dimensions, T> _boundingCenter, _boundingExtents;
+        T _boundingRadius;
 };
 
 /**
@@ -29,11 +29,36 @@
  * @brief @ref compilation-speedup-hpp "Template implementation" for @ref Drawable.h
  */
 
+#include <Corrade/Utility/Assert.h>
+
 #include "Magnum/SceneGraph/Drawable.h"
 
 namespace Magnum { namespace SceneGraph {
 
-template<UnsignedInt dimensions, class T> Drawable<dimensions, T>::Drawable(AbstractObject<dimensions, T>& object, DrawableGroup<dimensions, T>* drawables): AbstractGroupedFeature<dimensions, Drawable<dimensions, T>, T>(object, drawables) {}
+template<UnsignedInt dimensions, class T> Drawable<dimensions, T>::Drawable(AbstractObject<dimensions, T>& object, DrawableGroup<dimensions, T>* drawables): AbstractGroupedFeature<dimensions, Drawable<dimensions, T>, T>(object, drawables), _boundingRadius{T(-1)} {}
+
+template<UnsignedInt dimensions, class T> Drawable<dimensions, T>& Drawable<dimensions, T>::setBoundingSphere(const VectorTypeFor<dimensions, T>& center, const T radius) {
+    CORRADE_ASSERT(radius >= T(0),
+        "SceneGraph::Drawable::setBoundingSphere(): expected non-negative radius, got" << radius, *this);
+    _boundingCenter = center;
+    _boundingExtents = {};
+    _boundingRadius = radius;
+    return *this;
+}
+
+template<UnsignedInt dimensions, class T> Drawable<dimensions, T>& Drawable<dimensions, T>::setBoundingBox(const RangeTypeFor<dimensions, T>& box) {
+    _boundingCenter = box.center();
+    _boundingExtents = box.size()*T(0.5);
+    _boundingRadius = T(0);
+    return *this;
+}
+
+template<UnsignedInt dimensions, class T> Drawable<dimensions, T>& Drawable<dimensions, T>::resetBounds() {
+    _boundingCenter = {};
+    _boundingExtents = {};
+    _boundingRadius = T(-1);
+    return *this;
+}
 
 }}
 
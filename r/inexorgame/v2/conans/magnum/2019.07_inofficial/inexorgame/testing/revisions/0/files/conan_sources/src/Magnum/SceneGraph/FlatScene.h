@@ -0,0 +1,287 @@
+#ifndef Magnum_SceneGraph_FlatScene_h
+#define Magnum_SceneGraph_FlatScene_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::FlatScene, alias @ref Magnum::SceneGraph::BasicFlatScene2D, @ref Magnum::SceneGraph::BasicFlatScene3D, typedef @ref Magnum::SceneGraph::FlatScene2D, @ref Magnum::SceneGraph::FlatScene3D
+ */
+
+#include <vector>
+#include <Corrade/Containers/StridedArrayView.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/DimensionTraits.h"
+#include "Magnum/Math/Matrix3.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/SceneGraph/SceneGraph.h"
+#include "Magnum/SceneGraph/visibility.h"
+
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Flat scene with index-based hierarchy
+
+An alternative to the @ref Object / @ref Scene hierarchy meant for scenes with
+a large number of objects. Instead of each object being a separate
+heap-allocated instance linked to its parent and siblings, the objects are
+just indices into contiguous arrays of parent indices, local transformation
+matrices and cached absolute transformation matrices. The arrays are sorted so
+a parent always comes before its children, which is ensured by
+@ref addObject() accepting only already existing objects as parents.
+
+The dirty state is a bitset with one bit per object. @ref setDirty() sets a
+bit and remembers the first dirty object, @ref setClean() then recomputes
+absolute transformations of all dirty objects and their descendants in a
+single linear pass starting at the first dirty object --- because of the
+ordering, parent absolute transformation is always updated before it's used
+by its children.
+
+@code{.cpp}
+SceneGraph::FlatScene3D scene;
+UnsignedInt car = scene.addObject(SceneGraph::FlatScene3D::NoParent,
+    Matrix4::translation({5.0f, 0.0f, 0.0f}));
+UnsignedInt wheel = scene.addObject(car, Matrix4::translation({1.0f, -0.5f, 0.0f}));
+
+// each frame
+scene.setTransformation(car, Matrix4::translation({6.0f, 0.0f, 0.0f}))
+    .setClean();
+Matrix4 wheelTransformation = scene.absoluteTransformation(wheel);
+@endcode
+
+Compared to @ref Camera::drawableTransformations(), which builds vectors of
+references and walks the parent chain of each object,
+@ref cameraTransformationsInto() only multiplies already cached absolute
+transformations with the camera matrix into a caller-provided view.
+
+@section SceneGraph-FlatScene-explicit-specializations Explicit template specializations
+
+The following specializations are explicitly compiled into @ref SceneGraph
+library. For other specializations (e.g. using @ref Magnum::Double "Double"
+type) you have to use @ref FlatScene.hpp implementation file to avoid linker
+errors. See also @ref compilation-speedup-hpp for more information.
+
+-   @ref FlatScene2D
+-   @ref FlatScene3D
+
+@see @ref scenegraph, @ref BasicFlatScene2D, @ref BasicFlatScene3D
+*/
+template<UnsignedInt dimensions, class T> class FlatScene {
+    public:
+        /** @brief Matrix type */
+        typedef MatrixTypeFor<dimensions, T> MatrixType;
+
+        /**
+         * @brief Parent index of root objects
+         *
+         * @see @ref addObject(), @ref parent()
+         */
+        enum: UnsignedInt { NoParent = ~UnsignedInt{} };
+
+        /**
+         * @brief Constructor
+         *
+         * Creates an empty scene.
+         */
+        explicit FlatScene();
+
+        /** @brief Object count */
+        std::size_t size() const { return _parents.size(); }
+
+        /**
+         * @brief Reserve memory for given object count
+         * @return Reference to self (for method chaining)
+         */
+        FlatScene<dimensions, T>& reserve(std::size_t size);
+
+        /**
+         * @brief Add an object
+         * @param parent            Parent object index or @ref NoParent
+         * @param transformation    Local transformation
+         * @return Index of the new object
+         *
+         * The @p parent is expected to be either @ref NoParent or less than
+         * @ref size(). The object is marked as dirty.
+         */
+        UnsignedInt addObject(UnsignedInt parent, const MatrixType& transformation = MatrixType{});
+
+        /**
+         * @brief Remove all objects
+         * @return Reference to self (for method chaining)
+         */
+        FlatScene<dimensions, T>& clear();
+
+        /**
+         * @brief Parent indices
+         *
+         * Each value is either @ref NoParent or less than its own index.
+         */
+        Containers::ArrayView<const UnsignedInt> parents() const {
+            return {_parents.data(), _parents.size()};
+        }
+
+        /**
+         * @brief Parent index
+         *
+         * Expects that @p object is less than @ref size().
+         */
+        UnsignedInt parent(UnsignedInt object) const;
+
+        /** @brief Local transformations */
+        Containers::ArrayView<const MatrixType> transformations() const {
+            return {_transformations.data(), _transformations.size()};
+        }
+
+        /**
+         * @brief Local transformation
+         *
+         * Expects that @p object is less than @ref size().
+         */
+        MatrixType transformation(UnsignedInt object) const;
+
+        /**
+         * @brief Set local transformation
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @p object is less than @ref size(). Marks the object
+         * as dirty.
+         */
+        FlatScene<dimensions, T>& setTransformation(UnsignedInt object, const MatrixType& transformation);
+
+        /**
+         * @brief Whether absolute transformation of given object is dirty
+         *
+         * Returns @cpp true @ce if the object or any of its parents was marked
+         * as dirty since last call to @ref setClean(). Expects that @p object
+         * is less than @ref size().
+         */
+        bool isDirty(UnsignedInt object) const;
+
+        /**
+         * @brief Set object absolute transformation as dirty
+         * @return Reference to self (for method chaining)
+         *
+         * Sets a bit in the dirty bitset, dirty state of the object children
+         * is implicit. Expects that @p object is less than @ref size().
+         */
+        FlatScene<dimensions, T>& setDirty(UnsignedInt object);
+
+        /**
+         * @brief Clean absolute transformations of all dirty objects
+         * @return Reference to self (for method chaining)
+         *
+         * Recomputes absolute transformation of all objects that are dirty
+         * or have a dirty ancestor in a single pass and clears the dirty
+         * bitset. Does nothing if no object is dirty.
+         */
+        FlatScene<dimensions, T>& setClean();
+
+        /**
+         * @brief Absolute transformations
+         *
+         * Values for objects that are dirty are not up-to-date, call
+         * @ref setClean() first.
+         */
+        Containers::ArrayView<const MatrixType> absoluteTransformations() const {
+            return {_absoluteTransformations.data(), _absoluteTransformations.size()};
+        }
+
+        /**
+         * @brief Absolute transformation
+         *
+         * Expects that @p object is less than @ref size(). The value is not
+         * up-to-date if the object is dirty, call @ref setClean() first.
+         */
+        MatrixType absoluteTransformation(UnsignedInt object) const;
+
+        /**
+         * @brief Transformations relative to camera
+         * @param[in] cameraMatrix  Camera matrix
+         * @param[in] objects       Object indices
+         * @param[out] out          Where to put the transformations
+         *
+         * Cleans the dirty objects and fills @p out with
+         * @cpp cameraMatrix*absoluteTransformation(objects[i]) @ce. Expects
+         * that @p out has the same size as @p objects and all indices are
+         * less than @ref size(). Does no allocation.
+         */
+        void cameraTransformationsInto(const MatrixType& cameraMatrix, Containers::ArrayView<const UnsignedInt> objects, const Containers::StridedArrayView1D<MatrixType>& out);
+
+    private:
+        bool isDirtyBit(UnsignedInt object) const {
+            return _dirty[object >> 5] & (1u << (object & 31));
+        }
+
+        std::vector<UnsignedInt> _parents;
+        std::vector<MatrixType> _transformations;
+        std::vector<MatrixType> _absoluteTransformations;
+        std::vector<UnsignedInt> _dirty;
+        std::size_t _firstDirty;
+};
+
+/**
+@brief Flat scene for two-dimensional scenes
+
+Convenience alternative to @cpp FlatScene<2, T> @ce. See @ref FlatScene for
+more information.
+@see @ref FlatScene2D, @ref BasicFlatScene3D
+*/
+#ifndef CORRADE_MSVC2015_COMPATIBILITY /* Multiple definitions still broken */
+template<class T> using BasicFlatScene2D = FlatScene<2, T>;
+#endif
+
+/**
+@brief Flat scene for two-dimensional float scenes
+
+@see @ref FlatScene3D
+*/
+typedef BasicFlatScene2D<Float> FlatScene2D;
+
+/**
+@brief Flat scene for three-dimensional scenes
+
+Convenience alternative to @cpp FlatScene<3, T> @ce. See @ref FlatScene for
+more information.
+@see @ref FlatScene3D, @ref BasicFlatScene2D
+*/
+#ifndef CORRADE_MSVC2015_COMPATIBILITY /* Multiple definitions still broken */
+template<class T> using BasicFlatScene3D = FlatScene<3, T>;
+#endif
+
+/**
+@brief Flat scene for three-dimensional float scenes
+
+@see @ref FlatScene2D
+*/
+typedef BasicFlatScene3D<Float> FlatScene3D;
+
+#if defined(CORRADE_TARGET_WINDOWS) && !defined(__MINGW32__)
+extern template class MAGNUM_SCENEGRAPH_EXPORT FlatScene<2, Float>;
+extern template class MAGNUM_SCENEGRAPH_EXPORT FlatScene<3, Float>;
+#endif
+
+}}
+
+#endif
@@ -0,0 +1,154 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief @ref compilation-speedup-hpp "Template implementation" for @ref FlatScene.h
+ */
+
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/SceneGraph/FlatScene.h"
+
+namespace Magnum { namespace SceneGraph {
+
+template<UnsignedInt dimensions, class T> FlatScene<dimensions, T>::FlatScene(): _firstDirty{0} {}
+
+template<UnsignedInt dimensions, class T> FlatScene<dimensions, T>& FlatScene<dimensions, T>::reserve(const std::size_t size) {
+    _parents.reserve(size);
+    _transformations.reserve(size);
+    _absoluteTransformations.reserve(size);
+    _dirty.reserve((size + 31)/32);
+    return *this;
+}
+
+template<UnsignedInt dimensions, class T> UnsignedInt FlatScene<dimensions, T>::addObject(const UnsignedInt parent, const MatrixType& transformation) {
+    CORRADE_ASSERT(parent == NoParent || parent < _parents.size(),
+        "SceneGraph::FlatScene::addObject(): parent index" << parent << "out of range for" << _parents.size() << "objects", {});
+
+    const UnsignedInt object = _parents.size();
+    _parents.push_back(parent);
+    _transformations.push_back(transformation);
+    _absoluteTransformations.emplace_back();
+    if(!(object & 31)) _dirty.push_back(0);
+    setDirty(object);
+    return object;
+}
+
+template<UnsignedInt dimensions, class T> FlatScene<dimensions, T>& FlatScene<dimensions, T>::clear() {
+    _parents.clear();
+    _transformations.clear();
+    _absoluteTransformations.clear();
+    _dirty.clear();
+    _firstDirty = 0;
+    return *this;
+}
+
+template<UnsignedInt dimensions, class T> UnsignedInt FlatScene<dimensions, T>::parent(const UnsignedInt object) const {
+    CORRADE_ASSERT(object < _parents.size(),
+        "SceneGraph::FlatScene::parent(): index" << object << "out of range for" << _parents.size() << "objects", {});
+    return _parents[object];
+}
+
+template<UnsignedInt dimensions, class T> auto FlatScene<dimensions, T>::transformation(const UnsignedInt object) const -> MatrixType {
+    CORRADE_ASSERT(object < _parents.size(),
+        "SceneGraph::FlatScene::transformation(): index" << object << "out of range for" << _parents.size() << "objects", {});
+    return _transformations[object];
+}
+
+template<UnsignedInt dimensions, class T> FlatScene<dimensions, T>& FlatScene<dimensions, T>::setTransformation(const UnsignedInt object, const MatrixType& transformation) {
+    CORRADE_ASSERT(object < _parents.size(),
+        "SceneGraph::FlatScene::setTransformation(): index" << object << "out of range for" << _parents.size() << "objects", *this);
+    _transformations[object] = transformation;
+    return setDirty(object);
+}
+
+template<UnsignedInt dimensions, class T> bool FlatScene<dimensions, T>::isDirty(UnsignedInt object) const {
+    CORRADE_ASSERT(object < _parents.size(),
+        "SceneGraph::FlatScene::isDirty(): index" << object << "out of range for" << _parents.size() << "objects", {});
+
+    /* Nothing before the first dirty object can be dirty */
+    for(; object != NoParent && object >= _firstDirty; object = _parents[object])
+        if(isDirtyBit(object)) return true;
+    return false;
+}
+
+template<UnsignedInt dimensions, class T> FlatScene<dimensions, T>& FlatScene<dimensions, T>::setDirty(const UnsignedInt object) {
+    CORRADE_ASSERT(object < _parents.size(),
+        "SceneGraph::FlatScene::setDirty(): index" << object << "out of range for" << _parents.size() << "objects", *this);
+    _dirty[object >> 5] |= 1u << (object & 31);
+    if(object < _firstDirty) _firstDirty = object;
+    return *this;
+}
+
+template<UnsignedInt dimensions, class T> FlatScene<dimensions, T>& FlatScene<dimensions, T>::setClean() {
+    const std::size_t size = _parents.size();
+    if(_firstDirty >= size) return *this;
+
+    /* Parents are always before children, so by the time a child is
+       reached, parent absolute transformation is up-to-date and its dirty
+       bit says whether the child needs to be updated as well. Propagating
+       the bit to the child then handles the whole subtree. */
+    const UnsignedInt* const parents = _parents.data();
+    const MatrixType* const transformations = _transformations.data();
+    MatrixType* const absoluteTransformations = _absoluteTransformations.data();
+    UnsignedInt* const dirty = _dirty.data();
+    for(std::size_t i = _firstDirty; i != size; ++i) {
+        const UnsignedInt parent = parents[i];
+        if(parent == NoParent) {
+            if(dirty[i >> 5] & (1u << (i & 31)))
+                absoluteTransformations[i] = transformations[i];
+        } else if(dirty[i >> 5] & (1u << (i & 31)) || dirty[parent >> 5] & (1u << (parent & 31))) {
+            absoluteTransformations[i] = absoluteTransformations[parent]*transformations[i];
+            dirty[i >> 5] |= 1u << (i & 31);
+        }
+    }
+
+    for(std::size_t i = _firstDirty >> 5, end = _dirty.size(); i != end; ++i)
+        dirty[i] = 0;
+    _firstDirty = size;
+    return *this;
+}
+
+template<UnsignedInt dimensions, class T> auto FlatScene<dimensions, T>::absoluteTransformation(const UnsignedInt object) const -> MatrixType {
+    CORRADE_ASSERT(object < _parents.size(),
+        "SceneGraph::FlatScene::absoluteTransformation(): index" << object << "out of range for" << _parents.size() << "objects", {});
+    return _absoluteTransformations[object];
+}
+
+template<UnsignedInt dimensions, class T> void FlatScene<dimensions, T>::cameraTransformationsInto(const MatrixType& cameraMatrix, const Containers::ArrayView<const UnsignedInt> objects, const Containers::StridedArrayView1D<MatrixType>& out) {
+    CORRADE_ASSERT(objects.size() == out.size(),
+        "SceneGraph::FlatScene::cameraTransformationsInto(): expected output view size" << objects.size() << "but got" << out.size(), );
+
+    setClean();
+
+    const MatrixType* const absoluteTransformations = _absoluteTransformations.data();
+    for(std::size_t i = 0; i != objects.size(); ++i) {
+        CORRADE_ASSERT(objects[i] < _parents.size(),
+            "SceneGraph::FlatScene::cameraTransformationsInto(): index" << objects[i] << "out of range for" << _parents.size() << "objects", );
+        out[i] = cameraMatrix*absoluteTransformations[objects[i]];
+    }
+}
+
+}}
@@ -0,0 +1,208 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "FrustumCulling.h"
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/Math/Constants.h"
+#include "Magnum/Math/Frustum.h"
+#include "Magnum/SceneGraph/Camera.h"
+#include "Magnum/SceneGraph/Drawable.h"
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define MAGNUM_SCENEGRAPH_CULL_AVX
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MAGNUM_SCENEGRAPH_CULL_SSE2
+#endif
+
+namespace Magnum { namespace SceneGraph {
+
+namespace {
+
+/* Eight volumes in SoA layout */
+struct alignas(32) Batch {
+    Float cx[8], cy[8], cz[8], ex[8], ey[8], ez[8], r[8];
+};
+
+/* Plane with precomputed absolute value of the normal, splatted to be usable
+   directly by the vector code */
+struct Plane {
+    Float nx, ny, nz, ax, ay, az, w;
+};
+
+/* Returns bitmask of visible volumes in the batch */
+UnsignedInt cullBatch(const Batch& batch, const Plane(&planes)[6]) {
+    #if defined(MAGNUM_SCENEGRAPH_CULL_AVX)
+    const __m256 cx = _mm256_load_ps(batch.cx);
+    const __m256 cy = _mm256_load_ps(batch.cy);
+    const __m256 cz = _mm256_load_ps(batch.cz);
+    const __m256 ex = _mm256_load_ps(batch.ex);
+    const __m256 ey = _mm256_load_ps(batch.ey);
+    const __m256 ez = _mm256_load_ps(batch.ez);
+    const __m256 r = _mm256_load_ps(batch.r);
+    __m256 outside = _mm256_setzero_ps();
+    for(const Plane& p: planes) {
+        /* Signed distance of the center plus projected radius of the
+           volume onto the plane normal, negative if the volume is
+           completely behind the plane */
+        __m256 d = _mm256_add_ps(_mm256_mul_ps(cx, _mm256_set1_ps(p.nx)), _mm256_set1_ps(p.w));
+        d = _mm256_add_ps(d, _mm256_mul_ps(cy, _mm256_set1_ps(p.ny)));
+        d = _mm256_add_ps(d, _mm256_mul_ps(cz, _mm256_set1_ps(p.nz)));
+        d = _mm256_add_ps(d, r);
+        d = _mm256_add_ps(d, _mm256_mul_ps(ex, _mm256_set1_ps(p.ax)));
+        d = _mm256_add_ps(d, _mm256_mul_ps(ey, _mm256_set1_ps(p.ay)));
+        d = _mm256_add_ps(d, _mm256_mul_ps(ez, _mm256_set1_ps(p.az)));
+        outside = _mm256_or_ps(outside, _mm256_cmp_ps(d, _mm256_setzero_ps(), _CMP_LT_OQ));
+    }
+    return ~UnsignedInt(_mm256_movemask_ps(outside)) & 0xff;
+    #elif defined(MAGNUM_SCENEGRAPH_CULL_SSE2)
+    UnsignedInt visible = 0;
+    for(std::size_t half = 0; half != 8; half += 4) {
+        const __m128 cx = _mm_load_ps(batch.cx + half);
+        const __m128 cy = _mm_load_ps(batch.cy + half);
+        const __m128 cz = _mm_load_ps(batch.cz + half);
+        const __m128 ex = _mm_load_ps(batch.ex + half);
+        const __m128 ey = _mm_load_ps(batch.ey + half);
+        const __m128 ez = _mm_load_ps(batch.ez + half);
+        const __m128 r = _mm_load_ps(batch.r + half);
+        __m128 outside = _mm_setzero_ps();
+        for(const Plane& p: planes) {
+            __m128 d = _mm_add_ps(_mm_mul_ps(cx, _mm_set1_ps(p.nx)), _mm_set1_ps(p.w));
+            d = _mm_add_ps(d, _mm_mul_ps(cy, _mm_set1_ps(p.ny)));
+            d = _mm_add_ps(d, _mm_mul_ps(cz, _mm_set1_ps(p.nz)));
+            d = _mm_add_ps(d, r);
+            d = _mm_add_ps(d, _mm_mul_ps(ex, _mm_set1_ps(p.ax)));
+            d = _mm_add_ps(d, _mm_mul_ps(ey, _mm_set1_ps(p.ay)));
+            d = _mm_add_ps(d, _mm_mul_ps(ez, _mm_set1_ps(p.az)));
+            outside = _mm_or_ps(outside, _mm_cmplt_ps(d, _mm_setzero_ps()));
+        }
+        visible |= (~UnsignedInt(_mm_movemask_ps(outside)) & 0xf) << half;
+    }
+    return visible;
+    #else
+    UnsignedInt visible = 0;
+    for(std::size_t i = 0; i != 8; ++i) {
+        bool outside = false;
+        for(const Plane& p: planes) {
+            /* Same operation order as the vector variants */
+            const Float d = batch.cx[i]*p.nx + p.w + batch.cy[i]*p.ny + batch.cz[i]*p.nz + batch.r[i] + batch.ex[i]*p.ax + batch.ey[i]*p.ay + batch.ez[i]*p.az;
+            outside = outside || d < 0.0f;
+        }
+        if(!outside) visible |= 1 << i;
+    }
+    return visible;
+    #endif
+}
+
+}
+
+void frustumCullInto(const Frustum& frustum, const Containers::StridedArrayView1D<const Vector3>& centers, const Containers::StridedArrayView1D<const Vector3>& extents, const Containers::StridedArrayView1D<const Float>& radii, const Containers::StridedArrayView1D<bool>& visible) {
+    CORRADE_ASSERT(centers.size() == visible.size() && extents.size() == visible.size() && radii.size() == visible.size(),
+        "SceneGraph::frustumCullInto(): expected all views to have the same size but got" << centers.size() << Debug::nospace << "," << extents.size() << Debug::nospace << "," << radii.size() << "and" << visible.size(), );
+
+    /* Normalize the planes so the radius can be compared with the distance
+       directly. Degenerate planes are made to never cull anything. */
+    Plane planes[6];
+    for(std::size_t i = 0; i != 6; ++i) {
+        const Vector4& plane = frustum[i];
+        const Float length = plane.xyz().length();
+        const Vector4 normalized = length > 0.0f ? plane/length : Vector4{0.0f, 0.0f, 0.0f, 1.0f};
+        planes[i] = {normalized.x(), normalized.y(), normalized.z(),
+            Math::abs(normalized.x()), Math::abs(normalized.y()), Math::abs(normalized.z()), normalized.w()};
+    }
+
+    Batch batch;
+    for(std::size_t begin = 0; begin < visible.size(); begin += 8) {
+        const std::size_t count = visible.size() - begin < 8 ? visible.size() - begin : 8;
+
+        /* Pack the batch, zero the unused tail */
+        for(std::size_t i = 0; i != 8; ++i) {
+            const bool used = i < count;
+            const Vector3 c = used ? centers[begin + i] : Vector3{};
+            const Vector3 e = used ? extents[begin + i] : Vector3{};
+            batch.cx[i] = c.x();
+            batch.cy[i] = c.y();
+            batch.cz[i] = c.z();
+            batch.ex[i] = e.x();
+            batch.ey[i] = e.y();
+            batch.ez[i] = e.z();
+            batch.r[i] = used ? radii[begin + i] : 0.0f;
+        }
+
+        const UnsignedInt mask = cullBatch(batch, planes);
+        for(std::size_t i = 0; i != count; ++i)
+            visible[begin + i] = mask & (1 << i);
+    }
+}
+
+std::vector<std::pair<std::reference_wrapper<Drawable3D>, Matrix4>> culledDrawableTransformations(Camera3D& camera, DrawableGroup3D& group) {
+    std::vector<std::pair<std::reference_wrapper<Drawable3D>, Matrix4>> transformations = camera.drawableTransformations(group);
+
+    /* Transform the bounds to camera space. For spheres the radius is scaled
+       by the largest axis scale, for boxes the new half-extents are the
+       extents of the transformed box (Arvo's method). */
+    Containers::Array<Vector3> centers{Containers::NoInit, transformations.size()};
+    Containers::Array<Vector3> extents{Containers::NoInit, transformations.size()};
+    Containers::Array<Float> radii{Containers::NoInit, transformations.size()};
+    for(std::size_t i = 0; i != transformations.size(); ++i) {
+        const Drawable3D& drawable = transformations[i].first;
+        const Matrix4& matrix = transformations[i].second;
+
+        /* Huge radius for drawables without bounds, so they're never
+           culled */
+        if(!drawable.hasBounds()) {
+            centers[i] = {};
+            extents[i] = {};
+            radii[i] = Constants::inf();
+            continue;
+        }
+
+        centers[i] = matrix.transformPoint(drawable.boundingCenter());
+        const Vector3 e = drawable.boundingExtents();
+        extents[i] = Math::abs(matrix[0].xyz())*e.x() +
+                     Math::abs(matrix[1].xyz())*e.y() +
+                     Math::abs(matrix[2].xyz())*e.z();
+        radii[i] = drawable.boundingRadius()*Math::sqrt(Math::max(Math::max(
+            matrix[0].xyz().dot(), matrix[1].xyz().dot()), matrix[2].xyz().dot()));
+    }
+
+    Containers::Array<bool> visible{Containers::NoInit, transformations.size()};
+    frustumCullInto(Frustum::fromMatrix(camera.projectionMatrix()), centers, extents, radii, visible);
+
+    /* Remove the invisible drawables, keeping the order */
+    std::size_t out = 0;
+    for(std::size_t i = 0; i != transformations.size(); ++i)
+        if(visible[i]) transformations[out++] = transformations[i];
+    transformations.erase(transformations.begin() + out, transformations.end());
+    return transformations;
+}
+
+}}
@@ -0,0 +1,81 @@
+#ifndef Magnum_SceneGraph_FrustumCulling_h
+#define Magnum_SceneGraph_FrustumCulling_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::SceneGraph::frustumCullInto(), @ref Magnum::SceneGraph::culledDrawableTransformations()
+ */
+
+#include <functional>
+#include <utility>
+#include <vector>
+#include <Corrade/Containers/StridedArrayView.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/SceneGraph/SceneGraph.h"
+#include "Magnum/SceneGraph/visibility.h"
+
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Test bounding volumes against a frustum
+@param[in] frustum  Frustum, e.g. created with @ref Math::Frustum::fromMatrix()
+@param[in] centers  Bounding volume centers
+@param[in] extents  Bounding box half-extents
+@param[in] radii    Bounding sphere radii
+@param[out] visible Where to put the visibility
+
+Each volume is a box with given half-extents enlarged by given radius, which
+means a sphere has zero @p extents and a box has zero @p radii. Volumes that
+are completely behind any of the frustum planes are marked as not visible,
+the others as visible --- as with @ref Math::Intersection::aabbFrustum(), the
+test is conservative and some volumes near frustum corners may be reported
+as visible even though they're outside.
+
+The volumes are processed in batches of eight, with the plane tests done
+using AVX, two SSE2 operations or a scalar fallback, depending on what
+instruction set the library is compiled for. All views are expected to have
+the same size.
+*/
+void MAGNUM_SCENEGRAPH_EXPORT frustumCullInto(const Frustum& frustum, const Containers::StridedArrayView1D<const Vector3>& centers, const Containers::StridedArrayView1D<const Vector3>& extents, const Containers::StridedArrayView1D<const Float>& radii, const Containers::StridedArrayView1D<bool>& visible);
+
+/**
+@brief Transformations of visible drawables in the group relative to the camera
+
+Equivalent to @ref Camera::drawableTransformations(), but returns only the
+drawables that are at least partially inside the camera frustum. The frustum
+is calculated from @ref Camera::projectionMatrix() and the bounds set on
+each drawable using @ref Drawable::setBoundingSphere() or
+@ref Drawable::setBoundingBox() are transformed to camera space using its
+transformation, then tested with @ref frustumCullInto(). Drawables without
+bounds are always returned. The result can be passed to
+@ref Camera::draw(const std::vector<std::pair<std::reference_wrapper<Drawable<dimensions, T>>, MatrixTypeFor<dimensions, T>>>&).
+*/
+std::vector<std::pair<std::reference_wrapper<Drawable3D>, Matrix4>> MAGNUM_SCENEGRAPH_EXPORT culledDrawableTransformations(Camera3D& camera, DrawableGroup3D& group);
+
+}}
+
+#endif
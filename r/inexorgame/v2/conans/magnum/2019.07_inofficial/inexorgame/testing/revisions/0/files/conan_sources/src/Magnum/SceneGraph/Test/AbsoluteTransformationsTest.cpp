@@ -0,0 +1,221 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstring>
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/SceneGraph/AbsoluteTransformations.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/Scene.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test { namespace {
+
+using namespace Math::Literals;
+
+typedef Object<MatrixTransformation3D> Object3D;
+typedef Scene<MatrixTransformation3D> Scene3D;
+
+struct AbsoluteTransformationsTest: TestSuite::Tester {
+    explicit AbsoluteTransformationsTest();
+
+    void serial();
+    void parallel();
+    void parallelReverseOrder();
+    void parallelDuplicatesAndAncestors();
+    void empty();
+    void wrongOutputSize();
+
+    void matrices();
+    void drawables();
+
+    private:
+        Scene3D _scene;
+        std::vector<std::reference_wrapper<Object3D>> _leaves;
+        std::vector<Matrix4> _expected;
+};
+
+const struct {
+    const char* name;
+    UnsignedInt threadCount;
+} ParallelData[]{
+    {"two threads", 2},
+    {"four threads", 4},
+    {"all threads", 0},
+    /* Not enough objects for this many threads, gets clamped */
+    {"1000 threads", 1000}
+};
+
+const Matrix4 InitialTransformation = Matrix4::translation({0.0f, 0.0f, -10.0f});
+
+AbsoluteTransformationsTest::AbsoluteTransformationsTest() {
+    addTests({&AbsoluteTransformationsTest::serial});
+
+    addInstancedTests({&AbsoluteTransformationsTest::parallel,
+                       &AbsoluteTransformationsTest::parallelReverseOrder},
+        Containers::arraySize(ParallelData));
+
+    addTests({&AbsoluteTransformationsTest::parallelDuplicatesAndAncestors,
+              &AbsoluteTransformationsTest::empty,
+              &AbsoluteTransformationsTest::wrongOutputSize,
+
+              &AbsoluteTransformationsTest::matrices,
+              &AbsoluteTransformationsTest::drawables});
+
+    /* A wide hierarchy, 8 + 8*8 + 8*8*64 objects. That's enough to get split
+       among four threads, the last level being split into four chunks. */
+    for(std::size_t i = 0; i != 8; ++i) {
+        Object3D* a = new Object3D{&_scene};
+        a->rotateY(Deg(45.0f*i)).translate(Vector3::xAxis(10.0f));
+        for(std::size_t j = 0; j != 8; ++j) {
+            Object3D* b = new Object3D{a};
+            b->rotateX(Deg(30.0f*j)).scale(Vector3{1.5f});
+            for(std::size_t k = 0; k != 64; ++k) {
+                Object3D* c = new Object3D{b};
+                c->translate({0.1f*k, 0.0f, 0.0f}).rotateZ(Deg(5.0f*k));
+                _leaves.push_back(*c);
+
+                /* Composed top-down the same way as the tested function
+                   does it */
+                _expected.push_back(InitialTransformation*a->transformation()*b->transformation()*c->transformation());
+            }
+        }
+    }
+}
+
+void AbsoluteTransformationsTest::serial() {
+    std::vector<Matrix4> out(_leaves.size());
+    absoluteTransformationsInto(_leaves, Containers::StridedArrayView1D<Matrix4>{Containers::arrayView(out.data(), out.size())}, InitialTransformation);
+
+    CORRADE_COMPARE(out.size(), _expected.size());
+    for(std::size_t i = 0; i != out.size(); ++i)
+        CORRADE_COMPARE(out[i], _expected[i]);
+}
+
+void AbsoluteTransformationsTest::parallel() {
+    auto&& data = ParallelData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    std::vector<Matrix4> serial(_leaves.size());
+    absoluteTransformationsInto(_leaves, Containers::StridedArrayView1D<Matrix4>{Containers::arrayView(serial.data(), serial.size())}, InitialTransformation);
+
+    std::vector<Matrix4> out(_leaves.size());
+    absoluteTransformationsInto(_leaves, Containers::StridedArrayView1D<Matrix4>{Containers::arrayView(out.data(), out.size())}, InitialTransformation, data.threadCount);
+
+    for(std::size_t i = 0; i != out.size(); ++i)
+        CORRADE_COMPARE(out[i], _expected[i]);
+
+    /* The composition order is the same, so the result is bit-exact */
+    CORRADE_VERIFY(std::memcmp(out.data(), serial.data(), out.size()*sizeof(Matrix4)) == 0);
+}
+
+void AbsoluteTransformationsTest::parallelReverseOrder() {
+    auto&& data = ParallelData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    std::vector<std::reference_wrapper<Object3D>> objects{_leaves.rbegin(), _leaves.rend()};
+    std::vector<Matrix4> out(objects.size());
+    absoluteTransformationsInto(objects, Containers::StridedArrayView1D<Matrix4>{Containers::arrayView(out.data(), out.size())}, InitialTransformation, data.threadCount);
+
+    for(std::size_t i = 0; i != out.size(); ++i)
+        CORRADE_VERIFY(std::memcmp(&out[i], &_expected[out.size() - i - 1], sizeof(Matrix4)) == 0);
+}
+
+void AbsoluteTransformationsTest::parallelDuplicatesAndAncestors() {
+    /* Leaves interleaved with their ancestors, the scene itself and a leaf
+       listed twice */
+    std::vector<std::reference_wrapper<Object3D>> objects;
+    for(std::size_t i = 0; i != _leaves.size(); ++i) {
+        objects.push_back(_leaves[i]);
+        if(i % 64 == 0) objects.push_back(*_leaves[i].get().parent());
+    }
+    objects.push_back(_scene);
+    objects.push_back(_leaves[100]);
+
+    std::vector<Matrix4> serial(objects.size());
+    absoluteTransformationsInto(objects, Containers::StridedArrayView1D<Matrix4>{Containers::arrayView(serial.data(), serial.size())}, InitialTransformation);
+
+    std::vector<Matrix4> out(objects.size());
+    absoluteTransformationsInto(objects, Containers::StridedArrayView1D<Matrix4>{Containers::arrayView(out.data(), out.size())}, InitialTransformation, 4);
+
+    CORRADE_VERIFY(std::memcmp(out.data(), serial.data(), out.size()*sizeof(Matrix4)) == 0);
+    CORRADE_COMPARE(out[0], _expected[0]);
+    CORRADE_COMPARE(out[1], InitialTransformation*_leaves[0].get().parent()->parent()->transformation()*_leaves[0].get().parent()->transformation());
+    CORRADE_COMPARE(out[objects.size() - 2], InitialTransformation);
+    CORRADE_COMPARE(out[objects.size() - 1], _expected[100]);
+}
+
+void AbsoluteTransformationsTest::empty() {
+    absoluteTransformationsInto(std::vector<std::reference_wrapper<Object3D>>{}, nullptr, {}, 4);
+    CORRADE_VERIFY(true);
+}
+
+void AbsoluteTransformationsTest::wrongOutputSize() {
+    Matrix4 transformations[3];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    absoluteTransformationsInto(_leaves, Containers::StridedArrayView1D<Matrix4>{transformations}, {}, 4);
+    CORRADE_COMPARE(out.str(), "SceneGraph::absoluteTransformationsInto(): expected output view size 4096 but got 3\n");
+}
+
+void AbsoluteTransformationsTest::matrices() {
+    const std::vector<Matrix4> out = absoluteTransformationMatrices(_leaves, InitialTransformation, 4);
+
+    CORRADE_COMPARE(out.size(), _expected.size());
+    for(std::size_t i = 0; i != out.size(); ++i)
+        CORRADE_COMPARE(out[i], _expected[i]);
+}
+
+void AbsoluteTransformationsTest::drawables() {
+    struct Drawable3D: Drawable<3, Float> {
+        using Drawable<3, Float>::Drawable;
+
+        void draw(const Matrix4&, Camera<3, Float>&) override {}
+    };
+
+    Object3D cameraObject{&_scene};
+    cameraObject.translate(Vector3::zAxis(10.0f));
+    Camera<3, Float> camera{cameraObject};
+
+    DrawableGroup<3, Float> group;
+    for(Object3D& leaf: _leaves) new Drawable3D{leaf, &group};
+
+    const auto out = drawableTransformations<MatrixTransformation3D>(camera, group, 4);
+    CORRADE_COMPARE(out.size(), _leaves.size());
+    for(std::size_t i = 0; i != out.size(); ++i) {
+        CORRADE_COMPARE(&out[i].first.get(), &group[i]);
+        CORRADE_COMPARE(out[i].second, _expected[i]);
+    }
+
+    /* Delete the drawables so they don't stay attached to the objects for
+       the other test cases */
+    while(!group.isEmpty()) delete &group[0];
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::AbsoluteTransformationsTest)
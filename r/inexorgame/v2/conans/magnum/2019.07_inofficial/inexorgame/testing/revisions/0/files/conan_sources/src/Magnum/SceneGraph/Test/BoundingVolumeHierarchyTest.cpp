@@ -0,0 +1,378 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Frustum.h"
+#include "Magnum/Math/Intersection.h"
+#include "Magnum/SceneGraph/BoundingVolumeHierarchy.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/Scene.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test { namespace {
+
+using namespace Math::Literals;
+
+struct BoundingVolumeHierarchyTest: TestSuite::Tester {
+    explicit BoundingVolumeHierarchyTest();
+
+    void construct();
+    void buildEmpty();
+    void buildMaxLeafSizeOne();
+    void buildSamePosition();
+    void buildZeroMaxLeafSize();
+
+    void query();
+    void refit();
+    void setPrimitiveBoundsOutOfRange();
+
+    void group();
+    void groupRemoveVolume();
+    void groupIndexOutOfRange();
+};
+
+typedef Object<MatrixTransformation3D> Object3D;
+typedef Scene<MatrixTransformation3D> Scene3D;
+
+BoundingVolumeHierarchyTest::BoundingVolumeHierarchyTest() {
+    addTests({&BoundingVolumeHierarchyTest::construct,
+              &BoundingVolumeHierarchyTest::buildEmpty,
+              &BoundingVolumeHierarchyTest::buildMaxLeafSizeOne,
+              &BoundingVolumeHierarchyTest::buildSamePosition,
+              &BoundingVolumeHierarchyTest::buildZeroMaxLeafSize,
+
+              &BoundingVolumeHierarchyTest::query,
+              &BoundingVolumeHierarchyTest::refit,
+              &BoundingVolumeHierarchyTest::setPrimitiveBoundsOutOfRange,
+
+              &BoundingVolumeHierarchyTest::group,
+              &BoundingVolumeHierarchyTest::groupRemoveVolume,
+              &BoundingVolumeHierarchyTest::groupIndexOutOfRange});
+}
+
+/* Deterministic pseudo-random boxes scattered in a 100x100x100 cube */
+std::vector<Range3D> randomBoxes(const std::size_t count, UnsignedInt seed) {
+    const auto next = [&seed]() {
+        seed = seed*1664525u + 1013904223u;
+        return Float(seed >> 8)/Float(1 << 24);
+    };
+
+    std::vector<Range3D> boxes;
+    boxes.reserve(count);
+    for(std::size_t i = 0; i != count; ++i) {
+        const Vector3 min{next()*100.0f, next()*100.0f, next()*100.0f};
+        boxes.push_back({min, min + Vector3{next(), next(), next()}*4.0f});
+    }
+    return boxes;
+}
+
+Containers::StridedArrayView1D<const Range3D> view(const std::vector<Range3D>& boxes) {
+    return Containers::arrayView(boxes.data(), boxes.size());
+}
+
+/* Brute-force variant of the queries, with the same tests as the
+   implementation */
+template<class Test> std::vector<UnsignedInt> bruteForce(const std::vector<Range3D>& boxes, Test test) {
+    std::vector<UnsignedInt> out;
+    for(std::size_t i = 0; i != boxes.size(); ++i)
+        if(test(boxes[i])) out.push_back(i);
+    return out;
+}
+
+/* The queries don't return the primitives in any particular order */
+std::vector<UnsignedInt> sorted(std::vector<UnsignedInt> values) {
+    std::sort(values.begin(), values.end());
+    return values;
+}
+
+const Frustum TestFrustum = Frustum::fromMatrix(
+    Matrix4::perspectiveProjection(45.0_degf, 1.0f, 1.0f, 80.0f)*
+    Matrix4::lookAt({-20.0f, 50.0f, -20.0f}, {50.0f, 50.0f, 50.0f}, Vector3::yAxis()).inverted());
+const Vector3 SphereCenter{30.0f, 60.0f, 40.0f};
+constexpr Float SphereRadius = 15.0f;
+const Range3D QueryRange{{10.0f, 20.0f, 30.0f}, {40.0f, 35.0f, 60.0f}};
+const Vector3 RayOrigin{-10.0f, 50.0f, 50.0f};
+const Vector3 RayDirection = Vector3{1.0f, 0.05f, -0.1f}.normalized();
+
+void BoundingVolumeHierarchyTest::construct() {
+    BoundingVolumeHierarchy hierarchy;
+    CORRADE_COMPARE(hierarchy.primitiveCount(), 0);
+    CORRADE_COMPARE(hierarchy.nodeCount(), 0);
+    CORRADE_COMPARE(hierarchy.bounds(), Range3D{});
+    CORRADE_VERIFY(!hierarchy.isDirty());
+}
+
+void BoundingVolumeHierarchyTest::buildEmpty() {
+    BoundingVolumeHierarchy hierarchy;
+    const std::vector<Range3D> boxes = randomBoxes(10, 1);
+    hierarchy.build(view(boxes));
+    CORRADE_COMPARE(hierarchy.primitiveCount(), 10);
+
+    /* Building again with no primitives empties the hierarchy */
+    hierarchy.build(nullptr);
+    CORRADE_COMPARE(hierarchy.primitiveCount(), 0);
+    CORRADE_COMPARE(hierarchy.nodeCount(), 0);
+    CORRADE_COMPARE(hierarchy.bounds(), Range3D{});
+
+    std::vector<UnsignedInt> out;
+    hierarchy.queryRange({{-1000.0f, -1000.0f, -1000.0f}, {1000.0f, 1000.0f, 1000.0f}}, out);
+    CORRADE_VERIFY(out.empty());
+}
+
+void BoundingVolumeHierarchyTest::buildMaxLeafSizeOne() {
+    const std::vector<Range3D> boxes = randomBoxes(100, 2);
+    BoundingVolumeHierarchy hierarchy;
+    hierarchy.build(view(boxes), 1);
+
+    /* Each primitive in its own leaf, which is a full binary tree */
+    CORRADE_COMPARE(hierarchy.nodeCount(), 2*100 - 1);
+
+    Range3D bounds = boxes[0];
+    for(const Range3D& box: boxes)
+        bounds = {Math::min(bounds.min(), box.min()), Math::max(bounds.max(), box.max())};
+    CORRADE_COMPARE(hierarchy.bounds(), bounds);
+}
+
+void BoundingVolumeHierarchyTest::buildSamePosition() {
+    /* All centroids in the same place, so no binning is possible and the
+       nodes get split in halves */
+    const std::vector<Range3D> boxes(9, Range3D{{1.0f, 2.0f, 3.0f}, {1.0f, 2.0f, 3.0f}});
+    BoundingVolumeHierarchy hierarchy;
+    hierarchy.build(view(boxes), 2);
+
+    CORRADE_COMPARE(hierarchy.bounds(), boxes[0]);
+
+    std::vector<UnsignedInt> out;
+    hierarchy.querySphere({1.0f, 2.0f, 3.0f}, 0.0f, out);
+    CORRADE_COMPARE(sorted(out), (std::vector<UnsignedInt>{0, 1, 2, 3, 4, 5, 6, 7, 8}));
+}
+
+void BoundingVolumeHierarchyTest::buildZeroMaxLeafSize() {
+    BoundingVolumeHierarchy hierarchy;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    hierarchy.build(nullptr, 0);
+    CORRADE_COMPARE(out.str(), "SceneGraph::BoundingVolumeHierarchy::build(): max leaf size can't be zero\n");
+}
+
+void BoundingVolumeHierarchyTest::query() {
+    const std::vector<Range3D> boxes = randomBoxes(2000, 3);
+    BoundingVolumeHierarchy hierarchy;
+    hierarchy.build(view(boxes));
+    CORRADE_VERIFY(hierarchy.nodeCount() < 2*boxes.size());
+
+    std::vector<UnsignedInt> frustum;
+    hierarchy.queryFrustum(TestFrustum, frustum);
+    std::vector<UnsignedInt> expectedFrustum = bruteForce(boxes, [](const Range3D& bounds) {
+        return Math::Intersection::rangeFrustum(bounds, TestFrustum);
+    });
+    CORRADE_VERIFY(!expectedFrustum.empty());
+    CORRADE_COMPARE(sorted(frustum), expectedFrustum);
+
+    std::vector<UnsignedInt> sphere;
+    hierarchy.querySphere(SphereCenter, SphereRadius, sphere);
+    std::vector<UnsignedInt> expectedSphere = bruteForce(boxes, [](const Range3D& bounds) {
+        return (Math::clamp(SphereCenter, bounds.min(), bounds.max()) - SphereCenter).dot() <= SphereRadius*SphereRadius;
+    });
+    CORRADE_VERIFY(!expectedSphere.empty());
+    CORRADE_COMPARE(sorted(sphere), expectedSphere);
+
+    std::vector<UnsignedInt> range;
+    hierarchy.queryRange(QueryRange, range);
+    std::vector<UnsignedInt> expectedRange = bruteForce(boxes, [](const Range3D& bounds) {
+        return (bounds.min() <= QueryRange.max()).all() && (QueryRange.min() <= bounds.max()).all();
+    });
+    CORRADE_VERIFY(!expectedRange.empty());
+    CORRADE_COMPARE(sorted(range), expectedRange);
+
+    std::vector<UnsignedInt> ray;
+    hierarchy.queryRay(RayOrigin, RayDirection, ray);
+    std::vector<UnsignedInt> expectedRay = bruteForce(boxes, [](const Range3D& bounds) {
+        return Math::Intersection::rayRange(RayOrigin, 1.0f/RayDirection, bounds);
+    });
+    CORRADE_VERIFY(!expectedRay.empty());
+    CORRADE_COMPARE(sorted(ray), expectedRay);
+
+    /* The results get appended */
+    hierarchy.queryRange(QueryRange, range);
+    CORRADE_COMPARE(range.size(), 2*expectedRange.size());
+}
+
+void BoundingVolumeHierarchyTest::refit() {
+    std::vector<Range3D> boxes = randomBoxes(1000, 4);
+    BoundingVolumeHierarchy hierarchy;
+    hierarchy.build(view(boxes));
+    const std::size_t nodeCount = hierarchy.nodeCount();
+
+    /* Move every seventh box somewhere else, including outside of the
+       original bounds */
+    const std::vector<Range3D> moved = randomBoxes(1000, 5);
+    for(std::size_t i = 0; i < boxes.size(); i += 7) {
+        boxes[i] = {moved[i].min()*1.5f, moved[i].max()*1.5f};
+        hierarchy.setPrimitiveBounds(i, boxes[i]);
+    }
+    CORRADE_VERIFY(hierarchy.isDirty());
+    CORRADE_COMPARE(hierarchy.primitiveBounds()[7], boxes[7]);
+
+    hierarchy.refit();
+    CORRADE_VERIFY(!hierarchy.isDirty());
+    CORRADE_COMPARE(hierarchy.nodeCount(), nodeCount);
+
+    Range3D bounds = boxes[0];
+    for(const Range3D& box: boxes)
+        bounds = {Math::min(bounds.min(), box.min()), Math::max(bounds.max(), box.max())};
+    CORRADE_COMPARE(hierarchy.bounds(), bounds);
+
+    std::vector<UnsignedInt> sphere;
+    hierarchy.querySphere(SphereCenter, SphereRadius*2.0f, sphere);
+    CORRADE_COMPARE(sorted(sphere), bruteForce(boxes, [](const Range3D& bounds) {
+        return (Math::clamp(SphereCenter, bounds.min(), bounds.max()) - SphereCenter).dot() <= 4.0f*SphereRadius*SphereRadius;
+    }));
+
+    std::vector<UnsignedInt> range;
+    hierarchy.queryRange(QueryRange, range);
+    CORRADE_COMPARE(sorted(range), bruteForce(boxes, [](const Range3D& bounds) {
+        return (bounds.min() <= QueryRange.max()).all() && (QueryRange.min() <= bounds.max()).all();
+    }));
+
+    /* Refit with nothing dirty does nothing */
+    hierarchy.refit();
+    CORRADE_COMPARE(hierarchy.bounds(), bounds);
+}
+
+void BoundingVolumeHierarchyTest::setPrimitiveBoundsOutOfRange() {
+    const std::vector<Range3D> boxes = randomBoxes(3, 6);
+    BoundingVolumeHierarchy hierarchy;
+    hierarchy.build(view(boxes));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    hierarchy.setPrimitiveBounds(3, {});
+    CORRADE_VERIFY(!hierarchy.isDirty());
+    CORRADE_COMPARE(out.str(), "SceneGraph::BoundingVolumeHierarchy::setPrimitiveBounds(): index 3 out of range for 3 primitives\n");
+}
+
+void BoundingVolumeHierarchyTest::group() {
+    Scene3D scene;
+    Object3D parent{&scene};
+    Object3D a{&parent};
+    Object3D b{&parent};
+    Object3D c{&scene};
+    a.translate({10.0f, 0.0f, 0.0f});
+    b.translate({-10.0f, 0.0f, 0.0f});
+    c.scale(Vector3{2.0f}).translate({0.0f, 10.0f, 0.0f});
+
+    BoundingVolumeGroup volumes;
+    const Range3D unit{{-1.0f, -1.0f, -1.0f}, {1.0f, 1.0f, 1.0f}};
+    BoundingVolume va{a, volumes, unit};
+    BoundingVolume vb{b, volumes, unit};
+    BoundingVolume vc{c, volumes, unit};
+    CORRADE_COMPARE(volumes.size(), 3);
+    CORRADE_COMPARE(&volumes[1], &vb);
+    CORRADE_COMPARE(vc.id(), 2);
+    CORRADE_COMPARE(vc.group(), &volumes);
+
+    volumes.update();
+    CORRADE_COMPARE(volumes.hierarchy().primitiveCount(), 3);
+    CORRADE_COMPARE(va.absoluteBounds(), (Range3D{{9.0f, -1.0f, -1.0f}, {11.0f, 1.0f, 1.0f}}));
+    CORRADE_COMPARE(vc.absoluteBounds(), (Range3D{{-2.0f, 8.0f, -2.0f}, {2.0f, 12.0f, 2.0f}}));
+
+    std::vector<UnsignedInt> out;
+    volumes.hierarchy().querySphere({10.0f, 0.0f, 0.0f}, 0.5f, out);
+    CORRADE_COMPARE(out, std::vector<UnsignedInt>{0});
+
+    /* Moving a parent updates its children on next update() */
+    parent.translate({0.0f, 0.0f, 5.0f});
+    volumes.update();
+    CORRADE_VERIFY(!volumes.hierarchy().isDirty());
+    CORRADE_COMPARE(va.absoluteBounds(), (Range3D{{9.0f, -1.0f, 4.0f}, {11.0f, 1.0f, 6.0f}}));
+    CORRADE_COMPARE(vb.absoluteBounds(), (Range3D{{-11.0f, -1.0f, 4.0f}, {-9.0f, 1.0f, 6.0f}}));
+    CORRADE_COMPARE(vc.absoluteBounds(), (Range3D{{-2.0f, 8.0f, -2.0f}, {2.0f, 12.0f, 2.0f}}));
+
+    out.clear();
+    volumes.hierarchy().querySphere({10.0f, 0.0f, 0.0f}, 0.5f, out);
+    CORRADE_VERIFY(out.empty());
+
+    /* Changing the bounds */
+    vc.setBounds({{-1.0f, -1.0f, -1.0f}, {0.0f, 0.0f, 0.0f}});
+    volumes.update();
+    CORRADE_COMPARE(vc.absoluteBounds(), (Range3D{{-2.0f, 8.0f, -2.0f}, {0.0f, 10.0f, 0.0f}}));
+    CORRADE_COMPARE(volumes.hierarchy().primitiveBounds()[2], vc.absoluteBounds());
+}
+
+void BoundingVolumeHierarchyTest::groupRemoveVolume() {
+    Scene3D scene;
+    Object3D a{&scene};
+    Object3D b{&scene};
+    Object3D c{&scene};
+    a.translate({10.0f, 0.0f, 0.0f});
+    c.translate({-10.0f, 0.0f, 0.0f});
+
+    BoundingVolumeGroup volumes;
+    const Range3D unit{{-1.0f, -1.0f, -1.0f}, {1.0f, 1.0f, 1.0f}};
+    BoundingVolume va{a, volumes, unit};
+    BoundingVolume* vb = new BoundingVolume{b, volumes, unit};
+    BoundingVolume vc{c, volumes, unit};
+    volumes.update();
+
+    /* The last volume gets moved in place of the removed one */
+    delete vb;
+    CORRADE_COMPARE(volumes.size(), 2);
+    CORRADE_COMPARE(&volumes[1], &vc);
+    CORRADE_COMPARE(vc.id(), 1);
+
+    volumes.update();
+    CORRADE_COMPARE(volumes.hierarchy().primitiveCount(), 2);
+    std::vector<UnsignedInt> out;
+    volumes.hierarchy().querySphere({-10.0f, 0.0f, 0.0f}, 0.5f, out);
+    CORRADE_COMPARE(out, std::vector<UnsignedInt>{1});
+}
+
+void BoundingVolumeHierarchyTest::groupIndexOutOfRange() {
+    Scene3D scene;
+    Object3D a{&scene};
+    Object3D b{&scene};
+    BoundingVolumeGroup volumes;
+    BoundingVolume va{a, volumes, {}};
+    BoundingVolume vb{b, volumes, {}};
+    const BoundingVolumeGroup& cvolumes = volumes;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    /* The first volume is returned as a fallback */
+    CORRADE_COMPARE(&volumes[2], &va);
+    CORRADE_COMPARE(&cvolumes[17], &va);
+    CORRADE_COMPARE(out.str(),
+        "SceneGraph::BoundingVolumeGroup::operator[](): index 2 out of range for 2 volumes\n"
+        "SceneGraph::BoundingVolumeGroup::operator[](): index 17 out of range for 2 volumes\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::BoundingVolumeHierarchyTest)
@@ -0,0 +1,289 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/SceneGraph/FlatScene.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test { namespace {
+
+using namespace Math::Literals;
+
+struct FlatSceneTest: TestSuite::Tester {
+    explicit FlatSceneTest();
+
+    void construct();
+    void addObject();
+    void addObjectInvalidParent();
+    void clear();
+
+    void setClean();
+    void setCleanSubtree();
+    void setCleanManyObjects();
+    void isDirty();
+    void twoDimensions();
+
+    void cameraTransformationsInto();
+    void cameraTransformationsIntoWrongSize();
+
+    void indexOutOfRange();
+};
+
+FlatSceneTest::FlatSceneTest() {
+    addTests({&FlatSceneTest::construct,
+              &FlatSceneTest::addObject,
+              &FlatSceneTest::addObjectInvalidParent,
+              &FlatSceneTest::clear,
+
+              &FlatSceneTest::setClean,
+              &FlatSceneTest::setCleanSubtree,
+              &FlatSceneTest::setCleanManyObjects,
+              &FlatSceneTest::isDirty,
+              &FlatSceneTest::twoDimensions,
+
+              &FlatSceneTest::cameraTransformationsInto,
+              &FlatSceneTest::cameraTransformationsIntoWrongSize,
+
+              &FlatSceneTest::indexOutOfRange});
+}
+
+void FlatSceneTest::construct() {
+    FlatScene3D scene;
+    CORRADE_COMPARE(scene.size(), 0);
+    CORRADE_VERIFY(scene.parents().empty());
+    CORRADE_VERIFY(scene.transformations().empty());
+    CORRADE_VERIFY(scene.absoluteTransformations().empty());
+
+    /* Cleaning an empty scene does nothing */
+    scene.setClean();
+    CORRADE_COMPARE(scene.size(), 0);
+}
+
+void FlatSceneTest::addObject() {
+    FlatScene3D scene;
+    const UnsignedInt a = scene.addObject(FlatScene3D::NoParent, Matrix4::translation(Vector3::xAxis()));
+    const UnsignedInt b = scene.addObject(a);
+    const UnsignedInt c = scene.addObject(FlatScene3D::NoParent);
+    const UnsignedInt d = scene.addObject(b, Matrix4::scaling(Vector3{2.0f}));
+
+    CORRADE_COMPARE(a, 0);
+    CORRADE_COMPARE(b, 1);
+    CORRADE_COMPARE(c, 2);
+    CORRADE_COMPARE(d, 3);
+    CORRADE_COMPARE(scene.size(), 4);
+
+    const UnsignedInt expectedParents[]{FlatScene3D::NoParent, 0, FlatScene3D::NoParent, 1};
+    CORRADE_COMPARE_AS(scene.parents(), Containers::arrayView(expectedParents),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(scene.parent(3), 1);
+    CORRADE_COMPARE(scene.transformation(0), Matrix4::translation(Vector3::xAxis()));
+    CORRADE_COMPARE(scene.transformation(1), Matrix4{});
+    CORRADE_COMPARE(scene.transformations()[3], Matrix4::scaling(Vector3{2.0f}));
+
+    /* New objects are dirty */
+    for(UnsignedInt i = 0; i != scene.size(); ++i)
+        CORRADE_VERIFY(scene.isDirty(i));
+}
+
+void FlatSceneTest::addObjectInvalidParent() {
+    FlatScene3D scene;
+    scene.addObject(FlatScene3D::NoParent);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    scene.addObject(1);
+    CORRADE_COMPARE(out.str(), "SceneGraph::FlatScene::addObject(): parent index 1 out of range for 1 objects\n");
+    CORRADE_COMPARE(scene.size(), 1);
+}
+
+void FlatSceneTest::clear() {
+    FlatScene3D scene;
+    scene.addObject(FlatScene3D::NoParent);
+    scene.addObject(0);
+    scene.setClean();
+
+    scene.clear();
+    CORRADE_COMPARE(scene.size(), 0);
+    CORRADE_VERIFY(scene.absoluteTransformations().empty());
+
+    /* The scene is usable again after clearing */
+    const UnsignedInt a = scene.addObject(FlatScene3D::NoParent, Matrix4::translation(Vector3::yAxis()));
+    CORRADE_COMPARE(a, 0);
+    CORRADE_VERIFY(scene.isDirty(a));
+    scene.setClean();
+    CORRADE_COMPARE(scene.absoluteTransformation(a), Matrix4::translation(Vector3::yAxis()));
+}
+
+void FlatSceneTest::setClean() {
+    FlatScene3D scene;
+    const UnsignedInt a = scene.addObject(FlatScene3D::NoParent, Matrix4::translation(Vector3::xAxis()));
+    const UnsignedInt b = scene.addObject(a, Matrix4::rotationZ(90.0_degf));
+    const UnsignedInt c = scene.addObject(b, Matrix4::translation(Vector3::xAxis()));
+
+    scene.setClean();
+    CORRADE_VERIFY(!scene.isDirty(a));
+    CORRADE_VERIFY(!scene.isDirty(b));
+    CORRADE_VERIFY(!scene.isDirty(c));
+    CORRADE_COMPARE(scene.absoluteTransformation(a), Matrix4::translation(Vector3::xAxis()));
+    CORRADE_COMPARE(scene.absoluteTransformation(b), Matrix4::translation(Vector3::xAxis())*Matrix4::rotationZ(90.0_degf));
+    CORRADE_COMPARE(scene.absoluteTransformation(c).translation(), (Vector3{1.0f, 1.0f, 0.0f}));
+}
+
+void FlatSceneTest::setCleanSubtree() {
+    FlatScene3D scene;
+    const UnsignedInt a = scene.addObject(FlatScene3D::NoParent);
+    const UnsignedInt b = scene.addObject(a);
+    const UnsignedInt c = scene.addObject(FlatScene3D::NoParent);
+    const UnsignedInt d = scene.addObject(b);
+    const UnsignedInt e = scene.addObject(c);
+    scene.setClean();
+
+    /* Changing the middle of the hierarchy marks just its subtree dirty */
+    scene.setTransformation(b, Matrix4::translation(Vector3::zAxis()));
+    CORRADE_VERIFY(!scene.isDirty(a));
+    CORRADE_VERIFY(scene.isDirty(b));
+    CORRADE_VERIFY(!scene.isDirty(c));
+    CORRADE_VERIFY(scene.isDirty(d));
+    CORRADE_VERIFY(!scene.isDirty(e));
+
+    scene.setClean();
+    CORRADE_VERIFY(!scene.isDirty(d));
+    CORRADE_COMPARE(scene.absoluteTransformation(a), Matrix4{});
+    CORRADE_COMPARE(scene.absoluteTransformation(b), Matrix4::translation(Vector3::zAxis()));
+    CORRADE_COMPARE(scene.absoluteTransformation(c), Matrix4{});
+    CORRADE_COMPARE(scene.absoluteTransformation(d), Matrix4::translation(Vector3::zAxis()));
+    CORRADE_COMPARE(scene.absoluteTransformation(e), Matrix4{});
+}
+
+void FlatSceneTest::setCleanManyObjects() {
+    /* A chain spanning several words of the dirty bitset, each object
+       translated by one relative to its parent */
+    FlatScene3D scene;
+    scene.reserve(100);
+    UnsignedInt parent = FlatScene3D::NoParent;
+    for(UnsignedInt i = 0; i != 100; ++i)
+        parent = scene.addObject(parent, Matrix4::translation(Vector3::xAxis()));
+    scene.setClean();
+    CORRADE_COMPARE(scene.absoluteTransformation(99).translation(), (Vector3{100.0f, 0.0f, 0.0f}));
+
+    /* Dirtying an object in the second word updates everything after it */
+    scene.setTransformation(40, Matrix4::translation(Vector3::xAxis()*2.0f));
+    CORRADE_VERIFY(!scene.isDirty(39));
+    CORRADE_VERIFY(scene.isDirty(40));
+    CORRADE_VERIFY(scene.isDirty(99));
+    scene.setClean();
+    CORRADE_COMPARE(scene.absoluteTransformation(39).translation(), (Vector3{40.0f, 0.0f, 0.0f}));
+    CORRADE_COMPARE(scene.absoluteTransformation(40).translation(), (Vector3{42.0f, 0.0f, 0.0f}));
+    CORRADE_COMPARE(scene.absoluteTransformation(99).translation(), (Vector3{101.0f, 0.0f, 0.0f}));
+}
+
+void FlatSceneTest::isDirty() {
+    FlatScene3D scene;
+    const UnsignedInt a = scene.addObject(FlatScene3D::NoParent);
+    const UnsignedInt b = scene.addObject(a);
+    scene.setClean();
+    CORRADE_VERIFY(!scene.isDirty(b));
+
+    /* Explicitly dirtying the parent makes the child dirty as well, without
+       touching its own bit */
+    scene.setDirty(a);
+    CORRADE_VERIFY(scene.isDirty(a));
+    CORRADE_VERIFY(scene.isDirty(b));
+
+    scene.setClean();
+    CORRADE_VERIFY(!scene.isDirty(a));
+    CORRADE_VERIFY(!scene.isDirty(b));
+}
+
+void FlatSceneTest::twoDimensions() {
+    FlatScene2D scene;
+    const UnsignedInt a = scene.addObject(FlatScene2D::NoParent, Matrix3::translation(Vector2::xAxis()));
+    const UnsignedInt b = scene.addObject(a, Matrix3::scaling(Vector2{3.0f}));
+    scene.setClean();
+    CORRADE_COMPARE(scene.absoluteTransformation(b), Matrix3::translation(Vector2::xAxis())*Matrix3::scaling(Vector2{3.0f}));
+}
+
+void FlatSceneTest::cameraTransformationsInto() {
+    FlatScene3D scene;
+    const UnsignedInt a = scene.addObject(FlatScene3D::NoParent, Matrix4::translation(Vector3::xAxis()));
+    const UnsignedInt b = scene.addObject(a, Matrix4::translation(Vector3::yAxis()));
+    const UnsignedInt c = scene.addObject(FlatScene3D::NoParent, Matrix4::scaling(Vector3{2.0f}));
+
+    /* The scene is dirty, gets cleaned first */
+    const Matrix4 camera = Matrix4::translation(-Vector3::zAxis());
+    const UnsignedInt objects[]{c, b};
+    Matrix4 out[2];
+    scene.cameraTransformationsInto(camera, objects, out);
+    CORRADE_VERIFY(!scene.isDirty(b));
+    CORRADE_COMPARE(out[0], camera*Matrix4::scaling(Vector3{2.0f}));
+    CORRADE_COMPARE(out[1], camera*Matrix4::translation({1.0f, 1.0f, 0.0f}));
+}
+
+void FlatSceneTest::cameraTransformationsIntoWrongSize() {
+    FlatScene3D scene;
+    scene.addObject(FlatScene3D::NoParent);
+    scene.addObject(FlatScene3D::NoParent);
+
+    const UnsignedInt objects[]{0, 1};
+    const UnsignedInt objectsOutOfRange[]{0, 2};
+    Matrix4 out[2];
+    Matrix4 outWrongSize[1];
+
+    std::ostringstream o;
+    Error redirectError{&o};
+    scene.cameraTransformationsInto({}, objects, outWrongSize);
+    scene.cameraTransformationsInto({}, objectsOutOfRange, out);
+    CORRADE_COMPARE(o.str(),
+        "SceneGraph::FlatScene::cameraTransformationsInto(): expected output view size 2 but got 1\n"
+        "SceneGraph::FlatScene::cameraTransformationsInto(): index 2 out of range for 2 objects\n");
+}
+
+void FlatSceneTest::indexOutOfRange() {
+    FlatScene3D scene;
+    scene.addObject(FlatScene3D::NoParent);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    scene.parent(1);
+    scene.transformation(1);
+    scene.setTransformation(1, {});
+    scene.isDirty(1);
+    scene.setDirty(1);
+    scene.absoluteTransformation(1);
+    CORRADE_COMPARE(out.str(),
+        "SceneGraph::FlatScene::parent(): index 1 out of range for 1 objects\n"
+        "SceneGraph::FlatScene::transformation(): index 1 out of range for 1 objects\n"
+        "SceneGraph::FlatScene::setTransformation(): index 1 out of range for 1 objects\n"
+        "SceneGraph::FlatScene::isDirty(): index 1 out of range for 1 objects\n"
+        "SceneGraph::FlatScene::setDirty(): index 1 out of range for 1 objects\n"
+        "SceneGraph::FlatScene::absoluteTransformation(): index 1 out of range for 1 objects\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::FlatSceneTest)
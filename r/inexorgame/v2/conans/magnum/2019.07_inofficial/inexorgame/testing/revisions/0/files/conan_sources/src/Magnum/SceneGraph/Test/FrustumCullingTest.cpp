@@ -0,0 +1,307 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Constants.h"
+#include "Magnum/Math/Frustum.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/SceneGraph/Camera.h"
+#include "Magnum/SceneGraph/Drawable.h"
+#include "Magnum/SceneGraph/FrustumCulling.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/Scene.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test { namespace {
+
+using namespace Math::Literals;
+
+struct FrustumCullingTest: TestSuite::Tester {
+    explicit FrustumCullingTest();
+
+    void spheres();
+    void boxes();
+    void conservative();
+    void degeneratePlane();
+    void strided();
+    void empty();
+    void matchesScalar();
+    void wrongSize();
+
+    void culledDrawableTransformations();
+};
+
+typedef Object<MatrixTransformation3D> Object3D;
+typedef Scene<MatrixTransformation3D> Scene3D;
+
+/* A cube from -1 to 1 with normals pointing inside, not normalized to test
+   that the implementation does that */
+const Frustum UnitCube{
+    { 2.0f,  0.0f,  0.0f, 2.0f},
+    {-2.0f,  0.0f,  0.0f, 2.0f},
+    { 0.0f,  3.0f,  0.0f, 3.0f},
+    { 0.0f, -3.0f,  0.0f, 3.0f},
+    { 0.0f,  0.0f,  0.5f, 0.5f},
+    { 0.0f,  0.0f, -0.5f, 0.5f}};
+
+FrustumCullingTest::FrustumCullingTest() {
+    addTests({&FrustumCullingTest::spheres,
+              &FrustumCullingTest::boxes,
+              &FrustumCullingTest::conservative,
+              &FrustumCullingTest::degeneratePlane,
+              &FrustumCullingTest::strided,
+              &FrustumCullingTest::empty,
+              &FrustumCullingTest::matchesScalar,
+              &FrustumCullingTest::wrongSize,
+
+              &FrustumCullingTest::culledDrawableTransformations});
+}
+
+void FrustumCullingTest::spheres() {
+    /* Nine volumes to test the batch tail as well */
+    const Vector3 centers[]{
+        {0.0f, 0.0f, 0.0f},     /* inside */
+        {3.0f, 0.0f, 0.0f},     /* right of the cube */
+        {1.8f, 0.0f, 0.0f},     /* partially inside */
+        {0.0f, -2.5f, 0.0f},    /* below */
+        {0.0f, 0.0f, 1.9f},     /* partially inside */
+        {0.0f, 0.0f, -2.1f},    /* behind */
+        {0.0f, 0.0f, 0.0f},     /* enclosing the whole cube */
+        {-1.5f, 0.0f, 0.0f},    /* partially inside from the left */
+        {-5.0f, 0.0f, 0.0f}};   /* far left, in the tail */
+    const Vector3 extents[9]{};
+    const Float radii[]{0.5f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 10.0f, 0.6f, 1.0f};
+    bool visible[9];
+    frustumCullInto(UnitCube, centers, extents, radii, visible);
+
+    const bool expected[]{true, false, true, false, true, false, true, true, false};
+    CORRADE_COMPARE_AS(Containers::arrayView(visible), Containers::arrayView(expected),
+        TestSuite::Compare::Container);
+}
+
+void FrustumCullingTest::boxes() {
+    const Vector3 centers[]{
+        {0.0f, 0.0f, 0.0f},
+        {2.0f, 0.0f, 0.0f},
+        {2.6f, 0.0f, 0.0f},
+        {0.0f, 0.0f, -3.0f}};
+    const Vector3 extents[]{
+        {0.1f, 0.1f, 0.1f},
+        {1.5f, 0.1f, 0.1f},     /* reaches to x = 0.5 */
+        {1.5f, 0.1f, 0.1f},     /* ends at x = 1.1 */
+        {0.1f, 0.1f, 2.5f}};    /* reaches to z = -0.5 */
+    const Float radii[4]{};
+    bool visible[4];
+    frustumCullInto(UnitCube, centers, extents, radii, visible);
+
+    const bool expected[]{true, true, false, true};
+    CORRADE_COMPARE_AS(Containers::arrayView(visible), Containers::arrayView(expected),
+        TestSuite::Compare::Container);
+}
+
+void FrustumCullingTest::conservative() {
+    /* A sphere and a box enlarged by a radius near the corner, outside but
+       not completely behind any single plane */
+    const Vector3 centers[]{{1.5f, 1.5f, 0.0f}, {1.5f, 1.5f, 0.0f}};
+    const Vector3 extents[]{{}, {0.2f, 0.2f, 0.0f}};
+    const Float radii[]{0.6f, 0.35f};
+    bool visible[2];
+    frustumCullInto(UnitCube, centers, extents, radii, visible);
+
+    CORRADE_VERIFY(visible[0]);
+    CORRADE_VERIFY(visible[1]);
+}
+
+void FrustumCullingTest::degeneratePlane() {
+    /* The far plane is zero, so it doesn't cull anything */
+    const Frustum frustum{UnitCube.left(), UnitCube.right(), UnitCube.bottom(),
+        UnitCube.top(), UnitCube.near(), {}};
+
+    const Vector3 centers[]{{0.0f, 0.0f, 100.0f}, {0.0f, 0.0f, -100.0f}};
+    const Vector3 extents[2]{};
+    const Float radii[]{1.0f, 1.0f};
+    bool visible[2];
+    frustumCullInto(frustum, centers, extents, radii, visible);
+
+    CORRADE_VERIFY(visible[0]);
+    CORRADE_VERIFY(!visible[1]);
+}
+
+void FrustumCullingTest::strided() {
+    struct Volume {
+        Vector3 center;
+        Float radius;
+        bool visible;
+    } volumes[]{
+        {{0.0f, 0.0f, 0.0f}, 0.5f, false},
+        {{3.0f, 0.0f, 0.0f}, 1.0f, true},
+        {{1.8f, 0.0f, 0.0f}, 1.0f, false}
+    };
+    const Vector3 extents[3]{};
+    frustumCullInto(UnitCube,
+        Containers::StridedArrayView1D<const Vector3>{Containers::arrayView(volumes), &volumes[0].center, 3, sizeof(Volume)},
+        extents,
+        Containers::StridedArrayView1D<const Float>{Containers::arrayView(volumes), &volumes[0].radius, 3, sizeof(Volume)},
+        Containers::StridedArrayView1D<bool>{Containers::arrayView(volumes), &volumes[0].visible, 3, sizeof(Volume)});
+
+    CORRADE_VERIFY(volumes[0].visible);
+    CORRADE_VERIFY(!volumes[1].visible);
+    CORRADE_VERIFY(volumes[2].visible);
+}
+
+void FrustumCullingTest::empty() {
+    frustumCullInto(UnitCube, nullptr, nullptr, nullptr, nullptr);
+    CORRADE_VERIFY(true);
+}
+
+void FrustumCullingTest::matchesScalar() {
+    /* Volumes on a grid sweeping through a perspective frustum, compared to a
+       plain per-volume scalar calculation. The grid is offset so no volume
+       touches a plane exactly, as the result there would depend on
+       rounding. */
+    const Frustum frustum = Frustum::fromMatrix(
+        Matrix4::perspectiveProjection(60.0_degf, 1.5f, 0.5f, 20.0f)*
+        Matrix4::rotationY(15.0_degf));
+
+    std::size_t count = 0;
+    Containers::Array<Vector3> centers{Containers::NoInit, 21*21*21};
+    Containers::Array<Vector3> extents{Containers::NoInit, 21*21*21};
+    Containers::Array<Float> radii{Containers::NoInit, 21*21*21};
+    Containers::Array<bool> expected{Containers::NoInit, 21*21*21};
+    for(Int z = 0; z != 21; ++z) for(Int y = 0; y != 21; ++y) for(Int x = 0; x != 21; ++x) {
+        const Vector3 center{x - 10.03f, y - 10.07f, -z - 0.11f};
+        const Vector3 extent = (x + y) % 3 ? Vector3{0.3f, 0.1f, 0.2f} : Vector3{};
+        const Float radius = (x + z) % 2 ? 0.25f : 0.0f;
+
+        /* Plain scalar test with normalized planes, in doubles */
+        bool visible = true, ambiguous = false;
+        for(std::size_t i = 0; i != 6; ++i) {
+            const Vector4d plane = Vector4d{frustum[i]}/Vector3d{frustum[i].xyz()}.length();
+            const Double d = Math::dot(plane.xyz(), Vector3d{center}) + plane.w() +
+                Math::dot(Math::abs(plane.xyz()), Vector3d{extent}) + Double(radius);
+            if(Math::abs(d) < 1.0e-4) ambiguous = true;
+            if(d < 0.0) visible = false;
+        }
+        if(ambiguous) continue;
+
+        centers[count] = center;
+        extents[count] = extent;
+        radii[count] = radius;
+        expected[count] = visible;
+        ++count;
+    }
+
+    Containers::Array<bool> visible{Containers::NoInit, count};
+    frustumCullInto(frustum, centers.prefix(count), extents.prefix(count), radii.prefix(count), visible);
+    CORRADE_COMPARE_AS(Containers::arrayView(visible), expected.prefix(count),
+        TestSuite::Compare::Container);
+
+    /* Make sure the test is not trivial */
+    std::size_t visibleCount = 0;
+    for(bool i: visible) if(i) ++visibleCount;
+    CORRADE_VERIFY(visibleCount > 0);
+    CORRADE_VERIFY(visibleCount < count);
+}
+
+void FrustumCullingTest::wrongSize() {
+    const Vector3 centers[3]{};
+    const Vector3 extents[2]{};
+    const Float radii[3]{};
+    bool visible[3];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    frustumCullInto(UnitCube, centers, extents, radii, visible);
+    CORRADE_COMPARE(out.str(), "SceneGraph::frustumCullInto(): expected all views to have the same size but got 3, 2, 3 and 3\n");
+}
+
+void FrustumCullingTest::culledDrawableTransformations() {
+    struct CullableDrawable: Drawable3D {
+        explicit CullableDrawable(Object3D& object, DrawableGroup3D* group): Drawable3D{object, group} {}
+
+        void draw(const Matrix4&, Camera3D&) override {}
+    };
+
+    Scene3D scene;
+    Object3D cameraObject{&scene};
+    Camera3D camera{cameraObject};
+    camera.setProjectionMatrix(Matrix4::perspectiveProjection(90.0_degf, 1.0f, 0.1f, 100.0f));
+
+    DrawableGroup3D group;
+
+    Object3D inside{&scene};
+    inside.translate({0.0f, 0.0f, -5.0f});
+    CullableDrawable a{inside, &group};
+    a.setBoundingSphere({}, 0.5f);
+
+    Object3D behind{&scene};
+    behind.translate({0.0f, 0.0f, 5.0f});
+    CullableDrawable b{behind, &group};
+    b.setBoundingSphere({}, 0.5f);
+
+    /* The frustum is 10 units wide at this distance, so the sphere is
+       outside unless scaled */
+    Object3D side{&scene};
+    side.translate({8.0f, 0.0f, -5.0f});
+    CullableDrawable c{side, &group};
+    c.setBoundingSphere({}, 0.5f);
+
+    Object3D sideScaled{&scene};
+    sideScaled.scale(Vector3{10.0f}).translate({8.0f, 0.0f, -5.0f});
+    CullableDrawable d{sideScaled, &group};
+    d.setBoundingSphere({}, 0.5f);
+
+    /* A box that's outside unless rotated to point away from the camera */
+    Object3D box{&scene};
+    box.translate({8.0f, 0.0f, -5.0f});
+    CullableDrawable e{box, &group};
+    e.setBoundingBox({{2.0f, -0.1f, -0.1f}, {4.0f, 0.1f, 0.1f}});
+
+    Object3D boxRotated{&scene};
+    boxRotated.rotateY(90.0_degf).translate({8.0f, 0.0f, -5.0f});
+    CullableDrawable f{boxRotated, &group};
+    f.setBoundingBox({{2.0f, -0.1f, -0.1f}, {4.0f, 0.1f, 0.1f}});
+
+    /* No bounds, never culled */
+    Object3D unbounded{&scene};
+    unbounded.translate({0.0f, 0.0f, 50.0f});
+    CullableDrawable g{unbounded, &group};
+
+    const auto transformations = SceneGraph::culledDrawableTransformations(camera, group);
+    CORRADE_COMPARE(transformations.size(), 4);
+    CORRADE_COMPARE(&transformations[0].first.get(), &a);
+    CORRADE_COMPARE(&transformations[1].first.get(), &d);
+    CORRADE_COMPARE(&transformations[2].first.get(), &f);
+    CORRADE_COMPARE(&transformations[3].first.get(), &g);
+    CORRADE_COMPARE(transformations[0].second, Matrix4::translation({0.0f, 0.0f, -5.0f}));
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::FrustumCullingTest)
@@ -104,6 +104,7 @@ template MAGNUM_TRADE_EXPORT auto animationInterpolatorFor<CubicHermite2D, Math:
 template MAGNUM_TRADE_EXPORT auto animationInterpolatorFor<CubicHermite3D, Math::Vector3<Float>>(Animation::Interpolation) -> Math::Vector3<Float>(*)(const CubicHermite3D&, const CubicHermite3D&, Float);
 template MAGNUM_TRADE_EXPORT auto animationInterpolatorFor<CubicHermiteComplex, Complex>(Animation::Interpolation) -> Complex(*)(const CubicHermiteComplex&, const CubicHermiteComplex&, Float);
 template MAGNUM_TRADE_EXPORT auto animationInterpolatorFor<CubicHermiteQuaternion, Quaternion>(Animation::Interpolation) -> Quaternion(*)(const CubicHermiteQuaternion&, const CubicHermiteQuaternion&, Float);
+template MAGNUM_TRADE_EXPORT auto animationInterpolatorFor<Animation::QuantizedQuaternion, Quaternion>(Animation::Interpolation) -> Quaternion(*)(const Animation::QuantizedQuaternion&, const Animation::QuantizedQuaternion&, Float);
 
 Debug& operator<<(Debug& debug, const AnimationTrackType value) {
     switch(value) {
@@ -133,6 +134,7 @@ Debug& operator<<(Debug& debug, const AnimationTrackType value) {
         _c(CubicHermite3D)
         _c(CubicHermiteComplex)
         _c(CubicHermiteQuaternion)
+        _c(QuantizedQuaternion)
         #undef _c
         /* LCOV_EXCL_STOP */
     }
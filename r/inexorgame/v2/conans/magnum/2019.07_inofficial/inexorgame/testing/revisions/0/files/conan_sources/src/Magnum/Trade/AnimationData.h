@@ -31,6 +31,7 @@
 
 #include "Magnum/Magnum.h"
 #include "Magnum/Math/Math.h"
+#include "Magnum/Animation/QuantizedQuaternion.h"
 #include "Magnum/Animation/Track.h"
 #include "Magnum/Trade/Trade.h"
 #include "Magnum/Trade/visibility.h"
@@ -114,7 +115,15 @@ enum class AnimationTrackType: UnsignedByte {
      * @ref Magnum::CubicHermiteQuaternion "CubicHermiteQuaternion". Usually
      * used for spline-interpolated @ref AnimationTrackTargetType::Rotation3D.
      */
-    CubicHermiteQuaternion
+    CubicHermiteQuaternion,
+
+    /**
+     * @ref Animation::QuantizedQuaternion. Usually used for compressed
+     * linearly interpolated @ref AnimationTrackTargetType::Rotation3D, with
+     * @ref AnimationTrackType::Quaternion as the result type.
+     * @see @ref compressAnimation()
+     */
+    QuantizedQuaternion
 };
 
 /** @debugoperatorenum{AnimationTrackType} */
@@ -167,10 +176,12 @@ enum class AnimationTrackTargetType: UnsignedByte {
      * Modifies 3D object rotation. Type is usually
      * @ref Magnum::Quaternion "Quaternion" or
      * @ref Magnum::CubicHermiteQuaternion "CubicHermiteQuaternion" for
-     * spline-interpolated data.
+     * spline-interpolated data or @ref Animation::QuantizedQuaternion for
+     * compressed data.
      *
      * @see @ref AnimationTrackType::Quaternion,
      *      @ref AnimationTrackType::CubicHermiteQuaternion,
+     *      @ref AnimationTrackType::QuantizedQuaternion,
      *      @ref ObjectData3D::rotation()
      */
     Rotation3D,
@@ -496,6 +507,8 @@ namespace Implementation {
     template<> constexpr AnimationTrackType animationTypeFor<CubicHermite3D>() { return AnimationTrackType::CubicHermite3D; }
     template<> constexpr AnimationTrackType animationTypeFor<CubicHermiteComplex>() { return AnimationTrackType::CubicHermiteComplex; }
     template<> constexpr AnimationTrackType animationTypeFor<CubicHermiteQuaternion>() { return AnimationTrackType::CubicHermiteQuaternion; }
+
+    template<> constexpr AnimationTrackType animationTypeFor<Animation::QuantizedQuaternion>() { return AnimationTrackType::QuantizedQuaternion; }
     /* LCOV_EXCL_STOP */
 }
 #endif
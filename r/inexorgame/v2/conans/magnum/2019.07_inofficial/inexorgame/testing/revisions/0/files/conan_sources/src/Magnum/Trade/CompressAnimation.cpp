@@ -0,0 +1,335 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "CompressAnimation.h"
+
+#include <cstring>
+#include <vector>
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Math/CubicHermite.h"
+#include "Magnum/Math/DualQuaternion.h"
+#include "Magnum/Math/Quaternion.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/Trade/AnimationData.h"
+
+namespace Magnum { namespace Trade {
+
+namespace {
+
+struct OutputTrack;
+typedef AnimationTrackData(*TrackFactory)(const OutputTrack&, const Containers::StridedArrayView1D<const Float>&, const char*);
+
+struct OutputTrack {
+    AnimationTrackType type, resultType;
+    AnimationTrackTargetType targetType;
+    UnsignedInt target;
+    Animation::Interpolation interpolation;
+    Animation::Extrapolation before, after;
+    void(*interpolator)();
+    TrackFactory factory;
+
+    /* If set, the track uses the fixed-rate keys common for the whole
+       animation and the keys array is empty */
+    bool sharedKeys;
+    std::vector<Float> keys;
+    std::vector<char> values;
+};
+
+template<class V, class R> AnimationTrackData createTrack(const OutputTrack& track, const Containers::StridedArrayView1D<const Float>& keys, const char* values) {
+    return AnimationTrackData{track.type, track.resultType, track.targetType, track.target,
+        Animation::TrackView<Float, V, R>{keys,
+            Containers::arrayView(reinterpret_cast<const V*>(values), keys.size()),
+            track.interpolation,
+            reinterpret_cast<R(*)(const V&, const V&, Float)>(track.interpolator),
+            track.before, track.after}};
+}
+
+template<class V> void setValues(OutputTrack& out, const Containers::StridedArrayView1D<const V>& values) {
+    out.values.resize(values.size()*sizeof(V));
+    for(std::size_t i = 0; i != values.size(); ++i)
+        std::memcpy(out.values.data() + i*sizeof(V), &values[i], sizeof(V));
+}
+
+template<class V> void setValues(OutputTrack& out, const std::vector<V>& values, const std::vector<std::size_t>& indices) {
+    out.values.resize(indices.size()*sizeof(V));
+    for(std::size_t i = 0; i != indices.size(); ++i)
+        std::memcpy(out.values.data() + i*sizeof(V), &values[indices[i]], sizeof(V));
+}
+
+template<class V, class R = Animation::ResultOf<V>> void copyTrack(const AnimationData& animation, const UnsignedInt id, OutputTrack& out) {
+    const Animation::TrackView<Float, V, R>& track = animation.track<V, R>(id);
+    out.interpolator = reinterpret_cast<void(*)()>(track.interpolator());
+    out.factory = createTrack<V, R>;
+    out.keys.resize(track.size());
+    for(std::size_t i = 0; i != track.size(); ++i)
+        out.keys[i] = track.keys()[i];
+    setValues(out, track.values());
+}
+
+void copyTrack(const AnimationData& animation, const UnsignedInt id, OutputTrack& out) {
+    switch(animation.trackType(id)) {
+        #define _c(type, ...) case AnimationTrackType::type: return copyTrack<__VA_ARGS__>(animation, id, out);
+        _c(Bool, bool)
+        _c(Float, Float)
+        _c(UnsignedInt, UnsignedInt)
+        _c(Int, Int)
+        _c(BoolVector2, Math::BoolVector<2>)
+        _c(BoolVector3, Math::BoolVector<3>)
+        _c(BoolVector4, Math::BoolVector<4>)
+        _c(Vector2, Vector2)
+        _c(Vector2ui, Vector2ui)
+        _c(Vector2i, Vector2i)
+        _c(Vector3, Vector3)
+        _c(Vector3ui, Vector3ui)
+        _c(Vector3i, Vector3i)
+        _c(Vector4, Vector4)
+        _c(Vector4ui, Vector4ui)
+        _c(Vector4i, Vector4i)
+        _c(Complex, Complex)
+        _c(Quaternion, Quaternion)
+        _c(DualQuaternion, DualQuaternion)
+        _c(CubicHermite1D, CubicHermite1D)
+        _c(CubicHermite2D, CubicHermite2D)
+        _c(CubicHermite3D, CubicHermite3D)
+        _c(CubicHermiteComplex, CubicHermiteComplex)
+        _c(CubicHermiteQuaternion, CubicHermiteQuaternion)
+        _c(QuantizedQuaternion, Animation::QuantizedQuaternion)
+        #undef _c
+    }
+
+    CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+std::vector<Float> sampleTimes(const Range1D& duration, const Float sampleRate) {
+    /* Subtracting a small epsilon to avoid a nearly duplicate last key
+       because of floating-point error */
+    const std::size_t count = duration.size() > 0.0f ?
+        std::size_t(Math::ceil(duration.size()*sampleRate - 1.0e-3f)) + 1 : 1;
+    std::vector<Float> times(count);
+    for(std::size_t i = 0; i + 1 < count; ++i)
+        times[i] = duration.min() + i/sampleRate;
+    times.back() = duration.max();
+    return times;
+}
+
+/* Greedily extends each linear segment as long as all source values inside
+   it are reproduced within the error bound. The stored values are the ones
+   that actually end up in the output (i.e., quantized) and are interpolated
+   with the same function as in the output. Segment length is capped to keep
+   the worst case linear in the key count. */
+constexpr std::size_t MaxSegmentLength = 256;
+template<class T, class U> std::vector<std::size_t> reduceKeys(const std::vector<Float>& times, const std::vector<T>& source, const std::vector<U>& stored, T(*const interpolate)(const U&, const U&, Float), Float(*const error)(const T&, const T&), const Float maxError) {
+    std::vector<std::size_t> indices;
+    if(times.empty()) return indices;
+
+    indices.push_back(0);
+    std::size_t begin = 0;
+    for(std::size_t end = 2; end < times.size(); ++end) {
+        bool fits = end - begin <= MaxSegmentLength;
+        for(std::size_t i = begin + 1; fits && i != end; ++i) {
+            const Float t = (times[i] - times[begin])/(times[end] - times[begin]);
+            fits = error(interpolate(stored[begin], stored[end], t), source[i]) <= maxError;
+        }
+
+        if(!fits) {
+            begin = end - 1;
+            indices.push_back(begin);
+        }
+    }
+    if(times.size() > 1) indices.push_back(times.size() - 1);
+
+    return indices;
+}
+
+Float vectorError(const Vector3& a, const Vector3& b) {
+    return (a - b).length();
+}
+
+/* Angle of the relative rotation. Not using acos() of the dot product, as
+   that is too imprecise for small angles. */
+Float angleError(const Quaternion& a, const Quaternion& b) {
+    const Quaternion difference = a.conjugated()*b;
+    return 2.0f*std::atan2(difference.vector().length(), Math::abs(difference.scalar()));
+}
+
+}
+
+AnimationData compressAnimation(const AnimationData& animation, const Float sampleRate, const Float maxError, const Rad maxAngleError) {
+    const auto vectorLerp = Animation::interpolatorFor<Vector3, Vector3>(Animation::Interpolation::Linear);
+    const auto quantizedSlerp = Animation::interpolatorFor<Animation::QuantizedQuaternion, Quaternion>(Animation::Interpolation::Linear);
+
+    const std::vector<Float> sharedKeys = sampleRate > 0.0f ?
+        sampleTimes(animation.duration(), sampleRate) : std::vector<Float>{};
+    bool sharedKeysUsed = false;
+
+    std::vector<OutputTrack> outputTracks(animation.trackCount());
+    for(UnsignedInt i = 0; i != animation.trackCount(); ++i) {
+        OutputTrack& out = outputTracks[i];
+        out.type = animation.trackType(i);
+        out.resultType = animation.trackResultType(i);
+        out.targetType = animation.trackTargetType(i);
+        out.target = animation.trackTarget(i);
+        out.sharedKeys = false;
+
+        const Animation::TrackViewStorage<Float>& storage = animation.track(i);
+        out.interpolation = storage.interpolation();
+        out.before = storage.before();
+        out.after = storage.after();
+
+        /* Tracks are classified by the interpolation hint and not by
+           comparing interpolator pointers, as the address of inline function
+           templates such as Math::lerp() or Math::slerp() may differ between
+           libraries */
+        const bool isVector = out.type == AnimationTrackType::Vector3 &&
+            out.resultType == AnimationTrackType::Vector3;
+        const bool isQuaternion = out.type == AnimationTrackType::Quaternion &&
+            out.resultType == AnimationTrackType::Quaternion;
+
+        /* Quaternions with constant interpolation are just quantized */
+        if(isQuaternion && storage.interpolation() == Animation::Interpolation::Constant) {
+            const Animation::TrackView<Float, Quaternion>& track = animation.track<Quaternion>(i);
+            out.type = AnimationTrackType::QuantizedQuaternion;
+            out.interpolator = reinterpret_cast<void(*)()>(Animation::interpolatorFor<Animation::QuantizedQuaternion, Quaternion>(Animation::Interpolation::Constant));
+            out.factory = createTrack<Animation::QuantizedQuaternion, Quaternion>;
+            out.keys.resize(track.size());
+            std::vector<Animation::QuantizedQuaternion> values(track.size());
+            std::vector<std::size_t> indices(track.size());
+            for(std::size_t j = 0; j != track.size(); ++j) {
+                out.keys[j] = track.keys()[j];
+                values[j] = Animation::QuantizedQuaternion{track.values()[j]};
+                indices[j] = j;
+            }
+            setValues(out, values, indices);
+            continue;
+        }
+
+        /* Other tracks that aren't linearly interpolated vectors or rotations
+           are copied unchanged */
+        if(!(isVector || isQuaternion) || storage.interpolation() != Animation::Interpolation::Linear) {
+            copyTrack(animation, i, out);
+            continue;
+        }
+
+        /* Decide on the source keys. Fixed-rate keys are shared if the track
+           spans the whole animation. */
+        std::vector<Float> times;
+        if(sampleRate > 0.0f) {
+            const Range1D duration = storage.duration();
+            out.sharedKeys = duration == animation.duration();
+            times = out.sharedKeys ? sharedKeys : sampleTimes(duration, sampleRate);
+        } else {
+            times.resize(storage.size());
+            for(std::size_t j = 0; j != times.size(); ++j)
+                times[j] = storage.keys()[j];
+        }
+
+        std::vector<std::size_t> indices;
+        if(isVector) {
+            const Animation::TrackView<Float, Vector3>& track = animation.track<Vector3>(i);
+            std::vector<Vector3> values(times.size());
+            std::size_t hint{};
+            for(std::size_t j = 0; j != times.size(); ++j)
+                values[j] = sampleRate > 0.0f ? track.at(times[j], hint) : track.values()[j];
+
+            if(maxError > 0.0f)
+                indices = reduceKeys(times, values, values, vectorLerp, vectorError, maxError);
+            else for(std::size_t j = 0; j != times.size(); ++j)
+                indices.push_back(j);
+
+            out.interpolator = reinterpret_cast<void(*)()>(track.interpolator());
+            out.factory = createTrack<Vector3, Vector3>;
+            setValues(out, values, indices);
+
+        } else {
+            const Animation::TrackView<Float, Quaternion>& track = animation.track<Quaternion>(i);
+            std::vector<Quaternion> values(times.size());
+            std::vector<Animation::QuantizedQuaternion> quantized(times.size());
+            std::size_t hint{};
+            for(std::size_t j = 0; j != times.size(); ++j) {
+                values[j] = sampleRate > 0.0f ? track.at(times[j], hint) : track.values()[j];
+                quantized[j] = Animation::QuantizedQuaternion{values[j]};
+            }
+
+            if(Float(maxAngleError) > 0.0f)
+                indices = reduceKeys(times, values, quantized, quantizedSlerp, angleError, Float(maxAngleError));
+            else for(std::size_t j = 0; j != times.size(); ++j)
+                indices.push_back(j);
+
+            out.type = AnimationTrackType::QuantizedQuaternion;
+            out.interpolator = reinterpret_cast<void(*)()>(quantizedSlerp);
+            out.factory = createTrack<Animation::QuantizedQuaternion, Quaternion>;
+            setValues(out, quantized, indices);
+        }
+
+        /* If any keys were removed, the track needs its own */
+        if(!out.sharedKeys || indices.size() != times.size()) {
+            out.sharedKeys = false;
+            out.keys.resize(indices.size());
+            for(std::size_t j = 0; j != indices.size(); ++j)
+                out.keys[j] = times[indices[j]];
+        } else sharedKeysUsed = true;
+    }
+
+    /* Calculate the total data size, aligning everything to four bytes */
+    std::size_t dataSize = sharedKeysUsed ? sharedKeys.size()*sizeof(Float) : 0;
+    for(const OutputTrack& track: outputTracks) {
+        dataSize += track.keys.size()*sizeof(Float);
+        dataSize += (track.values.size() + 3) & ~std::size_t(3);
+    }
+
+    /* Copy everything to a single buffer and create the track views */
+    Containers::Array<char> data{Containers::ValueInit, dataSize};
+    Containers::Array<AnimationTrackData> tracks{outputTracks.size()};
+    std::size_t offset = 0;
+    Containers::ArrayView<const Float> sharedKeyView;
+    if(sharedKeysUsed) {
+        std::memcpy(data.data(), sharedKeys.data(), sharedKeys.size()*sizeof(Float));
+        sharedKeyView = Containers::arrayView(reinterpret_cast<const Float*>(data.data()), sharedKeys.size());
+        offset += sharedKeys.size()*sizeof(Float);
+    }
+    for(std::size_t i = 0; i != outputTracks.size(); ++i) {
+        const OutputTrack& track = outputTracks[i];
+
+        Containers::ArrayView<const Float> keys = sharedKeyView;
+        if(!track.sharedKeys) {
+            if(!track.keys.empty())
+                std::memcpy(data.data() + offset, track.keys.data(), track.keys.size()*sizeof(Float));
+            keys = Containers::arrayView(reinterpret_cast<const Float*>(data.data() + offset), track.keys.size());
+            offset += track.keys.size()*sizeof(Float);
+        }
+
+        if(!track.values.empty())
+            std::memcpy(data.data() + offset, track.values.data(), track.values.size());
+        tracks[i] = track.factory(track, keys, data.data() + offset);
+        offset += (track.values.size() + 3) & ~std::size_t(3);
+    }
+
+    CORRADE_INTERNAL_ASSERT(offset == dataSize);
+    return AnimationData{std::move(data), std::move(tracks), animation.duration()};
+}
+
+}}
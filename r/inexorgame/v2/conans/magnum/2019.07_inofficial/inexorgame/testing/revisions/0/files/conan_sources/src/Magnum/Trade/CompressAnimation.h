@@ -0,0 +1,91 @@
+#ifndef Magnum_Trade_CompressAnimation_h
+#define Magnum_Trade_CompressAnimation_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::Trade::compressAnimation()
+ */
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Angle.h"
+#include "Magnum/Trade/Trade.h"
+#include "Magnum/Trade/visibility.h"
+
+namespace Magnum { namespace Trade {
+
+/**
+@brief Compress animation data
+@param animation        Animation to compress
+@param sampleRate       Rate at which to resample the tracks, in samples per
+    time unit. If @cpp 0.0f @ce, the original keyframes are kept.
+@param maxError         Maximal allowed error of translation and scaling
+    tracks, in their own units
+@param maxAngleError    Maximal allowed error of rotation tracks
+@return Compressed animation data
+
+Tracks that are compressed:
+
+-   Linearly interpolated @ref AnimationTrackType::Vector3 tracks are
+    resampled and reduced.
+-   Linearly interpolated @ref AnimationTrackType::Quaternion tracks are
+    resampled, reduced and converted to
+    @ref AnimationTrackType::QuantizedQuaternion.
+-   @ref AnimationTrackType::Quaternion tracks with constant interpolation are
+    converted to @ref AnimationTrackType::QuantizedQuaternion.
+
+Tracks are classified by their @ref Animation::TrackViewStorage::interpolation()
+hint, the interpolator function itself is not inspected. Compressed rotation
+tracks are interpolated with
+@ref Animation::select(const QuantizedQuaternion&, const QuantizedQuaternion&, Float)
+or @ref Animation::slerpShortestPath(const QuantizedQuaternion&, const QuantizedQuaternion&, Float)
+regardless of the original interpolator. All other tracks are copied
+unchanged. Target types, targets, extrapolation and the animation duration are
+preserved.
+
+If @p sampleRate is non-zero, each compressed track is first resampled at a
+fixed rate over its duration. Keyframe times of all tracks spanning the whole
+animation duration are then the same and are stored in the output data just
+once, shared by all those tracks.
+
+Keyframes are then reduced by fitting the longest linear segments that
+reproduce all intermediate keyframes within @p maxError or @p maxAngleError.
+If resampling is enabled, the bound is relative to the resampled keyframes.
+The error of quantized quaternions is included in the fit, so the bound holds
+for the unpacked values as well. Set both to @cpp 0.0f @ce to disable the
+reduction.
+
+The output can be sampled directly using
+@ref AnimationData::track() and @ref Animation::TrackView::at(). Quantized
+rotation tracks are accessed as
+@cpp track<Animation::QuantizedQuaternion, Quaternion>() @ce, unpacked on the
+fly during interpolation.
+@experimental
+*/
+MAGNUM_TRADE_EXPORT AnimationData compressAnimation(const AnimationData& animation, Float sampleRate = 0.0f, Float maxError = 1.0e-4f, Rad maxAngleError = Rad{1.0e-3f});
+
+}}
+
+#endif
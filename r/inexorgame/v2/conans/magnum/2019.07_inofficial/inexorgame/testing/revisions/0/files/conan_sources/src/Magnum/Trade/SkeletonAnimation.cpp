@@ -0,0 +1,269 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "SkeletonAnimation.h"
+
+#include <vector>
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/Quaternion.h"
+#include "Magnum/Math/QuaternionBatch.h"
+#include "Magnum/Trade/AnimationData.h"
+
+namespace Magnum { namespace Trade {
+
+namespace {
+
+struct Track {
+    UnsignedInt id;
+    UnsignedInt joint;
+    AnimationTrackTargetType targetType;
+    std::size_t hint;
+};
+
+/* Same keyframe search as in Animation::interpolate(), but instead of calling
+   the interpolator it returns the keyframe indices and interpolation phase so
+   the interpolation itself can be batched. Returns false if the result should
+   be default-constructed. */
+bool keyframes(const Containers::StridedArrayView1D<const Float>& keys, const Animation::Extrapolation before, const Animation::Extrapolation after, Float frame, std::size_t& hint, std::size_t& a, std::size_t& b, Float& t) {
+    if(!keys.size()) return false;
+
+    if(keys.size() == 1) {
+        if((frame < keys[0] && before == Animation::Extrapolation::DefaultConstructed) ||
+           (frame > keys[0] && after == Animation::Extrapolation::DefaultConstructed))
+            return false;
+
+        a = b = 0;
+        t = 0.0f;
+        return true;
+    }
+
+    Animation::findKeyframe(keys, frame, hint);
+
+    if(frame < keys[hint]) {
+        if(before == Animation::Extrapolation::DefaultConstructed) return false;
+        if(before == Animation::Extrapolation::Constant) frame = keys[hint];
+    } else if(frame >= keys[hint + 1]) {
+        if(after == Animation::Extrapolation::DefaultConstructed) return false;
+        if(after == Animation::Extrapolation::Constant) frame = keys[hint + 1];
+    }
+
+    a = hint;
+    b = hint + 1;
+    t = Math::lerpInverted(keys[hint], keys[hint + 1], frame);
+    return true;
+}
+
+}
+
+struct SkeletonAnimation::State {
+    const AnimationData* animation;
+
+    Containers::Array<Int> parents;
+    Containers::Array<Vector3> translations;
+    Containers::Array<Quaternion> rotations;
+    Containers::Array<Vector3> scalings;
+    Containers::Array<Matrix4> world;
+
+    /* Linearly interpolated rotation tracks, interpolated in a batch */
+    std::vector<Track> rotationTracks;
+    Containers::Array<Quaternion> rotationA, rotationB, rotationResult;
+    Containers::Array<Float> rotationT;
+
+    /* Linearly interpolated translation and scaling tracks */
+    std::vector<Track> vectorTracks;
+
+    /* Everything else, going through TrackView::at() */
+    std::vector<Track> genericTracks;
+};
+
+SkeletonAnimation::SkeletonAnimation(const AnimationData& animation, const Containers::ArrayView<const Int> parents, const Containers::StridedArrayView1D<const Vector3>& restTranslations, const Containers::StridedArrayView1D<const Quaternion>& restRotations, const Containers::StridedArrayView1D<const Vector3>& restScalings): _state{Containers::InPlaceInit} {
+    const std::size_t jointCount = parents.size();
+    CORRADE_ASSERT(restTranslations.size() == jointCount && restRotations.size() == jointCount && restScalings.size() == jointCount,
+        "Trade::SkeletonAnimation: expected" << jointCount << "rest translations, rotations and scalings but got" << restTranslations.size() << Debug::nospace << "," << restRotations.size() << "and" << restScalings.size(), );
+
+    _state->animation = &animation;
+    _state->parents = Containers::Array<Int>{Containers::NoInit, jointCount};
+    _state->translations = Containers::Array<Vector3>{Containers::NoInit, jointCount};
+    _state->rotations = Containers::Array<Quaternion>{Containers::NoInit, jointCount};
+    _state->scalings = Containers::Array<Vector3>{Containers::NoInit, jointCount};
+    _state->world = Containers::Array<Matrix4>{Containers::NoInit, jointCount};
+    for(std::size_t i = 0; i != jointCount; ++i) {
+        CORRADE_ASSERT(parents[i] < Int(i),
+            "Trade::SkeletonAnimation: expected parent of joint" << i << "to be less than" << i << "but got" << parents[i], );
+        _state->parents[i] = parents[i];
+        _state->translations[i] = restTranslations[i];
+        _state->rotations[i] = restRotations[i];
+        _state->scalings[i] = restScalings[i];
+    }
+
+    /* Classifying by the interpolation hint and not by comparing the
+       interpolator pointers, as addresses of the inline template functions
+       may differ between libraries */
+    for(UnsignedInt i = 0; i != animation.trackCount(); ++i) {
+        const AnimationTrackTargetType targetType = animation.trackTargetType(i);
+        const UnsignedInt target = animation.trackTarget(i);
+        if(target >= jointCount) continue;
+
+        const AnimationTrackType type = animation.trackType(i);
+        const AnimationTrackType resultType = animation.trackResultType(i);
+        const bool linear = animation.track(i).interpolation() == Animation::Interpolation::Linear;
+        const Track track{i, target, targetType, 0};
+
+        if(targetType == AnimationTrackTargetType::Rotation3D) {
+            if(resultType != AnimationTrackType::Quaternion) continue;
+            if(type == AnimationTrackType::Quaternion && linear)
+                _state->rotationTracks.push_back(track);
+            else if(type == AnimationTrackType::Quaternion || type == AnimationTrackType::CubicHermiteQuaternion || type == AnimationTrackType::QuantizedQuaternion)
+                _state->genericTracks.push_back(track);
+
+        } else if(targetType == AnimationTrackTargetType::Translation3D ||
+                  targetType == AnimationTrackTargetType::Scaling3D) {
+            if(resultType != AnimationTrackType::Vector3) continue;
+            if(type == AnimationTrackType::Vector3 && linear)
+                _state->vectorTracks.push_back(track);
+            else if(type == AnimationTrackType::Vector3 || type == AnimationTrackType::CubicHermite3D)
+                _state->genericTracks.push_back(track);
+        }
+    }
+
+    const std::size_t rotationCount = _state->rotationTracks.size();
+    _state->rotationA = Containers::Array<Quaternion>{Containers::NoInit, rotationCount};
+    _state->rotationB = Containers::Array<Quaternion>{Containers::NoInit, rotationCount};
+    _state->rotationResult = Containers::Array<Quaternion>{Containers::NoInit, rotationCount};
+    _state->rotationT = Containers::Array<Float>{Containers::NoInit, rotationCount};
+}
+
+SkeletonAnimation::SkeletonAnimation(SkeletonAnimation&&) noexcept = default;
+
+SkeletonAnimation::~SkeletonAnimation() = default;
+
+SkeletonAnimation& SkeletonAnimation::operator=(SkeletonAnimation&&) noexcept = default;
+
+std::size_t SkeletonAnimation::jointCount() const {
+    return _state->parents.size();
+}
+
+std::size_t SkeletonAnimation::trackCount() const {
+    return _state->rotationTracks.size() + _state->vectorTracks.size() + _state->genericTracks.size();
+}
+
+Containers::StridedArrayView1D<const Vector3> SkeletonAnimation::translations() const {
+    return _state->translations;
+}
+
+Containers::StridedArrayView1D<const Quaternion> SkeletonAnimation::rotations() const {
+    return _state->rotations;
+}
+
+Containers::StridedArrayView1D<const Vector3> SkeletonAnimation::scalings() const {
+    return _state->scalings;
+}
+
+void SkeletonAnimation::evaluateLocal(const Float time) {
+    State& state = *_state;
+    const AnimationData& animation = *state.animation;
+
+    /* Gather keyframes of all linearly interpolated rotation tracks and
+       interpolate them in a single batch */
+    for(std::size_t i = 0; i != state.rotationTracks.size(); ++i) {
+        Track& track = state.rotationTracks[i];
+        const Animation::TrackView<Float, Quaternion>& view = animation.track<Quaternion>(track.id);
+        std::size_t a, b;
+        if(keyframes(view.keys(), view.before(), view.after(), time, track.hint, a, b, state.rotationT[i])) {
+            state.rotationA[i] = view.values()[a];
+            state.rotationB[i] = view.values()[b];
+        } else {
+            state.rotationA[i] = state.rotationB[i] = Quaternion{};
+            state.rotationT[i] = 0.0f;
+        }
+    }
+    Math::slerpShortestPathInto(state.rotationA, state.rotationB, state.rotationT, state.rotationResult);
+    for(std::size_t i = 0; i != state.rotationTracks.size(); ++i)
+        state.rotations[state.rotationTracks[i].joint] = state.rotationResult[i];
+
+    /* Linearly interpolated translation and scaling tracks */
+    for(Track& track: state.vectorTracks) {
+        const Animation::TrackView<Float, Vector3>& view = animation.track<Vector3>(track.id);
+        std::size_t a, b;
+        Float t;
+        const Vector3 value = keyframes(view.keys(), view.before(), view.after(), time, track.hint, a, b, t) ?
+            Math::lerp(view.values()[a], view.values()[b], t) : Vector3{};
+        (track.targetType == AnimationTrackTargetType::Translation3D ?
+            state.translations : state.scalings)[track.joint] = value;
+    }
+
+    /* Remaining tracks */
+    for(Track& track: state.genericTracks) {
+        const AnimationTrackType type = animation.trackType(track.id);
+        if(type == AnimationTrackType::Quaternion)
+            state.rotations[track.joint] = animation.track<Quaternion>(track.id).at(time, track.hint);
+        else if(type == AnimationTrackType::CubicHermiteQuaternion)
+            state.rotations[track.joint] = animation.track<CubicHermiteQuaternion>(track.id).at(time, track.hint);
+        else if(type == AnimationTrackType::QuantizedQuaternion)
+            state.rotations[track.joint] = animation.track<Animation::QuantizedQuaternion>(track.id).at(time, track.hint);
+        else {
+            const Vector3 value = type == AnimationTrackType::Vector3 ?
+                animation.track<Vector3>(track.id).at(time, track.hint) :
+                animation.track<CubicHermite3D>(track.id).at(time, track.hint);
+            (track.targetType == AnimationTrackTargetType::Translation3D ?
+                state.translations : state.scalings)[track.joint] = value;
+        }
+    }
+}
+
+void SkeletonAnimation::evaluate(const Float time, const Containers::StridedArrayView1D<Matrix4>& transformations) {
+    CORRADE_ASSERT(transformations.size() == _state->parents.size(),
+        "Trade::SkeletonAnimation::evaluate(): expected" << _state->parents.size() << "transformations but got" << transformations.size(), );
+
+    evaluateLocal(time);
+    Math::transformationMatricesInto(_state->translations, _state->rotations, _state->scalings, transformations);
+
+    /* Parents always come before their children, so a single pass is enough
+       to resolve the whole hierarchy */
+    for(std::size_t i = 0; i != _state->parents.size(); ++i) {
+        const Int parent = _state->parents[i];
+        if(parent >= 0) transformations[i] = transformations[parent]*transformations[i];
+    }
+}
+
+void SkeletonAnimation::evaluate(const Float time, const Containers::StridedArrayView1D<const Matrix4>& inverseBindMatrices, const Containers::StridedArrayView1D<Matrix4>& jointMatrices) {
+    CORRADE_ASSERT(inverseBindMatrices.size() == _state->parents.size() && jointMatrices.size() == _state->parents.size(),
+        "Trade::SkeletonAnimation::evaluate(): expected" << _state->parents.size() << "inverse bind and joint matrices but got" << inverseBindMatrices.size() << "and" << jointMatrices.size(), );
+
+    evaluateLocal(time);
+    Containers::ArrayView<Matrix4> world = _state->world;
+    Math::transformationMatricesInto(_state->translations, _state->rotations, _state->scalings, world);
+
+    for(std::size_t i = 0; i != world.size(); ++i) {
+        const Int parent = _state->parents[i];
+        if(parent >= 0) world[i] = world[parent]*world[i];
+        jointMatrices[i] = world[i]*inverseBindMatrices[i];
+    }
+}
+
+}}
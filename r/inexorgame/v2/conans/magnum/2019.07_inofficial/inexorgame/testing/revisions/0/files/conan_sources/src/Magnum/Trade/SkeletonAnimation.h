@@ -0,0 +1,187 @@
+#ifndef Magnum_Trade_SkeletonAnimation_h
+#define Magnum_Trade_SkeletonAnimation_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Trade::SkeletonAnimation
+ */
+
+#include <Corrade/Containers/Pointer.h>
+#include <Corrade/Containers/StridedArrayView.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Trade/Trade.h"
+#include "Magnum/Trade/visibility.h"
+
+namespace Magnum { namespace Trade {
+
+/**
+@brief Skeleton animation evaluator
+
+Evaluates translation, rotation and scaling tracks of an @ref AnimationData
+for a whole skeleton at once and calculates final joint matrices for skinning.
+The skeleton is described by a flat array of parent indices, where each joint
+is expected to come after its parent and root joints have the parent set to
+@cpp -1 @ce. Tracks with @ref AnimationTrackTargetType::Translation3D,
+@ref AnimationTrackTargetType::Rotation3D and
+@ref AnimationTrackTargetType::Scaling3D targeting a joint index are used,
+other tracks are ignored. Joints that are not animated keep their rest pose.
+
+@code{.cpp}
+Trade::AnimationData animation = *importer->animation(0);
+Trade::SkeletonAnimation skeleton{animation, parents,
+    restTranslations, restRotations, restScalings};
+
+Containers::Array<Matrix4> jointMatrices{skeleton.jointCount()};
+skeleton.evaluate(time, inverseBindMatrices, jointMatrices);
+@endcode
+
+@section Trade-SkeletonAnimation-performance Performance considerations
+
+The track classification is done just once in the constructor, based on the
+@ref Animation::TrackView::interpolation() hint. On every @ref evaluate()
+call, keyframes of all rotation tracks with @ref Animation::Interpolation::Linear
+are gathered first and then interpolated together using
+@ref Math::slerpShortestPathInto(). Local transformations of all joints are
+then converted to matrices using @ref Math::transformationMatricesInto() and
+the hierarchy is resolved in a single pass over the parent array, which is
+possible thanks to the parent ordering requirement. Each track remembers the
+last keyframe position, so playing the animation forward is cheap. Tracks
+with other interpolation modes as well as compressed rotation tracks produced
+by @ref compressAnimation() are evaluated using
+@ref Animation::TrackView::at() one by one. Note that tracks hinted as
+@ref Animation::Interpolation::Linear are always interpolated with
+@ref Math::slerpShortestPath() and @ref Math::lerp(), regardless of the
+interpolator they were created with --- tracks with a custom interpolator
+should use @ref Animation::Interpolation::Custom, which is what the
+interpolator-only @ref Animation::TrackView constructor sets.
+
+The @ref AnimationData instance is referenced, not copied, and is expected to
+stay in scope for the whole lifetime of this class.
+@experimental
+*/
+class MAGNUM_TRADE_EXPORT SkeletonAnimation {
+    public:
+        /**
+         * @brief Constructor
+         * @param animation         Animation data
+         * @param parents           Parent index for each joint, @cpp -1 @ce
+         *      for roots
+         * @param restTranslations  Rest translation for each joint
+         * @param restRotations     Rest rotation for each joint
+         * @param restScalings      Rest scaling for each joint
+         *
+         * Expects that all arrays have the same size and that each parent
+         * index is smaller than index of the joint it belongs to. The
+         * @p animation is expected to stay in scope for the whole lifetime of
+         * the instance.
+         */
+        explicit SkeletonAnimation(const AnimationData& animation, Containers::ArrayView<const Int> parents, const Containers::StridedArrayView1D<const Vector3>& restTranslations, const Containers::StridedArrayView1D<const Quaternion>& restRotations, const Containers::StridedArrayView1D<const Vector3>& restScalings);
+
+        /** @brief Copying is not allowed */
+        SkeletonAnimation(const SkeletonAnimation&) = delete;
+
+        /** @brief Move constructor */
+        SkeletonAnimation(SkeletonAnimation&&) noexcept;
+
+        ~SkeletonAnimation();
+
+        /** @brief Copying is not allowed */
+        SkeletonAnimation& operator=(const SkeletonAnimation&) = delete;
+
+        /** @brief Move assignment */
+        SkeletonAnimation& operator=(SkeletonAnimation&&) noexcept;
+
+        /** @brief Joint count */
+        std::size_t jointCount() const;
+
+        /**
+         * @brief Count of animated tracks
+         *
+         * Count of tracks that target one of the joints.
+         */
+        std::size_t trackCount() const;
+
+        /**
+         * @brief Joint translations
+         *
+         * Local joint translations from the last @ref evaluate() call or the
+         * rest pose if it wasn't called yet.
+         */
+        Containers::StridedArrayView1D<const Vector3> translations() const;
+
+        /**
+         * @brief Joint rotations
+         *
+         * Local joint rotations from the last @ref evaluate() call or the
+         * rest pose if it wasn't called yet.
+         */
+        Containers::StridedArrayView1D<const Quaternion> rotations() const;
+
+        /**
+         * @brief Joint scalings
+         *
+         * Local joint scalings from the last @ref evaluate() call or the rest
+         * pose if it wasn't called yet.
+         */
+        Containers::StridedArrayView1D<const Vector3> scalings() const;
+
+        /**
+         * @brief Evaluate world joint transformations
+         * @param[in] time              Animation time
+         * @param[out] transformations  Where to put world transformation of
+         *      each joint
+         *
+         * Expects that size of @p transformations is the same as
+         * @ref jointCount().
+         */
+        void evaluate(Float time, const Containers::StridedArrayView1D<Matrix4>& transformations);
+
+        /**
+         * @brief Evaluate joint matrices for skinning
+         * @param[in] time                  Animation time
+         * @param[in] inverseBindMatrices   Inverse bind matrix of each joint
+         * @param[out] jointMatrices        Where to put world transformation
+         *      of each joint multiplied by its inverse bind matrix
+         *
+         * Same as @ref evaluate(Float, const Containers::StridedArrayView1D<Matrix4>&),
+         * but additionally multiplies the world transformations with
+         * @p inverseBindMatrices in the same pass. Expects that size of both
+         * views is the same as @ref jointCount().
+         */
+        void evaluate(Float time, const Containers::StridedArrayView1D<const Matrix4>& inverseBindMatrices, const Containers::StridedArrayView1D<Matrix4>& jointMatrices);
+
+    private:
+        struct State;
+
+        MAGNUM_TRADE_LOCAL void evaluateLocal(Float time);
+
+        Containers::Pointer<State> _state;
+};
+
+}}
+
+#endif
@@ -0,0 +1,347 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <vector>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/ArrayViewStl.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+
+#include "Magnum/Animation/QuantizedQuaternion.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Quaternion.h"
+#include "Magnum/Trade/AnimationData.h"
+#include "Magnum/Trade/CompressAnimation.h"
+
+namespace Magnum { namespace Trade { namespace Test { namespace {
+
+struct CompressAnimationTest: TestSuite::Tester {
+    explicit CompressAnimationTest();
+
+    void reduce();
+    void reduceDisabled();
+    void resample();
+    void resampleReduce();
+    void resamplePartialTrack();
+
+    void constantRotation();
+    void copiedTracks();
+};
+
+const struct {
+    const char* name;
+    Float maxError;
+    Rad maxAngleError;
+} ReduceData[]{
+    {"tight", 1.0e-4f, Rad{1.0e-3f}},
+    {"default", 1.0e-3f, Rad{1.0e-2f}},
+    {"loose", 1.0e-1f, Rad{5.0e-2f}}
+};
+
+CompressAnimationTest::CompressAnimationTest() {
+    addInstancedTests({&CompressAnimationTest::reduce,
+                       &CompressAnimationTest::resampleReduce},
+        Containers::arraySize(ReduceData));
+
+    addTests({&CompressAnimationTest::reduceDisabled,
+              &CompressAnimationTest::resample,
+              &CompressAnimationTest::resamplePartialTrack,
+
+              &CompressAnimationTest::constantRotation,
+              &CompressAnimationTest::copiedTracks});
+}
+
+/* Quantization error of a rotation, as documented in QuantizedQuaternion */
+constexpr Rad QuantizationError{Deg{0.01f}};
+
+/* Slack for float rounding in the error calculation itself */
+constexpr Float Epsilon = 1.0e-5f;
+
+/* Angle of the relative rotation, same as used by compressAnimation() */
+Float angle(const Quaternion& a, const Quaternion& b) {
+    const Quaternion difference = a.conjugated()*b;
+    return 2.0f*std::atan2(difference.vector().length(), Math::abs(difference.scalar()));
+}
+
+/* Smooth animation with densely sampled linear translation and rotation
+   tracks, a rotation track with constant interpolation and a scaling track
+   that's not compressed */
+struct Source {
+    explicit Source(const std::size_t count, const Float step, const Float partialTrackEnd = 0.0f) {
+        for(std::size_t i = 0; i != count; ++i) {
+            const Float t = i*step;
+            keys.push_back(t);
+            translations.push_back({std::sin(0.5f*t), 2.0f*std::cos(0.3f*t), 0.5f*t});
+            rotations.push_back(Quaternion::rotation(Rad{0.4f*t},
+                Vector3{std::sin(0.2f*t), 1.0f, std::cos(0.1f*t)}.normalized()));
+            scalings.push_back(Vector3{1.0f + 0.1f*i});
+        }
+
+        /* Optionally make the constant and scaling tracks shorter than the
+           rest of the animation */
+        std::size_t partialCount = count;
+        if(partialTrackEnd > 0.0f) {
+            partialCount = 0;
+            while(partialCount != count && keys[partialCount] <= partialTrackEnd)
+                ++partialCount;
+        }
+
+        Containers::Array<AnimationTrackData> tracks{Containers::InPlaceInit, {
+            {AnimationTrackType::Vector3,
+             AnimationTrackTargetType::Translation3D, 3,
+             Animation::TrackView<Float, Vector3>{keys, translations,
+                Animation::Interpolation::Linear,
+                Animation::Extrapolation::Constant,
+                Animation::Extrapolation::Extrapolated}},
+            {AnimationTrackType::Quaternion,
+             AnimationTrackTargetType::Rotation3D, 3,
+             Animation::TrackView<Float, Quaternion>{keys, rotations,
+                Animation::Interpolation::Linear,
+                Animation::Extrapolation::DefaultConstructed,
+                Animation::Extrapolation::Constant}},
+            {AnimationTrackType::Quaternion,
+             AnimationTrackTargetType::Rotation3D, 5,
+             Animation::TrackView<Float, Quaternion>{
+                Containers::arrayView(keys.data(), partialCount),
+                Containers::arrayView(rotations.data(), partialCount),
+                Animation::Interpolation::Constant}},
+            {AnimationTrackType::Vector3,
+             AnimationTrackTargetType::Scaling3D, 7,
+             Animation::TrackView<Float, Vector3>{
+                Containers::arrayView(keys.data(), partialCount),
+                Containers::arrayView(scalings.data(), partialCount),
+                Animation::Interpolation::Constant}}
+        }};
+        animation.emplace(Containers::Array<char>{}, std::move(tracks));
+    }
+
+    std::vector<Float> keys;
+    std::vector<Vector3> translations;
+    std::vector<Quaternion> rotations;
+    std::vector<Vector3> scalings;
+    Containers::Optional<AnimationData> animation;
+};
+
+void CompressAnimationTest::reduce() {
+    auto&& data = ReduceData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Source source{1001, 0.01f};
+    const AnimationData& animation = *source.animation;
+    const AnimationData compressed = compressAnimation(animation, 0.0f, data.maxError, data.maxAngleError);
+
+    const auto translation = compressed.track<Vector3>(0);
+    const auto rotation = compressed.track<Animation::QuantizedQuaternion, Quaternion>(1);
+    CORRADE_COMPARE_AS(translation.size(), source.keys.size(),
+        TestSuite::Compare::Less);
+    CORRADE_COMPARE_AS(rotation.size(), source.keys.size(),
+        TestSuite::Compare::Less);
+
+    /* The bound holds on all original keyframes. Between them the difference
+       of two piecewise linear functions is linear, so the translation bound
+       holds everywhere. */
+    Float maxError = 0.0f, maxAngleError = 0.0f;
+    std::size_t translationHint{}, rotationHint{}, sourceHint{};
+    for(std::size_t i = 0; i != source.keys.size(); ++i) {
+        const Float key = source.keys[i];
+        maxError = Math::max(maxError, (translation.at(key, translationHint) - source.translations[i]).length());
+        maxAngleError = Math::max(maxAngleError, angle(rotation.at(key, rotationHint), source.rotations[i]));
+
+        const Float middle = key + 0.005f;
+        maxError = Math::max(maxError, (translation.at(middle, translationHint) - animation.track<Vector3>(0).at(middle, sourceHint)).length());
+    }
+    CORRADE_COMPARE_AS(maxError, data.maxError + Epsilon,
+        TestSuite::Compare::LessOrEqual);
+    CORRADE_COMPARE_AS(maxAngleError, Float(data.maxAngleError) + Epsilon,
+        TestSuite::Compare::LessOrEqual);
+
+    /* The first and last keyframes are always kept */
+    CORRADE_COMPARE(translation.keys()[0], 0.0f);
+    CORRADE_COMPARE(translation.keys()[translation.size() - 1], 10.0f);
+    CORRADE_COMPARE(rotation.keys()[0], 0.0f);
+    CORRADE_COMPARE(rotation.keys()[rotation.size() - 1], 10.0f);
+}
+
+void CompressAnimationTest::reduceDisabled() {
+    Source source{101, 0.1f};
+    const AnimationData compressed = compressAnimation(*source.animation, 0.0f, 0.0f, Rad{0.0f});
+
+    const auto translation = compressed.track<Vector3>(0);
+    const auto rotation = compressed.track<Animation::QuantizedQuaternion, Quaternion>(1);
+    CORRADE_COMPARE(translation.size(), source.keys.size());
+    CORRADE_COMPARE(rotation.size(), source.keys.size());
+
+    /* Translations are kept verbatim, rotations only quantized */
+    Float maxAngleError = 0.0f;
+    for(std::size_t i = 0; i != source.keys.size(); ++i) {
+        CORRADE_COMPARE(translation.keys()[i], source.keys[i]);
+        CORRADE_COMPARE(translation.values()[i], source.translations[i]);
+        CORRADE_COMPARE(rotation.keys()[i], source.keys[i]);
+        maxAngleError = Math::max(maxAngleError, angle(rotation.values()[i].quaternion(), source.rotations[i]));
+    }
+    CORRADE_COMPARE_AS(maxAngleError, Float(QuantizationError),
+        TestSuite::Compare::LessOrEqual);
+}
+
+void CompressAnimationTest::resample() {
+    /* Sparse source keyframes, resampled at a higher rate and not reduced */
+    Source source{11, 1.0f};
+    const AnimationData& animation = *source.animation;
+    const AnimationData compressed = compressAnimation(animation, 4.0f, 0.0f, Rad{0.0f});
+
+    const auto translation = compressed.track<Vector3>(0);
+    const auto rotation = compressed.track<Animation::QuantizedQuaternion, Quaternion>(1);
+    CORRADE_COMPARE(translation.size(), 41);
+    CORRADE_COMPARE(rotation.size(), 41);
+
+    /* Both tracks span the whole animation, so the keys are shared */
+    CORRADE_VERIFY(translation.keys().data() == rotation.keys().data());
+
+    Float maxError = 0.0f, maxAngleError = 0.0f;
+    for(std::size_t i = 0; i != translation.size(); ++i) {
+        const Float key = translation.keys()[i];
+        CORRADE_COMPARE(key, i*0.25f);
+        maxError = Math::max(maxError, (translation.values()[i] - animation.track<Vector3>(0).at(key)).length());
+        maxAngleError = Math::max(maxAngleError, angle(rotation.values()[i].quaternion(), animation.track<Quaternion>(1).at(key)));
+    }
+    CORRADE_COMPARE_AS(maxError, Epsilon,
+        TestSuite::Compare::LessOrEqual);
+    CORRADE_COMPARE_AS(maxAngleError, Float(QuantizationError),
+        TestSuite::Compare::LessOrEqual);
+}
+
+void CompressAnimationTest::resampleReduce() {
+    auto&& data = ReduceData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Source source{51, 0.2f};
+    const AnimationData& animation = *source.animation;
+    const AnimationData compressed = compressAnimation(animation, 30.0f, data.maxError, data.maxAngleError);
+
+    const auto translation = compressed.track<Vector3>(0);
+    const auto rotation = compressed.track<Animation::QuantizedQuaternion, Quaternion>(1);
+    CORRADE_COMPARE_AS(translation.size(), 301,
+        TestSuite::Compare::Less);
+    CORRADE_COMPARE_AS(rotation.size(), 301,
+        TestSuite::Compare::Less);
+
+    /* The bound is relative to the resampled keyframes */
+    Float maxError = 0.0f, maxAngleError = 0.0f;
+    for(std::size_t i = 0; i != 301; ++i) {
+        const Float key = Math::min(i/30.0f, 10.0f);
+        maxError = Math::max(maxError, (translation.at(key) - animation.track<Vector3>(0).at(key)).length());
+        maxAngleError = Math::max(maxAngleError, angle(rotation.at(key), animation.track<Quaternion>(1).at(key)));
+    }
+    CORRADE_COMPARE_AS(maxError, data.maxError + Epsilon,
+        TestSuite::Compare::LessOrEqual);
+    CORRADE_COMPARE_AS(maxAngleError, Float(data.maxAngleError) + Epsilon,
+        TestSuite::Compare::LessOrEqual);
+}
+
+void CompressAnimationTest::resamplePartialTrack() {
+    /* The translation track is resampled over its own duration and has its
+       own keys */
+    const std::vector<Float> wholeKeys{0.0f, 10.0f};
+    const std::vector<Vector3> wholeValues{Vector3{0.0f}, Vector3{10.0f}};
+    const std::vector<Float> keys{2.0f, 5.0f};
+    const std::vector<Vector3> values{Vector3{0.0f}, Vector3{3.0f}};
+    Containers::Array<AnimationTrackData> tracks{Containers::InPlaceInit, {
+        {AnimationTrackType::Vector3,
+         AnimationTrackTargetType::Translation3D, 3,
+         Animation::TrackView<Float, Vector3>{wholeKeys, wholeValues,
+            Animation::Interpolation::Linear}},
+        {AnimationTrackType::Vector3,
+         AnimationTrackTargetType::Translation3D, 4,
+         Animation::TrackView<Float, Vector3>{keys, values,
+            Animation::Interpolation::Linear}}
+    }};
+    const AnimationData animation{Containers::Array<char>{}, std::move(tracks)};
+    const AnimationData compressed = compressAnimation(animation, 2.0f, 0.0f, Rad{0.0f});
+
+    CORRADE_COMPARE(compressed.duration(), (Range1D{0.0f, 10.0f}));
+    const auto whole = compressed.track<Vector3>(0);
+    const auto partial = compressed.track<Vector3>(1);
+    CORRADE_COMPARE(whole.size(), 21);
+    CORRADE_COMPARE(partial.size(), 7);
+    CORRADE_VERIFY(whole.keys().data() != partial.keys().data());
+    CORRADE_COMPARE(partial.keys()[0], 2.0f);
+    CORRADE_COMPARE(partial.keys()[1], 2.5f);
+    CORRADE_COMPARE(partial.keys()[6], 5.0f);
+    CORRADE_COMPARE(partial.values()[3], Vector3{1.5f});
+}
+
+void CompressAnimationTest::constantRotation() {
+    Source source{11, 1.0f, 4.0f};
+    const AnimationData compressed = compressAnimation(*source.animation, 0.0f, 1.0f, Rad{1.0f});
+
+    CORRADE_COMPARE(compressed.trackType(2), AnimationTrackType::QuantizedQuaternion);
+    CORRADE_COMPARE(compressed.trackResultType(2), AnimationTrackType::Quaternion);
+
+    /* Not reduced, even with a large error */
+    const auto rotation = compressed.track<Animation::QuantizedQuaternion, Quaternion>(2);
+    CORRADE_COMPARE(rotation.interpolation(), Animation::Interpolation::Constant);
+    CORRADE_COMPARE(rotation.size(), 5);
+    for(std::size_t i = 0; i != rotation.size(); ++i) {
+        CORRADE_COMPARE(rotation.keys()[i], source.keys[i]);
+        CORRADE_VERIFY(rotation.values()[i] == Animation::QuantizedQuaternion{source.rotations[i]});
+    }
+    CORRADE_VERIFY(rotation.at(1.5f) == Animation::QuantizedQuaternion{source.rotations[1]}.quaternion());
+}
+
+void CompressAnimationTest::copiedTracks() {
+    Source source{11, 1.0f, 4.0f};
+    const AnimationData& animation = *source.animation;
+    const AnimationData compressed = compressAnimation(animation, 2.0f);
+
+    /* Metadata of all tracks are preserved */
+    CORRADE_COMPARE(compressed.duration(), animation.duration());
+    CORRADE_COMPARE(compressed.trackCount(), animation.trackCount());
+    for(UnsignedInt i = 0; i != animation.trackCount(); ++i) {
+        CORRADE_COMPARE(compressed.trackResultType(i), animation.trackResultType(i));
+        CORRADE_COMPARE(compressed.trackTargetType(i), animation.trackTargetType(i));
+        CORRADE_COMPARE(compressed.trackTarget(i), animation.trackTarget(i));
+        CORRADE_COMPARE(compressed.track(i).interpolation(), animation.track(i).interpolation());
+        CORRADE_COMPARE(compressed.track(i).before(), animation.track(i).before());
+        CORRADE_COMPARE(compressed.track(i).after(), animation.track(i).after());
+    }
+
+    /* Constant scaling track is copied unchanged, not resampled */
+    CORRADE_COMPARE(compressed.trackType(3), AnimationTrackType::Vector3);
+    const auto scaling = compressed.track<Vector3>(3);
+    CORRADE_COMPARE(scaling.size(), 5);
+    for(std::size_t i = 0; i != scaling.size(); ++i) {
+        CORRADE_COMPARE(scaling.keys()[i], source.keys[i]);
+        CORRADE_COMPARE(scaling.values()[i], source.scalings[i]);
+    }
+
+    /* The output doesn't reference the input data */
+    CORRADE_VERIFY(scaling.keys().data() != source.keys.data());
+    CORRADE_VERIFY(scaling.values().data() != source.scalings.data());
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::CompressAnimationTest)
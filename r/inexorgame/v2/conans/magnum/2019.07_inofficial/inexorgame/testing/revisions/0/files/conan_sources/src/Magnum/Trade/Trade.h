@@ -74,6 +74,7 @@ class ObjectData3D;
 class PhongMaterialData;
 class TextureData;
 class SceneData;
+class SkeletonAnimation;
 #endif
 
 }}
@@ -0,0 +1,256 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <vector>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/PluginManager/Manager.h>
+#include <Corrade/Utility/Arguments.h>
+#include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/Directory.h>
+#include <Corrade/Utility/FormatStl.h>
+
+#include "Magnum/Math/CubicHermite.h"
+#include "Magnum/Math/DualQuaternion.h"
+#include "Magnum/Math/Quaternion.h"
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/AnimationData.h"
+#include "Magnum/Trade/CompressAnimation.h"
+
+namespace Magnum {
+
+/** @page magnum-animationcompressor Animation compression utility
+@brief Reports compression ratio and error of animation tracks
+
+@m_footernavigation
+@m_keywords{magnum-animationcompressor animationcompressor}
+
+This utility is built if both `WITH_TRADE` and `WITH_ANIMATIONCOMPRESSOR` is
+enabled when building Magnum. To use this utility with CMake, you need to
+request the `animationcompressor` component of the `Magnum` package and use
+the `Magnum::animationcompressor` target for example in a custom command:
+
+@code{.cmake}
+find_package(Magnum REQUIRED animationcompressor)
+
+add_custom_command(OUTPUT ... COMMAND Magnum::animationcompressor ...)
+@endcode
+
+See @ref building, @ref cmake and the @ref Trade namespace for more
+information.
+
+@section magnum-animationcompressor-usage Usage
+
+@code{.sh}
+magnum-animationcompressor [-h|--help] [--importer IMPORTER]
+    [--plugin-dir DIR] [--sample-rate RATE] [--max-error ERROR]
+    [--max-angle-error DEGREES] [--] input
+@endcode
+
+Arguments:
+
+-   `input` --- input scene file
+-   `-h`, `--help` --- display this help message and exit
+-   `--importer IMPORTER` --- scene importer plugin (default:
+    @ref Trade::AnySceneImporter "AnySceneImporter")
+-   `--plugin-dir DIR` --- override base plugin dir
+-   `--sample-rate RATE` --- resample tracks at given rate, in samples per
+    second (default: @cpp 0 @ce, keep original keyframes)
+-   `--max-error ERROR` --- maximal translation and scaling error (default:
+    @cpp 0.0001 @ce)
+-   `--max-angle-error DEGREES` --- maximal rotation error in degrees
+    (default: @cpp 0.05 @ce)
+
+Each animation in the file is compressed using @ref Trade::compressAnimation()
+and for each track the keyframe count, size and maximal error is printed,
+followed by a total for the whole animation. The error is measured at all
+source and compressed keyframes and in the middle between the source
+keyframes. Rotation error is printed in degrees. Tracks that are copied
+unchanged are listed without the error.
+
+@section magnum-animationcompressor-example Example usage
+
+Showing how a glTF file would compress when resampled to 30 samples per
+second:
+
+@code{.sh}
+magnum-animationcompressor --sample-rate 30 walk.gltf
+@endcode
+
+*/
+
+}
+
+using namespace Magnum;
+
+namespace {
+
+std::size_t typeSize(const Trade::AnimationTrackType type) {
+    switch(type) {
+        case Trade::AnimationTrackType::Bool:
+            return sizeof(bool);
+        case Trade::AnimationTrackType::Float:
+        case Trade::AnimationTrackType::UnsignedInt:
+        case Trade::AnimationTrackType::Int:
+            return 4;
+        case Trade::AnimationTrackType::BoolVector2:
+        case Trade::AnimationTrackType::BoolVector3:
+        case Trade::AnimationTrackType::BoolVector4:
+            return 1;
+        case Trade::AnimationTrackType::Vector2:
+        case Trade::AnimationTrackType::Vector2ui:
+        case Trade::AnimationTrackType::Vector2i:
+        case Trade::AnimationTrackType::Complex:
+            return 8;
+        case Trade::AnimationTrackType::Vector3:
+        case Trade::AnimationTrackType::Vector3ui:
+        case Trade::AnimationTrackType::Vector3i:
+        case Trade::AnimationTrackType::CubicHermite1D:
+            return 12;
+        case Trade::AnimationTrackType::Vector4:
+        case Trade::AnimationTrackType::Vector4ui:
+        case Trade::AnimationTrackType::Vector4i:
+        case Trade::AnimationTrackType::Quaternion:
+            return 16;
+        case Trade::AnimationTrackType::DualQuaternion:
+        case Trade::AnimationTrackType::CubicHermite2D:
+        case Trade::AnimationTrackType::CubicHermiteComplex:
+            return 32;
+        case Trade::AnimationTrackType::CubicHermite3D:
+            return 36;
+        case Trade::AnimationTrackType::CubicHermiteQuaternion:
+            return 48;
+        case Trade::AnimationTrackType::QuantizedQuaternion:
+            return 6;
+    }
+
+    CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+/* Times at which the error is measured -- all keyframes of both tracks and
+   midpoints between source keyframes */
+std::vector<Float> errorSampleTimes(const Animation::TrackViewStorage<Float>& source, const Animation::TrackViewStorage<Float>& compressed) {
+    std::vector<Float> times;
+    for(std::size_t i = 0; i != source.size(); ++i) {
+        times.push_back(source.keys()[i]);
+        if(i + 1 != source.size())
+            times.push_back((source.keys()[i] + source.keys()[i + 1])*0.5f);
+    }
+    for(std::size_t i = 0; i != compressed.size(); ++i)
+        times.push_back(compressed.keys()[i]);
+    return times;
+}
+
+bool sharesKeys(const Trade::AnimationData& animation, const UnsignedInt id) {
+    const void* const keys = animation.track(id).keys().data();
+    for(UnsignedInt i = 0; i != animation.trackCount(); ++i)
+        if(i != id && animation.track(i).size() && animation.track(i).keys().data() == keys) return true;
+    return false;
+}
+
+}
+
+int main(int argc, char** argv) {
+    Utility::Arguments args;
+    args.addArgument("input").setHelp("input", "input scene file")
+        .addOption("importer", "AnySceneImporter").setHelp("importer", "scene importer plugin")
+        .addOption("plugin-dir").setHelp("plugin-dir", "override base plugin dir", "DIR")
+        .addOption("sample-rate", "0").setHelp("sample-rate", "resample tracks at given rate, in samples per second", "RATE")
+        .addOption("max-error", "0.0001").setHelp("max-error", "maximal translation and scaling error", "ERROR")
+        .addOption("max-angle-error", "0.05").setHelp("max-angle-error", "maximal rotation error in degrees", "DEGREES")
+        .setGlobalHelp("Reports compression ratio and error of animation tracks.")
+        .parse(argc, argv);
+
+    /* Load importer plugin */
+    PluginManager::Manager<Trade::AbstractImporter> importerManager{
+        args.value("plugin-dir").empty() ? std::string{} :
+        Utility::Directory::join(args.value("plugin-dir"), Trade::AbstractImporter::pluginSearchPaths()[0])};
+    Containers::Pointer<Trade::AbstractImporter> importer = importerManager.loadAndInstantiate(args.value("importer"));
+    if(!importer) return 1;
+
+    /* Open input file */
+    if(!importer->openFile(args.value("input"))) {
+        Error() << "Cannot open file" << args.value("input");
+        return 2;
+    }
+
+    const Float sampleRate = args.value<Float>("sample-rate");
+    const Float maxError = args.value<Float>("max-error");
+    const Rad maxAngleError = Deg{args.value<Float>("max-angle-error")};
+
+    std::size_t totalSourceSize = 0, totalCompressedSize = 0;
+    for(UnsignedInt i = 0; i != importer->animationCount(); ++i) {
+        Containers::Optional<Trade::AnimationData> source = importer->animation(i);
+        if(!source) {
+            Error() << "Cannot import animation" << i;
+            return 3;
+        }
+
+        const Trade::AnimationData compressed = Trade::compressAnimation(*source, sampleRate, maxError, maxAngleError);
+
+        Debug() << "Animation" << i << importer->animationName(i) << "with" << source->trackCount() << "tracks:";
+
+        for(UnsignedInt j = 0; j != source->trackCount(); ++j) {
+            const Animation::TrackViewStorage<Float>& sourceTrack = source->track(j);
+            const Animation::TrackViewStorage<Float>& compressedTrack = compressed.track(j);
+            const bool sourceShared = sharesKeys(*source, j);
+            const bool compressedShared = sharesKeys(compressed, j);
+            const std::size_t sourceSize = (sourceShared ? 0 : sourceTrack.size()*sizeof(Float)) + sourceTrack.size()*typeSize(source->trackType(j));
+            const std::size_t compressedSize = (compressedShared ? 0 : compressedTrack.size()*sizeof(Float)) + compressedTrack.size()*typeSize(compressed.trackType(j));
+
+            Debug d;
+            d << " " << source->trackTargetType(j) << source->trackTarget(j) << Debug::nospace << ":"
+              << source->trackType(j) << Debug::nospace
+              << Utility::formatString(", {}{} keys, {} bytes ->", sourceTrack.size(), sourceShared ? " shared" : "", sourceSize)
+              << compressed.trackType(j) << Debug::nospace
+              << Utility::formatString(", {}{} keys, {} bytes ({:.2}x)", compressedTrack.size(), compressedShared ? " shared" : "", compressedSize, compressedSize ? Float(sourceSize)/compressedSize : 0.0f);
+
+            const std::vector<Float> times = errorSampleTimes(sourceTrack, compressedTrack);
+            std::size_t sourceHint{}, compressedHint{};
+            if(source->trackType(j) == Trade::AnimationTrackType::Vector3 &&
+               compressed.trackType(j) == Trade::AnimationTrackType::Vector3) {
+                Float error = 0.0f;
+                for(const Float time: times)
+                    error = Math::max(error, (source->track<Vector3>(j).at(time, sourceHint) - compressed.track<Vector3>(j).at(time, compressedHint)).length());
+                d << Debug::nospace << ", max error" << error;
+
+            } else if(source->trackType(j) == Trade::AnimationTrackType::Quaternion &&
+                      compressed.trackType(j) == Trade::AnimationTrackType::QuantizedQuaternion) {
+                Float error = 0.0f;
+                for(const Float time: times) {
+                    const Quaternion difference = source->track<Quaternion>(j).at(time, sourceHint).conjugated()*compressed.track<Animation::QuantizedQuaternion, Quaternion>(j).at(time, compressedHint);
+                    error = Math::max(error, 2.0f*std::atan2(difference.vector().length(), Math::abs(difference.scalar())));
+                }
+                d << Debug::nospace << ", max error" << Float(Deg(Rad(error))) << "degrees";
+
+            } else d << Debug::nospace << ", unchanged";
+        }
+
+        Debug() << "  Total:" << source->data().size() << "bytes ->" << compressed.data().size() << "bytes" << Utility::formatString("({:.2}x)", compressed.data().size() ? Float(source->data().size())/compressed.data().size() : 0.0f);
+        totalSourceSize += source->data().size();
+        totalCompressedSize += compressed.data().size();
+    }
+
+    Debug() << "Compressed" << importer->animationCount() << "animations from" << totalSourceSize << "to" << totalCompressedSize << "bytes" << Utility::formatString("({:.2}x)", totalCompressedSize ? Float(totalSourceSize)/totalCompressedSize : 0.0f);
+}
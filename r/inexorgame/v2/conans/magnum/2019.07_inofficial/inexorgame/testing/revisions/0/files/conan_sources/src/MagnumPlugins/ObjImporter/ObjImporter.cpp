@@ -25,14 +25,19 @@
 
 #include "ObjImporter.h"
 
-#include <fstream>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <limits>
 #include <sstream>
+#include <thread>
 #include <unordered_map>
+#include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/ArrayView.h>
 #include <Corrade/Containers/Optional.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
 #include <Corrade/Utility/DebugStl.h>
-#include <Corrade/Utility/String.h>
+#include <Corrade/Utility/Directory.h>
 
 #include "Magnum/Mesh.h"
 #include "Magnum/MeshTools/CombineIndexedArrays.h"
@@ -45,39 +50,213 @@ namespace Magnum { namespace Trade {
 struct ObjImporter::File {
     std::unordered_map<std::string, UnsignedInt> meshesForName;
     std::vector<std::string> meshNames;
-    std::vector<std::tuple<std::streampos, std::streampos, UnsignedInt, UnsignedInt, UnsignedInt>> meshes;
-    Containers::Pointer<std::istream> in;
+    std::vector<std::tuple<std::size_t, std::size_t, UnsignedInt, UnsignedInt, UnsignedInt>> meshes;
+
+    /* The file contents are parsed directly from memory. The view points
+       either to a memory-mapped file or to a copy of the data passed to
+       openData(). */
+    Containers::ArrayView<const char> in;
+    Containers::Array<char> data;
+    #if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+    Containers::Array<const char, Utility::Directory::MapDeleter> mapped;
+    #endif
 };
 
 namespace {
 
-void ignoreLine(std::istream& in) {
-    in.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+inline bool isSpace(const char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
 }
 
-template<std::size_t size> Math::Vector<size, Float> extractFloatData(const std::string& str, Float* extra = nullptr) {
-    std::vector<std::string> data = Utility::String::splitWithoutEmptyParts(str, ' ');
-    if(data.size() < size || data.size() > size + (extra ? 1 : 0)) {
+inline bool isDigit(const char c) {
+    return UnsignedInt(c - '0') < 10;
+}
+
+/* Returns end of the line starting at `it`, excluding the newline character */
+inline const char* findLineEnd(const char* const it, const char* const end) {
+    const char* const found = static_cast<const char*>(std::memchr(it, '\n', end - it));
+    return found ? found : end;
+}
+
+inline const char* skipSpaces(const char* it, const char* const end) {
+    while(it != end && isSpace(*it)) ++it;
+    return it;
+}
+
+inline const char* skipNonSpaces(const char* it, const char* const end) {
+    while(it != end && !isSpace(*it)) ++it;
+    return it;
+}
+
+/* The keyword, numbers and index tuples on a line are separated only by
+   spaces, other whitespace is a part of the token */
+inline const char* skipSeparators(const char* it, const char* const end) {
+    while(it != end && *it == ' ') ++it;
+    return it;
+}
+
+inline const char* skipNonSeparators(const char* it, const char* const end) {
+    while(it != end && *it != ' ') ++it;
+    return it;
+}
+
+template<std::size_t size> inline bool isKeyword(const char* const begin, const char* const end, const char(&keyword)[size]) {
+    return std::size_t(end - begin) == size - 1 && std::memcmp(begin, keyword, size - 1) == 0;
+}
+
+/* Powers of ten that are exactly representable in a double */
+constexpr Double Powers10[]{
+    1.0e0, 1.0e1, 1.0e2, 1.0e3, 1.0e4, 1.0e5, 1.0e6, 1.0e7, 1.0e8, 1.0e9,
+    1.0e10, 1.0e11, 1.0e12, 1.0e13, 1.0e14, 1.0e15, 1.0e16, 1.0e17, 1.0e18,
+    1.0e19, 1.0e20, 1.0e21, 1.0e22
+};
+
+/* Parses a decimal floating-point number in the whole [begin, end) range,
+   without any allocations or locale lookups. Returns false if the range isn't
+   a plain decimal number or if the result wouldn't be exact or in range for a
+   float, parseFloat() delegates to std::stof() in that case. */
+bool parseFloatFast(const char* it, const char* const end, Float& out) {
+    bool negative = false;
+    if(it != end && (*it == '-' || *it == '+')) {
+        negative = *it == '-';
+        ++it;
+    }
+
+    /* The mantissa has to be exactly representable in a double */
+    constexpr UnsignedLong MaxMantissa = 1ull << 53;
+    UnsignedLong mantissa = 0;
+    Int exponent = 0;
+    bool hasDigits = false;
+    for(; it != end && isDigit(*it); ++it) {
+        hasDigits = true;
+        mantissa = mantissa*10 + (*it - '0');
+        if(mantissa > MaxMantissa) return false;
+    }
+    if(it != end && *it == '.') for(++it; it != end && isDigit(*it); ++it) {
+        hasDigits = true;
+        mantissa = mantissa*10 + (*it - '0');
+        if(mantissa > MaxMantissa) return false;
+        --exponent;
+    }
+    if(!hasDigits) return false;
+
+    if(it != end && (*it == 'e' || *it == 'E')) {
+        ++it;
+        bool negativeExponent = false;
+        if(it != end && (*it == '-' || *it == '+')) {
+            negativeExponent = *it == '-';
+            ++it;
+        }
+        if(it == end || !isDigit(*it)) return false;
+
+        Int explicitExponent = 0;
+        for(; it != end && isDigit(*it); ++it)
+            if(explicitExponent < 10000)
+                explicitExponent = explicitExponent*10 + (*it - '0');
+        exponent += negativeExponent ? -explicitExponent : explicitExponent;
+    }
+    if(it != end) return false;
+
+    /* With both the mantissa and the power of ten exact, the double result is
+       correctly rounded */
+    Double value = Double(mantissa);
+    if(mantissa && exponent) {
+        if(exponent > 0 && exponent <= 22) value *= Powers10[exponent];
+        else if(exponent < 0 && exponent >= -22) value /= Powers10[-exponent];
+        else return false;
+    }
+
+    /* std::stof() fails for values that overflow or underflow a float */
+    if(value > Double(std::numeric_limits<Float>::max()) ||
+       (mantissa && value < Double(std::numeric_limits<Float>::min())))
+        return false;
+
+    out = Float(negative ? -value : value);
+    return true;
+}
+
+/* Accepts the same input as std::stof() did originally, including special
+   values, hexadecimal floats and trailing characters after a number, and
+   fails for out-of-range values. Common decimal numbers go through the fast
+   path, which may differ from std::stof() by one ulp in rare cases due to
+   rounding through a double. */
+bool parseFloat(const char* const begin, const char* const end, Float& out) {
+    if(parseFloatFast(begin, end, out)) return true;
+
+    try {
+        out = std::stof(std::string{begin, end});
+    } catch(const std::exception&) {
+        return false;
+    }
+    return true;
+}
+
+/* Plain decimal digits, fails if the value doesn't fit */
+bool parseUnsignedIntFast(const char* it, const char* const end, UnsignedInt& out) {
+    if(it == end) return false;
+
+    UnsignedLong value = 0;
+    for(; it != end; ++it) {
+        if(!isDigit(*it)) return false;
+        value = value*10 + (*it - '0');
+        if(value > std::numeric_limits<UnsignedInt>::max()) return false;
+    }
+
+    out = UnsignedInt(value);
+    return true;
+}
+
+/* Accepts the same input as std::stoul() did originally. In particular,
+   negative values wrap around, so "-1" is reported as an index out of range
+   and not as a conversion error. */
+bool parseUnsignedInt(const char* const begin, const char* const end, UnsignedInt& out) {
+    if(parseUnsignedIntFast(begin, end, out)) return true;
+
+    try {
+        out = UnsignedInt(std::stoul(std::string{begin, end}));
+    } catch(const std::exception&) {
+        return false;
+    }
+    return true;
+}
+
+template<std::size_t size> Math::Vector<size, Float> extractFloatData(const char* const begin, const char* const end, Float* extra = nullptr) {
+    /* Check the token count first so the size error has precedence over
+       conversion errors */
+    std::size_t count = 0;
+    for(const char* it = skipSeparators(begin, end); it != end; ++count)
+        it = skipSeparators(skipNonSeparators(it, end), end);
+    if(count < size || count > size + (extra ? 1 : 0)) {
         Error() << "Trade::ObjImporter::mesh3D(): invalid float array size";
         throw 0;
     }
 
     Math::Vector<size, Float> output;
 
-    for(std::size_t i = 0; i != size; ++i)
-        output[i] = std::stof(data[i]);
-
-    if(data.size() == size+1) {
-        /* This should be obvious from the first if, but add this just to make
-           Clang Analyzer happy */
-        CORRADE_INTERNAL_ASSERT(extra);
+    std::size_t i = 0;
+    for(const char* it = skipSeparators(begin, end); it != end; it = skipSeparators(it, end), ++i) {
+        const char* const tokenEnd = skipNonSeparators(it, end);
+        if(!parseFloat(it, tokenEnd, i < size ? output[i] : *extra)) {
+            Error() << "Trade::ObjImporter::mesh3D(): error while converting numeric data";
+            throw 0;
+        }
 
-        *extra = std::stof(data.back());
+        it = tokenEnd;
     }
 
     return output;
 }
 
+UnsignedInt extractIndex(const char* const begin, const char* const end) {
+    UnsignedInt index;
+    if(!parseUnsignedInt(begin, end, index)) {
+        Error() << "Trade::ObjImporter::mesh3D(): error while converting numeric data";
+        throw 0;
+    }
+
+    return index;
+}
+
 template<class T> void reindex(const std::vector<UnsignedInt>& indices, std::vector<T>& data) {
     /* Check that indices are in range */
     for(UnsignedInt i: indices) if(i >= data.size()) {
@@ -88,6 +267,173 @@ template<class T> void reindex(const std::vector<UnsignedInt>& indices, std::vec
     data = MeshTools::duplicate(indices, data);
 }
 
+/* Data parsed from a line-aligned part of a mesh. The indices are already
+   relative to the beginning of the mesh, which means chunks of the same mesh
+   can be simply concatenated. */
+struct MeshChunk {
+    Containers::Optional<MeshPrimitive> primitive;
+    std::vector<Vector3> positions;
+    std::vector<Vector2> textureCoordinates;
+    std::vector<Vector3> normals;
+    std::vector<UnsignedInt> positionIndices;
+    std::vector<UnsignedInt> textureCoordinateIndices;
+    std::vector<UnsignedInt> normalIndices;
+
+    /* Used only when parsing on multiple threads */
+    bool succeeded{};
+    std::string errors;
+    std::size_t positionsOffset{}, textureCoordinatesOffset{}, normalsOffset{},
+        positionIndicesOffset{}, textureCoordinateIndicesOffset{}, normalIndicesOffset{};
+};
+
+bool parseMeshChunk(const char* const begin, const char* const end, const UnsignedInt positionIndexOffset, const UnsignedInt textureCoordinateIndexOffset, const UnsignedInt normalIndexOffset, MeshChunk& out) {
+    try { for(const char* it = begin; it != end; ) {
+        /* Get the line */
+        const char* const currentLineEnd = findLineEnd(it, end);
+        const char* const currentLineBegin = it;
+        it = currentLineEnd == end ? end : currentLineEnd + 1;
+
+        /* Ignore comments */
+        if(currentLineBegin != currentLineEnd && *currentLineBegin == '#') continue;
+
+        /* Trim the line, ignore empty lines */
+        const char* const lineBegin = skipSpaces(currentLineBegin, currentLineEnd);
+        const char* lineEnd = currentLineEnd;
+        while(lineEnd != lineBegin && isSpace(lineEnd[-1])) --lineEnd;
+        if(lineBegin == lineEnd) continue;
+
+        /* Split the line into keyword and contents */
+        const char* const keywordEnd = skipNonSeparators(lineBegin, lineEnd);
+        const char* const contents = skipSpaces(keywordEnd, lineEnd);
+
+        /* Vertex position */
+        if(isKeyword(lineBegin, keywordEnd, "v")) {
+            Float extra{1.0f};
+            const Vector3 data = extractFloatData<3>(contents, lineEnd, &extra);
+            if(!Math::TypeTraits<Float>::equals(extra, 1.0f)) {
+                Error() << "Trade::ObjImporter::mesh3D(): homogeneous coordinates are not supported";
+                return false;
+            }
+
+            out.positions.push_back(data);
+
+        /* Texture coordinate */
+        } else if(isKeyword(lineBegin, keywordEnd, "vt")) {
+            Float extra{0.0f};
+            const auto data = extractFloatData<2>(contents, lineEnd, &extra);
+            if(!Math::TypeTraits<Float>::equals(extra, 0.0f)) {
+                Error() << "Trade::ObjImporter::mesh3D(): 3D texture coordinates are not supported";
+                return false;
+            }
+
+            out.textureCoordinates.push_back(data);
+
+        /* Normal */
+        } else if(isKeyword(lineBegin, keywordEnd, "vn")) {
+            out.normals.push_back(extractFloatData<3>(contents, lineEnd));
+
+        /* Indices */
+        } else if(isKeyword(lineBegin, keywordEnd, "p") ||
+                  isKeyword(lineBegin, keywordEnd, "l") ||
+                  isKeyword(lineBegin, keywordEnd, "f")) {
+            /* Check that we don't mix the primitives in one mesh. The
+               primitive is remembered before checking the vertex count so
+               the errors are reported in the same order even if the mesh is
+               parsed in multiple chunks. */
+            const MeshPrimitive primitive =
+                *lineBegin == 'p' ? MeshPrimitive::Points :
+                *lineBegin == 'l' ? MeshPrimitive::Lines :
+                                    MeshPrimitive::Triangles;
+            if(out.primitive && *out.primitive != primitive) {
+                Error() << "Trade::ObjImporter::mesh3D(): mixed primitive" << *out.primitive << "and" << primitive;
+                return false;
+            }
+            out.primitive = primitive;
+
+            /* Count the index tuples */
+            std::size_t indexTupleCount = 0;
+            for(const char* tuple = contents; tuple != lineEnd; ++indexTupleCount)
+                tuple = skipSeparators(skipNonSeparators(tuple, lineEnd), lineEnd);
+
+            /* Check vertex count per primitive */
+            if(primitive == MeshPrimitive::Points && indexTupleCount != 1) {
+                Error() << "Trade::ObjImporter::mesh3D(): wrong index count for point";
+                return false;
+            } else if(primitive == MeshPrimitive::Lines && indexTupleCount != 2) {
+                Error() << "Trade::ObjImporter::mesh3D(): wrong index count for line";
+                return false;
+            } else if(primitive == MeshPrimitive::Triangles && indexTupleCount < 3) {
+                Error() << "Trade::ObjImporter::mesh3D(): wrong index count for triangle";
+                return false;
+            } else if(primitive == MeshPrimitive::Triangles && indexTupleCount != 3) {
+                Error() << "Trade::ObjImporter::mesh3D(): polygons are not supported";
+                return false;
+            }
+
+            for(const char* tuple = contents; tuple != lineEnd; ) {
+                const char* const tupleEnd = skipNonSeparators(tuple, lineEnd);
+
+                /* Split the tuple on slashes, keeping empty parts */
+                const char* indices[4]{tuple};
+                std::size_t indexCount = 1;
+                for(const char* i = tuple; i != tupleEnd; ++i) if(*i == '/') {
+                    if(indexCount == 3) {
+                        Error() << "Trade::ObjImporter::mesh3D(): invalid index data";
+                        return false;
+                    }
+                    indices[indexCount++] = i + 1;
+                }
+                indices[indexCount] = tupleEnd + 1;
+
+                /* Position indices */
+                out.positionIndices.push_back(extractIndex(indices[0], indices[1] - 1) - positionIndexOffset);
+
+                /* Texture coordinates */
+                if(indexCount == 2 || (indexCount == 3 && indices[2] - indices[1] > 1))
+                    out.textureCoordinateIndices.push_back(extractIndex(indices[1], indices[2] - 1) - textureCoordinateIndexOffset);
+
+                /* Normal indices */
+                if(indexCount == 3)
+                    out.normalIndices.push_back(extractIndex(indices[2], indices[3] - 1) - normalIndexOffset);
+
+                tuple = skipSeparators(tupleEnd, lineEnd);
+            }
+
+        /* Ignore unsupported keywords, error out on unknown keywords */
+        } else if(!isKeyword(lineBegin, keywordEnd, "mtllib") &&
+                  !isKeyword(lineBegin, keywordEnd, "usemtl") &&
+                  !isKeyword(lineBegin, keywordEnd, "g") &&
+                  !isKeyword(lineBegin, keywordEnd, "s")) {
+            Error() << "Trade::ObjImporter::mesh3D(): unknown keyword" << std::string{lineBegin, keywordEnd};
+            return false;
+        }
+
+    }} catch(...) {
+        /* Error message already printed */
+        return false;
+    }
+
+    return true;
+}
+
+#if defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+/* Calculates offset of each chunk in the merged array using a prefix sum and
+   enlarges the array in the first chunk to fit all of them */
+template<class T> void prepareMerge(std::vector<MeshChunk>& chunks, std::vector<T> MeshChunk::*array, std::size_t MeshChunk::*offset) {
+    std::size_t size = 0;
+    for(MeshChunk& chunk: chunks) {
+        chunk.*offset = size;
+        size += (chunk.*array).size();
+    }
+
+    (chunks.front().*array).resize(size);
+}
+
+template<class T> void merge(std::vector<MeshChunk>& chunks, MeshChunk& chunk, std::vector<T> MeshChunk::*array, std::size_t MeshChunk::*offset) {
+    std::copy((chunk.*array).begin(), (chunk.*array).end(), (chunks.front().*array).begin() + chunk.*offset);
+}
+#endif
+
 }
 
 ObjImporter::ObjImporter() = default;
@@ -103,56 +449,92 @@ void ObjImporter::doClose() { _file.reset(); }
 bool ObjImporter::doIsOpened() const { return !!_file; }
 
 void ObjImporter::doOpenFile(const std::string& filename) {
-    Containers::Pointer<std::istream> in{new std::ifstream{filename, std::ios::binary}};
-    if(!in->good()) {
+    if(!Utility::Directory::exists(filename)) {
         Error() << "Trade::ObjImporter::openFile(): cannot open file" << filename;
         return;
     }
 
+    /* Map the file instead of reading it to avoid a copy of potentially huge
+       data. Empty files can't be mapped, so silently fall back to reading
+       the file in that case. */
+    #if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+    Containers::Array<const char, Utility::Directory::MapDeleter> mapped;
+    {
+        Error silenceError{nullptr};
+        mapped = Utility::Directory::mapRead(filename);
+    }
+    if(mapped) {
+        _file.reset(new File);
+        _file->in = mapped;
+        _file->mapped = std::move(mapped);
+        parseMeshNames();
+        return;
+    }
+    #endif
+
+    /* Reading an empty file gives back an empty array as well, the read
+       failed only if it printed an error */
+    Containers::Array<char> data;
+    std::ostringstream out;
+    {
+        Error redirectError{&out};
+        data = Utility::Directory::read(filename);
+    }
+    if(!data && !out.str().empty()) {
+        Error() << "Trade::ObjImporter::openFile(): cannot open file" << filename;
+        return;
+    }
     _file.reset(new File);
-    _file->in = std::move(in);
+    _file->in = data;
+    _file->data = std::move(data);
     parseMeshNames();
 }
 
 void ObjImporter::doOpenData(Containers::ArrayView<const char> data) {
     _file.reset(new File);
-    _file->in.reset(new std::istringstream{{data.begin(), data.size()}});
+    _file->data = Containers::Array<char>{Containers::NoInit, data.size()};
+    std::memcpy(_file->data.data(), data.data(), data.size());
+    _file->in = _file->data;
 
     parseMeshNames();
 }
 
 void ObjImporter::parseMeshNames() {
+    const char* const begin = _file->in.begin();
+    const char* const end = _file->in.end();
+
     /* First mesh starts at the beginning, its indices start from 1. The end
        offset will be updated to proper value later. */
     UnsignedInt positionIndexOffset = 1;
-    UnsignedInt normalIndexOffset = 1;
     UnsignedInt textureCoordinateIndexOffset = 1;
-    _file->meshes.emplace_back(0, 0, positionIndexOffset, normalIndexOffset, textureCoordinateIndexOffset);
+    UnsignedInt normalIndexOffset = 1;
+    _file->meshes.emplace_back(0, 0, positionIndexOffset, textureCoordinateIndexOffset, normalIndexOffset);
 
     /* The first mesh doesn't have name by default but we might find it later,
        so we need to track whether there are any data before first name */
     bool thisIsFirstMeshAndItHasNoData = true;
     _file->meshNames.emplace_back();
 
-    while(_file->in->good()) {
+    for(const char* it = begin; it != end; ) {
         /* The previous object might end at the beginning of this line */
-        const std::streampos end = _file->in->tellg();
-
-        /* Comment line */
-        if(_file->in->peek() == '#') {
-            ignoreLine(*_file->in);
-            continue;
-        }
+        const std::size_t lineBegin = it - begin;
+        const char* const currentLineEnd = findLineEnd(it, end);
+        const char* const next = currentLineEnd == end ? end : currentLineEnd + 1;
 
         /* Parse the keyword */
-        std::string keyword;
-        *_file->in >> keyword;
+        const char* const keywordBegin = skipSpaces(it, currentLineEnd);
+        const char* const keywordEnd = skipNonSpaces(keywordBegin, currentLineEnd);
+        it = next;
+
+        /* Empty and comment lines */
+        if(keywordBegin == keywordEnd || *keywordBegin == '#') continue;
 
         /* Mesh name */
-        if(keyword == "o") {
-            std::string name;
-            std::getline(*_file->in, name);
-            name = Utility::String::trim(name);
+        if(isKeyword(keywordBegin, keywordEnd, "o")) {
+            const char* const nameBegin = skipSpaces(keywordEnd, currentLineEnd);
+            const char* nameEnd = currentLineEnd;
+            while(nameEnd != nameBegin && isSpace(nameEnd[-1])) --nameEnd;
+            std::string name{nameBegin, nameEnd};
 
             /* This is the name of first mesh */
             if(thisIsFirstMeshAndItHasNoData) {
@@ -164,54 +546,46 @@ void ObjImporter::parseMeshNames() {
                 _file->meshNames.back() = std::move(name);
 
                 /* Update its begin offset to be more precise */
-                std::get<0>(_file->meshes.back()) = _file->in->tellg();
+                std::get<0>(_file->meshes.back()) = next - begin;
 
             /* Otherwise this is a name of new mesh */
             } else {
                 /* Set end of the previous one */
-                std::get<1>(_file->meshes.back()) = end;
+                std::get<1>(_file->meshes.back()) = lineBegin;
 
                 /* Save name and offset of the new one. The end offset will be
                    updated later. */
                 if(!name.empty())
                     _file->meshesForName.emplace(name, _file->meshes.size());
                 _file->meshNames.emplace_back(std::move(name));
-                _file->meshes.emplace_back(_file->in->tellg(), 0, positionIndexOffset, textureCoordinateIndexOffset, normalIndexOffset);
+                _file->meshes.emplace_back(next - begin, 0, positionIndexOffset, textureCoordinateIndexOffset, normalIndexOffset);
             }
 
-            continue;
-
         /* If there are any data/indices before the first name, it means that
            the first object is unnamed. We need to check for them. */
 
         /* Vertex data, update index offset for the following meshes */
-        } else if(keyword == "v") {
+        } else if(isKeyword(keywordBegin, keywordEnd, "v")) {
             ++positionIndexOffset;
             thisIsFirstMeshAndItHasNoData = false;
-        } else if(keyword == "vt") {
+        } else if(isKeyword(keywordBegin, keywordEnd, "vt")) {
             ++textureCoordinateIndexOffset;
             thisIsFirstMeshAndItHasNoData = false;
-        } else if(keyword == "vn") {
+        } else if(isKeyword(keywordBegin, keywordEnd, "vn")) {
             ++normalIndexOffset;
             thisIsFirstMeshAndItHasNoData = false;
 
         /* Index data, just mark that we found something for first unnamed
            object */
-        } else if(thisIsFirstMeshAndItHasNoData) for(const std::string& data: {"p", "l", "f"}) {
-            if(keyword == data) {
-                thisIsFirstMeshAndItHasNoData = false;
-                break;
-            }
+        } else if(isKeyword(keywordBegin, keywordEnd, "p") ||
+                  isKeyword(keywordBegin, keywordEnd, "l") ||
+                  isKeyword(keywordBegin, keywordEnd, "f")) {
+            thisIsFirstMeshAndItHasNoData = false;
         }
-
-        /* Ignore the rest of the line */
-        ignoreLine(*_file->in);
     }
 
     /* Set end of the last object */
-    _file->in->clear();
-    _file->in->seekg(0, std::ios::end);
-    std::get<1>(_file->meshes.back()) = _file->in->tellg();
+    std::get<1>(_file->meshes.back()) = _file->in.size();
 }
 
 UnsignedInt ObjImporter::doMesh3DCount() const { return _file->meshes.size(); }
@@ -226,163 +600,108 @@ std::string ObjImporter::doMesh3DName(UnsignedInt id) {
 }
 
 Containers::Optional<MeshData3D> ObjImporter::doMesh3D(UnsignedInt id) {
-    /* Seek the file, set mesh parsing parameters */
-    std::streampos begin, end;
+    /* Get the mesh range, set mesh parsing parameters */
+    std::size_t begin, end;
     UnsignedInt positionIndexOffset, textureCoordinateIndexOffset, normalIndexOffset;
     std::tie(begin, end, positionIndexOffset, textureCoordinateIndexOffset, normalIndexOffset) = _file->meshes[id];
-    _file->in->seekg(begin);
-
-    Containers::Optional<MeshPrimitive> primitive;
-    std::vector<Vector3> positions;
-    std::vector<std::vector<Vector2>> textureCoordinates;
-    std::vector<std::vector<Vector3>> normals;
-    std::vector<UnsignedInt> positionIndices;
-    std::vector<UnsignedInt> textureCoordinateIndices;
-    std::vector<UnsignedInt> normalIndices;
+    const Containers::ArrayView<const char> in = _file->in.slice(begin, end);
+
+    /* Decide how many chunks to split the mesh into. Meshes smaller than the
+       minimal chunk size are parsed on a single thread. If the plugin was
+       instantiated directly without a plugin manager, the configuration is
+       empty, in which case everything is done on a single thread as well. */
+    std::size_t chunkCount = 1;
+    #if defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+    if(configuration().hasValue("threads")) {
+        std::size_t threadCount = configuration().value<std::size_t>("threads");
+        if(!threadCount) threadCount = std::thread::hardware_concurrency();
+        const std::size_t minimumChunkSize = std::max(configuration().value<std::size_t>("minimumChunkSize"), std::size_t{1});
+        chunkCount = std::max(std::min(threadCount, in.size()/minimumChunkSize), std::size_t{1});
+    }
+    #endif
 
-    try { while(_file->in->good() && _file->in->tellg() < end) {
-        /* Ignore comments */
-        if(_file->in->peek() == '#') {
-            ignoreLine(*_file->in);
-            continue;
+    std::vector<MeshChunk> chunks(chunkCount);
+    if(chunkCount == 1) {
+        if(!parseMeshChunk(in.begin(), in.end(), positionIndexOffset, textureCoordinateIndexOffset, normalIndexOffset, chunks.front()))
+            return Containers::NullOpt;
+    }
+    #if defined(CORRADE_BUILD_MULTITHREADED) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+    else {
+        /* Split the range into line-aligned chunks of roughly equal size */
+        std::vector<const char*> bounds(chunkCount + 1);
+        bounds.front() = in.begin();
+        bounds.back() = in.end();
+        for(std::size_t i = 1; i != chunkCount; ++i) {
+            const char* const bound = findLineEnd(std::max(in.begin() + in.size()*i/chunkCount, bounds[i - 1]), in.end());
+            bounds[i] = bound == in.end() ? bound : bound + 1;
         }
 
-        /* Get the line */
-        std::string line;
-        std::getline(*_file->in, line);
-        line = Utility::String::trim(line);
-
-        /* Ignore empty lines */
-        if(line.empty()) continue;
-
-        /* Split the line into keyword and contents */
-        const std::size_t keywordEnd = line.find(' ');
-        const std::string keyword = line.substr(0, keywordEnd);
-        const std::string contents = keywordEnd != std::string::npos ?
-            Utility::String::ltrim(line.substr(keywordEnd+1)) : "";
-
-        /* Vertex position */
-        if(keyword == "v") {
-            Float extra{1.0f};
-            const Vector3 data = extractFloatData<3>(contents, &extra);
-            if(!Math::TypeTraits<Float>::equals(extra, 1.0f)) {
-                Error() << "Trade::ObjImporter::mesh3D(): homogeneous coordinates are not supported";
+        /* Parse each chunk on its own thread. Error output is thread-local,
+           so capture it and print only the first error in file order
+           afterwards, the same as a serial parse would. */
+        auto parse = [&](const std::size_t i) {
+            std::ostringstream out;
+            Error redirectError{&out};
+            chunks[i].succeeded = parseMeshChunk(bounds[i], bounds[i + 1], positionIndexOffset, textureCoordinateIndexOffset, normalIndexOffset, chunks[i]);
+            chunks[i].errors = out.str();
+        };
+        std::vector<std::thread> threads;
+        threads.reserve(chunkCount - 1);
+        for(std::size_t i = 1; i != chunkCount; ++i)
+            threads.emplace_back(parse, i);
+        parse(0);
+        for(std::thread& thread: threads) thread.join();
+
+        /* Check that we don't mix the primitives across chunks. If a chunk
+           failed before encountering any primitive, its own error comes
+           first. */
+        Containers::Optional<MeshPrimitive> primitive;
+        for(const MeshChunk& chunk: chunks) {
+            if(primitive && chunk.primitive && *primitive != *chunk.primitive) {
+                Error() << "Trade::ObjImporter::mesh3D(): mixed primitive" << *primitive << "and" << *chunk.primitive;
                 return Containers::NullOpt;
             }
-
-            positions.push_back(data);
-
-        /* Texture coordinate */
-        } else if(keyword == "vt") {
-            Float extra{0.0f};
-            const auto data = extractFloatData<2>(contents, &extra);
-            if(!Math::TypeTraits<Float>::equals(extra, 0.0f)) {
-                Error() << "Trade::ObjImporter::mesh3D(): 3D texture coordinates are not supported";
+            if(!chunk.succeeded) {
+                Error{Error::Flag::NoNewlineAtTheEnd} << chunk.errors;
                 return Containers::NullOpt;
             }
-
-            if(textureCoordinates.empty()) textureCoordinates.emplace_back();
-            textureCoordinates.front().emplace_back(data);
-
-        /* Normal */
-        } else if(keyword == "vn") {
-            if(normals.empty()) normals.emplace_back();
-            normals.front().emplace_back(extractFloatData<3>(contents));
-
-        /* Indices */
-        } else if(keyword == "p" || keyword == "l" || keyword == "f") {
-            const std::vector<std::string> indexTuples = Utility::String::splitWithoutEmptyParts(contents, ' ');
-
-            /* Points */
-            if(keyword == "p") {
-                /* Check that we don't mix the primitives in one mesh */
-                if(primitive && primitive != MeshPrimitive::Points) {
-                    Error() << "Trade::ObjImporter::mesh3D(): mixed primitive" << *primitive << "and" << MeshPrimitive::Points;
-                    return Containers::NullOpt;
-                }
-
-                /* Check vertex count per primitive */
-                if(indexTuples.size() != 1) {
-                    Error() << "Trade::ObjImporter::mesh3D(): wrong index count for point";
-                    return Containers::NullOpt;
-                }
-
-                primitive = MeshPrimitive::Points;
-
-            /* Lines */
-            } else if(keyword == "l") {
-                /* Check that we don't mix the primitives in one mesh */
-                if(primitive && primitive != MeshPrimitive::Lines) {
-                    Error() << "Trade::ObjImporter::mesh3D(): mixed primitive" << *primitive << "and" << MeshPrimitive::Lines;
-                    return Containers::NullOpt;
-                }
-
-                /* Check vertex count per primitive */
-                if(indexTuples.size() != 2) {
-                    Error() << "Trade::ObjImporter::mesh3D(): wrong index count for line";
-                    return Containers::NullOpt;
-                }
-
-                primitive = MeshPrimitive::Lines;
-
-            /* Faces */
-            } else if(keyword == "f") {
-                /* Check that we don't mix the primitives in one mesh */
-                if(primitive && primitive != MeshPrimitive::Triangles) {
-                    Error() << "Trade::ObjImporter::mesh3D(): mixed primitive" << *primitive << "and" << MeshPrimitive::Triangles;
-                    return Containers::NullOpt;
-                }
-
-                /* Check vertex count per primitive */
-                if(indexTuples.size() < 3) {
-                    Error() << "Trade::ObjImporter::mesh3D(): wrong index count for triangle";
-                    return Containers::NullOpt;
-                } else if(indexTuples.size() != 3) {
-                    Error() << "Trade::ObjImporter::mesh3D(): polygons are not supported";
-                    return Containers::NullOpt;
-                }
-
-                primitive = MeshPrimitive::Triangles;
-
-            } else CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
-
-            for(const std::string& indexTuple: indexTuples) {
-                std::vector<std::string> indices = Utility::String::split(indexTuple, '/');
-                if(indices.size() > 3) {
-                    Error() << "Trade::ObjImporter::mesh3D(): invalid index data";
-                    return Containers::NullOpt;
-                }
-
-                /* Position indices */
-                positionIndices.push_back(std::stoul(indices[0]) - positionIndexOffset);
-
-                /* Texture coordinates */
-                if(indices.size() == 2 || (indices.size() == 3 && !indices[1].empty()))
-                    textureCoordinateIndices.push_back(std::stoul(indices[1]) - textureCoordinateIndexOffset);
-
-                /* Normal indices */
-                if(indices.size() == 3)
-                    normalIndices.push_back(std::stoul(indices[2]) - normalIndexOffset);
-            }
-
-        /* Ignore unsupported keywords, error out on unknown keywords */
-        } else if(![&keyword](){
-            /* Using lambda to emulate for-else construct like in Python */
-            for(const std::string expected: {"mtllib", "usemtl", "g", "s"})
-                if(keyword == expected) return true;
-            return false;
-        }()) {
-            Error() << "Trade::ObjImporter::mesh3D(): unknown keyword" << keyword;
-            return Containers::NullOpt;
+            if(!primitive) primitive = chunk.primitive;
         }
-
-    }} catch(const std::exception&) {
-        Error() << "Trade::ObjImporter::mesh3D(): error while converting numeric data";
-        return Containers::NullOpt;
-    } catch(...) {
-        /* Error message already printed */
-        return Containers::NullOpt;
+        chunks.front().primitive = primitive;
+
+        /* Concatenate the chunks into the first one. The offsets are
+           calculated upfront so each chunk can be copied on its own thread. */
+        prepareMerge(chunks, &MeshChunk::positions, &MeshChunk::positionsOffset);
+        prepareMerge(chunks, &MeshChunk::textureCoordinates, &MeshChunk::textureCoordinatesOffset);
+        prepareMerge(chunks, &MeshChunk::normals, &MeshChunk::normalsOffset);
+        prepareMerge(chunks, &MeshChunk::positionIndices, &MeshChunk::positionIndicesOffset);
+        prepareMerge(chunks, &MeshChunk::textureCoordinateIndices, &MeshChunk::textureCoordinateIndicesOffset);
+        prepareMerge(chunks, &MeshChunk::normalIndices, &MeshChunk::normalIndicesOffset);
+        threads.clear();
+        for(std::size_t i = 1; i != chunkCount; ++i) threads.emplace_back([&chunks](MeshChunk& chunk) {
+            merge(chunks, chunk, &MeshChunk::positions, &MeshChunk::positionsOffset);
+            merge(chunks, chunk, &MeshChunk::textureCoordinates, &MeshChunk::textureCoordinatesOffset);
+            merge(chunks, chunk, &MeshChunk::normals, &MeshChunk::normalsOffset);
+            merge(chunks, chunk, &MeshChunk::positionIndices, &MeshChunk::positionIndicesOffset);
+            merge(chunks, chunk, &MeshChunk::textureCoordinateIndices, &MeshChunk::textureCoordinateIndicesOffset);
+            merge(chunks, chunk, &MeshChunk::normalIndices, &MeshChunk::normalIndicesOffset);
+        }, std::ref(chunks[i]));
+        for(std::thread& thread: threads) thread.join();
     }
+    #endif
+
+    MeshChunk& chunk = chunks.front();
+    const Containers::Optional<MeshPrimitive> primitive = chunk.primitive;
+    std::vector<Vector3> positions = std::move(chunk.positions);
+    std::vector<std::vector<Vector2>> textureCoordinates;
+    if(!chunk.textureCoordinates.empty())
+        textureCoordinates.push_back(std::move(chunk.textureCoordinates));
+    std::vector<std::vector<Vector3>> normals;
+    if(!chunk.normals.empty())
+        normals.push_back(std::move(chunk.normals));
+    std::vector<UnsignedInt> positionIndices = std::move(chunk.positionIndices);
+    std::vector<UnsignedInt> textureCoordinateIndices = std::move(chunk.textureCoordinateIndices);
+    std::vector<UnsignedInt> normalIndices = std::move(chunk.normalIndices);
 
     /* There should be at least indexed position data */
     if(positions.empty() || positionIndices.empty()) {
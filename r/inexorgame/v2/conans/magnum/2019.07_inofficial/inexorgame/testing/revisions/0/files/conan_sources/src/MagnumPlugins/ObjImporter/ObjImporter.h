@@ -70,6 +70,22 @@ for more information.
 
 @section Trade-ObjImporter-limitations Behavior and limitations
 
+The file is parsed directly from memory without any intermediate stream
+buffering. On platforms that support it, files opened with @ref openFile() are
+memory-mapped using @ref Utility::Directory::mapRead(), data passed to
+@ref openData() are copied once. Opening the file does a single pass that
+records byte range and index offsets of each mesh, @ref mesh3D() then parses
+only the range belonging to given mesh.
+
+Large meshes can be parsed on multiple threads by setting the @cb{.ini} threads @ce
+option in the plugin configuration to a value other than @cpp 1 @ce, with
+@cpp 0 @ce meaning all available cores. The mesh range is then split into
+line-aligned chunks of at least @cb{.ini} minimumChunkSize @ce bytes, each
+parsed on its own thread, and the results are concatenated afterwards. The
+imported data as well as the reported errors are the same regardless of the
+thread count. Multithreaded parsing is available only if Corrade is built with
+`BUILD_MULTITHREADED` and not on @ref CORRADE_TARGET_EMSCRIPTEN "Emscripten".
+
 Polygons (quads etc.), automatic normal generation and material properties are
 currently not supported.
 */
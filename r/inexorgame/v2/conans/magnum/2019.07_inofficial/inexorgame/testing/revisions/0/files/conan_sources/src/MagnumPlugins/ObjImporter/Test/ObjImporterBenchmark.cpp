@@ -0,0 +1,104 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/PluginManager/Manager.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
+#include <Corrade/Utility/FormatStl.h>
+
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/MeshData3D.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace Trade { namespace Test { namespace {
+
+struct ObjImporterBenchmark: TestSuite::Tester {
+    explicit ObjImporterBenchmark();
+
+    void mesh3D();
+
+    /* Explicitly forbid system-wide plugin dependencies */
+    PluginManager::Manager<AbstractImporter> _manager{"nonexistent"};
+
+    std::string _data;
+};
+
+/* Thread counts to measure scaling with, 0 uses all available cores */
+constexpr UnsignedInt ThreadCounts[]{1, 2, 4, 8, 0};
+
+/* A grid of quads split into triangles with positions, texture coordinates
+   and normals, about 7 MB of data */
+std::string grid(const std::size_t size) {
+    std::ostringstream out;
+    for(std::size_t y = 0; y != size; ++y)
+        for(std::size_t x = 0; x != size; ++x)
+            out << "v " << x << " " << y << " 0\n"
+                << "vt " << x/Float(size) << " " << y/Float(size) << "\n";
+    out << "vn 0 0 1\n";
+    for(std::size_t y = 0; y != size - 1; ++y)
+        for(std::size_t x = 0; x != size - 1; ++x) {
+            const std::size_t a = y*size + x + 1, b = a + 1, c = a + size, d = c + 1;
+            out << "f " << a << "/" << a << "/1 " << b << "/" << b << "/1 " << d << "/" << d << "/1\n"
+                << "f " << a << "/" << a << "/1 " << d << "/" << d << "/1 " << c << "/" << c << "/1\n";
+        }
+    return out.str();
+}
+
+ObjImporterBenchmark::ObjImporterBenchmark(): _data{grid(256)} {
+    addInstancedBenchmarks({&ObjImporterBenchmark::mesh3D}, 5,
+        Containers::arraySize(ThreadCounts));
+
+    /* Load the plugin directly from the build tree. Otherwise it's static and
+       already loaded. */
+    #ifdef OBJIMPORTER_PLUGIN_FILENAME
+    CORRADE_INTERNAL_ASSERT(_manager.load(OBJIMPORTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+}
+
+void ObjImporterBenchmark::mesh3D() {
+    const UnsignedInt threadCount = ThreadCounts[testCaseInstanceId()];
+    setTestCaseDescription(threadCount ? Utility::formatString("{} threads", threadCount) : "all cores");
+
+    /* Chunks are at least a megabyte by default, so this parses the mesh in
+       up to seven chunks */
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("ObjImporter");
+    importer->configuration().setValue("threads", threadCount);
+    CORRADE_VERIFY(importer->openData(Containers::ArrayView<const char>{_data.data(), _data.size()}));
+
+    Containers::Optional<MeshData3D> mesh;
+    CORRADE_BENCHMARK(1)
+        mesh = importer->mesh3D(0);
+
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->indices().size(), 255*255*6);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::ObjImporterBenchmark)
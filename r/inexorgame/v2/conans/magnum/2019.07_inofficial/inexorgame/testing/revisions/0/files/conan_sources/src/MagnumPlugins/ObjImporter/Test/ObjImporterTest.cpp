@@ -0,0 +1,249 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/PluginManager/Manager.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Mesh.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/MeshData3D.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace Trade { namespace Test { namespace {
+
+struct ObjImporterTest: TestSuite::Tester {
+    explicit ObjImporterTest();
+
+    void whitespaceAroundLine();
+    void tabSeparatedNumbers();
+    void tabAfterKeyword();
+    void indentedComment();
+
+    void invalidFloatArraySizeBeforeConversion();
+    void invalidFloatConversion();
+
+    void threaded();
+    void threadedErrorOrder();
+
+    /* Explicitly forbid system-wide plugin dependencies */
+    PluginManager::Manager<AbstractImporter> _manager{"nonexistent"};
+};
+
+ObjImporterTest::ObjImporterTest() {
+    addTests({&ObjImporterTest::whitespaceAroundLine,
+              &ObjImporterTest::tabSeparatedNumbers,
+              &ObjImporterTest::tabAfterKeyword,
+              &ObjImporterTest::indentedComment,
+
+              &ObjImporterTest::invalidFloatArraySizeBeforeConversion,
+              &ObjImporterTest::invalidFloatConversion,
+
+              &ObjImporterTest::threaded,
+              &ObjImporterTest::threadedErrorOrder});
+
+    /* Load the plugin directly from the build tree. Otherwise it's static and
+       already loaded. */
+    #ifdef OBJIMPORTER_PLUGIN_FILENAME
+    CORRADE_INTERNAL_ASSERT(_manager.load(OBJIMPORTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+}
+
+Containers::ArrayView<const char> view(const std::string& data) {
+    return {data.data(), data.size()};
+}
+
+void ObjImporterTest::whitespaceAroundLine() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("ObjImporter");
+    const std::string data =
+        "\tv 1 2 3 \t\r\n"
+        " \tv 4 5  6\t\n"
+        "v 7 8 9\r\n"
+        "\t\n"
+        "p 1\t\n"
+        "p  2\n"
+        "\tp 3 \r\n";
+    CORRADE_VERIFY(importer->openData(view(data)));
+
+    Containers::Optional<MeshData3D> mesh = importer->mesh3D(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->primitive(), MeshPrimitive::Points);
+    CORRADE_COMPARE_AS(mesh->positions(0), (std::vector<Vector3>{
+        {1.0f, 2.0f, 3.0f},
+        {4.0f, 5.0f, 6.0f},
+        {7.0f, 8.0f, 9.0f}
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(mesh->indices(), (std::vector<UnsignedInt>{
+        0, 1, 2
+    }), TestSuite::Compare::Container);
+}
+
+void ObjImporterTest::tabSeparatedNumbers() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("ObjImporter");
+
+    /* Only spaces separate the numbers, so this is a single token */
+    const std::string data =
+        "v 1\t2\t3\n"
+        "p 1\n";
+    CORRADE_VERIFY(importer->openData(view(data)));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->mesh3D(0));
+    CORRADE_COMPARE(out.str(), "Trade::ObjImporter::mesh3D(): invalid float array size\n");
+}
+
+void ObjImporterTest::tabAfterKeyword() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("ObjImporter");
+
+    /* The keyword ends at the first space */
+    const std::string data =
+        "v\t1 2 3\n"
+        "p 1\n";
+    CORRADE_VERIFY(importer->openData(view(data)));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->mesh3D(0));
+    CORRADE_COMPARE(out.str(), "Trade::ObjImporter::mesh3D(): unknown keyword v\t1\n");
+}
+
+void ObjImporterTest::indentedComment() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("ObjImporter");
+
+    /* Only a # at the very beginning of a line denotes a comment */
+    const std::string data =
+        "# a comment\n"
+        "v 1 2 3\n"
+        " # not a comment\n"
+        "p 1\n";
+    CORRADE_VERIFY(importer->openData(view(data)));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->mesh3D(0));
+    CORRADE_COMPARE(out.str(), "Trade::ObjImporter::mesh3D(): unknown keyword #\n");
+}
+
+void ObjImporterTest::invalidFloatArraySizeBeforeConversion() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("ObjImporter");
+
+    /* The size is checked before any of the numbers get converted */
+    const std::string data =
+        "v 1 abc 2 3 4\n"
+        "p 1\n";
+    CORRADE_VERIFY(importer->openData(view(data)));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->mesh3D(0));
+    CORRADE_COMPARE(out.str(), "Trade::ObjImporter::mesh3D(): invalid float array size\n");
+}
+
+void ObjImporterTest::invalidFloatConversion() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("ObjImporter");
+
+    const std::string data =
+        "v 1 abc 2\n"
+        "p 1\n";
+    CORRADE_VERIFY(importer->openData(view(data)));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->mesh3D(0));
+    CORRADE_COMPARE(out.str(), "Trade::ObjImporter::mesh3D(): error while converting numeric data\n");
+}
+
+/* A grid of quads split into triangles, with every line long enough that
+   each chunk gets at least a few of them */
+std::string grid(const std::size_t size) {
+    std::ostringstream out;
+    for(std::size_t y = 0; y != size; ++y)
+        for(std::size_t x = 0; x != size; ++x)
+            out << "v " << x << " " << y << " 0\n"
+                << "vt " << x/Float(size) << " " << y/Float(size) << "\n";
+    out << "vn 0 0 1\n";
+    for(std::size_t y = 0; y != size - 1; ++y)
+        for(std::size_t x = 0; x != size - 1; ++x) {
+            const std::size_t a = y*size + x + 1, b = a + 1, c = a + size, d = c + 1;
+            out << "f " << a << "/" << a << "/1 " << b << "/" << b << "/1 " << d << "/" << d << "/1\n"
+                << "f " << a << "/" << a << "/1 " << d << "/" << d << "/1 " << c << "/" << c << "/1\n";
+        }
+    return out.str();
+}
+
+void ObjImporterTest::threaded() {
+    const std::string data = grid(32);
+
+    Containers::Pointer<AbstractImporter> serial = _manager.instantiate("ObjImporter");
+    serial->configuration().setValue("threads", 1);
+    CORRADE_VERIFY(serial->openData(view(data)));
+    Containers::Optional<MeshData3D> expected = serial->mesh3D(0);
+    CORRADE_VERIFY(expected);
+
+    /* Force splitting into as many chunks as there are threads */
+    Containers::Pointer<AbstractImporter> parallel = _manager.instantiate("ObjImporter");
+    parallel->configuration().setValue("threads", 4);
+    parallel->configuration().setValue("minimumChunkSize", 1);
+    CORRADE_VERIFY(parallel->openData(view(data)));
+    Containers::Optional<MeshData3D> actual = parallel->mesh3D(0);
+    CORRADE_VERIFY(actual);
+
+    CORRADE_COMPARE(actual->primitive(), MeshPrimitive::Triangles);
+    CORRADE_COMPARE_AS(actual->indices(), expected->indices(),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(actual->positions(0), expected->positions(0),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(actual->textureCoords2D(0), expected->textureCoords2D(0),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(actual->normals(0), expected->normals(0),
+        TestSuite::Compare::Container);
+}
+
+void ObjImporterTest::threadedErrorOrder() {
+    /* An error at the end and another one at the beginning, each in a
+       different chunk. Only the first one in file order gets reported. */
+    const std::string data = "v 1 abc 2\n" + grid(32) + "v 1 2\n";
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("ObjImporter");
+    importer->configuration().setValue("threads", 4);
+    importer->configuration().setValue("minimumChunkSize", 1);
+    CORRADE_VERIFY(importer->openData(view(data)));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->mesh3D(0));
+    CORRADE_COMPARE(out.str(), "Trade::ObjImporter::mesh3D(): error while converting numeric data\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::ObjImporterTest)
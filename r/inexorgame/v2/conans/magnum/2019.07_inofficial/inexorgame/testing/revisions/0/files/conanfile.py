@@ -52,6 +52,7 @@ class MagnumConan(ConanFile):
         "target_gl": [True, False],
         "target_gles": [True, False],
         "target_vk": [True, False],
+        "with_animationcompressor": [True, False],
         "with_anyaudioimporter": [True, False],
         "with_anyimageconverter": [True, False],
         "with_anyimageimporter": [True, False],
@@ -94,6 +95,7 @@ class MagnumConan(ConanFile):
         "target_gl": True,
         "target_gles": False,
         "target_vk": False,
+        "with_animationcompressor": False,
         "with_anyaudioimporter": False,
         "with_anyimageconverter": False,
         "with_anyimageimporter": False,